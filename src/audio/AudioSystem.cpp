@@ -11,10 +11,7 @@
 namespace gloaming {
 
 AudioSystem::AudioSystem()
-    : System("AudioSystem", 10),
-      m_soundManager(std::make_unique<SoundManager>()),
-      m_musicManager(std::make_unique<MusicManager>()),
-      m_alive(std::make_shared<bool>(true)) {
+    : AudioSystem(AudioConfig{}) {
 }
 
 AudioSystem::AudioSystem(const AudioConfig& config)
@@ -22,6 +19,8 @@ AudioSystem::AudioSystem(const AudioConfig& config)
       m_soundManager(std::make_unique<SoundManager>()),
       m_musicManager(std::make_unique<MusicManager>()),
       m_alive(std::make_shared<bool>(true)) {
+    // Streams music through raylib, so it stays on the main thread
+    declareAccess().reads<resource::Camera>().writes<resource::Audio>().mainThread();
 }
 
 AudioSystem::~AudioSystem() {
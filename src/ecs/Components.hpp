@@ -47,6 +47,7 @@ struct Velocity {
 struct Sprite {
     const Texture* texture = nullptr;
     Rect sourceRect{0, 0, 0, 0};        // Region in texture (0,0,0,0 = entire texture)
+    Rect sheetRect{0, 0, 0, 0};         // Whole sheet in texture, e.g. its atlas region (0 size = entire texture)
     Vec2 origin{0.5f, 0.5f};            // Pivot point (0-1, 0.5 = center)
     Color tint = Color::White();
     int layer = 0;                       // Render order (higher = on top)
@@ -64,6 +65,15 @@ struct Sprite {
     Sprite(const Texture* tex, const Rect& src) : texture(tex), sourceRect(src) {}
     Sprite(const Texture* tex, const Rect& src, int renderLayer)
         : texture(tex), sourceRect(src), layer(renderLayer) {}
+
+    /// Bounds of the sprite sheet within the texture. Animation frames are
+    /// relative to this, since packed textures live on shared atlas pages.
+    Rect sheetBounds() const {
+        if (sheetRect.width > 0 && sheetRect.height > 0) return sheetRect;
+        if (!texture) return Rect(0, 0, 0, 0);
+        return Rect(0, 0, static_cast<float>(texture->getWidth()),
+                    static_cast<float>(texture->getHeight()));
+    }
 };
 
 /// Collision layer flags (bitmask)
@@ -230,7 +240,10 @@ struct Trigger {
         : onEnter(std::move(enter)), onExit(std::move(exit)) {}
 };
 
-/// Network sync settings (future multiplayer support)
+/// Network sync settings. Server entities with this component (and a
+/// Transform) are replicated to connected clients by ReplicationServer;
+/// on clients, interpolationDelay sets how far behind the newest snapshot
+/// the entity is drawn.
 struct NetworkSync {
     bool syncPosition = true;
     bool syncRotation = true;
@@ -241,14 +254,21 @@ struct NetworkSync {
     constexpr NetworkSync() = default;
 };
 
+/// Marks a client-side entity created by ReplicationClient from a server
+/// snapshot. netId is the server's entity ID.
+struct NetworkReplica {
+    uint32_t netId = 0;
+};
+
 /// Tag component for player entities
 struct PlayerTag {
     int playerIndex = 0;                 // For local multiplayer
 };
 
-/// Tag component for enemy entities
+/// Tag component for enemy entities. Only the runtime ID is stored; the
+/// qualified ID is on the registry's EnemyDefinition (and in Name::type).
 struct EnemyTag {
-    std::string enemyType;
+    uint16_t runtimeId = 0;              // ContentRegistry enemy ID (0 = unregistered)
 };
 
 /// Tag component for NPC entities
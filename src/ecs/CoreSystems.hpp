@@ -10,7 +10,9 @@ namespace gloaming {
 /// System that updates entity positions based on velocity
 class MovementSystem : public System {
 public:
-    MovementSystem() : System("MovementSystem", 0) {}
+    MovementSystem() : System("MovementSystem", 0) {
+        declareAccess().reads<Velocity>().writes<Transform>();
+    }
 
     void update(float dt) override {
         getRegistry().each<Transform, Velocity>([dt](Entity /*entity*/, Transform& transform, Velocity& velocity) {
@@ -27,7 +29,9 @@ public:
 /// System that destroys entities that have exceeded their lifetime
 class LifetimeSystem : public System {
 public:
-    LifetimeSystem() : System("LifetimeSystem", 100) {}
+    LifetimeSystem() : System("LifetimeSystem", 100) {
+        declareAccess().writes<Lifetime, resource::Entities>();
+    }
 
     void update(float dt) override {
         std::vector<Entity> toDestroy;
@@ -48,7 +52,9 @@ public:
 /// System that updates health invincibility timers
 class HealthSystem : public System {
 public:
-    HealthSystem() : System("HealthSystem", 20) {}
+    HealthSystem() : System("HealthSystem", 20) {
+        declareAccess().writes<Health>();
+    }
 
     void update(float dt) override {
         getRegistry().each<Health>([dt](Entity /*entity*/, Health& health) {
@@ -60,7 +66,9 @@ public:
 /// System that updates light source flicker
 class LightUpdateSystem : public System {
 public:
-    LightUpdateSystem() : System("LightUpdateSystem", 30) {}
+    LightUpdateSystem() : System("LightUpdateSystem", 30) {
+        declareAccess().writes<LightSource>();
+    }
 
     void update(float dt) override {
         getRegistry().each<LightSource>([dt](Entity /*entity*/, LightSource& light) {
@@ -253,12 +253,18 @@ Entity EntityFactory::createSprite(Registry& registry, Vec2 position, const Text
 void EntityFactory::applyDefinition(Registry& registry, Entity entity, const EntityDefinition& def) {
     // Sprite component
     if (!def.texturePath.empty() && m_textureManager) {
-        const Texture* texture = m_textureManager->loadTexture(def.texturePath);
-        if (texture) {
-            Sprite sprite(texture);
+        // Packed textures resolve to a region of a shared atlas page; rects
+        // in the definition stay relative to the original image
+        TextureRegion region;
+        if (m_textureManager->resolveRegion(def.texturePath, region)) {
+            const Vec2 regionOrigin(region.bounds.x, region.bounds.y);
+            Sprite sprite(region.texture, region.bounds);
+            sprite.sheetRect = region.bounds;
 
             if (def.sourceRect) {
                 sprite.sourceRect = *def.sourceRect;
+                sprite.sourceRect.x += regionOrigin.x;
+                sprite.sourceRect.y += regionOrigin.y;
             }
             if (def.origin) {
                 sprite.origin = *def.origin;
@@ -278,6 +284,10 @@ void EntityFactory::applyDefinition(Registry& registry, Entity entity, const Ent
                 for (const auto& animDef : def.animations) {
                     AnimationClip clip;
                     clip.frames = animDef.frames;
+                    for (Rect& frame : clip.frames) {
+                        frame.x += regionOrigin.x;
+                        frame.y += regionOrigin.y;
+                    }
                     clip.fps = animDef.fps;
                     if (animDef.mode == "once")
                         clip.mode = PlaybackMode::Once;
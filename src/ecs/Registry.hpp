@@ -4,8 +4,11 @@
 
 #include <entt/entt.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <functional>
+#include <span>
 #include <string>
 #include <unordered_map>
 
@@ -25,7 +28,9 @@ public:
 
     /// Create a new entity
     Entity create() {
-        return m_registry.create();
+        Entity entity = m_registry.create();
+        touch(entity);
+        return entity;
     }
 
     /// Create a new entity with given components
@@ -33,12 +38,14 @@ public:
     Entity create(Components&&... components) {
         Entity entity = m_registry.create();
         (m_registry.emplace<std::decay_t<Components>>(entity, std::forward<Components>(components)), ...);
+        touch(entity);
         return entity;
     }
 
     /// Destroy an entity
     void destroy(Entity entity) {
         if (valid(entity)) {
+            touch(entity);
             m_registry.destroy(entity);
         }
     }
@@ -67,12 +74,14 @@ public:
     /// Add a component to an entity
     template<typename Component, typename... Args>
     Component& add(Entity entity, Args&&... args) {
+        touch(entity);
         return m_registry.emplace<Component>(entity, std::forward<Args>(args)...);
     }
 
     /// Add or replace a component on an entity
     template<typename Component, typename... Args>
     Component& addOrReplace(Entity entity, Args&&... args) {
+        touch(entity);
         return m_registry.emplace_or_replace<Component>(entity, std::forward<Args>(args)...);
     }
 
@@ -80,6 +89,7 @@ public:
     template<typename Component>
     void remove(Entity entity) {
         if (has<Component>(entity)) {
+            touch(entity);
             m_registry.remove<Component>(entity);
         }
     }
@@ -194,9 +204,56 @@ public:
 
     /// Clear all entities and components
     void clear() {
+        touch();
         m_registry.clear();
     }
 
+    /// Change stamp for caches derived from the registry (SpatialIndex).
+    /// Advances on touch() and clear(), i.e. when any entity may have
+    /// changed. Safe to advance from several threads at once.
+    uint64_t version() const {
+        return std::atomic_ref<uint64_t>(m_version).load(std::memory_order_relaxed);
+    }
+
+    /// Mark derived caches stale after editing any number of components in
+    /// place (e.g. after a system ran).
+    void touch() {
+        std::atomic_ref<uint64_t>(m_version).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Log one entity as changed, so caches can update just that entity.
+    /// Every create/destroy/add/replace/remove made through this wrapper
+    /// does this; code that moves or retypes one entity in place calls it
+    /// afterwards. Main thread only, like structural changes. A long log
+    /// turns into a touch().
+    void touch(Entity entity) {
+        uint64_t version = this->version();
+        if (version != m_changedVersion) {
+            // A bulk change supersedes everything logged before it
+            m_changedBase += m_changed.size();
+            m_changed.clear();
+            m_changedVersion = version;
+        }
+        if (m_changed.size() >= kMaxChangedEntities) {
+            touch();
+            return;
+        }
+        m_changed.push_back(entity);
+    }
+
+    /// Position in the change log; pass to changedSince() later.
+    uint64_t changeCursor() const { return m_changedBase + m_changed.size(); }
+
+    /// Entities logged by touch(entity) since `cursor`, in order, possibly
+    /// repeated. Only complete while version() is unchanged since the
+    /// cursor was taken.
+    std::span<const Entity> changedSince(uint64_t cursor) const {
+        if (version() != m_changedVersion || cursor < m_changedBase) return {};
+        size_t from = static_cast<size_t>(cursor - m_changedBase);
+        if (from >= m_changed.size()) return {};
+        return std::span<const Entity>(m_changed).subspan(from);
+    }
+
     /// Sort entities with a component
     template<typename Component, typename Compare>
     void sort(Compare compare) {
@@ -241,7 +298,14 @@ public:
     }
 
 private:
+    /// Longest change log before touch(entity) falls back to touch()
+    static constexpr size_t kMaxChangedEntities = 4096;
+
     entt::registry m_registry;
+    alignas(std::atomic_ref<uint64_t>::required_alignment) mutable uint64_t m_version = 0;    ///< Accessed through atomic_ref
+    std::vector<Entity> m_changed;      ///< Entities touched one at a time since m_changedVersion
+    uint64_t m_changedBase = 0;         ///< changeCursor() of m_changed[0]
+    uint64_t m_changedVersion = 0;      ///< version() the log belongs to
 };
 
 } // namespace gloaming
@@ -0,0 +1,137 @@
+#include "ecs/SystemGraph.hpp"
+#include "engine/JobSystem.hpp"
+
+#include <algorithm>
+
+namespace gloaming {
+
+// =============================================================================
+// SystemAccess
+// =============================================================================
+
+bool SystemAccess::intersects(const std::vector<TypeId>& a, const std::vector<TypeId>& b) {
+    // Sets hold a handful of IDs; a nested scan beats sorting
+    for (TypeId x : a) {
+        for (TypeId y : b) {
+            if (x == y) return true;
+        }
+    }
+    return false;
+}
+
+bool SystemAccess::conflictsWith(const SystemAccess& other) const {
+    static const uint32_t kEntities = entt::type_hash<resource::Entities>::value();
+
+    // Everyone implicitly reads the entity set
+    auto writesEntities = [](const SystemAccess& a) {
+        return std::find(a.m_writes.begin(), a.m_writes.end(), kEntities) != a.m_writes.end();
+    };
+    if (writesEntities(*this) || writesEntities(other)) return true;
+
+    return intersects(m_writes, other.m_writes) ||
+           intersects(m_writes, other.m_reads) ||
+           intersects(m_reads, other.m_writes);
+}
+
+void SystemAccess::preparePools(Registry& registry) const {
+    for (auto prepare : m_preparePools) {
+        prepare(registry);
+    }
+}
+
+// =============================================================================
+// SystemGraph
+// =============================================================================
+
+void SystemGraph::build(const std::vector<const SystemAccess*>& accesses) {
+    size_t count = accesses.size();
+    m_successors.assign(count, {});
+    m_dependencyCount.assign(count, 0);
+    m_mainThread.assign(count, 0);
+    m_hasParallelism = false;
+
+    for (size_t j = 0; j < count; ++j) {
+        m_mainThread[j] = !accesses[j] || accesses[j]->requiresMainThread();
+        for (size_t i = 0; i < j; ++i) {
+            bool conflict = !accesses[i] || !accesses[j] ||
+                            accesses[i]->conflictsWith(*accesses[j]);
+            if (conflict) {
+                m_successors[i].push_back(static_cast<uint32_t>(j));
+                ++m_dependencyCount[j];
+            } else {
+                m_hasParallelism = true;
+            }
+        }
+    }
+
+    m_remainingDeps = std::make_unique<std::atomic<uint32_t>[]>(count);
+    m_mainQueue.reserve(count);
+}
+
+bool SystemGraph::dependsOn(size_t later, size_t earlier) const {
+    if (earlier >= m_successors.size()) return false;
+    const auto& succ = m_successors[earlier];
+    return std::find(succ.begin(), succ.end(), static_cast<uint32_t>(later)) != succ.end();
+}
+
+void SystemGraph::execute(JobSystem& jobs, const std::function<void(size_t)>& runNode) {
+    size_t count = size();
+    if (count == 0) return;
+
+    for (size_t i = 0; i < count; ++i) {
+        m_remainingDeps[i].store(m_dependencyCount[i], std::memory_order_relaxed);
+    }
+    m_mainQueue.clear();
+    m_remainingNodes.store(count, std::memory_order_release);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (m_dependencyCount[i] == 0) schedule(i, jobs, runNode);
+    }
+
+    // Run main-thread nodes as they become ready; otherwise help the pool
+    while (m_remainingNodes.load(std::memory_order_acquire) > 0) {
+        uint32_t node = 0;
+        bool haveNode = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mainQueueMutex);
+            if (!m_mainQueue.empty()) {
+                // Lowest index first keeps undeclared systems in priority order
+                auto it = std::min_element(m_mainQueue.begin(), m_mainQueue.end());
+                node = *it;
+                m_mainQueue.erase(it);
+                haveNode = true;
+            }
+        }
+
+        if (haveNode) {
+            runNode(node);
+            complete(node, jobs, runNode);
+        } else if (!jobs.tryRunOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void SystemGraph::schedule(size_t node, JobSystem& jobs, const std::function<void(size_t)>& runNode) {
+    if (m_mainThread[node] || !jobs.isRunning()) {
+        std::lock_guard<std::mutex> lock(m_mainQueueMutex);
+        m_mainQueue.push_back(static_cast<uint32_t>(node));
+        return;
+    }
+    jobs.submit([this, node, &jobs, &runNode]() {
+        runNode(node);
+        complete(node, jobs, runNode);
+    });
+}
+
+void SystemGraph::complete(size_t node, JobSystem& jobs, const std::function<void(size_t)>& runNode) {
+    for (uint32_t next : m_successors[node]) {
+        if (m_remainingDeps[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            schedule(next, jobs, runNode);
+        }
+    }
+    // Last: once this reaches zero execute() returns and the graph may be reused
+    m_remainingNodes.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace gloaming
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "ecs/Registry.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace gloaming {
+
+class JobSystem;
+
+/// Engine-owned state a system can declare access to, alongside components.
+/// Only used as markers in SystemAccess; never stored in the registry.
+namespace resource {
+struct Tag {};
+struct Entities : Tag {};   ///< Creating/destroying entities
+struct Events   : Tag {};   ///< EventBus emit/queue/subscribe
+struct TileMap  : Tag {};   ///< World tiles and chunks
+struct Camera   : Tag {};   ///< The engine camera
+struct Audio    : Tag {};   ///< Audio device, sounds and music
+} // namespace resource
+
+/// The components and resources a system's update() reads and writes.
+///
+///   declareAccess()
+///       .reads<Transform, LightSource, resource::TileMap>()
+///       .writes<Sprite>();
+///
+/// Two systems conflict when either writes something the other touches.
+/// Every declared system implicitly reads resource::Entities (views check
+/// entity validity), so a system that creates or destroys entities must
+/// declare writes<resource::Entities>() and will run alone.
+///
+/// Adding or removing a component counts as a write to that component.
+/// Anything that can call into Lua synchronously (EventBus::emit, Lua
+/// callbacks) must not be declared — leave the system undeclared instead.
+class SystemAccess {
+public:
+    template<typename... Ts>
+    SystemAccess& reads() {
+        (add<Ts>(m_reads), ...);
+        return *this;
+    }
+
+    template<typename... Ts>
+    SystemAccess& writes() {
+        (add<Ts>(m_writes), ...);
+        return *this;
+    }
+
+    /// Keep the system on the thread that runs the scheduler (e.g. it calls
+    /// raylib). It may still overlap with systems running on workers.
+    SystemAccess& mainThread() {
+        m_mainThread = true;
+        return *this;
+    }
+
+    bool requiresMainThread() const { return m_mainThread; }
+
+    /// Whether the two systems must not run at the same time.
+    bool conflictsWith(const SystemAccess& other) const;
+
+    /// Create the registry storage for every declared component so that
+    /// concurrent views never have to insert a pool.
+    void preparePools(Registry& registry) const;
+
+private:
+    using TypeId = uint32_t;
+
+    template<typename T>
+    void add(std::vector<TypeId>& set) {
+        TypeId id = entt::type_hash<T>::value();
+        for (TypeId existing : set) {
+            if (existing == id) return;
+        }
+        set.push_back(id);
+        if constexpr (!std::is_base_of_v<resource::Tag, T>) {
+            m_preparePools.push_back([](Registry& registry) {
+                registry.raw().storage<T>();
+            });
+        }
+    }
+
+    static bool intersects(const std::vector<TypeId>& a, const std::vector<TypeId>& b);
+
+    std::vector<TypeId> m_reads;
+    std::vector<TypeId> m_writes;
+    std::vector<void (*)(Registry&)> m_preparePools;
+    bool m_mainThread = false;
+};
+
+/// Dependency DAG over the systems of one phase.
+///
+/// Nodes are systems in execution (priority) order. Node j depends on every
+/// earlier node i it conflicts with; an undeclared system (nullptr access)
+/// conflicts with everything, so it keeps its exact place in the serial
+/// order and runs on the calling thread.
+class SystemGraph {
+public:
+    /// Build the graph from per-system access declarations (nullptr = undeclared).
+    void build(const std::vector<const SystemAccess*>& accesses);
+
+    size_t size() const { return m_dependencyCount.size(); }
+
+    /// Whether any two systems can run concurrently.
+    bool hasParallelism() const { return m_hasParallelism; }
+
+    /// Direct dependency test (later waits for earlier).
+    bool dependsOn(size_t later, size_t earlier) const;
+
+    /// Run every node once, each after all of its dependencies. Nodes that
+    /// require the main thread run on the caller; the rest go to the job
+    /// system. Blocks until all nodes have run.
+    void execute(JobSystem& jobs, const std::function<void(size_t)>& runNode);
+
+private:
+    void complete(size_t node, JobSystem& jobs, const std::function<void(size_t)>& runNode);
+    void schedule(size_t node, JobSystem& jobs, const std::function<void(size_t)>& runNode);
+
+    std::vector<std::vector<uint32_t>> m_successors;
+    std::vector<uint32_t> m_dependencyCount;
+    std::vector<uint8_t> m_mainThread;
+    bool m_hasParallelism = false;
+
+    // Execution state (reused every run)
+    std::unique_ptr<std::atomic<uint32_t>[]> m_remainingDeps;
+    std::atomic<size_t> m_remainingNodes{0};
+    std::mutex m_mainQueueMutex;
+    std::vector<uint32_t> m_mainQueue;
+};
+
+} // namespace gloaming
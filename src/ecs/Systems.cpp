@@ -0,0 +1,96 @@
+#include "ecs/Systems.hpp"
+#include "engine/Log.hpp"
+
+namespace gloaming {
+
+// =============================================================================
+// SystemTimingStats
+// =============================================================================
+
+void SystemTimingStats::addSample(double ms) {
+    lastMs = ms;
+    frameMs += ms;
+    ++sampleCount;
+
+    if (sampleCount == 1) {
+        avgMs = ms;
+    } else {
+        avgMs = avgMs * (1.0 - ProfileZoneStats::kSmoothing) + ms * ProfileZoneStats::kSmoothing;
+    }
+    maxMs = std::max(maxMs, ms);
+
+    // Judge spikes against the median before this sample joins the window
+    if (sampleCount > kRefreshInterval && ms > kSpikeFloorMs && ms > p50Ms * kSpikeFactor) {
+        ++spikeCount;
+    }
+
+    m_window[m_windowNext] = static_cast<float>(ms);
+    m_windowNext = (m_windowNext + 1) % kWindowSize;
+
+    if (sampleCount <= kRefreshInterval || sampleCount % kRefreshInterval == 0) {
+        refreshPercentiles();
+    }
+}
+
+void SystemTimingStats::refreshPercentiles() {
+    size_t count = static_cast<size_t>(std::min<uint64_t>(sampleCount, kWindowSize));
+    if (count == 0) {
+        p50Ms = p95Ms = p99Ms = 0.0;
+        return;
+    }
+
+    std::array<float, kWindowSize> sorted;
+    std::copy_n(m_window.begin(), count, sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(count));
+
+    // Nearest-rank percentile
+    auto rank = [count](double p) {
+        size_t r = static_cast<size_t>(p * static_cast<double>(count) + 0.999999);
+        return std::min(std::max<size_t>(r, 1), count) - 1;
+    };
+    p50Ms = sorted[rank(0.50)];
+    p95Ms = sorted[rank(0.95)];
+    p99Ms = sorted[rank(0.99)];
+}
+
+// =============================================================================
+// SystemScheduler
+// =============================================================================
+
+const System* SystemScheduler::checkFrameBudget(double frameMs, double budgetMs) {
+    const System* worst = nullptr;
+    double worstMs = 0.0;
+    double systemsMs = 0.0;
+
+    for (auto& [phase, systems] : m_phases) {
+        for (auto& system : systems) {
+            double ms = system->m_timing.frameMs;
+            systemsMs += ms;
+            if (ms > worstMs) {
+                worstMs = ms;
+                worst = system.get();
+            }
+            system->m_timing.frameMs = 0.0;
+        }
+    }
+
+    ++m_framesSinceAlarm;
+    if (budgetMs <= 0.0 || frameMs <= budgetMs) return nullptr;
+
+    ++m_budgetOverruns;
+    if (m_budgetAlarmEnabled && m_framesSinceAlarm >= kBudgetAlarmCooldown) {
+        m_framesSinceAlarm = 0;
+        if (worst) {
+            const auto& t = worst->getTimingStats();
+            LOG_WARN("Frame budget exceeded: {:.2f} ms of {:.2f} ms — slowest system '{}' "
+                     "took {:.2f} ms (p50 {:.2f} / p95 {:.2f} ms), systems total {:.2f} ms",
+                     frameMs, budgetMs, worst->getName(), worstMs, t.p50Ms, t.p95Ms, systemsMs);
+        } else {
+            LOG_WARN("Frame budget exceeded: {:.2f} ms of {:.2f} ms (no system time recorded)",
+                     frameMs, budgetMs);
+        }
+    }
+    return worst;
+}
+
+} // namespace gloaming
@@ -1,12 +1,19 @@
 #pragma once
 
 #include "ecs/Registry.hpp"
+#include "ecs/SystemGraph.hpp"
+#include "engine/Profiler.hpp"
+#include "engine/JobSystem.hpp"
 
 #include <string>
 #include <vector>
+#include <array>
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 #include <functional>
+#include <chrono>
+#include <cstdint>
 
 namespace gloaming {
 
@@ -23,11 +30,47 @@ enum class SystemPhase {
     PostRender      // After rendering (debug overlays, UI)
 };
 
+/// Rolling timing statistics for one system, recorded by SystemScheduler
+/// every time the system's update() runs.
+///
+/// Percentiles cover the last kWindowSize samples and are refreshed every
+/// kRefreshInterval samples. A spike is a sample above kSpikeFactor times
+/// the rolling median (and above kSpikeFloorMs, so near-zero systems don't
+/// count scheduler noise as spikes).
+struct SystemTimingStats {
+    static constexpr size_t kWindowSize      = 240;
+    static constexpr size_t kRefreshInterval = 30;
+    static constexpr double kSpikeFactor     = 3.0;
+    static constexpr double kSpikeFloorMs    = 0.25;
+
+    double lastMs  = 0.0;
+    double avgMs   = 0.0;
+    double maxMs   = 0.0;
+    double p50Ms   = 0.0;
+    double p95Ms   = 0.0;
+    double p99Ms   = 0.0;
+    double frameMs = 0.0;       ///< Time accumulated since the last frame budget check
+    uint64_t sampleCount = 0;
+    uint64_t spikeCount  = 0;
+
+    /// Record one update() duration.
+    void addSample(double ms);
+
+    /// Recompute p50/p95/p99 from the current window.
+    void refreshPercentiles();
+
+    void reset() { *this = SystemTimingStats{}; }
+
+private:
+    std::array<float, kWindowSize> m_window{};
+    size_t m_windowNext = 0;
+};
+
 /// Base class for all ECS systems
 class System {
 public:
     explicit System(const std::string& name, int priority = 0)
-        : m_name(name), m_priority(priority) {}
+        : m_name(name), m_priority(priority), m_zoneId(Profiler::zoneId(name)) {}
     virtual ~System() = default;
 
     // Non-copyable
@@ -56,21 +99,51 @@ public:
     void setEnabled(bool enabled) { m_enabled = enabled; }
     bool isEnabled() const { return m_enabled; }
 
+    /// Timing of this system's update() as measured by the scheduler.
+    const SystemTimingStats& getTimingStats() const { return m_timing; }
+
+    /// Declared component/resource access, or nullptr if the system never
+    /// declared any (it then always runs serially on the scheduler's thread).
+    const SystemAccess* getAccess() const { return m_accessDeclared ? &m_access : nullptr; }
+
 protected:
+    /// Declare what update() reads and writes (call from the constructor).
+    /// Declared systems that don't conflict may run concurrently on worker
+    /// threads; see SystemAccess for the rules.
+    SystemAccess& declareAccess() {
+        m_accessDeclared = true;
+        return m_access;
+    }
+
     Registry& getRegistry() { return *m_registry; }
     const Registry& getRegistry() const { return *m_registry; }
     Engine& getEngine() { return *m_engine; }
     const Engine& getEngine() const { return *m_engine; }
 
 private:
+    friend class SystemScheduler;
+
     std::string m_name;
     int m_priority = 0;
     bool m_enabled = true;
+    ProfileZoneId m_zoneId;
+    SystemTimingStats m_timing;
+    SystemAccess m_access;
+    bool m_accessDeclared = false;
     Registry* m_registry = nullptr;
     Engine* m_engine = nullptr;
 };
 
 /// System scheduler - manages system registration and execution
+///
+/// Every update() call is timed into the system's SystemTimingStats and, when
+/// a profiler is attached, into a profiler zone named after the system.
+///
+/// With a running JobSystem attached, each update phase is run as a
+/// dependency graph built from the systems' declared access: systems that
+/// don't conflict run concurrently on worker threads, while undeclared
+/// systems keep their exact serial position on the calling thread. Render
+/// phases always run serially (draw calls must stay on the main thread).
 class SystemScheduler {
 public:
     SystemScheduler() = default;
@@ -86,6 +159,60 @@ public:
         m_engine = &engine;
     }
 
+    /// Attach a profiler so each system gets its own zone (nullptr to detach).
+    void setProfiler(Profiler* profiler) { m_profiler = profiler; }
+
+    /// Attach a job system for parallel phases (nullptr = always serial).
+    void setJobSystem(JobSystem* jobs) { m_jobSystem = jobs; }
+
+    /// Allow/disallow parallel execution (default: allowed).
+    void setParallelEnabled(bool enabled) { m_parallelEnabled = enabled; }
+    bool isParallelEnabled() const { return m_parallelEnabled; }
+
+    /// Whether a phase currently runs as a parallel graph.
+    bool isPhaseParallel(SystemPhase phase) {
+        if (!m_parallelEnabled || !m_jobSystem || !m_jobSystem->isRunning() ||
+            !isUpdatePhase(phase)) {
+            return false;
+        }
+        auto it = m_phases.find(phase);
+        return it != m_phases.end() && it->second.size() > 1 &&
+               graphFor(phase, it->second).hasParallelism();
+    }
+
+    /// Call once per completed frame. If frameMs exceeds budgetMs, logs the
+    /// system that spent the most time this frame (at most once per
+    /// kBudgetAlarmCooldown frames) and returns it. Always resets the
+    /// per-frame accumulators.
+    const System* checkFrameBudget(double frameMs, double budgetMs);
+
+    /// Enable/disable the frame budget alarm log (detection still runs).
+    void setBudgetAlarmEnabled(bool enabled) { m_budgetAlarmEnabled = enabled; }
+    bool isBudgetAlarmEnabled() const { return m_budgetAlarmEnabled; }
+
+    /// Number of frames that exceeded the budget since startup.
+    uint64_t budgetOverrunCount() const { return m_budgetOverruns; }
+
+    /// Minimum frames between two budget alarm log lines.
+    static constexpr uint64_t kBudgetAlarmCooldown = 120;
+
+    /// Visit every system in execution order (phase by phase).
+    template<typename Fn>
+    void forEachSystem(Fn&& fn) const {
+        for (SystemPhase phase : kAllPhases) {
+            auto it = m_phases.find(phase);
+            if (it == m_phases.end()) continue;
+            for (const auto& system : it->second) fn(*system, phase);
+        }
+    }
+
+    /// Reset timing statistics of all systems.
+    void resetTimingStats() {
+        for (auto& [phase, systems] : m_phases) {
+            for (auto& system : systems) system->m_timing.reset();
+        }
+    }
+
     /// Add a system to a specific phase
     template<typename T, typename... Args>
     T* addSystem(SystemPhase phase, Args&&... args) {
@@ -137,6 +264,7 @@ public:
             if (it != systems.end()) {
                 (*it)->shutdown();
                 systems.erase(it);
+                m_graphs.erase(phase);
                 return true;
             }
         }
@@ -147,9 +275,13 @@ public:
     void runPhase(SystemPhase phase, float dt) {
         auto it = m_phases.find(phase);
         if (it != m_phases.end()) {
+            if (isPhaseParallel(phase)) {
+                runPhaseParallel(phase, it->second, dt);
+                return;
+            }
             for (auto& system : it->second) {
                 if (system->isEnabled()) {
-                    system->update(dt);
+                    runTimed(*system, dt);
                 }
             }
         }
@@ -177,6 +309,7 @@ public:
             }
         }
         m_phases.clear();
+        m_graphs.clear();
     }
 
     /// Get count of systems in a phase
@@ -202,9 +335,69 @@ public:
     }
 
 private:
+    using TimingClock = std::chrono::steady_clock;
+
+    static constexpr SystemPhase kAllPhases[] = {
+        SystemPhase::PreUpdate, SystemPhase::Update, SystemPhase::PostUpdate,
+        SystemPhase::PreRender, SystemPhase::Render, SystemPhase::PostRender
+    };
+
+    static bool isUpdatePhase(SystemPhase phase) {
+        return phase == SystemPhase::PreUpdate || phase == SystemPhase::Update ||
+               phase == SystemPhase::PostUpdate;
+    }
+
+    void runTimed(System& system, float dt) {
+        auto start = TimingClock::now();
+        if (m_profiler) {
+            // ScopedZone feeds stats on the main thread and traces on workers
+            Profiler::ScopedZone zone(*m_profiler, system.m_zoneId);
+            system.update(dt);
+        } else {
+            system.update(dt);
+        }
+        // Any system may have moved entities in place
+        if (m_registry) m_registry->touch();
+        double ms = std::chrono::duration<double, std::milli>(TimingClock::now() - start).count();
+        system.m_timing.addSample(ms);
+    }
+
+    SystemGraph& graphFor(SystemPhase phase, std::vector<std::unique_ptr<System>>& systems) {
+        auto& graph = m_graphs[phase];
+        if (!graph) {
+            graph = std::make_unique<SystemGraph>();
+            std::vector<const SystemAccess*> accesses;
+            accesses.reserve(systems.size());
+            for (auto& system : systems) {
+                const SystemAccess* access = system->getAccess();
+                if (access && m_registry) access->preparePools(*m_registry);
+                accesses.push_back(access);
+            }
+            graph->build(accesses);
+        }
+        return *graph;
+    }
+
+    void runPhaseParallel(SystemPhase phase, std::vector<std::unique_ptr<System>>& systems, float dt) {
+        struct Context {
+            SystemScheduler* scheduler;
+            std::vector<std::unique_ptr<System>>* systems;
+            float dt;
+        } ctx{this, &systems, dt};
+
+        // Capture a single pointer so the std::function needs no allocation
+        graphFor(phase, systems).execute(*m_jobSystem, [c = &ctx](size_t index) {
+            System& system = *(*c->systems)[index];
+            if (system.isEnabled()) c->scheduler->runTimed(system, c->dt);
+        });
+    }
+
     void sortPhase(SystemPhase phase) {
+        m_graphs.erase(phase);
         auto& systems = m_phases[phase];
-        std::sort(systems.begin(), systems.end(),
+        // Stable: equal priorities keep registration order, so the serial
+        // fallback order and the dependency graph are deterministic
+        std::stable_sort(systems.begin(), systems.end(),
             [](const auto& a, const auto& b) {
                 return a->getPriority() < b->getPriority();
             });
@@ -213,6 +406,14 @@ private:
     std::unordered_map<SystemPhase, std::vector<std::unique_ptr<System>>> m_phases;
     Registry* m_registry = nullptr;
     Engine* m_engine = nullptr;
+    Profiler* m_profiler = nullptr;
+    JobSystem* m_jobSystem = nullptr;
+    bool m_parallelEnabled = true;
+    std::unordered_map<SystemPhase, std::unique_ptr<SystemGraph>> m_graphs;
+
+    bool m_budgetAlarmEnabled = true;
+    uint64_t m_budgetOverruns = 0;
+    uint64_t m_framesSinceAlarm = kBudgetAlarmCooldown;
 };
 
 } // namespace gloaming
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "ecs/Registry.hpp"
+#include "ecs/Components.hpp"
+
+namespace gloaming {
+
+/// Transform of a rendered entity at the previous simulation tick, plus the
+/// simulated Transform while an interpolated one is being drawn.
+/// Managed by TransformInterpolator; added automatically to sprites.
+struct TransformHistory {
+    Vec2 previousPosition{0.0f, 0.0f};
+    float previousRotation = 0.0f;
+    Vec2 simulatedPosition{0.0f, 0.0f};
+    float simulatedRotation = 0.0f;
+    bool hasPrevious = false;
+    bool interpolated = false;
+};
+
+/// Smooths sprite motion when the simulation runs at a fixed tick rate that
+/// differs from the render rate.
+///
+/// Per frame:
+///   for each tick: interpolator.beginTick(registry); simulate();
+///   interpolator.apply(registry, fixed.alpha());
+///   render();
+///   interpolator.restore(registry);
+///
+/// apply() temporarily moves each sprite's Transform to
+/// lerp(previous tick, current tick, alpha); restore() puts the simulated
+/// values back, so render code needs no changes and gameplay never sees an
+/// interpolated value. Writes to Transform during rendering are discarded.
+class TransformInterpolator {
+public:
+    /// Moves longer than this in one tick are treated as teleports and drawn
+    /// without interpolation (0 = always interpolate).
+    void setSnapDistance(float distance) { m_snapDistance = distance; }
+    float getSnapDistance() const { return m_snapDistance; }
+
+    /// Record every sprite's Transform as the previous tick's state.
+    /// Call right before each simulation tick.
+    void beginTick(Registry& registry) {
+        registry.each<Transform, Sprite>([&registry](Entity entity, const Transform& transform,
+                                                     const Sprite& /*sprite*/) {
+            TransformHistory* history = registry.tryGet<TransformHistory>(entity);
+            if (!history) history = &registry.add<TransformHistory>(entity);
+            history->previousPosition = transform.position;
+            history->previousRotation = transform.rotation;
+            history->hasPrevious = true;
+        });
+    }
+
+    /// Move Transforms to their interpolated render state.
+    void apply(Registry& registry, float alpha) {
+        const float snapSq = m_snapDistance * m_snapDistance;
+        registry.each<Transform, TransformHistory>([alpha, snapSq](Entity /*entity*/, Transform& transform,
+                                                                   TransformHistory& history) {
+            if (!history.hasPrevious) return;
+
+            Vec2 delta = transform.position - history.previousPosition;
+            if (snapSq > 0.0f && delta.x * delta.x + delta.y * delta.y > snapSq) return;
+
+            history.simulatedPosition = transform.position;
+            history.simulatedRotation = transform.rotation;
+            history.interpolated = true;
+
+            transform.position = history.previousPosition + delta * alpha;
+            transform.rotation = lerpAngle(history.previousRotation, transform.rotation, alpha);
+        });
+    }
+
+    /// Restore the simulated Transforms after rendering.
+    void restore(Registry& registry) {
+        registry.each<Transform, TransformHistory>([](Entity /*entity*/, Transform& transform,
+                                                      TransformHistory& history) {
+            if (!history.interpolated) return;
+            transform.position = history.simulatedPosition;
+            transform.rotation = history.simulatedRotation;
+            history.interpolated = false;
+        });
+    }
+
+    /// Interpolate degrees along the shorter arc.
+    static float lerpAngle(float from, float to, float t) {
+        float diff = to - from;
+        while (diff > 180.0f) diff -= 360.0f;
+        while (diff < -180.0f) diff += 360.0f;
+        return from + diff * t;
+    }
+
+private:
+    float m_snapDistance = 256.0f;
+};
+
+} // namespace gloaming
@@ -19,6 +19,15 @@ void DiagnosticOverlay::cycle() {
     }
 }
 
+bool DiagnosticOverlay::triggerCapture(Profiler& profiler) {
+    if (!profiler.capture(m_captureFrames)) {
+        LOG_WARN("DiagnosticOverlay: profiler capture already in progress");
+        return false;
+    }
+    LOG_INFO("DiagnosticOverlay: trace capture requested ({} frames)", m_captureFrames);
+    return true;
+}
+
 void DiagnosticOverlay::render(IRenderer* renderer, const Profiler& profiler,
                                 const ResourceManager& resources, Engine& engine) {
     if (m_mode == DiagnosticMode::Off || !renderer) return;
@@ -81,6 +90,42 @@ void DiagnosticOverlay::renderFull(IRenderer* renderer, const Profiler& profiler
     // Calculate panel height based on content
     const auto& zones = profiler.getAllZoneStats();
     int zoneLines = static_cast<int>(zones.size());
+    bool showCapture = profiler.isCapturing() || !profiler.lastCapturePath().empty();
+    if (showCapture) ++zoneLines;
+
+    // Slowest systems by rolling p95
+    m_slowSystems.clear();
+    engine.getSystemScheduler().forEachSystem([this](const System& system, SystemPhase) {
+        if (system.getTimingStats().sampleCount > 0) m_slowSystems.push_back(&system);
+    });
+    size_t systemLines = std::min(m_slowSystems.size(), kMaxSystemLines);
+    std::partial_sort(m_slowSystems.begin(),
+                      m_slowSystems.begin() + static_cast<std::ptrdiff_t>(systemLines),
+                      m_slowSystems.end(),
+                      [](const System* a, const System* b) {
+                          return a->getTimingStats().p95Ms > b->getTimingStats().p95Ms;
+                      });
+    if (systemLines > 0) zoneLines += static_cast<int>(systemLines) + 1;
+
+    // Mods spending the most Lua time per frame
+    const LuaCpuBudget& cpuBudget = engine.getModLoader().getLuaBindings().getCpuBudget();
+    m_slowMods.clear();
+    for (const auto& stats : cpuBudget.getStats()) {
+        if (stats.calls > 0) m_slowMods.push_back(&stats);
+    }
+    size_t modLines = std::min(m_slowMods.size(), kMaxModLines);
+    std::partial_sort(m_slowMods.begin(),
+                      m_slowMods.begin() + static_cast<std::ptrdiff_t>(modLines),
+                      m_slowMods.end(),
+                      [](const LuaCpuBudget::ModStats* a, const LuaCpuBudget::ModStats* b) {
+                          return a->avgFrameMs > b->avgFrameMs;
+                      });
+    if (modLines > 0) zoneLines += static_cast<int>(modLines) + 1;
+
+    // Lua collector pacing, one line
+    const LuaGcScheduler::Stats& gcStats =
+        engine.getModLoader().getLuaBindings().getGcScheduler().getStats();
+    zoneLines += 1;
     float panelHeight = kLineHeight * (14 + zoneLines) + kGraphHeight + kPadding * 4;
 
     // Background panel
@@ -117,10 +162,14 @@ void DiagnosticOverlay::renderFull(IRenderer* renderer, const Profiler& profiler
     if (!zones.empty()) {
         y = drawLine(renderer, x, y, "-- Profiler Zones --",
                      Color(200, 200, 255, 255));
-        for (const auto& zone : zones) {
+        buildZoneOrder(profiler);
+        for (size_t index : m_zoneOrder) {
+            const auto& zone = zones[index];
+            int indent = 2 + 2 * static_cast<int>(std::min<uint32_t>(zone.depth, 6));
             char buf[128];
-            snprintf(buf, sizeof(buf), "  %-16s %6.2f ms (avg %5.2f)",
-                     zone.name.c_str(), zone.lastTimeMs, zone.avgTimeMs);
+            snprintf(buf, sizeof(buf), "%*s%-*s %6.2f ms (avg %5.2f)",
+                     indent, "", std::max(4, 18 - indent), zone.name.c_str(),
+                     zone.lastTimeMs, zone.avgTimeMs);
 
             Color color = Color::White();
             if (zone.lastTimeMs > profiler.frameBudgetMs() * 0.5) {
@@ -133,6 +182,70 @@ void DiagnosticOverlay::renderFull(IRenderer* renderer, const Profiler& profiler
         }
     }
 
+    // ---- Systems ----
+    if (systemLines > 0) {
+        y = drawLine(renderer, x, y, "-- Systems (p50 / p95 / p99 ms, spikes) --",
+                     Color(200, 200, 255, 255));
+        for (size_t i = 0; i < systemLines; ++i) {
+            const System& system = *m_slowSystems[i];
+            const auto& t = system.getTimingStats();
+            char buf[128];
+            snprintf(buf, sizeof(buf), "  %-18.18s %5.2f %5.2f %5.2f  %llu",
+                     system.getName().c_str(), t.p50Ms, t.p95Ms, t.p99Ms,
+                     static_cast<unsigned long long>(t.spikeCount));
+
+            Color color = Color::White();
+            if (t.p95Ms > profiler.frameBudgetMs() * 0.25) color = Color(255, 200, 0, 255);
+            if (t.p95Ms > profiler.frameBudgetMs() * 0.5)  color = Color(255, 80, 80, 255);
+            y = drawLine(renderer, x, y, buf, color);
+        }
+    }
+
+    // ---- Lua mods ----
+    if (modLines > 0) {
+        y = drawLine(renderer, x, y, "-- Lua mods (avg / max call ms, overruns, aborts) --",
+                     Color(200, 200, 255, 255));
+        double softMs = cpuBudget.getSettings().softFrameMs;
+        for (size_t i = 0; i < modLines; ++i) {
+            const LuaCpuBudget::ModStats& stats = *m_slowMods[i];
+            char buf[128];
+            snprintf(buf, sizeof(buf), "  %-18.18s %5.2f %6.2f  %llu  %llu",
+                     stats.modId.c_str(), stats.avgFrameMs, stats.maxCallMs,
+                     static_cast<unsigned long long>(stats.softOverruns),
+                     static_cast<unsigned long long>(stats.hardAborts));
+
+            Color color = Color::White();
+            if (softMs > 0.0 && stats.avgFrameMs > softMs * 0.5) color = Color(255, 200, 0, 255);
+            if ((softMs > 0.0 && stats.avgFrameMs > softMs) || stats.hardAborts > 0) {
+                color = Color(255, 80, 80, 255);
+            }
+            y = drawLine(renderer, x, y, buf, color);
+        }
+    }
+
+    // ---- Lua GC ----
+    {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "Lua GC: %.2f ms avg / %.2f max | %.0f KB | %llu cycles, %llu full",
+                 gcStats.avgFrameMs, gcStats.maxFrameMs, gcStats.memoryKb,
+                 static_cast<unsigned long long>(gcStats.cycles),
+                 static_cast<unsigned long long>(gcStats.fullCollections));
+        y = drawLine(renderer, x, y, buf, Color(200, 200, 255, 255));
+    }
+
+    // ---- Trace capture ----
+    if (showCapture) {
+        char buf[192];
+        if (profiler.isCapturing()) {
+            snprintf(buf, sizeof(buf), "Capturing trace: %d frames left",
+                     profiler.captureFramesRemaining());
+        } else {
+            snprintf(buf, sizeof(buf), "Last trace: %s (F5 to capture)",
+                     profiler.lastCapturePath().c_str());
+        }
+        y = drawLine(renderer, x, y, buf, Color(255, 150, 150, 255));
+    }
+
     // ---- Frame graph ----
     y += 4;
     drawFrameGraph(renderer, x, y, profiler);
@@ -203,6 +316,31 @@ void DiagnosticOverlay::renderFull(IRenderer* renderer, const Profiler& profiler
 // Drawing helpers
 // =============================================================================
 
+void DiagnosticOverlay::buildZoneOrder(const Profiler& profiler) {
+    const auto& zones = profiler.getAllZoneStats();
+    m_zoneOrder.clear();
+
+    // Depth-first from each root so children sit under their parent even if
+    // they were first seen later. Zone counts are small; quadratic is fine.
+    auto visit = [&](auto& self, ProfileZoneId parent, uint32_t depth) -> void {
+        for (size_t i = 0; i < zones.size(); ++i) {
+            if (zones[i].parentId != parent || zones[i].depth != depth) continue;
+            m_zoneOrder.push_back(i);
+            if (depth < 32) self(self, zones[i].id, depth + 1);
+        }
+    };
+    visit(visit, ProfileZoneStats::kNoParent, 0);
+
+    // Anything not reachable (e.g. parent re-parented since) goes at the end
+    if (m_zoneOrder.size() < zones.size()) {
+        std::vector<bool> seen(zones.size(), false);
+        for (size_t i : m_zoneOrder) seen[i] = true;
+        for (size_t i = 0; i < zones.size(); ++i) {
+            if (!seen[i]) m_zoneOrder.push_back(i);
+        }
+    }
+}
+
 void DiagnosticOverlay::drawFrameGraph(IRenderer* renderer, float x, float y,
                                         const Profiler& profiler) {
     const auto& history = profiler.frameTimeHistory();
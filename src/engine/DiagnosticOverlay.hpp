@@ -1,14 +1,17 @@
 #pragma once
 
 #include "rendering/IRenderer.hpp"
+#include "mod/LuaCpuBudget.hpp"
 
 #include <string>
+#include <vector>
 
 namespace gloaming {
 
 // Forward declarations
 class Engine;
 class Profiler;
+class System;
 class ResourceManager;
 
 /// Display mode for the diagnostic overlay.
@@ -20,11 +23,12 @@ enum class DiagnosticMode {
 
 /// Renders performance diagnostics as a screen-space overlay.
 ///
-/// Three modes cycled by F2:
+/// Three modes cycled by F2 (F5 starts a profiler trace capture):
 ///   Off     → nothing
 ///   Minimal → compact FPS + frame budget bar in the top-right corner
 ///   Full    → detailed breakdown with per-zone profiler times, frame time
-///             graph, resource stats, entity counts, and system states
+///             graph, resource stats, entity counts, system states, and the
+///             mods spending the most Lua time
 ///
 /// The overlay replaces the previous hard-coded HUD text in Engine::render()
 /// when enabled, providing a cleaner separation of concerns.
@@ -42,6 +46,14 @@ public:
     /// Whether any overlay is being displayed.
     bool isVisible() const { return m_mode != DiagnosticMode::Off; }
 
+    /// Start a Chrome Trace capture of the next getCaptureFrames() frames.
+    /// Returns false if the profiler is already capturing.
+    bool triggerCapture(Profiler& profiler);
+
+    /// Number of frames captured by triggerCapture() (default: 120).
+    void setCaptureFrames(int frames) { if (frames > 0) m_captureFrames = frames; }
+    int getCaptureFrames() const { return m_captureFrames; }
+
     /// Render the overlay. Call after all game rendering is complete,
     /// before the renderer's endFrame().
     void render(IRenderer* renderer, const Profiler& profiler,
@@ -49,6 +61,12 @@ public:
 
 private:
     DiagnosticMode m_mode = DiagnosticMode::Off;
+    int m_captureFrames = 120;
+
+    // Scratch for drawing profiler zones in tree order and the slowest systems/mods
+    std::vector<size_t> m_zoneOrder;
+    std::vector<const System*> m_slowSystems;
+    std::vector<const LuaCpuBudget::ModStats*> m_slowMods;
 
     // Layout constants
     static constexpr int kFontSize     = 14;
@@ -58,12 +76,17 @@ private:
     static constexpr int kGraphWidth   = 240;
     static constexpr int kBarHeight    = 8;
     static constexpr int kBarWidth     = 200;
+    static constexpr size_t kMaxSystemLines = 8;
+    static constexpr size_t kMaxModLines = 6;
 
     // Section renderers
     void renderMinimal(IRenderer* renderer, const Profiler& profiler);
     void renderFull(IRenderer* renderer, const Profiler& profiler,
                     const ResourceManager& resources, Engine& engine);
 
+    /// Fill m_zoneOrder with zone indices ordered depth-first by parent.
+    void buildZoneOrder(const Profiler& profiler);
+
     /// Draw the frame time graph from the profiler history.
     void drawFrameGraph(IRenderer* renderer, float x, float y,
                         const Profiler& profiler);
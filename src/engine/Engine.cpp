@@ -5,6 +5,7 @@
 #include "engine/SystemSupportLuaBindings.hpp"
 #include "engine/ConfigPersistenceLuaBindings.hpp"
 #include "rendering/RaylibRenderer.hpp"
+#include "rendering/NullRenderer.hpp"
 #include "ecs/CoreSystems.hpp"
 #include "gameplay/Gameplay.hpp"
 #include "gameplay/GameplayLuaBindings.hpp"
@@ -18,9 +19,12 @@
 #include "world/WorldGenLuaBindings.hpp"
 
 #include <raylib.h>
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <csignal>
 #include <filesystem>
+#include <thread>
 
 namespace gloaming {
 
@@ -46,6 +50,14 @@ void Engine::emitShutdownOnce() {
 }
 
 bool Engine::init(const std::string& configPath) {
+    LaunchOptions launch;
+    launch.configPath = configPath;
+    return init(launch);
+}
+
+bool Engine::init(const LaunchOptions& launch) {
+    const std::string& configPath = launch.configPath;
+
     // Load configuration
     if (!m_config.loadFromFile(configPath)) {
         // Initialize logging with defaults before reporting the error
@@ -77,6 +89,20 @@ bool Engine::init(const std::string& configPath) {
 
     LOG_INFO("Gloaming Engine v{} starting...", kEngineVersion);
 
+    for (const auto& error : launch.errors) {
+        LOG_WARN("Command line: {}", error);
+    }
+
+    // Headless mode: config "headless" section, overridable from the command line
+    m_headless.enabled  = m_config.getBool("headless.enabled", false);
+    m_headless.tickRate = m_config.getFloat("headless.tick_rate",
+                                            m_config.getFloat("simulation.tick_rate", 60.0f));
+    m_headless.maxTicks = static_cast<uint64_t>(std::max(0, m_config.getInt("headless.max_ticks", 0)));
+    m_headless.realtime = m_config.getBool("headless.realtime", true);
+    m_headless.reportPath = m_config.getString("headless.report", "");
+    launch.applyTo(m_headless);
+    if (m_headless.tickRate <= 0.0) m_headless.tickRate = 60.0;
+
     // Platform-aware defaults for Steam Deck
     bool onDeck = SteamIntegration::isSteamDeck();
     int defaultWidth  = 1280;
@@ -96,18 +122,29 @@ bool Engine::init(const std::string& configPath) {
     if (fsMode == "exclusive")       winCfg.fullscreenMode = FullscreenMode::Fullscreen;
     else if (fsMode == "windowed")   winCfg.fullscreenMode = FullscreenMode::Windowed;
     else                             winCfg.fullscreenMode = FullscreenMode::BorderlessFullscreen;
+    winCfg.headless = m_headless.enabled;
 
     if (!m_window.init(winCfg)) {
         LOG_CRITICAL("Failed to create window");
         return false;
     }
 
-    LOG_INFO("Window created: {}x{} ({})",
-             winCfg.width, winCfg.height,
-             winCfg.fullscreen ? "fullscreen" : "windowed");
+    if (m_headless.enabled) {
+        LOG_INFO("Headless mode: no window ({}x{} virtual screen), {:.0f} Hz ticks, {}",
+                 winCfg.width, winCfg.height, m_headless.tickRate,
+                 m_headless.realtime ? "realtime" : "as fast as possible");
+    } else {
+        LOG_INFO("Window created: {}x{} ({})",
+                 winCfg.width, winCfg.height,
+                 winCfg.fullscreen ? "fullscreen" : "windowed");
+    }
 
     // Initialize renderer
-    m_renderer = std::make_unique<RaylibRenderer>();
+    if (m_headless.enabled) {
+        m_renderer = std::make_unique<NullRenderer>();
+    } else {
+        m_renderer = std::make_unique<RaylibRenderer>();
+    }
     if (!m_renderer->init(winCfg.width, winCfg.height)) {
         LOG_CRITICAL("Failed to initialize renderer");
         return false;
@@ -135,9 +172,20 @@ bool Engine::init(const std::string& configPath) {
 
     // Initialize ECS
     m_systemScheduler.init(m_registry, *this);
+    m_systemScheduler.setProfiler(&m_profiler);
+
+    // Worker pool for systems with declared, non-conflicting access
+    // (-1 = one per spare hardware thread, 0 = run everything on this thread)
+    int workerThreads = m_config.getInt("performance.worker_threads", -1);
+    m_jobSystem.start(workerThreads < 0 ? JobSystem::defaultWorkerCount()
+                                        : static_cast<unsigned>(workerThreads),
+                      &m_profiler);
+    m_systemScheduler.setJobSystem(&m_jobSystem);
+    m_profiler.setBackgroundTraceWrites(true);
+    m_systemScheduler.setParallelEnabled(m_config.getBool("performance.parallel_systems", true));
     m_entityFactory.setTextureManager(&m_textureManager);
 
-    LOG_INFO("ECS initialized");
+    LOG_INFO("ECS initialized ({} worker threads)", m_jobSystem.workerCount());
 
     // Initialize world system with default config
     TileMapConfig tileMapConfig;
@@ -202,7 +250,7 @@ bool Engine::init(const std::string& configPath) {
     // Initialize audio system (Stage 7)
     {
         AudioConfig audioCfg;
-        audioCfg.enabled = m_config.getBool("audio.enabled", true);
+        audioCfg.enabled = m_config.getBool("audio.enabled", true) && !m_headless.enabled;
         audioCfg.masterVolume = m_config.getFloat("audio.master_volume", 1.0f);
         audioCfg.sfxVolume = m_config.getFloat("audio.sfx_volume", 0.8f);
         audioCfg.musicVolume = m_config.getFloat("audio.music_volume", 0.7f);
@@ -235,7 +283,7 @@ bool Engine::init(const std::string& configPath) {
         });
 
         // State machine system (for entity AI)
-        m_systemScheduler.addSystem<StateMachineSystem>(SystemPhase::Update);
+        m_stateMachineSystem = m_systemScheduler.addSystem<StateMachineSystem>(SystemPhase::Update);
 
         // Animation controller system (Stage 10)
         m_systemScheduler.addSystem<AnimationControllerSystem>(SystemPhase::Update);
@@ -249,6 +297,9 @@ bool Engine::init(const std::string& configPath) {
         // Initialize entity spawning helpers (Stage 11)
         m_entitySpawning.setRegistry(&m_registry);
         m_entitySpawning.setEntityFactory(&m_entityFactory);
+        m_spatialIndex.setCellSize(m_config.getFloat("performance.spatial_cell_size",
+                                                     SpatialIndex::kDefaultCellSize));
+        m_entitySpawning.setSpatialIndex(&m_spatialIndex);
 
         // Wire dialogue system to use InputActions for key rebinding support
         m_dialogueSystem.setInputActions(&m_inputActions);
@@ -274,6 +325,15 @@ bool Engine::init(const std::string& configPath) {
 
         // NPC, Housing & Shop systems (Stage 15)
         m_npcSystem = m_systemScheduler.addSystem<NPCSystem>(SystemPhase::Update);
+
+        // AI level of detail: enemies/NPCs far from players and the camera
+        // update every few frames instead of every frame
+        AILodConfig aiLod;
+        aiLod.enabled = m_config.getBool("ai.lod_enabled", true);
+        aiLod.nearDistance = m_config.getFloat("ai.lod_near_distance", aiLod.nearDistance);
+        aiLod.midDistance = m_config.getFloat("ai.lod_mid_distance", aiLod.midDistance);
+        m_enemyAISystem->setLodConfig(aiLod);
+        m_npcSystem->setLodConfig(aiLod);
         m_housingSystem = m_systemScheduler.addSystem<HousingSystem>(SystemPhase::PostUpdate);
         m_shopManager.setContentRegistry(&m_modLoader.getContentRegistry());
         m_shopManager.setEventBus(&m_modLoader.getEventBus());
@@ -305,6 +365,26 @@ bool Engine::init(const std::string& configPath) {
     ModLoaderConfig modConfig;
     modConfig.modsDirectory = m_config.getString("mods.directory", "mods");
     modConfig.configFile = m_config.getString("mods.config", "config/mods.json");
+    modConfig.bytecodeCacheDirectory = m_config.getString("mods.bytecode_cache_dir", "cache/lua");
+    modConfig.bytecodeCacheKeyFile = m_config.getString("mods.bytecode_cache_key", "config/lua_cache.key");
+    modConfig.cpuBudget.softFrameMs = m_config.getFloat("mods.cpu_soft_frame_ms",
+        static_cast<float>(modConfig.cpuBudget.softFrameMs));
+    modConfig.cpuBudget.hardCallMs = m_config.getFloat("mods.cpu_hard_call_ms",
+        static_cast<float>(modConfig.cpuBudget.hardCallMs));
+    modConfig.cpuBudget.hardCallInstructions = static_cast<uint64_t>(std::max(0,
+        m_config.getInt("mods.cpu_hard_call_instructions",
+                        static_cast<int>(modConfig.cpuBudget.hardCallInstructions))));
+    modConfig.cpuBudget.loadCallMs = m_config.getFloat("mods.cpu_load_call_ms",
+        static_cast<float>(modConfig.cpuBudget.loadCallMs));
+    modConfig.cpuBudget.loadCallInstructions = static_cast<uint64_t>(std::max(0,
+        m_config.getInt("mods.cpu_load_call_instructions",
+                        static_cast<int>(modConfig.cpuBudget.loadCallInstructions))));
+    modConfig.gc.enginePaced = m_config.getBool("mods.gc_engine_paced", modConfig.gc.enginePaced);
+    modConfig.gc.pause = m_config.getInt("mods.gc_pause", modConfig.gc.pause);
+    modConfig.gc.stepMultiplier = m_config.getInt("mods.gc_step_multiplier", modConfig.gc.stepMultiplier);
+    modConfig.gc.stepSizeKb = m_config.getInt("mods.gc_step_size_kb", modConfig.gc.stepSizeKb);
+    modConfig.gc.maxFrameMs = m_config.getFloat("mods.gc_max_frame_ms",
+        static_cast<float>(modConfig.gc.maxFrameMs));
 
     if (m_modLoader.init(*this, modConfig)) {
         // Register gameplay Lua APIs (available to all mods)
@@ -385,6 +465,7 @@ bool Engine::init(const std::string& configPath) {
                 int loaded = m_modLoader.loadMods();
                 m_modLoader.postInitMods();
                 m_modLoader.getContentRegistry().validateNPCReferences();
+                packModTextures();
                 LOG_INFO("Mod system: {}/{} mods loaded successfully", loaded, discovered);
             }
         } else {
@@ -399,6 +480,8 @@ bool Engine::init(const std::string& configPath) {
         int targetFPS = m_config.getInt("profiler.target_fps", 60);
         m_profiler.setTargetFPS(targetFPS);
         m_profiler.setEnabled(m_config.getBool("profiler.enabled", true));
+        m_diagnosticOverlay.setCaptureFrames(m_config.getInt("profiler.capture_frames", 120));
+        m_systemScheduler.setBudgetAlarmEnabled(m_config.getBool("profiler.budget_alarm", true));
 
         LOG_INFO("Profiler initialized (target={}fps, budget={:.2f}ms, enabled={})",
                  targetFPS, m_profiler.frameBudgetMs(), m_profiler.isEnabled());
@@ -411,7 +494,7 @@ bool Engine::init(const std::string& configPath) {
 
         bool rumbleEnabled = m_config.getBool("input.rumble_enabled", true);
         float rumbleIntensity = m_config.getFloat("input.rumble_intensity", 1.0f);
-        m_haptics.setEnabled(rumbleEnabled);
+        m_haptics.setEnabled(rumbleEnabled && !m_headless.enabled);
         m_haptics.setIntensity(rumbleIntensity);
 
         std::string glyphStyle = m_config.getString("input.glyph_style", "auto");
@@ -464,7 +547,7 @@ bool Engine::init(const std::string& configPath) {
 
         // Target FPS (for battery management on Deck)
         int targetFPS = m_config.getInt("performance.target_fps", onDeck ? 60 : 0);
-        if (targetFPS > 0) {
+        if (targetFPS > 0 && !m_headless.enabled) {
             m_time.setTargetFPS(targetFPS);
         }
 
@@ -479,6 +562,45 @@ bool Engine::init(const std::string& configPath) {
         }
     }
 
+    // Fixed-tick simulation (off = one variable-length step per frame)
+    {
+        // Headless runs are already one fixed tick per loop iteration
+        FixedTimestepConfig fixedCfg;
+        fixedCfg.enabled = m_config.getBool("simulation.fixed_timestep", false) && !m_headless.enabled;
+        fixedCfg.tickRate = m_config.getFloat("simulation.tick_rate", 60.0f);
+        fixedCfg.maxStepsPerFrame = m_config.getInt("simulation.max_steps_per_frame", 5);
+        m_fixedTimestep.setConfig(fixedCfg);
+        m_transformInterpolator.setSnapDistance(
+            m_config.getFloat("simulation.interpolation_snap_distance", 256.0f));
+
+        if (m_fixedTimestep.isEnabled()) {
+            LOG_INFO("Fixed timestep: {:.0f} Hz, up to {} ticks per frame",
+                     m_fixedTimestep.getConfig().tickRate,
+                     m_fixedTimestep.getConfig().maxStepsPerFrame);
+        }
+    }
+
+    // Networking: replicate NetworkSync entities as server, or mirror them as client
+    {
+        std::string mode = m_config.getString("network.mode", "off");
+        ReplicationConfig netCfg;
+        netCfg.host = m_config.getString("network.host", "127.0.0.1");
+        netCfg.port = static_cast<uint16_t>(std::clamp(m_config.getInt("network.port", 27015), 0, 65535));
+        netCfg.snapshotRate = m_config.getFloat("network.snapshot_rate", 20.0f);
+        netCfg.maxPacketBytes = static_cast<size_t>(
+            std::clamp(m_config.getInt("network.max_packet_bytes", 1200), 64, 1500));
+        netCfg.timeout = m_config.getFloat("network.timeout", 5.0f);
+        netCfg.maxClients = static_cast<size_t>(std::max(m_config.getInt("network.max_clients", 16), 0));
+
+        if (mode == "server") {
+            m_replicationServer.start(netCfg);
+        } else if (mode == "client") {
+            m_replicationClient.connect(netCfg);
+        } else if (mode != "off") {
+            LOG_WARN("Unknown network.mode '{}' — networking disabled", mode);
+        }
+    }
+
     // Stage 19C: Seamlessness — install signal handlers for graceful exit
     {
         std::signal(SIGTERM, Engine::signalHandler);
@@ -501,22 +623,32 @@ bool Engine::init(const std::string& configPath) {
     return true;
 }
 
+bool Engine::checkTerminationSignal() {
+    // Stage 19C: Check for OS termination signals (SIGTERM/SIGINT)
+    if (!s_signalReceived.load(std::memory_order_relaxed)) return false;
+
+    LOG_INFO("Termination signal received — initiating graceful shutdown");
+    emitShutdownOnce();
+    if (m_saveSystem.isDirty()) {
+        LOG_INFO("Auto-saving before signal exit...");
+        m_saveSystem.saveAll();
+    }
+    m_running = false;
+    return true;
+}
+
 void Engine::run() {
+    if (m_headless.enabled) {
+        runHeadless();
+        return;
+    }
+
     LOG_INFO("Entering main loop");
 
     while (m_running && !m_window.shouldClose()) {
-        // Stage 19C: Check for OS termination signals (SIGTERM/SIGINT)
-        if (s_signalReceived.load(std::memory_order_relaxed)) {
-            LOG_INFO("Termination signal received — initiating graceful shutdown");
-            emitShutdownOnce();
-            if (m_saveSystem.isDirty()) {
-                LOG_INFO("Auto-saving before signal exit...");
-                m_saveSystem.saveAll();
-            }
-            m_running = false;
-            break;
-        }
+        if (checkTerminationSignal()) break;
 
+        const auto frameStart = std::chrono::steady_clock::now();
         m_profiler.beginFrame();
 
         double dt = static_cast<double>(GetFrameTime());
@@ -534,13 +666,92 @@ void Engine::run() {
             auto z = m_profiler.scopedZone("Render");
             render();
         }
+        {
+            // Slack is the budget minus the frame's own work. Time spent
+            // waiting in present is not work: counting it would leave the
+            // collector no slack at all whenever vsync is on.
+            auto z = m_profiler.scopedZone("LuaGC");
+            double usedMs = std::chrono::duration<double, std::milli>(
+                m_presentStart - frameStart).count();
+            m_modLoader.getLuaBindings().getGcScheduler().step(m_profiler.frameBudgetMs() - usedMs);
+        }
 
         m_profiler.endFrame();
+
+        // Name the system that blew the frame budget (budget 0 = just reset counters)
+        m_systemScheduler.checkFrameBudget(m_profiler.frameTimeMs(),
+            m_profiler.isEnabled() ? m_profiler.frameBudgetMs() : 0.0);
+        m_modLoader.getLuaBindings().getCpuBudget().endFrame();
     }
 
     LOG_INFO("Main loop exited");
 }
 
+void Engine::runHeadless() {
+    using Clock = std::chrono::steady_clock;
+
+    const double tickDt = 1.0 / m_headless.tickRate;
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(tickDt));
+
+    if (m_headless.maxTicks > 0) {
+        LOG_INFO("Entering headless loop ({} ticks)", m_headless.maxTicks);
+    } else {
+        LOG_INFO("Entering headless loop (until shutdown)");
+    }
+
+    HeadlessReport report;
+    const auto start = Clock::now();
+    auto nextTick = start;
+
+    // No input, no rendering: each iteration is exactly one simulation tick
+    while (m_running && (m_headless.maxTicks == 0 || report.ticks() < m_headless.maxTicks)) {
+        if (checkTerminationSignal()) break;
+
+        const auto tickStart = Clock::now();
+        m_profiler.beginFrame();
+
+        m_time.update(tickDt);
+        {
+            auto z = m_profiler.scopedZone("Update");
+            update(m_time.deltaTime());
+        }
+        {
+            auto z = m_profiler.scopedZone("LuaGC");
+            double usedMs = std::chrono::duration<double, std::milli>(Clock::now() - tickStart).count();
+            m_modLoader.getLuaBindings().getGcScheduler().step(tickDt * 1000.0 - usedMs);
+        }
+
+        m_profiler.endFrame();
+        m_systemScheduler.checkFrameBudget(m_profiler.frameTimeMs(),
+            m_profiler.isEnabled() ? m_profiler.frameBudgetMs() : 0.0);
+        m_modLoader.getLuaBindings().getCpuBudget().endFrame();
+        report.recordTick(std::chrono::duration<double, std::milli>(Clock::now() - tickStart).count());
+
+        if (m_headless.realtime) {
+            nextTick += tickDuration;
+            auto now = Clock::now();
+            if (nextTick > now) {
+                std::this_thread::sleep_until(nextTick);
+            } else if (now - nextTick > tickDuration * 15) {
+                nextTick = now;   // Fell far behind: don't burst to catch up
+            }
+        }
+    }
+
+    report.finish(std::chrono::duration<double>(Clock::now() - start).count(),
+                  static_cast<double>(report.ticks()) * tickDt);
+
+    LOG_INFO("Headless loop exited: {} ticks in {:.2f}s ({:.3f} ms/tick avg, {:.3f} p95, {:.3f} max)",
+             report.ticks(), report.wallSeconds(), report.avgTickMs(),
+             report.percentileTickMs(95.0), report.maxTickMs());
+
+    if (!m_headless.reportPath.empty() &&
+        report.writeJson(m_headless.reportPath, m_profiler.getAllZoneStats())) {
+        LOG_INFO("Headless report written to '{}'", m_headless.reportPath);
+    }
+}
+
 void Engine::processInput() {
     m_input.update();
     m_gamepad.update();
@@ -593,6 +804,8 @@ void Engine::processInput() {
                 LOG_INFO("Auto-saving on suspend...");
                 m_saveSystem.saveAll();
             }
+            // Nobody is watching the frame rate now, so collect everything
+            m_modLoader.getLuaBindings().getGcScheduler().requestFullCollect("suspend");
 
             // Notify mods via EventBus
             EventData suspendData;
@@ -644,6 +857,11 @@ void Engine::processInput() {
         LOG_INFO("Profiler {}", m_profiler.isEnabled() ? "enabled" : "disabled");
     }
 
+    // Capture a profiler trace (F5)
+    if (m_input.isKeyPressed(KEY_F5)) {
+        m_diagnosticOverlay.triggerCapture(m_profiler);
+    }
+
     // Toggle lighting system
     if (m_input.isKeyPressed(KEY_L) && m_lightingSystem) {
         bool wasEnabled = m_lightingSystem->getConfig().enabled;
@@ -655,8 +873,75 @@ void Engine::processInput() {
 void Engine::update(double dt) {
     float dtFloat = static_cast<float>(dt);
 
-    // Run ECS update systems
-    m_systemScheduler.update(dtFloat);
+    if (!m_fixedTimestep.isEnabled()) {
+        simulate(dtFloat);
+    } else {
+        int steps = m_fixedTimestep.advance(dt);
+        float tickDt = static_cast<float>(m_fixedTimestep.tickDt());
+        for (int i = 0; i < steps; ++i) {
+            m_transformInterpolator.beginTick(m_registry);
+            Vec2 cameraBefore = m_camera.getPosition();
+
+            simulate(tickDt);
+
+            // Camera cuts (scene changes, respawns) are not smoothed
+            m_cameraTickDelta = m_camera.getPosition() - cameraBefore;
+            float snap = m_transformInterpolator.getSnapDistance();
+            if (snap > 0.0f && m_cameraTickDelta.lengthSquared() > snap * snap) {
+                m_cameraTickDelta = {0.0f, 0.0f};
+            }
+        }
+    }
+
+    updateFrame(dtFloat);
+}
+
+void Engine::simulate(float dt) {
+    // Pressed/released input reads as every edge since the last tick, so a
+    // frame that runs no tick doesn't lose one and a frame that runs two
+    // doesn't repeat it
+    m_input.beginTick();
+    m_gamepad.beginTick();
+
+    // Run ECS update systems. Spatial queries bring m_spatialIndex up to
+    // date on demand: a rebuild once per system that moved entities, and
+    // per-entity refreshes for script moves and spawns in between.
+    m_systemScheduler.update(dt);
+
+    // Deliver events queued by systems this tick (deferred/batched dispatch).
+    // Runs after all update phases so Lua handlers never interleave with
+    // tight system loops, and before UI/scenes so they observe the results.
+    {
+        auto z = m_profiler.scopedZone("EventFlush");
+        getEventBus().flushQueued();
+    }
+
+    // Update timers (paused when overlay scenes are active)
+    m_timerSystem.update(dt, m_registry, m_sceneManager.isPausedByOverlay());
+
+    // Update tweens (moves entities in place)
+    m_tweenSystem.update(dt, m_registry);
+    m_registry.touch();
+
+    // Send snapshots of this tick's state to clients
+    if (m_replicationServer.isRunning()) {
+        auto z = m_profiler.scopedZone("Replication");
+        m_replicationServer.update(m_registry, dt);
+    }
+
+    m_inputActions.latchAxisState(m_gamepad);
+    m_input.endTick();
+    m_gamepad.endTick();
+}
+
+void Engine::updateFrame(float dtFloat) {
+    // Receive snapshots and interpolate replicas (per frame, so they move
+    // smoothly whatever the simulation rate)
+    if (m_replicationClient.isOpen()) {
+        auto z = m_profiler.scopedZone("Replication");
+        m_replicationClient.update(m_registry, dtFloat);
+        m_registry.touch();
+    }
 
     // Update UI system (processes input, rebuilds dynamic UIs, computes layout)
     m_uiSystem.update(dtFloat);
@@ -670,12 +955,6 @@ void Engine::update(double dt) {
     // Update scene manager (processes transitions)
     m_sceneManager.update(dtFloat);
 
-    // Update timers (paused when overlay scenes are active)
-    m_timerSystem.update(dtFloat, m_registry, m_sceneManager.isPausedByOverlay());
-
-    // Update tweens
-    m_tweenSystem.update(dtFloat, m_registry);
-
     // Update haptics (tick down vibrations)
     m_haptics.update(dtFloat);
 
@@ -725,6 +1004,33 @@ void Engine::update(double dt) {
     m_inputActions.latchAxisState(m_gamepad);
 }
 
+void Engine::packModTextures() {
+    if (!m_config.getBool("textures.atlas_packing", true)) return;
+
+    // Sprite textures only: tiles draw from the TileRenderer's single
+    // tileset, not from per-tile textures, so packing those gains nothing
+    const ContentRegistry& content = m_modLoader.getContentRegistry();
+    std::vector<std::string> paths;
+    for (const auto& id : content.getItemIds()) {
+        if (const auto* def = content.getItem(id)) paths.push_back(def->texturePath);
+    }
+    for (const auto& id : content.getEnemyIds()) {
+        if (const auto* def = content.getEnemy(id)) paths.push_back(def->texturePath);
+    }
+    for (const auto& id : content.getNPCIds()) {
+        if (const auto* def = content.getNPC(id)) paths.push_back(def->texturePath);
+    }
+    for (const auto& type : m_entityFactory.getDefinitionTypes()) {
+        if (const auto* def = m_entityFactory.getDefinition(type)) paths.push_back(def->texturePath);
+    }
+
+    AtlasPackSettings settings;
+    settings.pageSize = m_config.getInt("textures.atlas_page_size", settings.pageSize);
+    settings.padding = m_config.getInt("textures.atlas_padding", settings.padding);
+    m_textureManager.packTextures(paths, settings,
+                                  m_config.getString("textures.atlas_cache_dir", "cache/atlas"));
+}
+
 void Engine::render() {
     // Apply camera shake offset before rendering, with RAII guard to ensure undo
     Vec2 shakeOffset = m_tweenSystem.getShakeOffset();
@@ -742,6 +1048,25 @@ void Engine::render() {
         }
     } shakeGuard{m_camera, shakeOffset, hasShake};
 
+    // Fixed timestep: draw sprites and the camera between the last two ticks,
+    // then put the simulated state back
+    struct InterpolationGuard {
+        Engine& engine;
+        Vec2 cameraOffset;
+        bool active;
+        ~InterpolationGuard() {
+            if (!active) return;
+            engine.m_transformInterpolator.restore(engine.m_registry);
+            engine.m_camera.move(-cameraOffset.x, -cameraOffset.y);
+        }
+    } interpolationGuard{*this, {0.0f, 0.0f}, m_fixedTimestep.isEnabled()};
+    if (interpolationGuard.active) {
+        float alpha = m_fixedTimestep.alpha();
+        m_transformInterpolator.apply(m_registry, alpha);
+        interpolationGuard.cameraOffset = m_cameraTickDelta * (alpha - 1.0f);
+        m_camera.move(interpolationGuard.cameraOffset.x, interpolationGuard.cameraOffset.y);
+    }
+
     m_renderer->beginFrame();
     m_renderer->clear(Color(20, 20, 30, 255));
 
@@ -968,9 +1293,10 @@ void Engine::render() {
         }
     }
 
-    m_renderer->drawText("WASD/Arrows: Move | Q/E: Zoom | F2: Diagnostics | F3: Debug | F4: Profiler | L: Light | F11: FS",
+    m_renderer->drawText("WASD/Arrows: Move | Q/E: Zoom | F2: Diagnostics | F3: Debug | F4: Profiler | F5: Trace | L: Light | F11: FS",
                          {20, 470}, 16, Color::Gray());
 
+    m_presentStart = std::chrono::steady_clock::now();
     m_renderer->endFrame();
     // Camera shake offset is automatically undone by ShakeGuard destructor
 }
@@ -992,6 +1318,10 @@ void Engine::shutdown() {
     // Shutdown Steam integration after mods have released their references
     m_steamIntegration.shutdown();
 
+    // Tell peers we're leaving
+    m_replicationClient.disconnect();
+    m_replicationServer.stop();
+
     // Shutdown UI system (after mods, before renderer)
     m_uiSystem.shutdown();
 
@@ -1013,6 +1343,7 @@ void Engine::shutdown() {
 
     // Shutdown ECS
     m_systemScheduler.shutdown();
+    m_jobSystem.stop();
     m_registry.clear();
 
     // Unload all textures
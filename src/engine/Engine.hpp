@@ -4,7 +4,10 @@
 #include "engine/Window.hpp"
 #include "engine/Input.hpp"
 #include "engine/Time.hpp"
+#include "engine/FixedTimestep.hpp"
+#include "engine/Headless.hpp"
 #include "engine/Profiler.hpp"
+#include "engine/JobSystem.hpp"
 #include "engine/ResourceManager.hpp"
 #include "engine/DiagnosticOverlay.hpp"
 #include "rendering/IRenderer.hpp"
@@ -16,6 +19,7 @@
 #include "ecs/Registry.hpp"
 #include "ecs/Systems.hpp"
 #include "ecs/EntityFactory.hpp"
+#include "ecs/TransformInterpolation.hpp"
 #include "world/TileMap.hpp"
 #include "lighting/LightingSystem.hpp"
 #include "audio/AudioSystem.hpp"
@@ -24,6 +28,7 @@
 #include "gameplay/GameMode.hpp"
 #include "gameplay/InputActions.hpp"
 #include "gameplay/Pathfinding.hpp"
+#include "gameplay/StateMachine.hpp"
 #include "gameplay/DialogueSystem.hpp"
 #include "gameplay/TileLayers.hpp"
 #include "gameplay/CollisionLayers.hpp"
@@ -51,10 +56,12 @@
 #include "rendering/ViewportScaler.hpp"
 #include "ui/UIScaling.hpp"
 #include "engine/SteamIntegration.hpp"
+#include "net/Replication.hpp"
 
 #include <string>
 #include <memory>
 #include <atomic>
+#include <chrono>
 
 namespace gloaming {
 
@@ -64,6 +71,10 @@ inline constexpr const char* kEngineVersion = "0.5.0";
 class Engine {
 public:
     bool init(const std::string& configPath = "config.json");
+
+    /// Initialize with command-line overrides (config path, headless mode).
+    bool init(const LaunchOptions& launch);
+
     void run();
     void shutdown();
 
@@ -80,6 +91,11 @@ public:
     Input&  getInput()  { return m_input; }
     Time&   getTime()   { return m_time; }
 
+    /// Headless mode: no window, renderer, audio or input devices.
+    bool isHeadless() const { return m_headless.enabled; }
+    const HeadlessConfig& getHeadlessConfig() const { return m_headless; }
+    FixedTimestep& getFixedTimestep() { return m_fixedTimestep; }
+
     // Rendering accessors
     IRenderer* getRenderer() { return m_renderer.get(); }
     Camera& getCamera() { return m_camera; }
@@ -91,6 +107,7 @@ public:
     // ECS accessors
     Registry& getRegistry() { return m_registry; }
     SystemScheduler& getSystemScheduler() { return m_systemScheduler; }
+    JobSystem& getJobSystem() { return m_jobSystem; }
     EntityFactory& getEntityFactory() { return m_entityFactory; }
 
     // World accessors
@@ -118,6 +135,8 @@ public:
     TileLayerManager& getTileLayerManager() { return m_tileLayers; }
     CollisionLayerRegistry& getCollisionLayers() { return m_collisionLayers; }
     EntitySpawning& getEntitySpawning() { return m_entitySpawning; }
+    SpatialIndex& getSpatialIndex() { return m_spatialIndex; }
+    StateMachineSystem* getStateMachineSystem() { return m_stateMachineSystem; }
 
     // World generation accessors (Stage 12)
     WorldGenerator& getWorldGenerator() { return m_worldGenerator; }
@@ -176,15 +195,35 @@ public:
     // Configuration Persistence (Stage 19E)
     const std::string& getLocalConfigPath() const { return m_localConfigPath; }
 
+    // Networking (config "network.mode": "off", "server" or "client")
+    ReplicationServer& getReplicationServer() { return m_replicationServer; }
+    ReplicationClient& getReplicationClient() { return m_replicationClient; }
+
 private:
     void processInput();
+    void runHeadless();
+    bool checkTerminationSignal();
     void update(double dt);
+    void simulate(float dt);
+    void updateFrame(float dt);
     void render();
+    void packModTextures();         // Merge mod sprite textures into atlas pages
 
     Config m_config;
     Window m_window;
     Input  m_input;
     Time   m_time;
+    HeadlessConfig m_headless;
+
+    // Fixed-tick simulation: sprites and the camera are drawn interpolated
+    // between the last two ticks
+    FixedTimestep m_fixedTimestep;
+    TransformInterpolator m_transformInterpolator;
+    Vec2 m_cameraTickDelta{0.0f, 0.0f};   ///< Camera movement during the last tick
+
+    /// When render() handed the frame to the renderer to present. Presenting
+    /// blocks on vsync/frame pacing, so Lua GC slack is measured up to here.
+    std::chrono::steady_clock::time_point m_presentStart;
 
     // Rendering systems
     std::unique_ptr<IRenderer> m_renderer;
@@ -194,7 +233,8 @@ private:
     TileRenderer m_tileRenderer;
     ParallaxBackground m_parallaxBg;
 
-    // ECS systems
+    // ECS systems (job system first: it must outlive the scheduler)
+    JobSystem m_jobSystem;
     Registry m_registry;
     SystemScheduler m_systemScheduler;
     EntityFactory m_entityFactory;
@@ -222,6 +262,8 @@ private:
     TileLayerManager m_tileLayers;
     CollisionLayerRegistry m_collisionLayers;
     EntitySpawning m_entitySpawning;
+    SpatialIndex m_spatialIndex;
+    StateMachineSystem* m_stateMachineSystem = nullptr;   // Managed by SystemScheduler
 
     // World generation (Stage 12)
     WorldGenerator m_worldGenerator;
@@ -267,6 +309,10 @@ private:
     // Steam Integration (Stage 19D)
     SteamIntegration m_steamIntegration;
 
+    // Networking: snapshot replication of NetworkSync entities
+    ReplicationServer m_replicationServer;
+    ReplicationClient m_replicationClient;
+
     // Configuration Persistence (Stage 19E)
     std::string m_localConfigPath;  ///< Derived path for per-device config overrides
 
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+
+namespace gloaming {
+
+/// Configuration for FixedTimestep.
+struct FixedTimestepConfig {
+    bool enabled = false;
+    double tickRate = 60.0;       ///< Simulation ticks per second
+    int maxStepsPerFrame = 5;     ///< Catch-up cap; time beyond it is dropped
+};
+
+/// Accumulator that turns variable frame times into whole simulation ticks.
+///
+/// Each frame, advance() adds the frame time and returns how many fixed
+/// ticks to simulate; the leftover fraction of a tick is kept for the next
+/// frame and exposed as alpha() so rendering can interpolate between the
+/// previous and current tick. When a hitch would need more than
+/// maxStepsPerFrame ticks, the excess is dropped (the game slows down
+/// instead of spiralling).
+///
+/// Usage per frame:
+///   int steps = fixed.advance(frameDt);
+///   for (int i = 0; i < steps; ++i) simulate(fixed.tickDt());
+///   render(fixed.alpha());
+///
+/// Edge-triggered input (isKeyPressed) is polled once per frame but latched
+/// per tick (Input::beginTick()), so each edge reaches exactly one tick.
+class FixedTimestep {
+public:
+    void setConfig(const FixedTimestepConfig& config) {
+        m_config = config;
+        if (m_config.tickRate <= 0.0) m_config.tickRate = 60.0;
+        if (m_config.maxStepsPerFrame < 1) m_config.maxStepsPerFrame = 1;
+        m_accumulator = 0.0;
+    }
+    const FixedTimestepConfig& getConfig() const { return m_config; }
+
+    bool isEnabled() const { return m_config.enabled; }
+
+    /// Seconds simulated by one tick.
+    double tickDt() const { return 1.0 / m_config.tickRate; }
+
+    /// Add a frame's time; returns the number of ticks to run this frame.
+    int advance(double frameDt) {
+        if (frameDt > 0.0) m_accumulator += frameDt;
+
+        const double step = tickDt();
+        int steps = 0;
+        while (m_accumulator >= step && steps < m_config.maxStepsPerFrame) {
+            m_accumulator -= step;
+            ++steps;
+        }
+
+        // Still behind after the cap: drop whole ticks, keep the fraction
+        while (m_accumulator >= step) {
+            m_accumulator -= step;
+            m_droppedTime += step;
+        }
+
+        m_tickCount += static_cast<uint64_t>(steps);
+        m_lastSteps = steps;
+        return steps;
+    }
+
+    /// How far the current frame is between the last two ticks, in [0, 1).
+    float alpha() const { return static_cast<float>(m_accumulator / tickDt()); }
+
+    /// Ticks run by the last advance().
+    int lastSteps() const { return m_lastSteps; }
+
+    /// Total ticks since creation.
+    uint64_t tickCount() const { return m_tickCount; }
+
+    /// Total simulation time skipped by the catch-up cap (seconds).
+    double droppedTime() const { return m_droppedTime; }
+
+    /// Forget any partial tick (e.g. after loading a world).
+    void reset() { m_accumulator = 0.0; }
+
+private:
+    FixedTimestepConfig m_config;
+    double m_accumulator = 0.0;
+    double m_droppedTime = 0.0;
+    uint64_t m_tickCount = 0;
+    int m_lastSteps = 0;
+};
+
+} // namespace gloaming
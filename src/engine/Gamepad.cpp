@@ -6,7 +6,15 @@
 namespace gloaming {
 
 void Gamepad::update() {
-    // Raylib handles gamepad state internally; no per-frame work needed.
+    // Raylib tracks held state; only edges need latching for ticks
+    for (int gamepadId = 0; gamepadId < MAX_GAMEPADS; ++gamepadId) {
+        if (!IsGamepadAvailable(gamepadId)) continue;
+        for (int button = 0; button < kMaxButtons; ++button) {
+            m_buttonEdges.record(gamepadId * kMaxButtons + button,
+                                 IsGamepadButtonPressed(gamepadId, button),
+                                 IsGamepadButtonReleased(gamepadId, button));
+        }
+    }
 }
 
 bool Gamepad::isConnected(int gamepadId) const {
@@ -24,6 +32,7 @@ int Gamepad::getConnectedCount() const {
 
 bool Gamepad::isButtonPressed(GamepadButton button, int gamepadId) const {
     if (!isConnected(gamepadId)) return false;
+    if (m_inTick) return m_buttonEdges.pressed(gamepadId * kMaxButtons + static_cast<int>(button));
     return IsGamepadButtonPressed(gamepadId, static_cast<int>(button));
 }
 
@@ -34,6 +43,7 @@ bool Gamepad::isButtonDown(GamepadButton button, int gamepadId) const {
 
 bool Gamepad::isButtonReleased(GamepadButton button, int gamepadId) const {
     if (!isConnected(gamepadId)) return false;
+    if (m_inTick) return m_buttonEdges.released(gamepadId * kMaxButtons + static_cast<int>(button));
     return IsGamepadButtonReleased(gamepadId, static_cast<int>(button));
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "engine/InputEdgeLatch.hpp"
 #include "engine/Vec2.hpp"
 
 #include <cstdint>
@@ -46,10 +47,20 @@ enum class GamepadAxis : int {
 
 /// Thin abstraction over Raylib gamepad input.
 /// Supports up to MAX_GAMEPADS simultaneously connected controllers.
+/// Button edges are latched per simulation tick like Input's.
 class Gamepad {
 public:
+    /// Poll the backend (once per frame).
     void update();
 
+    /// Bracket one simulation tick (see Input::beginTick()).
+    void beginTick() { m_inTick = true; }
+    void endTick() {
+        m_inTick = false;
+        m_buttonEdges.clear();
+    }
+    bool inTick() const { return m_inTick; }
+
     // Connection state
     bool isConnected(int gamepadId = 0) const;
     int  getConnectedCount() const;
@@ -77,6 +88,9 @@ public:
 
     static constexpr int MAX_GAMEPADS = 4;
 
+    /// Button codes latched per gamepad (Raylib's button codes stop below this)
+    static constexpr int kMaxButtons = 32;
+
 private:
     /// Apply radial deadzone to a stick vector.
     Vec2 applyRadialDeadzone(float x, float y) const;
@@ -85,6 +99,8 @@ private:
     float applyTriggerDeadzone(float value) const;
 
     float m_deadzone = 0.15f;
+    bool m_inTick = false;
+    InputEdgeLatch<MAX_GAMEPADS * kMaxButtons> m_buttonEdges;   ///< By gamepadId * kMaxButtons + button
 };
 
 } // namespace gloaming
@@ -0,0 +1,146 @@
+#include "engine/Headless.hpp"
+#include "engine/Log.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+namespace gloaming {
+
+// =============================================================================
+// LaunchOptions
+// =============================================================================
+
+LaunchOptions LaunchOptions::parse(int argc, const char* const* argv) {
+    LaunchOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto value = [&](std::string_view name) -> const char* {
+            if (i + 1 < argc) return argv[++i];
+            options.errors.push_back(std::string(name) + " requires a value");
+            return nullptr;
+        };
+
+        if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--fast") {
+            options.realtime = false;
+        } else if (arg == "--realtime") {
+            options.realtime = true;
+        } else if (arg == "--config") {
+            if (const char* v = value(arg)) options.configPath = v;
+        } else if (arg == "--report") {
+            if (const char* v = value(arg)) options.reportPath = std::string(v);
+        } else if (arg == "--ticks") {
+            const char* v = value(arg);
+            if (!v) continue;
+            std::string_view text = v;
+            uint64_t ticks = 0;
+            auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), ticks);
+            if (ec != std::errc() || end != text.data() + text.size()) {
+                options.errors.push_back("--ticks expects a number, got '" + std::string(text) + "'");
+            } else {
+                options.ticks = ticks;
+            }
+        } else {
+            options.errors.push_back("unknown argument '" + std::string(arg) + "'");
+        }
+    }
+    return options;
+}
+
+void LaunchOptions::applyTo(HeadlessConfig& config) const {
+    if (headless) config.enabled = *headless;
+    if (ticks) {
+        config.maxTicks = *ticks;
+        config.enabled = true;
+    }
+    if (realtime) {
+        config.realtime = *realtime;
+        if (!*realtime) config.enabled = true;
+    }
+    if (reportPath) {
+        config.reportPath = *reportPath;
+        config.enabled = true;
+    }
+}
+
+// =============================================================================
+// HeadlessReport
+// =============================================================================
+
+void HeadlessReport::recordTick(double tickMs) {
+    if (m_tickMs.size() < kMaxSamples) {
+        m_tickMs.push_back(static_cast<float>(tickMs));
+    } else {
+        m_tickMs[m_ticks % kMaxSamples] = static_cast<float>(tickMs);
+    }
+    ++m_ticks;
+    m_totalMs += tickMs;
+    m_maxTickMs = std::max(m_maxTickMs, tickMs);
+}
+
+void HeadlessReport::finish(double wallSeconds, double simulatedSeconds) {
+    m_wallSeconds = wallSeconds;
+    m_simulatedSeconds = simulatedSeconds;
+}
+
+double HeadlessReport::avgTickMs() const {
+    return m_ticks == 0 ? 0.0 : m_totalMs / static_cast<double>(m_ticks);
+}
+
+double HeadlessReport::percentileTickMs(double p) const {
+    if (m_tickMs.empty()) return 0.0;
+    std::vector<float> sorted = m_tickMs;
+    size_t index = static_cast<size_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 *
+                                                 static_cast<double>(sorted.size())));
+    index = std::clamp<size_t>(index, 1, sorted.size()) - 1;
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(index), sorted.end());
+    return sorted[index];
+}
+
+bool HeadlessReport::writeJson(const std::string& path,
+                               const std::vector<ProfileZoneStats>& zones) const {
+    nlohmann::json report;
+    report["ticks"] = ticks();
+    report["wall_seconds"] = m_wallSeconds;
+    report["simulated_seconds"] = m_simulatedSeconds;
+    report["ticks_per_second"] = m_wallSeconds > 0.0 ? static_cast<double>(ticks()) / m_wallSeconds : 0.0;
+    report["tick_ms"] = {
+        {"avg", avgTickMs()},
+        {"p50", percentileTickMs(50.0)},
+        {"p95", percentileTickMs(95.0)},
+        {"p99", percentileTickMs(99.0)},
+        {"max", m_maxTickMs},
+    };
+
+    nlohmann::json zoneJson = nlohmann::json::object();
+    for (const auto& zone : zones) {
+        zoneJson[zone.name] = {
+            {"avg_ms", zone.avgTimeMs},
+            {"max_ms", zone.maxTimeMs},
+            {"samples", zone.sampleCount},
+        };
+    }
+    report["zones"] = std::move(zoneJson);
+
+    std::error_code ec;
+    auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) std::filesystem::create_directories(parent, ec);
+
+    std::ofstream out(path);
+    if (!out) {
+        LOG_ERROR("Headless: could not write report to '{}'", path);
+        return false;
+    }
+    out << report.dump(2) << '\n';
+    return static_cast<bool>(out);
+}
+
+} // namespace gloaming
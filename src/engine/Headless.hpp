@@ -0,0 +1,75 @@
+#pragma once
+
+#include "engine/Profiler.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace gloaming {
+
+/// Headless mode: no window, renderer, audio or input devices; the main
+/// loop runs fixed ticks instead of following the display.
+/// Read from the "headless" section of config.json.
+struct HeadlessConfig {
+    bool enabled = false;
+    double tickRate = 60.0;       ///< Ticks per second of simulated time
+    uint64_t maxTicks = 0;        ///< Stop after this many ticks (0 = until shutdown)
+    bool realtime = true;         ///< Pace ticks to the wall clock; false = as fast as possible
+    std::string reportPath;       ///< Write a JSON run report here on exit (empty = none)
+};
+
+/// Command-line options. They override config.json for this run only and
+/// are never written back to the config files.
+///
+///   gloaming [--config <path>] [--headless] [--ticks <n>] [--fast | --realtime]
+///            [--report <path>]
+struct LaunchOptions {
+    std::string configPath = "config.json";
+    std::optional<bool> headless;
+    std::optional<uint64_t> ticks;
+    std::optional<bool> realtime;
+    std::optional<std::string> reportPath;
+
+    /// Arguments that could not be parsed (reported, then ignored).
+    std::vector<std::string> errors;
+
+    static LaunchOptions parse(int argc, const char* const* argv);
+
+    /// Apply the overrides on top of a config-derived HeadlessConfig.
+    /// --ticks, --fast and --report imply --headless.
+    void applyTo(HeadlessConfig& config) const;
+};
+
+/// Timing summary of a headless run, for performance regression checks.
+class HeadlessReport {
+public:
+    void recordTick(double tickMs);
+    void finish(double wallSeconds, double simulatedSeconds);
+
+    uint64_t ticks() const { return m_ticks; }
+    double wallSeconds() const { return m_wallSeconds; }
+    double simulatedSeconds() const { return m_simulatedSeconds; }
+    double avgTickMs() const;
+    double maxTickMs() const { return m_maxTickMs; }
+
+    /// Tick time at percentile p (0-100) over the last kMaxSamples ticks.
+    double percentileTickMs(double p) const;
+
+    /// Tick times kept for percentiles (about 4.6 hours at 60 Hz).
+    static constexpr size_t kMaxSamples = 1u << 20;
+
+    /// Write the summary plus per-zone profiler averages as JSON.
+    bool writeJson(const std::string& path, const std::vector<ProfileZoneStats>& zones) const;
+
+private:
+    std::vector<float> m_tickMs;   // Ring buffer once full
+    uint64_t m_ticks = 0;
+    double m_totalMs = 0.0;
+    double m_maxTickMs = 0.0;
+    double m_wallSeconds = 0.0;
+    double m_simulatedSeconds = 0.0;
+};
+
+} // namespace gloaming
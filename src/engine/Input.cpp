@@ -6,11 +6,25 @@ namespace gloaming {
 
 void Input::update() {
     m_mouseWheelDelta = GetMouseWheelMove();
+    m_tickWheelDelta += m_mouseWheelDelta;
+    for (int key = 1; key < kMaxKeys; ++key) {
+        m_keyEdges.record(key, IsKeyPressed(key), IsKeyReleased(key));
+    }
+    for (int button = 0; button < kMaxMouseButtons; ++button) {
+        m_mouseEdges.record(button, IsMouseButtonPressed(button), IsMouseButtonReleased(button));
+    }
+}
+
+void Input::endTick() {
+    m_inTick = false;
+    m_keyEdges.clear();
+    m_mouseEdges.clear();
+    m_tickWheelDelta = 0.0f;
 }
 
 // Key enum overloads
 bool Input::isKeyPressed(Key key) const {
-    return IsKeyPressed(static_cast<int>(key));
+    return isKeyPressed(static_cast<int>(key));
 }
 
 bool Input::isKeyDown(Key key) const {
@@ -18,11 +32,12 @@ bool Input::isKeyDown(Key key) const {
 }
 
 bool Input::isKeyReleased(Key key) const {
-    return IsKeyReleased(static_cast<int>(key));
+    return isKeyReleased(static_cast<int>(key));
 }
 
 // Raw int overloads (backward compatibility)
 bool Input::isKeyPressed(int key) const {
+    if (m_inTick) return m_keyEdges.pressed(key);
     return IsKeyPressed(key);
 }
 
@@ -31,6 +46,7 @@ bool Input::isKeyDown(int key) const {
 }
 
 bool Input::isKeyReleased(int key) const {
+    if (m_inTick) return m_keyEdges.released(key);
     return IsKeyReleased(key);
 }
 
@@ -44,7 +60,7 @@ float Input::getMouseY() const {
 
 // MouseButton enum overloads
 bool Input::isMouseButtonPressed(MouseButton button) const {
-    return IsMouseButtonPressed(static_cast<int>(button));
+    return isMouseButtonPressed(static_cast<int>(button));
 }
 
 bool Input::isMouseButtonDown(MouseButton button) const {
@@ -52,11 +68,12 @@ bool Input::isMouseButtonDown(MouseButton button) const {
 }
 
 bool Input::isMouseButtonReleased(MouseButton button) const {
-    return IsMouseButtonReleased(static_cast<int>(button));
+    return isMouseButtonReleased(static_cast<int>(button));
 }
 
 // Raw int overloads (backward compatibility)
 bool Input::isMouseButtonPressed(int button) const {
+    if (m_inTick) return m_mouseEdges.pressed(button);
     return IsMouseButtonPressed(button);
 }
 
@@ -65,11 +82,12 @@ bool Input::isMouseButtonDown(int button) const {
 }
 
 bool Input::isMouseButtonReleased(int button) const {
+    if (m_inTick) return m_mouseEdges.released(button);
     return IsMouseButtonReleased(button);
 }
 
 float Input::getMouseWheelDelta() const {
-    return m_mouseWheelDelta;
+    return m_inTick ? m_tickWheelDelta : m_mouseWheelDelta;
 }
 
 } // namespace gloaming
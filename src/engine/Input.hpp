@@ -1,5 +1,7 @@
 #pragma once
 
+#include "engine/InputEdgeLatch.hpp"
+
 #include <cstdint>
 
 namespace gloaming {
@@ -65,10 +67,19 @@ enum class MouseButton : int {
 
 /// Thin abstraction over Raylib input.
 /// Keeps game code decoupled from the backend.
+///
+/// Pressed/released queries and the wheel delta describe the current frame,
+/// except between beginTick() and endTick(), where they describe everything
+/// since the previous tick (see InputEdgeLatch). Held state is always live.
 class Input {
 public:
+    /// Poll the backend (once per frame).
     void update();
 
+    /// Bracket one simulation tick.
+    void beginTick() { m_inTick = true; }
+    void endTick();
+
     // Keyboard (engine Key enum)
     bool isKeyPressed(Key key) const;
     bool isKeyDown(Key key) const;
@@ -90,8 +101,16 @@ public:
     bool  isMouseButtonReleased(int button) const;
     float getMouseWheelDelta() const;
 
+    /// Highest key code tracked for ticks, plus one (Raylib's MAX_KEYBOARD_KEYS)
+    static constexpr int kMaxKeys = 512;
+    static constexpr int kMaxMouseButtons = 8;
+
 private:
     float m_mouseWheelDelta = 0.0f;
+    float m_tickWheelDelta = 0.0f;      ///< Summed over frames since the last tick
+    bool m_inTick = false;
+    InputEdgeLatch<kMaxKeys> m_keyEdges;
+    InputEdgeLatch<kMaxMouseButtons> m_mouseEdges;
 };
 
 } // namespace gloaming
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+
+namespace gloaming {
+
+/// Press/release edges of up to N buttons, held for fixed-tick consumers.
+///
+/// The backend reports an edge only for the frame it happened in, but with a
+/// fixed timestep a frame may run no tick (the edge would be lost) or
+/// several (each would see it). Recording every frame's edges here and
+/// clearing them after each tick hands every edge to exactly one tick: the
+/// first one after it.
+template<size_t N>
+class InputEdgeLatch {
+public:
+    static constexpr size_t kSize = N;
+
+    /// Add one frame's edges for `code` (codes outside [0, N) are ignored).
+    void record(int code, bool pressed, bool released) {
+        if (code < 0 || static_cast<size_t>(code) >= N) return;
+        if (pressed) m_pressed.set(static_cast<size_t>(code));
+        if (released) m_released.set(static_cast<size_t>(code));
+    }
+
+    /// Whether `code` was pressed / released since the last clear().
+    bool pressed(int code) const {
+        return code >= 0 && static_cast<size_t>(code) < N && m_pressed.test(static_cast<size_t>(code));
+    }
+    bool released(int code) const {
+        return code >= 0 && static_cast<size_t>(code) < N && m_released.test(static_cast<size_t>(code));
+    }
+
+    /// Forget every latched edge (at the end of a tick).
+    void clear() {
+        m_pressed.reset();
+        m_released.reset();
+    }
+
+private:
+    std::bitset<N> m_pressed;
+    std::bitset<N> m_released;
+};
+
+} // namespace gloaming
@@ -0,0 +1,172 @@
+#include "engine/JobSystem.hpp"
+#include "engine/Profiler.hpp"
+#include "engine/Log.hpp"
+
+#include <string>
+
+namespace gloaming {
+
+namespace {
+thread_local const JobSystem* t_pool = nullptr;
+thread_local int t_workerIndex = -1;
+} // namespace
+
+JobSystem::~JobSystem() {
+    stop();
+}
+
+void JobSystem::start(unsigned workers, Profiler* profiler) {
+    stop();
+    if (workers == 0) {
+        LOG_INFO("JobSystem: no worker threads, jobs run on the caller");
+        return;
+    }
+
+    m_stopping.store(false, std::memory_order_relaxed);
+    m_queues.clear();
+    for (unsigned i = 0; i < workers; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    m_threads.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        m_threads.emplace_back(&JobSystem::workerLoop, this, i, profiler);
+    }
+    LOG_INFO("JobSystem: started {} worker threads", workers);
+}
+
+void JobSystem::stop() {
+    if (m_threads.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping.store(true, std::memory_order_relaxed);
+    }
+    m_sleepCv.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+    m_threads.clear();
+
+    // Anything still queued runs here so no submitted job is lost
+    Job job;
+    while (steal(0, job)) {
+        m_pending.fetch_sub(1, std::memory_order_relaxed);
+        job();
+    }
+    m_queues.clear();
+}
+
+void JobSystem::submit(Job job) {
+    if (m_threads.empty()) {
+        job();
+        return;
+    }
+
+    unsigned index = (t_pool == this && t_workerIndex >= 0)
+        ? static_cast<unsigned>(t_workerIndex)
+        : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % workerCount();
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->jobs.push_back(std::move(job));
+    }
+    m_pending.fetch_add(1, std::memory_order_release);
+
+    // Taking the sleep lock orders this with a worker's predicate check
+    { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+    m_sleepCv.notify_one();
+}
+
+bool JobSystem::tryRunOne() {
+    if (m_pending.load(std::memory_order_acquire) == 0) return false;
+
+    Job job;
+    bool found = (t_pool == this && t_workerIndex >= 0)
+        ? popLocal(static_cast<unsigned>(t_workerIndex), job) ||
+          steal(static_cast<unsigned>(t_workerIndex), job)
+        : steal(0, job);
+    if (!found) return false;
+
+    m_pending.fetch_sub(1, std::memory_order_relaxed);
+    job();
+    return true;
+}
+
+void JobSystem::waitFor(const std::atomic<size_t>& counter) {
+    while (counter.load(std::memory_order_acquire) > 0) {
+        if (!tryRunOne()) std::this_thread::yield();
+    }
+}
+
+bool JobSystem::popLocal(unsigned index, Job& out) {
+    auto& queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+    out = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::steal(unsigned thief, Job& out) {
+    size_t count = m_queues.size();
+    for (size_t i = 0; i < count; ++i) {
+        auto& queue = *m_queues[(thief + 1 + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+        out = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(unsigned index, Profiler* profiler) {
+    t_pool = this;
+    t_workerIndex = static_cast<int>(index);
+    if (profiler) {
+        profiler->setThreadName("Worker " + std::to_string(index + 1));
+    }
+
+    constexpr int kSpinsBeforeSleep = 64;
+    int idleSpins = 0;
+    Job job;
+
+    while (true) {
+        if (popLocal(index, job) || steal(index, job)) {
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            job();
+            job = nullptr;
+            idleSpins = 0;
+            continue;
+        }
+
+        if (m_stopping.load(std::memory_order_relaxed)) break;
+
+        // Jobs arrive in bursts within a frame; spin briefly before sleeping
+        if (++idleSpins < kSpinsBeforeSleep) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepCv.wait(lock, [this]() {
+            return m_pending.load(std::memory_order_acquire) > 0 ||
+                   m_stopping.load(std::memory_order_relaxed);
+        });
+        idleSpins = 0;
+    }
+
+    t_pool = nullptr;
+    t_workerIndex = -1;
+}
+
+int JobSystem::currentWorkerIndex() {
+    return t_workerIndex;
+}
+
+unsigned JobSystem::defaultWorkerCount() {
+    unsigned hardware = std::thread::hardware_concurrency();
+    if (hardware <= 1) return 0;
+    return std::min(hardware - 1, 7u);
+}
+
+} // namespace gloaming
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gloaming {
+
+class Profiler;
+
+/// Work-stealing thread pool for short, frame-bound jobs.
+///
+/// Each worker owns a deque: it pops its own newest job first (cache-warm)
+/// and steals the oldest job from a sibling when its own deque is empty.
+/// Jobs submitted from outside the pool are dealt round-robin.
+///
+/// Threads that wait on jobs (the main thread in SystemScheduler, callers of
+/// parallelFor) help by running queued jobs via tryRunOne() instead of
+/// blocking, so a pool with zero workers still makes progress — everything
+/// just runs on the caller.
+///
+/// Jobs must not throw.
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    JobSystem() = default;
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /// Start `workers` threads (0 = run everything on the calling thread).
+    /// If a profiler is given, workers name themselves "Worker N" in traces.
+    void start(unsigned workers, Profiler* profiler = nullptr);
+
+    /// Finish queued jobs and join all workers.
+    void stop();
+
+    /// Number of worker threads (not counting helping callers).
+    unsigned workerCount() const { return static_cast<unsigned>(m_threads.size()); }
+    bool isRunning() const { return !m_threads.empty(); }
+
+    /// Queue a job. With no workers running, the job runs immediately.
+    void submit(Job job);
+
+    /// Run one queued job on the calling thread. Returns false if none.
+    bool tryRunOne();
+
+    /// Run or help until `counter` reaches zero.
+    void waitFor(const std::atomic<size_t>& counter);
+
+    /// Split [0, count) into chunks of at least `grain` items and call
+    /// fn(begin, end) for each, in parallel. Blocks until all chunks finish;
+    /// the caller runs the first chunk itself. Chunk boundaries depend only
+    /// on count, grain and the worker count.
+    template<typename Fn>
+    void parallelFor(size_t count, size_t grain, Fn&& fn);
+
+    /// Worker index of the calling thread (-1 when not a pool worker).
+    static int currentWorkerIndex();
+
+    /// Reasonable default: one worker per spare hardware thread, at most 7.
+    static unsigned defaultWorkerCount();
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void workerLoop(unsigned index, Profiler* profiler);
+    bool popLocal(unsigned index, Job& out);
+    bool steal(unsigned thief, Job& out);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t> m_pending{0};
+    std::atomic<unsigned> m_nextQueue{0};
+    std::atomic<bool> m_stopping{false};
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCv;
+};
+
+template<typename Fn>
+void JobSystem::parallelFor(size_t count, size_t grain, Fn&& fn) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+    if (!isRunning() || count <= grain) {
+        fn(size_t{0}, count);
+        return;
+    }
+
+    // A few chunks per thread so stealing can even out uneven work
+    size_t maxChunks = static_cast<size_t>(workerCount() + 1) * 4;
+    size_t chunks = std::min((count + grain - 1) / grain, maxChunks);
+    size_t perChunk = (count + chunks - 1) / chunks;
+    chunks = (count + perChunk - 1) / perChunk;
+
+    std::atomic<size_t> remaining{chunks - 1};
+    for (size_t c = 1; c < chunks; ++c) {
+        size_t begin = c * perChunk;
+        size_t end = std::min(count, begin + perChunk);
+        submit([&fn, &remaining, begin, end]() {
+            fn(begin, end);
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+
+    fn(size_t{0}, std::min(count, perChunk));
+    waitFor(remaining);
+}
+
+} // namespace gloaming
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace gloaming {
+
+/// 128-bit secret for KeyedHash.
+using HashKey = std::array<uint64_t, 2>;
+
+/// SipHash-2-4: a keyed 64-bit hash (PRF). Unlike FNV, outputs cannot be
+/// forged or predicted without the key, so it is safe to use for values an
+/// attacker can see or supply (handshake cookies, cache tags). Not a
+/// replacement for a full MAC where 64 bits are too few.
+class KeyedHash {
+public:
+    explicit KeyedHash(const HashKey& key)
+        : m_v0(key[0] ^ 0x736f6d6570736575ull), m_v1(key[1] ^ 0x646f72616e646f6dull),
+          m_v2(key[0] ^ 0x6c7967656e657261ull), m_v3(key[1] ^ 0x7465646279746573ull) {}
+
+    /// Fresh random key from the OS entropy source.
+    static HashKey randomKey() {
+        std::random_device device;
+        auto draw = [&device]() {
+            return (static_cast<uint64_t>(device()) << 32) | static_cast<uint64_t>(device());
+        };
+        return HashKey{draw(), draw()};
+    }
+
+    /// One-shot hash of a byte range.
+    static uint64_t hash(const HashKey& key, const void* data, size_t size) {
+        KeyedHash h(key);
+        h.update(data, size);
+        return h.finish();
+    }
+
+    KeyedHash& update(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            m_tail |= static_cast<uint64_t>(bytes[i]) << (8 * (m_length & 7));
+            if ((++m_length & 7) == 0) {
+                compress(m_tail);
+                m_tail = 0;
+            }
+        }
+        return *this;
+    }
+
+    template<typename T>
+    KeyedHash& updateValue(const T& value) { return update(&value, sizeof(T)); }
+
+    uint64_t finish() {
+        compress(m_tail | (static_cast<uint64_t>(m_length) << 56));
+        m_v2 ^= 0xff;
+        for (int i = 0; i < 4; ++i) round();
+        return m_v0 ^ m_v1 ^ m_v2 ^ m_v3;
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int b) { return (x << b) | (x >> (64 - b)); }
+
+    void round() {
+        m_v0 += m_v1; m_v1 = rotl(m_v1, 13); m_v1 ^= m_v0; m_v0 = rotl(m_v0, 32);
+        m_v2 += m_v3; m_v3 = rotl(m_v3, 16); m_v3 ^= m_v2;
+        m_v0 += m_v3; m_v3 = rotl(m_v3, 21); m_v3 ^= m_v0;
+        m_v2 += m_v1; m_v1 = rotl(m_v1, 17); m_v1 ^= m_v2; m_v2 = rotl(m_v2, 32);
+    }
+
+    void compress(uint64_t word) {
+        m_v3 ^= word;
+        round();
+        round();
+        m_v0 ^= word;
+    }
+
+    uint64_t m_v0, m_v1, m_v2, m_v3;
+    uint64_t m_tail = 0;
+    uint64_t m_length = 0;
+};
+
+} // namespace gloaming
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <cstdint>
+
+namespace gloaming {
+
+/// Process-wide string interner producing dense, stable uint32_t IDs.
+///
+/// Each Tag type gets its own independent table, so event names, profiler
+/// zones, etc. do not share an ID space:
+///   struct ProfileZoneTag;
+///   using ProfileZoneNames = NameTable<ProfileZoneTag>;
+///
+/// IDs never change for the lifetime of the process, so call sites can
+/// resolve them once and cache them in statics. Interning and lookups take a
+/// lock; code that works purely on IDs does not.
+template<typename Tag>
+class NameTable {
+public:
+    static constexpr uint32_t kInvalid = 0xFFFFFFFFu;
+
+    /// Get the ID for a name, creating it on first use.
+    static uint32_t intern(std::string_view name) {
+        auto& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        auto it = t.ids.find(name);
+        if (it != t.ids.end()) return it->second;
+
+        uint32_t id = static_cast<uint32_t>(t.names.size());
+        t.names.emplace_back(name);
+        t.ids.emplace(t.names.back(), id);
+        return id;
+    }
+
+    /// Get the ID for a name without creating it (kInvalid if never interned).
+    static uint32_t find(std::string_view name) {
+        auto& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        auto it = t.ids.find(name);
+        return it != t.ids.end() ? it->second : kInvalid;
+    }
+
+    /// Get the name for an ID (empty string for unknown IDs).
+    static const std::string& name(uint32_t id) {
+        static const std::string empty;
+        auto& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        return id < t.names.size() ? t.names[id] : empty;
+    }
+
+    /// Number of names interned so far (IDs are 0..size()-1).
+    static size_t size() {
+        auto& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        return t.names.size();
+    }
+
+private:
+    struct Hash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+
+    struct Table {
+        std::mutex mutex;
+        // deque keeps references stable so the map can key on string_views into it
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, uint32_t, Hash, std::equal_to<>> ids;
+    };
+
+    static Table& table() {
+        static Table t;
+        return t;
+    }
+};
+
+} // namespace gloaming
@@ -5,8 +5,41 @@
 #include "engine/ResourceManager.hpp"
 #include "engine/DiagnosticOverlay.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace gloaming {
 
+static sol::table systemTimingToTable(sol::state& lua, const System& system) {
+    const auto& t = system.getTimingStats();
+    sol::table result = lua.create_table();
+    result["name"]     = system.getName();
+    result["enabled"]  = system.isEnabled();
+    result["last_ms"]  = t.lastMs;
+    result["avg_ms"]   = t.avgMs;
+    result["max_ms"]   = t.maxMs;
+    result["p50_ms"]   = t.p50Ms;
+    result["p95_ms"]   = t.p95Ms;
+    result["p99_ms"]   = t.p99Ms;
+    result["spikes"]   = t.spikeCount;
+    result["samples"]  = t.sampleCount;
+    return result;
+}
+
+static sol::table modCpuStatsToTable(sol::state& lua, const LuaCpuBudget::ModStats& s) {
+    sol::table result = lua.create_table();
+    result["mod"]           = s.modId;
+    result["calls"]         = s.calls;
+    result["instructions"]  = s.instructions;
+    result["total_ms"]      = s.totalMs;
+    result["last_frame_ms"] = s.lastFrameMs;
+    result["avg_frame_ms"]  = s.avgFrameMs;
+    result["max_call_ms"]   = s.maxCallMs;
+    result["soft_overruns"] = s.softOverruns;
+    result["hard_aborts"]   = s.hardAborts;
+    return result;
+}
+
 void bindPolishAPI(sol::state& lua, Engine& engine,
                    Profiler& profiler,
                    ResourceManager& resourceManager,
@@ -27,7 +60,7 @@ void bindPolishAPI(sol::state& lua, Engine& engine,
         profiler.endZone(name);
     };
 
-    // profiler.zone_stats(name) -> { last_ms, avg_ms, min_ms, max_ms, samples }
+    // profiler.zone_stats(name) -> { last_ms, avg_ms, min_ms, max_ms, samples, depth, parent }
     profilerApi["zone_stats"] = [&profiler, &lua](const std::string& name) -> sol::table {
         auto stats = profiler.getZoneStats(name);
         sol::table result = lua.create_table();
@@ -37,6 +70,10 @@ void bindPolishAPI(sol::state& lua, Engine& engine,
         result["min_ms"]   = stats.minTimeMs;
         result["max_ms"]   = stats.maxTimeMs;
         result["samples"]  = stats.sampleCount;
+        result["depth"]    = stats.depth;
+        if (stats.parentId != ProfileZoneStats::kNoParent) {
+            result["parent"] = Profiler::zoneName(stats.parentId);
+        }
         return result;
     };
 
@@ -81,6 +118,85 @@ void bindPolishAPI(sol::state& lua, Engine& engine,
         profiler.reset();
     };
 
+    // profiler.system_stats(name?) -> { name, last_ms, avg_ms, max_ms, p50_ms,
+    //     p95_ms, p99_ms, spikes, samples, enabled } or a list of them for all
+    //     systems in execution order when name is omitted (nil if not found)
+    profilerApi["system_stats"] = [&engine, &lua](sol::optional<std::string> name) -> sol::object {
+        auto& scheduler = engine.getSystemScheduler();
+        if (name) {
+            if (System* system = scheduler.getSystem(*name)) {
+                return systemTimingToTable(lua, *system);
+            }
+            return sol::nil;
+        }
+        sol::table list = lua.create_table();
+        int index = 1;
+        scheduler.forEachSystem([&](const System& system, SystemPhase) {
+            list[index++] = systemTimingToTable(lua, system);
+        });
+        return list;
+    };
+
+    // profiler.budget_overruns() -> number of frames over budget since startup
+    profilerApi["budget_overruns"] = [&engine]() -> uint64_t {
+        return engine.getSystemScheduler().budgetOverrunCount();
+    };
+
+    // profiler.capture(frames) -> bool
+    // Writes a Chrome Trace file under traces/. Mods cannot choose the path.
+    profilerApi["capture"] = [&profiler](int frames) -> bool {
+        return profiler.capture(frames);
+    };
+
+    // profiler.is_capturing() -> bool
+    profilerApi["is_capturing"] = [&profiler]() -> bool {
+        return profiler.isCapturing();
+    };
+
+    // profiler.last_capture() -> string|nil
+    profilerApi["last_capture"] = [&profiler]() -> sol::optional<std::string> {
+        if (profiler.lastCapturePath().empty()) return sol::nullopt;
+        return profiler.lastCapturePath();
+    };
+
+    // profiler.mod_stats(modId?) -> { mod, calls, instructions, total_ms,
+    //     last_frame_ms, avg_frame_ms, max_call_ms, soft_overruns, hard_aborts }
+    //     or a list of them for every mod when modId is omitted (nil if unknown)
+    profilerApi["mod_stats"] = [&engine, &lua](sol::optional<std::string> modId) -> sol::object {
+        const LuaCpuBudget& budget = engine.getModLoader().getLuaBindings().getCpuBudget();
+        if (modId) {
+            if (const auto* stats = budget.getStats(*modId)) {
+                return modCpuStatsToTable(lua, *stats);
+            }
+            return sol::nil;
+        }
+        sol::table list = lua.create_table();
+        int index = 1;
+        for (const auto& stats : budget.getStats()) {
+            list[index++] = modCpuStatsToTable(lua, stats);
+        }
+        return list;
+    };
+
+    // profiler.gc_stats() -> { last_frame_ms, avg_frame_ms, max_frame_ms, total_ms,
+    //     last_full_collect_ms, steps, cycles, full_collections, memory_kb, engine_paced }
+    profilerApi["gc_stats"] = [&engine, &lua]() -> sol::table {
+        const LuaGcScheduler& gc = engine.getModLoader().getLuaBindings().getGcScheduler();
+        const LuaGcScheduler::Stats& s = gc.getStats();
+        sol::table result = lua.create_table();
+        result["last_frame_ms"]        = s.lastFrameMs;
+        result["avg_frame_ms"]         = s.avgFrameMs;
+        result["max_frame_ms"]         = s.maxFrameMs;
+        result["total_ms"]             = s.totalMs;
+        result["last_full_collect_ms"] = s.lastFullCollectMs;
+        result["steps"]                = s.steps;
+        result["cycles"]               = s.cycles;
+        result["full_collections"]     = s.fullCollections;
+        result["memory_kb"]            = gc.memoryKb();
+        result["engine_paced"]         = gc.getSettings().enginePaced;
+        return result;
+    };
+
     // =========================================================================
     // resources API — resource tracking
     // =========================================================================
@@ -150,6 +266,26 @@ void bindPolishAPI(sol::state& lua, Engine& engine,
         return "off";
     };
 
+    // diagnostics.slowest_mods(count?) -> list of profiler.mod_stats tables,
+    //     highest average Lua time per frame first (default 5)
+    diagApi["slowest_mods"] = [&engine, &lua](sol::optional<int> count) -> sol::table {
+        const auto& all = engine.getModLoader().getLuaBindings().getCpuBudget().getStats();
+        std::vector<const LuaCpuBudget::ModStats*> order;
+        order.reserve(all.size());
+        for (const auto& stats : all) order.push_back(&stats);
+        size_t limit = std::min(order.size(), static_cast<size_t>(std::max(0, count.value_or(5))));
+        std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(limit),
+                          order.end(), [](const auto* a, const auto* b) {
+                              return a->avgFrameMs > b->avgFrameMs;
+                          });
+
+        sol::table list = lua.create_table();
+        for (size_t i = 0; i < limit; ++i) {
+            list[i + 1] = modCpuStatsToTable(lua, *order[i]);
+        }
+        return list;
+    };
+
     // diagnostics.is_visible() -> bool
     diagApi["is_visible"] = [&diagnosticOverlay]() -> bool {
         return diagnosticOverlay.isVisible();
@@ -2,38 +2,176 @@
 #include "engine/Log.hpp"
 
 #include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
 
 namespace gloaming {
 
+namespace {
+
+const ProfileZoneId kFrameZone = ProfileZoneNames::intern("Frame");
+
+std::atomic<uint64_t> g_nextProfilerInstance{1};
+
+/// Per-thread direct-mapped cache from name pointer to zone ID. Entries are
+/// verified with strcmp, so a reused pointer with different text just misses.
+struct ZoneNameCacheEntry {
+    const char* ptr = nullptr;
+    const std::string* name = nullptr;
+    ProfileZoneId id = 0;
+};
+constexpr size_t kZoneNameCacheSize = 64;
+thread_local ZoneNameCacheEntry t_zoneNameCache[kZoneNameCacheSize];
+
+ProfileZoneId resolveZoneName(const char* name) {
+    auto slot = (reinterpret_cast<uintptr_t>(name) >> 3) & (kZoneNameCacheSize - 1);
+    auto& entry = t_zoneNameCache[slot];
+    if (entry.ptr == name && std::strcmp(name, entry.name->c_str()) == 0) {
+        return entry.id;
+    }
+    entry.id = ProfileZoneNames::intern(name);
+    entry.name = &ProfileZoneNames::name(entry.id);
+    entry.ptr = name;
+    return entry.id;
+}
+
+/// Last ThreadBuffer this thread used, tagged with the owning profiler.
+struct ThreadBufferCache {
+    uint64_t instance = 0;
+    void* buffer = nullptr;
+};
+thread_local ThreadBufferCache t_threadBuffer;
+
+void writeJsonString(std::ostream& out, const std::string& s) {
+    out << '"';
+    for (char c : s) {
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n";  break;
+            case '\r': out << "\\r";  break;
+            case '\t': out << "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                    out << buf;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+// =============================================================================
+// ThreadBuffer — lock-free SPSC ring (producer: owning thread, consumer: main)
 // =============================================================================
-// ScopedZone — stores const char* to avoid per-frame allocation
+
+struct Profiler::ThreadBuffer {
+    std::thread::id thread;
+    uint32_t tid = 0;
+    std::string name;   // guarded by m_threadsMutex
+
+    std::vector<TraceEvent> events = std::vector<TraceEvent>(kThreadBufferSize);
+    alignas(64) std::atomic<size_t> head{0};    // next write (producer)
+    alignas(64) std::atomic<size_t> tail{0};    // next read (consumer)
+    std::atomic<uint64_t> dropped{0};
+
+    void push(const TraceEvent& ev) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= kThreadBufferSize) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events[h & (kThreadBufferSize - 1)] = ev;
+        head.store(h + 1, std::memory_order_release);
+    }
+};
+
+static_assert((Profiler::kThreadBufferSize & (Profiler::kThreadBufferSize - 1)) == 0,
+              "thread buffer size must be a power of two");
+
+// =============================================================================
+// ScopedZone — holds the interned ID to avoid per-frame allocation
 // =============================================================================
 
 Profiler::ScopedZone::ScopedZone(Profiler& profiler, const char* name)
-    : m_profiler(profiler), m_name(name) {
-    m_profiler.beginZone(m_name);
+    : ScopedZone(profiler, resolveZoneName(name)) {}
+
+Profiler::ScopedZone::ScopedZone(Profiler& profiler, ProfileZoneId id)
+    : m_profiler(profiler), m_id(id),
+      m_ownerThread(std::this_thread::get_id() == profiler.m_ownerThread) {
+    if (m_ownerThread) {
+        m_profiler.beginZone(m_id);
+    } else if (m_profiler.m_capturing.load(std::memory_order_relaxed)) {
+        m_traceStartNs = nowNs();
+    }
 }
 
 Profiler::ScopedZone::~ScopedZone() {
-    m_profiler.endZone(m_name);
+    if (m_ownerThread) {
+        m_profiler.endZone(m_id);
+    } else if (m_traceStartNs != 0 && m_profiler.m_capturing.load(std::memory_order_relaxed)) {
+        m_profiler.recordTrace(m_id, m_traceStartNs, nowNs());
+    }
 }
 
 // =============================================================================
 // Profiler
 // =============================================================================
 
-Profiler::Profiler() {
+Profiler::Profiler()
+    : m_instanceId(g_nextProfilerInstance.fetch_add(1, std::memory_order_relaxed))
+    , m_ownerThread(std::this_thread::get_id()) {
     m_history.resize(kHistorySize, 0.0f);
-    m_activeZones.reserve(8); // Typical engine has < 10 zones
+    m_activeZones.reserve(16);
+}
+
+Profiler::~Profiler() {
+    if (m_traceWriter.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            m_stopWriter = true;
+        }
+        m_writeCv.notify_all();
+        m_traceWriter.join();       // Finishes queued writes first
+    }
+}
+
+uint64_t Profiler::nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count());
 }
 
 void Profiler::beginFrame() {
-    if (!m_enabled) return;
+    if (!isEnabled()) return;
     m_frameStart = Clock::now();
+
+    if (m_captureFramesLeft > 0 && !m_capturing.load(std::memory_order_relaxed)) {
+        // Discard anything left over from before the capture started
+        drainThreadBuffers();
+        m_captureEvents.clear();
+        m_captureDropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_threadsMutex);
+            for (auto& buffer : m_threads) buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+        m_captureStartNs = nowNs();
+        m_capturing.store(true, std::memory_order_release);
+        LOG_INFO("Profiler: capturing {} frames", m_captureFramesLeft);
+    }
+    m_frameStartNs = nowNs();
 }
 
 void Profiler::endFrame() {
-    if (!m_enabled) return;
+    if (!isEnabled()) return;
 
     auto now = Clock::now();
     double elapsed = std::chrono::duration<double, std::milli>(now - m_frameStart).count();
@@ -54,60 +192,81 @@ void Profiler::endFrame() {
     // Record in ring buffer
     m_history[m_historyIndex] = static_cast<float>(elapsed);
     m_historyIndex = (m_historyIndex + 1) % kHistorySize;
+
+    if (m_capturing.load(std::memory_order_relaxed)) {
+        recordTrace(kFrameZone, m_frameStartNs, nowNs());
+        drainThreadBuffers();
+        if (--m_captureFramesLeft <= 0) {
+            finishCapture();
+        }
+    }
 }
 
 void Profiler::beginZone(const std::string& name) {
-    if (!m_enabled) return;
+    beginZone(zoneId(name));
+}
 
-    // Warn on overlapping zone with the same name (Issue #4)
-    for (const auto& active : m_activeZones) {
-        if (active.name == name) {
-            LOG_WARN("Profiler: overlapping beginZone('{}') — previous measurement will be lost", name);
-            break;
-        }
-    }
+void Profiler::beginZone(ProfileZoneId id) {
+    if (!isEnabled() || std::this_thread::get_id() != m_ownerThread) return;
 
-    // Check if zone already active (overlap) — update start time
+    // Overlapping zone with the same name — restart its timer (Issue #4)
     for (auto& active : m_activeZones) {
-        if (active.name == name) {
+        if (active.id == id) {
+            LOG_WARN("Profiler: overlapping beginZone('{}') — previous measurement will be lost",
+                     zoneName(id));
             active.start = Clock::now();
             return;
         }
     }
 
-    m_activeZones.push_back(ActiveZone{name, Clock::now()});
+    // Create stats on first entry so parents precede their children
+    auto& stats = getOrCreateZone(id);
+    stats.depth = static_cast<uint32_t>(m_activeZones.size());
+    stats.parentId = m_activeZones.empty() ? ProfileZoneStats::kNoParent
+                                           : m_activeZones.back().id;
+
+    m_activeZones.push_back(ActiveZone{id, Clock::now()});
 }
 
 void Profiler::endZone(const std::string& name) {
-    if (!m_enabled) return;
+    auto id = ProfileZoneNames::find(name);
+    if (id != ProfileZoneNames::kInvalid) endZone(id);
+}
 
-    // Linear search through small vector (typically < 10 entries)
-    for (auto it = m_activeZones.begin(); it != m_activeZones.end(); ++it) {
-        if (it->name == name) {
-            auto now = Clock::now();
-            double elapsed = std::chrono::duration<double, std::milli>(now - it->start).count();
+void Profiler::endZone(ProfileZoneId id) {
+    if (!isEnabled() || std::this_thread::get_id() != m_ownerThread) return;
 
-            // Swap-and-pop for O(1) removal
-            if (it != m_activeZones.end() - 1) {
-                *it = std::move(m_activeZones.back());
-            }
-            m_activeZones.pop_back();
+    // Search from the innermost zone (normally the one being closed)
+    for (size_t i = m_activeZones.size(); i-- > 0; ) {
+        if (m_activeZones[i].id != id) continue;
 
-            auto& stats = getOrCreateZone(name);
-            stats.lastTimeMs = elapsed;
-            stats.sampleCount++;
+        auto now = Clock::now();
+        auto start = m_activeZones[i].start;
+        double elapsed = std::chrono::duration<double, std::milli>(now - start).count();
+        m_activeZones.erase(m_activeZones.begin() + static_cast<std::ptrdiff_t>(i));
 
-            if (stats.sampleCount == 1) {
-                stats.avgTimeMs = elapsed;
-            } else {
-                stats.avgTimeMs = stats.avgTimeMs * (1.0 - ProfileZoneStats::kSmoothing)
-                                + elapsed * ProfileZoneStats::kSmoothing;
-            }
+        auto& stats = getOrCreateZone(id);
+        stats.lastTimeMs = elapsed;
+        stats.sampleCount++;
 
-            stats.minTimeMs = std::min(stats.minTimeMs, elapsed);
-            stats.maxTimeMs = std::max(stats.maxTimeMs, elapsed);
-            return;
+        if (stats.sampleCount == 1) {
+            stats.avgTimeMs = elapsed;
+        } else {
+            stats.avgTimeMs = stats.avgTimeMs * (1.0 - ProfileZoneStats::kSmoothing)
+                            + elapsed * ProfileZoneStats::kSmoothing;
+        }
+
+        stats.minTimeMs = std::min(stats.minTimeMs, elapsed);
+        stats.maxTimeMs = std::max(stats.maxTimeMs, elapsed);
+
+        if (m_capturing.load(std::memory_order_relaxed)) {
+            auto startNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                start.time_since_epoch()).count());
+            auto endNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                now.time_since_epoch()).count());
+            recordTrace(id, startNs, endNs);
         }
+        return;
     }
 
     // Zone was never started — ignore silently
@@ -117,10 +276,14 @@ Profiler::ScopedZone Profiler::scopedZone(const char* name) {
     return ScopedZone(*this, name);
 }
 
+Profiler::ScopedZone Profiler::scopedZone(ProfileZoneId id) {
+    return ScopedZone(*this, id);
+}
+
 ProfileZoneStats Profiler::getZoneStats(const std::string& name) const {
-    auto it = m_zoneIndexMap.find(name);
-    if (it != m_zoneIndexMap.end()) {
-        return m_zoneStatsVec[it->second];
+    auto id = ProfileZoneNames::find(name);
+    if (id < m_zoneIndex.size() && m_zoneIndex[id] >= 0) {
+        return m_zoneStatsVec[static_cast<size_t>(m_zoneIndex[id])];
     }
     return ProfileZoneStats{name};
 }
@@ -145,22 +308,229 @@ void Profiler::reset() {
 
     m_activeZones.clear();
     m_zoneStatsVec.clear();
-    m_zoneIndexMap.clear();
+    m_zoneIndex.clear();
 
     std::fill(m_history.begin(), m_history.end(), 0.0f);
     m_historyIndex = 0;
 }
 
-ProfileZoneStats& Profiler::getOrCreateZone(const std::string& name) {
-    auto it = m_zoneIndexMap.find(name);
-    if (it != m_zoneIndexMap.end()) {
-        return m_zoneStatsVec[it->second];
+ProfileZoneStats& Profiler::getOrCreateZone(ProfileZoneId id) {
+    if (id >= m_zoneIndex.size()) {
+        m_zoneIndex.resize(static_cast<size_t>(id) + 1, -1);
+    }
+    if (m_zoneIndex[id] >= 0) {
+        return m_zoneStatsVec[static_cast<size_t>(m_zoneIndex[id])];
     }
 
-    size_t index = m_zoneStatsVec.size();
-    m_zoneIndexMap[name] = index;
-    m_zoneStatsVec.push_back(ProfileZoneStats{name});
+    m_zoneIndex[id] = static_cast<int32_t>(m_zoneStatsVec.size());
+    ProfileZoneStats stats{zoneName(id)};
+    stats.id = id;
+    m_zoneStatsVec.push_back(std::move(stats));
     return m_zoneStatsVec.back();
 }
 
+// =============================================================================
+// Trace capture
+// =============================================================================
+
+bool Profiler::capture(int frames, const std::string& path) {
+    if (frames <= 0 || m_captureFramesLeft > 0) return false;
+
+    setEnabled(true);
+    m_captureFramesLeft = frames;
+    m_captureFramesTotal = frames;
+    m_capturePath = path;
+    return true;
+}
+
+Profiler::ThreadBuffer& Profiler::threadBuffer() {
+    if (t_threadBuffer.instance == m_instanceId) {
+        return *static_cast<ThreadBuffer*>(t_threadBuffer.buffer);
+    }
+
+    auto self = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+
+    ThreadBuffer* found = nullptr;
+    for (auto& buffer : m_threads) {
+        if (buffer->thread == self) { found = buffer.get(); break; }
+    }
+    if (!found) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->thread = self;
+        buffer->tid = static_cast<uint32_t>(m_threads.size()) + 1;
+        buffer->name = self == m_ownerThread ? "Main" : "Thread " + std::to_string(buffer->tid);
+        found = buffer.get();
+        m_threads.push_back(std::move(buffer));
+    }
+
+    t_threadBuffer.instance = m_instanceId;
+    t_threadBuffer.buffer = found;
+    return *found;
+}
+
+void Profiler::recordTrace(ProfileZoneId zone, uint64_t startNs, uint64_t endNs) {
+    auto& buffer = threadBuffer();
+    buffer.push(TraceEvent{startNs, endNs > startNs ? endNs - startNs : 0, zone, buffer.tid});
+}
+
+void Profiler::drainThreadBuffers() {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    for (auto& buffer : m_threads) {
+        size_t tail = buffer->tail.load(std::memory_order_relaxed);
+        size_t head = buffer->head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            if (m_captureEvents.size() >= kMaxCaptureEvents) {
+                m_captureDropped += head - tail;
+                tail = head;
+                break;
+            }
+            m_captureEvents.push_back(buffer->events[tail & (kThreadBufferSize - 1)]);
+        }
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+}
+
+void Profiler::finishCapture() {
+    m_capturing.store(false, std::memory_order_release);
+    m_captureFramesLeft = 0;
+    drainThreadBuffers();
+
+    std::string path = m_capturePath;
+    if (path.empty()) {
+        char stamp[32];
+        std::time_t t = std::time(nullptr);
+        std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&t));
+        path = std::string("traces/trace_") + stamp + ".json";
+    }
+
+    // Hand the events to the writer; swapping leaves m_captureEvents with
+    // no capacity, so the buffer is freed as soon as the file is written
+    auto trace = std::make_shared<TraceFile>();
+    trace->path = path;
+    trace->events.swap(m_captureEvents);
+    trace->startNs = m_captureStartNs;
+    trace->dropped = droppedTraceEvents();
+    trace->frames = m_captureFramesTotal;
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        for (const auto& buffer : m_threads) trace->threadNames.emplace_back(buffer->tid, buffer->name);
+    }
+    m_capturedEventCount = trace->events.size();
+    m_lastCapturePath = path;
+
+    if (!m_backgroundWrites) {
+        writeTraceFile(*trace);
+        return;
+    }
+
+    // A thread of its own rather than a job: the main thread helps run
+    // jobs while it waits on systems, and must not pick up a file write
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_pendingWrites.fetch_add(1, std::memory_order_relaxed);
+        m_writeQueue.push_back(std::move(trace));
+        if (!m_traceWriter.joinable()) {
+            m_traceWriter = std::thread([this]() { traceWriterLoop(); });
+        }
+    }
+    m_writeCv.notify_all();
+}
+
+void Profiler::traceWriterLoop() {
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+    while (true) {
+        m_writeCv.wait(lock, [this]() { return m_stopWriter || !m_writeQueue.empty(); });
+        if (m_writeQueue.empty()) return;       // Stopping, nothing left to write
+
+        std::shared_ptr<TraceFile> trace = std::move(m_writeQueue.front());
+        m_writeQueue.pop_front();
+        lock.unlock();
+        writeTraceFile(*trace);
+        trace.reset();
+        lock.lock();
+
+        m_pendingWrites.fetch_sub(1, std::memory_order_release);
+        m_writeCv.notify_all();
+    }
+}
+
+void Profiler::waitForTraceWrites() {
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+    m_writeCv.wait(lock, [this]() { return m_pendingWrites.load(std::memory_order_acquire) == 0; });
+}
+
+uint64_t Profiler::droppedTraceEvents() const {
+    uint64_t dropped = m_captureDropped;
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    for (const auto& buffer : m_threads) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+void Profiler::writeChromeTrace(std::ostream& out, const TraceFile& trace) {
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+           "\"args\":{\"name\":\"Gloaming\"}}";
+
+    for (const auto& [tid, name] : trace.threadNames) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << tid << ",\"args\":{\"name\":";
+        writeJsonString(out, name);
+        out << "}}";
+    }
+
+    // Timestamps are microseconds relative to the start of the capture
+    char buf[96];
+    for (const auto& ev : trace.events) {
+        uint64_t start = std::max(ev.startNs, trace.startNs);
+        uint64_t end = ev.startNs + ev.durNs;
+        uint64_t dur = end > start ? end - start : 0;
+
+        out << ",\n{\"name\":";
+        writeJsonString(out, zoneName(ev.zone));
+        snprintf(buf, sizeof(buf), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                 static_cast<double>(start - trace.startNs) / 1000.0,
+                 static_cast<double>(dur) / 1000.0, ev.tid);
+        out << buf;
+    }
+    out << "\n]}\n";
+}
+
+bool Profiler::writeTraceFile(TraceFile& trace) {
+    // Chronological order; on ties the enclosing (longer) zone goes first
+    std::sort(trace.events.begin(), trace.events.end(),
+              [](const TraceEvent& a, const TraceEvent& b) {
+                  if (a.startNs != b.startNs) return a.startNs < b.startNs;
+                  return a.durNs > b.durNs;
+              });
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    auto parent = fs::path(trace.path).parent_path();
+    if (!parent.empty()) fs::create_directories(parent, ec);
+
+    std::ofstream file(trace.path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOG_ERROR("Profiler: cannot write trace to '{}'", trace.path);
+        return false;
+    }
+    writeChromeTrace(file, trace);
+    if (!file) {
+        LOG_ERROR("Profiler: failed writing trace to '{}'", trace.path);
+        return false;
+    }
+    LOG_INFO("Profiler: wrote {} events over {} frames to '{}'{}",
+             trace.events.size(), trace.frames, trace.path,
+             trace.dropped > 0 ? " (" + std::to_string(trace.dropped) + " dropped)" : "");
+    return true;
+}
+
+void Profiler::setThreadName(std::string_view name) {
+    auto& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    buffer.name = std::string(name);
+}
+
 } // namespace gloaming
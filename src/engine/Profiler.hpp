@@ -1,14 +1,30 @@
 #pragma once
 
+#include "engine/NameTable.hpp"
+
 #include <string>
 #include <string_view>
 #include <vector>
-#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iosfwd>
 #include <cstdint>
+#include <utility>
 
 namespace gloaming {
 
+/// Interned profiler zone name. Resolve once with Profiler::zoneId() and
+/// reuse so the hot path never hashes a string.
+using ProfileZoneId = uint32_t;
+
+struct ProfileZoneTag;
+using ProfileZoneNames = NameTable<ProfileZoneTag>;
+
 /// Per-zone timing statistics.
 struct ProfileZoneStats {
     std::string name;
@@ -18,12 +34,22 @@ struct ProfileZoneStats {
     double maxTimeMs   = 0.0;
     uint64_t sampleCount = 0;
 
+    ProfileZoneId id = ProfileZoneNames::kInvalid;
+
+    /// Zone this one was last opened inside (kNoParent for top-level zones)
+    /// and its nesting depth at that time (0 = top level).
+    ProfileZoneId parentId = ProfileZoneNames::kInvalid;
+    uint32_t depth = 0;
+
+    static constexpr ProfileZoneId kNoParent = ProfileZoneNames::kInvalid;
+
     /// Smoothing factor for the exponential moving average (lower = smoother).
     static constexpr double kSmoothing = 0.1;
 };
 
-/// Lightweight performance profiler with named zone timing, frame budget
-/// tracking, and a ring buffer of recent frame times for graphing.
+/// Lightweight hierarchical performance profiler with zone timing, frame
+/// budget tracking, a ring buffer of recent frame times for graphing, and
+/// on-demand Chrome Trace capture.
 ///
 /// Usage:
 ///   profiler.beginFrame();
@@ -31,16 +57,30 @@ struct ProfileZoneStats {
 ///   { auto z = profiler.scopedZone("Render");  ... }
 ///   profiler.endFrame();
 ///
-/// Zone names are expected to be string literals or long-lived strings.
-/// The profiler stores `const char*` for zone lookup in the hot path and
-/// only allocates `std::string` once per unique zone (on first encounter).
+/// Zones nest: a zone opened while another is open becomes its child, and
+/// its stats record the parent and depth so the overlay can show a tree.
+/// Zone names are interned into ProfileZoneIds; hot call sites can cache the
+/// ID (`static const auto kId = Profiler::zoneId("Physics")`) to skip lookup.
+///
+/// Statistics are kept for zones on the thread that created the profiler
+/// (the main thread). ScopedZones opened on other threads are only recorded
+/// while a trace capture is running.
+///
+/// Trace capture: capture(frames) records every zone on every thread for
+/// the next N frames into per-thread lock-free ring buffers, then writes a
+/// Chrome Trace Event JSON file (open in chrome://tracing or ui.perfetto.dev).
+/// Nothing is recorded into the buffers outside a capture. With background
+/// writes on, the file is sorted and written on the profiler's own writer
+/// thread (never on the main thread, even while it helps a JobSystem), and
+/// the events are freed once it is written.
 class Profiler {
 public:
     /// RAII zone guard. Calls endZone() on destruction.
-    /// Stores a `const char*` to avoid per-frame string allocation.
+    /// Holds only the interned zone ID, so no per-frame allocation.
     class ScopedZone {
     public:
         ScopedZone(Profiler& profiler, const char* name);
+        ScopedZone(Profiler& profiler, ProfileZoneId id);
         ~ScopedZone();
 
         ScopedZone(const ScopedZone&) = delete;
@@ -48,10 +88,22 @@ public:
 
     private:
         Profiler& m_profiler;
-        const char* m_name;
+        ProfileZoneId m_id;
+        uint64_t m_traceStartNs = 0; ///< Set for trace-only zones on worker threads
+        bool m_ownerThread;
     };
 
     Profiler();
+    ~Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /// Intern a zone name (IDs are shared by all profilers).
+    static ProfileZoneId zoneId(std::string_view name) { return ProfileZoneNames::intern(name); }
+
+    /// Name for a zone ID (empty for unknown IDs).
+    static const std::string& zoneName(ProfileZoneId id) { return ProfileZoneNames::name(id); }
 
     /// Call at the very start of each frame.
     void beginFrame();
@@ -61,22 +113,28 @@ public:
 
     /// Start timing a named zone.
     void beginZone(const std::string& name);
+    void beginZone(ProfileZoneId id);
 
     /// Stop timing a named zone and accumulate stats.
     void endZone(const std::string& name);
+    void endZone(ProfileZoneId id);
 
-    /// Create a RAII scoped zone (zero-copy: stores the pointer directly).
-    /// The name must outlive the ScopedZone (string literals are fine).
+    /// Create a RAII scoped zone. The name is resolved to an ID through a
+    /// small per-thread cache, so repeated literals cost a compare, not a hash.
     ScopedZone scopedZone(const char* name);
+    ScopedZone scopedZone(ProfileZoneId id);
 
     // ---- Query API ----
 
     /// Get stats for a specific zone (returns empty stats if not found).
     ProfileZoneStats getZoneStats(const std::string& name) const;
 
-    /// Get all zone stats in insertion order.
+    /// Get all zone stats in first-seen order (parents before their children).
     const std::vector<ProfileZoneStats>& getAllZoneStats() const { return m_zoneStatsVec; }
 
+    /// Number of zones currently open on the main thread.
+    size_t openZoneDepth() const { return m_activeZones.size(); }
+
     /// Total frame time of the last completed frame (ms).
     double frameTimeMs() const { return m_frameTimeMs; }
 
@@ -110,20 +168,94 @@ public:
     const std::vector<float>& frameTimeHistory() const { return m_history; }
     size_t historyIndex() const { return m_historyIndex; }
 
+    // ---- Trace capture ----
+
+    /// Capture the next `frames` frames into a Chrome Trace JSON file.
+    /// An empty path writes to traces/trace_<timestamp>.json. Enables the
+    /// profiler if it was disabled. Returns false if a capture is already
+    /// pending or running, or frames <= 0.
+    bool capture(int frames, const std::string& path = "");
+
+    /// Whether a capture is pending or running.
+    bool isCapturing() const { return m_captureFramesLeft > 0; }
+
+    /// Frames left in the current (or pending) capture.
+    int captureFramesRemaining() const { return m_captureFramesLeft; }
+
+    /// Path of the most recent capture's trace file (empty if none yet).
+    /// The file may still be being written; see isWritingTrace().
+    const std::string& lastCapturePath() const { return m_lastCapturePath; }
+
+    /// Number of events in the most recent capture.
+    size_t capturedEventCount() const { return m_capturedEventCount; }
+
+    /// Events lost because a thread's ring buffer or the capture was full.
+    uint64_t droppedTraceEvents() const;
+
+    /// Write finished captures on a background thread instead of
+    /// synchronously in endFrame() (off by default).
+    void setBackgroundTraceWrites(bool enabled) { m_backgroundWrites = enabled; }
+
+    /// Whether a finished capture is still being written.
+    bool isWritingTrace() const { return m_pendingWrites.load(std::memory_order_acquire) > 0; }
+
+    /// Block until every trace file is written.
+    void waitForTraceWrites();
+
+    /// Name the calling thread in captured traces (e.g. "Worker 2").
+    void setThreadName(std::string_view name);
+
+    /// Per-thread ring buffer capacity (events) and per-capture event cap.
+    static constexpr size_t kThreadBufferSize = 16384;
+    static constexpr size_t kMaxCaptureEvents = 1u << 21;
+
     /// Reset all statistics.
     void reset();
 
     /// Whether profiling is currently active. When disabled, beginZone/endZone
     /// are no-ops for zero overhead.
-    bool isEnabled() const { return m_enabled; }
-    void setEnabled(bool enabled) { m_enabled = enabled; }
-    void toggle() { m_enabled = !m_enabled; }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    void toggle() { setEnabled(!isEnabled()); }
 
 private:
     using Clock = std::chrono::high_resolution_clock;
     using TimePoint = Clock::time_point;
 
-    bool m_enabled = true;
+    /// One completed zone as recorded for tracing.
+    struct TraceEvent {
+        uint64_t startNs = 0;
+        uint64_t durNs   = 0;
+        ProfileZoneId zone = 0;
+        uint32_t tid = 0;
+    };
+
+    /// Single-producer/single-consumer ring owned by one thread (defined in .cpp).
+    struct ThreadBuffer;
+
+    /// A finished capture, owned by the job that writes it.
+    struct TraceFile {
+        std::string path;
+        std::vector<TraceEvent> events;
+        std::vector<std::pair<uint32_t, std::string>> threadNames;
+        uint64_t startNs = 0;
+        uint64_t dropped = 0;
+        int frames = 0;
+    };
+
+    static uint64_t nowNs();
+
+    ThreadBuffer& threadBuffer();
+    void recordTrace(ProfileZoneId zone, uint64_t startNs, uint64_t endNs);
+    void drainThreadBuffers();
+    void finishCapture();
+    static void writeChromeTrace(std::ostream& out, const TraceFile& trace);
+    static bool writeTraceFile(TraceFile& trace);
+    void traceWriterLoop();
+
+    std::atomic<bool> m_enabled{true};
+    const uint64_t m_instanceId;
+    const std::thread::id m_ownerThread;
 
     // Frame-level timing
     TimePoint m_frameStart;
@@ -136,23 +268,48 @@ private:
     // Frame budget
     double m_frameBudgetMs = 16.6667; // 60 FPS
 
-    // Per-zone active timers — small flat vector for cache-friendly iteration.
-    // Typical engines have < 10 profiler zones per frame so linear search wins.
+    // Open zones on the main thread, innermost last. Typical nesting is a
+    // handful deep so linear search from the top wins.
     struct ActiveZone {
-        std::string name;
+        ProfileZoneId id;
         TimePoint start;
     };
     std::vector<ActiveZone> m_activeZones;
 
-    // Zone statistics — vector for ordered iteration, map for O(1) lookup
+    // Zone statistics — vector for ordered iteration, indexed by zone ID
+    // (-1 = no stats yet) for O(1) lookup without hashing.
     std::vector<ProfileZoneStats> m_zoneStatsVec;
-    std::unordered_map<std::string, size_t> m_zoneIndexMap;
+    std::vector<int32_t> m_zoneIndex;
 
-    ProfileZoneStats& getOrCreateZone(const std::string& name);
+    ProfileZoneStats& getOrCreateZone(ProfileZoneId id);
 
     // Frame time history ring buffer
     std::vector<float> m_history;
     size_t m_historyIndex = 0;
+
+    // Trace capture
+    std::atomic<bool> m_capturing{false};
+    int m_captureFramesLeft = 0;
+    int m_captureFramesTotal = 0;
+    std::string m_capturePath;
+    std::string m_lastCapturePath;
+    uint64_t m_captureStartNs = 0;
+    uint64_t m_frameStartNs = 0;
+    uint64_t m_captureDropped = 0;
+    size_t m_capturedEventCount = 0;
+    std::vector<TraceEvent> m_captureEvents;
+    bool m_backgroundWrites = false;
+    std::atomic<size_t> m_pendingWrites{0};
+
+    // Background trace writer, started by the first background write
+    std::thread m_traceWriter;
+    std::mutex m_writeMutex;
+    std::condition_variable m_writeCv;      ///< Queue filled, write finished, or stopping
+    std::deque<std::shared_ptr<TraceFile>> m_writeQueue;   // guarded by m_writeMutex
+    bool m_stopWriter = false;                             // guarded by m_writeMutex
+
+    mutable std::mutex m_threadsMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
 };
 
 } // namespace gloaming
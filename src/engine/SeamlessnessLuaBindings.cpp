@@ -23,42 +23,33 @@ void bindSeamlessnessAPI(sol::state& lua, Engine& engine) {
 
     // engine.on_suspend(callback) -> handler_id
     // Shorthand for event.on("engine.suspend", callback)
-    engineApi["on_suspend"] = [&engine](sol::function callback) -> uint64_t {
-        sol::function fn = callback;
-        auto& eventBus = engine.getEventBus();
-        return eventBus.on("engine.suspend", [fn](const EventData&) -> bool {
-            try { fn(); }
-            catch (const std::exception& ex) {
-                MOD_LOG_ERROR("engine.on_suspend callback error: {}", ex.what());
-            }
+    engineApi["on_suspend"] = [&engine](sol::protected_function callback) -> uint64_t {
+        auto fn = engine.getModLoader().getLuaBindings().modCallback(
+            std::move(callback), "engine.on_suspend callback");
+        return engine.getEventBus().on("engine.suspend", [fn](const EventData&) -> bool {
+            fn();
             return false;  // Don't cancel the event
         });
     };
 
     // engine.on_resume(callback) -> handler_id
     // Shorthand for event.on("engine.resume", callback)
-    engineApi["on_resume"] = [&engine](sol::function callback) -> uint64_t {
-        sol::function fn = callback;
-        auto& eventBus = engine.getEventBus();
-        return eventBus.on("engine.resume", [fn](const EventData&) -> bool {
-            try { fn(); }
-            catch (const std::exception& ex) {
-                MOD_LOG_ERROR("engine.on_resume callback error: {}", ex.what());
-            }
+    engineApi["on_resume"] = [&engine](sol::protected_function callback) -> uint64_t {
+        auto fn = engine.getModLoader().getLuaBindings().modCallback(
+            std::move(callback), "engine.on_resume callback");
+        return engine.getEventBus().on("engine.resume", [fn](const EventData&) -> bool {
+            fn();
             return false;
         });
     };
 
     // engine.on_shutdown(callback) -> handler_id
     // Shorthand for event.on("engine.shutdown", callback)
-    engineApi["on_shutdown"] = [&engine](sol::function callback) -> uint64_t {
-        sol::function fn = callback;
-        auto& eventBus = engine.getEventBus();
-        return eventBus.on("engine.shutdown", [fn](const EventData&) -> bool {
-            try { fn(); }
-            catch (const std::exception& ex) {
-                MOD_LOG_ERROR("engine.on_shutdown callback error: {}", ex.what());
-            }
+    engineApi["on_shutdown"] = [&engine](sol::protected_function callback) -> uint64_t {
+        auto fn = engine.getModLoader().getLuaBindings().modCallback(
+            std::move(callback), "engine.on_shutdown callback");
+        return engine.getEventBus().on("engine.shutdown", [fn](const EventData&) -> bool {
+            fn();
             return false;
         });
     };
@@ -5,6 +5,16 @@
 namespace gloaming {
 
 bool Window::init(const WindowConfig& config) {
+    if (config.headless) {
+        // Nothing to open: every query answers from the config and every
+        // window operation is a no-op, so callers need no special cases
+        m_headless = true;
+        m_headlessWidth = config.width;
+        m_headlessHeight = config.height;
+        m_fullscreenMode = FullscreenMode::Windowed;
+        return true;
+    }
+
     unsigned int flags = FLAG_WINDOW_RESIZABLE;
     if (config.vsync) {
         flags |= FLAG_VSYNC_HINT;
@@ -41,6 +51,7 @@ bool Window::init(const WindowConfig& config) {
 }
 
 void Window::shutdown() {
+    m_headless = false;
     if (m_initialized) {
         CloseWindow();
         m_initialized = false;
@@ -48,31 +59,38 @@ void Window::shutdown() {
 }
 
 bool Window::shouldClose() const {
+    if (m_headless) return false;
     return WindowShouldClose();
 }
 
 void Window::beginFrame() {
+    if (m_headless) return;
     BeginDrawing();
     ClearBackground({20, 20, 30, 255});
 }
 
 void Window::endFrame() {
+    if (m_headless) return;
     EndDrawing();
 }
 
 int Window::getWidth() const {
+    if (m_headless) return m_headlessWidth;
     return GetScreenWidth();
 }
 
 int Window::getHeight() const {
+    if (m_headless) return m_headlessHeight;
     return GetScreenHeight();
 }
 
 void Window::setTitle(const std::string& title) {
+    if (m_headless) return;
     SetWindowTitle(title.c_str());
 }
 
 void Window::toggleFullscreen() {
+    if (m_headless) return;
     if (m_fullscreenMode == FullscreenMode::Windowed) {
         // Enter borderless fullscreen by default when toggling
         ToggleBorderlessWindowed();
@@ -89,7 +107,7 @@ void Window::toggleFullscreen() {
 }
 
 void Window::setFullscreenMode(FullscreenMode mode) {
-    if (mode == m_fullscreenMode) return;
+    if (m_headless || mode == m_fullscreenMode) return;
 
     // First, exit current mode
     if (m_fullscreenMode == FullscreenMode::Fullscreen) {
@@ -109,6 +127,7 @@ void Window::setFullscreenMode(FullscreenMode mode) {
 }
 
 int Window::getRefreshRate() const {
+    if (m_headless) return 0;
     return GetMonitorRefreshRate(GetCurrentMonitor());
 }
 
@@ -117,6 +136,7 @@ bool Window::isFullscreen() const {
 }
 
 bool Window::isFocused() const {
+    if (m_headless) return true;
     return IsWindowFocused();
 }
 
@@ -17,6 +17,7 @@ struct WindowConfig {
     bool        fullscreen = false;
     bool        vsync      = true;
     FullscreenMode fullscreenMode = FullscreenMode::BorderlessFullscreen;
+    bool        headless   = false;  ///< No OS window; size is reported as configured
 };
 
 class Window {
@@ -51,8 +52,14 @@ public:
     /// returns false.  Call exactly once per frame.
     bool pollSizeChanged();
 
+    /// True when created without an OS window (headless mode).
+    bool isHeadless() const { return m_headless; }
+
 private:
     bool m_initialized = false;
+    bool m_headless = false;
+    int m_headlessWidth = 0;
+    int m_headlessHeight = 0;
     FullscreenMode m_fullscreenMode = FullscreenMode::Windowed;
     int m_lastWidth = 0;
     int m_lastHeight = 0;
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "ecs/Components.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace gloaming {
+
+/// Distance tiers for AI level of detail.
+enum class AILodTier : uint8_t {
+    Near = 0,   ///< Updated every frame
+    Mid  = 1,   ///< Updated every AILodConfig::midInterval frames
+    Far  = 2,   ///< Updated every AILodConfig::farInterval frames
+    Count
+};
+
+/// Configuration for AILodScheduler.
+struct AILodConfig {
+    bool enabled = true;
+    float nearDistance = 640.0f;   ///< Agents closer than this to a player/camera run every frame
+    float midDistance = 1600.0f;   ///< Agents closer than this run every midInterval frames
+    uint32_t midInterval = 4;
+    uint32_t farInterval = 16;
+};
+
+/// Per-agent LOD bookkeeping, embedded in AI components (EnemyAI, NPCAI).
+struct AILodState {
+    float pendingDt = 0.0f;                 ///< Time accumulated since the agent last ran
+    AILodTier tier = AILodTier::Near;       ///< Tier chosen on the agent's last check
+};
+
+/// Decides, per agent per frame, whether an AI agent runs this frame.
+///
+/// Agents are tiered by squared distance to the nearest reference point
+/// (players and the camera center). A tier with interval N runs each agent
+/// once every N frames; which frame is chosen from the entity ID, so a tier's
+/// agents are spread round-robin across the N frames instead of all running
+/// together. Skipped frames accumulate dt, and an agent that runs receives
+/// the whole accumulated step, so timers and movement stay correct.
+///
+/// Usage per frame:
+///   lod.beginFrame();
+///   lod.addReferencePoint(playerPos);  // for each player, plus the camera
+///   float step;
+///   if (lod.shouldUpdate(entity, pos, ai.lod, dt, step)) runAI(step);
+class AILodScheduler {
+public:
+    void setConfig(const AILodConfig& config) { m_config = config; }
+    const AILodConfig& getConfig() const { return m_config; }
+
+    /// Advance the frame counter and forget last frame's reference points.
+    void beginFrame() {
+        ++m_frame;
+        m_referencePoints.clear();
+        m_updated.fill(0);
+        m_skipped = 0;
+    }
+
+    void addReferencePoint(const Vec2& point) { m_referencePoints.push_back(point); }
+
+    /// Tier for an agent at `position` (Near when there are no reference points).
+    AILodTier tierFor(const Vec2& position) const {
+        if (!m_config.enabled || m_referencePoints.empty()) return AILodTier::Near;
+
+        float nearestSq = -1.0f;
+        for (const auto& point : m_referencePoints) {
+            float dx = point.x - position.x;
+            float dy = point.y - position.y;
+            float distSq = dx * dx + dy * dy;
+            if (nearestSq < 0.0f || distSq < nearestSq) nearestSq = distSq;
+        }
+
+        if (nearestSq < m_config.nearDistance * m_config.nearDistance) return AILodTier::Near;
+        if (nearestSq < m_config.midDistance * m_config.midDistance) return AILodTier::Mid;
+        return AILodTier::Far;
+    }
+
+    /// Frames between updates for a tier.
+    uint32_t intervalFor(AILodTier tier) const {
+        switch (tier) {
+            case AILodTier::Mid: return m_config.midInterval > 0 ? m_config.midInterval : 1;
+            case AILodTier::Far: return m_config.farInterval > 0 ? m_config.farInterval : 1;
+            default:             return 1;
+        }
+    }
+
+    /// Accumulate dt for an agent and decide whether it runs this frame.
+    /// When it does, `stepDt` receives the time since its last update.
+    bool shouldUpdate(Entity entity, const Vec2& position, AILodState& state,
+                      float dt, float& stepDt) {
+        state.pendingDt += dt;
+        state.tier = tierFor(position);
+
+        uint32_t interval = intervalFor(state.tier);
+        uint32_t slot = static_cast<uint32_t>(entity);
+        if (interval > 1 && (m_frame + slot) % interval != 0) {
+            ++m_skipped;
+            return false;
+        }
+
+        stepDt = state.pendingDt;
+        state.pendingDt = 0.0f;
+        ++m_updated[static_cast<size_t>(state.tier)];
+        return true;
+    }
+
+    /// Agents updated this frame in a tier.
+    uint32_t updatedCount(AILodTier tier) const { return m_updated[static_cast<size_t>(tier)]; }
+
+    /// Agents skipped this frame (all tiers).
+    uint32_t skippedCount() const { return m_skipped; }
+
+    uint64_t frame() const { return m_frame; }
+
+private:
+    AILodConfig m_config;
+    uint64_t m_frame = 0;
+    std::vector<Vec2> m_referencePoints;
+    std::array<uint32_t, static_cast<size_t>(AILodTier::Count)> m_updated{};
+    uint32_t m_skipped = 0;
+};
+
+} // namespace gloaming
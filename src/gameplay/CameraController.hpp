@@ -70,7 +70,11 @@ struct CameraTarget {
 class CameraControllerSystem : public System {
 public:
     explicit CameraControllerSystem(const CameraControllerConfig& config = {})
-        : System("CameraControllerSystem", -100), m_config(config) {}
+        : System("CameraControllerSystem", -100), m_config(config) {
+        declareAccess()
+            .reads<Transform, CameraTarget, Velocity>()
+            .writes<resource::Camera>();
+    }
 
     void init(Registry& registry, Engine& engine) override {
         System::init(registry, engine);
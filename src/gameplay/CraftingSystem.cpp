@@ -12,17 +12,22 @@ bool CraftingManager::canCraft(const std::string& recipeId, const Inventory& inv
     const RecipeDefinition* recipe = m_contentRegistry->getRecipe(recipeId);
     if (!recipe) return false;
 
+    return canCraftRecipe(*recipe, inventory, position);
+}
+
+bool CraftingManager::canCraftRecipe(const RecipeDefinition& recipe, const Inventory& inventory,
+                                      const Vec2& position) const {
     // Check ingredients
-    if (!hasIngredients(*recipe, inventory)) return false;
+    if (!hasIngredients(recipe, inventory)) return false;
 
     // Check station proximity
-    if (!recipe->station.empty()) {
-        if (!isStationNearby(recipe->station, position)) return false;
+    if (!recipe.station.empty()) {
+        if (!isStationNearby(recipe.station, position)) return false;
     }
 
     // Check that result can fit in inventory
     int maxStack = 999;
-    const ItemDefinition* resultItemDef = m_contentRegistry->getItem(recipe->resultItem);
+    const ItemDefinition* resultItemDef = m_contentRegistry->getItem(recipe.resultItem);
     if (resultItemDef) {
         maxStack = resultItemDef->maxStack;
     }
@@ -31,13 +36,13 @@ bool CraftingManager::canCraft(const std::string& recipeId, const Inventory& inv
     for (const auto& slot : inventory.slots) {
         if (slot.isEmpty()) {
             availableSpace += maxStack;
-        } else if (slot.matches(recipe->resultItem) && slot.count < maxStack) {
+        } else if (slot.matches(recipe.resultItem) && slot.count < maxStack) {
             availableSpace += maxStack - slot.count;
         }
-        if (availableSpace >= recipe->resultCount) break;
+        if (availableSpace >= recipe.resultCount) break;
     }
 
-    if (availableSpace < recipe->resultCount) return false;
+    if (availableSpace < recipe.resultCount) return false;
 
     return true;
 }
@@ -109,10 +114,10 @@ std::vector<std::string> CraftingManager::getAvailableRecipes(
     std::vector<std::string> result;
     if (!m_contentRegistry) return result;
 
-    auto allIds = m_contentRegistry->getRecipeIds();
-    for (const auto& id : allIds) {
-        if (canCraft(id, inventory, position)) {
-            result.push_back(id);
+    // Walk the flat recipe table instead of resolving every ID by name
+    for (const auto& recipe : m_contentRegistry->getRecipes()) {
+        if (canCraftRecipe(recipe, inventory, position)) {
+            result.push_back(recipe.qualifiedId.empty() ? recipe.id : recipe.qualifiedId);
         }
     }
     return result;
@@ -55,6 +55,10 @@ public:
     bool isStationNearby(const std::string& stationTileId, const Vec2& position) const;
 
 private:
+    /// canCraft() for an already-resolved recipe
+    bool canCraftRecipe(const RecipeDefinition& recipe, const Inventory& inventory,
+                        const Vec2& position) const;
+
     /// Check if all ingredients are present in the inventory
     bool hasIngredients(const RecipeDefinition& recipe, const Inventory& inventory) const;
 
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "ecs/Components.hpp"
+#include "gameplay/AILod.hpp"
+#include "engine/NameTable.hpp"
 
 #include <string>
+#include <string_view>
+#include <ostream>
 #include <cstdint>
 
 namespace gloaming {
@@ -33,17 +37,88 @@ namespace AIBehavior {
     constexpr const char* Guard       = "guard";
     constexpr const char* Orbit       = "orbit";
     constexpr const char* StrafeRun   = "strafe_run";
+    constexpr const char* Custom      = "custom";   ///< Skipped by EnemyAISystem (FSM-driven)
 }
 
+/// Fixed IDs of the built-in behaviors, in AIBehaviorId's ID space.
+/// Names registered by mods get IDs after Count.
+enum class BuiltinAIBehavior : uint32_t {
+    Idle, PatrolWalk, PatrolFly, PatrolPath, Chase, Flee, Guard, Orbit, StrafeRun, Custom,
+    Count
+};
+
+struct AIBehaviorTag;
+using AIBehaviorNames = NameTable<AIBehaviorTag>;
+
+/// A behavior name interned to a dense integer ID on assignment.
+///
+/// Behaves like the string it was made from (assign, compare and print by
+/// name), but the per-frame dispatch in EnemyAISystem only ever looks at
+/// id(). Built-in names always map to their BuiltinAIBehavior value.
+class AIBehaviorId {
+public:
+    AIBehaviorId() : AIBehaviorId(BuiltinAIBehavior::Idle) {}
+    AIBehaviorId(BuiltinAIBehavior builtin) : m_id(static_cast<uint32_t>(builtin)) { seedBuiltins(); }
+    AIBehaviorId(std::string_view name) : m_id(intern(name)) {}
+    AIBehaviorId(const char* name) : m_id(intern(name)) {}
+    AIBehaviorId(const std::string& name) : m_id(intern(name)) {}
+
+    uint32_t id() const { return m_id; }
+    const std::string& name() const {
+        seedBuiltins();
+        return AIBehaviorNames::name(m_id);
+    }
+
+    bool isBuiltin() const { return m_id < static_cast<uint32_t>(BuiltinAIBehavior::Count); }
+    BuiltinAIBehavior builtin() const { return static_cast<BuiltinAIBehavior>(m_id); }
+
+    /// ID for a name (interning it if new). Built-in names are seeded first,
+    /// so they always get their BuiltinAIBehavior value.
+    static uint32_t intern(std::string_view name) {
+        seedBuiltins();
+        return AIBehaviorNames::intern(name);
+    }
+
+    friend bool operator==(const AIBehaviorId& a, const AIBehaviorId& b) { return a.m_id == b.m_id; }
+    friend bool operator==(const AIBehaviorId& a, BuiltinAIBehavior b) { return a.builtin() == b; }
+    friend bool operator==(const AIBehaviorId& a, std::string_view b) { return a.name() == b; }
+    friend bool operator==(const AIBehaviorId& a, const char* b) { return a.name() == b; }
+    friend bool operator==(const AIBehaviorId& a, const std::string& b) { return a.name() == b; }
+
+    friend std::ostream& operator<<(std::ostream& os, const AIBehaviorId& b) { return os << b.name(); }
+
+private:
+    /// Intern the built-in names, once, before any ID is made or named.
+    /// Every path to an ID goes through here, so a built-in ID is never
+    /// handed out before its name exists.
+    static void seedBuiltins() {
+        static const bool seeded = [] {
+            // Order must match BuiltinAIBehavior
+            for (const char* name : {AIBehavior::Idle, AIBehavior::PatrolWalk, AIBehavior::PatrolFly,
+                                     AIBehavior::PatrolPath, AIBehavior::Chase, AIBehavior::Flee,
+                                     AIBehavior::Guard, AIBehavior::Orbit, AIBehavior::StrafeRun,
+                                     AIBehavior::Custom}) {
+                AIBehaviorNames::intern(name);
+            }
+            return true;
+        }();
+        (void)seeded;
+    }
+
+    uint32_t m_id;
+};
+
 /// EnemyAI component — drives enemy decision-making each frame.
 ///
-/// The `behavior` string references a built-in behavior or a mod-registered one.
-/// Built-in behaviors are handled by EnemyAISystem. For custom Lua-driven AI,
-/// set behavior to "custom" and use fsm.add_state() / fsm.set_state() on the
-/// same entity — EnemyAISystem will skip entities whose behavior is "custom".
+/// `behavior` names a built-in behavior or a mod-registered one; assigning a
+/// name interns it, so switching behaviors costs one lookup and dispatch is by
+/// integer. Built-in behaviors are handled by EnemyAISystem. For custom
+/// Lua-driven AI, set behavior to "custom" and use fsm.add_state() /
+/// fsm.set_state() on the same entity — EnemyAISystem will skip entities whose
+/// behavior is "custom".
 struct EnemyAI {
-    std::string behavior = "idle";      ///< Active behavior name (from AIBehavior:: or custom)
-    std::string defaultBehavior = "idle"; ///< Behavior to return to after chase/flee ends
+    AIBehaviorId behavior;              ///< Active behavior (from AIBehavior:: or custom)
+    AIBehaviorId defaultBehavior;       ///< Behavior to return to after chase/flee ends
 
     float detectionRange = 200.0f;      ///< Range at which the enemy detects the player
     float attackRange = 32.0f;          ///< Range at which the enemy attacks
@@ -75,8 +150,11 @@ struct EnemyAI {
     float despawnTimer = 0.0f;          ///< Accumulated time out of range
     float despawnDelay = 5.0f;          ///< Seconds out of range before despawn
 
+    AILodState lod;                     ///< Update-rate bookkeeping (EnemyAISystem)
+
     EnemyAI() = default;
     explicit EnemyAI(const std::string& bhv) : behavior(bhv), defaultBehavior(bhv) {}
+    explicit EnemyAI(const char* bhv) : behavior(bhv), defaultBehavior(bhv) {}
 };
 
 /// Configuration for the enemy spawn manager
@@ -5,10 +5,24 @@
 #include "world/TileMap.hpp"
 #include "mod/EventBus.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace gloaming {
 
+namespace {
+
+// Event names and payload keys, interned once so emit sites never hash strings
+const EventId  kEnemyRemovedEvent       = EventNames::intern("enemy_removed");
+const EventId  kEnemyContactDamageEvent = EventNames::intern("enemy_contact_damage");
+const EventKey kKeyEntity               = EventNames::intern("entity");
+const EventKey kKeyReason               = EventNames::intern("reason");
+const EventKey kKeyEnemy                = EventNames::intern("enemy");
+const EventKey kKeyPlayer               = EventNames::intern("player");
+const EventKey kKeyDamage               = EventNames::intern("damage");
+
+} // namespace
+
 void EnemyAISystem::init(Registry& registry, Engine& engine) {
     System::init(registry, engine);
     m_tileMap = &engine.getTileMap();
@@ -19,85 +33,179 @@ void EnemyAISystem::init(Registry& registry, Engine& engine) {
 
 void EnemyAISystem::shutdown() {
     m_customBehaviors.clear();
+    m_batches.clear();
+    m_players.clear();
 }
 
 void EnemyAISystem::registerBehavior(const std::string& name, CustomAIBehavior behavior) {
-    m_customBehaviors[name] = std::move(behavior);
+    uint32_t id = AIBehaviorId::intern(name);
+    if (id >= m_customBehaviors.size()) m_customBehaviors.resize(id + 1);
+    m_customBehaviors[id] = std::move(behavior);
 }
 
 bool EnemyAISystem::hasBehavior(const std::string& name) const {
-    return m_customBehaviors.find(name) != m_customBehaviors.end();
+    uint32_t id = AIBehaviorNames::find(name);
+    return id < m_customBehaviors.size() && m_customBehaviors[id];
+}
+
+size_t EnemyAISystem::lastBatchSize(AIBehaviorId behavior) const {
+    return behavior.id() < m_batches.size() ? m_batches[behavior.id()].size() : 0;
+}
+
+void EnemyAISystem::BehaviorBatch::clear() {
+    entities.clear();
+    ai.clear();
+    dt.clear();
+    velocity.clear();
+    position.clear();
+    targetPosition.clear();
+    hasTarget.clear();
+    healthPercent.clear();
+}
+
+EnemyAISystem::BehaviorBatch& EnemyAISystem::batchFor(uint32_t behaviorId) {
+    if (behaviorId >= m_batches.size()) m_batches.resize(behaviorId + 1);
+    return m_batches[behaviorId];
 }
 
 void EnemyAISystem::update(float dt) {
     auto& registry = getRegistry();
     m_viewMode = getEngine().getGameModeConfig().viewMode;
 
-    // Collect entities to despawn (can't destroy during iteration)
-    std::vector<Entity> toDespawn;
+    gatherPlayers();
+    for (auto& batch : m_batches) batch.clear();
+    m_toDespawn.clear();
 
+    m_lod.beginFrame();
+    for (const auto& player : m_players) m_lod.addReferencePoint(player.position);
+    m_lod.addReferencePoint(getEngine().getCamera().getPosition());
+
+    constexpr uint32_t kCustomId = static_cast<uint32_t>(BuiltinAIBehavior::Custom);
+    constexpr uint32_t kIdleId   = static_cast<uint32_t>(BuiltinAIBehavior::Idle);
+    constexpr uint32_t kFleeId   = static_cast<uint32_t>(BuiltinAIBehavior::Flee);
+
+    // Pass 1: shared per-enemy logic, then sort each enemy into its behavior batch
     registry.each<EnemyAI, Transform>([&](Entity entity, EnemyAI& ai, Transform& transform) {
+        uint32_t behaviorId = ai.behavior.id();
+
         // Skip "custom" behavior — those use the FSM system directly
-        if (ai.behavior == "custom") return;
+        if (behaviorId == kCustomId) return;
 
-        // 1. Despawn check
-        if (checkDespawn(entity, transform, ai, dt)) {
-            toDespawn.push_back(entity);
+        // Distant enemies only run every few frames, with the accumulated dt
+        float step = 0.0f;
+        if (!m_lod.shouldUpdate(entity, transform.position, ai.lod, dt, step)) return;
+
+        // 1. Despawn check (can't destroy during iteration)
+        if (checkDespawn(transform, ai, step)) {
+            m_toDespawn.push_back(entity);
             return;
         }
 
         // 2. Contact damage (with cooldown)
-        checkContactDamage(entity, transform, ai);
+        if (ai.contactDamage > 0 && ai.attackTimer <= 0.0f) {
+            if (const auto* collider = registry.tryGet<Collider>(entity)) {
+                checkContactDamage(entity, transform, *collider, ai);
+            }
+        }
 
         // 3. Target acquisition (periodic)
-        ai.targetCheckTimer -= dt;
+        ai.targetCheckTimer -= step;
         if (ai.targetCheckTimer <= 0.0f) {
             ai.targetCheckTimer = ai.targetCheckInterval;
             ai.target = findNearestPlayer(transform.position, ai.detectionRange);
         }
 
         // 4. Health-based behavior transitions
-        if (registry.has<Health>(entity)) {
-            auto& health = registry.get<Health>(entity);
-            if (!health.isDead() && health.getPercentage() < ai.fleeHealthThreshold &&
-                ai.behavior != AIBehavior::Flee) {
-                ai.behavior = AIBehavior::Flee;
+        float healthPercent = -1.0f;
+        if (const auto* health = registry.tryGet<Health>(entity)) {
+            healthPercent = health->getPercentage();
+            if (!health->isDead() && healthPercent < ai.fleeHealthThreshold &&
+                behaviorId != kFleeId) {
+                ai.behavior = BuiltinAIBehavior::Flee;
+                behaviorId = kFleeId;
             }
         }
 
         // 5. Update attack timer
         if (ai.attackTimer > 0.0f) {
-            ai.attackTimer -= dt;
+            ai.attackTimer -= step;
         }
 
-        // 6. Execute current behavior
-        // Check custom behaviors first
-        auto customIt = m_customBehaviors.find(ai.behavior);
-        if (customIt != m_customBehaviors.end()) {
-            customIt->second(entity, ai, dt);
+        // 6. Queue for the behavior pass. Custom behaviors only need the entity;
+        // built-ins (except idle, which does nothing) need a Velocity to steer.
+        bool isCustom = behaviorId < m_customBehaviors.size() && m_customBehaviors[behaviorId];
+        if (isCustom) {
+            auto& batch = batchFor(behaviorId);
+            batch.entities.push_back(entity);
+            batch.dt.push_back(step);
             return;
         }
+        if (behaviorId == kIdleId || !ai.behavior.isBuiltin()) return;
+
+        auto* velocity = registry.tryGet<Velocity>(entity);
+        if (!velocity) return;
+
+        Vec2 targetPosition;
+        bool hasTarget = false;
+        if (ai.target != NullEntity && registry.valid(ai.target)) {
+            if (const auto* targetTransform = registry.tryGet<Transform>(ai.target)) {
+                targetPosition = targetTransform->position;
+                hasTarget = true;
+            }
+        }
 
-        // Built-in behaviors
-        if (ai.behavior == AIBehavior::Idle)          behaviorIdle(entity, ai, dt);
-        else if (ai.behavior == AIBehavior::PatrolWalk)  behaviorPatrolWalk(entity, ai, dt);
-        else if (ai.behavior == AIBehavior::PatrolFly)   behaviorPatrolFly(entity, ai, dt);
-        else if (ai.behavior == AIBehavior::PatrolPath)  behaviorPatrolPath(entity, ai, dt);
-        else if (ai.behavior == AIBehavior::Chase)       behaviorChase(entity, ai, dt);
-        else if (ai.behavior == AIBehavior::Flee)        behaviorFlee(entity, ai, dt);
-        else if (ai.behavior == AIBehavior::Guard)       behaviorGuard(entity, ai, dt);
-        else if (ai.behavior == AIBehavior::Orbit)       behaviorOrbit(entity, ai, dt);
-        else if (ai.behavior == AIBehavior::StrafeRun)   behaviorStrafeRun(entity, ai, dt);
+        auto& batch = batchFor(behaviorId);
+        batch.entities.push_back(entity);
+        batch.ai.push_back(&ai);
+        batch.dt.push_back(step);
+        batch.velocity.push_back(velocity);
+        batch.position.push_back(transform.position);
+        batch.targetPosition.push_back(targetPosition);
+        batch.hasTarget.push_back(hasTarget ? 1 : 0);
+        batch.healthPercent.push_back(healthPercent);
     });
 
+    // Pass 2: built-in behaviors, one tight loop per behavior
+    for (uint32_t id = 0; id < m_batches.size() && id < kCustomId; ++id) {
+        auto& batch = m_batches[id];
+        if (batch.ai.empty()) continue;   // empty, or overridden by a custom behavior
+        switch (static_cast<BuiltinAIBehavior>(id)) {
+            case BuiltinAIBehavior::PatrolWalk: behaviorPatrolWalk(batch); break;
+            case BuiltinAIBehavior::PatrolFly:  behaviorPatrolFly(batch);  break;
+            case BuiltinAIBehavior::PatrolPath: behaviorPatrolPath(batch); break;
+            case BuiltinAIBehavior::Chase:      behaviorChase(batch);      break;
+            case BuiltinAIBehavior::Flee:       behaviorFlee(batch);       break;
+            case BuiltinAIBehavior::Guard:      behaviorGuard(batch);      break;
+            case BuiltinAIBehavior::Orbit:      behaviorOrbit(batch);      break;
+            case BuiltinAIBehavior::StrafeRun:  behaviorStrafeRun(batch);  break;
+            default: break;
+        }
+    }
+
+    // Pass 3: custom behaviors. Callbacks may create or destroy entities, so
+    // components are looked up again rather than cached. They may also
+    // (re)register behaviors, which would destroy a callable mid-call: run a
+    // copy, so a replacement only applies from the next frame.
+    for (uint32_t id = 0; id < m_batches.size() && id < m_customBehaviors.size(); ++id) {
+        if (!m_customBehaviors[id] || m_batches[id].entities.empty()) continue;
+        CustomAIBehavior behavior = m_customBehaviors[id];
+        const auto& batch = m_batches[id];
+        for (size_t i = 0; i < batch.entities.size(); ++i) {
+            Entity entity = batch.entities[i];
+            auto* ai = registry.valid(entity) ? registry.tryGet<EnemyAI>(entity) : nullptr;
+            if (!ai) continue;
+            behavior(entity, *ai, batch.dt[i]);
+        }
+    }
+
     // Destroy despawned entities
-    for (Entity entity : toDespawn) {
+    for (Entity entity : m_toDespawn) {
         if (registry.valid(entity)) {
             if (m_eventBus) {
                 EventData data;
-                data.setInt("entity", static_cast<int>(entity));
-                data.setString("reason", "despawn");
-                m_eventBus->emit("enemy_removed", data);
+                data.setInt(kKeyEntity, static_cast<int>(entity));
+                data.setString(kKeyReason, "despawn");
+                m_eventBus->emit(kEnemyRemovedEvent, data);
             }
             if (m_enemySpawnSystem) {
                 m_enemySpawnSystem->incrementDespawned();
@@ -107,43 +215,53 @@ void EnemyAISystem::update(float dt) {
     }
 }
 
-Entity EnemyAISystem::findNearestPlayer(const Vec2& position, float maxRange) {
+void EnemyAISystem::gatherPlayers() {
     auto& registry = getRegistry();
-    Entity nearest = NullEntity;
-    float nearestDistSq = maxRange * maxRange;
+    m_players.clear();
 
     registry.each<PlayerTag, Transform>([&](Entity player, const PlayerTag&,
                                               const Transform& playerTransform) {
-        float dx = playerTransform.position.x - position.x;
-        float dy = playerTransform.position.y - position.y;
+        PlayerInfo info;
+        info.entity = player;
+        info.position = playerTransform.position;
+        auto* health = registry.tryGet<Health>(player);
+        const auto* collider = registry.tryGet<Collider>(player);
+        if (health && collider) {
+            info.health = health;
+            info.bounds = collider->getBounds(playerTransform);
+            info.velocity = registry.tryGet<Velocity>(player);
+        }
+        m_players.push_back(info);
+    });
+}
+
+Entity EnemyAISystem::findNearestPlayer(const Vec2& position, float maxRange) const {
+    Entity nearest = NullEntity;
+    float nearestDistSq = maxRange * maxRange;
+
+    for (const auto& player : m_players) {
+        float dx = player.position.x - position.x;
+        float dy = player.position.y - position.y;
         float distSq = dx * dx + dy * dy;
         if (distSq < nearestDistSq) {
             nearestDistSq = distSq;
-            nearest = player;
+            nearest = player.entity;
         }
-    });
+    }
 
     return nearest;
 }
 
 void EnemyAISystem::checkContactDamage(Entity enemy, const Transform& enemyTransform,
-                                        EnemyAI& ai) {
-    if (ai.contactDamage <= 0) return;
-    if (ai.attackTimer > 0.0f) return; // Cooldown not elapsed
-
-    auto& registry = getRegistry();
-    if (!registry.has<Collider>(enemy)) return;
-    auto& enemyCollider = registry.get<Collider>(enemy);
-
+                                        const Collider& enemyCollider, EnemyAI& ai) {
     Rect enemyBounds = enemyCollider.getBounds(enemyTransform);
 
-    registry.each<PlayerTag, Transform, Health, Collider>([&](
-            Entity player, const PlayerTag&, const Transform& playerTransform,
-            Health& playerHealth, const Collider& playerCollider) {
+    for (const auto& player : m_players) {
+        if (!player.health) continue;
+        Health& playerHealth = *player.health;
+        if (playerHealth.isDead() || playerHealth.isInvincible()) continue;
 
-        if (playerHealth.isDead() || playerHealth.isInvincible()) return;
-
-        Rect playerBounds = playerCollider.getBounds(playerTransform);
+        const Rect& playerBounds = player.bounds;
 
         // Simple AABB overlap
         bool overlapping =
@@ -159,50 +277,43 @@ void EnemyAISystem::checkContactDamage(Entity enemy, const Transform& enemyTrans
                 ai.attackTimer = ai.attackCooldown;
 
                 // Apply knockback away from enemy
-                if (registry.has<Velocity>(player)) {
-                    auto& vel = registry.get<Velocity>(player);
-                    float dx = playerTransform.position.x - enemyTransform.position.x;
-                    float dy = playerTransform.position.y - enemyTransform.position.y;
+                if (player.velocity) {
+                    float dx = player.position.x - enemyTransform.position.x;
+                    float dy = player.position.y - enemyTransform.position.y;
                     float dist = std::sqrt(dx * dx + dy * dy);
                     if (dist > 0.01f) {
-                        vel.linear.x += (dx / dist) * 200.0f;
-                        vel.linear.y += (dy / dist) * 150.0f;
+                        player.velocity->linear.x += (dx / dist) * 200.0f;
+                        player.velocity->linear.y += (dy / dist) * 150.0f;
                     }
                 }
 
+                // Queued, not emitted: a handler running mid-pass could destroy
+                // the players gathered for this frame
                 if (m_eventBus) {
                     EventData data;
-                    data.setInt("enemy", static_cast<int>(enemy));
-                    data.setInt("player", static_cast<int>(player));
-                    data.setFloat("damage", dealt);
-                    m_eventBus->emit("enemy_contact_damage", data);
+                    data.setInt(kKeyEnemy, static_cast<int>(enemy));
+                    data.setInt(kKeyPlayer, static_cast<int>(player.entity));
+                    data.setFloat(kKeyDamage, dealt);
+                    m_eventBus->queue(kEnemyContactDamageEvent, data);
                 }
             }
         }
-    });
+    }
 }
 
-bool EnemyAISystem::checkDespawn(Entity enemy, const Transform& transform,
-                                  EnemyAI& ai, float dt) {
+bool EnemyAISystem::checkDespawn(const Transform& transform, EnemyAI& ai, float dt) const {
     if (ai.despawnDistance <= 0.0f) return false;
 
-    auto& registry = getRegistry();
+    // If no players exist, despawn immediately
+    if (m_players.empty()) return true;
 
-    // Track whether any player was found
-    bool foundPlayer = false;
     float closestDistSq = ai.despawnDistance * ai.despawnDistance * 4.0f;
-
-    registry.each<PlayerTag, Transform>([&](Entity, const PlayerTag&,
-                                              const Transform& playerTransform) {
-        foundPlayer = true;
-        float dx = playerTransform.position.x - transform.position.x;
-        float dy = playerTransform.position.y - transform.position.y;
+    for (const auto& player : m_players) {
+        float dx = player.position.x - transform.position.x;
+        float dy = player.position.y - transform.position.y;
         float distSq = dx * dx + dy * dy;
         if (distSq < closestDistSq) closestDistSq = distSq;
-    });
-
-    // If no players exist, despawn immediately
-    if (!foundPlayer) return true;
+    }
 
     float despawnDistSq = ai.despawnDistance * ai.despawnDistance;
     if (closestDistSq > despawnDistSq) {
@@ -219,352 +330,350 @@ bool EnemyAISystem::checkDespawn(Entity enemy, const Transform& transform,
 
 // =============================================================================
 // Built-in behavior implementations
+//
+// Each runs once per frame over every enemy currently in that behavior. A
+// behavior switch made here (e.g. patrol -> chase) takes effect next frame.
 // =============================================================================
 
-void EnemyAISystem::behaviorIdle(Entity /*entity*/, EnemyAI& /*ai*/, float /*dt*/) {
-    // Do nothing — enemies with "idle" just stand there
-    // Useful for turrets or enemies waiting for triggers
-}
-
-void EnemyAISystem::behaviorPatrolWalk(Entity entity, EnemyAI& ai, float dt) {
-    auto& registry = getRegistry();
-    if (!registry.has<Velocity>(entity)) return;
-    auto& velocity = registry.get<Velocity>(entity);
-    auto& transform = registry.get<Transform>(entity);
-
-    // If a player is detected, switch to chase
-    if (ai.target != NullEntity && registry.valid(ai.target)) {
-        ai.behavior = AIBehavior::Chase;
-        return;
-    }
+void EnemyAISystem::behaviorPatrolWalk(BehaviorBatch& batch) {
+    const bool sideView = m_viewMode == ViewMode::SideView;
+    const float tileSize = m_tileMap ? static_cast<float>(m_tileMap->getTileSize()) : 0.0f;
 
-    // Walk horizontally, reversing at patrol bounds or walls
-    float targetX = ai.homePosition.x + ai.patrolRadius * static_cast<float>(ai.patrolDirection);
-    float dx = targetX - transform.position.x;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EnemyAI& ai = *batch.ai[i];
+        Velocity& velocity = *batch.velocity[i];
+        const Vec2& position = batch.position[i];
 
-    if (std::abs(dx) < 8.0f) {
-        // Reached patrol endpoint, reverse
-        ai.patrolDirection = -ai.patrolDirection;
-    }
+        // If a player is detected, switch to chase
+        if (batch.hasTarget[i]) {
+            ai.behavior = BuiltinAIBehavior::Chase;
+            continue;
+        }
 
-    velocity.linear.x = ai.moveSpeed * static_cast<float>(ai.patrolDirection);
+        // Walk horizontally, reversing at patrol bounds or walls
+        float targetX = ai.homePosition.x + ai.patrolRadius * static_cast<float>(ai.patrolDirection);
+        float dx = targetX - position.x;
 
-    // Check for wall ahead using tile map
-    if (m_tileMap) {
-        float tileSize = static_cast<float>(m_tileMap->getTileSize());
-        int tileX = static_cast<int>(std::floor(
-            (transform.position.x + static_cast<float>(ai.patrolDirection) * tileSize) / tileSize));
-        int tileY = static_cast<int>(std::floor(transform.position.y / tileSize));
-        Tile ahead = m_tileMap->getTile(tileX, tileY);
-        if (ahead.isSolid()) {
+        if (std::abs(dx) < 8.0f) {
+            // Reached patrol endpoint, reverse
             ai.patrolDirection = -ai.patrolDirection;
-            velocity.linear.x = ai.moveSpeed * static_cast<float>(ai.patrolDirection);
         }
 
-        // Check for ledge (no ground ahead) — only in side-view
-        if (m_viewMode == ViewMode::SideView) {
-            Tile ground = m_tileMap->getTile(tileX, tileY + 1);
-            if (!ground.isSolid()) {
+        velocity.linear.x = ai.moveSpeed * static_cast<float>(ai.patrolDirection);
+
+        // Check for wall ahead using tile map
+        if (m_tileMap) {
+            int tileX = static_cast<int>(std::floor(
+                (position.x + static_cast<float>(ai.patrolDirection) * tileSize) / tileSize));
+            int tileY = static_cast<int>(std::floor(position.y / tileSize));
+            Tile ahead = m_tileMap->getTile(tileX, tileY);
+            if (ahead.isSolid()) {
                 ai.patrolDirection = -ai.patrolDirection;
                 velocity.linear.x = ai.moveSpeed * static_cast<float>(ai.patrolDirection);
             }
+
+            // Check for ledge (no ground ahead) — only in side-view
+            if (sideView) {
+                Tile ground = m_tileMap->getTile(tileX, tileY + 1);
+                if (!ground.isSolid()) {
+                    ai.patrolDirection = -ai.patrolDirection;
+                    velocity.linear.x = ai.moveSpeed * static_cast<float>(ai.patrolDirection);
+                }
+            }
         }
     }
 }
 
-void EnemyAISystem::behaviorPatrolFly(Entity entity, EnemyAI& ai, float dt) {
-    auto& registry = getRegistry();
-    if (!registry.has<Velocity>(entity)) return;
-    auto& velocity = registry.get<Velocity>(entity);
-    auto& transform = registry.get<Transform>(entity);
-
-    // If a player is detected, switch to chase
-    if (ai.target != NullEntity && registry.valid(ai.target)) {
-        ai.behavior = AIBehavior::Chase;
-        return;
-    }
+void EnemyAISystem::behaviorPatrolFly(BehaviorBatch& batch) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EnemyAI& ai = *batch.ai[i];
+        const float dt = batch.dt[i];
+        Velocity& velocity = *batch.velocity[i];
+        const Vec2& position = batch.position[i];
+
+        // If a player is detected, switch to chase
+        if (batch.hasTarget[i]) {
+            ai.behavior = BuiltinAIBehavior::Chase;
+            continue;
+        }
 
-    // Fly in a sine-wave pattern around home position
-    ai.patrolTimer += dt;
-    float xTarget = ai.homePosition.x + std::cos(ai.patrolTimer * 0.5f) * ai.patrolRadius;
-    float yTarget = ai.homePosition.y + std::sin(ai.patrolTimer * 1.0f) * ai.patrolRadius * 0.5f;
+        // Fly in a sine-wave pattern around home position
+        ai.patrolTimer += dt;
+        float xTarget = ai.homePosition.x + std::cos(ai.patrolTimer * 0.5f) * ai.patrolRadius;
+        float yTarget = ai.homePosition.y + std::sin(ai.patrolTimer * 1.0f) * ai.patrolRadius * 0.5f;
 
-    float dx = xTarget - transform.position.x;
-    float dy = yTarget - transform.position.y;
-    float dist = std::sqrt(dx * dx + dy * dy);
+        float dx = xTarget - position.x;
+        float dy = yTarget - position.y;
+        float dist = std::sqrt(dx * dx + dy * dy);
 
-    if (dist > 1.0f) {
-        velocity.linear.x = (dx / dist) * ai.moveSpeed;
-        velocity.linear.y = (dy / dist) * ai.moveSpeed;
-    } else {
-        velocity.linear = Vec2(0.0f, 0.0f);
+        if (dist > 1.0f) {
+            velocity.linear.x = (dx / dist) * ai.moveSpeed;
+            velocity.linear.y = (dy / dist) * ai.moveSpeed;
+        } else {
+            velocity.linear = Vec2(0.0f, 0.0f);
+        }
     }
 }
 
-void EnemyAISystem::behaviorPatrolPath(Entity entity, EnemyAI& ai, float dt) {
-    auto& registry = getRegistry();
-    if (!registry.has<Velocity>(entity)) return;
-    auto& velocity = registry.get<Velocity>(entity);
-    auto& transform = registry.get<Transform>(entity);
-
-    // If a player is detected, switch to chase
-    if (ai.target != NullEntity && registry.valid(ai.target)) {
-        ai.behavior = AIBehavior::Chase;
-        return;
-    }
+void EnemyAISystem::behaviorPatrolPath(BehaviorBatch& batch) {
+    std::uniform_real_distribution<float> timerDist(2.0f, 5.0f);
+    std::uniform_int_distribution<int> idleDist(0, 2);
 
-    // For top-down games: wander around home using simple direction changes
-    ai.patrolTimer -= dt;
-    if (ai.patrolTimer <= 0.0f) {
-        // Pick a new random direction using engine RNG
-        std::uniform_real_distribution<float> timerDist(2.0f, 5.0f);
-        ai.patrolTimer = timerDist(m_rng);
-        ai.patrolDirection = (ai.patrolDirection + 1) % 4; // Cycle 0-3
-
-        // Random chance to idle for a moment
-        std::uniform_int_distribution<int> idleDist(0, 2);
-        if (idleDist(m_rng) == 0) {
-            velocity.linear = Vec2(0.0f, 0.0f);
-            return;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EnemyAI& ai = *batch.ai[i];
+        const float dt = batch.dt[i];
+        Velocity& velocity = *batch.velocity[i];
+        const Vec2& position = batch.position[i];
+
+        // If a player is detected, switch to chase
+        if (batch.hasTarget[i]) {
+            ai.behavior = BuiltinAIBehavior::Chase;
+            continue;
         }
-    }
 
-    // Move in current direction (4-directional for top-down)
-    switch (ai.patrolDirection % 4) {
-        case 0: velocity.linear = Vec2(ai.moveSpeed, 0.0f); break;
-        case 1: velocity.linear = Vec2(0.0f, ai.moveSpeed); break;
-        case 2: velocity.linear = Vec2(-ai.moveSpeed, 0.0f); break;
-        case 3: velocity.linear = Vec2(0.0f, -ai.moveSpeed); break;
-    }
+        // For top-down games: wander around home using simple direction changes
+        ai.patrolTimer -= dt;
+        if (ai.patrolTimer <= 0.0f) {
+            // Pick a new random direction using engine RNG
+            ai.patrolTimer = timerDist(m_rng);
+            ai.patrolDirection = (ai.patrolDirection + 1) % 4; // Cycle 0-3
+
+            // Random chance to idle for a moment
+            if (idleDist(m_rng) == 0) {
+                velocity.linear = Vec2(0.0f, 0.0f);
+                continue;
+            }
+        }
+
+        // Move in current direction (4-directional for top-down)
+        switch (ai.patrolDirection % 4) {
+            case 0: velocity.linear = Vec2(ai.moveSpeed, 0.0f); break;
+            case 1: velocity.linear = Vec2(0.0f, ai.moveSpeed); break;
+            case 2: velocity.linear = Vec2(-ai.moveSpeed, 0.0f); break;
+            case 3: velocity.linear = Vec2(0.0f, -ai.moveSpeed); break;
+        }
 
-    // Enforce patrol radius from home
-    float dx = transform.position.x - ai.homePosition.x;
-    float dy = transform.position.y - ai.homePosition.y;
-    float distSq = dx * dx + dy * dy;
-    if (distSq > ai.patrolRadius * ai.patrolRadius) {
-        // Move back toward home
-        float dist = std::sqrt(distSq);
-        velocity.linear.x = -(dx / dist) * ai.moveSpeed;
-        velocity.linear.y = -(dy / dist) * ai.moveSpeed;
+        // Enforce patrol radius from home
+        float dx = position.x - ai.homePosition.x;
+        float dy = position.y - ai.homePosition.y;
+        float distSq = dx * dx + dy * dy;
+        if (distSq > ai.patrolRadius * ai.patrolRadius) {
+            // Move back toward home
+            float dist = std::sqrt(distSq);
+            velocity.linear.x = -(dx / dist) * ai.moveSpeed;
+            velocity.linear.y = -(dy / dist) * ai.moveSpeed;
+        }
     }
 }
 
-void EnemyAISystem::behaviorChase(Entity entity, EnemyAI& ai, float dt) {
-    auto& registry = getRegistry();
-    if (!registry.has<Velocity>(entity)) return;
-    auto& velocity = registry.get<Velocity>(entity);
-    auto& transform = registry.get<Transform>(entity);
-
-    // If target is invalid or out of range, return to default
-    if (ai.target == NullEntity || !registry.valid(ai.target) ||
-        !registry.has<Transform>(ai.target)) {
-        ai.behavior = ai.defaultBehavior;
-        ai.target = NullEntity;
-        velocity.linear = Vec2(0.0f, 0.0f);
-        return;
-    }
+void EnemyAISystem::behaviorChase(BehaviorBatch& batch) {
+    const bool sideView = m_viewMode == ViewMode::SideView;
 
-    auto& targetPos = registry.get<Transform>(ai.target).position;
-    float dx = targetPos.x - transform.position.x;
-    float dy = targetPos.y - transform.position.y;
-    float distSq = dx * dx + dy * dy;
-    float dist = std::sqrt(distSq);
-
-    // If target is too far, give up
-    float giveUpRange = ai.detectionRange * 1.5f;
-    if (dist > giveUpRange) {
-        ai.behavior = ai.defaultBehavior;
-        ai.target = NullEntity;
-        velocity.linear = Vec2(0.0f, 0.0f);
-        return;
-    }
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EnemyAI& ai = *batch.ai[i];
+        Velocity& velocity = *batch.velocity[i];
 
-    // Move toward target
-    if (dist > ai.attackRange) {
-        float chaseSpeed = ai.moveSpeed * 1.2f; // Chase slightly faster than patrol
-        if (m_viewMode == ViewMode::SideView) {
-            // Side-view: only horizontal chase (vertical handled by gravity/jumping)
-            velocity.linear.x = (dx > 0.0f ? 1.0f : -1.0f) * chaseSpeed;
-        } else {
-            // Top-down / flight: full 2D chase
-            velocity.linear.x = (dx / dist) * chaseSpeed;
-            velocity.linear.y = (dy / dist) * chaseSpeed;
+        // If target is invalid or out of range, return to default
+        if (!batch.hasTarget[i]) {
+            ai.behavior = ai.defaultBehavior;
+            ai.target = NullEntity;
+            velocity.linear = Vec2(0.0f, 0.0f);
+            continue;
         }
-    } else {
-        // In attack range: slow down and deal damage via contact
-        velocity.linear.x *= 0.5f;
-        if (m_viewMode != ViewMode::SideView) {
-            velocity.linear.y *= 0.5f;
+
+        float dx = batch.targetPosition[i].x - batch.position[i].x;
+        float dy = batch.targetPosition[i].y - batch.position[i].y;
+        float dist = std::sqrt(dx * dx + dy * dy);
+
+        // If target is too far, give up
+        float giveUpRange = ai.detectionRange * 1.5f;
+        if (dist > giveUpRange) {
+            ai.behavior = ai.defaultBehavior;
+            ai.target = NullEntity;
+            velocity.linear = Vec2(0.0f, 0.0f);
+            continue;
+        }
+
+        // Move toward target
+        if (dist > ai.attackRange) {
+            float chaseSpeed = ai.moveSpeed * 1.2f; // Chase slightly faster than patrol
+            if (sideView) {
+                // Side-view: only horizontal chase (vertical handled by gravity/jumping)
+                velocity.linear.x = (dx > 0.0f ? 1.0f : -1.0f) * chaseSpeed;
+            } else {
+                // Top-down / flight: full 2D chase
+                velocity.linear.x = (dx / dist) * chaseSpeed;
+                velocity.linear.y = (dy / dist) * chaseSpeed;
+            }
+        } else {
+            // In attack range: slow down and deal damage via contact
+            velocity.linear.x *= 0.5f;
+            if (!sideView) {
+                velocity.linear.y *= 0.5f;
+            }
         }
     }
 }
 
-void EnemyAISystem::behaviorFlee(Entity entity, EnemyAI& ai, float dt) {
-    auto& registry = getRegistry();
-    if (!registry.has<Velocity>(entity)) return;
-    auto& velocity = registry.get<Velocity>(entity);
-    auto& transform = registry.get<Transform>(entity);
-
-    // If health recovered or no target, return to default
-    if (registry.has<Health>(entity)) {
-        auto& health = registry.get<Health>(entity);
-        if (health.getPercentage() > ai.fleeHealthThreshold * 1.5f) {
+void EnemyAISystem::behaviorFlee(BehaviorBatch& batch) {
+    const bool sideView = m_viewMode == ViewMode::SideView;
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EnemyAI& ai = *batch.ai[i];
+        Velocity& velocity = *batch.velocity[i];
+
+        // If health recovered or no target, return to default
+        float healthPercent = batch.healthPercent[i];
+        if (healthPercent >= 0.0f && healthPercent > ai.fleeHealthThreshold * 1.5f) {
             ai.behavior = ai.defaultBehavior;
-            return;
+            continue;
         }
-    }
 
-    if (ai.target == NullEntity || !registry.valid(ai.target) ||
-        !registry.has<Transform>(ai.target)) {
-        ai.behavior = ai.defaultBehavior;
-        return;
-    }
+        if (!batch.hasTarget[i]) {
+            ai.behavior = ai.defaultBehavior;
+            continue;
+        }
 
-    auto& targetPos = registry.get<Transform>(ai.target).position;
-    float dx = transform.position.x - targetPos.x;
-    float dy = transform.position.y - targetPos.y;
-    float dist = std::sqrt(dx * dx + dy * dy);
+        float dx = batch.position[i].x - batch.targetPosition[i].x;
+        float dy = batch.position[i].y - batch.targetPosition[i].y;
+        float dist = std::sqrt(dx * dx + dy * dy);
 
-    if (dist > 0.01f) {
-        float fleeSpeed = ai.moveSpeed * 1.5f;
-        if (m_viewMode == ViewMode::SideView) {
-            velocity.linear.x = (dx > 0.0f ? 1.0f : -1.0f) * fleeSpeed;
-        } else {
-            velocity.linear.x = (dx / dist) * fleeSpeed;
-            velocity.linear.y = (dy / dist) * fleeSpeed;
+        if (dist > 0.01f) {
+            float fleeSpeed = ai.moveSpeed * 1.5f;
+            if (sideView) {
+                velocity.linear.x = (dx > 0.0f ? 1.0f : -1.0f) * fleeSpeed;
+            } else {
+                velocity.linear.x = (dx / dist) * fleeSpeed;
+                velocity.linear.y = (dy / dist) * fleeSpeed;
+            }
         }
     }
 }
 
-void EnemyAISystem::behaviorGuard(Entity entity, EnemyAI& ai, float dt) {
-    auto& registry = getRegistry();
-    if (!registry.has<Velocity>(entity)) return;
-    auto& velocity = registry.get<Velocity>(entity);
-    auto& transform = registry.get<Transform>(entity);
-
-    // If target is in detection range, chase it
-    if (ai.target != NullEntity && registry.valid(ai.target) &&
-        registry.has<Transform>(ai.target)) {
-        auto& targetPos = registry.get<Transform>(ai.target).position;
-        float dx = targetPos.x - transform.position.x;
-        float dy = targetPos.y - transform.position.y;
-        float dist = std::sqrt(dx * dx + dy * dy);
-
-        if (dist < ai.detectionRange) {
-            // Chase, but don't go too far from home
-            float homeDistX = transform.position.x - ai.homePosition.x;
-            float homeDistY = transform.position.y - ai.homePosition.y;
-            float homeDist = std::sqrt(homeDistX * homeDistX + homeDistY * homeDistY);
-
-            if (homeDist < ai.patrolRadius * 2.0f) {
-                // Chase within leash range
-                if (dist > ai.attackRange) {
-                    if (m_viewMode == ViewMode::SideView) {
-                        velocity.linear.x = (dx > 0.0f ? 1.0f : -1.0f) * ai.moveSpeed;
-                    } else {
-                        velocity.linear.x = (dx / dist) * ai.moveSpeed;
-                        velocity.linear.y = (dy / dist) * ai.moveSpeed;
+void EnemyAISystem::behaviorGuard(BehaviorBatch& batch) {
+    const bool sideView = m_viewMode == ViewMode::SideView;
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EnemyAI& ai = *batch.ai[i];
+        Velocity& velocity = *batch.velocity[i];
+        const Vec2& position = batch.position[i];
+
+        // If target is in detection range, chase it
+        if (batch.hasTarget[i]) {
+            float dx = batch.targetPosition[i].x - position.x;
+            float dy = batch.targetPosition[i].y - position.y;
+            float dist = std::sqrt(dx * dx + dy * dy);
+
+            if (dist < ai.detectionRange) {
+                // Chase, but don't go too far from home
+                float homeDistX = position.x - ai.homePosition.x;
+                float homeDistY = position.y - ai.homePosition.y;
+                float homeDist = std::sqrt(homeDistX * homeDistX + homeDistY * homeDistY);
+
+                if (homeDist < ai.patrolRadius * 2.0f) {
+                    // Chase within leash range
+                    if (dist > ai.attackRange) {
+                        if (sideView) {
+                            velocity.linear.x = (dx > 0.0f ? 1.0f : -1.0f) * ai.moveSpeed;
+                        } else {
+                            velocity.linear.x = (dx / dist) * ai.moveSpeed;
+                            velocity.linear.y = (dy / dist) * ai.moveSpeed;
+                        }
                     }
+                    continue;
                 }
-                return;
             }
         }
-    }
 
-    // Return to home position
-    float dx = ai.homePosition.x - transform.position.x;
-    float dy = ai.homePosition.y - transform.position.y;
-    float dist = std::sqrt(dx * dx + dy * dy);
+        // Return to home position
+        float dx = ai.homePosition.x - position.x;
+        float dy = ai.homePosition.y - position.y;
+        float dist = std::sqrt(dx * dx + dy * dy);
 
-    if (dist > 8.0f) {
-        if (m_viewMode == ViewMode::SideView) {
-            velocity.linear.x = (dx > 0.0f ? 1.0f : -1.0f) * ai.moveSpeed * 0.5f;
+        if (dist > 8.0f) {
+            if (sideView) {
+                velocity.linear.x = (dx > 0.0f ? 1.0f : -1.0f) * ai.moveSpeed * 0.5f;
+            } else {
+                velocity.linear.x = (dx / dist) * ai.moveSpeed * 0.5f;
+                velocity.linear.y = (dy / dist) * ai.moveSpeed * 0.5f;
+            }
         } else {
-            velocity.linear.x = (dx / dist) * ai.moveSpeed * 0.5f;
-            velocity.linear.y = (dy / dist) * ai.moveSpeed * 0.5f;
+            velocity.linear = Vec2(0.0f, 0.0f);
         }
-    } else {
-        velocity.linear = Vec2(0.0f, 0.0f);
     }
 }
 
-void EnemyAISystem::behaviorOrbit(Entity entity, EnemyAI& ai, float dt) {
-    auto& registry = getRegistry();
-    if (!registry.has<Velocity>(entity)) return;
-    auto& velocity = registry.get<Velocity>(entity);
-    auto& transform = registry.get<Transform>(entity);
-
-    Vec2 center = ai.homePosition;
+void EnemyAISystem::behaviorOrbit(BehaviorBatch& batch) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EnemyAI& ai = *batch.ai[i];
+        const float dt = batch.dt[i];
+        Velocity& velocity = *batch.velocity[i];
 
-    // If target exists, orbit around target instead of home
-    if (ai.target != NullEntity && registry.valid(ai.target) &&
-        registry.has<Transform>(ai.target)) {
-        center = registry.get<Transform>(ai.target).position;
-    }
+        // If target exists, orbit around target instead of home
+        Vec2 center = batch.hasTarget[i] ? batch.targetPosition[i] : ai.homePosition;
 
-    // Update orbit angle
-    ai.orbitAngle += ai.orbitSpeed * dt;
-    if (ai.orbitAngle > 2.0f * PI) ai.orbitAngle -= 2.0f * PI;
+        // Update orbit angle
+        ai.orbitAngle += ai.orbitSpeed * dt;
+        if (ai.orbitAngle > 2.0f * PI) ai.orbitAngle -= 2.0f * PI;
 
-    // Calculate desired position on orbit circle
-    float desiredX = center.x + std::cos(ai.orbitAngle) * ai.orbitDistance;
-    float desiredY = center.y + std::sin(ai.orbitAngle) * ai.orbitDistance;
+        // Calculate desired position on orbit circle
+        float desiredX = center.x + std::cos(ai.orbitAngle) * ai.orbitDistance;
+        float desiredY = center.y + std::sin(ai.orbitAngle) * ai.orbitDistance;
 
-    // Smoothly move toward desired position
-    float dx = desiredX - transform.position.x;
-    float dy = desiredY - transform.position.y;
-    float dist = std::sqrt(dx * dx + dy * dy);
+        // Smoothly move toward desired position
+        float dx = desiredX - batch.position[i].x;
+        float dy = desiredY - batch.position[i].y;
+        float dist = std::sqrt(dx * dx + dy * dy);
 
-    if (dist > 1.0f) {
-        float speed = std::min(ai.moveSpeed * 2.0f, dist * 5.0f);
-        velocity.linear.x = (dx / dist) * speed;
-        velocity.linear.y = (dy / dist) * speed;
+        if (dist > 1.0f) {
+            float speed = std::min(ai.moveSpeed * 2.0f, dist * 5.0f);
+            velocity.linear.x = (dx / dist) * speed;
+            velocity.linear.y = (dy / dist) * speed;
+        }
     }
 }
 
-void EnemyAISystem::behaviorStrafeRun(Entity entity, EnemyAI& ai, float dt) {
-    auto& registry = getRegistry();
-    if (!registry.has<Velocity>(entity)) return;
-    auto& velocity = registry.get<Velocity>(entity);
-    auto& transform = registry.get<Transform>(entity);
-
-    if (ai.target == NullEntity || !registry.valid(ai.target) ||
-        !registry.has<Transform>(ai.target)) {
-        // No target — fly back toward home
-        float dx = ai.homePosition.x - transform.position.x;
-        float dy = ai.homePosition.y - transform.position.y;
-        float dist = std::sqrt(dx * dx + dy * dy);
-        if (dist > 1.0f) {
-            velocity.linear.x = (dx / dist) * ai.moveSpeed;
-            velocity.linear.y = (dy / dist) * ai.moveSpeed;
+void EnemyAISystem::behaviorStrafeRun(BehaviorBatch& batch) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EnemyAI& ai = *batch.ai[i];
+        const float dt = batch.dt[i];
+        Velocity& velocity = *batch.velocity[i];
+        const Vec2& position = batch.position[i];
+
+        if (!batch.hasTarget[i]) {
+            // No target — fly back toward home
+            float dx = ai.homePosition.x - position.x;
+            float dy = ai.homePosition.y - position.y;
+            float dist = std::sqrt(dx * dx + dy * dy);
+            if (dist > 1.0f) {
+                velocity.linear.x = (dx / dist) * ai.moveSpeed;
+                velocity.linear.y = (dy / dist) * ai.moveSpeed;
+            }
+            continue;
         }
-        return;
-    }
 
-    auto& targetPos = registry.get<Transform>(ai.target).position;
-    float dx = targetPos.x - transform.position.x;
-    float dy = targetPos.y - transform.position.y;
-    float dist = std::sqrt(dx * dx + dy * dy);
+        float dx = batch.targetPosition[i].x - position.x;
+        float dy = batch.targetPosition[i].y - position.y;
+        float dist = std::sqrt(dx * dx + dy * dy);
 
-    // Strafe run: approach, then retreat after getting close
-    if (ai.patrolDirection > 0) {
-        // Approach phase
-        if (dist > ai.attackRange) {
-            velocity.linear.x = (dx / dist) * ai.moveSpeed * 1.5f;
-            velocity.linear.y = (dy / dist) * ai.moveSpeed * 1.5f;
-        } else {
-            // Close enough — switch to retreat
-            ai.patrolDirection = -1;
-            ai.patrolTimer = 3.0f; // Retreat for 3 seconds
-        }
-    } else {
-        // Retreat phase
-        ai.patrolTimer -= dt;
-        if (ai.patrolTimer <= 0.0f) {
-            ai.patrolDirection = 1; // Start approach again
+        // Strafe run: approach, then retreat after getting close
+        if (ai.patrolDirection > 0) {
+            // Approach phase
+            if (dist > ai.attackRange) {
+                velocity.linear.x = (dx / dist) * ai.moveSpeed * 1.5f;
+                velocity.linear.y = (dy / dist) * ai.moveSpeed * 1.5f;
+            } else {
+                // Close enough — switch to retreat
+                ai.patrolDirection = -1;
+                ai.patrolTimer = 3.0f; // Retreat for 3 seconds
+            }
         } else {
-            // Move away
-            if (dist > 0.01f) {
+            // Retreat phase
+            ai.patrolTimer -= dt;
+            if (ai.patrolTimer <= 0.0f) {
+                ai.patrolDirection = 1; // Start approach again
+            } else if (dist > 0.01f) {
+                // Move away
                 velocity.linear.x = -(dx / dist) * ai.moveSpeed;
                 velocity.linear.y = -(dy / dist) * ai.moveSpeed;
             }
@@ -3,10 +3,12 @@
 #include "ecs/Systems.hpp"
 #include "ecs/Components.hpp"
 #include "gameplay/EnemyAI.hpp"
+#include "gameplay/AILod.hpp"
 #include "gameplay/GameMode.hpp"
 
 #include <functional>
-#include <unordered_map>
+#include <deque>
+#include <vector>
 #include <string>
 #include <random>
 
@@ -25,14 +27,22 @@ using CustomAIBehavior = std::function<void(Entity, EnemyAI&, float)>;
 ///
 /// Built-in behaviors handle common patterns for all target game styles.
 /// Mods can register custom behaviors via enemy_ai.register_behavior() in Lua,
-/// or use "custom" + FSM for fully scripted AI.
+/// or use "custom" + FSM for fully scripted AI. A custom behavior registered
+/// under a built-in name replaces the built-in.
 ///
-/// Processing order per entity per frame:
-///   1. Despawn check (too far from player for too long)
-///   2. Contact damage check (player overlapping enemy, with cooldown)
-///   3. Target acquisition (periodic scan for nearest player)
-///   4. Behavior-specific logic (movement, attack decisions)
-///   5. Health-based transitions (flee when low HP)
+/// Each frame:
+///   1. Players are gathered once into a small array (position, bounds, health)
+///   2. The LOD scheduler decides which enemies run this frame: distant ones
+///      run every 4th/16th frame (staggered) with the accumulated dt
+///   3. Per running enemy: despawn check, contact damage, target acquisition,
+///      health-based flee transition, attack timer — all against that array
+///   4. Enemies are grouped by behavior ID into batches, and each built-in
+///      behavior runs as one tight loop over its batch's contiguous arrays
+///   5. Custom (mod) behaviors run last, one callback per enemy, grouped by
+///      behavior. They run after every built-in behavior rather than in
+///      entity order, so a custom behavior always sees this frame's built-in
+///      movement of other enemies. Behaviors registered during this pass
+///      take effect next frame.
 class EnemyAISystem : public System {
 public:
     EnemyAISystem() : System("EnemyAISystem", 12) {}
@@ -47,45 +57,82 @@ public:
     /// Check if a custom behavior is registered
     bool hasBehavior(const std::string& name) const;
 
+    /// Number of enemies the last update() ran a behavior for, by behavior ID.
+    size_t lastBatchSize(AIBehaviorId behavior) const;
+
+    /// Distance-based update-rate scheduling (see AILodScheduler).
+    void setLodConfig(const AILodConfig& config) { m_lod.setConfig(config); }
+    const AILodScheduler& getLod() const { return m_lod; }
+
 private:
-    /// Find the nearest player to an entity
-    Entity findNearestPlayer(const Vec2& position, float maxRange);
+    /// One player, gathered once per frame.
+    struct PlayerInfo {
+        Entity entity = NullEntity;
+        Vec2 position;
+        Rect bounds;
+        Health* health = nullptr;       ///< Set only when the player can take contact damage
+        Velocity* velocity = nullptr;
+    };
+
+    /// Enemies that share a behavior, stored as parallel arrays. Component
+    /// pointers stay valid for the batch pass: built-in behaviors never add
+    /// or remove components.
+    struct BehaviorBatch {
+        std::vector<Entity> entities;
+        std::vector<EnemyAI*> ai;
+        std::vector<float> dt;              ///< Step for this enemy (LOD-accumulated)
+        std::vector<Velocity*> velocity;
+        std::vector<Vec2> position;
+        std::vector<Vec2> targetPosition;
+        std::vector<uint8_t> hasTarget;     ///< Target is alive and has a Transform
+        std::vector<float> healthPercent;   ///< -1 when the enemy has no Health
+
+        size_t size() const { return entities.size(); }
+        void clear();
+    };
+
+    /// Gather players into m_players.
+    void gatherPlayers();
+
+    /// Find the nearest player to a position (within maxRange)
+    Entity findNearestPlayer(const Vec2& position, float maxRange) const;
 
     /// Apply contact damage when player overlaps enemy (respects attackCooldown)
     void checkContactDamage(Entity enemy, const Transform& enemyTransform,
-                            EnemyAI& ai);
+                            const Collider& enemyCollider, EnemyAI& ai);
 
     /// Handle despawn logic (distance from player)
-    bool checkDespawn(Entity enemy, const Transform& transform, EnemyAI& ai, float dt);
+    bool checkDespawn(const Transform& transform, EnemyAI& ai, float dt) const;
 
-    // --- Built-in behavior implementations ---
+    BehaviorBatch& batchFor(uint32_t behaviorId);
 
-    /// Idle: do nothing (for scripted or stationary enemies)
-    void behaviorIdle(Entity entity, EnemyAI& ai, float dt);
+    // --- Built-in behavior implementations (one call per batch) ---
 
     /// PatrolWalk: walk back and forth horizontally, reversing at walls/ledges
-    void behaviorPatrolWalk(Entity entity, EnemyAI& ai, float dt);
+    void behaviorPatrolWalk(BehaviorBatch& batch);
 
     /// PatrolFly: fly in a sine-wave pattern around home position
-    void behaviorPatrolFly(Entity entity, EnemyAI& ai, float dt);
+    void behaviorPatrolFly(BehaviorBatch& batch);
 
     /// PatrolPath: wander around home position with random direction changes (top-down games)
-    void behaviorPatrolPath(Entity entity, EnemyAI& ai, float dt);
+    void behaviorPatrolPath(BehaviorBatch& batch);
 
     /// Chase: move toward target entity
-    void behaviorChase(Entity entity, EnemyAI& ai, float dt);
+    void behaviorChase(BehaviorBatch& batch);
 
     /// Flee: move away from target entity
-    void behaviorFlee(Entity entity, EnemyAI& ai, float dt);
+    void behaviorFlee(BehaviorBatch& batch);
 
     /// Guard: stay near home, chase if target enters detection range
-    void behaviorGuard(Entity entity, EnemyAI& ai, float dt);
+    void behaviorGuard(BehaviorBatch& batch);
 
     /// Orbit: circle around target at fixed distance (flight games)
-    void behaviorOrbit(Entity entity, EnemyAI& ai, float dt);
+    void behaviorOrbit(BehaviorBatch& batch);
 
     /// StrafeRun: fly toward target, then retreat (flight attack runs)
-    void behaviorStrafeRun(Entity entity, EnemyAI& ai, float dt);
+    void behaviorStrafeRun(BehaviorBatch& batch);
+
+    // Idle does nothing and is never batched.
 
     // Subsystem references
     TileMap* m_tileMap = nullptr;
@@ -93,8 +140,16 @@ private:
     EnemySpawnSystem* m_enemySpawnSystem = nullptr;
     ViewMode m_viewMode = ViewMode::SideView;
 
-    // Custom behaviors registered by mods
-    std::unordered_map<std::string, CustomAIBehavior> m_customBehaviors;
+    // Custom behaviors registered by mods, indexed by behavior ID. A deque so
+    // a callback registering another behavior doesn't move the running one.
+    std::deque<CustomAIBehavior> m_customBehaviors;
+
+    AILodScheduler m_lod;
+
+    // Per-frame scratch, reused across frames
+    std::vector<PlayerInfo> m_players;
+    std::vector<BehaviorBatch> m_batches;   ///< Indexed by behavior ID
+    std::vector<Entity> m_toDespawn;
 
     // RNG for AI randomization (replaces std::rand)
     std::mt19937 m_rng{std::random_device{}()};
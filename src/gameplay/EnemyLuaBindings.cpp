@@ -122,7 +122,7 @@ void bindEnemyAPI(sol::state& lua, Engine& engine,
         auto& registry = engine.getRegistry();
         Entity entity = static_cast<Entity>(entityId);
         if (!registry.valid(entity) || !registry.has<EnemyAI>(entity)) return "";
-        return registry.get<EnemyAI>(entity).behavior;
+        return registry.get<EnemyAI>(entity).behavior.name();
     };
 
     // enemy_ai.set_detection(entityId, range)
@@ -221,14 +221,18 @@ void bindEnemyAPI(sol::state& lua, Engine& engine,
 
     // enemy_ai.register_behavior(name, callback)
     // callback = function(entityId, dt) ... end
-    aiApi["register_behavior"] = [&aiSystem](const std::string& name, sol::function callback) {
-        sol::function fn = callback;
+    aiApi["register_behavior"] = [&aiSystem, &engine](const std::string& name,
+                                                      sol::protected_function callback) {
+        sol::protected_function fn = callback;
+        LuaCpuBudget* cpu = &engine.getModLoader().getLuaBindings().getCpuBudget();
+        LuaCpuBudget::ModHandle owner = cpu->currentMod();
         aiSystem.registerBehavior(name,
-            [fn](Entity entity, EnemyAI& ai, float dt) {
-                try {
-                    fn(static_cast<uint32_t>(entity), dt);
-                } catch (const std::exception& ex) {
-                    MOD_LOG_ERROR("enemy_ai behavior '{}' error: {}", ai.behavior, ex.what());
+            [fn, cpu, owner](Entity entity, EnemyAI& ai, float dt) {
+                LuaCpuBudget::Scope scope(cpu, owner);
+                sol::protected_function_result result = fn(static_cast<uint32_t>(entity), dt);
+                if (!result.valid()) {
+                    sol::error err = result;
+                    MOD_LOG_ERROR("enemy_ai behavior '{}' error: {}", ai.behavior.name(), err.what());
                 }
             });
     };
@@ -248,7 +252,7 @@ void bindEnemyAPI(sol::state& lua, Engine& engine,
         EnemyAI ai;
         if (opts) {
             ai.behavior = opts->get_or<std::string>("behavior", "idle");
-            ai.defaultBehavior = opts->get_or<std::string>("default_behavior", ai.behavior);
+            ai.defaultBehavior = opts->get_or<std::string>("default_behavior", ai.behavior.name());
             ai.detectionRange = opts->get_or("detection_range", 200.0f);
             ai.attackRange = opts->get_or("attack_range", 32.0f);
             ai.moveSpeed = opts->get_or("move_speed", 60.0f);
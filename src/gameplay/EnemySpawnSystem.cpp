@@ -11,6 +11,17 @@
 
 namespace gloaming {
 
+namespace {
+
+// Event names and payload keys, interned once so emit sites never hash strings
+const EventId  kEnemySpawnedEvent = EventNames::intern("enemy_spawned");
+const EventKey kKeyEntity         = EventNames::intern("entity");
+const EventKey kKeyEnemyId        = EventNames::intern("enemy_id");
+const EventKey kKeyX              = EventNames::intern("x");
+const EventKey kKeyY              = EventNames::intern("y");
+
+} // namespace
+
 void EnemySpawnSystem::init(Registry& registry, Engine& engine) {
     System::init(registry, engine);
     m_contentRegistry = &engine.getContentRegistry();
@@ -42,9 +53,12 @@ int EnemySpawnSystem::getActiveEnemyCount() {
 }
 
 int EnemySpawnSystem::getEnemyCountByType(const std::string& type) {
+    uint16_t runtimeId = m_contentRegistry ? m_contentRegistry->getEnemyRuntimeId(type) : 0;
+    if (runtimeId == 0) return 0;   // Unregistered types are never spawned
+
     int count = 0;
-    getRegistry().each<EnemyTag>([&count, &type](Entity, const EnemyTag& tag) {
-        if (tag.enemyType == type) ++count;
+    getRegistry().each<EnemyTag>([&count, runtimeId](Entity, const EnemyTag& tag) {
+        if (tag.runtimeId == runtimeId) ++count;
     });
     return count;
 }
@@ -250,7 +264,7 @@ Entity EnemySpawnSystem::createEnemyEntity(const std::string& enemyId, float x,
     Entity entity = registry.create(
         Transform{Vec2(x, y)},
         Name{def->name, enemyId},
-        EnemyTag{enemyId}
+        EnemyTag{def->runtimeId}
     );
 
     // Health
@@ -316,11 +330,11 @@ Entity EnemySpawnSystem::createEnemyEntity(const std::string& enemyId, float x,
     // Emit spawn event
     if (m_eventBus) {
         EventData data;
-        data.setInt("entity", static_cast<int>(entity));
-        data.setString("enemy_id", enemyId);
-        data.setFloat("x", x);
-        data.setFloat("y", y);
-        m_eventBus->emit("enemy_spawned", data);
+        data.setInt(kKeyEntity, static_cast<int>(entity));
+        data.setString(kKeyEnemyId, enemyId);
+        data.setFloat(kKeyX, x);
+        data.setFloat(kKeyY, y);
+        m_eventBus->emit(kEnemySpawnedEvent, data);
     }
 
     return entity;
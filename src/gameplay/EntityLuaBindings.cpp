@@ -5,6 +5,7 @@
 #include "gameplay/ProjectileSystem.hpp"
 #include "gameplay/CollisionLayers.hpp"
 #include "gameplay/SpriteAnimation.hpp"
+#include "gameplay/LuaComponentViews.hpp"
 
 #include <cmath>
 
@@ -96,20 +97,21 @@ void bindEntityAPI(sol::state& lua, Engine& engine,
             return;
         }
 
-        const Texture* texture = engine.getTextureManager().loadTexture(texturePath);
-        if (!texture) {
+        TextureRegion region;
+        if (!engine.getTextureManager().resolveRegion(texturePath, region)) {
             MOD_LOG_WARN("entity.set_sprite: failed to load texture '{}'", texturePath);
             return;
         }
 
         if (registry.has<Sprite>(entity)) {
             auto& sprite = registry.get<Sprite>(entity);
-            sprite.texture = texture;
-            sprite.sourceRect = Rect(0, 0,
-                static_cast<float>(texture->getWidth()),
-                static_cast<float>(texture->getHeight()));
+            sprite.texture = region.texture;
+            sprite.sourceRect = region.bounds;
+            sprite.sheetRect = region.bounds;
         } else {
-            registry.add<Sprite>(entity, texture);
+            Sprite sprite(region.texture, region.bounds);
+            sprite.sheetRect = region.bounds;
+            registry.add<Sprite>(entity, std::move(sprite));
         }
     };
 
@@ -208,6 +210,7 @@ void bindEntityAPI(sol::state& lua, Engine& engine,
                 tr.position = Vec2(x, y);
                 tr.rotation = rotation;
                 tr.scale = Vec2(scaleX, scaleY);
+                registry.touch(entity);
             } else {
                 registry.add<Transform>(entity, Vec2(x, y), rotation, Vec2(scaleX, scaleY));
             }
@@ -372,6 +375,10 @@ void bindEntityAPI(sol::state& lua, Engine& engine,
         else MOD_LOG_WARN("entity.remove_component: unknown component '{}'", name);
     };
 
+    // entity.ref(entityId, name) / entity.each({ names... }, fn) — live
+    // component views for scripts touching many entities per tick
+    bindComponentViews(lua, entityApi, engine.getRegistry());
+
     // entity.find_in_radius(x, y, radius [, filter]) -> table of results
     entityApi["find_in_radius"] = [&engine, &spawning, &collisionLayers](
             float x, float y, float radius,
@@ -463,9 +470,11 @@ void bindEntityAPI(sol::state& lua, Engine& engine,
         // Sprite
         sol::optional<std::string> spritePath = opts.get<sol::optional<std::string>>("sprite");
         if (spritePath && !spritePath->empty()) {
-            const Texture* tex = engine.getTextureManager().loadTexture(*spritePath);
-            if (tex) {
-                registry.add<Sprite>(entity, tex);
+            TextureRegion region;
+            if (engine.getTextureManager().resolveRegion(*spritePath, region)) {
+                Sprite sprite(region.texture, region.bounds);
+                sprite.sheetRect = region.bounds;
+                registry.add<Sprite>(entity, std::move(sprite));
             }
         }
 
@@ -515,17 +524,14 @@ void bindEntityAPI(sol::state& lua, Engine& engine,
         }
 
         // On-hit callback
-        sol::optional<sol::function> onHit = opts.get<sol::optional<sol::function>>("on_hit");
+        sol::optional<sol::protected_function> onHit =
+            opts.get<sol::optional<sol::protected_function>>("on_hit");
         if (onHit) {
-            sol::function fn = *onHit;
+            auto fn = engine.getModLoader().getLuaBindings().modCallback<uint32_t, uint32_t>(
+                *onHit, "projectile on_hit callback");
             projectileSystem.getCallbacks().registerOnHit(entity,
                 [fn](const ProjectileHitInfo& info) {
-                    try {
-                        fn(static_cast<uint32_t>(info.projectile),
-                           static_cast<uint32_t>(info.target));
-                    } catch (const std::exception& ex) {
-                        MOD_LOG_ERROR("projectile on_hit callback error: {}", ex.what());
-                    }
+                    fn(static_cast<uint32_t>(info.projectile), static_cast<uint32_t>(info.target));
                 });
         }
 
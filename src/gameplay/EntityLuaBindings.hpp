@@ -19,6 +19,7 @@ class CollisionLayerRegistry;
 ///   - entity.set_position(), entity.get_position()
 ///   - entity.set_velocity(), entity.get_velocity()
 ///   - entity.set_component(), entity.get_component()
+///   - entity.ref(), entity.each() (zero-copy component views)
 ///   - entity.find_in_radius(), entity.count()
 ///   - projectile.spawn()
 void bindEntityAPI(sol::state& lua, Engine& engine,
@@ -4,6 +4,60 @@
 
 namespace gloaming {
 
+namespace {
+
+/// Translate a query filter to index terms; false if the index can't answer
+/// it (a type it hasn't interned, e.g. one set in place since the sync)
+bool toSpatialFilter(const SpatialIndex& index, const EntityQueryFilter& filter, SpatialFilter& out) {
+    out.layerMask = filter.requiredLayer;
+    out.typeId = 0;
+    if (!filter.type.empty()) {
+        out.typeId = index.typeId(filter.type);
+        if (out.typeId == 0) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+const SpatialIndex* EntitySpawning::currentIndex() const {
+    if (!m_spatialIndex) return nullptr;
+    if (!m_spatialIndex->isCurrent(*m_registry)) m_spatialIndex->update(*m_registry);
+    return m_spatialIndex;
+}
+
+bool EntitySpawning::acceptCandidate(Entity entity, float cx, float cy, float radiusSq,
+                                     const EntityQueryFilter& filter, EntityQueryResult& out) const {
+    // The index may list entities destroyed or changed since it was built:
+    // re-check everything against live components
+    if (!m_registry->valid(entity)) return false;
+    const Transform* transform = m_registry->tryGet<Transform>(entity);
+    if (!transform) return false;
+
+    if (!filter.type.empty()) {
+        const Name* name = m_registry->tryGet<Name>(entity);
+        if (!name || name->type != filter.type) return false;
+    }
+    if (filter.requiredLayer != 0) {
+        const Collider* collider = m_registry->tryGet<Collider>(entity);
+        if (!collider || (collider->layer & filter.requiredLayer) == 0) return false;
+    }
+    if (filter.excludeDead) {
+        const Health* health = m_registry->tryGet<Health>(entity);
+        if (health && health->isDead()) return false;
+    }
+
+    float dx = transform->position.x - cx;
+    float dy = transform->position.y - cy;
+    float distSq = dx * dx + dy * dy;
+    if (distSq > radiusSq) return false;
+
+    out.entity = entity;
+    out.distance = std::sqrt(distSq);
+    out.position = transform->position;
+    return true;
+}
+
 std::vector<EntityQueryResult> EntitySpawning::findInRadius(
         float cx, float cy, float radius,
         const EntityQueryFilter& filter) const {
@@ -13,6 +67,26 @@ std::vector<EntityQueryResult> EntitySpawning::findInRadius(
     float radiusSq = radius * radius;
     std::vector<EntityQueryResult> results;
 
+    const SpatialIndex* index = currentIndex();
+    SpatialFilter spatialFilter;
+    if (index && toSpatialFilter(*index, filter, spatialFilter)) {
+        std::vector<Entity> candidates;
+        index->queryRadius(Vec2(cx, cy), radius, spatialFilter, candidates);
+        results.reserve(candidates.size());
+        for (Entity entity : candidates) {
+            EntityQueryResult result;
+            if (acceptCandidate(entity, cx, cy, radiusSq, filter, result)) {
+                results.push_back(result);
+            }
+        }
+
+        std::sort(results.begin(), results.end(),
+            [](const EntityQueryResult& a, const EntityQueryResult& b) {
+                return a.distance < b.distance;
+            });
+        return results;
+    }
+
     m_registry->each<Transform>([&](Entity entity, const Transform& transform) {
         // Type filter
         if (!filter.type.empty()) {
@@ -63,6 +137,25 @@ EntityQueryResult EntitySpawning::findNearest(
     float bestDistSq = maxRadiusSq + 1.0f;
     EntityQueryResult best;
 
+    const SpatialIndex* index = currentIndex();
+    SpatialFilter spatialFilter;
+    if (index && toSpatialFilter(*index, filter, spatialFilter)) {
+        // Widen k until a candidate survives the live checks (dead or
+        // destroyed entities near the point are skipped that way)
+        std::vector<Entity> candidates;
+        for (size_t k = 1;; k *= 4) {
+            index->queryNearest(Vec2(cx, cy), k, maxRadius, spatialFilter, candidates);
+            for (Entity entity : candidates) {
+                EntityQueryResult result;
+                if (acceptCandidate(entity, cx, cy, maxRadiusSq, filter, result) &&
+                    (best.entity == NullEntity || result.distance < best.distance)) {
+                    best = result;
+                }
+            }
+            if (best.entity != NullEntity || candidates.size() < k) return best;
+        }
+    }
+
     m_registry->each<Transform>([&](Entity entity, const Transform& transform) {
         if (!filter.type.empty()) {
             if (!m_registry->has<Name>(entity)) return;
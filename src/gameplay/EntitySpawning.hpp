@@ -3,6 +3,7 @@
 #include "ecs/Registry.hpp"
 #include "ecs/Components.hpp"
 #include "ecs/EntityFactory.hpp"
+#include "physics/SpatialIndex.hpp"
 
 #include <vector>
 #include <string>
@@ -27,12 +28,20 @@ struct EntityQueryResult {
 /// Utility class for entity spatial queries and helper operations.
 /// Wraps the Registry and EntityFactory to provide a convenient API
 /// for Lua bindings.
+///
+/// With a SpatialIndex attached, radius and nearest queries take candidates
+/// from the index and check them against live components; otherwise they
+/// scan every Transform entity. The index is resynced first whenever the
+/// registry changed since its last sync (Registry::version()), so entities
+/// moved, spawned or retyped earlier in the tick are never missed. Type
+/// filters naming a type the index hasn't seen scan too.
 class EntitySpawning {
 public:
     EntitySpawning() = default;
 
     void setRegistry(Registry* registry) { m_registry = registry; }
     void setEntityFactory(EntityFactory* factory) { m_factory = factory; }
+    void setSpatialIndex(SpatialIndex* index) { m_spatialIndex = index; }
 
     /// Create a blank entity with just a Transform and Name
     Entity create(float x, float y) {
@@ -72,6 +81,7 @@ public:
             m_registry->add<Transform>(entity, Vec2(x, y));
         } else {
             m_registry->get<Transform>(entity).position = Vec2(x, y);
+            m_registry->touch(entity);
         }
     }
 
@@ -99,7 +109,7 @@ public:
         return m_registry->get<Velocity>(entity).linear;
     }
 
-    /// Find all entities within a radius of a point (O(N) brute force scan)
+    /// Find all entities within a radius of a point, nearest first
     std::vector<EntityQueryResult> findInRadius(
             float cx, float cy, float radius,
             const EntityQueryFilter& filter = EntityQueryFilter{}) const;
@@ -113,8 +123,17 @@ public:
     size_t countByType(const std::string& type) const;
 
 private:
+    /// The attached index, brought up to date with the registry; nullptr
+    /// when there is none
+    const SpatialIndex* currentIndex() const;
+
+    /// Check an index candidate against its live components; fills `out` on a match
+    bool acceptCandidate(Entity entity, float cx, float cy, float radiusSq,
+                         const EntityQueryFilter& filter, EntityQueryResult& out) const;
+
     Registry* m_registry = nullptr;
     EntityFactory* m_factory = nullptr;
+    SpatialIndex* m_spatialIndex = nullptr;
 };
 
 } // namespace gloaming
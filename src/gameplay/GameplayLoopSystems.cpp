@@ -8,6 +8,32 @@
 
 namespace gloaming {
 
+namespace {
+
+// Event names and payload keys, interned once so emit sites never hash strings
+const EventId  kItemPickupEvent    = EventNames::intern("item_pickup");
+const EventId  kTileBrokenEvent    = EventNames::intern("tile_broken");
+const EventId  kMeleeHitEvent      = EventNames::intern("melee_hit");
+const EventId  kPlayerDeathEvent   = EventNames::intern("player_death");
+const EventId  kPlayerRespawnEvent = EventNames::intern("player_respawn");
+const EventKey kKeyItem            = EventNames::intern("item");
+const EventKey kKeyCount           = EventNames::intern("count");
+const EventKey kKeyPlayer          = EventNames::intern("player");
+const EventKey kKeyTileX           = EventNames::intern("tile_x");
+const EventKey kKeyTileY           = EventNames::intern("tile_y");
+const EventKey kKeyTileId          = EventNames::intern("tile_id");
+const EventKey kKeyEntity          = EventNames::intern("entity");
+const EventKey kKeyTileType        = EventNames::intern("tile_type");
+const EventKey kKeyDropItem        = EventNames::intern("drop_item");
+const EventKey kKeyDropCount       = EventNames::intern("drop_count");
+const EventKey kKeyAttacker        = EventNames::intern("attacker");
+const EventKey kKeyTarget          = EventNames::intern("target");
+const EventKey kKeyDamage          = EventNames::intern("damage");
+const EventKey kKeyX               = EventNames::intern("x");
+const EventKey kKeyY               = EventNames::intern("y");
+
+} // namespace
+
 // ============================================================================
 // ItemDropSystem
 // ============================================================================
@@ -70,10 +96,10 @@ void ItemDropSystem::update(float dt) {
                 if (leftover < drop.count) {
                     // At least some items were picked up
                     EventData data;
-                    data.setString("item", drop.itemId);
-                    data.setInt("count", drop.count - leftover);
-                    data.setInt("player", static_cast<int>(player.entity));
-                    m_eventBus->emit("item_pickup", data);
+                    data.setString(kKeyItem, drop.itemId);
+                    data.setInt(kKeyCount, drop.count - leftover);
+                    data.setInt(kKeyPlayer, static_cast<int>(player.entity));
+                    m_eventBus->emit(kItemPickupEvent, data);
 
                     if (leftover <= 0) {
                         toDestroy.push_back(dropEntity);
@@ -136,16 +162,16 @@ void ToolUseSystem::update(float dt) {
 
                 // Emit event
                 EventData data;
-                data.setInt("tile_x", tool.targetTileX);
-                data.setInt("tile_y", tool.targetTileY);
-                data.setInt("tile_id", tile.id);
-                data.setInt("entity", static_cast<int>(entity));
+                data.setInt(kKeyTileX, tool.targetTileX);
+                data.setInt(kKeyTileY, tool.targetTileY);
+                data.setInt(kKeyTileId, tile.id);
+                data.setInt(kKeyEntity, static_cast<int>(entity));
                 if (tileDef) {
-                    data.setString("tile_type", tileDef->qualifiedId);
-                    data.setString("drop_item", tileDef->dropItem);
-                    data.setInt("drop_count", tileDef->dropCount);
+                    data.setString(kKeyTileType, tileDef->qualifiedId);
+                    data.setString(kKeyDropItem, tileDef->dropItem);
+                    data.setInt(kKeyDropCount, tileDef->dropCount);
                 }
-                m_eventBus->emit("tile_broken", data);
+                m_eventBus->emit(kTileBrokenEvent, data);
             }
 
             tool.reset();
@@ -228,10 +254,10 @@ void MeleeAttackSystem::update(float dt) {
                 }
 
                 EventData data;
-                data.setInt("attacker", static_cast<int>(swing.attacker));
-                data.setInt("target", static_cast<int>(target));
-                data.setFloat("damage", dealt);
-                m_eventBus->emit("melee_hit", data);
+                data.setInt(kKeyAttacker, static_cast<int>(swing.attacker));
+                data.setInt(kKeyTarget, static_cast<int>(target));
+                data.setFloat(kKeyDamage, dealt);
+                m_eventBus->emit(kMeleeHitEvent, data);
             }
         });
     }
@@ -264,8 +290,8 @@ void CombatSystem::update(float dt) {
             combat.die();
 
             EventData data;
-            data.setInt("entity", static_cast<int>(entity));
-            m_eventBus->emit("player_death", data);
+            data.setInt(kKeyEntity, static_cast<int>(entity));
+            m_eventBus->emit(kPlayerDeathEvent, data);
         }
 
         // Handle respawn timer
@@ -274,10 +300,10 @@ void CombatSystem::update(float dt) {
                 performRespawn(combat, health, transform, registry, entity);
 
                 EventData data;
-                data.setInt("entity", static_cast<int>(entity));
-                data.setFloat("x", combat.spawnPoint.x);
-                data.setFloat("y", combat.spawnPoint.y);
-                m_eventBus->emit("player_respawn", data);
+                data.setInt(kKeyEntity, static_cast<int>(entity));
+                data.setFloat(kKeyX, combat.spawnPoint.x);
+                data.setFloat(kKeyY, combat.spawnPoint.y);
+                m_eventBus->emit(kPlayerRespawnEvent, data);
             }
         }
     });
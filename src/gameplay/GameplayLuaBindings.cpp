@@ -7,6 +7,8 @@
 #include "engine/Haptics.hpp"
 #include "gameplay/Gameplay.hpp"
 
+#include <algorithm>
+
 namespace gloaming {
 
 /// Helper: convert a Lua string to FacingDirection
@@ -56,6 +58,27 @@ static Key parseKey(const std::string& name) {
     return Key::Space;
 }
 
+/// Helper: wrap Lua on_enter/on_update/on_exit functions as StateCallbacks,
+/// charging their CPU time to the mod defining them
+static StateCallbacks makeStateCallbacks(const sol::table& callbacks, LuaBindings& bindings) {
+    using OptionalFn = sol::optional<sol::protected_function>;
+    StateCallbacks cbs;
+
+    if (OptionalFn onEnter = callbacks.get<OptionalFn>("on_enter")) {
+        auto fn = bindings.modCallback<uint32_t>(*onEnter, "FSM onEnter");
+        cbs.onEnter = [fn](Entity e) { fn(static_cast<uint32_t>(e)); };
+    }
+    if (OptionalFn onUpdate = callbacks.get<OptionalFn>("on_update")) {
+        auto fn = bindings.modCallback<uint32_t, float>(*onUpdate, "FSM onUpdate");
+        cbs.onUpdate = [fn](Entity e, float dt) { fn(static_cast<uint32_t>(e), dt); };
+    }
+    if (OptionalFn onExit = callbacks.get<OptionalFn>("on_exit")) {
+        auto fn = bindings.modCallback<uint32_t>(*onExit, "FSM onExit");
+        cbs.onExit = [fn](Entity e) { fn(static_cast<uint32_t>(e)); };
+    }
+    return cbs;
+}
+
 /// Helper: convert a Lua gamepad button name to GamepadButton enum
 static GamepadButton parseGamepadButton(const std::string& name) {
     if (name == "a" || name == "face_down")    return GamepadButton::FaceDown;
@@ -270,6 +293,7 @@ void bindGameplayAPI(sol::state& lua, Engine& engine,
         auto& transform = registry.get<Transform>(entity);
         auto& grid = registry.get<GridMovement>(entity);
         transform.position = grid.snapToGrid(transform.position);
+        registry.touch(entity);
     };
 
     // =========================================================================
@@ -425,54 +449,184 @@ void bindGameplayAPI(sol::state& lua, Engine& engine,
 
         StateCallbacks cbs;
         if (callbacks) {
-            sol::optional<sol::function> onEnter = callbacks->get<sol::optional<sol::function>>("on_enter");
-            sol::optional<sol::function> onUpdate = callbacks->get<sol::optional<sol::function>>("on_update");
-            sol::optional<sol::function> onExit = callbacks->get<sol::optional<sol::function>>("on_exit");
-
-            if (onEnter) {
-                sol::function fn = *onEnter;
-                cbs.onEnter = [fn](Entity e) {
-                    try { fn(static_cast<uint32_t>(e)); }
-                    catch (const std::exception& ex) { MOD_LOG_ERROR("FSM onEnter error: {}", ex.what()); }
+            cbs = makeStateCallbacks(*callbacks, engine.getModLoader().getLuaBindings());
+        }
+        registry.get<StateMachine>(entity).addState(name, std::move(cbs));
+    };
+
+    // fsm.define(name, {
+    //     initial = "idle",
+    //     states = { idle = { on_enter=, on_update=, on_update_batch=, on_exit= }, ... },
+    //     transitions = { { from = "idle", to = "chase", when = function(id, time) ... end }, ... },
+    // })
+    // Registers a shared definition once; entities join it with fsm.attach.
+    // New states are added in name order; without `initial`, the first name starts.
+    // Redefining a name keeps its state IDs, so attached entities survive reloads.
+    // From inside an FSM callback, the redefinition applies once the update returns.
+    fsmApi["define"] = [&engine](const std::string& name, sol::table spec) -> bool {
+        auto* fsmSystem = engine.getStateMachineSystem();
+        if (!fsmSystem) return false;
+
+        // Read and validate the whole spec before touching the definition,
+        // so a bad redefinition leaves the old one intact
+        sol::optional<sol::table> states = spec.get<sol::optional<sol::table>>("states");
+        if (!states) {
+            MOD_LOG_ERROR("fsm.define('{}'): missing 'states' table", name);
+            return false;
+        }
+
+        LuaBindings& bindings = engine.getModLoader().getLuaBindings();
+        LuaCpuBudget* cpu = &bindings.getCpuBudget();
+        LuaCpuBudget::ModHandle owner = cpu->currentMod();
+
+        struct StateSpec {
+            std::string name;
+            StateCallbacks callbacks;
+            FSMBatchUpdate batch;
+        };
+        struct TransitionSpec {
+            std::string from;
+            std::string to;
+            FSMCondition condition;
+        };
+        std::vector<StateSpec> stateSpecs;
+        std::vector<TransitionSpec> transitionSpecs;
+
+        states->for_each([&](const sol::object& key, const sol::object& value) {
+            if (!key.is<std::string>() || !value.is<sol::table>()) return;
+            sol::table stateSpec = value.as<sol::table>();
+            StateCallbacks cbs = makeStateCallbacks(stateSpec, bindings);
+
+            FSMBatchUpdate batch;
+            sol::optional<sol::protected_function> onBatch =
+                stateSpec.get<sol::optional<sol::protected_function>>("on_update_batch");
+            if (onBatch) {
+                sol::protected_function fn = *onBatch;
+                batch = [fn, cpu, owner](std::span<const Entity> entities, float dt) {
+                    LuaCpuBudget::Scope scope(cpu, owner);
+                    sol::state_view lua(fn.lua_state());
+                    sol::table ids = lua.create_table(static_cast<int>(entities.size()), 0);
+                    for (size_t i = 0; i < entities.size(); ++i) {
+                        ids[i + 1] = static_cast<uint32_t>(entities[i]);
+                    }
+                    sol::protected_function_result result = fn(ids, dt);
+                    if (!result.valid()) {
+                        sol::error err = result;
+                        MOD_LOG_ERROR("FSM onUpdateBatch error: {}", err.what());
+                    }
                 };
             }
-            if (onUpdate) {
-                sol::function fn = *onUpdate;
-                cbs.onUpdate = [fn](Entity e, float dt) {
-                    try { fn(static_cast<uint32_t>(e), dt); }
-                    catch (const std::exception& ex) { MOD_LOG_ERROR("FSM onUpdate error: {}", ex.what()); }
-                };
+            stateSpecs.push_back({key.as<std::string>(), std::move(cbs), std::move(batch)});
+        });
+        // for_each follows Lua's hash order; sort so state IDs (and the
+        // default initial state) are the same on every run
+        std::sort(stateSpecs.begin(), stateSpecs.end(),
+                  [](const StateSpec& a, const StateSpec& b) { return a.name < b.name; });
+
+        sol::optional<sol::table> transitions = spec.get<sol::optional<sol::table>>("transitions");
+        if (transitions) {
+            transitions->for_each([&](const sol::object&, const sol::object& value) {
+                if (!value.is<sol::table>()) return;
+                sol::table t = value.as<sol::table>();
+
+                FSMCondition condition;
+                sol::optional<sol::protected_function> when =
+                    t.get<sol::optional<sol::protected_function>>("when");
+                if (when) {
+                    sol::protected_function fn = *when;
+                    condition = [fn, cpu, owner](Entity e, float time) -> bool {
+                        LuaCpuBudget::Scope scope(cpu, owner);
+                        sol::protected_function_result result = fn(static_cast<uint32_t>(e), time);
+                        if (!result.valid()) {
+                            sol::error err = result;
+                            MOD_LOG_ERROR("FSM transition condition error: {}", err.what());
+                            return false;
+                        }
+                        return result.get_type() == sol::type::boolean && result.get<bool>();
+                    };
+                }
+                transitionSpecs.push_back({t.get_or("from", std::string()),
+                                           t.get_or("to", std::string()), std::move(condition)});
+            });
+        }
+
+        sol::optional<std::string> initial = spec.get<sol::optional<std::string>>("initial");
+
+        // Applied after the current dispatch when called from an FSM callback
+        fsmSystem->redefine(name, [name, stateSpecs = std::move(stateSpecs),
+                                   transitionSpecs = std::move(transitionSpecs),
+                                   initial](FSMDefinition& def) {
+            def.clearTransitions();
+            for (const auto& state : stateSpecs) {
+                def.addState(state.name, state.callbacks, state.batch);
             }
-            if (onExit) {
-                sol::function fn = *onExit;
-                cbs.onExit = [fn](Entity e) {
-                    try { fn(static_cast<uint32_t>(e)); }
-                    catch (const std::exception& ex) { MOD_LOG_ERROR("FSM onExit error: {}", ex.what()); }
-                };
+            for (const auto& t : transitionSpecs) {
+                if (!def.addTransition(t.from, t.to, t.condition)) {
+                    MOD_LOG_WARN("fsm.define('{}'): unknown state in transition {} -> {}",
+                                 name, t.from, t.to);
+                }
             }
+            if (initial) def.setInitialState(def.findState(*initial));
+        });
+        return true;
+    };
+
+    // fsm.attach(id, definition_name, initial_state?) — give an entity a shared FSM
+    fsmApi["attach"] = [&engine](uint32_t entityId, const std::string& definition,
+                                 sol::optional<std::string> initial) -> bool {
+        auto& registry = engine.getRegistry();
+        auto* fsmSystem = engine.getStateMachineSystem();
+        Entity entity = static_cast<Entity>(entityId);
+        if (!fsmSystem || !registry.valid(entity)) return false;
+
+        FSMDefinitionId defId = fsmSystem->findDefinition(definition);
+        const FSMDefinition* def = fsmSystem->getDefinition(defId);
+        if (!def) {
+            MOD_LOG_WARN("fsm.attach: unknown definition '{}'", definition);
+            return false;
         }
 
-        registry.get<StateMachine>(entity).addState(name, std::move(cbs));
+        FSMStateId initialState = initial ? def->findState(*initial) : kNoFSMState;
+        FSMInstance& fsm = registry.has<FSMInstance>(entity)
+            ? registry.get<FSMInstance>(entity)
+            : registry.add<FSMInstance>(entity);
+        return fsmSystem->start(fsm, entity, defId, initialState);
     };
 
+    // set_state/get_state/get_state_time work for both per-entity (fsm.add)
+    // and shared (fsm.attach) machines
     fsmApi["set_state"] = [&engine](uint32_t entityId, const std::string& state) {
         auto& registry = engine.getRegistry();
         Entity entity = static_cast<Entity>(entityId);
-        if (!registry.valid(entity) || !registry.has<StateMachine>(entity)) return;
+        if (!registry.valid(entity)) return;
+        if (auto* shared = registry.tryGet<FSMInstance>(entity)) {
+            if (auto* fsmSystem = engine.getStateMachineSystem()) {
+                fsmSystem->setState(*shared, entity, state);
+            }
+            return;
+        }
+        if (!registry.has<StateMachine>(entity)) return;
         StateMachineSystem::setState(registry.get<StateMachine>(entity), entity, state);
     };
 
     fsmApi["get_state"] = [&engine](uint32_t entityId) -> std::string {
         auto& registry = engine.getRegistry();
         Entity entity = static_cast<Entity>(entityId);
-        if (!registry.valid(entity) || !registry.has<StateMachine>(entity)) return "";
+        if (!registry.valid(entity)) return "";
+        if (auto* shared = registry.tryGet<FSMInstance>(entity)) {
+            auto* fsmSystem = engine.getStateMachineSystem();
+            return fsmSystem ? fsmSystem->getStateName(*shared) : "";
+        }
+        if (!registry.has<StateMachine>(entity)) return "";
         return registry.get<StateMachine>(entity).getCurrentState();
     };
 
     fsmApi["get_state_time"] = [&engine](uint32_t entityId) -> float {
         auto& registry = engine.getRegistry();
         Entity entity = static_cast<Entity>(entityId);
-        if (!registry.valid(entity) || !registry.has<StateMachine>(entity)) return 0.0f;
+        if (!registry.valid(entity)) return 0.0f;
+        if (auto* shared = registry.tryGet<FSMInstance>(entity)) return shared->timeInState;
+        if (!registry.has<StateMachine>(entity)) return 0.0f;
         return registry.get<StateMachine>(entity).getStateTime();
     };
 
@@ -505,30 +659,22 @@ void bindGameplayAPI(sol::state& lua, Engine& engine,
                     choice.text = c.get_or<std::string>("text", "");
                     choice.nextNodeId = c.get_or<std::string>("next", "");
 
-                    sol::optional<sol::function> onSelect = c.get<sol::optional<sol::function>>("on_select");
+                    sol::optional<sol::protected_function> onSelect =
+                        c.get<sol::optional<sol::protected_function>>("on_select");
                     if (onSelect) {
-                        sol::function fn = *onSelect;
-                        choice.onSelect = [fn]() {
-                            try { fn(); }
-                            catch (const std::exception& ex) {
-                                MOD_LOG_ERROR("Dialogue choice callback error: {}", ex.what());
-                            }
-                        };
+                        choice.onSelect = engine.getModLoader().getLuaBindings().modCallback(
+                            *onSelect, "Dialogue choice callback");
                     }
                     node.choices.push_back(std::move(choice));
                 }
             }
 
             // Parse onShow callback
-            sol::optional<sol::function> onShow = n.get<sol::optional<sol::function>>("on_show");
+            sol::optional<sol::protected_function> onShow =
+                n.get<sol::optional<sol::protected_function>>("on_show");
             if (onShow) {
-                sol::function fn = *onShow;
-                node.onShow = [fn]() {
-                    try { fn(); }
-                    catch (const std::exception& ex) {
-                        MOD_LOG_ERROR("Dialogue onShow error: {}", ex.what());
-                    }
-                };
+                node.onShow = engine.getModLoader().getLuaBindings().modCallback(
+                    *onShow, "Dialogue onShow");
             }
 
             nodeList.push_back(std::move(node));
@@ -553,13 +699,9 @@ void bindGameplayAPI(sol::state& lua, Engine& engine,
         dialogue.getConfig().typewriterSpeed = charsPerSec;
     };
 
-    dialogueApi["on_end"] = [&dialogue](sol::function callback) {
-        dialogue.setOnDialogueEnd([callback]() {
-            try { callback(); }
-            catch (const std::exception& ex) {
-                MOD_LOG_ERROR("Dialogue on_end error: {}", ex.what());
-            }
-        });
+    dialogueApi["on_end"] = [&dialogue, &engine](sol::protected_function callback) {
+        dialogue.setOnDialogueEnd(engine.getModLoader().getLuaBindings().modCallback(
+            std::move(callback), "Dialogue on_end"));
     };
 
     // =========================================================================
@@ -630,29 +772,23 @@ void bindGameplayAPI(sol::state& lua, Engine& engine,
         int frameWidth = opts.get_or("frame_width", 0);
         int frameHeight = opts.get_or("frame_height", 0);
 
-        // If frame dimensions are not specified, try to derive from the Sprite's texture.
-        // Heuristic: width = textureWidth / frameCount, height = frameWidth (assumes
-        // square frames).  This works well for common sprite sheets where each frame is
-        // a square tile.  For non-square frames, callers should provide explicit
-        // frame_width / frame_height values.
-        if ((frameWidth <= 0 || frameHeight <= 0) && registry.has<Sprite>(entity)) {
-            auto& sprite = registry.get<Sprite>(entity);
-            if (sprite.texture && sprite.texture->isValid()) {
-                if (frameWidth <= 0 && frameCount > 0) {
-                    frameWidth = sprite.texture->getWidth() / frameCount;
-                }
-                if (frameHeight <= 0) {
-                    frameHeight = frameWidth > 0 ? frameWidth : sprite.texture->getHeight();
-                }
-            }
+        // Frames are laid out within the Sprite's sheet, which for packed
+        // textures is a region of a shared atlas page. Missing frame sizes
+        // are derived from the sheet (square frames); for non-square frames,
+        // callers should provide explicit frame_width / frame_height values.
+        bool added = false;
+        const Sprite* sprite = registry.has<Sprite>(entity) ? &registry.get<Sprite>(entity) : nullptr;
+        if (sprite && sprite->texture && sprite->texture->isValid()) {
+            added = ctrl.addClipFromSprite(clipName, *sprite, row, frameCount,
+                                           frameWidth, frameHeight, fps, mode);
+        } else if (frameWidth > 0 && frameHeight > 0) {
+            ctrl.addClipFromSheet(clipName, row, frameCount, frameWidth, frameHeight, fps, mode);
+            added = true;
         }
 
-        if (frameWidth <= 0 || frameHeight <= 0) {
+        if (!added) {
             MOD_LOG_WARN("animation.add: cannot determine frame dimensions for clip '{}'", clipName);
-            return;
         }
-
-        ctrl.addClipFromSheet(clipName, row, frameCount, frameWidth, frameHeight, fps, mode);
     };
 
     // animation.play(entityId, clipName)
@@ -701,7 +837,7 @@ void bindGameplayAPI(sol::state& lua, Engine& engine,
 
     // animation.on_frame(entityId, clipName, frameIndex, callback)
     animApi["on_frame"] = [&engine](uint32_t entityId, const std::string& clipName,
-                                     int frameIndex, sol::function callback) {
+                                     int frameIndex, sol::protected_function callback) {
         auto& registry = engine.getRegistry();
         Entity entity = static_cast<Entity>(entityId);
         if (!registry.valid(entity) || !registry.has<AnimationController>(entity)) {
@@ -709,15 +845,11 @@ void bindGameplayAPI(sol::state& lua, Engine& engine,
             return;
         }
 
-        sol::function fn = callback;
+        auto fn = engine.getModLoader().getLuaBindings().modCallback<uint32_t>(
+            std::move(callback), "animation.on_frame callback");
         registry.get<AnimationController>(entity).addFrameEvent(
             clipName, frameIndex,
-            [fn](Entity e) {
-                try { fn(static_cast<uint32_t>(e)); }
-                catch (const std::exception& ex) {
-                    MOD_LOG_ERROR("animation.on_frame callback error: {}", ex.what());
-                }
-            }
+            [fn](Entity e) { fn(static_cast<uint32_t>(e)); }
         );
     };
 
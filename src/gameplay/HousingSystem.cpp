@@ -11,6 +11,21 @@
 
 namespace gloaming {
 
+namespace {
+
+// Event names and payload keys, interned once so emit sites never hash strings
+const EventId  kHousingRoomInvalidatedEvent = EventNames::intern("housing_room_invalidated");
+const EventId  kHousingRoomFoundEvent       = EventNames::intern("housing_room_found");
+const EventId  kHousingNpcAssignedEvent     = EventNames::intern("housing_npc_assigned");
+const EventKey kKeyRoomId                   = EventNames::intern("room_id");
+const EventKey kKeyNpcEntity                = EventNames::intern("npc_entity");
+const EventKey kKeyX                        = EventNames::intern("x");
+const EventKey kKeyY                        = EventNames::intern("y");
+const EventKey kKeyWidth                    = EventNames::intern("width");
+const EventKey kKeyHeight                   = EventNames::intern("height");
+
+} // namespace
+
 void HousingSystem::init(Registry& registry, Engine& engine) {
     System::init(registry, engine);
     m_tileMap = &engine.getTileMap();
@@ -54,9 +69,10 @@ void HousingSystem::update(float dt) {
                 if (room.consecutiveInvalidChecks >= EvictionThreshold) {
                     if (m_eventBus && room.assignedNPC != NullEntity) {
                         EventData data;
-                        data.setInt("room_id", room.id);
-                        data.setInt("npc_entity", static_cast<int>(room.assignedNPC));
-                        m_eventBus->emit("housing_room_invalidated", data);
+                        data.setInt(kKeyRoomId, room.id);
+                        data.setInt(kKeyNpcEntity, static_cast<int>(room.assignedNPC));
+                        // Queued: update() may run on a worker thread
+                        m_eventBus->queue(kHousingRoomInvalidatedEvent, data);
                     }
                     return true;
                 }
@@ -226,12 +242,12 @@ std::vector<ValidatedRoom> HousingSystem::scanForRooms(float centerX, float cent
 
                     if (m_eventBus) {
                         EventData data;
-                        data.setInt("room_id", room.id);
-                        data.setInt("x", room.topLeft.x);
-                        data.setInt("y", room.topLeft.y);
-                        data.setInt("width", room.bottomRight.x - room.topLeft.x + 1);
-                        data.setInt("height", room.bottomRight.y - room.topLeft.y + 1);
-                        m_eventBus->emit("housing_room_found", data);
+                        data.setInt(kKeyRoomId, room.id);
+                        data.setInt(kKeyX, room.topLeft.x);
+                        data.setInt(kKeyY, room.topLeft.y);
+                        data.setInt(kKeyWidth, room.bottomRight.x - room.topLeft.x + 1);
+                        data.setInt(kKeyHeight, room.bottomRight.y - room.topLeft.y + 1);
+                        m_eventBus->emit(kHousingRoomFoundEvent, data);
                     }
                 }
             }
@@ -257,9 +273,9 @@ bool HousingSystem::assignNPCToRoom(Entity npc, int roomId) {
 
             if (m_eventBus) {
                 EventData data;
-                data.setInt("room_id", roomId);
-                data.setInt("npc_entity", static_cast<int>(npc));
-                m_eventBus->emit("housing_npc_assigned", data);
+                data.setInt(kKeyRoomId, roomId);
+                data.setInt(kKeyNpcEntity, static_cast<int>(npc));
+                m_eventBus->emit(kHousingNpcAssignedEvent, data);
             }
 
             return true;
@@ -58,7 +58,10 @@ struct ValidatedRoom {
 
 class HousingSystem : public System {
 public:
-    HousingSystem() : System("HousingSystem", 10) {}
+    HousingSystem() : System("HousingSystem", 10) {
+        // Room re-validation only reads tiles; invalidation events are queued
+        declareAccess().reads<resource::TileMap>().writes<resource::Events>();
+    }
 
     void init(Registry& registry, Engine& engine) override;
     void update(float dt) override;
@@ -289,8 +289,9 @@ void InputActionMap::registerFlightDefaults() {
 // --- Axis state tracking ---
 
 void InputActionMap::latchAxisState(const Gamepad& gamepad) {
+    float* prev = gamepad.inTick() ? m_tickPrevAxisValues : m_prevAxisValues;
     for (int i = 0; i < AXIS_COUNT; ++i) {
-        m_prevAxisValues[i] = gamepad.getAxis(static_cast<GamepadAxis>(i));
+        prev[i] = gamepad.getAxis(static_cast<GamepadAxis>(i));
     }
 }
 
@@ -334,7 +335,8 @@ bool InputActionMap::checkBinding(const InputBinding& binding, const Input& inpu
 
         case InputSourceType::GamepadAxis: {
             float val = gamepad.getAxis(binding.gamepadAxis);
-            float prevVal = m_prevAxisValues[static_cast<int>(binding.gamepadAxis)];
+            const float* prev = gamepad.inTick() ? m_tickPrevAxisValues : m_prevAxisValues;
+            float prevVal = prev[static_cast<int>(binding.gamepadAxis)];
 
             bool active = binding.axisPositive
                 ? (val >= binding.axisThreshold)
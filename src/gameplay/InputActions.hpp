@@ -119,6 +119,8 @@ public:
 
     /// Call once per frame after gamepad update to latch axis values.
     /// Required for correct Pressed/Released edge detection on axis bindings.
+    /// Called inside a tick (Gamepad::beginTick()), latches the values ticks
+    /// compare against instead, so each tick sees an axis edge once.
     void latchAxisState(const Gamepad& gamepad);
 
 private:
@@ -137,6 +139,7 @@ private:
     // Previous-frame axis values for Pressed/Released edge detection
     static constexpr int AXIS_COUNT = 6;
     float m_prevAxisValues[AXIS_COUNT] = {};
+    float m_tickPrevAxisValues[AXIS_COUNT] = {};    ///< As of the end of the last tick
 };
 
 } // namespace gloaming
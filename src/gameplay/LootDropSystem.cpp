@@ -10,6 +10,20 @@
 
 namespace gloaming {
 
+namespace {
+
+// Event names and payload keys, interned once so emit sites never hash strings
+const EventId  kEnemyKilledEvent = EventNames::intern("enemy_killed");
+const EventId  kLootDroppedEvent = EventNames::intern("loot_dropped");
+const EventKey kKeyEntity        = EventNames::intern("entity");
+const EventKey kKeyEnemyId       = EventNames::intern("enemy_id");
+const EventKey kKeyX             = EventNames::intern("x");
+const EventKey kKeyY             = EventNames::intern("y");
+const EventKey kKeyItem          = EventNames::intern("item");
+const EventKey kKeyCount         = EventNames::intern("count");
+
+} // namespace
+
 void LootDropSystem::init(Registry& registry, Engine& engine) {
     System::init(registry, engine);
     m_contentRegistry = &engine.getContentRegistry();
@@ -43,20 +57,21 @@ void LootDropSystem::update(float dt) {
     for (Entity enemy : deadEnemies) {
         if (!registry.valid(enemy)) continue;
 
-        auto& tag = registry.get<EnemyTag>(enemy);
-        auto& transform = registry.get<Transform>(enemy);
+        uint16_t enemyRuntimeId = registry.get<EnemyTag>(enemy).runtimeId;
+        Vec2 position = registry.get<Transform>(enemy).position;
 
         // Spawn loot
-        spawnLoot(enemy, tag.enemyType, transform.position);
+        spawnLoot(enemyRuntimeId, position);
 
         // Emit death event
         if (m_eventBus) {
+            const EnemyDefinition* def = m_contentRegistry->getEnemyByRuntime(enemyRuntimeId);
             EventData data;
-            data.setInt("entity", static_cast<int>(enemy));
-            data.setString("enemy_id", tag.enemyType);
-            data.setFloat("x", transform.position.x);
-            data.setFloat("y", transform.position.y);
-            m_eventBus->emit("enemy_killed", data);
+            data.setInt(kKeyEntity, static_cast<int>(enemy));
+            data.setString(kKeyEnemyId, def ? std::string_view(def->qualifiedId) : std::string_view());
+            data.setFloat(kKeyX, position.x);
+            data.setFloat(kKeyY, position.y);
+            m_eventBus->emit(kEnemyKilledEvent, data);
         }
 
         // Update kill stats
@@ -69,14 +84,16 @@ void LootDropSystem::update(float dt) {
     }
 }
 
-void LootDropSystem::spawnLoot(Entity enemy, const std::string& enemyType,
-                                const Vec2& position) {
-    const EnemyDefinition* def = m_contentRegistry->getEnemy(enemyType);
-    if (!def) return;
-
+void LootDropSystem::spawnLoot(uint16_t enemyRuntimeId, const Vec2& position) {
     std::uniform_real_distribution<float> chanceDist(0.0f, 1.0f);
 
-    for (const auto& drop : def->drops) {
+    // Re-fetch the definition each drop: a loot_dropped handler may register
+    // content, which can move the registry's definition array
+    for (size_t i = 0;; ++i) {
+        const EnemyDefinition* def = m_contentRegistry->getEnemyByRuntime(enemyRuntimeId);
+        if (!def || i >= def->drops.size()) break;
+        const auto& drop = def->drops[i];
+
         // Roll for drop chance
         if (chanceDist(m_rng) > drop.chance) continue;
 
@@ -95,12 +112,12 @@ void LootDropSystem::spawnLoot(Entity enemy, const std::string& enemyType,
 
         if (m_eventBus) {
             EventData data;
-            data.setString("item", drop.item);
-            data.setInt("count", count);
-            data.setString("enemy_id", enemyType);
-            data.setFloat("x", position.x);
-            data.setFloat("y", position.y);
-            m_eventBus->emit("loot_dropped", data);
+            data.setString(kKeyItem, drop.item);
+            data.setInt(kKeyCount, count);
+            data.setString(kKeyEnemyId, def->qualifiedId);
+            data.setFloat(kKeyX, position.x);
+            data.setFloat(kKeyY, position.y);
+            m_eventBus->emit(kLootDroppedEvent, data);
         }
     }
 }
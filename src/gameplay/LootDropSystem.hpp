@@ -35,7 +35,7 @@ public:
 
 private:
     /// Spawn item drops for a killed enemy
-    void spawnLoot(Entity enemy, const std::string& enemyType, const Vec2& position);
+    void spawnLoot(uint16_t enemyRuntimeId, const Vec2& position);
 
     /// Create an ItemDrop entity at a position with a small random offset
     Entity spawnItemDropEntity(const std::string& itemId, int count,
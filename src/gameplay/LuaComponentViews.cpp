@@ -0,0 +1,228 @@
+#include "gameplay/LuaComponentViews.hpp"
+#include "ecs/Components.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gloaming {
+
+namespace {
+
+/// Most components one entity.each() call can ask for
+constexpr size_t kMaxEachComponents = 4;
+
+template<typename T>
+using StorageFor = std::remove_reference_t<decltype(std::declval<entt::registry&>().storage<T>())>;
+
+/// One entity's component, looked up in its EnTT pool on every access.
+/// Holds the pool rather than the component because pools reallocate as
+/// components are added.
+template<typename T>
+class ComponentView {
+public:
+    ComponentView(StorageFor<T>& storage, Entity entity)
+        : m_storage(&storage), m_entity(entity) {}
+
+    bool valid() const { return m_storage->contains(m_entity); }
+    uint32_t id() const { return static_cast<uint32_t>(m_entity); }
+    Entity entity() const { return m_entity; }
+    void retarget(Entity entity) { m_entity = entity; }
+
+    T& get() const {
+        if (!m_storage->contains(m_entity)) {
+            throw std::runtime_error("component view is stale (entity destroyed or component removed)");
+        }
+        return m_storage->get(m_entity);
+    }
+
+private:
+    StorageFor<T>* m_storage;
+    Entity m_entity;
+};
+
+using TransformView = ComponentView<Transform>;
+using VelocityView = ComponentView<Velocity>;
+using HealthView = ComponentView<Health>;
+using GravityView = ComponentView<Gravity>;
+
+/// Read/write Lua property for one float field of a view's component
+template<typename View, typename Get>
+auto floatField(Get get) {
+    return sol::property(
+        [get](const View& view) -> float { return get(view.get()); },
+        [get](View& view, float value) { get(view.get()) = value; });
+}
+
+/// floatField for a Transform position coordinate. Logs the entity as
+/// changed on write so cached spatial queries notice the move.
+template<typename Get>
+auto positionField(Registry& registry, Get get) {
+    return sol::property(
+        [get](const TransformView& view) -> float { return get(view.get()); },
+        [get, &registry](TransformView& view, float value) {
+            get(view.get()) = value;
+            registry.touch(view.entity());
+        });
+}
+
+/// Type-erased operations on one component kind, so each() can mix kinds
+struct ViewKind {
+    std::string_view name;
+    entt::sparse_set& (*pool)(Registry& registry);
+    sol::object (*make)(lua_State* L, Registry& registry, Entity entity, void*& outView);
+    void (*retarget)(void* view, Entity entity);
+};
+
+template<typename T>
+ViewKind makeViewKind(std::string_view name) {
+    return {
+        name,
+        [](Registry& registry) -> entt::sparse_set& { return registry.raw().storage<T>(); },
+        [](lua_State* L, Registry& registry, Entity entity, void*& outView) {
+            sol::object object = sol::make_object(L, ComponentView<T>(registry.raw().storage<T>(), entity));
+            // Userdata never moves, so the pointer stays valid while `object` lives
+            outView = &object.as<ComponentView<T>&>();
+            return object;
+        },
+        [](void* view, Entity entity) { static_cast<ComponentView<T>*>(view)->retarget(entity); },
+    };
+}
+
+const ViewKind* findViewKind(std::string_view name) {
+    static const std::array<ViewKind, 4> kKinds = {
+        makeViewKind<Transform>("transform"),
+        makeViewKind<Velocity>("velocity"),
+        makeViewKind<Health>("health"),
+        makeViewKind<Gravity>("gravity"),
+    };
+    for (const ViewKind& kind : kKinds) {
+        if (kind.name == name) return &kind;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void bindComponentViews(sol::state& lua, sol::table entityApi, Registry& registry) {
+    lua.new_usertype<TransformView>("TransformView", sol::no_constructor,
+        "x", positionField(registry, [](Transform& t) -> float& { return t.position.x; }),
+        "y", positionField(registry, [](Transform& t) -> float& { return t.position.y; }),
+        "rotation", floatField<TransformView>([](Transform& t) -> float& { return t.rotation; }),
+        "scale_x", floatField<TransformView>([](Transform& t) -> float& { return t.scale.x; }),
+        "scale_y", floatField<TransformView>([](Transform& t) -> float& { return t.scale.y; }),
+        "entity", sol::readonly_property(&TransformView::id),
+        "valid", sol::readonly_property(&TransformView::valid));
+
+    lua.new_usertype<VelocityView>("VelocityView", sol::no_constructor,
+        "x", floatField<VelocityView>([](Velocity& v) -> float& { return v.linear.x; }),
+        "y", floatField<VelocityView>([](Velocity& v) -> float& { return v.linear.y; }),
+        "angular", floatField<VelocityView>([](Velocity& v) -> float& { return v.angular; }),
+        "entity", sol::readonly_property(&VelocityView::id),
+        "valid", sol::readonly_property(&VelocityView::valid));
+
+    lua.new_usertype<HealthView>("HealthView", sol::no_constructor,
+        "current", floatField<HealthView>([](Health& h) -> float& { return h.current; }),
+        "max", floatField<HealthView>([](Health& h) -> float& { return h.max; }),
+        "percentage", sol::readonly_property([](const HealthView& v) { return v.get().getPercentage(); }),
+        "is_dead", sol::readonly_property([](const HealthView& v) { return v.get().isDead(); }),
+        "entity", sol::readonly_property(&HealthView::id),
+        "valid", sol::readonly_property(&HealthView::valid));
+
+    lua.new_usertype<GravityView>("GravityView", sol::no_constructor,
+        "scale", floatField<GravityView>([](Gravity& g) -> float& { return g.scale; }),
+        "grounded", sol::readonly_property([](const GravityView& v) { return v.get().grounded; }),
+        "entity", sol::readonly_property(&GravityView::id),
+        "valid", sol::readonly_property(&GravityView::valid));
+
+    // entity.ref(entityId, componentName) -> live view, or nil if the entity
+    // lacks the component
+    entityApi["ref"] = [&registry](sol::this_state ts, uint32_t entityId,
+                                   const std::string& name) -> sol::object {
+        const ViewKind* kind = findViewKind(name);
+        if (!kind) {
+            throw std::runtime_error("entity.ref: no view for component '" + name + "'");
+        }
+        Entity entity = static_cast<Entity>(entityId);
+        if (!registry.valid(entity) || !kind->pool(registry).contains(entity)) {
+            return sol::nil;
+        }
+        void* view = nullptr;
+        return kind->make(ts, registry, entity, view);
+    };
+
+    // entity.each({ componentName, ... }, fn(entityId, view, ...)) -> visited count
+    entityApi["each"] = [&registry](sol::this_state ts, sol::table names,
+                                    sol::function fn) -> int {
+        lua_State* L = ts;
+
+        std::array<const ViewKind*, kMaxEachComponents> kinds{};
+        std::array<entt::sparse_set*, kMaxEachComponents> pools{};
+        size_t count = 0;
+        for (size_t i = 1; i <= names.size(); ++i) {
+            sol::optional<std::string> name = names.get<sol::optional<std::string>>(i);
+            const ViewKind* kind = name ? findViewKind(*name) : nullptr;
+            if (!kind) {
+                throw std::runtime_error("entity.each: no view for component '" +
+                                         name.value_or("?") + "'");
+            }
+            if (count == kMaxEachComponents) {
+                throw std::runtime_error("entity.each: at most 4 components");
+            }
+            kinds[count] = kind;
+            pools[count] = &kind->pool(registry);
+            ++count;
+        }
+        if (count == 0) return 0;
+
+        // The smallest pool drives iteration. Snapshot it, since the
+        // callback may create or destroy entities
+        size_t driver = 0;
+        for (size_t i = 1; i < count; ++i) {
+            if (pools[i]->size() < pools[driver]->size()) driver = i;
+        }
+        std::vector<Entity> entities(pools[driver]->begin(), pools[driver]->end());
+
+        // One view per component, re-pointed at each entity in turn
+        std::array<sol::object, kMaxEachComponents> views;
+        std::array<void*, kMaxEachComponents> viewPtrs{};
+        for (size_t i = 0; i < count; ++i) {
+            views[i] = kinds[i]->make(L, registry, entt::null, viewPtrs[i]);
+        }
+
+        int visited = 0;
+        const int top = lua_gettop(L);
+        for (Entity entity : entities) {
+            bool matches = true;
+            for (size_t i = 0; i < count && matches; ++i) {
+                matches = pools[i]->contains(entity);
+            }
+            if (!matches) continue;
+
+            for (size_t i = 0; i < count; ++i) {
+                kinds[i]->retarget(viewPtrs[i], entity);
+            }
+
+            fn.push(L);
+            lua_pushinteger(L, static_cast<lua_Integer>(static_cast<uint32_t>(entity)));
+            for (size_t i = 0; i < count; ++i) {
+                views[i].push(L);
+            }
+            if (lua_pcall(L, static_cast<int>(count) + 1, 1, 0) != LUA_OK) {
+                const char* message = lua_tostring(L, -1);
+                std::string error = message ? message : "entity.each: callback failed";
+                lua_settop(L, top);
+                throw std::runtime_error(error);
+            }
+            ++visited;
+            bool stop = lua_isboolean(L, -1) && !lua_toboolean(L, -1);
+            lua_settop(L, top);
+            if (stop) break;
+        }
+        return visited;
+    };
+}
+
+} // namespace gloaming
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "ecs/Registry.hpp"
+
+#include <sol/sol.hpp>
+
+namespace gloaming {
+
+/// Registers zero-copy component views on the `entity` table:
+///   - entity.ref(id, name) -> live view of one component, or nil
+///   - entity.each({ names... }, fn) -> calls fn(id, view1, view2, ...) for
+///     every entity that has all of them; fn returning false stops early
+///
+/// Views ("transform", "velocity", "health", "gravity") read and write EnTT
+/// storage directly instead of copying into tables. Every field access
+/// checks that the entity still has the component, so a view outliving its
+/// entity (or a recycled ID) raises a Lua error; `view.valid` tests without
+/// raising. each() reuses one view per component for every entity it visits,
+/// so keep entity.ref() results, not those, beyond the callback.
+void bindComponentViews(sol::state& lua, sol::table entityApi, Registry& registry);
+
+} // namespace gloaming
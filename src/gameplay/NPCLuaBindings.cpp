@@ -134,14 +134,18 @@ void bindNPCAPI(sol::state& lua, Engine& engine,
 
     // npc.register_behavior(name, callback)
     // callback = function(entityId, dt) ... end
-    npcApi["register_behavior"] = [&npcSystem](const std::string& name, sol::function callback) {
-        sol::function fn = callback;
+    npcApi["register_behavior"] = [&npcSystem, &engine](const std::string& name,
+                                                        sol::protected_function callback) {
+        sol::protected_function fn = callback;
+        LuaCpuBudget* cpu = &engine.getModLoader().getLuaBindings().getCpuBudget();
+        LuaCpuBudget::ModHandle owner = cpu->currentMod();
         npcSystem.registerBehavior(name,
-            [fn](Entity entity, NPCAI& ai, float dt) {
-                try {
-                    fn(static_cast<uint32_t>(entity), dt);
-                } catch (const std::exception& ex) {
-                    MOD_LOG_ERROR("npc behavior '{}' error: {}", ai.behavior, ex.what());
+            [fn, cpu, owner](Entity entity, NPCAI& ai, float dt) {
+                LuaCpuBudget::Scope scope(cpu, owner);
+                sol::protected_function_result result = fn(static_cast<uint32_t>(entity), dt);
+                if (!result.valid()) {
+                    sol::error err = result;
+                    MOD_LOG_ERROR("npc behavior '{}' error: {}", ai.behavior, err.what());
                 }
             });
     };
@@ -12,6 +12,21 @@
 
 namespace gloaming {
 
+namespace {
+
+// Event names and payload keys, interned once so emit sites never hash strings
+const EventId  kNpcSpawnedEvent         = EventNames::intern("npc_spawned");
+const EventId  kNpcDialogueStartedEvent = EventNames::intern("npc_dialogue_started");
+const EventKey kKeyNpcId                = EventNames::intern("npc_id");
+const EventKey kKeyEntity               = EventNames::intern("entity");
+const EventKey kKeyX                    = EventNames::intern("x");
+const EventKey kKeyY                    = EventNames::intern("y");
+const EventKey kKeyNpcEntity            = EventNames::intern("npc_entity");
+const EventKey kKeyPlayerEntity         = EventNames::intern("player_entity");
+const EventKey kKeyDialogueId           = EventNames::intern("dialogue_id");
+
+} // namespace
+
 void NPCSystem::init(Registry& registry, Engine& engine) {
     System::init(registry, engine);
     m_tileMap = &engine.getTileMap();
@@ -27,27 +42,41 @@ void NPCSystem::init(Registry& registry, Engine& engine) {
 void NPCSystem::update(float dt) {
     auto& registry = getRegistry();
 
+    // Gather players once; they are also the LOD reference points
+    m_players.clear();
+    m_lod.beginFrame();
+    registry.each<PlayerTag, Transform>([&](Entity player, const PlayerTag&,
+                                             const Transform& pt) {
+        m_players.emplace_back(player, pt.position);
+        m_lod.addReferencePoint(pt.position);
+    });
+    m_lod.addReferencePoint(getEngine().getCamera().getPosition());
+
     registry.each<NPCAI, Transform>([&](Entity entity, NPCAI& ai, Transform& transform) {
         // Skip FSM-driven NPCs
         if (ai.behavior == NPCBehavior::Custom) return;
 
+        // Distant NPCs only run every few frames, with the accumulated dt
+        float step = 0.0f;
+        if (!m_lod.shouldUpdate(entity, transform.position, ai.lod, dt, step)) return;
+
         // Check player proximity for interaction
         checkPlayerInteraction(entity, transform, ai);
 
         // Execute custom behavior if registered
         auto customIt = m_customBehaviors.find(ai.behavior);
         if (customIt != m_customBehaviors.end()) {
-            customIt->second(entity, ai, dt);
+            customIt->second(entity, ai, step);
             return;
         }
 
         // Execute built-in behavior
         if (ai.behavior == NPCBehavior::Idle) {
-            behaviorIdle(entity, ai, dt);
+            behaviorIdle(entity, ai, step);
         } else if (ai.behavior == NPCBehavior::Wander) {
-            behaviorWander(entity, ai, dt);
+            behaviorWander(entity, ai, step);
         } else if (ai.behavior == NPCBehavior::Stationed) {
-            behaviorStationed(entity, ai, dt);
+            behaviorStationed(entity, ai, step);
         }
         // "schedule" is handled by Lua via custom behavior or FSM
     });
@@ -123,11 +152,11 @@ Entity NPCSystem::spawnNPC(const std::string& npcId, float x, float y) {
     // Emit event
     if (m_eventBus) {
         EventData data;
-        data.setString("npc_id", npcId);
-        data.setInt("entity", static_cast<int>(npc));
-        data.setFloat("x", x);
-        data.setFloat("y", y);
-        m_eventBus->emit("npc_spawned", data);
+        data.setString(kKeyNpcId, npcId);
+        data.setInt(kKeyEntity, static_cast<int>(npc));
+        data.setFloat(kKeyX, x);
+        data.setFloat(kKeyY, y);
+        m_eventBus->emit(kNpcSpawnedEvent, data);
     }
 
     LOG_DEBUG("NPCSystem: spawned '{}' at ({}, {})", npcId, x, y);
@@ -178,10 +207,10 @@ bool NPCSystem::startDialogue(Entity npc, Entity player) {
     // Emit event
     if (m_eventBus) {
         EventData data;
-        data.setInt("npc_entity", static_cast<int>(npc));
-        data.setInt("player_entity", static_cast<int>(player));
-        data.setString("dialogue_id", dlg.dialogueId);
-        m_eventBus->emit("npc_dialogue_started", data);
+        data.setInt(kKeyNpcEntity, static_cast<int>(npc));
+        data.setInt(kKeyPlayerEntity, static_cast<int>(player));
+        data.setString(kKeyDialogueId, dlg.dialogueId);
+        m_eventBus->emit(kNpcDialogueStartedEvent, data);
     }
 
     return true;
@@ -191,21 +220,19 @@ int NPCSystem::getActiveNPCCount() const {
     return static_cast<int>(getRegistry().count<NPCTag>());
 }
 
-void NPCSystem::checkPlayerInteraction(Entity npc, const Transform& npcTransform, NPCAI& ai) {
-    auto& registry = getRegistry();
+void NPCSystem::checkPlayerInteraction(Entity /*npc*/, const Transform& npcTransform, NPCAI& ai) {
     ai.playerInRange = false;
     ai.interactingPlayer = NullEntity;
 
-    registry.each<PlayerTag, Transform>([&](Entity player, const PlayerTag&,
-                                             const Transform& pt) {
-        float dx = pt.position.x - npcTransform.position.x;
-        float dy = pt.position.y - npcTransform.position.y;
-        float dist = std::sqrt(dx * dx + dy * dy);
-        if (dist <= ai.interactionRange) {
+    float rangeSq = ai.interactionRange * ai.interactionRange;
+    for (const auto& [player, position] : m_players) {
+        float dx = position.x - npcTransform.position.x;
+        float dy = position.y - npcTransform.position.y;
+        if (dx * dx + dy * dy <= rangeSq) {
             ai.playerInRange = true;
             ai.interactingPlayer = player;
         }
-    });
+    }
 }
 
 void NPCSystem::behaviorIdle(Entity /*npc*/, NPCAI& /*ai*/, float /*dt*/) {
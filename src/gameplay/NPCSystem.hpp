@@ -3,6 +3,7 @@
 #include "ecs/Systems.hpp"
 #include "ecs/Components.hpp"
 #include "gameplay/GameMode.hpp"
+#include "gameplay/AILod.hpp"
 
 #include <string>
 #include <vector>
@@ -61,6 +62,8 @@ struct NPCAI {
     bool playerInRange = false;
     Entity interactingPlayer = NullEntity;
 
+    AILodState lod;                      // Update-rate bookkeeping (NPCSystem)
+
     NPCAI() = default;
     explicit NPCAI(const std::string& behav)
         : behavior(behav), defaultBehavior(behav) {}
@@ -116,6 +119,11 @@ public:
     /// Get NPC count
     int getActiveNPCCount() const;
 
+    /// Distance-based update-rate scheduling: NPCs far from every player and
+    /// the camera update every few frames with the accumulated dt.
+    void setLodConfig(const AILodConfig& config) { m_lod.setConfig(config); }
+    const AILodScheduler& getLod() const { return m_lod; }
+
 private:
     void checkPlayerInteraction(Entity npc, const Transform& transform, NPCAI& ai);
 
@@ -134,6 +142,11 @@ private:
     ViewMode m_viewMode = ViewMode::SideView;
 
     std::unordered_map<std::string, NPCBehaviorCallback> m_customBehaviors;
+
+    AILodScheduler m_lod;
+
+    // Players gathered once per frame (entity, position)
+    std::vector<std::pair<Entity, Vec2>> m_players;
 };
 
 } // namespace gloaming
@@ -36,7 +36,7 @@ static Color readColor(const sol::optional<sol::table>& optTbl) {
 }
 
 /// Helper: build ParticleEmitterConfig from a Lua table
-static ParticleEmitterConfig readEmitterConfig(const sol::table& opts) {
+static ParticleEmitterConfig readEmitterConfig(const sol::table& opts, TextureManager& textures) {
     ParticleEmitterConfig config;
 
     // Emission
@@ -116,6 +116,14 @@ static ParticleEmitterConfig readEmitterConfig(const sol::table& opts) {
     // Follow camera
     config.followCamera = opts.get_or("follow_camera", false);
 
+    // Appearance: texture path and "alpha" / "additive" blending
+    sol::optional<std::string> texturePath = opts.get<sol::optional<std::string>>("texture");
+    if (texturePath && !texturePath->empty()) {
+        config.texture = textures.loadTexture(*texturePath);
+    }
+    std::string blend = opts.get_or<std::string>("blend", "alpha");
+    config.blend = (blend == "additive") ? BlendMode::Additive : BlendMode::Alpha;
+
     return config;
 }
 
@@ -130,8 +138,8 @@ void bindParticlePolishAPI(sol::state& lua, Engine& engine,
     auto particlesApi = lua.create_named_table("particles");
 
     // particles.burst({ x, y, count, speed, angle, lifetime, size, color, ... })
-    particlesApi["burst"] = [&particleSystem](sol::table opts) -> uint32_t {
-        ParticleEmitterConfig config = readEmitterConfig(opts);
+    particlesApi["burst"] = [&engine, &particleSystem](sol::table opts) -> uint32_t {
+        ParticleEmitterConfig config = readEmitterConfig(opts, engine.getTextureManager());
 
         Vec2 position(
             opts.get_or("x", 0.0f),
@@ -142,15 +150,15 @@ void bindParticlePolishAPI(sol::state& lua, Engine& engine,
     };
 
     // particles.attach(entityId, { rate, speed, angle, ... }) -> emitterId
-    particlesApi["attach"] = [&particleSystem](uint32_t entityId, sol::table opts) -> uint32_t {
-        ParticleEmitterConfig config = readEmitterConfig(opts);
+    particlesApi["attach"] = [&engine, &particleSystem](uint32_t entityId, sol::table opts) -> uint32_t {
+        ParticleEmitterConfig config = readEmitterConfig(opts, engine.getTextureManager());
         Entity entity = static_cast<Entity>(entityId);
         return particleSystem.attach(entity, config);
     };
 
     // particles.spawn_emitter({ x, y, rate, speed, angle, ... }) -> emitterId
-    particlesApi["spawn_emitter"] = [&particleSystem](sol::table opts) -> uint32_t {
-        ParticleEmitterConfig config = readEmitterConfig(opts);
+    particlesApi["spawn_emitter"] = [&engine, &particleSystem](sol::table opts) -> uint32_t {
+        ParticleEmitterConfig config = readEmitterConfig(opts, engine.getTextureManager());
 
         Vec2 position(
             opts.get_or("x", 0.0f),
@@ -197,10 +205,10 @@ void bindParticlePolishAPI(sol::state& lua, Engine& engine,
 
     // tween.to(entityId, { x = 100, y = 200, ... }, duration, easing, on_complete)
     // Supports tweening: x, y, rotation, scale_x, scale_y, alpha
-    tweenApi["to"] = [&tweenSystem](uint32_t entityId, sol::table properties,
-                                     float duration,
-                                     sol::optional<std::string> easingName,
-                                     sol::optional<sol::function> onComplete) -> sol::object {
+    tweenApi["to"] = [&engine, &tweenSystem](uint32_t entityId, sol::table properties,
+                                              float duration,
+                                              sol::optional<std::string> easingName,
+                                              sol::optional<sol::protected_function> onComplete) -> sol::object {
         Entity entity = static_cast<Entity>(entityId);
         EasingFunction easing = Easing::linear;
 
@@ -252,13 +260,8 @@ void bindParticlePolishAPI(sol::state& lua, Engine& engine,
             // Only attach completion callback to the last property tween
             std::function<void()> completionCb = nullptr;
             if (isLast && onComplete) {
-                sol::function fn = *onComplete;
-                completionCb = [fn]() {
-                    try { fn(); }
-                    catch (const std::exception& ex) {
-                        MOD_LOG_ERROR("tween on_complete error: {}", ex.what());
-                    }
-                };
+                completionCb = engine.getModLoader().getLuaBindings().modCallback(
+                    *onComplete, "tween on_complete");
             }
 
             lastId = tweenSystem.tweenTo(entity, entries[i].prop, entries[i].value,
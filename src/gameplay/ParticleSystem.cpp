@@ -11,17 +11,77 @@ namespace gloaming {
 
 ParticleSystem::ParticleSystem()
     : System("ParticleSystem", 0) {
+    // Particles live in the system; entities are only read for emitter positions
+    declareAccess().reads<Transform>();
+
     m_particles.resize(1000); // Initial pool size
-    // Initialize free-list with all indices (all particles start dead)
-    m_freeList.reserve(1000);
-    for (size_t i = 0; i < 1000; ++i) {
-        m_freeList.push_back(i);
-    }
 }
 
 void ParticleSystem::init(Registry& registry, Engine& engine) {
     System::init(registry, engine);
-    LOG_INFO("ParticleSystem initialized (pool size: {})", m_particles.size());
+    m_jobSystem = &engine.getJobSystem();
+    LOG_INFO("ParticleSystem initialized (pool size: {})", m_particles.capacity());
+}
+
+void ParticleSystem::ParticleStore::resize(size_t n) {
+    posX.resize(n);
+    posY.resize(n);
+    velX.resize(n);
+    velY.resize(n);
+    age.resize(n);
+    lifetime.resize(n);
+    invLifetime.resize(n);
+    gravity.resize(n);
+    size.resize(n);
+    sizeStart.resize(n);
+    sizeEnd.resize(n);
+    colorStart.resize(n);
+    colorEnd.resize(n);
+    material.resize(n);
+    emitterId.resize(n);
+}
+
+void ParticleSystem::ParticleStore::removeSwap(size_t i) {
+    size_t last = --count;
+    if (i == last) return;
+    posX[i] = posX[last];
+    posY[i] = posY[last];
+    velX[i] = velX[last];
+    velY[i] = velY[last];
+    age[i] = age[last];
+    lifetime[i] = lifetime[last];
+    invLifetime[i] = invLifetime[last];
+    gravity[i] = gravity[last];
+    size[i] = size[last];
+    sizeStart[i] = sizeStart[last];
+    sizeEnd[i] = sizeEnd[last];
+    colorStart[i] = colorStart[last];
+    colorEnd[i] = colorEnd[last];
+    material[i] = material[last];
+    emitterId[i] = emitterId[last];
+}
+
+void ParticleSystem::integrate(size_t begin, size_t end, float dt) {
+    // Raw pointers keep the loop free of vector bounds bookkeeping so it vectorizes
+    float* __restrict px = m_particles.posX.data();
+    float* __restrict py = m_particles.posY.data();
+    float* __restrict vx = m_particles.velX.data();
+    float* __restrict vy = m_particles.velY.data();
+    float* __restrict age = m_particles.age.data();
+    const float* __restrict invLife = m_particles.invLifetime.data();
+    const float* __restrict gravity = m_particles.gravity.data();
+    float* __restrict size = m_particles.size.data();
+    const float* __restrict sizeStart = m_particles.sizeStart.data();
+    const float* __restrict sizeEnd = m_particles.sizeEnd.data();
+
+    for (size_t i = begin; i < end; ++i) {
+        age[i] += dt;
+        vy[i] += gravity[i] * dt;
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        float t = age[i] * invLife[i];
+        size[i] = sizeStart[i] + (sizeEnd[i] - sizeStart[i]) * t;
+    }
 }
 
 void ParticleSystem::update(float dt) {
@@ -55,29 +115,22 @@ void ParticleSystem::update(float dt) {
         }
     }
 
-    // Update all particles
-    for (size_t i = 0; i < m_particles.size(); ++i) {
-        auto& particle = m_particles[i];
-        if (!particle.alive) continue;
-
-        particle.age += dt;
-        if (particle.age >= particle.lifetime) {
-            particle.alive = false;
-            freeParticle(i);
-            continue;
-        }
+    // Update all particles: branch-free integration over the dense arrays,
+    // split across workers for big pools, then compact out the expired ones
+    const size_t count = m_particles.count;
+    auto integrateRange = [this, dt](size_t begin, size_t end) { integrate(begin, end, dt); };
+    if (m_jobSystem && count > kParallelGrain) {
+        m_jobSystem->parallelFor(count, kParallelGrain, integrateRange);
+    } else {
+        integrateRange(0, count);
+    }
 
-        // Apply gravity
-        if (particle.gravity != 0.0f) {
-            particle.velocity.y += particle.gravity * dt;
+    for (size_t i = 0; i < m_particles.count; ) {
+        if (m_particles.age[i] >= m_particles.lifetime[i]) {
+            m_particles.removeSwap(i);
+        } else {
+            ++i;
         }
-
-        // Move
-        particle.position += particle.velocity * dt;
-
-        // Update size based on curve
-        float t = particle.age / particle.lifetime;
-        particle.size = particle.sizeCurve.evaluate(t);
     }
 
     // Clean up dead emitters (not active + no alive particles from them)
@@ -112,36 +165,59 @@ void ParticleSystem::render(IRenderer* renderer, const Camera& camera) {
     visibleArea.width += 100.0f;
     visibleArea.height += 100.0f;
 
-    for (const auto& particle : m_particles) {
-        if (!particle.alive) continue;
+    const float zoom = camera.getZoom();
+    m_batches.resize(m_materials.size());
+    for (auto& batch : m_batches) batch.clear();
+
+    for (size_t i = 0; i < m_particles.count; ++i) {
+        Vec2 position(m_particles.posX[i], m_particles.posY[i]);
 
         // Culling: skip particles outside visible area
-        if (!visibleArea.contains(particle.position)) continue;
+        if (!visibleArea.contains(position)) continue;
 
         // Interpolate color
-        float t = particle.age / particle.lifetime;
-        ColorF currentColor = ColorF::lerp(particle.colorStart, particle.colorEnd, t);
+        float t = m_particles.age[i] * m_particles.invLifetime[i];
+        ColorF currentColor = ColorF::lerp(m_particles.colorStart[i], m_particles.colorEnd[i], t);
         Color drawColor = currentColor.toColor();
 
         // Convert to screen space
-        Vec2 screenPos = camera.worldToScreen(particle.position);
-        float halfSize = particle.size * 0.5f * camera.getZoom();
-
-        // Draw as filled rectangle (simple colored particle)
-        Rect drawRect(
-            screenPos.x - halfSize,
-            screenPos.y - halfSize,
-            particle.size * camera.getZoom(),
-            particle.size * camera.getZoom()
-        );
-        renderer->drawRectangle(drawRect, drawColor);
+        Vec2 screenPos = camera.worldToScreen(position);
+        float halfSize = m_particles.size[i] * 0.5f * zoom;
+        float left = screenPos.x - halfSize;
+        float top = screenPos.y - halfSize;
+        float right = screenPos.x + halfSize;
+        float bottom = screenPos.y + halfSize;
+
+        auto& batch = m_batches[m_particles.material[i]];
+        batch.push_back({Vec2(left, top), Vec2(0.0f, 0.0f), drawColor});
+        batch.push_back({Vec2(left, bottom), Vec2(0.0f, 1.0f), drawColor});
+        batch.push_back({Vec2(right, bottom), Vec2(1.0f, 1.0f), drawColor});
+        batch.push_back({Vec2(right, top), Vec2(1.0f, 0.0f), drawColor});
+    }
+
+    for (size_t m = 0; m < m_batches.size(); ++m) {
+        const auto& batch = m_batches[m];
+        if (batch.empty()) continue;
+        renderer->drawQuadBatch(m_materials[m].texture, m_materials[m].blend,
+                                batch.data(), batch.size() / 4);
     }
 }
 
+uint32_t ParticleSystem::internMaterial(const ParticleEmitterConfig& config) {
+    for (size_t i = 0; i < m_materials.size(); ++i) {
+        if (m_materials[i].texture == config.texture && m_materials[i].blend == config.blend) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    m_materials.push_back({config.texture, config.blend});
+    return static_cast<uint32_t>(m_materials.size() - 1);
+}
+
 EmitterId ParticleSystem::burst(const ParticleEmitterConfig& config, Vec2 position) {
     EmitterInstance emitter;
     emitter.id = m_nextId++;
     emitter.config = config;
+    emitter.material = internMaterial(config);
     emitter.position = position + config.offset;
     emitter.active = false; // Burst emitters don't continuously emit
 
@@ -161,6 +237,7 @@ EmitterId ParticleSystem::attach(Entity entity, const ParticleEmitterConfig& con
     EmitterInstance emitter;
     emitter.id = m_nextId++;
     emitter.config = config;
+    emitter.material = internMaterial(config);
     emitter.entity = entity;
     emitter.active = true;
 
@@ -178,6 +255,7 @@ EmitterId ParticleSystem::spawnEmitter(const ParticleEmitterConfig& config, Vec2
     EmitterInstance emitter;
     emitter.id = m_nextId++;
     emitter.config = config;
+    emitter.material = internMaterial(config);
     emitter.position = position + config.offset;
     emitter.active = true;
 
@@ -201,10 +279,11 @@ void ParticleSystem::destroyEmitter(EmitterId id) {
             emitter.alive = false;
             emitter.active = false;
             // Kill all particles belonging to this emitter
-            for (size_t i = 0; i < m_particles.size(); ++i) {
-                if (m_particles[i].alive && m_particles[i].emitterId == id) {
-                    m_particles[i].alive = false;
-                    freeParticle(i);
+            for (size_t i = 0; i < m_particles.count; ) {
+                if (m_particles.emitterId[i] == id) {
+                    m_particles.removeSwap(i);
+                } else {
+                    ++i;
                 }
             }
             return;
@@ -243,80 +322,70 @@ ParticleSystem::Stats ParticleSystem::getStats() const {
     for (const auto& e : m_emitters) {
         if (e.alive) ++stats.activeEmitters;
     }
-    for (const auto& p : m_particles) {
-        if (p.alive) ++stats.activeParticles;
-    }
-    stats.poolSize = m_particles.size();
+    stats.activeParticles = m_particles.count;
+    stats.poolSize = m_particles.capacity();
     return stats;
 }
 
 void ParticleSystem::emitParticles(EmitterInstance& emitter, int count) {
-    for (int i = 0; i < count; ++i) {
-        Particle* p = allocateParticle();
-        if (!p) return; // Pool full
+    auto& p = m_particles;
+    for (int n = 0; n < count; ++n) {
+        size_t i;
+        if (!allocateParticle(i)) return; // Pool full
 
-        p->alive = true;
-        p->age = 0.0f;
-        p->emitterId = emitter.id;
+        p.age[i] = 0.0f;
+        p.material[i] = emitter.material;
+        p.emitterId[i] = emitter.id;
 
         // Position: emitter position + random spread for area emitters
-        p->position = emitter.position;
+        p.posX[i] = emitter.position.x;
+        p.posY[i] = emitter.position.y;
         if (emitter.config.width > 0.0f) {
-            p->position.x += randomRange(-emitter.config.width * 0.5f,
-                                          emitter.config.width * 0.5f);
+            p.posX[i] += randomRange(-emitter.config.width * 0.5f,
+                                      emitter.config.width * 0.5f);
         }
 
         // Velocity from angle and speed
         float speed = randomRange(emitter.config.speed.min, emitter.config.speed.max);
         float angleDeg = randomRange(emitter.config.angle.min, emitter.config.angle.max);
         float angleRad = angleDeg * DEG_TO_RAD;
-        p->velocity = Vec2(std::cos(angleRad) * speed, std::sin(angleRad) * speed);
+        p.velX[i] = std::cos(angleRad) * speed;
+        p.velY[i] = std::sin(angleRad) * speed;
 
         // Lifetime
-        p->lifetime = randomRange(emitter.config.lifetime.min, emitter.config.lifetime.max);
+        float lifetime = randomRange(emitter.config.lifetime.min, emitter.config.lifetime.max);
+        p.lifetime[i] = lifetime;
+        p.invLifetime[i] = lifetime > 0.0f ? 1.0f / lifetime : 0.0f;
 
         // Size curve
-        p->sizeCurve = emitter.config.size;
-        p->size = emitter.config.size.start;
+        p.sizeStart[i] = emitter.config.size.start;
+        p.sizeEnd[i] = emitter.config.size.finish;
+        p.size[i] = emitter.config.size.start;
 
         // Colors
-        p->colorStart = emitter.config.colorStart;
-        p->colorEnd = emitter.config.colorEnd;
+        p.colorStart[i] = emitter.config.colorStart;
+        p.colorEnd[i] = emitter.config.colorEnd;
         if (emitter.config.fade) {
             // Ensure end alpha fades to 0 if fade is enabled
-            p->colorEnd.a = 0.0f;
+            p.colorEnd[i].a = 0.0f;
         }
 
         // Gravity
-        p->gravity = emitter.config.gravity;
+        p.gravity[i] = emitter.config.gravity;
     }
 }
 
-Particle* ParticleSystem::allocateParticle() {
-    // O(1) allocation from the free-list
-    if (!m_freeList.empty()) {
-        size_t idx = m_freeList.back();
-        m_freeList.pop_back();
-        return &m_particles[idx];
-    }
+bool ParticleSystem::allocateParticle(size_t& index) {
+    if (m_particles.count >= m_maxParticles) return false; // At capacity
 
-    // Free-list empty — grow pool if under limit
-    if (m_particles.size() < m_maxParticles) {
-        size_t oldSize = m_particles.size();
-        size_t newSize = std::min(m_particles.size() * 2, m_maxParticles);
+    // Grow the arrays geometrically up to the limit
+    if (m_particles.count == m_particles.capacity()) {
+        size_t newSize = std::min(std::max<size_t>(m_particles.capacity() * 2, 64), m_maxParticles);
         m_particles.resize(newSize);
-        // Add new slots (except the first one we'll return) to free-list
-        for (size_t i = oldSize + 1; i < newSize; ++i) {
-            m_freeList.push_back(i);
-        }
-        return &m_particles[oldSize];
     }
 
-    return nullptr; // At capacity
-}
-
-void ParticleSystem::freeParticle(size_t index) {
-    m_freeList.push_back(index);
+    index = m_particles.count++;
+    return true;
 }
 
 float ParticleSystem::randomRange(float min, float max) {
@@ -4,6 +4,7 @@
 #include "ecs/Systems.hpp"
 #include "rendering/IRenderer.hpp"
 #include "rendering/Camera.hpp"
+#include "engine/JobSystem.hpp"
 
 #include <string>
 #include <vector>
@@ -97,30 +98,20 @@ struct ParticleEmitterConfig {
     Vec2 offset{0.0f, 0.0f};
     float width = 0.0f;             // Emitter width (for area emitters like rain)
 
+    // Appearance
+    const Texture* texture = nullptr;   // Drawn stretched over each particle (nullptr = solid color)
+    BlendMode blend = BlendMode::Alpha;
+
     // Behavior
     bool followCamera = false;      // Emitter follows camera position
     bool worldSpace = true;         // Particles simulate in world space
 };
 
-/// A single particle in the pool
-struct Particle {
-    Vec2 position{0.0f, 0.0f};
-    Vec2 velocity{0.0f, 0.0f};
-    float lifetime = 1.0f;         // Total lifetime
-    float age = 0.0f;              // Current age
-    float size = 4.0f;             // Current size
-    ColorF colorStart;
-    ColorF colorEnd;
-    SizeCurve sizeCurve;
-    float gravity = 0.0f;
-    EmitterId emitterId = InvalidEmitterId; // Which emitter spawned this particle
-    bool alive = false;
-};
-
 /// An active emitter instance
 struct EmitterInstance {
     EmitterId id = InvalidEmitterId;
     ParticleEmitterConfig config;
+    uint32_t material = 0;          // Index into the system's texture/blend table
     Vec2 position{0.0f, 0.0f};     // World position (or camera-relative if followCamera)
     Entity entity = NullEntity;     // Attached entity (NullEntity = world position)
     float emitAccumulator = 0.0f;   // Fractional particle accumulation for continuous mode
@@ -138,8 +129,20 @@ struct EmitterInstance {
 ///   - Configurable lifetime, speed, angle, color, size curves
 ///   - Particle pool for zero-allocation emission
 ///   - Camera-following emitters (for weather effects)
+///
+/// Particles are stored as parallel arrays (one per field) kept dense:
+/// a dying particle is swapped with the last live one, so update and
+/// render only ever touch live particles. The per-particle pass is plain
+/// float loops over those arrays, which the compiler vectorizes, and pools
+/// larger than kParallelGrain are split across the engine's JobSystem.
+///
+/// Rendering fills one quad vertex stream per texture/blend combination
+/// and submits each with a single IRenderer::drawQuadBatch call.
 class ParticleSystem : public System {
 public:
+    static constexpr size_t kDefaultMaxParticles = 262144;
+    static constexpr size_t kParallelGrain = 16384;    ///< Particles per update job
+
     ParticleSystem();
     ~ParticleSystem() override = default;
 
@@ -188,23 +191,59 @@ public:
     /// Set maximum particle count (pool size limit)
     void setMaxParticles(size_t maxParticles) { m_maxParticles = maxParticles; }
 
+    /// Job system for large pools (init() uses the engine's; nullptr = serial)
+    void setJobSystem(JobSystem* jobs) { m_jobSystem = jobs; }
+
 private:
+    /// Live particles, one array per field, indices [0, count) all alive
+    struct ParticleStore {
+        size_t count = 0;
+        std::vector<float> posX, posY;
+        std::vector<float> velX, velY;
+        std::vector<float> age;
+        std::vector<float> lifetime;
+        std::vector<float> invLifetime;
+        std::vector<float> gravity;
+        std::vector<float> size;
+        std::vector<float> sizeStart, sizeEnd;
+        std::vector<ColorF> colorStart, colorEnd;   // Only read when rendering
+        std::vector<uint32_t> material;
+        std::vector<EmitterId> emitterId;
+
+        size_t capacity() const { return posX.size(); }
+        void resize(size_t n);
+        /// Move the last live particle into slot i
+        void removeSwap(size_t i);
+    };
+
+    /// Texture and blend mode shared by all particles drawn in one batch
+    struct Material {
+        const Texture* texture = nullptr;
+        BlendMode blend = BlendMode::Alpha;
+    };
+
+    /// Find or add the material for an emitter config
+    uint32_t internMaterial(const ParticleEmitterConfig& config);
+
+    /// Advance particles [begin, end) by dt
+    void integrate(size_t begin, size_t end, float dt);
+
     /// Emit particles from an emitter
     void emitParticles(EmitterInstance& emitter, int count);
 
-    /// Get or allocate a particle slot from the pool (O(1) via free-list)
-    Particle* allocateParticle();
-
-    /// Return a particle slot to the free-list
-    void freeParticle(size_t index);
+    /// Claim the next dense slot, growing the arrays if under the limit
+    /// @return false if the pool is full
+    bool allocateParticle(size_t& index);
 
     /// Random float in range
     float randomRange(float min, float max);
 
     std::vector<EmitterInstance> m_emitters;
-    std::vector<Particle> m_particles;
-    std::vector<size_t> m_freeList;          // Indices of dead particles for O(1) allocation
-    size_t m_maxParticles = 10000;
+    ParticleStore m_particles;
+    std::vector<Material> m_materials;
+    std::vector<std::vector<QuadVertex>> m_batches;    // Per material, reused each frame
+    size_t m_maxParticles = kDefaultMaxParticles;
+    JobSystem* m_jobSystem = nullptr;
     EmitterId m_nextId = 1;
     std::mt19937 m_rng{std::random_device{}()};
     std::uniform_real_distribution<float> m_dist{0.0f, 1.0f};
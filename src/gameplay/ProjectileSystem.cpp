@@ -1,11 +1,23 @@
 #include "gameplay/ProjectileSystem.hpp"
 
+#include <algorithm>
+
 namespace gloaming {
 
 void ProjectileSystem::update(float dt) {
     auto& registry = getRegistry();
 
-    std::unordered_set<Entity> toDestroy;
+    m_toDestroy.clear();
+
+    // Grid of every collider some live projectile can hit, built once for
+    // the frame instead of scanning all colliders per projectile
+    uint32_t targetLayers = 0;
+    registry.each<Projectile>([&](Entity, const Projectile& proj) {
+        if (proj.alive) targetLayers |= proj.hitMask;
+    });
+    if (targetLayers != 0) {
+        m_targets.syncColliders(registry, targetLayers);
+    }
 
     // Process all projectile entities
     auto view = registry.view<Transform, Projectile>();
@@ -14,7 +26,7 @@ void ProjectileSystem::update(float dt) {
         auto& proj = view.get<Projectile>(entity);
 
         if (!proj.alive) {
-            toDestroy.insert(entity);
+            m_toDestroy.push_back(entity);
             continue;
         }
 
@@ -22,7 +34,7 @@ void ProjectileSystem::update(float dt) {
         proj.age += dt;
         if (proj.age >= proj.lifetime) {
             proj.alive = false;
-            toDestroy.insert(entity);
+            m_toDestroy.push_back(entity);
             continue;
         }
 
@@ -33,7 +45,7 @@ void ProjectileSystem::update(float dt) {
             float dist = std::sqrt(dx * dx + dy * dy);
             if (dist >= proj.maxDistance) {
                 proj.alive = false;
-                toDestroy.insert(entity);
+                m_toDestroy.push_back(entity);
                 continue;
             }
         }
@@ -47,27 +59,28 @@ void ProjectileSystem::update(float dt) {
             m_callbacks.fireOnHit(info);
 
             proj.alive = false;
-            toDestroy.insert(entity);
+            m_toDestroy.push_back(entity);
             continue;
         }
 
         // Auto-rotate to face velocity direction
-        if (proj.autoRotate && registry.has<Velocity>(entity)) {
-            auto& vel = registry.get<Velocity>(entity);
-            if (vel.linear.x != 0.0f || vel.linear.y != 0.0f) {
-                float angle = std::atan2(vel.linear.y, vel.linear.x) * (180.0f / PI);
+        const Velocity* vel = registry.tryGet<Velocity>(entity);
+        if (proj.autoRotate && vel) {
+            if (vel->linear.x != 0.0f || vel->linear.y != 0.0f) {
+                float angle = std::atan2(vel->linear.y, vel->linear.x) * (180.0f / PI);
                 transform.rotation = angle;
             }
         }
 
-        // Check entity overlaps for damage
+        // Check entity hits along this frame's movement
         if (proj.hitMask != 0 && registry.has<Collider>(entity)) {
-            checkEntityHits(entity, transform, proj, toDestroy);
+            Vec2 motion = vel ? vel->linear * dt : Vec2(0.0f, 0.0f);
+            checkEntityHits(entity, transform, proj, motion);
         }
     }
 
     // Destroy dead projectiles
-    for (Entity entity : toDestroy) {
+    for (Entity entity : m_toDestroy) {
         m_callbacks.removeOnHit(entity);
         if (registry.valid(entity)) {
             registry.destroy(entity);
@@ -83,43 +96,57 @@ void ProjectileSystem::update(float dt) {
 }
 
 void ProjectileSystem::checkEntityHits(Entity projEntity, const Transform& projTransform,
-                                       Projectile& proj, std::unordered_set<Entity>& toDestroy) {
+                                       Projectile& proj, Vec2 motion) {
     auto& registry = getRegistry();
 
-    if (!registry.has<Collider>(projEntity)) return;
-    auto& projCollider = registry.get<Collider>(projEntity);
+    const Collider* projCollider = registry.tryGet<Collider>(projEntity);
+    if (!projCollider) return;
 
-    AABB projAABB = Collision::getEntityAABB(projTransform, projCollider);
+    // Sweep from where the projectile started this frame to where it is now
+    AABB projAABB = Collision::getEntityAABB(projTransform, *projCollider);
+    AABB startAABB = projAABB.translated(Vec2(-motion.x, -motion.y));
 
-    // Check against all entities with colliders
-    auto targetView = registry.view<Transform, Collider>();
-    for (auto targetEntity : targetView) {
-        if (targetEntity == projEntity) continue;
-
-        // Skip self and owner
-        if (static_cast<uint32_t>(targetEntity) == proj.ownerEntity) continue;
+    SpatialFilter filter;
+    filter.layerMask = proj.hitMask;
+    filter.ignore = projEntity;
+    m_targets.queryAABB(AABB::merge(startAABB, projAABB), filter, m_queryScratch);
 
-        auto& targetCollider = targetView.get<Collider>(targetEntity);
+    m_hitScratch.clear();
+    for (Entity targetEntity : m_queryScratch) {
+        // Earlier on-hit callbacks may have destroyed entities
+        if (!registry.valid(targetEntity)) continue;
 
-        // Check if the target is on a layer the projectile can hit
-        if ((targetCollider.layer & proj.hitMask) == 0) continue;
-        if (!targetCollider.enabled) continue;
+        // Skip owner
+        if (static_cast<uint32_t>(targetEntity) == proj.ownerEntity) continue;
 
         // Skip already-hit entities (for piercing projectiles)
         uint32_t targetId = static_cast<uint32_t>(targetEntity);
         if (proj.wasHit(targetId)) continue;
 
-        // AABB overlap test
-        auto& targetTransform = targetView.get<Transform>(targetEntity);
-        AABB targetAABB = Collision::getEntityAABB(targetTransform, targetCollider);
+        const Transform* targetTransform = registry.tryGet<Transform>(targetEntity);
+        const Collider* targetCollider = registry.tryGet<Collider>(targetEntity);
+        if (!targetTransform || !targetCollider || !targetCollider->enabled) continue;
+        if ((targetCollider->layer & proj.hitMask) == 0) continue;
+
+        AABB targetAABB = Collision::getEntityAABB(*targetTransform, *targetCollider);
+        SweepResult sweep = sweepAABB(startAABB, motion, targetAABB);
+        if (!sweep.hit) continue;
+
+        m_hitScratch.push_back({targetEntity, sweep.time});
+    }
+
+    // Resolve hits nearest-first so pierce spends its budget in travel order
+    std::sort(m_hitScratch.begin(), m_hitScratch.end(),
+              [](const HitCandidate& a, const HitCandidate& b) { return a.time < b.time; });
 
-        auto result = testAABBCollision(projAABB, targetAABB);
-        if (!result.collided) continue;
+    for (const HitCandidate& hit : m_hitScratch) {
+        Entity targetEntity = hit.target;
+        if (!registry.valid(targetEntity)) continue;
 
         // --- HIT ---
         // Apply damage
-        if (registry.has<Health>(targetEntity)) {
-            registry.get<Health>(targetEntity).takeDamage(proj.damage);
+        if (Health* health = registry.tryGet<Health>(targetEntity)) {
+            health->takeDamage(proj.damage);
         }
 
         // Fire on-hit callback
@@ -132,9 +159,9 @@ void ProjectileSystem::checkEntityHits(Entity projEntity, const Transform& projT
 
         // Track hit for pierce; destroy if buffer is full to prevent
         // re-damaging earlier targets on infinite-pierce projectiles
-        if (!proj.addHit(targetId)) {
+        if (!proj.addHit(static_cast<uint32_t>(targetEntity))) {
             proj.alive = false;
-            toDestroy.insert(projEntity);
+            m_toDestroy.push_back(projEntity);
             return;
         }
 
@@ -142,7 +169,7 @@ void ProjectileSystem::checkEntityHits(Entity projEntity, const Transform& projT
         // -1 = unlimited hits (until buffer fills)
         if (proj.pierce == 0) {
             proj.alive = false;
-            toDestroy.insert(projEntity);
+            m_toDestroy.push_back(projEntity);
             return; // Stop checking further targets
         } else if (proj.pierce > 0) {
             proj.pierce--;
@@ -5,11 +5,12 @@
 #include "ecs/Registry.hpp"
 #include "physics/AABB.hpp"
 #include "physics/Collision.hpp"
+#include "physics/SpatialIndex.hpp"
 
 #include <functional>
 #include <unordered_map>
-#include <unordered_set>
 #include <cmath>
+#include <vector>
 
 namespace gloaming {
 
@@ -74,9 +75,19 @@ private:
 ///   1. Ages the projectile and checks lifetime
 ///   2. Checks max travel distance
 ///   3. Auto-rotates sprite to face velocity direction
-///   4. Detects overlap with target entities (via hitMask)
+///   4. Detects hits on target entities (via hitMask)
 ///   5. Applies damage, fires on-hit callbacks, handles pierce
 ///   6. Destroys projectiles that are no longer alive
+///
+/// Hit candidates come from a grid of the colliders on any projectile's
+/// hitMask, rebuilt once per update. Each projectile is swept over the
+/// segment it moved this frame (velocity * dt back from its position), so
+/// fast projectiles can't pass through thin targets between frames;
+/// targets are hit in order along the segment, which matters for pierce.
+///
+/// Destroyed projectile entities are recycled by EnTT (IDs come back with
+/// a bumped version, so stale script handles stay invalid) and component
+/// storage keeps its capacity, so steady-state spawning doesn't allocate.
 class ProjectileSystem : public System {
 public:
     ProjectileSystem() : System("ProjectileSystem", 15) {}
@@ -95,11 +106,21 @@ public:
     void update(float dt) override;
 
 private:
+    struct HitCandidate {
+        Entity target;
+        float time;             ///< Time of impact along this frame's segment (0-1)
+    };
+
     void checkEntityHits(Entity projEntity, const Transform& projTransform,
-                         Projectile& proj, std::unordered_set<Entity>& toDestroy);
+                         Projectile& proj, Vec2 motion);
 
     ProjectileCallbackRegistry m_callbacks;
     int m_cleanupCounter = 0;
+
+    SpatialIndex m_targets;                 ///< Colliders on any live projectile's hitMask
+    std::vector<Entity> m_toDestroy;
+    std::vector<Entity> m_queryScratch;
+    std::vector<HitCandidate> m_hitScratch;
 };
 
 } // namespace gloaming
@@ -331,6 +331,10 @@ void SceneManager::executeSceneSwitch(const std::string& newScene) {
         }
     }
 
+    // The old scene's Lua state is garbage now; collect it at the end of
+    // this frame rather than mid-callback in a later one
+    m_engine->getModLoader().getLuaBindings().getGcScheduler().requestFullCollect("scene switch");
+
     LOG_INFO("Scene switched: '{}' -> '{}'", previousScene, newScene);
 }
 
@@ -107,6 +107,7 @@ void bindSceneTimerSaveAPI(sol::state& lua, Engine& engine,
                            SceneManager& sceneManager,
                            TimerSystem& timerSystem,
                            SaveSystem& saveSystem) {
+    LuaBindings& luaBindings = engine.getModLoader().getLuaBindings();
 
     // =========================================================================
     // scene API — scene/level management
@@ -116,7 +117,7 @@ void bindSceneTimerSaveAPI(sol::state& lua, Engine& engine,
     // scene.register(name, { tiles = "...", size = { width, height },
     //                        camera = { mode, x, y, zoom },
     //                        on_enter = fn, on_exit = fn })
-    sceneApi["register"] = [&sceneManager](const std::string& name, sol::table opts) {
+    sceneApi["register"] = [&luaBindings, &sceneManager](const std::string& name, sol::table opts) {
         SceneDefinition def;
         def.tilesPath = opts.get_or<std::string>("tiles", "");
         def.isOverlay = opts.get_or("overlay", false);
@@ -139,27 +140,13 @@ void bindSceneTimerSaveAPI(sol::state& lua, Engine& engine,
         }
 
         // Callbacks
-        sol::optional<sol::function> onEnter = opts.get<sol::optional<sol::function>>("on_enter");
-        if (onEnter) {
-            sol::function fn = *onEnter;
-            def.onEnter = [fn]() {
-                try { fn(); }
-                catch (const std::exception& ex) {
-                    MOD_LOG_ERROR("scene on_enter error: {}", ex.what());
-                }
-            };
-        }
+        sol::optional<sol::protected_function> onEnter =
+            opts.get<sol::optional<sol::protected_function>>("on_enter");
+        if (onEnter) def.onEnter = luaBindings.modCallback(*onEnter, "scene on_enter");
 
-        sol::optional<sol::function> onExit = opts.get<sol::optional<sol::function>>("on_exit");
-        if (onExit) {
-            sol::function fn = *onExit;
-            def.onExit = [fn]() {
-                try { fn(); }
-                catch (const std::exception& ex) {
-                    MOD_LOG_ERROR("scene on_exit error: {}", ex.what());
-                }
-            };
-        }
+        sol::optional<sol::protected_function> onExit =
+            opts.get<sol::optional<sol::protected_function>>("on_exit");
+        if (onExit) def.onExit = luaBindings.modCallback(*onExit, "scene on_exit");
 
         sceneManager.registerScene(name, std::move(def));
     };
@@ -236,25 +223,15 @@ void bindSceneTimerSaveAPI(sol::state& lua, Engine& engine,
     auto timerApi = lua.create_named_table("timer");
 
     // timer.after(seconds, callback) -> timerId
-    timerApi["after"] = [&timerSystem](float seconds, sol::function callback) -> uint32_t {
-        sol::function fn = callback;
-        return timerSystem.after(seconds, [fn]() {
-            try { fn(); }
-            catch (const std::exception& ex) {
-                MOD_LOG_ERROR("timer.after callback error: {}", ex.what());
-            }
-        });
+    timerApi["after"] = [&luaBindings, &timerSystem](float seconds,
+                                                sol::protected_function callback) -> uint32_t {
+        return timerSystem.after(seconds, luaBindings.modCallback(callback, "timer.after callback"));
     };
 
     // timer.every(seconds, callback) -> timerId
-    timerApi["every"] = [&timerSystem](float seconds, sol::function callback) -> uint32_t {
-        sol::function fn = callback;
-        return timerSystem.every(seconds, [fn]() {
-            try { fn(); }
-            catch (const std::exception& ex) {
-                MOD_LOG_ERROR("timer.every callback error: {}", ex.what());
-            }
-        });
+    timerApi["every"] = [&luaBindings, &timerSystem](float seconds,
+                                                sol::protected_function callback) -> uint32_t {
+        return timerSystem.every(seconds, luaBindings.modCallback(callback, "timer.every callback"));
     };
 
     // timer.cancel(timerId) -> bool
@@ -263,29 +240,17 @@ void bindSceneTimerSaveAPI(sol::state& lua, Engine& engine,
     };
 
     // timer.after_for(entityId, seconds, callback) -> timerId
-    timerApi["after_for"] = [&timerSystem](uint32_t entityId, float seconds,
-                                           sol::function callback) -> uint32_t {
-        Entity entity = static_cast<Entity>(entityId);
-        sol::function fn = callback;
-        return timerSystem.afterFor(entity, seconds, [fn]() {
-            try { fn(); }
-            catch (const std::exception& ex) {
-                MOD_LOG_ERROR("timer.after_for callback error: {}", ex.what());
-            }
-        });
+    timerApi["after_for"] = [&luaBindings, &timerSystem](uint32_t entityId, float seconds,
+                                                    sol::protected_function callback) -> uint32_t {
+        return timerSystem.afterFor(static_cast<Entity>(entityId), seconds,
+                                    luaBindings.modCallback(callback, "timer.after_for callback"));
     };
 
     // timer.every_for(entityId, seconds, callback) -> timerId
-    timerApi["every_for"] = [&timerSystem](uint32_t entityId, float seconds,
-                                           sol::function callback) -> uint32_t {
-        Entity entity = static_cast<Entity>(entityId);
-        sol::function fn = callback;
-        return timerSystem.everyFor(entity, seconds, [fn]() {
-            try { fn(); }
-            catch (const std::exception& ex) {
-                MOD_LOG_ERROR("timer.every_for callback error: {}", ex.what());
-            }
-        });
+    timerApi["every_for"] = [&luaBindings, &timerSystem](uint32_t entityId, float seconds,
+                                                    sol::protected_function callback) -> uint32_t {
+        return timerSystem.everyFor(static_cast<Entity>(entityId), seconds,
+                                    luaBindings.modCallback(callback, "timer.every_for callback"));
     };
 
     // timer.active_count() -> int
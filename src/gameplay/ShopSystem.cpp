@@ -2,11 +2,24 @@
 #include "mod/EventBus.hpp"
 #include "engine/Log.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace gloaming {
 
-TradeResult ShopManager::buyItem(const std::string& shopId, const std::string& itemId,
+namespace {
+
+// Event names and payload keys, interned once so emit sites never hash strings
+const EventId  kShopBuyEvent  = EventNames::intern("shop_buy");
+const EventId  kShopSellEvent = EventNames::intern("shop_sell");
+const EventKey kKeyShopId     = EventNames::intern("shop_id");
+const EventKey kKeyItemId     = EventNames::intern("item_id");
+const EventKey kKeyCount      = EventNames::intern("count");
+const EventKey kKeyPrice      = EventNames::intern("price");
+
+} // namespace
+
+TradeResult ShopManager::buyItem(ContentRuntimeId shopId, const std::string& itemId,
                                   int count, Inventory& playerInventory) {
     TradeResult result;
 
@@ -20,25 +33,26 @@ TradeResult ShopManager::buyItem(const std::string& shopId, const std::string& i
         return result;
     }
 
-    const ShopDefinition* shop = m_contentRegistry->getShop(shopId);
+    const ShopDefinition* shop = m_contentRegistry->getShopByRuntime(shopId);
     if (!shop) {
         result.failReason = "shop not found";
         return result;
     }
 
-    const ShopItemEntry* entry = findShopItem(*shop, itemId);
-    if (!entry) {
+    int entryIndex = findShopItem(*shop, itemId);
+    if (entryIndex < 0) {
         result.failReason = "item not sold here";
         return result;
     }
+    const ShopItemEntry& entry = shop->items[entryIndex];
 
-    if (!entry->available) {
+    if (!entry.available) {
         result.failReason = "item not available";
         return result;
     }
 
     // Check runtime stock
-    int remaining = initStock(shopId, itemId, entry->stock);
+    int remaining = initStock(*shop, entryIndex);
     if (remaining == 0) {
         result.failReason = "out of stock";
         return result;
@@ -50,7 +64,7 @@ TradeResult ShopManager::buyItem(const std::string& shopId, const std::string& i
         buyCount = std::min(buyCount, remaining);
     }
 
-    int totalPrice = static_cast<int>(std::ceil(entry->buyPrice * buyCount * shop->buyMultiplier));
+    int totalPrice = static_cast<int>(std::ceil(entry.buyPrice * buyCount * shop->buyMultiplier));
     result.finalPrice = totalPrice;
 
     // Check player has enough currency
@@ -75,7 +89,7 @@ TradeResult ShopManager::buyItem(const std::string& shopId, const std::string& i
 
     // If partial add, refund the difference
     if (actualBought < buyCount) {
-        int actualPrice = static_cast<int>(std::ceil(entry->buyPrice * actualBought * shop->buyMultiplier));
+        int actualPrice = static_cast<int>(std::ceil(entry.buyPrice * actualBought * shop->buyMultiplier));
         int refund = totalPrice - actualPrice;
         if (refund > 0) {
             playerInventory.addItem(shop->currencyItem, refund);
@@ -84,25 +98,25 @@ TradeResult ShopManager::buyItem(const std::string& shopId, const std::string& i
     }
 
     // Decrement runtime stock
-    decrementStock(shopId, itemId, actualBought);
+    decrementStock(*shop, entryIndex, actualBought);
 
     result.finalPrice = totalPrice;
 
     // Emit event
     if (m_eventBus) {
         EventData data;
-        data.setString("shop_id", shopId);
-        data.setString("item_id", itemId);
-        data.setInt("count", actualBought);
-        data.setInt("price", totalPrice);
-        m_eventBus->emit("shop_buy", data);
+        data.setString(kKeyShopId, shop->qualifiedId);
+        data.setString(kKeyItemId, itemId);
+        data.setInt(kKeyCount, actualBought);
+        data.setInt(kKeyPrice, totalPrice);
+        m_eventBus->emit(kShopBuyEvent, data);
     }
 
     result.success = true;
     return result;
 }
 
-TradeResult ShopManager::sellItem(const std::string& shopId, const std::string& itemId,
+TradeResult ShopManager::sellItem(ContentRuntimeId shopId, const std::string& itemId,
                                    int count, Inventory& playerInventory) {
     TradeResult result;
 
@@ -116,7 +130,7 @@ TradeResult ShopManager::sellItem(const std::string& shopId, const std::string&
         return result;
     }
 
-    const ShopDefinition* shop = m_contentRegistry->getShop(shopId);
+    const ShopDefinition* shop = m_contentRegistry->getShopByRuntime(shopId);
     if (!shop) {
         result.failReason = "shop not found";
         return result;
@@ -133,9 +147,9 @@ TradeResult ShopManager::sellItem(const std::string& shopId, const std::string&
 
     // Calculate sell price — use shop entry if available, otherwise use item definition
     int unitPrice = 0;
-    const ShopItemEntry* entry = findShopItem(*shop, itemId);
-    if (entry) {
-        unitPrice = entry->sellPrice;
+    int entryIndex = findShopItem(*shop, itemId);
+    if (entryIndex >= 0) {
+        unitPrice = shop->items[entryIndex].sellPrice;
     } else {
         // Fall back to item definition sell value
         const ItemDefinition* itemDef = m_contentRegistry->getItem(itemId);
@@ -158,38 +172,34 @@ TradeResult ShopManager::sellItem(const std::string& shopId, const std::string&
     // Emit event
     if (m_eventBus) {
         EventData data;
-        data.setString("shop_id", shopId);
-        data.setString("item_id", itemId);
-        data.setInt("count", actualSold);
-        data.setInt("price", totalPrice);
-        m_eventBus->emit("shop_sell", data);
+        data.setString(kKeyShopId, shop->qualifiedId);
+        data.setString(kKeyItemId, itemId);
+        data.setInt(kKeyCount, actualSold);
+        data.setInt(kKeyPrice, totalPrice);
+        m_eventBus->emit(kShopSellEvent, data);
     }
 
     result.success = true;
     return result;
 }
 
-int ShopManager::getBuyPrice(const std::string& shopId, const std::string& itemId) const {
-    if (!m_contentRegistry) return 0;
-
-    const ShopDefinition* shop = m_contentRegistry->getShop(shopId);
+int ShopManager::getBuyPrice(ContentRuntimeId shopId, const std::string& itemId) const {
+    const ShopDefinition* shop = getShop(shopId);
     if (!shop) return 0;
 
-    const ShopItemEntry* entry = findShopItem(*shop, itemId);
-    if (!entry) return 0;
+    int entryIndex = findShopItem(*shop, itemId);
+    if (entryIndex < 0) return 0;
 
-    return static_cast<int>(std::ceil(entry->buyPrice * shop->buyMultiplier));
+    return static_cast<int>(std::ceil(shop->items[entryIndex].buyPrice * shop->buyMultiplier));
 }
 
-int ShopManager::getSellPrice(const std::string& shopId, const std::string& itemId) const {
-    if (!m_contentRegistry) return 0;
-
-    const ShopDefinition* shop = m_contentRegistry->getShop(shopId);
+int ShopManager::getSellPrice(ContentRuntimeId shopId, const std::string& itemId) const {
+    const ShopDefinition* shop = getShop(shopId);
     if (!shop) return 0;
 
-    const ShopItemEntry* entry = findShopItem(*shop, itemId);
-    if (entry) {
-        return static_cast<int>(std::floor(entry->sellPrice * shop->sellMultiplier));
+    int entryIndex = findShopItem(*shop, itemId);
+    if (entryIndex >= 0) {
+        return static_cast<int>(std::floor(shop->items[entryIndex].sellPrice * shop->sellMultiplier));
     }
 
     // Fall back to item definition
@@ -201,53 +211,60 @@ int ShopManager::getSellPrice(const std::string& shopId, const std::string& item
     return 0;
 }
 
-const ShopDefinition* ShopManager::getShop(const std::string& shopId) const {
+const ShopDefinition* ShopManager::getShop(ContentRuntimeId shopId) const {
     if (!m_contentRegistry) return nullptr;
-    return m_contentRegistry->getShop(shopId);
+    return m_contentRegistry->getShopByRuntime(shopId);
+}
+
+int ShopManager::getRemainingStock(ContentRuntimeId shopId, const std::string& itemId) const {
+    const ShopDefinition* shop = getShop(shopId);
+    if (!shop) return -1;
+    int entryIndex = findShopItem(*shop, itemId);
+    if (entryIndex < 0) return -1;
+
+    // Not yet tracked — return defined stock
+    int definedStock = shop->items[entryIndex].stock;
+    if (shopId > m_runtimeStock.size()) return definedStock;
+    const std::vector<int>& slots = m_runtimeStock[shopId - 1];
+    if (slots.size() != shop->items.size() || slots[entryIndex] == kUntracked) {
+        return definedStock;
+    }
+    return slots[entryIndex];
 }
 
-int ShopManager::getRemainingStock(const std::string& shopId, const std::string& itemId) const {
-    auto shopIt = m_runtimeStock.find(shopId);
-    if (shopIt == m_runtimeStock.end()) {
-        // Not yet tracked — return defined stock
-        if (!m_contentRegistry) return -1;
-        const ShopDefinition* shop = m_contentRegistry->getShop(shopId);
-        if (!shop) return -1;
-        const ShopItemEntry* entry = findShopItem(*shop, itemId);
-        return entry ? entry->stock : -1;
-    }
-    auto itemIt = shopIt->second.find(itemId);
-    if (itemIt == shopIt->second.end()) return -1;
-    return itemIt->second;
+int ShopManager::findShopItem(const ShopDefinition& shop, const std::string& itemId) const {
+    for (size_t i = 0; i < shop.items.size(); ++i) {
+        if (shop.items[i].itemId == itemId) return static_cast<int>(i);
+    }
+    return -1;
 }
 
-const ShopItemEntry* ShopManager::findShopItem(const ShopDefinition& shop,
-                                                const std::string& itemId) const {
-    for (const auto& entry : shop.items) {
-        if (entry.itemId == itemId) return &entry;
+std::vector<int>& ShopManager::stockSlots(const ShopDefinition& shop) {
+    if (shop.runtimeId > m_runtimeStock.size()) {
+        m_runtimeStock.resize(shop.runtimeId);
+    }
+    std::vector<int>& slots = m_runtimeStock[shop.runtimeId - 1];
+    if (slots.size() != shop.items.size()) {
+        slots.assign(shop.items.size(), kUntracked);
     }
-    return nullptr;
+    return slots;
 }
 
-int ShopManager::initStock(const std::string& shopId, const std::string& itemId, int definedStock) {
+int ShopManager::initStock(const ShopDefinition& shop, int entryIndex) {
+    int definedStock = shop.items[entryIndex].stock;
     if (definedStock < 0) return -1; // infinite
 
-    auto& shopStock = m_runtimeStock[shopId];
-    auto it = shopStock.find(itemId);
-    if (it == shopStock.end()) {
-        shopStock[itemId] = definedStock;
-        return definedStock;
+    int& slot = stockSlots(shop)[entryIndex];
+    if (slot == kUntracked) {
+        slot = definedStock;
     }
-    return it->second;
+    return slot;
 }
 
-void ShopManager::decrementStock(const std::string& shopId, const std::string& itemId, int amount) {
-    auto shopIt = m_runtimeStock.find(shopId);
-    if (shopIt == m_runtimeStock.end()) return;
-    auto itemIt = shopIt->second.find(itemId);
-    if (itemIt == shopIt->second.end()) return;
-    if (itemIt->second < 0) return; // infinite stock
-    itemIt->second = std::max(0, itemIt->second - amount);
+void ShopManager::decrementStock(const ShopDefinition& shop, int entryIndex, int amount) {
+    int& slot = stockSlots(shop)[entryIndex];
+    if (slot < 0) return; // infinite or untracked stock
+    slot = std::max(0, slot - amount);
 }
 
 } // namespace gloaming
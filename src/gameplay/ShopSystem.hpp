@@ -3,8 +3,9 @@
 #include "gameplay/GameplayLoop.hpp"
 #include "mod/ContentRegistry.hpp"
 
+#include <climits>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace gloaming {
 
@@ -21,6 +22,10 @@ struct TradeResult {
 /// Utility class managing shop buy/sell operations.
 /// Not a per-frame System — called on demand from Lua or UI events.
 /// Follows the CraftingManager pattern (Stage 13).
+///
+/// Shops are addressed by ContentRegistry runtime ID; the string overloads
+/// resolve the qualified ID once and forward. Items stay qualified strings
+/// because Inventory is keyed by them.
 class ShopManager {
 public:
     ShopManager() = default;
@@ -28,44 +33,76 @@ public:
     void setContentRegistry(ContentRegistry* registry) { m_contentRegistry = registry; }
     void setEventBus(EventBus* bus) { m_eventBus = bus; }
 
+    /// Runtime ID of a shop (0 if unknown or no registry is set).
+    ContentRuntimeId resolveShop(const std::string& shopId) const {
+        return m_contentRegistry ? m_contentRegistry->getShopRuntimeId(shopId) : 0;
+    }
+
     /// Buy item from shop into player inventory.
     /// Currency is deducted as an inventory item (e.g. "base:coins").
-    TradeResult buyItem(const std::string& shopId, const std::string& itemId,
+    TradeResult buyItem(ContentRuntimeId shopId, const std::string& itemId,
                         int count, Inventory& playerInventory);
+    TradeResult buyItem(const std::string& shopId, const std::string& itemId,
+                        int count, Inventory& playerInventory) {
+        return buyItem(resolveShop(shopId), itemId, count, playerInventory);
+    }
 
     /// Sell item from player inventory to shop.
     /// Currency is added as an inventory item.
-    TradeResult sellItem(const std::string& shopId, const std::string& itemId,
+    TradeResult sellItem(ContentRuntimeId shopId, const std::string& itemId,
                          int count, Inventory& playerInventory);
+    TradeResult sellItem(const std::string& shopId, const std::string& itemId,
+                         int count, Inventory& playerInventory) {
+        return sellItem(resolveShop(shopId), itemId, count, playerInventory);
+    }
 
     /// Get buy price for an item in a shop (includes multiplier).
-    int getBuyPrice(const std::string& shopId, const std::string& itemId) const;
+    int getBuyPrice(ContentRuntimeId shopId, const std::string& itemId) const;
+    int getBuyPrice(const std::string& shopId, const std::string& itemId) const {
+        return getBuyPrice(resolveShop(shopId), itemId);
+    }
 
     /// Get sell price for an item in a shop (includes multiplier).
-    int getSellPrice(const std::string& shopId, const std::string& itemId) const;
+    int getSellPrice(ContentRuntimeId shopId, const std::string& itemId) const;
+    int getSellPrice(const std::string& shopId, const std::string& itemId) const {
+        return getSellPrice(resolveShop(shopId), itemId);
+    }
 
     /// Get the shop definition (or nullptr if not found).
-    const ShopDefinition* getShop(const std::string& shopId) const;
+    const ShopDefinition* getShop(ContentRuntimeId shopId) const;
+    const ShopDefinition* getShop(const std::string& shopId) const {
+        return getShop(resolveShop(shopId));
+    }
 
     /// Get remaining stock for a specific item (-1 = infinite, 0 = out of stock).
-    int getRemainingStock(const std::string& shopId, const std::string& itemId) const;
+    int getRemainingStock(ContentRuntimeId shopId, const std::string& itemId) const;
+    int getRemainingStock(const std::string& shopId, const std::string& itemId) const {
+        return getRemainingStock(resolveShop(shopId), itemId);
+    }
 
 private:
-    const ShopItemEntry* findShopItem(const ShopDefinition& shop,
-                                       const std::string& itemId) const;
+    /// Marks a stock slot whose item hasn't been bought yet
+    static constexpr int kUntracked = INT_MIN;
+
+    /// Index of `itemId` in the shop's item list, or -1.
+    int findShopItem(const ShopDefinition& shop, const std::string& itemId) const;
+
+    /// Stock slots for a shop, one per item entry. Reset if the shop was
+    /// re-registered with a different number of items.
+    std::vector<int>& stockSlots(const ShopDefinition& shop);
 
     /// Initialize runtime stock from definition if not yet tracked.
-    int initStock(const std::string& shopId, const std::string& itemId, int definedStock);
+    int initStock(const ShopDefinition& shop, int entryIndex);
 
     /// Decrement runtime stock after a purchase.
-    void decrementStock(const std::string& shopId, const std::string& itemId, int amount);
+    void decrementStock(const ShopDefinition& shop, int entryIndex, int amount);
 
     ContentRegistry* m_contentRegistry = nullptr;
     EventBus* m_eventBus = nullptr;
 
     /// Runtime stock tracking, separate from immutable ShopDefinition.
-    /// Maps shopId -> (itemId -> remainingStock). -1 means infinite.
-    std::unordered_map<std::string, std::unordered_map<std::string, int>> m_runtimeStock;
+    /// Indexed by shop runtime ID - 1, then by item entry; -1 means infinite.
+    std::vector<std::vector<int>> m_runtimeStock;
 };
 
 } // namespace gloaming
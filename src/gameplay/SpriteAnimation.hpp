@@ -74,9 +74,11 @@ struct AnimationController {
     /// @param frameHeight Height of one frame in pixels
     /// @param fps         Playback speed
     /// @param mode        Playback mode
+    /// @param sheetOrigin Top-left of the sheet in its texture (atlas region)
     void addClipFromSheet(const std::string& name, int row, int frameCount,
                           int frameWidth, int frameHeight, float fps,
-                          PlaybackMode mode = PlaybackMode::Loop) {
+                          PlaybackMode mode = PlaybackMode::Loop,
+                          Vec2 sheetOrigin = Vec2(0.0f, 0.0f)) {
         AnimationClip clip;
         clip.fps = fps;
         clip.mode = mode;
@@ -84,8 +86,8 @@ struct AnimationController {
 
         for (int i = 0; i < frameCount; ++i) {
             clip.frames.push_back(Rect(
-                static_cast<float>(i * frameWidth),
-                static_cast<float>(row * frameHeight),
+                sheetOrigin.x + static_cast<float>(i * frameWidth),
+                sheetOrigin.y + static_cast<float>(row * frameHeight),
                 static_cast<float>(frameWidth),
                 static_cast<float>(frameHeight)
             ));
@@ -93,6 +95,26 @@ struct AnimationController {
         clips[name] = std::move(clip);
     }
 
+    /// Build a clip from the sheet a Sprite draws from. Frame sizes <= 0 are
+    /// derived from the sheet: width = sheet width / frameCount, height =
+    /// width (square frames). Returns false if no size can be determined.
+    bool addClipFromSprite(const std::string& name, const Sprite& sprite, int row,
+                           int frameCount, int frameWidth, int frameHeight, float fps,
+                           PlaybackMode mode = PlaybackMode::Loop) {
+        Rect sheet = sprite.sheetBounds();
+        if (frameWidth <= 0 && frameCount > 0) {
+            frameWidth = static_cast<int>(sheet.width) / frameCount;
+        }
+        if (frameHeight <= 0) {
+            frameHeight = frameWidth > 0 ? frameWidth : static_cast<int>(sheet.height);
+        }
+        if (frameWidth <= 0 || frameHeight <= 0) return false;
+
+        addClipFromSheet(name, row, frameCount, frameWidth, frameHeight, fps, mode,
+                         Vec2(sheet.x, sheet.y));
+        return true;
+    }
+
     /// Start playing a clip by name. If the clip is already playing and not
     /// finished, this is a no-op (call stop() first to restart).
     /// @return true if the clip exists and playback started
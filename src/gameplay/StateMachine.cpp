@@ -0,0 +1,244 @@
+#include "gameplay/StateMachine.hpp"
+
+namespace gloaming {
+
+// =============================================================================
+// FSMDefinition
+// =============================================================================
+
+FSMStateId FSMDefinition::addState(const std::string& name, StateCallbacks callbacks,
+                                   FSMBatchUpdate onUpdateBatch) {
+    FSMStateId id = findState(name);
+    if (id == kNoFSMState) {
+        if (m_states.size() >= kNoFSMState) return kNoFSMState;
+        id = static_cast<FSMStateId>(m_states.size());
+        m_states.push_back({});
+        m_states.back().name = name;
+    }
+
+    ++m_revision;
+    auto& state = m_states[id];
+    state.callbacks = std::move(callbacks);
+    state.onUpdateBatch = std::move(onUpdateBatch);
+    return id;
+}
+
+bool FSMDefinition::addTransition(const std::string& from, const std::string& to,
+                                  FSMCondition condition) {
+    FSMStateId fromId = findState(from);
+    FSMStateId toId = findState(to);
+    if (fromId == kNoFSMState || toId == kNoFSMState) return false;
+
+    ++m_revision;
+    m_states[fromId].transitions.push_back({toId, std::move(condition)});
+    return true;
+}
+
+void FSMDefinition::clearTransitions() {
+    ++m_revision;
+    for (auto& state : m_states) {
+        state.transitions.clear();
+    }
+}
+
+FSMStateId FSMDefinition::findState(std::string_view name) const {
+    // Definitions have a handful of states; a linear scan beats hashing
+    for (size_t i = 0; i < m_states.size(); ++i) {
+        if (m_states[i].name == name) return static_cast<FSMStateId>(i);
+    }
+    return kNoFSMState;
+}
+
+bool FSMDefinition::canTransition(FSMStateId from, FSMStateId to) const {
+    if (to >= m_states.size()) return false;
+    if (from >= m_states.size()) return true;   // Entering the first state
+
+    const auto& transitions = m_states[from].transitions;
+    if (transitions.empty()) return true;
+    for (const auto& t : transitions) {
+        if (t.to == to) return true;
+    }
+    return false;
+}
+
+// =============================================================================
+// StateMachineSystem — shared definitions
+// =============================================================================
+
+FSMDefinition& StateMachineSystem::define(const std::string& name) {
+    auto it = m_definitionIds.find(name);
+    if (it != m_definitionIds.end()) return m_definitions[it->second];
+
+    auto id = static_cast<FSMDefinitionId>(m_definitions.size());
+    m_definitions.emplace_back(name);
+    m_definitionIds.emplace(name, id);
+    return m_definitions.back();
+}
+
+void StateMachineSystem::redefine(const std::string& name,
+                                  std::function<void(FSMDefinition&)> edit) {
+    if (isDispatching()) {
+        m_deferredEdits.emplace_back(name, std::move(edit));
+        return;
+    }
+    edit(define(name));
+}
+
+void StateMachineSystem::applyDeferredEdits() {
+    // Called at depth 0, so nothing below defers again
+    auto edits = std::move(m_deferredEdits);
+    m_deferredEdits.clear();
+    for (auto& [name, edit] : edits) edit(define(name));
+}
+
+FSMDefinitionId StateMachineSystem::findDefinition(std::string_view name) const {
+    auto it = m_definitionIds.find(std::string(name));
+    return it != m_definitionIds.end() ? it->second : kInvalidFSMDefinition;
+}
+
+bool StateMachineSystem::start(FSMInstance& fsm, Entity entity, FSMDefinitionId definition,
+                               FSMStateId initial) {
+    const FSMDefinition* def = getDefinition(definition);
+    if (!def) return false;
+
+    if (initial == kNoFSMState) initial = def->getInitialState();
+    fsm = FSMInstance{};
+    fsm.definition = definition;
+    if (initial == kNoFSMState) return true;   // No states yet
+    return setState(fsm, entity, initial);
+}
+
+bool StateMachineSystem::setState(FSMInstance& fsm, Entity entity, FSMStateId newState) {
+    const FSMDefinition* def = getDefinition(fsm.definition);
+    if (!def || newState == fsm.currentState) return false;
+    if (!def->canTransition(fsm.currentState, newState)) return false;
+
+    DispatchScope dispatch(*this);
+
+    // Exit current state
+    if (const FSMStateDef* old = def->getState(fsm.currentState)) {
+        if (old->callbacks.onExit) old->callbacks.onExit(entity);
+    }
+
+    // Transition
+    fsm.previousState = fsm.currentState;
+    fsm.currentState = newState;
+    fsm.timeInState = 0.0f;
+
+    // Enter new state
+    const FSMStateDef* entered = def->getState(newState);
+    if (entered->callbacks.onEnter) entered->callbacks.onEnter(entity);
+    return true;
+}
+
+bool StateMachineSystem::setState(FSMInstance& fsm, Entity entity, std::string_view newState) {
+    const FSMDefinition* def = getDefinition(fsm.definition);
+    if (!def) return false;
+    return setState(fsm, entity, def->findState(newState));
+}
+
+const std::string& StateMachineSystem::getStateName(const FSMInstance& fsm) const {
+    static const std::string kEmpty;
+    const FSMDefinition* def = getDefinition(fsm.definition);
+    const FSMStateDef* state = def ? def->getState(fsm.currentState) : nullptr;
+    return state ? state->name : kEmpty;
+}
+
+void StateMachineSystem::updateShared(Registry& registry, float dt) {
+    DispatchScope dispatch(*this);
+
+    // Bucket entities by definition and current state. The buckets keep
+    // their capacity, so steady-state frames do not allocate.
+    if (m_groups.size() < m_definitions.size()) m_groups.resize(m_definitions.size());
+    for (size_t d = 0; d < m_definitions.size(); ++d) {
+        auto& byState = m_groups[d];
+        if (byState.size() < m_definitions[d].stateCount()) {
+            byState.resize(m_definitions[d].stateCount());
+        }
+        for (auto& group : byState) group.clear();
+    }
+
+    registry.each<FSMInstance>([this](Entity entity, FSMInstance& fsm) {
+        if (fsm.definition >= m_groups.size()) return;
+        auto& byState = m_groups[fsm.definition];
+        if (fsm.currentState >= byState.size()) return;
+        byState[fsm.currentState].push_back(entity);
+    });
+
+    // Dispatch. Definitions registered by a callback during dispatch have no
+    // group yet and start next frame.
+    const size_t definitionCount = m_groups.size();
+    for (size_t d = 0; d < definitionCount; ++d) {
+        const size_t stateCount = m_groups[d].size();
+        for (size_t s = 0; s < stateCount; ++s) {
+            if (m_groups[d][s].empty()) continue;
+            runGroup(registry, static_cast<FSMDefinitionId>(d), static_cast<FSMStateId>(s),
+                     m_groups[d][s], dt);
+        }
+    }
+}
+
+void StateMachineSystem::runGroup(Registry& registry, FSMDefinitionId definition,
+                                  FSMStateId stateId, const std::vector<Entity>& entities,
+                                  float dt) {
+    // Callbacks may change states, add or remove components, or destroy
+    // entities, so every per-entity step re-checks the instance.
+    auto current = [&](Entity entity) -> FSMInstance* {
+        if (!registry.valid(entity)) return nullptr;
+        FSMInstance* fsm = registry.tryGet<FSMInstance>(entity);
+        if (!fsm || fsm->definition != definition || fsm->currentState != stateId) return nullptr;
+        return fsm;
+    };
+
+    // Run the callbacks in place. redefine() holds back edits until the
+    // dispatch ends; the revision check picks up direct edits (new states,
+    // transitions) before the next callback reads the state again.
+    const FSMDefinition& def = m_definitions[definition];
+    const FSMStateDef* state = def.getState(stateId);
+    uint32_t revision = def.revision();
+    auto refresh = [&] {
+        if (def.revision() == revision) return;
+        revision = def.revision();
+        state = def.getState(stateId);
+    };
+
+    if (state->onUpdateBatch) {
+        state->onUpdateBatch(std::span<const Entity>(entities), dt);
+        refresh();
+    } else if (state->callbacks.onUpdate) {
+        for (Entity entity : entities) {
+            if (!current(entity) || !state->callbacks.onUpdate) continue;
+            state->callbacks.onUpdate(entity, dt);
+            refresh();
+        }
+    }
+
+    for (Entity entity : entities) {
+        FSMInstance* fsm = current(entity);
+        if (!fsm) continue;
+        fsm->timeInState += dt;
+
+        for (size_t i = 0; i < state->transitions.size(); ++i) {
+            const FSMTransition& transition = state->transitions[i];
+            if (!transition.condition) continue;
+            // A condition may add or remove components and so move this
+            // entity's FSMInstance; re-fetch before every call
+            fsm = current(entity);
+            if (!fsm) break;
+            const FSMStateId to = transition.to;
+            bool fire = transition.condition(entity, fsm->timeInState);
+            refresh();
+            if (!fire) continue;
+            if (FSMInstance* live = current(entity)) setState(*live, entity, to);
+            refresh();
+            break;
+        }
+    }
+}
+
+size_t StateMachineSystem::lastGroupSize(FSMDefinitionId definition, FSMStateId state) const {
+    if (definition >= m_groups.size() || state >= m_groups[definition].size()) return 0;
+    return m_groups[definition][state].size();
+}
+
+} // namespace gloaming
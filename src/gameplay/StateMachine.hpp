@@ -3,9 +3,15 @@
 #include "ecs/Systems.hpp"
 #include "ecs/Components.hpp"
 
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
-#include <functional>
+#include <utility>
+#include <vector>
 
 namespace gloaming {
 
@@ -23,12 +29,12 @@ struct StateCallbacks {
 /// Note on scaling: This component stores std::function callbacks and a string map,
 /// which makes it heavier than typical ECS components. This is acceptable for
 /// moderate numbers of AI entities (dozens to low hundreds). For games with thousands
-/// of stateful entities, consider a shared FSM definition table that entities
-/// reference by ID instead of storing callbacks per-entity.
+/// of stateful entities, register an FSMDefinition once and give entities an
+/// FSMInstance instead (see below).
 ///
 /// Transition guards (e.g., "can only transition from X to Y") are not built in.
 /// Transitions are purely imperative via setState(). Implement guards in your
-/// onUpdate callbacks if needed.
+/// onUpdate callbacks if needed, or use an FSMDefinition's transition table.
 ///
 /// Usage example (from Lua):
 ///   -- Define states for an NPC
@@ -61,8 +67,115 @@ struct StateMachine {
     float getStateTime() const { return stateTime; }
 };
 
-/// System that updates all entities with StateMachine components.
+// =============================================================================
+// Shared FSM definitions
+// =============================================================================
+
+using FSMDefinitionId = uint32_t;
+using FSMStateId = uint16_t;
+
+constexpr FSMDefinitionId kInvalidFSMDefinition = 0xFFFFFFFFu;
+constexpr FSMStateId kNoFSMState = 0xFFFF;
+
+/// Update callback for every entity in one state of one definition, called
+/// once per frame with all of them instead of once per entity.
+using FSMBatchUpdate = std::function<void(std::span<const Entity>, float)>;
+
+/// Automatic transition condition: (entity, time in current state) -> fire?
+using FSMCondition = std::function<bool(Entity, float)>;
+
+/// An edge in a definition's transition table.
+struct FSMTransition {
+    FSMStateId to = kNoFSMState;
+    FSMCondition condition;    ///< Optional; when set, checked every frame
+};
+
+/// One state of an FSMDefinition.
+struct FSMStateDef {
+    std::string name;
+    StateCallbacks callbacks;
+    FSMBatchUpdate onUpdateBatch;   ///< Preferred over callbacks.onUpdate when set
+    std::vector<FSMTransition> transitions;
+};
+
+/// A state machine registered once and shared by every entity that uses it.
+/// States get dense integer IDs in the order they are added.
+///
+/// The transition table is optional. A state with no transitions can move to
+/// any state; once a state lists transitions, setState() only allows those
+/// targets. Transitions with a condition also fire on their own: after the
+/// state's update, the first transition whose condition returns true is taken.
+///
+/// Every edit bumps revision(), so code holding a reference into the state
+/// table can tell it changed. Adding states never moves existing ones, but
+/// editing a state's callbacks or transitions may destroy or move callables
+/// that are running: from inside a callback of the same system, make those
+/// edits through StateMachineSystem::redefine().
+class FSMDefinition {
+public:
+    explicit FSMDefinition(std::string name) : m_name(std::move(name)) {}
+
+    const std::string& getName() const { return m_name; }
+
+    /// Add a state, or replace the callbacks of an existing one (its ID and
+    /// transitions are kept). Returns the state's ID.
+    FSMStateId addState(const std::string& name, StateCallbacks callbacks = {},
+                        FSMBatchUpdate onUpdateBatch = {});
+
+    /// Allow from -> to, optionally firing automatically when `condition`
+    /// holds. Returns false if either state is unknown.
+    bool addTransition(const std::string& from, const std::string& to,
+                       FSMCondition condition = {});
+
+    /// Drop every transition (states and their IDs are kept).
+    void clearTransitions();
+
+    /// Bumped by every addState/addTransition/clearTransitions.
+    uint32_t revision() const { return m_revision; }
+
+    /// State ID for a name (kNoFSMState if unknown).
+    FSMStateId findState(std::string_view name) const;
+
+    /// State data for an ID (nullptr if out of range).
+    const FSMStateDef* getState(FSMStateId id) const {
+        return id < m_states.size() ? &m_states[id] : nullptr;
+    }
+
+    size_t stateCount() const { return m_states.size(); }
+
+    /// Whether setState() may move from `from` to `to`.
+    bool canTransition(FSMStateId from, FSMStateId to) const;
+
+    /// State entered by StateMachineSystem::start(); defaults to the first state.
+    void setInitialState(FSMStateId id) { m_initialState = id; }
+    FSMStateId getInitialState() const {
+        if (m_initialState < m_states.size()) return m_initialState;
+        return m_states.empty() ? kNoFSMState : 0;
+    }
+
+private:
+    std::string m_name;
+    std::deque<FSMStateDef> m_states;   // deque: adding a state never moves the others
+    FSMStateId m_initialState = kNoFSMState;
+    uint32_t m_revision = 0;
+};
+
+/// Per-entity state for a shared FSMDefinition. Plain data, no callbacks.
+struct FSMInstance {
+    FSMDefinitionId definition = kInvalidFSMDefinition;
+    FSMStateId currentState = kNoFSMState;
+    FSMStateId previousState = kNoFSMState;
+    float timeInState = 0.0f;
+};
+
+/// System that updates all entities with StateMachine or FSMInstance components.
 /// Handles state transitions and calls state callbacks.
+///
+/// FSMInstance entities are grouped by (definition, state) each frame, and
+/// each group is dispatched together: one onUpdateBatch call for the whole
+/// group, or onUpdate per entity when the state has no batch callback.
+/// Dispatch runs callbacks straight out of the definitions, without copying
+/// them; redefine() holds back edits until no callback is running.
 class StateMachineSystem : public System {
 public:
     StateMachineSystem() : System("StateMachineSystem", 5) {}
@@ -79,7 +192,55 @@ public:
                 fsm.stateTime += dt;
             }
         );
+        updateShared(getRegistry(), dt);
+    }
+
+    // ---- Shared definitions ----
+
+    /// Register a definition by name, or return the existing one so it can be
+    /// redefined (e.g. on mod hot-reload). IDs are stable for the process.
+    FSMDefinition& define(const std::string& name);
+
+    /// Apply `edit` to the named definition (creating it if needed) now, or,
+    /// when called from inside one of this system's callbacks, once the
+    /// outermost dispatch returns. Use this for edits that may come from a
+    /// callback: changing a definition mid-dispatch would destroy the
+    /// callable that is running.
+    void redefine(const std::string& name, std::function<void(FSMDefinition&)> edit);
+
+    /// True while update() or setState() is running state callbacks.
+    bool isDispatching() const { return m_dispatchDepth > 0; }
+
+    /// Definition lookup (nullptr if unknown).
+    FSMDefinition* getDefinition(FSMDefinitionId id) {
+        return id < m_definitions.size() ? &m_definitions[id] : nullptr;
+    }
+    const FSMDefinition* getDefinition(FSMDefinitionId id) const {
+        return id < m_definitions.size() ? &m_definitions[id] : nullptr;
     }
+    FSMDefinitionId findDefinition(std::string_view name) const;
+    size_t definitionCount() const { return m_definitions.size(); }
+
+    /// Point an instance at a definition and enter `initial` (the definition's
+    /// initial state if kNoFSMState). Returns false for unknown IDs.
+    bool start(FSMInstance& fsm, Entity entity, FSMDefinitionId definition,
+               FSMStateId initial = kNoFSMState);
+
+    /// Transition an instance, honoring its definition's transition table.
+    /// Calls onExit on the old state and onEnter on the new one. Returns
+    /// false if the state is unknown, unchanged or not an allowed target.
+    bool setState(FSMInstance& fsm, Entity entity, FSMStateId newState);
+    bool setState(FSMInstance& fsm, Entity entity, std::string_view newState);
+
+    /// Name of the instance's current state (empty if none).
+    const std::string& getStateName(const FSMInstance& fsm) const;
+
+    /// Group every FSMInstance by definition/state, run each group's update,
+    /// advance timeInState and take automatic transitions. Called by update().
+    void updateShared(Registry& registry, float dt);
+
+    /// Entities in a (definition, state) group during the last updateShared().
+    size_t lastGroupSize(FSMDefinitionId definition, FSMStateId state) const;
 
     /// Transition an entity's state machine to a new state.
     /// Calls onExit on the old state and onEnter on the new state.
@@ -106,6 +267,35 @@ public:
             it->second.onEnter(entity);
         }
     }
+
+private:
+    /// Marks a callback dispatch; the outermost one applies deferred edits
+    struct DispatchScope {
+        explicit DispatchScope(StateMachineSystem& system) : m_system(system) {
+            ++m_system.m_dispatchDepth;
+        }
+        ~DispatchScope() {
+            if (--m_system.m_dispatchDepth == 0) m_system.applyDeferredEdits();
+        }
+        DispatchScope(const DispatchScope&) = delete;
+        DispatchScope& operator=(const DispatchScope&) = delete;
+
+    private:
+        StateMachineSystem& m_system;
+    };
+
+    void runGroup(Registry& registry, FSMDefinitionId definition, FSMStateId state,
+                  const std::vector<Entity>& entities, float dt);
+    void applyDeferredEdits();
+
+    std::deque<FSMDefinition> m_definitions;   // deque: references survive define()
+    std::unordered_map<std::string, FSMDefinitionId> m_definitionIds;
+
+    /// Scratch: entities per [definition][state], reused every frame
+    std::vector<std::vector<std::vector<Entity>>> m_groups;
+
+    int m_dispatchDepth = 0;
+    std::vector<std::pair<std::string, std::function<void(FSMDefinition&)>>> m_deferredEdits;
 };
 
 } // namespace gloaming
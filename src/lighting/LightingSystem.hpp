@@ -37,10 +37,13 @@ struct LightingStats {
 /// - Rendering the light overlay
 class LightingSystem : public System {
 public:
-    LightingSystem() : System("LightingSystem", 50) {}
+    LightingSystem() : LightingSystem(LightingSystemConfig{}) {}
     explicit LightingSystem(const LightingSystemConfig& config)
         : System("LightingSystem", 50), m_config(config),
-          m_lightMap(config.lightMap), m_dayNightCycle(config.dayNight) {}
+          m_lightMap(config.lightMap), m_dayNightCycle(config.dayNight) {
+        // Writes only its own light map
+        declareAccess().reads<Transform, LightSource, resource::TileMap>();
+    }
 
     void init(Registry& registry, Engine& engine) override;
     void update(float dt) override;
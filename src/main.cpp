@@ -1,10 +1,10 @@
 #include "engine/Engine.hpp"
 #include "engine/Log.hpp"
 
-int main() {
+int main(int argc, char** argv) {
     gloaming::Engine engine;
 
-    if (!engine.init("config.json")) {
+    if (!engine.init(gloaming::LaunchOptions::parse(argc, argv))) {
         return 1;
     }
 
@@ -0,0 +1,205 @@
+#include "mod/BytecodeCache.hpp"
+#include "engine/Log.hpp"
+
+#include <sol/sol.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace gloaming {
+
+namespace {
+
+constexpr uint32_t kBytecodeCacheMagic = 0x43554C47;   // "GLUC"
+constexpr uint32_t kBytecodeCacheVersion = 2;
+constexpr uint64_t kMaxCachedChunkSize = 64ull * 1024 * 1024;
+
+/// Everything a dumped chunk's validity depends on besides its source
+struct LuaAbi {
+    uint32_t cacheVersion = kBytecodeCacheVersion;
+    uint32_t versionNum = LUA_VERSION_NUM;
+    uint32_t integerSize = sizeof(lua_Integer);
+    uint32_t numberSize = sizeof(lua_Number);
+    uint32_t sizeTSize = sizeof(size_t);
+    uint32_t instructionSize = sizeof(uint32_t);
+};
+
+/// Keyed tag over an entry's key and chunk
+uint64_t tagFor(const HashKey& secret, uint64_t key, std::string_view bytecode) {
+    KeyedHash hash(secret);
+    hash.updateValue(key).update(bytecode.data(), bytecode.size());
+    return hash.finish();
+}
+
+template<typename T>
+void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool readValue(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/// Write `secret` to `path` as a new owner-only file. The temp file is
+/// created with mode 0600 (O_EXCL, so never through an existing file or
+/// link) and renamed into place, so the key is never readable by others or
+/// half-written.
+bool writeKeyFile(const std::string& path, const HashKey& secret) {
+    std::string tempPath = path + ".tmp";
+#ifdef _WIN32
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        writeValue(file, secret[0]);
+        writeValue(file, secret[1]);
+        if (!file.good()) return false;
+    }
+#else
+    ::unlink(tempPath.c_str());     // Left behind by an interrupted run
+    int fd = ::open(tempPath.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0600);
+    if (fd < 0) return false;
+    bool written = ::write(fd, secret.data(), sizeof(secret)) == static_cast<ssize_t>(sizeof(secret));
+    if (::close(fd) != 0) written = false;
+    if (!written) {
+        ::unlink(tempPath.c_str());
+        return false;
+    }
+#endif
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+BytecodeCache::BytecodeCache(std::string directory, std::string keyFile)
+    : m_directory(std::move(directory)), m_keyFile(std::move(keyFile)) {
+    if (m_directory.empty()) return;
+    if (m_keyFile.empty()) m_keyFile = m_directory + ".key";
+    if (!loadSecret()) {
+        LOG_WARN("BytecodeCache: no usable key at '{}', caching disabled", m_keyFile);
+        m_directory.clear();
+    }
+}
+
+bool BytecodeCache::loadSecret() {
+    {
+        std::ifstream file(m_keyFile, std::ios::binary);
+        if (file.is_open() && readValue(file, m_secret[0]) && readValue(file, m_secret[1])) {
+            return true;
+        }
+    }
+
+    // First run (or an unreadable key): start a new one. Entries tagged
+    // under the old key become misses.
+    m_secret = KeyedHash::randomKey();
+    std::error_code ec;
+    fs::path keyPath(m_keyFile);
+    if (keyPath.has_parent_path()) fs::create_directories(keyPath.parent_path(), ec);
+    return writeKeyFile(m_keyFile, m_secret);
+}
+
+uint64_t BytecodeCache::keyFor(std::string_view chunkName, std::string_view source) const {
+    static const std::string release = LUA_RELEASE;
+    KeyedHash hash(m_secret);
+    hash.updateValue(LuaAbi{}).update(release.data(), release.size());
+    // Length first, so name/source boundaries can't be shifted
+    hash.updateValue(static_cast<uint64_t>(chunkName.size())).update(chunkName.data(), chunkName.size());
+    hash.update(source.data(), source.size());
+    return hash.finish();
+}
+
+std::string BytecodeCache::pathFor(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.luac", static_cast<unsigned long long>(key));
+    return (fs::path(m_directory) / name).string();
+}
+
+bool BytecodeCache::load(uint64_t key, std::string& bytecode) const {
+    if (!isEnabled()) return false;
+
+    std::ifstream file(pathFor(key), std::ios::binary);
+    if (!file.is_open()) return false;
+
+    uint32_t magic = 0, version = 0;
+    uint64_t storedKey = 0, size = 0, tag = 0;
+    if (!readValue(file, magic) || magic != kBytecodeCacheMagic) return false;
+    if (!readValue(file, version) || version != kBytecodeCacheVersion) return false;
+    if (!readValue(file, storedKey) || storedKey != key) return false;
+    if (!readValue(file, size) || size == 0 || size > kMaxCachedChunkSize) return false;
+    if (!readValue(file, tag)) return false;
+
+    std::string chunk(static_cast<size_t>(size), '\0');
+    if (!file.read(chunk.data(), static_cast<std::streamsize>(size))) return false;
+    if (tagFor(m_secret, key, chunk) != tag) {
+        LOG_WARN("BytecodeCache: '{}' fails authentication (corrupt or from another install), recompiling",
+                 pathFor(key));
+        return false;
+    }
+
+    bytecode = std::move(chunk);
+    return true;
+}
+
+bool BytecodeCache::save(uint64_t key, std::string_view bytecode) const {
+    if (!isEnabled() || bytecode.empty()) return false;
+
+    std::error_code ec;
+    fs::create_directories(m_directory, ec);
+    if (ec) {
+        LOG_WARN("BytecodeCache: cannot create '{}': {}", m_directory, ec.message());
+        return false;
+    }
+
+    // Write beside the target and rename, so readers never see a partial file
+    std::string path = pathFor(key);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_WARN("BytecodeCache: cannot write '{}'", tempPath);
+            return false;
+        }
+
+        writeValue(file, kBytecodeCacheMagic);
+        writeValue(file, kBytecodeCacheVersion);
+        writeValue(file, key);
+        writeValue(file, static_cast<uint64_t>(bytecode.size()));
+        writeValue(file, tagFor(m_secret, key, bytecode));
+        file.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+
+        if (!file.good()) {
+            file.close();
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+void BytecodeCache::remove(uint64_t key) const {
+    if (!isEnabled()) return;
+    std::error_code ec;
+    fs::remove(pathFor(key), ec);
+}
+
+} // namespace gloaming
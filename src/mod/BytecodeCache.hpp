@@ -0,0 +1,61 @@
+#pragma once
+
+#include "engine/KeyedHash.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace gloaming {
+
+/// Compiled Lua chunks on disk, one file per script, so unchanged mod
+/// scripts skip parsing on the next run.
+///
+/// Keys cover the chunk name, the source text and the Lua ABI the chunk was
+/// compiled for (version, number sizes), so an engine built against a
+/// different Lua never loads a stale chunk, and two scripts with the same
+/// text keep their own names in error messages.
+///
+/// Trust boundary: Lua loads these files as bytecode, which the VM does not
+/// verify, so a forged entry runs with engine privileges. Every entry is
+/// therefore tagged with a keyed hash (SipHash) under a per-install secret
+/// kept in `keyFile`, generated on first use. A file that is missing,
+/// truncated, from another format version, or fails its tag (corrupt, or
+/// written by another install) is treated as a miss. Both the cache and the
+/// key file are local state: never ship either with a game or mod, and keep
+/// the key file somewhere mods can't write.
+class BytecodeCache {
+public:
+    /// `keyFile` defaults to "<directory>.key". Caching is disabled if the
+    /// key can be neither read nor created.
+    explicit BytecodeCache(std::string directory = {}, std::string keyFile = {});
+
+    /// Caching is off when no directory is set
+    bool isEnabled() const { return !m_directory.empty(); }
+    const std::string& getDirectory() const { return m_directory; }
+    const std::string& getKeyFile() const { return m_keyFile; }
+
+    /// Cache key (and file name) for a script, from its chunk name ("@path")
+    /// and source text. Keyed with this install's secret, so other parties
+    /// can't predict which file a script will be cached in.
+    uint64_t keyFor(std::string_view chunkName, std::string_view source) const;
+
+    /// Cache file for `key`
+    std::string pathFor(uint64_t key) const;
+
+    bool load(uint64_t key, std::string& bytecode) const;
+    bool save(uint64_t key, std::string_view bytecode) const;
+
+    /// Delete the file for `key` (superseded by an edited script)
+    void remove(uint64_t key) const;
+
+private:
+    /// Read the secret from m_keyFile, creating it if absent
+    bool loadSecret();
+
+    std::string m_directory;
+    std::string m_keyFile;
+    HashKey m_secret{};
+};
+
+} // namespace gloaming
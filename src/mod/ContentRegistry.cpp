@@ -7,76 +7,58 @@ namespace gloaming {
 // Registration
 // ---------------------------------------------------------------------------
 
-uint16_t ContentRegistry::registerTile(const TileContentDef& def) {
-    TileContentDef tile = def;
-    tile.runtimeId = m_nextTileId++;
-    std::string qid = tile.qualifiedId.empty()
-        ? tile.id  // Fallback if not namespaced
-        : tile.qualifiedId;
-
-    if (m_tiles.count(qid)) {
-        LOG_WARN("ContentRegistry: overwriting tile '{}'", qid);
+namespace {
+
+/// Store `def` in `table`, logging overwrites and a full ID space
+template<typename Def>
+uint16_t registerContent(ContentTable<Def>& table, const Def& def, const char* kind) {
+    const std::string& qid = def.qualifiedId.empty()
+        ? def.id  // Fallback if not namespaced
+        : def.qualifiedId;
+
+    bool overwritten = false;
+    uint16_t runtimeId = table.put(qid, def, &overwritten);
+    if (runtimeId == 0) {
+        LOG_ERROR("ContentRegistry: cannot register {} '{}': all {} runtime IDs in use",
+                  kind, qid, ContentTable<Def>::kMaxEntries);
+        return 0;
+    }
+    if (overwritten) {
+        LOG_WARN("ContentRegistry: overwriting {} '{}'", kind, qid);
     }
+    LOG_DEBUG("ContentRegistry: registered {} '{}' (runtime ID {})", kind, qid, runtimeId);
+    return runtimeId;
+}
+
+} // namespace
 
-    m_runtimeToTile[tile.runtimeId] = qid;
-    m_tiles[qid] = std::move(tile);
-    LOG_DEBUG("ContentRegistry: registered tile '{}' (runtime ID {})", qid, m_tiles[qid].runtimeId);
-    return m_tiles[qid].runtimeId;
+uint16_t ContentRegistry::registerTile(const TileContentDef& def) {
+    return registerContent(m_tiles, def, "tile");
 }
 
-void ContentRegistry::registerItem(const ItemDefinition& def) {
-    std::string qid = def.qualifiedId.empty() ? def.id : def.qualifiedId;
-    if (m_items.count(qid)) {
-        LOG_WARN("ContentRegistry: overwriting item '{}'", qid);
-    }
-    m_items[qid] = def;
+uint16_t ContentRegistry::registerItem(const ItemDefinition& def) {
     m_tileToItemDirty = true;
-    LOG_DEBUG("ContentRegistry: registered item '{}'", qid);
+    return registerContent(m_items, def, "item");
 }
 
-void ContentRegistry::registerEnemy(const EnemyDefinition& def) {
-    std::string qid = def.qualifiedId.empty() ? def.id : def.qualifiedId;
-    if (m_enemies.count(qid)) {
-        LOG_WARN("ContentRegistry: overwriting enemy '{}'", qid);
-    }
-    m_enemies[qid] = def;
-    LOG_DEBUG("ContentRegistry: registered enemy '{}'", qid);
+uint16_t ContentRegistry::registerEnemy(const EnemyDefinition& def) {
+    return registerContent(m_enemies, def, "enemy");
 }
 
-void ContentRegistry::registerRecipe(const RecipeDefinition& def) {
-    std::string qid = def.qualifiedId.empty() ? def.id : def.qualifiedId;
-    if (m_recipes.count(qid)) {
-        LOG_WARN("ContentRegistry: overwriting recipe '{}'", qid);
-    }
-    m_recipes[qid] = def;
-    LOG_DEBUG("ContentRegistry: registered recipe '{}'", qid);
+uint16_t ContentRegistry::registerRecipe(const RecipeDefinition& def) {
+    return registerContent(m_recipes, def, "recipe");
 }
 
-void ContentRegistry::registerNPC(const NPCDefinition& def) {
-    std::string qid = def.qualifiedId.empty() ? def.id : def.qualifiedId;
-    if (m_npcs.count(qid)) {
-        LOG_WARN("ContentRegistry: overwriting NPC '{}'", qid);
-    }
-    m_npcs[qid] = def;
-    LOG_DEBUG("ContentRegistry: registered NPC '{}'", qid);
+uint16_t ContentRegistry::registerNPC(const NPCDefinition& def) {
+    return registerContent(m_npcs, def, "NPC");
 }
 
-void ContentRegistry::registerDialogueTree(const DialogueTreeDef& def) {
-    std::string qid = def.qualifiedId.empty() ? def.id : def.qualifiedId;
-    if (m_dialogueTrees.count(qid)) {
-        LOG_WARN("ContentRegistry: overwriting dialogue tree '{}'", qid);
-    }
-    m_dialogueTrees[qid] = def;
-    LOG_DEBUG("ContentRegistry: registered dialogue tree '{}'", qid);
+uint16_t ContentRegistry::registerDialogueTree(const DialogueTreeDef& def) {
+    return registerContent(m_dialogueTrees, def, "dialogue tree");
 }
 
-void ContentRegistry::registerShop(const ShopDefinition& def) {
-    std::string qid = def.qualifiedId.empty() ? def.id : def.qualifiedId;
-    if (m_shops.count(qid)) {
-        LOG_WARN("ContentRegistry: overwriting shop '{}'", qid);
-    }
-    m_shops[qid] = def;
-    LOG_DEBUG("ContentRegistry: registered shop '{}'", qid);
+uint16_t ContentRegistry::registerShop(const ShopDefinition& def) {
+    return registerContent(m_shops, def, "shop");
 }
 
 // ---------------------------------------------------------------------------
@@ -376,76 +358,10 @@ bool ContentRegistry::loadRecipesFromJson(const nlohmann::json& json,
 // Queries
 // ---------------------------------------------------------------------------
 
-const TileContentDef* ContentRegistry::getTile(const std::string& qualifiedId) const {
-    auto it = m_tiles.find(qualifiedId);
-    return it != m_tiles.end() ? &it->second : nullptr;
-}
-
-const TileContentDef* ContentRegistry::getTileByRuntime(uint16_t runtimeId) const {
-    auto it = m_runtimeToTile.find(runtimeId);
-    if (it == m_runtimeToTile.end()) return nullptr;
-    return getTile(it->second);
-}
-
-const ItemDefinition* ContentRegistry::getItem(const std::string& qualifiedId) const {
-    auto it = m_items.find(qualifiedId);
-    return it != m_items.end() ? &it->second : nullptr;
-}
-
-const EnemyDefinition* ContentRegistry::getEnemy(const std::string& qualifiedId) const {
-    auto it = m_enemies.find(qualifiedId);
-    return it != m_enemies.end() ? &it->second : nullptr;
-}
-
-const RecipeDefinition* ContentRegistry::getRecipe(const std::string& qualifiedId) const {
-    auto it = m_recipes.find(qualifiedId);
-    return it != m_recipes.end() ? &it->second : nullptr;
-}
-
-bool ContentRegistry::hasTile(const std::string& qualifiedId) const {
-    return m_tiles.count(qualifiedId) > 0;
-}
-
-bool ContentRegistry::hasItem(const std::string& qualifiedId) const {
-    return m_items.count(qualifiedId) > 0;
-}
-
-bool ContentRegistry::hasEnemy(const std::string& qualifiedId) const {
-    return m_enemies.count(qualifiedId) > 0;
-}
-
-std::vector<std::string> ContentRegistry::getTileIds() const {
-    std::vector<std::string> ids;
-    ids.reserve(m_tiles.size());
-    for (const auto& [id, _] : m_tiles) ids.push_back(id);
-    return ids;
-}
-
-std::vector<std::string> ContentRegistry::getItemIds() const {
-    std::vector<std::string> ids;
-    ids.reserve(m_items.size());
-    for (const auto& [id, _] : m_items) ids.push_back(id);
-    return ids;
-}
-
-std::vector<std::string> ContentRegistry::getEnemyIds() const {
-    std::vector<std::string> ids;
-    ids.reserve(m_enemies.size());
-    for (const auto& [id, _] : m_enemies) ids.push_back(id);
-    return ids;
-}
-
-std::vector<std::string> ContentRegistry::getRecipeIds() const {
-    std::vector<std::string> ids;
-    ids.reserve(m_recipes.size());
-    for (const auto& [id, _] : m_recipes) ids.push_back(id);
-    return ids;
-}
-
 std::vector<const RecipeDefinition*> ContentRegistry::getRecipesByCategory(
         const std::string& category) const {
     std::vector<const RecipeDefinition*> results;
-    for (const auto& [_, recipe] : m_recipes) {
+    for (const auto& recipe : m_recipes.all()) {
         if (recipe.category == category) {
             results.push_back(&recipe);
         }
@@ -456,7 +372,7 @@ std::vector<const RecipeDefinition*> ContentRegistry::getRecipesByCategory(
 std::vector<const RecipeDefinition*> ContentRegistry::getRecipesForItem(
         const std::string& itemId) const {
     std::vector<const RecipeDefinition*> results;
-    for (const auto& [_, recipe] : m_recipes) {
+    for (const auto& recipe : m_recipes.all()) {
         if (recipe.resultItem == itemId) {
             results.push_back(&recipe);
         }
@@ -621,52 +537,12 @@ bool ContentRegistry::loadShopsFromJson(const nlohmann::json& json,
 }
 
 // ---------------------------------------------------------------------------
-// Stage 15 Queries
+// Validation
 // ---------------------------------------------------------------------------
 
-const NPCDefinition* ContentRegistry::getNPC(const std::string& qualifiedId) const {
-    auto it = m_npcs.find(qualifiedId);
-    return it != m_npcs.end() ? &it->second : nullptr;
-}
-
-const DialogueTreeDef* ContentRegistry::getDialogueTree(const std::string& qualifiedId) const {
-    auto it = m_dialogueTrees.find(qualifiedId);
-    return it != m_dialogueTrees.end() ? &it->second : nullptr;
-}
-
-const ShopDefinition* ContentRegistry::getShop(const std::string& qualifiedId) const {
-    auto it = m_shops.find(qualifiedId);
-    return it != m_shops.end() ? &it->second : nullptr;
-}
-
-bool ContentRegistry::hasNPC(const std::string& qualifiedId) const {
-    return m_npcs.count(qualifiedId) > 0;
-}
-
-bool ContentRegistry::hasShop(const std::string& qualifiedId) const {
-    return m_shops.count(qualifiedId) > 0;
-}
-
-bool ContentRegistry::hasDialogueTree(const std::string& qualifiedId) const {
-    return m_dialogueTrees.count(qualifiedId) > 0;
-}
-
-std::vector<std::string> ContentRegistry::getNPCIds() const {
-    std::vector<std::string> ids;
-    ids.reserve(m_npcs.size());
-    for (const auto& [id, _] : m_npcs) ids.push_back(id);
-    return ids;
-}
-
-std::vector<std::string> ContentRegistry::getShopIds() const {
-    std::vector<std::string> ids;
-    ids.reserve(m_shops.size());
-    for (const auto& [id, _] : m_shops) ids.push_back(id);
-    return ids;
-}
-
 void ContentRegistry::validateNPCReferences() const {
-    for (const auto& [qid, npc] : m_npcs) {
+    for (const auto& npc : m_npcs.all()) {
+        const std::string& qid = npc.qualifiedId.empty() ? npc.id : npc.qualifiedId;
         if (!npc.dialogueId.empty() && !hasDialogueTree(npc.dialogueId)) {
             LOG_WARN("ContentRegistry: NPC '{}' references unknown dialogue tree '{}'",
                      qid, npc.dialogueId);
@@ -680,8 +556,6 @@ void ContentRegistry::validateNPCReferences() const {
 
 void ContentRegistry::clear() {
     m_tiles.clear();
-    m_runtimeToTile.clear();
-    m_nextTileId = 1;
     m_items.clear();
     m_enemies.clear();
     m_recipes.clear();
@@ -702,9 +576,11 @@ std::string ContentRegistry::getItemForTile(const std::string& tileId) const {
 
 void ContentRegistry::rebuildTileItemLookup() const {
     m_tileToItem.clear();
-    for (const auto& [qid, item] : m_items) {
-        if (!item.placesTile.empty()) {
-            m_tileToItem[item.placesTile] = qid;
+    const auto& qids = m_items.qualifiedIds();
+    const auto& items = m_items.all();
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (!items[i].placesTile.empty()) {
+            m_tileToItem[items[i].placesTile] = qids[i];
         }
     }
     m_tileToItemDirty = false;
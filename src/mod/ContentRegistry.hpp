@@ -125,6 +125,9 @@ struct ItemDefinition {
     // Script for custom behavior
     std::string onHitScript;
     std::string onUseScript;
+
+    // Runtime item ID assigned by the registry
+    uint16_t runtimeId = 0;
 };
 
 // ---------------------------------------------------------------------------
@@ -187,6 +190,9 @@ struct EnemyDefinition {
     // Collider size (defaults to 16x16)
     float colliderWidth = 16.0f;
     float colliderHeight = 16.0f;
+
+    // Runtime enemy ID assigned by the registry
+    uint16_t runtimeId = 0;
 };
 
 // ---------------------------------------------------------------------------
@@ -225,6 +231,9 @@ struct NPCDefinition {
     // Collider
     float colliderWidth = 16.0f;
     float colliderHeight = 16.0f;
+
+    // Runtime NPC ID assigned by the registry
+    uint16_t runtimeId = 0;
 };
 
 // ---------------------------------------------------------------------------
@@ -250,6 +259,7 @@ struct DialogueTreeDef {
     std::string qualifiedId;
     std::string greetingNodeId;          // Starting node ID
     std::vector<DialogueNodeDef> nodes;
+    uint16_t runtimeId = 0;              // Assigned by the registry
 };
 
 // ---------------------------------------------------------------------------
@@ -272,6 +282,7 @@ struct ShopDefinition {
     float buyMultiplier = 1.0f;          // Price modifier for buying
     float sellMultiplier = 0.5f;         // Sell ratio
     std::string currencyItem = "base:coins"; // Item used as currency
+    uint16_t runtimeId = 0;              // Assigned by the registry
 };
 
 // ---------------------------------------------------------------------------
@@ -294,38 +305,119 @@ struct RecipeDefinition {
 
     std::string station;             // Required crafting station (tile ID), empty = hand-craft
     std::string category = "misc";
+
+    // Runtime recipe ID assigned by the registry
+    uint16_t runtimeId = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Content Table
+// ---------------------------------------------------------------------------
+
+/// Runtime ID for registered content; 0 means none. Each content type has
+/// its own dense ID space starting at 1.
+using ContentRuntimeId = uint16_t;
+
+/// Definitions of one content type in a flat array indexed by runtime ID,
+/// with a string index for load-time and Lua lookups. Re-registering a
+/// qualified ID overwrites the definition in place and keeps its ID, so IDs
+/// held by gameplay code stay valid across hot reloads.
+///
+/// Registering new content may reallocate the array: hold runtime IDs, not
+/// definition pointers, across registrations.
+template<typename Def>
+class ContentTable {
+public:
+    static constexpr size_t kMaxEntries = UINT16_MAX;
+
+    /// Insert or overwrite `def` under `qualifiedId` and stamp its runtime
+    /// ID. Returns 0 (and stores nothing) when the ID space is exhausted.
+    ContentRuntimeId put(const std::string& qualifiedId, Def def, bool* overwritten = nullptr) {
+        auto it = m_index.find(qualifiedId);
+        if (overwritten) *overwritten = it != m_index.end();
+        if (it != m_index.end()) {
+            def.runtimeId = it->second;
+            m_defs[it->second - 1] = std::move(def);
+            return it->second;
+        }
+        if (m_defs.size() >= kMaxEntries) return 0;
+        auto id = static_cast<ContentRuntimeId>(m_defs.size() + 1);
+        def.runtimeId = id;
+        m_defs.push_back(std::move(def));
+        m_qualifiedIds.push_back(qualifiedId);
+        m_index.emplace(qualifiedId, id);
+        return id;
+    }
+
+    const Def* find(const std::string& qualifiedId) const { return get(idOf(qualifiedId)); }
+
+    const Def* get(ContentRuntimeId id) const {
+        return id != 0 && id <= m_defs.size() ? &m_defs[id - 1] : nullptr;
+    }
+
+    /// Runtime ID for `qualifiedId`, or 0
+    ContentRuntimeId idOf(const std::string& qualifiedId) const {
+        auto it = m_index.find(qualifiedId);
+        return it != m_index.end() ? it->second : 0;
+    }
+
+    bool contains(const std::string& qualifiedId) const { return m_index.count(qualifiedId) > 0; }
+
+    /// Definitions in runtime-ID order (index i holds ID i + 1)
+    const std::vector<Def>& all() const { return m_defs; }
+
+    /// Qualified IDs in runtime-ID order
+    const std::vector<std::string>& qualifiedIds() const { return m_qualifiedIds; }
+
+    size_t size() const { return m_defs.size(); }
+
+    void clear() {
+        m_defs.clear();
+        m_qualifiedIds.clear();
+        m_index.clear();
+    }
+
+private:
+    std::vector<Def> m_defs;
+    std::vector<std::string> m_qualifiedIds;
+    std::unordered_map<std::string, ContentRuntimeId> m_index;
 };
 
 // ---------------------------------------------------------------------------
 // Content Registry
 // ---------------------------------------------------------------------------
 
+/// All mod content, keyed two ways: qualified string IDs ("mod:name") for
+/// loading, Lua and cross-references, and dense runtime IDs for gameplay
+/// code that looks content up every frame. Resolve a string once with
+/// get*RuntimeId() and keep the number.
 class ContentRegistry {
 public:
     ContentRegistry() = default;
 
     // ---- Registration ----
+    // Each returns the assigned runtime ID (0 if that type's ID space is full).
 
     /// Register a tile definition. Returns the assigned runtime ID.
     uint16_t registerTile(const TileContentDef& def);
 
     /// Register an item definition.
-    void registerItem(const ItemDefinition& def);
+    uint16_t registerItem(const ItemDefinition& def);
 
     /// Register an enemy definition.
-    void registerEnemy(const EnemyDefinition& def);
+    uint16_t registerEnemy(const EnemyDefinition& def);
 
     /// Register a recipe definition.
-    void registerRecipe(const RecipeDefinition& def);
+    uint16_t registerRecipe(const RecipeDefinition& def);
 
     /// Register an NPC definition (Stage 15).
-    void registerNPC(const NPCDefinition& def);
+    uint16_t registerNPC(const NPCDefinition& def);
 
     /// Register a dialogue tree definition (Stage 15).
-    void registerDialogueTree(const DialogueTreeDef& def);
+    uint16_t registerDialogueTree(const DialogueTreeDef& def);
 
     /// Register a shop definition (Stage 15).
-    void registerShop(const ShopDefinition& def);
+    uint16_t registerShop(const ShopDefinition& def);
 
     // ---- Bulk loading from JSON ----
 
@@ -354,31 +446,62 @@ public:
     /// Load shop definitions from JSON (Stage 15).
     bool loadShopsFromJson(const nlohmann::json& json, const std::string& modId);
 
-    // ---- Queries ----
-
-    const TileContentDef* getTile(const std::string& qualifiedId) const;
-    const TileContentDef* getTileByRuntime(uint16_t runtimeId) const;
-    const ItemDefinition* getItem(const std::string& qualifiedId) const;
-    const EnemyDefinition* getEnemy(const std::string& qualifiedId) const;
-    const RecipeDefinition* getRecipe(const std::string& qualifiedId) const;
-    const NPCDefinition* getNPC(const std::string& qualifiedId) const;
-    const DialogueTreeDef* getDialogueTree(const std::string& qualifiedId) const;
-    const ShopDefinition* getShop(const std::string& qualifiedId) const;
-
-    bool hasTile(const std::string& qualifiedId) const;
-    bool hasItem(const std::string& qualifiedId) const;
-    bool hasEnemy(const std::string& qualifiedId) const;
-    bool hasNPC(const std::string& qualifiedId) const;
-    bool hasShop(const std::string& qualifiedId) const;
-    bool hasDialogueTree(const std::string& qualifiedId) const;
-
-    /// Get all tile IDs
-    std::vector<std::string> getTileIds() const;
-    std::vector<std::string> getItemIds() const;
-    std::vector<std::string> getEnemyIds() const;
-    std::vector<std::string> getRecipeIds() const;
-    std::vector<std::string> getNPCIds() const;
-    std::vector<std::string> getShopIds() const;
+    // ---- Queries by qualified ID ----
+
+    const TileContentDef* getTile(const std::string& qualifiedId) const { return m_tiles.find(qualifiedId); }
+    const ItemDefinition* getItem(const std::string& qualifiedId) const { return m_items.find(qualifiedId); }
+    const EnemyDefinition* getEnemy(const std::string& qualifiedId) const { return m_enemies.find(qualifiedId); }
+    const RecipeDefinition* getRecipe(const std::string& qualifiedId) const { return m_recipes.find(qualifiedId); }
+    const NPCDefinition* getNPC(const std::string& qualifiedId) const { return m_npcs.find(qualifiedId); }
+    const DialogueTreeDef* getDialogueTree(const std::string& qualifiedId) const {
+        return m_dialogueTrees.find(qualifiedId);
+    }
+    const ShopDefinition* getShop(const std::string& qualifiedId) const { return m_shops.find(qualifiedId); }
+
+    bool hasTile(const std::string& qualifiedId) const { return m_tiles.contains(qualifiedId); }
+    bool hasItem(const std::string& qualifiedId) const { return m_items.contains(qualifiedId); }
+    bool hasEnemy(const std::string& qualifiedId) const { return m_enemies.contains(qualifiedId); }
+    bool hasNPC(const std::string& qualifiedId) const { return m_npcs.contains(qualifiedId); }
+    bool hasShop(const std::string& qualifiedId) const { return m_shops.contains(qualifiedId); }
+    bool hasDialogueTree(const std::string& qualifiedId) const { return m_dialogueTrees.contains(qualifiedId); }
+
+    // ---- Runtime IDs ----
+
+    /// Runtime ID for a qualified ID, or 0 if it isn't registered
+    uint16_t getTileRuntimeId(const std::string& qualifiedId) const { return m_tiles.idOf(qualifiedId); }
+    uint16_t getItemRuntimeId(const std::string& qualifiedId) const { return m_items.idOf(qualifiedId); }
+    uint16_t getEnemyRuntimeId(const std::string& qualifiedId) const { return m_enemies.idOf(qualifiedId); }
+    uint16_t getRecipeRuntimeId(const std::string& qualifiedId) const { return m_recipes.idOf(qualifiedId); }
+    uint16_t getNPCRuntimeId(const std::string& qualifiedId) const { return m_npcs.idOf(qualifiedId); }
+    uint16_t getShopRuntimeId(const std::string& qualifiedId) const { return m_shops.idOf(qualifiedId); }
+
+    /// Definition for a runtime ID (an array index), or nullptr
+    const TileContentDef* getTileByRuntime(uint16_t runtimeId) const { return m_tiles.get(runtimeId); }
+    const ItemDefinition* getItemByRuntime(uint16_t runtimeId) const { return m_items.get(runtimeId); }
+    const EnemyDefinition* getEnemyByRuntime(uint16_t runtimeId) const { return m_enemies.get(runtimeId); }
+    const RecipeDefinition* getRecipeByRuntime(uint16_t runtimeId) const { return m_recipes.get(runtimeId); }
+    const NPCDefinition* getNPCByRuntime(uint16_t runtimeId) const { return m_npcs.get(runtimeId); }
+    const DialogueTreeDef* getDialogueTreeByRuntime(uint16_t runtimeId) const {
+        return m_dialogueTrees.get(runtimeId);
+    }
+    const ShopDefinition* getShopByRuntime(uint16_t runtimeId) const { return m_shops.get(runtimeId); }
+
+    /// All definitions of a type in runtime-ID order, for iteration without
+    /// string lookups
+    const std::vector<TileContentDef>& getTiles() const { return m_tiles.all(); }
+    const std::vector<ItemDefinition>& getItems() const { return m_items.all(); }
+    const std::vector<EnemyDefinition>& getEnemies() const { return m_enemies.all(); }
+    const std::vector<RecipeDefinition>& getRecipes() const { return m_recipes.all(); }
+    const std::vector<NPCDefinition>& getNPCs() const { return m_npcs.all(); }
+    const std::vector<ShopDefinition>& getShops() const { return m_shops.all(); }
+
+    /// Get all tile IDs (in registration order)
+    std::vector<std::string> getTileIds() const { return m_tiles.qualifiedIds(); }
+    std::vector<std::string> getItemIds() const { return m_items.qualifiedIds(); }
+    std::vector<std::string> getEnemyIds() const { return m_enemies.qualifiedIds(); }
+    std::vector<std::string> getRecipeIds() const { return m_recipes.qualifiedIds(); }
+    std::vector<std::string> getNPCIds() const { return m_npcs.qualifiedIds(); }
+    std::vector<std::string> getShopIds() const { return m_shops.qualifiedIds(); }
 
     /// Get recipes by category
     std::vector<const RecipeDefinition*> getRecipesByCategory(const std::string& category) const;
@@ -404,22 +527,19 @@ public:
     size_t npcCount() const { return m_npcs.size(); }
     size_t shopCount() const { return m_shops.size(); }
 
-    /// Clear all registered content
+    /// Clear all registered content (runtime IDs restart at 1)
     void clear();
 
 private:
-    std::unordered_map<std::string, TileContentDef> m_tiles;
-    std::unordered_map<uint16_t, std::string> m_runtimeToTile;  // runtime ID -> qualified ID
-    uint16_t m_nextTileId = 1;  // 0 = air/empty
-
-    std::unordered_map<std::string, ItemDefinition> m_items;
-    std::unordered_map<std::string, EnemyDefinition> m_enemies;
-    std::unordered_map<std::string, RecipeDefinition> m_recipes;
+    ContentTable<TileContentDef> m_tiles;       // Tile runtime ID 0 = air/empty
+    ContentTable<ItemDefinition> m_items;
+    ContentTable<EnemyDefinition> m_enemies;
+    ContentTable<RecipeDefinition> m_recipes;
 
     // Stage 15
-    std::unordered_map<std::string, NPCDefinition> m_npcs;
-    std::unordered_map<std::string, DialogueTreeDef> m_dialogueTrees;
-    std::unordered_map<std::string, ShopDefinition> m_shops;
+    ContentTable<NPCDefinition> m_npcs;
+    ContentTable<DialogueTreeDef> m_dialogueTrees;
+    ContentTable<ShopDefinition> m_shops;
 
     /// Lazily built reverse lookup: tileId -> itemId (for items with placesTile)
     mutable std::unordered_map<std::string, std::string> m_tileToItem;
@@ -1,51 +1,239 @@
 #pragma once
 
+#include "engine/NameTable.hpp"
+
 #include <string>
+#include <string_view>
+#include <span>
 #include <vector>
-#include <unordered_map>
 #include <functional>
 #include <algorithm>
-#include <any>
+#include <cstdint>
+#include <cstring>
 
 namespace gloaming {
 
-/// Event data container — wraps arbitrary key-value pairs for Lua interop
+/// Interned event name. Resolve once with EventNames::intern() and reuse at
+/// subscription and emit sites so the hot path never hashes a string.
+using EventId = uint32_t;
+
+/// Interned event payload key (shares the EventNames table with EventId).
+using EventKey = uint32_t;
+
+/// Process-wide interner for event names and payload keys.
+///
+/// IDs are dense, stable for the lifetime of the process and shared by every
+/// EventBus, so they can be cached in statics at call sites:
+///   static const EventId kTileBroken = EventNames::intern("tile_broken");
+struct EventNameTag;
+using EventNames = NameTable<EventNameTag>;
+
+/// Event data container — a flat key/value payload with interned keys.
+///
+/// The first kInlineEntries values and kInlineText bytes of string data live
+/// inside the object, so a typical event (a handful of ints/floats plus an ID
+/// string or two) is built on the stack with zero heap allocations. Larger
+/// payloads spill into heap-backed overflow storage transparently.
+///
+/// As with the original map-per-type layout, a key may hold one value of each
+/// type independently (setInt("x") does not replace setString("x")).
 class EventData {
 public:
+    enum class Type : uint8_t { Int, Float, Bool, String };
+
+    static constexpr size_t kInlineEntries = 8;
+    static constexpr size_t kInlineText = 128;
+
     EventData() = default;
 
-    void setString(const std::string& key, const std::string& value) { m_strings[key] = value; }
-    void setFloat(const std::string& key, float value) { m_floats[key] = value; }
-    void setInt(const std::string& key, int value) { m_ints[key] = value; }
-    void setBool(const std::string& key, bool value) { m_bools[key] = value; }
+    // ---- Setters (interned keys — preferred on hot paths) ----
+
+    void setString(EventKey key, std::string_view value) {
+        Entry& e = slot(key, Type::String);
+        e.text = appendText(value);
+    }
+    void setFloat(EventKey key, float value) { slot(key, Type::Float).f = value; }
+    void setInt(EventKey key, int value)     { slot(key, Type::Int).i = value; }
+    void setBool(EventKey key, bool value)   { slot(key, Type::Bool).b = value; }
+
+    // ---- Setters (string keys — interned on the fly) ----
+
+    void setString(std::string_view key, std::string_view value) { setString(EventNames::intern(key), value); }
+    void setFloat(std::string_view key, float value) { setFloat(EventNames::intern(key), value); }
+    void setInt(std::string_view key, int value)     { setInt(EventNames::intern(key), value); }
+    void setBool(std::string_view key, bool value)   { setBool(EventNames::intern(key), value); }
+
+    // ---- Getters ----
+
+    /// Zero-copy string access; the view is valid while this EventData lives.
+    std::string_view getStringView(EventKey key, std::string_view def = {}) const {
+        const Entry* e = lookup(key, Type::String);
+        return e ? textOf(*e) : def;
+    }
+    std::string getString(EventKey key, const std::string& def = "") const {
+        const Entry* e = lookup(key, Type::String);
+        return e ? std::string(textOf(*e)) : def;
+    }
+    float getFloat(EventKey key, float def = 0.0f) const {
+        const Entry* e = lookup(key, Type::Float);
+        return e ? e->f : def;
+    }
+    int getInt(EventKey key, int def = 0) const {
+        const Entry* e = lookup(key, Type::Int);
+        return e ? e->i : def;
+    }
+    bool getBool(EventKey key, bool def = false) const {
+        const Entry* e = lookup(key, Type::Bool);
+        return e ? e->b : def;
+    }
 
-    std::string getString(const std::string& key, const std::string& def = "") const {
-        auto it = m_strings.find(key);
-        return it != m_strings.end() ? it->second : def;
+    std::string_view getStringView(std::string_view key, std::string_view def = {}) const {
+        return getStringView(EventNames::find(key), def);
     }
-    float getFloat(const std::string& key, float def = 0.0f) const {
-        auto it = m_floats.find(key);
-        return it != m_floats.end() ? it->second : def;
+    std::string getString(std::string_view key, const std::string& def = "") const {
+        return getString(EventNames::find(key), def);
     }
-    int getInt(const std::string& key, int def = 0) const {
-        auto it = m_ints.find(key);
-        return it != m_ints.end() ? it->second : def;
+    float getFloat(std::string_view key, float def = 0.0f) const { return getFloat(EventNames::find(key), def); }
+    int getInt(std::string_view key, int def = 0) const         { return getInt(EventNames::find(key), def); }
+    bool getBool(std::string_view key, bool def = false) const  { return getBool(EventNames::find(key), def); }
+
+    bool hasString(EventKey key) const { return lookup(key, Type::String) != nullptr; }
+    bool hasFloat(EventKey key) const  { return lookup(key, Type::Float) != nullptr; }
+    bool hasInt(EventKey key) const    { return lookup(key, Type::Int) != nullptr; }
+    bool hasBool(EventKey key) const   { return lookup(key, Type::Bool) != nullptr; }
+
+    bool hasString(std::string_view key) const { return hasString(EventNames::find(key)); }
+    bool hasFloat(std::string_view key) const  { return hasFloat(EventNames::find(key)); }
+    bool hasInt(std::string_view key) const    { return hasInt(EventNames::find(key)); }
+    bool hasBool(std::string_view key) const   { return hasBool(EventNames::find(key)); }
+
+    /// Number of stored values (across all types).
+    size_t size() const { return m_inlineCount + m_overflow.size(); }
+    bool empty() const { return size() == 0; }
+
+    /// Remove all values. Keeps any overflow capacity for reuse.
+    void clear() {
+        m_inlineCount = 0;
+        m_overflow.clear();
+        m_textUsed = 0;
+        m_textOverflow.clear();
     }
-    bool getBool(const std::string& key, bool def = false) const {
-        auto it = m_bools.find(key);
-        return it != m_bools.end() ? it->second : def;
+
+    /// Payload equality (order-independent). Used to coalesce duplicate
+    /// queued events.
+    bool operator==(const EventData& other) const {
+        if (size() != other.size()) return false;
+        bool equal = true;
+        forEach([&](EventKey key, Type type, const EventData&) {
+            if (!equal) return;
+            const Entry* a = lookup(key, type);
+            const Entry* b = other.lookup(key, type);
+            if (!b) { equal = false; return; }
+            switch (type) {
+                case Type::Int:    equal = a->i == b->i; break;
+                case Type::Float:  equal = a->f == b->f; break;
+                case Type::Bool:   equal = a->b == b->b; break;
+                case Type::String: equal = textOf(*a) == other.textOf(*b); break;
+            }
+        });
+        return equal;
     }
 
-    bool hasString(const std::string& key) const { return m_strings.count(key) > 0; }
-    bool hasFloat(const std::string& key) const { return m_floats.count(key) > 0; }
-    bool hasInt(const std::string& key) const { return m_ints.count(key) > 0; }
-    bool hasBool(const std::string& key) const { return m_bools.count(key) > 0; }
+    /// Order-independent payload hash, consistent with operator==.
+    size_t hash() const {
+        size_t h = size();
+        forEach([&](EventKey key, Type type, const EventData&) {
+            const Entry* e = lookup(key, type);
+            size_t v = 0;
+            switch (type) {
+                case Type::Int:    v = std::hash<int>{}(e->i); break;
+                case Type::Float:  v = std::hash<float>{}(e->f); break;
+                case Type::Bool:   v = e->b ? 1 : 2; break;
+                case Type::String: v = std::hash<std::string_view>{}(textOf(*e)); break;
+            }
+            size_t entryHash = (static_cast<size_t>(key) * 0x9E3779B97F4A7C15ull)
+                             ^ (static_cast<size_t>(type) << 7) ^ v;
+            h += entryHash * 0xBF58476D1CE4E5B9ull;  // commutative combine
+        });
+        return h;
+    }
+
+    /// Visit every stored value in insertion order (used to marshal payloads
+    /// into Lua tables). The visitor is called as fn(key, type, data) and can
+    /// read the value through the typed getters.
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t i = 0; i < m_inlineCount; ++i) fn(m_inline[i].key, m_inline[i].type, *this);
+        for (const auto& e : m_overflow) fn(e.key, e.type, *this);
+    }
 
 private:
-    std::unordered_map<std::string, std::string> m_strings;
-    std::unordered_map<std::string, float> m_floats;
-    std::unordered_map<std::string, int> m_ints;
-    std::unordered_map<std::string, bool> m_bools;
+    struct TextRef {
+        uint32_t offset;  // < kInlineText: m_text; otherwise m_textOverflow[offset - kInlineText]
+        uint32_t length;
+    };
+
+    struct Entry {
+        EventKey key;
+        Type type;
+        union {
+            int i;
+            float f;
+            bool b;
+            TextRef text;
+        };
+    };
+
+    const Entry* lookup(EventKey key, Type type) const {
+        for (size_t i = 0; i < m_inlineCount; ++i) {
+            if (m_inline[i].key == key && m_inline[i].type == type) return &m_inline[i];
+        }
+        for (const auto& e : m_overflow) {
+            if (e.key == key && e.type == type) return &e;
+        }
+        return nullptr;
+    }
+
+    Entry& slot(EventKey key, Type type) {
+        if (const Entry* e = lookup(key, type)) return const_cast<Entry&>(*e);
+        Entry* e;
+        if (m_inlineCount < kInlineEntries) {
+            e = &m_inline[m_inlineCount++];
+        } else {
+            e = &m_overflow.emplace_back();
+        }
+        e->key = key;
+        e->type = type;
+        e->text = TextRef{0, 0};
+        return *e;
+    }
+
+    TextRef appendText(std::string_view value) {
+        auto len = static_cast<uint32_t>(value.size());
+        if (m_textUsed + value.size() <= kInlineText) {
+            if (len > 0) std::memcpy(m_text + m_textUsed, value.data(), value.size());
+            TextRef ref{m_textUsed, len};
+            m_textUsed += len;
+            return ref;
+        }
+        TextRef ref{static_cast<uint32_t>(kInlineText + m_textOverflow.size()), len};
+        m_textOverflow.append(value);
+        return ref;
+    }
+
+    std::string_view textOf(const Entry& e) const {
+        if (e.text.offset < kInlineText) {
+            return std::string_view(m_text + e.text.offset, e.text.length);
+        }
+        return std::string_view(m_textOverflow).substr(e.text.offset - kInlineText, e.text.length);
+    }
+
+    Entry m_inline[kInlineEntries];
+    uint32_t m_inlineCount = 0;
+    uint32_t m_textUsed = 0;
+    char m_text[kInlineText];
+    std::vector<Entry> m_overflow;
+    std::string m_textOverflow;
 };
 
 /// Handler ID for unsubscribing
@@ -54,82 +242,415 @@ using EventHandlerId = uint64_t;
 /// Event handler callback — returns true to cancel the event (prevent further handlers)
 using EventHandler = std::function<bool(const EventData&)>;
 
+/// Batch handler callback — receives every queued event of one type at once.
+using EventBatchHandler = std::function<void(std::span<const EventData>)>;
+
 /// Event bus for loose-coupled mod communication
+///
+/// Handlers are stored in a flat table indexed by interned EventId. emit()
+/// iterates the live handler list in place instead of copying it: handlers
+/// subscribed during an emit are queued and merged after the outermost emit
+/// returns, and handlers unsubscribed during an emit are tombstoned (kept
+/// alive, skipped) until then. This makes emit allocation-free in steady state
+/// while preserving the old copy-on-emit semantics.
+///
+/// Queued mode (opt-in): queue() — or emit() on an event marked with
+/// setDeferred() — appends the event to a per-frame buffer instead of calling
+/// handlers. flushQueued() (called once per frame by Engine::update) drains
+/// the buffer grouped by event type, in the order each type was first queued:
+///   - per-event handlers run for every queued event, in priority order;
+///     handlers subscribed with coalesce=true see each distinct payload once
+///   - batch handlers (onBatch) are called once with all events of the type
+/// Events queued by handlers during a flush are delivered on the next flush.
+/// Queued events cannot be cancelled by their emitter, and cancelling inside
+/// a per-event handler only stops later per-event handlers for that event.
 class EventBus {
 public:
     EventBus() = default;
 
+    /// Intern an event name (convenience forward to EventNames::intern).
+    static EventId intern(std::string_view eventName) { return EventNames::intern(eventName); }
+
     /// Subscribe to an event. Lower priority = called first.
     /// Returns a handler ID for later unsubscription.
-    EventHandlerId on(const std::string& eventName, EventHandler handler, int priority = 0) {
+    /// With coalesce=true, queued duplicates (same payload) are delivered to
+    /// this handler once per flush; immediate emits are unaffected.
+    EventHandlerId on(EventId eventId, EventHandler handler, int priority = 0,
+                      bool coalesce = false) {
         EventHandlerId id = m_nextId++;
-        m_handlers[eventName].push_back({id, priority, std::move(handler)});
-        sortHandlers(eventName);
+        HandlerEntry entry{id, priority, false, coalesce, std::move(handler), {}};
+        if (m_dispatchDepth > 0) {
+            m_pendingAdds.push_back({eventId, std::move(entry)});
+            m_hasDeferred = true;
+        } else {
+            insertSorted(eventId, std::move(entry));
+        }
         return id;
     }
 
+    EventHandlerId on(std::string_view eventName, EventHandler handler, int priority = 0,
+                      bool coalesce = false) {
+        return on(EventNames::intern(eventName), std::move(handler), priority, coalesce);
+    }
+
+    /// Subscribe a batch handler. It is called once per flushQueued() with
+    /// every queued event of the type (and with a single-element span for
+    /// immediate emits that were not cancelled). Shares the ID space of on().
+    EventHandlerId onBatch(EventId eventId, EventBatchHandler handler, int priority = 0) {
+        EventHandlerId id = m_nextId++;
+        HandlerEntry entry{id, priority, false, false, {}, std::move(handler)};
+        if (m_dispatchDepth > 0) {
+            m_pendingAdds.push_back({eventId, std::move(entry)});
+            m_hasDeferred = true;
+        } else {
+            insertSorted(eventId, std::move(entry));
+        }
+        return id;
+    }
+
+    EventHandlerId onBatch(std::string_view eventName, EventBatchHandler handler, int priority = 0) {
+        return onBatch(EventNames::intern(eventName), std::move(handler), priority);
+    }
+
     /// Unsubscribe a handler by ID
     bool off(EventHandlerId id) {
-        for (auto& [name, handlers] : m_handlers) {
+        for (auto& handlers : m_handlers) {
             auto it = std::find_if(handlers.begin(), handlers.end(),
-                [id](const HandlerEntry& entry) { return entry.id == id; });
+                [id](const HandlerEntry& entry) { return entry.id == id && !entry.removed; });
             if (it != handlers.end()) {
-                handlers.erase(it);
+                removeAt(handlers, it);
                 return true;
             }
         }
+        auto pit = std::find_if(m_pendingAdds.begin(), m_pendingAdds.end(),
+            [id](const PendingAdd& p) { return p.entry.id == id; });
+        if (pit != m_pendingAdds.end()) {
+            m_pendingAdds.erase(pit);
+            return true;
+        }
         return false;
     }
 
     /// Unsubscribe all handlers for an event
-    void offAll(const std::string& eventName) {
-        m_handlers.erase(eventName);
+    void offAll(EventId eventId) {
+        if (eventId < m_handlers.size()) {
+            auto& handlers = m_handlers[eventId];
+            if (m_dispatchDepth > 0) {
+                for (auto& h : handlers) h.removed = true;
+                m_hasDeferred = true;
+            } else {
+                handlers.clear();
+            }
+        }
+        m_pendingAdds.erase(std::remove_if(m_pendingAdds.begin(), m_pendingAdds.end(),
+            [eventId](const PendingAdd& p) { return p.eventId == eventId; }), m_pendingAdds.end());
+    }
+
+    void offAll(std::string_view eventName) {
+        EventId id = EventNames::find(eventName);
+        if (id != EventNames::kInvalid) offAll(id);
     }
 
     /// Emit an event, calling all handlers in priority order.
     /// Returns true if the event was cancelled by a handler.
-    bool emit(const std::string& eventName, const EventData& data = {}) {
-        auto it = m_handlers.find(eventName);
-        if (it == m_handlers.end()) return false;
+    bool emit(EventId eventId, const EventData& data = {}) {
+        if (isDeferred(eventId)) {
+            queue(eventId, data);
+            return false;
+        }
+        if (eventId >= m_handlers.size()) return false;
 
-        // Copy handlers to allow safe modification during iteration
-        auto handlers = it->second;
-        for (const auto& handler : handlers) {
+        // Subscriptions are deferred while m_dispatchDepth > 0, so neither
+        // m_handlers nor this list can grow or reallocate during the loop.
+        DispatchGuard guard(*this);
+        const auto& handlers = m_handlers[eventId];
+        const size_t count = handlers.size();
+        for (size_t i = 0; i < count; ++i) {
+            const HandlerEntry& handler = handlers[i];
+            if (handler.removed || handler.isBatch()) continue;
             if (handler.callback(data)) {
                 return true;  // Event cancelled
             }
         }
+        for (size_t i = 0; i < count; ++i) {
+            const HandlerEntry& handler = handlers[i];
+            if (!handler.removed && handler.isBatch()) {
+                handler.batchCallback(std::span<const EventData>(&data, 1));
+            }
+        }
         return false;
     }
 
+    bool emit(std::string_view eventName, const EventData& data = {}) {
+        EventId id = EventNames::find(eventName);
+        return id != EventNames::kInvalid ? emit(id, data) : false;
+    }
+
+    // ---- Queued mode ----
+
+    /// Append an event to the per-frame queue; handlers run on flushQueued().
+    /// Returns false (and counts a drop) if the queue is at capacity.
+    bool queue(EventId eventId, const EventData& data = {}) {
+        if (m_queuedCount >= m_maxQueued) {
+            ++m_droppedCount;
+            return false;
+        }
+        auto& lists = m_queues[m_writeQueue];
+        if (eventId >= lists.size()) lists.resize(static_cast<size_t>(eventId) + 1);
+        auto& list = lists[eventId];
+        if (list.empty()) m_queueOrder[m_writeQueue].push_back(eventId);
+        list.push_back(data);
+        ++m_queuedCount;
+        return true;
+    }
+
+    bool queue(std::string_view eventName, const EventData& data = {}) {
+        return queue(EventNames::intern(eventName), data);
+    }
+
+    /// Route emit() for an event type through the queue.
+    void setDeferred(EventId eventId, bool deferred) {
+        if (eventId >= m_deferred.size()) {
+            if (!deferred) return;
+            m_deferred.resize(static_cast<size_t>(eventId) + 1, 0);
+        }
+        m_deferred[eventId] = deferred ? 1 : 0;
+    }
+
+    void setDeferred(std::string_view eventName, bool deferred) {
+        setDeferred(EventNames::intern(eventName), deferred);
+    }
+
+    bool isDeferred(EventId eventId) const {
+        return eventId < m_deferred.size() && m_deferred[eventId] != 0;
+    }
+
+    /// Deliver all queued events. Returns the number of events delivered.
+    size_t flushQueued() {
+        if (m_queuedCount == 0 || m_flushing) return 0;
+        struct FlushGuard {
+            bool& flag;
+            explicit FlushGuard(bool& f) : flag(f) { flag = true; }
+            ~FlushGuard() { flag = false; }
+        } flushGuard(m_flushing);
+
+        // Swap buffers so handlers that queue more events write to the
+        // other side (delivered next flush) while we drain this one.
+        const int readQueue = m_writeQueue;
+        m_writeQueue ^= 1;
+        m_queuedCount = 0;
+
+        size_t delivered = 0;
+        auto& order = m_queueOrder[readQueue];
+        auto& lists = m_queues[readQueue];
+        for (size_t o = 0; o < order.size(); ++o) {
+            EventId eventId = order[o];
+            auto& events = lists[eventId];
+            dispatchQueued(eventId, events);
+            delivered += events.size();
+            events.clear();  // keeps capacity for the next frame
+        }
+        order.clear();
+        return delivered;
+    }
+
+    /// Number of events waiting for the next flushQueued().
+    size_t queuedCount() const { return m_queuedCount; }
+
+    /// Events rejected because the queue was full (since construction).
+    uint64_t droppedCount() const { return m_droppedCount; }
+
+    /// Cap on events queued between flushes (default 65536).
+    void setMaxQueuedEvents(size_t maxEvents) { m_maxQueued = maxEvents; }
+    size_t maxQueuedEvents() const { return m_maxQueued; }
+
+    /// Drop queued events without delivering them.
+    /// During a flush only the not-yet-delivered side is cleared.
+    void clearQueued() {
+        for (int q = 0; q < 2; ++q) {
+            if (m_flushing && q != m_writeQueue) continue;
+            for (EventId eventId : m_queueOrder[q]) m_queues[q][eventId].clear();
+            m_queueOrder[q].clear();
+        }
+        m_queuedCount = 0;
+    }
+
     /// Get the number of handlers for an event
-    size_t handlerCount(const std::string& eventName) const {
-        auto it = m_handlers.find(eventName);
-        return it != m_handlers.end() ? it->second.size() : 0;
+    size_t handlerCount(EventId eventId) const {
+        size_t count = 0;
+        if (eventId < m_handlers.size()) {
+            for (const auto& h : m_handlers[eventId]) {
+                if (!h.removed) ++count;
+            }
+        }
+        for (const auto& p : m_pendingAdds) {
+            if (p.eventId == eventId) ++count;
+        }
+        return count;
+    }
+
+    size_t handlerCount(std::string_view eventName) const {
+        EventId id = EventNames::find(eventName);
+        return id != EventNames::kInvalid ? handlerCount(id) : 0;
     }
 
-    /// Clear all handlers
+    /// Whether any handler is subscribed to an event (cheap pre-check that lets
+    /// emit sites skip building an EventData nobody will read).
+    bool hasHandlers(EventId eventId) const {
+        return handlerCount(eventId) > 0;
+    }
+
+    /// Clear all handlers (queued events and deferred flags are kept)
     void clear() {
-        m_handlers.clear();
+        if (m_dispatchDepth > 0) {
+            for (auto& handlers : m_handlers) {
+                for (auto& h : handlers) h.removed = true;
+            }
+            m_hasDeferred = true;
+        } else {
+            m_handlers.clear();
+        }
+        m_pendingAdds.clear();
     }
 
 private:
     struct HandlerEntry {
         EventHandlerId id;
         int priority;
-        EventHandler callback;
+        bool removed;
+        bool coalesce;
+        EventHandler callback;            // set for per-event handlers
+        EventBatchHandler batchCallback;  // set for batch handlers
+
+        bool isBatch() const { return static_cast<bool>(batchCallback); }
+    };
+
+    struct PendingAdd {
+        EventId eventId;
+        HandlerEntry entry;
     };
 
-    void sortHandlers(const std::string& eventName) {
-        auto& handlers = m_handlers[eventName];
-        std::stable_sort(handlers.begin(), handlers.end(),
-            [](const HandlerEntry& a, const HandlerEntry& b) {
-                return a.priority < b.priority;
-            });
+    struct DispatchGuard {
+        explicit DispatchGuard(EventBus& bus) : bus(bus) { ++bus.m_dispatchDepth; }
+        ~DispatchGuard() {
+            if (--bus.m_dispatchDepth == 0 && bus.m_hasDeferred) {
+                bus.applyDeferred();
+            }
+        }
+        EventBus& bus;
+    };
+
+    void insertSorted(EventId eventId, HandlerEntry entry) {
+        if (eventId >= m_handlers.size()) {
+            m_handlers.resize(static_cast<size_t>(eventId) + 1);
+        }
+        auto& handlers = m_handlers[eventId];
+        // upper_bound keeps equal-priority handlers in subscription order
+        auto pos = std::upper_bound(handlers.begin(), handlers.end(), entry.priority,
+            [](int priority, const HandlerEntry& h) { return priority < h.priority; });
+        handlers.insert(pos, std::move(entry));
     }
 
-    std::unordered_map<std::string, std::vector<HandlerEntry>> m_handlers;
+    void removeAt(std::vector<HandlerEntry>& handlers, std::vector<HandlerEntry>::iterator it) {
+        if (m_dispatchDepth > 0) {
+            // The handler may be the one currently executing — keep it alive
+            it->removed = true;
+            m_hasDeferred = true;
+        } else {
+            handlers.erase(it);
+        }
+    }
+
+    void dispatchQueued(EventId eventId, const std::vector<EventData>& events) {
+        if (eventId >= m_handlers.size() || events.empty()) return;
+
+        DispatchGuard guard(*this);
+        const auto& handlers = m_handlers[eventId];
+        const size_t count = handlers.size();
+
+        bool anyCoalesce = false;
+        for (size_t i = 0; i < count; ++i) {
+            anyCoalesce |= (!handlers[i].removed && handlers[i].coalesce);
+        }
+        if (anyCoalesce) markDuplicates(events);
+
+        for (size_t e = 0; e < events.size(); ++e) {
+            for (size_t i = 0; i < count; ++i) {
+                const HandlerEntry& handler = handlers[i];
+                if (handler.removed || handler.isBatch()) continue;
+                if (handler.coalesce && m_duplicate[e]) continue;
+                if (handler.callback(events[e])) break;  // cancelled for this event
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const HandlerEntry& handler = handlers[i];
+            if (!handler.removed && handler.isBatch()) {
+                handler.batchCallback(std::span<const EventData>(events.data(), events.size()));
+            }
+        }
+    }
+
+    /// Fill m_duplicate[i] = true for every event equal to an earlier one.
+    /// Sorts indices by payload hash so this is O(n log n); scratch buffers
+    /// are members so steady-state flushes do not allocate.
+    void markDuplicates(const std::vector<EventData>& events) {
+        const size_t n = events.size();
+        m_duplicate.assign(n, 0);
+        m_dupOrder.resize(n);
+        for (size_t i = 0; i < n; ++i) m_dupOrder[i] = {events[i].hash(), static_cast<uint32_t>(i)};
+        std::sort(m_dupOrder.begin(), m_dupOrder.end());
+
+        for (size_t a = 0; a < n; ) {
+            size_t b = a + 1;
+            while (b < n && m_dupOrder[b].first == m_dupOrder[a].first) ++b;
+            // [a, b) share a hash; within it, indices are ascending
+            for (size_t i = a + 1; i < b; ++i) {
+                for (size_t j = a; j < i; ++j) {
+                    if (!m_duplicate[m_dupOrder[j].second] &&
+                        events[m_dupOrder[i].second] == events[m_dupOrder[j].second]) {
+                        m_duplicate[m_dupOrder[i].second] = 1;
+                        break;
+                    }
+                }
+            }
+            a = b;
+        }
+    }
+
+    void applyDeferred() {
+        m_hasDeferred = false;
+        for (auto& handlers : m_handlers) {
+            handlers.erase(std::remove_if(handlers.begin(), handlers.end(),
+                [](const HandlerEntry& h) { return h.removed; }), handlers.end());
+        }
+        auto pending = std::move(m_pendingAdds);
+        m_pendingAdds.clear();
+        for (auto& p : pending) {
+            insertSorted(p.eventId, std::move(p.entry));
+        }
+    }
+
+    std::vector<std::vector<HandlerEntry>> m_handlers;  // indexed by EventId
+    std::vector<PendingAdd> m_pendingAdds;
+
+    // Queued mode: double-buffered per-type event lists (indexed by EventId)
+    // plus the order in which each type was first queued this frame.
+    std::vector<std::vector<EventData>> m_queues[2];
+    std::vector<EventId> m_queueOrder[2];
+    int m_writeQueue = 0;
+    size_t m_queuedCount = 0;
+    size_t m_maxQueued = 65536;
+    uint64_t m_droppedCount = 0;
+    bool m_flushing = false;
+    std::vector<uint8_t> m_deferred;  // indexed by EventId
+
+    // Coalescing scratch
+    std::vector<uint8_t> m_duplicate;
+    std::vector<std::pair<size_t, uint32_t>> m_dupOrder;
+
     EventHandlerId m_nextId = 1;
+    int m_dispatchDepth = 0;
+    bool m_hasDeferred = false;
 };
 
 } // namespace gloaming
@@ -1,65 +1,258 @@
 #include "mod/HotReload.hpp"
 #include "engine/Log.hpp"
 
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <cerrno>
+#include <unistd.h>
+#endif
+
 namespace fs = std::filesystem;
 
 namespace gloaming {
 
+#ifdef __linux__
+namespace {
+
+// Writes surface as IN_CLOSE_WRITE (or IN_MODIFY for writers that keep the
+// file open); atomic saves surface as IN_MOVED_TO on the final name
+constexpr uint32_t kWatchMask = IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_DELETE |
+                                IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+constexpr size_t kEventBufferSize = 64 * 1024;
+
+} // namespace
+#endif
+
+HotReload::HotReload(bool preferEvents) {
+#ifdef __linux__
+    if (preferEvents) {
+        m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotifyFd < 0) {
+            LOG_WARN("HotReload: inotify unavailable ({}), falling back to polling",
+                     std::strerror(errno));
+        } else {
+            m_eventBuffer.resize(kEventBufferSize);
+        }
+    }
+#else
+    (void)preferEvents;
+#endif
+}
+
+HotReload::~HotReload() {
+    unwatchAll();
+#ifdef __linux__
+    if (m_inotifyFd >= 0) {
+        close(m_inotifyFd);
+    }
+#endif
+}
+
 void HotReload::watchMod(const std::string& modId, const std::string& directory) {
     if (!fs::exists(directory) || !fs::is_directory(directory)) {
         LOG_WARN("HotReload: directory '{}' does not exist for mod '{}'", directory, modId);
         return;
     }
 
-    WatchedMod watch;
+    unwatchMod(modId);
+
+    WatchedMod& watch = m_watchedMods[modId];
     watch.modId = modId;
     watch.directory = directory;
-    watch.fileTimestamps = scanDirectory(directory);
 
-    m_watchedMods[modId] = std::move(watch);
-    LOG_DEBUG("HotReload: watching mod '{}' ({} files)", modId,
-             m_watchedMods[modId].fileTimestamps.size());
+    // Event-driven when every directory could be watched; otherwise (no
+    // inotify, or the per-user watch limit was hit) fall back to scanning
+    watch.polled = m_inotifyFd < 0 || !addDirectoryWatches(watch, directory);
+    if (watch.polled) {
+        removeWatches(watch);
+        watch.fileTimestamps = scanDirectory(directory);
+        LOG_DEBUG("HotReload: watching mod '{}' ({} files, polling)", modId,
+                  watch.fileTimestamps.size());
+    } else {
+        LOG_DEBUG("HotReload: watching mod '{}' ({} directories, inotify)", modId,
+                  watch.watchDescriptors.size());
+    }
 }
 
 void HotReload::unwatchMod(const std::string& modId) {
-    m_watchedMods.erase(modId);
+    auto it = m_watchedMods.find(modId);
+    if (it == m_watchedMods.end()) return;
+    removeWatches(it->second);
+    m_watchedMods.erase(it);
 }
 
 void HotReload::unwatchAll() {
+    for (auto& [modId, watch] : m_watchedMods) {
+        removeWatches(watch);
+    }
     m_watchedMods.clear();
 }
 
 bool HotReload::poll() {
     auto now = Clock::now();
+
+    if (m_inotifyFd >= 0) {
+        readEvents(now);
+    }
+
     auto elapsed = std::chrono::duration<float>(now - m_lastPollTime).count();
-    if (elapsed < m_pollIntervalSeconds) {
-        return false;
+    if (elapsed >= m_pollIntervalSeconds) {
+        m_lastPollTime = now;
+        scanForChanges(now);
+    }
+
+    // Report mods whose changes have settled. Callbacks run after the scan
+    // since they may watch or unwatch mods.
+    std::vector<std::pair<std::string, std::vector<std::string>>> ready;
+    for (auto& [modId, watch] : m_watchedMods) {
+        if (watch.pending.empty()) continue;
+        if (std::chrono::duration<float>(now - watch.lastChange).count() < m_debounceSeconds) {
+            continue;
+        }
+
+        std::vector<std::string> changed(watch.pending.begin(), watch.pending.end());
+        std::sort(changed.begin(), changed.end());
+        watch.pending.clear();
+        ready.emplace_back(modId, std::move(changed));
+    }
+
+    for (const auto& [modId, changed] : ready) {
+        LOG_INFO("HotReload: {} file(s) changed in mod '{}'", changed.size(), modId);
+        for (const auto& file : changed) {
+            LOG_DEBUG("HotReload:   changed: {}", file);
+        }
+
+        if (m_callback) {
+            m_callback(modId, changed);
+        }
     }
-    m_lastPollTime = now;
 
-    bool anyChanges = false;
+    return !ready.empty();
+}
 
+void HotReload::scanForChanges(TimePoint now) {
     for (auto& [modId, watch] : m_watchedMods) {
+        if (!watch.polled) continue;
+
         auto currentState = scanDirectory(watch.directory);
         auto changed = detectChanges(watch.fileTimestamps, currentState);
+        if (changed.empty()) continue;
+
+        watch.pending.insert(changed.begin(), changed.end());
+        watch.lastChange = now;
+        watch.fileTimestamps = std::move(currentState);
+    }
+}
+
+void HotReload::readEvents(TimePoint now) {
+#ifdef __linux__
+    for (;;) {
+        ssize_t length = read(m_inotifyFd, m_eventBuffer.data(), m_eventBuffer.size());
+        if (length <= 0) break;     // EAGAIN: queue drained
+
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(&m_eventBuffer[offset]);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            // Queue overflowed: changes were lost, so report whole mods
+            if (event->mask & IN_Q_OVERFLOW) {
+                LOG_WARN("HotReload: inotify queue overflowed, reloading all watched mods");
+                for (auto& [modId, watch] : m_watchedMods) {
+                    watch.pending.insert(watch.directory);
+                    watch.lastChange = now;
+                }
+                continue;
+            }
+
+            auto dirIt = m_watchedDirs.find(event->wd);
+            if (dirIt == m_watchedDirs.end()) continue;
+
+            auto modIt = m_watchedMods.find(dirIt->second.modId);
+            if (modIt == m_watchedMods.end()) continue;
+            WatchedMod& watch = modIt->second;
 
-        if (!changed.empty()) {
-            LOG_INFO("HotReload: {} file(s) changed in mod '{}'", changed.size(), modId);
-            for (const auto& file : changed) {
-                LOG_DEBUG("HotReload:   changed: {}", file);
+            // The directory itself went away
+            if (event->mask & IN_IGNORED) {
+                auto& wds = watch.watchDescriptors;
+                wds.erase(std::remove(wds.begin(), wds.end(), event->wd), wds.end());
+                m_watchedDirs.erase(dirIt);
+                continue;
             }
 
-            if (m_callback) {
-                m_callback(modId, changed);
+            fs::path path = dirIt->second.path;
+            if (event->len > 0) path /= event->name;
+
+            // New subdirectory: watch it, and pick up files written into it
+            // before the watch existed
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    addDirectoryWatches(watch, path.string());
+                    for (const auto& [file, time] : scanDirectory(path.string())) {
+                        watch.pending.insert(file);
+                        watch.lastChange = now;
+                    }
+                }
+                continue;
             }
 
-            // Update stored timestamps
-            watch.fileTimestamps = std::move(currentState);
-            anyChanges = true;
+            if (!isWatchedFile(path)) continue;
+            watch.pending.insert(path.string());
+            watch.lastChange = now;
+        }
+    }
+#else
+    (void)now;
+#endif
+}
+
+bool HotReload::addDirectoryWatches(WatchedMod& mod, const std::string& directory) {
+#ifdef __linux__
+    auto addWatch = [&](const std::string& path) {
+        int wd = inotify_add_watch(m_inotifyFd, path.c_str(), kWatchMask);
+        if (wd < 0) {
+            LOG_WARN("HotReload: cannot watch '{}': {}", path, std::strerror(errno));
+            return false;
+        }
+        m_watchedDirs[wd] = {mod.modId, path};
+        mod.watchDescriptors.push_back(wd);
+        return true;
+    };
+
+    if (!addWatch(directory)) return false;
+    try {
+        for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+            if (entry.is_directory() && !addWatch(entry.path().string())) return false;
         }
+    } catch (const fs::filesystem_error& e) {
+        LOG_WARN("HotReload: error scanning directory '{}': {}", directory, e.what());
+        return false;
     }
+    return true;
+#else
+    (void)mod;
+    (void)directory;
+    return false;
+#endif
+}
+
+void HotReload::removeWatches(WatchedMod& mod) {
+#ifdef __linux__
+    for (int wd : mod.watchDescriptors) {
+        inotify_rm_watch(m_inotifyFd, wd);
+        m_watchedDirs.erase(wd);
+    }
+#endif
+    mod.watchDescriptors.clear();
+}
 
-    return anyChanges;
+bool HotReload::isWatchedFile(const fs::path& path) {
+    std::string ext = path.extension().string();
+    return ext == ".lua" || ext == ".json" || ext == ".png" || ext == ".ogg"
+        || ext == ".wav" || ext == ".frag" || ext == ".vert";
 }
 
 std::unordered_map<std::string, HotReload::FileTime>
@@ -71,9 +264,7 @@ HotReload::scanDirectory(const std::string& dir) {
             if (!entry.is_regular_file()) continue;
 
             // Only watch relevant file types
-            std::string ext = entry.path().extension().string();
-            if (ext == ".lua" || ext == ".json" || ext == ".png" || ext == ".ogg"
-                || ext == ".wav" || ext == ".frag" || ext == ".vert") {
+            if (isWatchedFile(entry.path())) {
                 timestamps[entry.path().string()] = entry.last_write_time();
             }
         }
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <filesystem>
 #include <chrono>
@@ -10,13 +11,30 @@
 namespace gloaming {
 
 /// Tracks file modifications for hot-reloading mod content in debug builds.
-/// Uses polling (portable across platforms, no inotify/FSEvents dependency).
+///
+/// On Linux, changes arrive as inotify events, so an idle poll() is a single
+/// non-blocking read. Elsewhere (or if inotify is unavailable) each poll
+/// rescans the watched directories and diffs file timestamps.
+///
+/// Either way, changes are collected per mod and the callback fires once
+/// with all of them after the mod's files have been quiet for the debounce
+/// window, so an editor's write-rename-touch save pattern triggers one reload.
 class HotReload {
 public:
     using ReloadCallback = std::function<void(const std::string& modId,
                                              const std::vector<std::string>& changedFiles)>;
 
-    HotReload() = default;
+    enum class Backend {
+        Polling,        ///< Timestamp scan every poll interval
+        Inotify         ///< Kernel change events (Linux)
+    };
+
+    /// `preferEvents` = false forces the polling backend.
+    explicit HotReload(bool preferEvents = true);
+    ~HotReload();
+
+    HotReload(const HotReload&) = delete;
+    HotReload& operator=(const HotReload&) = delete;
 
     /// Start watching a mod directory.
     void watchMod(const std::string& modId, const std::string& directory);
@@ -30,13 +48,20 @@ public:
     /// Set the callback for when changes are detected.
     void setCallback(ReloadCallback callback) { m_callback = std::move(callback); }
 
-    /// Poll for changes. Call this periodically (e.g. once per second).
-    /// Returns true if any changes were detected and the callback was invoked.
+    /// Collect changes and invoke the callback for mods whose changes have
+    /// settled. Cheap enough to call every frame with the inotify backend.
+    /// Returns true if the callback was invoked.
     bool poll();
 
-    /// Set polling interval (minimum time between checks).
+    /// Set polling interval (minimum time between scans, polling backend only).
     void setPollInterval(float seconds) { m_pollIntervalSeconds = seconds; }
 
+    /// Quiet time after a mod's last change before its reload fires.
+    void setDebounce(float seconds) { m_debounceSeconds = seconds; }
+
+    /// Backend in use.
+    Backend backend() const { return m_inotifyFd >= 0 ? Backend::Inotify : Backend::Polling; }
+
     /// Check if any mods are being watched.
     bool isWatching() const { return !m_watchedMods.empty(); }
 
@@ -51,7 +76,17 @@ private:
     struct WatchedMod {
         std::string modId;
         std::string directory;
-        std::unordered_map<std::string, FileTime> fileTimestamps;
+        std::unordered_map<std::string, FileTime> fileTimestamps;  ///< When polled
+        std::vector<int> watchDescriptors;                        ///< When event-driven
+        std::unordered_set<std::string> pending;                  ///< Changed, not yet reported
+        TimePoint lastChange;
+        bool polled = true;         ///< Scanned each interval (no inotify watches)
+    };
+
+    /// Directory covered by one inotify watch
+    struct WatchedDir {
+        std::string modId;
+        std::string path;
     };
 
     /// Scan a directory and record all file timestamps.
@@ -62,10 +97,22 @@ private:
         const std::unordered_map<std::string, FileTime>& oldState,
         const std::unordered_map<std::string, FileTime>& newState);
 
+    /// File types that trigger a reload
+    static bool isWatchedFile(const std::filesystem::path& path);
+
+    void scanForChanges(TimePoint now);
+    void readEvents(TimePoint now);
+    bool addDirectoryWatches(WatchedMod& mod, const std::string& directory);
+    void removeWatches(WatchedMod& mod);
+
     std::unordered_map<std::string, WatchedMod> m_watchedMods;
+    std::unordered_map<int, WatchedDir> m_watchedDirs;      ///< By inotify watch descriptor
     ReloadCallback m_callback;
     float m_pollIntervalSeconds = 1.0f;
+    float m_debounceSeconds = 0.1f;
     TimePoint m_lastPollTime = Clock::now();
+    int m_inotifyFd = -1;
+    std::vector<char> m_eventBuffer;
 };
 
 } // namespace gloaming
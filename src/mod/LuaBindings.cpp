@@ -63,13 +63,23 @@ bool LuaBindings::init(Engine& engine, ContentRegistry& registry, EventBus& even
     bindUIAPI();
     bindUtilAPI();
 
+    // Measure the collector's baseline once the engine APIs are in place
+    m_gcScheduler.attach(m_lua.lua_state());
+
     m_initialized = true;
     LOG_INFO("LuaBindings: initialized successfully");
     return true;
 }
 
+LuaBindings::~LuaBindings() {
+    m_cpuBudget.detach();
+    m_gcScheduler.detach();
+}
+
 void LuaBindings::shutdown() {
     // The sol::state destructor handles cleanup
+    m_cpuBudget.detach();
+    m_gcScheduler.detach();
     m_initialized = false;
     m_engine = nullptr;
     m_registry = nullptr;
@@ -101,10 +111,8 @@ void LuaBindings::applySandbox() {
     // We keep 'require' but it will be overridden per-mod to scope to the mod's directory
     m_lua["require"] = sol::nil;
 
-    // Set instruction count limit to prevent infinite loops (10 million instructions)
-    lua_sethook(m_lua.lua_state(), [](lua_State* L, lua_Debug*) {
-        luaL_error(L, "instruction limit exceeded (possible infinite loop)");
-    }, LUA_MASKCOUNT, 10000000);
+    // Instruction/time limits per callback (infinite loops abort with an error)
+    m_cpuBudget.attach(m_lua.lua_state());
 
     LOG_DEBUG("LuaBindings: sandbox applied");
 }
@@ -265,14 +273,54 @@ void LuaBindings::bindContentAPI() {
     };
 }
 
+/// Convert a Lua table to an EventData payload (string keys only).
+static EventData tableToEventData(const sol::table& table) {
+    EventData data;
+    table.for_each([&data](const sol::object& key, const sol::object& value) {
+        if (!key.is<std::string>()) return;
+        std::string k = key.as<std::string>();
+        if (value.is<std::string>()) {
+            data.setString(k, value.as<std::string>());
+        } else if (value.is<bool>()) {
+            data.setBool(k, value.as<bool>());
+        } else if (value.is<int>()) {
+            data.setInt(k, value.as<int>());
+        } else if (value.is<float>() || value.is<double>()) {
+            data.setFloat(k, value.as<float>());
+        }
+    });
+    return data;
+}
+
+/// Convert an EventData payload to a Lua table (used for batch handlers).
+static sol::table eventDataToTable(sol::state_view lua, const EventData& data) {
+    sol::table t = lua.create_table(0, static_cast<int>(data.size()));
+    data.forEach([&t](EventKey key, EventData::Type type, const EventData& d) {
+        const std::string& name = EventNames::name(key);
+        switch (type) {
+            case EventData::Type::Int:    t[name] = d.getInt(key); break;
+            case EventData::Type::Float:  t[name] = d.getFloat(key); break;
+            case EventData::Type::Bool:   t[name] = d.getBool(key); break;
+            case EventData::Type::String: t[name] = d.getStringView(key); break;
+        }
+    });
+    return t;
+}
+
 void LuaBindings::bindEventsAPI() {
     auto events = m_lua.create_named_table("events");
 
-    // events.on(eventName, handler) — subscribe to an event
-    events["on"] = [this](const std::string& eventName, sol::function handler,
-                          sol::optional<int> priority) -> uint64_t {
+    // events.on(eventName, handler [, priority] [, options]) — subscribe to an event
+    // options = { coalesce = true } — receive each distinct queued payload once per frame
+    events["on"] = [this](const std::string& eventName, sol::protected_function handler,
+                          sol::optional<int> priority,
+                          sol::optional<sol::table> options) -> uint64_t {
         int prio = priority.value_or(0);
-        return m_eventBus->on(eventName, [handler](const EventData& data) -> bool {
+        bool coalesce = options ? options->get_or("coalesce", false) : false;
+        LuaCpuBudget* budget = &m_cpuBudget;
+        LuaCpuBudget::ModHandle owner = m_cpuBudget.currentMod();
+        return m_eventBus->on(eventName, [handler, budget, owner](const EventData& data) -> bool {
+            LuaCpuBudget::Scope scope(budget, owner);
             // Convert EventData to a Lua table for the handler
             try {
                 sol::protected_function_result result = handler(std::cref(data));
@@ -289,7 +337,35 @@ void LuaBindings::bindEventsAPI() {
                 MOD_LOG_ERROR("Event handler exception: {}", e.what());
             }
             return false;
-        }, prio);
+        }, prio, coalesce);
+    };
+
+    // events.on_batch(eventName, handler [, priority]) — receive all queued events
+    // of a type once per frame as an array of payload tables (one Lua call per
+    // type instead of one per event)
+    events["on_batch"] = [this](const std::string& eventName, sol::protected_function handler,
+                                sol::optional<int> priority) -> uint64_t {
+        lua_State* L = m_lua.lua_state();
+        LuaCpuBudget* budget = &m_cpuBudget;
+        LuaCpuBudget::ModHandle owner = m_cpuBudget.currentMod();
+        return m_eventBus->onBatch(eventName,
+            [handler, L, budget, owner](std::span<const EventData> batch) {
+                LuaCpuBudget::Scope scope(budget, owner);
+                try {
+                    sol::state_view lua(L);
+                    sol::table list = lua.create_table(static_cast<int>(batch.size()), 0);
+                    for (size_t i = 0; i < batch.size(); ++i) {
+                        list[i + 1] = eventDataToTable(lua, batch[i]);
+                    }
+                    sol::protected_function_result result = handler(list);
+                    if (!result.valid()) {
+                        sol::error err = result;
+                        MOD_LOG_ERROR("Batch event handler error: {}", err.what());
+                    }
+                } catch (const std::exception& e) {
+                    MOD_LOG_ERROR("Batch event handler exception: {}", e.what());
+                }
+            }, priority.value_or(0));
     };
 
     // events.off(handlerId) — unsubscribe
@@ -301,23 +377,24 @@ void LuaBindings::bindEventsAPI() {
     events["emit"] = [this](const std::string& eventName, sol::optional<sol::table> dataTable) {
         EventData data;
         if (dataTable) {
-            // Convert Lua table to EventData
-            dataTable->for_each([&data](const sol::object& key, const sol::object& value) {
-                if (!key.is<std::string>()) return;
-                std::string k = key.as<std::string>();
-                if (value.is<std::string>()) {
-                    data.setString(k, value.as<std::string>());
-                } else if (value.is<bool>()) {
-                    data.setBool(k, value.as<bool>());
-                } else if (value.is<int>()) {
-                    data.setInt(k, value.as<int>());
-                } else if (value.is<float>() || value.is<double>()) {
-                    data.setFloat(k, value.as<float>());
-                }
-            });
+            data = tableToEventData(*dataTable);
         }
         return m_eventBus->emit(eventName, data);
     };
+
+    // events.queue(eventName, data_table) — queue an event for end-of-update delivery
+    events["queue"] = [this](const std::string& eventName, sol::optional<sol::table> dataTable) {
+        EventData data;
+        if (dataTable) {
+            data = tableToEventData(*dataTable);
+        }
+        return m_eventBus->queue(eventName, data);
+    };
+
+    // events.set_deferred(eventName, enabled) — route emits of this event through the queue
+    events["set_deferred"] = [this](const std::string& eventName, bool deferred) {
+        m_eventBus->setDeferred(eventName, deferred);
+    };
 }
 
 void LuaBindings::bindAudioAPI() {
@@ -728,12 +805,12 @@ void LuaBindings::bindUIAPI() {
     ui["Button"] = [this](sol::optional<sol::table> props) -> std::shared_ptr<UIElement> {
         std::string id, label;
         sol::optional<sol::table> styleTable;
-        sol::optional<sol::function> onClick;
+        sol::optional<sol::protected_function> onClick;
         if (props) {
             id = props->get_or<std::string>("id", "");
             label = props->get_or<std::string>("label", "");
             styleTable = props->get<sol::optional<sol::table>>("style");
-            onClick = props->get<sol::optional<sol::function>>("on_click");
+            onClick = props->get<sol::optional<sol::protected_function>>("on_click");
 
             // Hover/press colors
             sol::optional<sol::table> hcObj = props->get<sol::optional<sol::table>>("hover_color");
@@ -741,20 +818,7 @@ void LuaBindings::bindUIAPI() {
 
             auto btn = std::make_shared<UIButton>(id, label);
             applyStyleTable(btn.get(), styleTable);
-            if (onClick) {
-                sol::function fn = *onClick;
-                btn->setOnClick([fn]() {
-                    try {
-                        sol::protected_function_result result = fn();
-                        if (!result.valid()) {
-                            sol::error err = result;
-                            MOD_LOG_ERROR("Button on_click error: {}", err.what());
-                        }
-                    } catch (const std::exception& e) {
-                        MOD_LOG_ERROR("Button on_click exception: {}", e.what());
-                    }
-                });
-            }
+            if (onClick) btn->setOnClick(modCallback(*onClick, "Button on_click"));
             if (hcObj) {
                 btn->setHoverColor(Color(
                     hcObj->get_or(1, 80), hcObj->get_or(2, 80),
@@ -775,7 +839,7 @@ void LuaBindings::bindUIAPI() {
         std::string id;
         float minVal = 0.0f, maxVal = 1.0f, value = 0.0f;
         sol::optional<sol::table> styleTable;
-        sol::optional<sol::function> onChange;
+        sol::optional<sol::protected_function> onChange;
 
         if (props) {
             id = props->get_or<std::string>("id", "");
@@ -783,7 +847,7 @@ void LuaBindings::bindUIAPI() {
             maxVal = props->get_or("max", 1.0f);
             value = props->get_or("value", 0.0f);
             styleTable = props->get<sol::optional<sol::table>>("style");
-            onChange = props->get<sol::optional<sol::function>>("on_change");
+            onChange = props->get<sol::optional<sol::protected_function>>("on_change");
         }
 
         auto slider = std::make_shared<UISlider>(id);
@@ -791,20 +855,7 @@ void LuaBindings::bindUIAPI() {
         slider->setValue(value);
         applyStyleTable(slider.get(), styleTable);
 
-        if (onChange) {
-            sol::function fn = *onChange;
-            slider->setOnChange([fn](float v) {
-                try {
-                    sol::protected_function_result result = fn(v);
-                    if (!result.valid()) {
-                        sol::error err = result;
-                        MOD_LOG_ERROR("Slider on_change error: {}", err.what());
-                    }
-                } catch (const std::exception& e) {
-                    MOD_LOG_ERROR("Slider on_change exception: {}", e.what());
-                }
-            });
-        }
+        if (onChange) slider->setOnChange(modCallback<float>(*onChange, "Slider on_change"));
 
         return std::static_pointer_cast<UIElement>(slider);
     };
@@ -854,7 +905,7 @@ void LuaBindings::bindUIAPI() {
     // ui.register(name, builderFunction)
     // The builder function is called to create the UI tree.
     // For static UIs, it's called once. For dynamic UIs, it's called every frame.
-    ui["register"] = [this](const std::string& name, sol::function builder) {
+    ui["register"] = [this](const std::string& name, sol::protected_function builder) {
         UISystem* uiSys = m_engine->getUISystem();
         if (!uiSys) {
             MOD_LOG_ERROR("ui.register: UI system not available");
@@ -879,14 +930,18 @@ void LuaBindings::bindUIAPI() {
 
     // ui.registerDynamic(name, builderFunction)
     // Builder is called every frame to rebuild the UI tree.
-    ui["registerDynamic"] = [this](const std::string& name, sol::function builder) {
+    ui["registerDynamic"] = [this](const std::string& name, sol::protected_function builder) {
         UISystem* uiSys = m_engine->getUISystem();
         if (!uiSys) {
             MOD_LOG_ERROR("ui.registerDynamic: UI system not available");
             return;
         }
 
-        uiSys->registerDynamicScreen(name, [builder]() -> std::shared_ptr<UIElement> {
+        // Rebuilt every frame, so charge it to the registering mod
+        LuaCpuBudget* budget = &m_cpuBudget;
+        LuaCpuBudget::ModHandle owner = m_cpuBudget.currentMod();
+        uiSys->registerDynamicScreen(name, [builder, budget, owner]() -> std::shared_ptr<UIElement> {
+            LuaCpuBudget::Scope scope(budget, owner);
             try {
                 sol::protected_function_result result = builder();
                 if (result.valid() && result.get_type() != sol::type::nil) {
@@ -1097,6 +1152,8 @@ void LuaBindings::bindUtilAPI() {
 }
 
 sol::environment LuaBindings::createModEnvironment(const std::string& modId) {
+    m_cpuBudget.registerMod(modId);
+
     // Create an environment that inherits from the global table (read-only)
     sol::environment env(m_lua, sol::create, m_lua.globals());
 
@@ -1128,14 +1185,13 @@ sol::environment LuaBindings::createModEnvironment(const std::string& modId) {
         }
 
         // Load and execute the file in the mod's environment
-        auto result = m_lua.load_file(path);
-        if (!result.valid()) {
-            sol::error err = result;
-            MOD_LOG_ERROR("[{}] require '{}': {}", modId, moduleName, err.what());
+        std::string loadError;
+        sol::protected_function chunk = loadScript(path, loadError);
+        if (!chunk.valid()) {
+            MOD_LOG_ERROR("[{}] require '{}': {}", modId, moduleName, loadError);
             return sol::nil;
         }
 
-        sol::protected_function chunk = result;
         sol::set_environment(callerEnv, chunk);
         auto execResult = chunk();
         if (!execResult.valid()) {
@@ -1153,17 +1209,22 @@ sol::environment LuaBindings::createModEnvironment(const std::string& modId) {
     return env;
 }
 
+LuaCpuBudget::ModHandle LuaBindings::envOwner(sol::environment& env) {
+    std::string modId = env["_MOD_ID"].get_or<std::string>("");
+    return modId.empty() ? LuaCpuBudget::kNoMod : m_cpuBudget.registerMod(modId);
+}
+
 bool LuaBindings::executeFile(const std::string& path, sol::environment& env) {
-    auto result = m_lua.load_file(path);
-    if (!result.valid()) {
-        sol::error err = result;
-        MOD_LOG_ERROR("LuaBindings: failed to load '{}': {}", path, err.what());
+    std::string loadError;
+    sol::protected_function chunk = loadScript(path, loadError);
+    if (!chunk.valid()) {
+        MOD_LOG_ERROR("LuaBindings: failed to load '{}': {}", path, loadError);
         return false;
     }
 
-    sol::protected_function chunk = result;
     sol::set_environment(env, chunk);
 
+    LuaCpuBudget::Scope scope(&m_cpuBudget, envOwner(env), LuaCpuBudget::Phase::Load);
     auto execResult = chunk();
     if (!execResult.valid()) {
         sol::error err = execResult;
@@ -1176,7 +1237,7 @@ bool LuaBindings::executeFile(const std::string& path, sol::environment& env) {
 
 bool LuaBindings::executeString(const std::string& code, sol::environment& env,
                                  const std::string& chunkName) {
-    auto result = m_lua.load(code, chunkName);
+    auto result = m_lua.load(code, chunkName, sol::load_mode::text);
     if (!result.valid()) {
         sol::error err = result;
         MOD_LOG_ERROR("LuaBindings: failed to load string '{}': {}", chunkName, err.what());
@@ -1186,6 +1247,7 @@ bool LuaBindings::executeString(const std::string& code, sol::environment& env,
     sol::protected_function chunk = result;
     sol::set_environment(env, chunk);
 
+    LuaCpuBudget::Scope scope(&m_cpuBudget, envOwner(env), LuaCpuBudget::Phase::Load);
     auto execResult = chunk();
     if (!execResult.valid()) {
         sol::error err = execResult;
@@ -1196,4 +1258,85 @@ bool LuaBindings::executeString(const std::string& code, sol::environment& env,
     return true;
 }
 
+// ============================================================================
+// Script loading and bytecode cache
+// ============================================================================
+
+/// lua_Writer appending each dumped block to a std::string
+static int appendDumpedChunk(lua_State*, const void* data, size_t size, void* userData) {
+    static_cast<std::string*>(userData)->append(static_cast<const char*>(data), size);
+    return 0;
+}
+
+void LuaBindings::setBytecodeCacheDirectory(const std::string& directory, const std::string& keyFile) {
+    m_bytecodeCache = BytecodeCache(directory, keyFile);
+    m_scriptKeys.clear();
+}
+
+sol::protected_function LuaBindings::loadScript(const std::string& path, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        error = "cannot open " + path;
+        return {};
+    }
+    std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::string chunkName = "@" + path;
+
+    if (!m_bytecodeCache.isEnabled()) {
+        return compileScript(source, chunkName, 0, error);
+    }
+
+    // An edited script (hot reload) supersedes its previous chunk
+    uint64_t key = m_bytecodeCache.keyFor(chunkName, source);
+    auto [it, inserted] = m_scriptKeys.try_emplace(path, key);
+    if (!inserted && it->second != key) {
+        m_bytecodeCache.remove(it->second);
+        it->second = key;
+    }
+
+    // Cached chunks were dumped by compileScript from this exact source and
+    // carry this install's tag, so loading them in binary mode does not
+    // widen what mods can run
+    std::string bytecode;
+    if (m_bytecodeCache.load(key, bytecode)) {
+        auto result = m_lua.load(bytecode, chunkName, sol::load_mode::binary);
+        if (result.valid()) {
+            ++m_bytecodeCacheHits;
+            sol::protected_function chunk = result;
+            return chunk;
+        }
+        sol::error err = result;
+        LOG_WARN("LuaBindings: discarding cached chunk for '{}': {}", path, err.what());
+        m_bytecodeCache.remove(key);
+    }
+
+    ++m_bytecodeCacheMisses;
+    return compileScript(source, chunkName, key, error);
+}
+
+sol::protected_function LuaBindings::compileScript(const std::string& source,
+                                                   const std::string& chunkName,
+                                                   uint64_t cacheKey, std::string& error) {
+    auto result = m_lua.load(source, chunkName, sol::load_mode::text);
+    if (!result.valid()) {
+        sol::error err = result;
+        error = err.what();
+        return {};
+    }
+    sol::protected_function chunk = result;
+
+    if (m_bytecodeCache.isEnabled()) {
+        // Keep debug info so errors from cached chunks still carry line numbers
+        lua_State* L = m_lua.lua_state();
+        std::string bytecode;
+        chunk.push(L);
+        int status = lua_dump(L, appendDumpedChunk, &bytecode, 0);
+        lua_pop(L, 1);
+        if (status == 0) {
+            m_bytecodeCache.save(cacheKey, bytecode);
+        }
+    }
+    return chunk;
+}
+
 } // namespace gloaming
@@ -1,9 +1,16 @@
 #pragma once
 
+#include "engine/Log.hpp"
+#include "mod/BytecodeCache.hpp"
+#include "mod/LuaCpuBudget.hpp"
+#include "mod/LuaGcScheduler.hpp"
+
 #include <sol/sol.hpp>
 
+#include <functional>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 namespace gloaming {
 
@@ -18,7 +25,9 @@ class UISystem;
 class LuaBindings {
 public:
     LuaBindings() = default;
-    ~LuaBindings() = default;
+    /// Unhooks the CPU budget and GC scheduler before the state closes, so
+    /// destroying without shutdown() never touches a freed lua_State
+    ~LuaBindings();
 
     // Non-copyable
     LuaBindings(const LuaBindings&) = delete;
@@ -35,14 +44,55 @@ public:
     /// The environment inherits read-only access to engine APIs but has its own globals.
     sol::environment createModEnvironment(const std::string& modId);
 
-    /// Execute a Lua script file within a mod's environment.
-    /// Returns true on success.
+    /// Execute a Lua script file within a mod's environment, under the CPU
+    /// budget's load-phase limits. Returns true on success.
     bool executeFile(const std::string& path, sol::environment& env);
 
-    /// Execute a Lua string within a mod's environment.
+    /// Execute a Lua string within a mod's environment (load-phase limits).
     bool executeString(const std::string& code, sol::environment& env,
                        const std::string& chunkName = "=string");
 
+    /// Compile a mod script, or load its cached chunk if the source is
+    /// unchanged. Sources are always loaded as text, so mods cannot hand
+    /// the VM precompiled chunks. Returns an invalid function and sets
+    /// `error` on failure.
+    sol::protected_function loadScript(const std::string& path, std::string& error);
+
+    /// Cache compiled scripts under `directory`, tagged with the secret in
+    /// `keyFile` (see BytecodeCache); an empty directory disables caching.
+    void setBytecodeCacheDirectory(const std::string& directory, const std::string& keyFile = {});
+    const BytecodeCache& getBytecodeCache() const { return m_bytecodeCache; }
+
+    /// Scripts served from the cache / compiled from source since init
+    size_t bytecodeCacheHits() const { return m_bytecodeCacheHits; }
+    size_t bytecodeCacheMisses() const { return m_bytecodeCacheMisses; }
+
+    /// Per-mod CPU accounting for Lua callbacks
+    LuaCpuBudget& getCpuBudget() { return m_cpuBudget; }
+    const LuaCpuBudget& getCpuBudget() const { return m_cpuBudget; }
+
+    /// Wrap a Lua function for the engine to call later. Each call runs
+    /// protected and is charged to the mod registering it (the current mod
+    /// at this call); errors are logged as "<what> error: ...", so `what`
+    /// must outlive the callback (a string literal).
+    template<typename... Args>
+    std::function<void(Args...)> modCallback(sol::protected_function fn, const char* what) {
+        LuaCpuBudget* cpu = &m_cpuBudget;
+        LuaCpuBudget::ModHandle owner = m_cpuBudget.currentMod();
+        return [fn = std::move(fn), cpu, owner, what](Args... args) {
+            LuaCpuBudget::Scope scope(cpu, owner);
+            sol::protected_function_result result = fn(args...);
+            if (!result.valid()) {
+                sol::error err = result;
+                MOD_LOG_ERROR("{} error: {}", what, err.what());
+            }
+        };
+    }
+
+    /// Engine-side pacing of the Lua garbage collector
+    LuaGcScheduler& getGcScheduler() { return m_gcScheduler; }
+    const LuaGcScheduler& getGcScheduler() const { return m_gcScheduler; }
+
     /// Get the raw sol2 state (for advanced usage)
     sol::state& getState() { return m_lua; }
 
@@ -74,11 +124,27 @@ private:
     /// Bind math/noise utilities
     void bindUtilAPI();
 
+    /// Budget handle for the mod owning `env` (kNoMod for anonymous environments)
+    LuaCpuBudget::ModHandle envOwner(sol::environment& env);
+
+    /// Compile source text (never binary) and, when caching, store its dump
+    sol::protected_function compileScript(const std::string& source, const std::string& chunkName,
+                                          uint64_t cacheKey, std::string& error);
+
+    // Declared before the state so its hook outlives any code run while
+    // the state closes
+    LuaCpuBudget m_cpuBudget;
+    LuaGcScheduler m_gcScheduler;
     sol::state m_lua;
     Engine* m_engine = nullptr;
     ContentRegistry* m_registry = nullptr;
     EventBus* m_eventBus = nullptr;
     bool m_initialized = false;
+
+    BytecodeCache m_bytecodeCache;
+    std::unordered_map<std::string, uint64_t> m_scriptKeys;  ///< Last cache key per script path
+    size_t m_bytecodeCacheHits = 0;
+    size_t m_bytecodeCacheMisses = 0;
 };
 
 } // namespace gloaming
@@ -0,0 +1,189 @@
+#include "mod/LuaCpuBudget.hpp"
+#include "engine/Log.hpp"
+
+#include <sol/sol.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace gloaming {
+
+namespace {
+
+/// Frames between repeated soft-budget warnings for the same mod
+constexpr uint64_t kWarnIntervalFrames = 300;
+
+/// Weight of the newest frame in ModStats::avgFrameMs
+constexpr double kFrameAverageWeight = 0.05;
+
+double msBetween(std::chrono::steady_clock::time_point from,
+                 std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+} // namespace
+
+void LuaCpuBudget::attach(lua_State* L) {
+    detach();
+    m_lua = L;
+    // Coroutines copy the main thread's extra space and hook when created
+    *static_cast<LuaCpuBudget**>(lua_getextraspace(L)) = this;
+    lua_sethook(L, &LuaCpuBudget::hook, LUA_MASKCOUNT, std::max(1, m_settings.hookInterval));
+}
+
+void LuaCpuBudget::detach() {
+    if (!m_lua) return;
+    lua_sethook(m_lua, nullptr, 0, 0);
+    *static_cast<LuaCpuBudget**>(lua_getextraspace(m_lua)) = nullptr;
+    m_lua = nullptr;
+}
+
+void LuaCpuBudget::setSettings(const Settings& settings) {
+    m_settings = settings;
+    if (m_lua) {
+        lua_sethook(m_lua, &LuaCpuBudget::hook, LUA_MASKCOUNT,
+                    std::max(1, m_settings.hookInterval));
+    }
+}
+
+LuaCpuBudget::ModHandle LuaCpuBudget::registerMod(const std::string& modId) {
+    auto [it, inserted] = m_modIndex.try_emplace(modId, static_cast<ModHandle>(m_mods.size()));
+    if (inserted) {
+        m_mods.push_back({});
+        m_mods.back().modId = modId;
+        m_lastWarnFrame.push_back(0);
+    }
+    return it->second;
+}
+
+LuaCpuBudget::ModHandle LuaCpuBudget::findMod(const std::string& modId) const {
+    auto it = m_modIndex.find(modId);
+    return it != m_modIndex.end() ? it->second : kNoMod;
+}
+
+const LuaCpuBudget::ModStats* LuaCpuBudget::getStats(const std::string& modId) const {
+    ModHandle mod = findMod(modId);
+    return mod != kNoMod ? &m_mods[mod] : nullptr;
+}
+
+void LuaCpuBudget::enter(ModHandle mod, Phase phase) {
+    auto now = Clock::now();
+    if (!m_stack.empty()) {
+        ActiveCall& parent = m_stack.back();
+        parent.elapsedMs += msBetween(parent.resumed, now);
+    }
+    // m_unscopedInstructions is left alone: unscoped code that calls into
+    // a scoped callback (e.g. emits an event) must not get a fresh ceiling
+    m_stack.push_back({mod, now, 0.0, 0, phase});
+}
+
+void LuaCpuBudget::leave() {
+    if (m_stack.empty()) return;
+
+    auto now = Clock::now();
+    ActiveCall call = m_stack.back();
+    m_stack.pop_back();
+    if (!m_stack.empty()) {
+        m_stack.back().resumed = now;
+    }
+
+    if (call.mod == kNoMod) return;
+    double ms = call.elapsedMs + msBetween(call.resumed, now);
+    ModStats& stats = m_mods[call.mod];
+    ++stats.calls;
+    stats.totalMs += ms;
+    stats.frameMs += ms;
+    stats.maxCallMs = std::max(stats.maxCallMs, ms);
+    if (call.aborted) {
+        ++stats.hardAborts;
+    }
+}
+
+void LuaCpuBudget::endFrame() {
+    ++m_frameCount;
+    m_unscopedInstructions = 0;
+
+    for (size_t i = 0; i < m_mods.size(); ++i) {
+        ModStats& stats = m_mods[i];
+        stats.lastFrameMs = stats.frameMs;
+        stats.avgFrameMs += (stats.frameMs - stats.avgFrameMs) * kFrameAverageWeight;
+        stats.frameMs = 0.0;
+
+        if (m_settings.softFrameMs <= 0.0 || stats.lastFrameMs <= m_settings.softFrameMs) {
+            continue;
+        }
+        ++stats.softOverruns;
+        if (m_lastWarnFrame[i] == 0 || m_frameCount - m_lastWarnFrame[i] >= kWarnIntervalFrames) {
+            m_lastWarnFrame[i] = m_frameCount;
+            MOD_LOG_WARN("[{}] Lua took {:.2f} ms this frame (soft budget {:.2f} ms, {} overruns)",
+                         stats.modId, stats.lastFrameMs, m_settings.softFrameMs,
+                         stats.softOverruns);
+        }
+    }
+}
+
+void LuaCpuBudget::reset() {
+    for (ModStats& stats : m_mods) {
+        std::string modId = std::move(stats.modId);
+        stats = {};
+        stats.modId = std::move(modId);
+    }
+    std::fill(m_lastWarnFrame.begin(), m_lastWarnFrame.end(), 0);
+    m_unscopedInstructions = 0;
+}
+
+const char* LuaCpuBudget::charge() {
+    const uint64_t step = static_cast<uint64_t>(std::max(1, m_settings.hookInterval));
+
+    // Code outside any scope (tests, engine-side calls) keeps a plain
+    // per-frame instruction ceiling as an infinite-loop guard
+    if (m_stack.empty()) {
+        m_unscopedInstructions += step;
+        if (m_settings.hardCallInstructions > 0 &&
+            m_unscopedInstructions > m_settings.hardCallInstructions) {
+            m_unscopedInstructions = 0;
+            return "instruction limit exceeded (possible infinite loop)";
+        }
+        return nullptr;
+    }
+
+    ActiveCall& call = m_stack.back();
+    call.instructions += step;
+    if (call.mod != kNoMod) {
+        m_mods[call.mod].instructions += step;
+    }
+
+    const bool load = call.phase == Phase::Load;
+    const uint64_t maxInstructions = load ? m_settings.loadCallInstructions
+                                          : m_settings.hardCallInstructions;
+    const double maxMs = load ? m_settings.loadCallMs : m_settings.hardCallMs;
+    bool overInstructions = maxInstructions > 0 && call.instructions > maxInstructions;
+    double ms = call.elapsedMs + msBetween(call.resumed, Clock::now());
+    bool overTime = maxMs > 0.0 && ms > maxMs;
+    if (!overInstructions && !overTime) return nullptr;
+
+    call.aborted = true;
+    const char* modId = call.mod != kNoMod ? m_mods[call.mod].modId.c_str() : "?";
+    if (overInstructions) {
+        std::snprintf(m_abortMessage, sizeof(m_abortMessage),
+                      "mod '%s' exceeded its CPU budget (%llu instructions in one call)",
+                      modId, static_cast<unsigned long long>(call.instructions));
+    } else {
+        std::snprintf(m_abortMessage, sizeof(m_abortMessage),
+                      "mod '%s' exceeded its CPU budget (%.1f ms in one call)", modId, ms);
+    }
+    return m_abortMessage;
+}
+
+void LuaCpuBudget::hook(lua_State* L, lua_Debug*) {
+    auto* self = *static_cast<LuaCpuBudget**>(lua_getextraspace(L));
+    if (!self) return;
+
+    // luaL_error longjmps out of here, so nothing with a destructor may be
+    // live at this point; the message lives in the budget
+    if (const char* abortMessage = self->charge()) {
+        luaL_error(L, "%s", abortMessage);
+    }
+}
+
+} // namespace gloaming
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct lua_State;
+struct lua_Debug;
+
+namespace gloaming {
+
+/// Per-mod Lua CPU accounting and runaway-script preemption.
+///
+/// Calls into mod code run inside a Scope naming the mod that registered
+/// the callback (LuaBindings::modCallback wraps a callback this way). A
+/// count hook fires every `hookInterval` instructions, charges them to the
+/// innermost scope's mod, and aborts the callback with a Lua error once it
+/// passes a hard budget. Time is exclusive: a nested scope (one mod's event
+/// handled by another) pauses its parent's clock. Lua running outside any
+/// scope only has a per-frame instruction ceiling.
+///
+/// Soft budgets are per mod per frame; going over counts an overrun and
+/// logs a rate-limited warning naming the mod.
+///
+/// Load-phase scopes (entry points, init/postInit/shutdown) are charged the
+/// same way but checked against the much larger load limits, so a big
+/// modpack's setup isn't mistaken for a runaway callback.
+class LuaCpuBudget {
+public:
+    using ModHandle = uint32_t;
+    static constexpr ModHandle kNoMod = UINT32_MAX;
+
+    struct Settings {
+        double softFrameMs = 4.0;                     ///< Per mod per frame, warn above (0 = off)
+        double hardCallMs = 250.0;                    ///< Per callback, abort above (0 = off)
+        uint64_t hardCallInstructions = 10'000'000;   ///< Per callback, abort above (0 = off)
+        double loadCallMs = 30'000.0;                 ///< Per load-phase call, abort above (0 = off)
+        uint64_t loadCallInstructions = 0;            ///< Per load-phase call, abort above (0 = off)
+        int hookInterval = 1000;                      ///< Instructions between hook checks
+    };
+
+    struct ModStats {
+        std::string modId;
+        uint64_t calls = 0;
+        uint64_t instructions = 0;      ///< Counted in hook-interval steps
+        double totalMs = 0.0;
+        double frameMs = 0.0;           ///< Accumulating in the current frame
+        double lastFrameMs = 0.0;       ///< Last completed frame
+        double avgFrameMs = 0.0;        ///< Moving average over recent frames
+        double maxCallMs = 0.0;
+        uint64_t softOverruns = 0;      ///< Frames over the soft budget
+        uint64_t hardAborts = 0;        ///< Callbacks aborted by a hard budget
+    };
+
+    /// Which hard limits a Scope is held to
+    enum class Phase {
+        Callback,       ///< hardCallMs / hardCallInstructions
+        Load,           ///< loadCallMs / loadCallInstructions
+    };
+
+    /// Attributes Lua execution to `mod` while alive. A null budget makes
+    /// this a no-op, so callers can hold an optional pointer.
+    class Scope {
+    public:
+        Scope(LuaCpuBudget* budget, ModHandle mod, Phase phase = Phase::Callback) : m_budget(budget) {
+            if (m_budget) m_budget->enter(mod, phase);
+        }
+        ~Scope() {
+            if (m_budget) m_budget->leave();
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        LuaCpuBudget* m_budget;
+    };
+
+    LuaCpuBudget() = default;
+    ~LuaCpuBudget() { detach(); }
+
+    LuaCpuBudget(const LuaCpuBudget&) = delete;
+    LuaCpuBudget& operator=(const LuaCpuBudget&) = delete;
+
+    /// Install the count hook on `L` (and coroutines created from it).
+    void attach(lua_State* L);
+    void detach();
+
+    void setSettings(const Settings& settings);
+    const Settings& getSettings() const { return m_settings; }
+
+    /// Handle for `modId`, created on first use
+    ModHandle registerMod(const std::string& modId);
+
+    /// Handle for `modId`, or kNoMod
+    ModHandle findMod(const std::string& modId) const;
+
+    /// Mod whose code is running (innermost scope), or kNoMod. Bindings
+    /// capture this when a callback is registered.
+    ModHandle currentMod() const { return m_stack.empty() ? kNoMod : m_stack.back().mod; }
+
+    /// Close the frame: roll per-frame times and check soft budgets.
+    void endFrame();
+
+    const std::vector<ModStats>& getStats() const { return m_mods; }
+    const ModStats* getStats(const std::string& modId) const;
+
+    /// Zero all counters (mods stay registered)
+    void reset();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct ActiveCall {
+        ModHandle mod;
+        Clock::time_point resumed;      ///< When this call last got the CPU
+        double elapsedMs = 0.0;         ///< Exclusive time before `resumed`
+        uint64_t instructions = 0;
+        Phase phase = Phase::Callback;
+        bool aborted = false;
+    };
+
+    static void hook(lua_State* L, lua_Debug* ar);
+
+    void enter(ModHandle mod, Phase phase);
+    void leave();
+
+    /// Charge one hook interval; returns an abort message or nullptr
+    const char* charge();
+
+    Settings m_settings;
+    std::vector<ModStats> m_mods;
+    std::unordered_map<std::string, ModHandle> m_modIndex;
+    std::vector<ActiveCall> m_stack;
+    std::vector<uint64_t> m_lastWarnFrame;       ///< Per mod, for rate-limiting
+    uint64_t m_unscopedInstructions = 0;         ///< Outside any scope, this frame
+    uint64_t m_frameCount = 0;
+    lua_State* m_lua = nullptr;
+    char m_abortMessage[192] = {};
+};
+
+} // namespace gloaming
@@ -0,0 +1,130 @@
+#include "mod/LuaGcScheduler.hpp"
+#include "engine/Log.hpp"
+
+#include <sol/sol.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+namespace gloaming {
+
+namespace {
+
+/// Weight of the newest frame in Stats::avgFrameMs
+constexpr double kFrameAverageWeight = 0.05;
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+void LuaGcScheduler::attach(lua_State* L) {
+    m_lua = L;
+    m_cycleActive = false;
+    m_pendingReason = nullptr;
+    applyParameters();
+    m_stats.memoryKb = memoryKb();
+    m_stats.baselineKb = m_stats.memoryKb;
+}
+
+void LuaGcScheduler::setSettings(const Settings& settings) {
+    m_settings = settings;
+    applyParameters();
+}
+
+void LuaGcScheduler::applyParameters() {
+    if (!m_lua) return;
+    // Lua takes the step size as log2(bytes)
+    unsigned stepBytes = static_cast<unsigned>(std::max(1, m_settings.stepSizeKb)) * 1024u;
+    int stepSizeLog2 = static_cast<int>(std::bit_width(stepBytes)) - 1;
+    lua_gc(m_lua, LUA_GCINC, std::max(0, m_settings.pause),
+           std::max(0, m_settings.stepMultiplier), stepSizeLog2);
+    lua_gc(m_lua, LUA_GCRESTART);
+}
+
+double LuaGcScheduler::memoryKb() const {
+    if (!m_lua) return 0.0;
+    return static_cast<double>(lua_gc(m_lua, LUA_GCCOUNT)) +
+           static_cast<double>(lua_gc(m_lua, LUA_GCCOUNTB)) / 1024.0;
+}
+
+void LuaGcScheduler::step(double slackMs) {
+    if (!m_lua) return;
+
+    if (m_pendingReason) {
+        auto start = Clock::now();
+        fullCollect(m_pendingReason);
+        recordFrame(msSince(start));
+        return;
+    }
+
+    double memory = memoryKb();
+    m_stats.memoryKb = memory;
+    if (!m_settings.enginePaced) {
+        recordFrame(0.0);
+        return;
+    }
+
+    // Lua starts a cycle on its own once the heap reaches `trigger`; start
+    // ours halfway there so it finishes in slack before that happens
+    double trigger = m_stats.baselineKb * std::max(100, m_settings.pause) / 100.0;
+    if (!m_cycleActive) {
+        if (memory < (m_stats.baselineKb + trigger) * 0.5) {
+            recordFrame(0.0);
+            return;
+        }
+        m_cycleActive = true;
+    }
+
+    double budgetMs = memory >= trigger ? m_settings.maxFrameMs
+                                        : std::min(slackMs, m_settings.maxFrameMs);
+    auto start = Clock::now();
+    do {
+        ++m_stats.steps;
+        // A zero-size step does one basic step regardless of debt; returns
+        // 1 when it finishes the cycle
+        if (lua_gc(m_lua, LUA_GCSTEP, 0)) {
+            m_cycleActive = false;
+            ++m_stats.cycles;
+            m_stats.baselineKb = memoryKb();
+            break;
+        }
+    } while (msSince(start) < budgetMs);
+
+    m_stats.memoryKb = memoryKb();
+    recordFrame(msSince(start));
+}
+
+void LuaGcScheduler::requestFullCollect(const char* reason) {
+    if (!m_pendingReason) m_pendingReason = reason;
+}
+
+void LuaGcScheduler::fullCollect(const char* reason) {
+    m_pendingReason = nullptr;
+    if (!m_lua) return;
+
+    auto start = Clock::now();
+    lua_gc(m_lua, LUA_GCCOLLECT);
+    double ms = msSince(start);
+
+    m_cycleActive = false;
+    ++m_stats.fullCollections;
+    m_stats.lastFullCollectMs = ms;
+    m_stats.memoryKb = memoryKb();
+    m_stats.baselineKb = m_stats.memoryKb;
+    LOG_DEBUG("Lua GC: full collection ({}) took {:.2f} ms, heap now {:.0f} KB",
+              reason ? reason : "requested", ms, m_stats.memoryKb);
+}
+
+void LuaGcScheduler::recordFrame(double ms) {
+    m_stats.lastFrameMs = ms;
+    m_stats.avgFrameMs += (ms - m_stats.avgFrameMs) * kFrameAverageWeight;
+    m_stats.maxFrameMs = std::max(m_stats.maxFrameMs, ms);
+    m_stats.totalMs += ms;
+}
+
+} // namespace gloaming
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+struct lua_State;
+
+namespace gloaming {
+
+/// Paces the Lua garbage collector from the frame loop.
+///
+/// Left alone, Lua collects whenever allocation debt crosses its threshold,
+/// which lands mid-callback at arbitrary points and shows up as periodic
+/// frame spikes. With engine pacing on, the scheduler starts each cycle
+/// early (halfway to Lua's own trigger) and advances it in bounded slices
+/// of frame slack, so the automatic collector rarely gets a turn. It stays
+/// armed as a backstop: a single allocation-heavy callback still can't grow
+/// the heap without bound.
+///
+/// Full collections are deferred to safe points: requestFullCollect() marks
+/// one and the next step() runs it, outside any Lua call.
+class LuaGcScheduler {
+public:
+    struct Settings {
+        bool enginePaced = true;        ///< Step the collector in frame slack
+        int pause = 200;                ///< Lua `pause` (%): heap growth before a new cycle
+        int stepMultiplier = 100;       ///< Lua `stepmul` (%): work done per step
+        int stepSizeKb = 16;            ///< Allocation between automatic steps
+        double maxFrameMs = 1.0;        ///< Most time step() spends per frame
+    };
+
+    struct Stats {
+        double lastFrameMs = 0.0;       ///< GC time in the last step() call
+        double avgFrameMs = 0.0;        ///< Moving average over recent frames
+        double maxFrameMs = 0.0;
+        double totalMs = 0.0;
+        double lastFullCollectMs = 0.0;
+        uint64_t steps = 0;             ///< Incremental steps the engine ran
+        uint64_t cycles = 0;            ///< Cycles the engine finished by stepping
+        uint64_t fullCollections = 0;
+        double memoryKb = 0.0;          ///< Heap size after the last step()
+        double baselineKb = 0.0;        ///< Heap size after the last finished cycle
+    };
+
+    LuaGcScheduler() = default;
+
+    LuaGcScheduler(const LuaGcScheduler&) = delete;
+    LuaGcScheduler& operator=(const LuaGcScheduler&) = delete;
+
+    /// Apply the settings to `L` and start pacing it.
+    void attach(lua_State* L);
+    void detach() { m_lua = nullptr; }
+
+    void setSettings(const Settings& settings);
+    const Settings& getSettings() const { return m_settings; }
+
+    /// Spend up to min(slackMs, maxFrameMs) advancing the current cycle.
+    /// A cycle in progress always gets at least one step, and a heap past
+    /// Lua's own trigger gets the full maxFrameMs. Runs a pending full
+    /// collection instead, if one was requested.
+    void step(double slackMs);
+
+    /// Run a full collection at the next step()
+    void requestFullCollect(const char* reason);
+    bool fullCollectPending() const { return m_pendingReason != nullptr; }
+
+    /// Run a full collection now. Must not be called from inside a Lua
+    /// call (finalizers may run); prefer requestFullCollect().
+    void fullCollect(const char* reason);
+
+    const Stats& getStats() const { return m_stats; }
+
+    /// Current Lua heap size in KB
+    double memoryKb() const;
+
+private:
+    void applyParameters();
+    void recordFrame(double ms);
+
+    Settings m_settings;
+    Stats m_stats;
+    lua_State* m_lua = nullptr;
+    const char* m_pendingReason = nullptr;   ///< String literal naming the safe point
+    bool m_cycleActive = false;
+};
+
+} // namespace gloaming
@@ -20,6 +20,10 @@ bool ModLoader::init(Engine& engine, const ModLoaderConfig& config) {
         LOG_ERROR("ModLoader: failed to initialize Lua bindings");
         return false;
     }
+    m_luaBindings.setBytecodeCacheDirectory(m_config.bytecodeCacheDirectory,
+                                            m_config.bytecodeCacheKeyFile);
+    m_luaBindings.getCpuBudget().setSettings(m_config.cpuBudget);
+    m_luaBindings.getGcScheduler().setSettings(m_config.gc);
 
     // Load mod enabled/disabled state
     loadModConfig();
@@ -180,8 +184,11 @@ void ModLoader::postInitMods() {
 
         auto& mod = it->second;
         if (mod.modTable.valid()) {
-            sol::optional<sol::function> postInit = mod.modTable["postInit"];
+            sol::optional<sol::protected_function> postInit = mod.modTable["postInit"];
             if (postInit) {
+                LuaCpuBudget& budget = m_luaBindings.getCpuBudget();
+                LuaCpuBudget::Scope scope(&budget, budget.registerMod(modId),
+                                          LuaCpuBudget::Phase::Load);
                 auto result = (*postInit)();
                 if (!result.valid()) {
                     sol::error err = result;
@@ -208,8 +215,11 @@ void ModLoader::shutdown() {
         auto& mod = modIt->second;
         if (mod.state == ModState::Loaded || mod.state == ModState::PostInit) {
             if (mod.modTable.valid()) {
-                sol::optional<sol::function> shutdownFn = mod.modTable["shutdown"];
+                sol::optional<sol::protected_function> shutdownFn = mod.modTable["shutdown"];
                 if (shutdownFn) {
+                    LuaCpuBudget& budget = m_luaBindings.getCpuBudget();
+                    LuaCpuBudget::Scope scope(&budget, budget.registerMod(*it),
+                                              LuaCpuBudget::Phase::Load);
                     auto result = (*shutdownFn)();
                     if (!result.valid()) {
                         sol::error err = result;
@@ -255,18 +265,21 @@ bool ModLoader::loadMod(const std::string& modId) {
     }
 
     // Load the entry point file
-    auto result = m_luaBindings.getState().load_file(entryPath);
-    if (!result.valid()) {
-        sol::error err = result;
-        MOD_LOG_ERROR("[{}] failed to load entry point: {}", modId, err.what());
+    std::string loadError;
+    sol::protected_function chunk = m_luaBindings.loadScript(entryPath, loadError);
+    if (!chunk.valid()) {
+        MOD_LOG_ERROR("[{}] failed to load entry point: {}", modId, loadError);
         mod.state = ModState::Failed;
-        mod.errorMessage = "Script load error: " + std::string(err.what());
+        mod.errorMessage = "Script load error: " + loadError;
         return false;
     }
 
-    sol::protected_function chunk = result;
     sol::set_environment(mod.luaEnv, chunk);
 
+    // Callbacks registered while the entry point and init() run belong to this mod
+    LuaCpuBudget& budget = m_luaBindings.getCpuBudget();
+    LuaCpuBudget::Scope scope(&budget, budget.registerMod(modId),
+                              LuaCpuBudget::Phase::Load);
     auto execResult = chunk();
     if (!execResult.valid()) {
         sol::error err = execResult;
@@ -281,7 +294,7 @@ bool ModLoader::loadMod(const std::string& modId) {
         mod.modTable = execResult;
 
         // Call init() if present
-        sol::optional<sol::function> initFn = mod.modTable["init"];
+        sol::optional<sol::protected_function> initFn = mod.modTable["init"];
         if (initFn) {
             auto initResult = (*initFn)();
             if (!initResult.valid()) {
@@ -41,6 +41,10 @@ struct ModLoaderConfig {
     std::string installDirectory = "mods/install";
     std::string configFile = "config/mods.json";
     bool enableHotReload = false;
+    std::string bytecodeCacheDirectory;     ///< Compiled script cache; empty disables caching
+    std::string bytecodeCacheKeyFile;       ///< Secret authenticating cache entries (empty = "<dir>.key")
+    LuaCpuBudget::Settings cpuBudget;       ///< Per-mod Lua CPU limits
+    LuaGcScheduler::Settings gc;            ///< Lua collector pacing
 };
 
 /// The mod loader orchestrates mod discovery, dependency resolution, and loading
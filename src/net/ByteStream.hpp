@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace gloaming {
+
+/// Append-only little-endian byte writer for network packets.
+///
+/// Integers that are usually small (entity ID gaps, quantized deltas) go
+/// through writeVarUint/writeVarInt: LEB128 with zigzag for signed values,
+/// so a delta of -3..3 costs one byte.
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<uint8_t>& buffer) : m_buffer(buffer) {}
+
+    void writeU8(uint8_t v) { m_buffer.push_back(v); }
+
+    void writeU16(uint16_t v) {
+        m_buffer.push_back(static_cast<uint8_t>(v));
+        m_buffer.push_back(static_cast<uint8_t>(v >> 8));
+    }
+
+    void writeU32(uint32_t v) {
+        for (int i = 0; i < 4; ++i) m_buffer.push_back(static_cast<uint8_t>(v >> (i * 8)));
+    }
+
+    void writeU64(uint64_t v) {
+        for (int i = 0; i < 8; ++i) m_buffer.push_back(static_cast<uint8_t>(v >> (i * 8)));
+    }
+
+    void writeVarUint(uint32_t v) {
+        while (v >= 0x80) {
+            m_buffer.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        m_buffer.push_back(static_cast<uint8_t>(v));
+    }
+
+    void writeVarInt(int32_t v) { writeVarUint(zigzag(v)); }
+
+    void writeBytes(const uint8_t* data, size_t size) {
+        m_buffer.insert(m_buffer.end(), data, data + size);
+    }
+
+    size_t size() const { return m_buffer.size(); }
+
+    /// Drop everything written after `size` (used to roll back a record
+    /// that would not fit the packet budget).
+    void truncate(size_t size) { if (size < m_buffer.size()) m_buffer.resize(size); }
+
+    /// Overwrite a previously written u16 at `offset`.
+    void patchU16(size_t offset, uint16_t v) {
+        m_buffer[offset] = static_cast<uint8_t>(v);
+        m_buffer[offset + 1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    static uint32_t zigzag(int32_t v) {
+        return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+    }
+
+    /// Encoded size of a varint, without writing it.
+    static size_t varUintSize(uint32_t v) {
+        size_t n = 1;
+        while (v >= 0x80) { v >>= 7; ++n; }
+        return n;
+    }
+
+private:
+    std::vector<uint8_t>& m_buffer;
+};
+
+/// Bounds-checked reader matching ByteWriter. Reading past the end (or a
+/// malformed varint) sets the failed flag and returns zeros, so decoders can
+/// read a whole record and check ok() once.
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    uint8_t readU8() {
+        if (!need(1)) return 0;
+        return m_data[m_pos++];
+    }
+
+    uint16_t readU16() {
+        if (!need(2)) return 0;
+        uint16_t v = static_cast<uint16_t>(m_data[m_pos] | (m_data[m_pos + 1] << 8));
+        m_pos += 2;
+        return v;
+    }
+
+    uint32_t readU32() {
+        if (!need(4)) return 0;
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(m_data[m_pos + i]) << (i * 8);
+        m_pos += 4;
+        return v;
+    }
+
+    uint64_t readU64() {
+        if (!need(8)) return 0;
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(m_data[m_pos + i]) << (i * 8);
+        m_pos += 8;
+        return v;
+    }
+
+    uint32_t readVarUint() {
+        uint32_t v = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (!need(1)) return 0;
+            uint8_t byte = m_data[m_pos++];
+            v |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return v;
+        }
+        m_failed = true;
+        return 0;
+    }
+
+    int32_t readVarInt() {
+        uint32_t v = readVarUint();
+        return static_cast<int32_t>((v >> 1) ^ (~(v & 1) + 1));
+    }
+
+    bool ok() const { return !m_failed; }
+    bool atEnd() const { return m_pos >= m_size; }
+    size_t position() const { return m_pos; }
+    size_t remaining() const { return m_failed ? 0 : m_size - m_pos; }
+
+private:
+    bool need(size_t n) {
+        if (m_failed || m_size - m_pos < n) {
+            m_failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    bool m_failed = false;
+};
+
+} // namespace gloaming
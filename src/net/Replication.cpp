@@ -0,0 +1,472 @@
+#include "net/Replication.hpp"
+#include "ecs/Components.hpp"
+#include "engine/Log.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace gloaming {
+
+namespace {
+
+/// Seconds between Hello packets while the client waits for a snapshot.
+constexpr float kHelloInterval = 0.5f;
+
+/// Seconds per handshake cookie window. A cookie is accepted in its own
+/// window and the next, so it stays valid for at least this long.
+constexpr float kCookieWindow = 10.0f;
+
+/// How far the client clock may run ahead of the newest snapshot before it
+/// is pulled back (covers a few lost packets without jitter).
+constexpr float kMaxClockLead = 0.25f;
+
+uint32_t floatBits(float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+float bitsFloat(uint32_t bits) {
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+void writeHeader(ByteWriter& out, NetPacket::Type type) {
+    out.writeU16(NetPacket::kMagic);
+    out.writeU8(type);
+}
+
+bool readHeader(ByteReader& in, uint8_t& type) {
+    uint16_t magic = in.readU16();
+    type = in.readU8();
+    return in.ok() && magic == NetPacket::kMagic;
+}
+
+float lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+/// Interpolate 16-bit angles the short way round.
+float lerpRotation(int32_t a, int32_t b, float t) {
+    int32_t diff = ((b - a + 32768) & 0xFFFF) - 32768;
+    return NetQuantize::toRotation(a) + NetQuantize::toRotation(diff) * t;
+}
+
+} // namespace
+
+// ============================================================================
+// ReplicationServer
+// ============================================================================
+
+bool ReplicationServer::start(const ReplicationConfig& config) {
+    stop();
+    m_config = config;
+    m_cookieKey = KeyedHash::randomKey();
+    if (!m_socket.open(config.port)) {
+        LOG_ERROR("Replication: could not bind UDP port {}", config.port);
+        return false;
+    }
+    LOG_INFO("Replication: server listening on UDP port {} ({} snapshots/s, {} bytes max, {} clients max)",
+             m_socket.localPort(), config.snapshotRate, config.maxPacketBytes, config.maxClients);
+    return true;
+}
+
+void ReplicationServer::stop() {
+    if (!isRunning()) return;
+    for (const auto& client : m_clients) {
+        m_packet.clear();
+        ByteWriter out(m_packet);
+        writeHeader(out, NetPacket::Disconnect);
+        m_socket.sendTo(client->address, m_packet.data(), m_packet.size());
+    }
+    m_clients.clear();
+    m_socket.close();
+    m_current.clear();
+    m_tick = 0;
+    m_time = 0.0f;
+    m_sendAccumulator = 0.0f;
+}
+
+void ReplicationServer::update(Registry& registry, float dt) {
+    if (!isRunning()) return;
+    m_time += dt;
+
+    for (auto& client : m_clients) client->silence += dt;
+    receive();
+
+    m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(),
+        [this](const std::unique_ptr<ClientConnection>& client) {
+            if (client->silence < m_config.timeout) return false;
+            LOG_INFO("Replication: client {} timed out", client->stats.clientId);
+            return true;
+        }), m_clients.end());
+
+    if (m_clients.empty()) {
+        m_sendAccumulator = 0.0f;
+        return;
+    }
+
+    float interval = 1.0f / std::max(m_config.snapshotRate, 1.0f);
+    m_sendAccumulator += dt;
+    if (m_sendAccumulator < interval) return;
+    // One snapshot per update at most; a long frame doesn't cause a burst
+    m_sendAccumulator = std::min(m_sendAccumulator - interval, interval);
+
+    ++m_tick;
+    captureSnapshot(registry, m_tick, m_time, m_current);
+    for (auto& client : m_clients) sendSnapshot(*client);
+}
+
+std::vector<ReplicationClientStats> ReplicationServer::clientStats() const {
+    std::vector<ReplicationClientStats> stats;
+    stats.reserve(m_clients.size());
+    for (const auto& client : m_clients) stats.push_back(client->stats);
+    return stats;
+}
+
+void ReplicationServer::receive() {
+    UdpAddress from;
+    int size;
+    while ((size = m_socket.receiveFrom(from, m_receiveBuffer.data(), m_receiveBuffer.size())) > 0) {
+        handlePacket(from, m_receiveBuffer.data(), static_cast<size_t>(size));
+    }
+}
+
+void ReplicationServer::handlePacket(const UdpAddress& from, const uint8_t* data, size_t size) {
+    ByteReader in(data, size);
+    uint8_t type;
+    if (!readHeader(in, type)) return;
+
+    ClientConnection* client = findClient(from);
+    switch (type) {
+        case NetPacket::Hello: {
+            // Anything we send back must not exceed what the sender paid
+            if (size < NetPacket::kHelloBytes) return;
+            uint8_t version = in.readU8();
+            uint64_t cookie = in.readU64();
+            if (!in.ok() || version != NetPacket::kProtocolVersion) return;
+            if (!client) {
+                if (!cookieValid(from, cookie)) {
+                    // The cookie is recomputed on the way back, so nothing
+                    // is kept for senders that never answer
+                    m_packet.clear();
+                    ByteWriter out(m_packet);
+                    writeHeader(out, NetPacket::Challenge);
+                    out.writeU64(cookieFor(from, static_cast<uint32_t>(m_time / kCookieWindow)));
+                    m_socket.sendTo(from, m_packet.data(), m_packet.size());
+                    return;
+                }
+                if (m_clients.size() >= m_config.maxClients) {
+                    LOG_DEBUG("Replication: refusing {}, server full ({} clients)",
+                              from.toString(), m_clients.size());
+                    return;
+                }
+                auto connection = std::make_unique<ClientConnection>();
+                connection->address = from;
+                connection->stats.clientId = m_nextClientId++;
+                LOG_INFO("Replication: client {} connected from {}",
+                         connection->stats.clientId, from.toString());
+                m_clients.push_back(std::move(connection));
+                client = m_clients.back().get();
+            }
+            client->silence = 0.0f;
+            break;
+        }
+        case NetPacket::Ack: {
+            uint32_t tick = in.readU32();
+            if (!client || !in.ok()) return;
+            client->silence = 0.0f;
+            if (tick > client->stats.ackedTick && tick <= m_tick) client->stats.ackedTick = tick;
+            break;
+        }
+        case NetPacket::Disconnect: {
+            if (!client) return;
+            LOG_INFO("Replication: client {} disconnected", client->stats.clientId);
+            m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(),
+                [client](const std::unique_ptr<ClientConnection>& c) { return c.get() == client; }),
+                m_clients.end());
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void ReplicationServer::sendSnapshot(ClientConnection& client) {
+    // The baseline must still be in history and must not share a slot with
+    // the snapshot about to be written
+    const Snapshot* baseline = nullptr;
+    uint32_t acked = client.stats.ackedTick;
+    if (acked != 0 && m_tick - acked < kHistory) {
+        const Snapshot& candidate = client.sent[acked % kHistory];
+        if (candidate.tick == acked) baseline = &candidate;
+    }
+
+    m_packet.clear();
+    ByteWriter out(m_packet);
+    writeHeader(out, NetPacket::Snapshot);
+    out.writeVarUint(client.stats.clientId);
+    out.writeU32(m_tick);
+    out.writeU32(baseline ? acked : 0);
+    out.writeU32(floatBits(m_time));
+
+    size_t limit = std::min(m_config.maxPacketBytes, NetPacket::kMaxDatagram);
+    size_t budget = limit > out.size() ? limit - out.size() : 0;
+
+    Snapshot& sent = client.sent[m_tick % kHistory];
+    SnapshotEncodeStats encoded = client.encoder.encode(m_current, baseline, budget, out, sent);
+
+    m_socket.sendTo(client.address, m_packet.data(), m_packet.size());
+    client.stats.bytesSent += m_packet.size();
+    client.stats.packetsSent++;
+    client.stats.lastPacketBytes = m_packet.size();
+    client.stats.lastDeferred = encoded.deferred;
+}
+
+ReplicationServer::ClientConnection* ReplicationServer::findClient(const UdpAddress& address) {
+    for (auto& client : m_clients) {
+        if (client->address == address) return client.get();
+    }
+    return nullptr;
+}
+
+uint64_t ReplicationServer::cookieFor(const UdpAddress& address, uint32_t window) const {
+    KeyedHash hash(m_cookieKey);
+    hash.updateValue(address.ip).updateValue(address.port).updateValue(window);
+    uint64_t cookie = hash.finish();
+    return cookie != 0 ? cookie : 1;        // 0 means "no cookie" on the wire
+}
+
+bool ReplicationServer::cookieValid(const UdpAddress& address, uint64_t cookie) const {
+    if (cookie == 0) return false;
+    uint32_t window = static_cast<uint32_t>(m_time / kCookieWindow);
+    return cookie == cookieFor(address, window) ||
+           (window > 0 && cookie == cookieFor(address, window - 1));
+}
+
+// ============================================================================
+// ReplicationClient
+// ============================================================================
+
+bool ReplicationClient::connect(const ReplicationConfig& config) {
+    disconnect();
+    m_config = config;
+    if (!UdpAddress::parse(config.host, config.port, m_server)) {
+        LOG_ERROR("Replication: invalid server address '{}'", config.host);
+        return false;
+    }
+    if (!m_socket.open(0)) {
+        LOG_ERROR("Replication: could not open a UDP socket");
+        return false;
+    }
+    LOG_INFO("Replication: connecting to {}", m_server.toString());
+    return true;
+}
+
+void ReplicationClient::disconnect() {
+    if (!isOpen()) return;
+    m_packet.clear();
+    ByteWriter out(m_packet);
+    writeHeader(out, NetPacket::Disconnect);
+    m_socket.sendTo(m_server, m_packet.data(), m_packet.size());
+    m_socket.close();
+
+    m_clientId = 0;
+    m_silence = 0.0f;
+    m_helloTimer = 0.0f;
+    m_cookie = 0;
+    for (auto& snapshot : m_snapshots) snapshot.clear();
+    m_newestTick = 0;
+    m_clock = 0.0f;
+    m_bytesReceived = 0;
+    m_replicas.clear();
+}
+
+Entity ReplicationClient::findEntity(uint32_t netId) const {
+    auto it = m_replicas.find(netId);
+    return it != m_replicas.end() ? it->second : NullEntity;
+}
+
+void ReplicationClient::update(Registry& registry, float dt) {
+    if (!isOpen()) return;
+    m_silence += dt;
+    m_clock += dt;
+
+    if (!isConnected()) {
+        m_helloTimer -= dt;
+        if (m_helloTimer <= 0.0f) sendHello();
+    }
+
+    receive();
+    applyReplicas(registry);
+}
+
+void ReplicationClient::receive() {
+    UdpAddress from;
+    int size;
+    while ((size = m_socket.receiveFrom(from, m_receiveBuffer.data(), m_receiveBuffer.size())) > 0) {
+        if (from != m_server) continue;
+        m_bytesReceived += static_cast<uint64_t>(size);
+
+        ByteReader in(m_receiveBuffer.data(), static_cast<size_t>(size));
+        uint8_t type;
+        if (!readHeader(in, type)) continue;
+        if (type == NetPacket::Snapshot) {
+            handleSnapshot(in);
+        } else if (type == NetPacket::Challenge) {
+            uint64_t cookie = in.readU64();
+            if (!in.ok() || cookie == 0 || isConnected()) continue;
+            // Answer right away rather than waiting out the Hello interval
+            m_cookie = cookie;
+            sendHello();
+        } else if (type == NetPacket::Disconnect) {
+            LOG_INFO("Replication: server closed the connection");
+            m_clientId = 0;
+            m_silence = m_config.timeout;
+        }
+    }
+}
+
+void ReplicationClient::sendHello() {
+    m_packet.clear();
+    ByteWriter out(m_packet);
+    writeHeader(out, NetPacket::Hello);
+    out.writeU8(NetPacket::kProtocolVersion);
+    out.writeU64(m_cookie);
+    m_packet.resize(std::max(m_packet.size(), NetPacket::kHelloBytes), 0);
+    m_socket.sendTo(m_server, m_packet.data(), m_packet.size());
+    m_helloTimer = kHelloInterval;
+}
+
+void ReplicationClient::handleSnapshot(ByteReader& in) {
+    uint32_t clientId = in.readVarUint();
+    uint32_t tick = in.readU32();
+    uint32_t baselineTick = in.readU32();
+    float time = bitsFloat(in.readU32());
+    if (!in.ok() || tick == 0 || clientId == 0) return;
+
+    // A new ID means the server forgot us (timeout or restart): its ticks
+    // and baselines no longer match ours
+    if (clientId != m_clientId) {
+        for (auto& snapshot : m_snapshots) snapshot.clear();
+        m_newestTick = 0;
+    }
+    if (findSnapshot(tick)) return;                     // duplicate
+
+    const Snapshot* baseline = nullptr;
+    if (baselineTick != 0) {
+        baseline = findSnapshot(baselineTick);
+        if (!baseline) return;                          // can't decode without it
+    }
+    if (!m_decoder.decode(in, baseline, m_decoded)) return;
+    m_decoded.tick = tick;
+    m_decoded.time = time;
+
+    Snapshot& slot = m_snapshots[tick % kHistory];
+    if (slot.tick > tick) return;                       // older than the whole history
+    std::swap(slot, m_decoded);
+
+    if (m_clientId != clientId) {
+        m_clientId = clientId;
+        LOG_INFO("Replication: connected as client {}", clientId);
+    }
+    m_silence = 0.0f;
+
+    if (tick > m_newestTick) {
+        m_newestTick = tick;
+        if (time > m_clock || m_clock - time > kMaxClockLead) m_clock = time;
+    }
+
+    m_packet.clear();
+    ByteWriter out(m_packet);
+    writeHeader(out, NetPacket::Ack);
+    out.writeU32(m_newestTick);
+    m_socket.sendTo(m_server, m_packet.data(), m_packet.size());
+}
+
+const Snapshot* ReplicationClient::findSnapshot(uint32_t tick) const {
+    const Snapshot& slot = m_snapshots[tick % kHistory];
+    return (tick != 0 && slot.tick == tick) ? &slot : nullptr;
+}
+
+void ReplicationClient::applyReplicas(Registry& registry) {
+    const Snapshot* newest = findSnapshot(m_newestTick);
+    if (!newest) return;
+
+    m_timeline.clear();
+    for (const auto& snapshot : m_snapshots) {
+        if (snapshot.tick != 0 && snapshot.tick <= m_newestTick) m_timeline.push_back(&snapshot);
+    }
+    std::sort(m_timeline.begin(), m_timeline.end(),
+              [](const Snapshot* a, const Snapshot* b) { return a->tick < b->tick; });
+
+    // Replicas the server no longer sends
+    m_stale.clear();
+    for (const auto& [netId, entity] : m_replicas) {
+        if (!newest->find(netId)) m_stale.push_back(netId);
+    }
+    for (uint32_t netId : m_stale) {
+        registry.destroy(m_replicas[netId]);
+        m_replicas.erase(netId);
+    }
+
+    // Bracketing snapshots depend only on the delay, which nearly all
+    // entities share, so cache the last lookup
+    int32_t cachedDelayMs = -1;
+    const Snapshot* from = nullptr;
+    const Snapshot* to = nullptr;
+    float renderTime = 0.0f;
+
+    for (const NetEntityState& latest : newest->entities) {
+        if (latest.interpolationDelayMs != cachedDelayMs) {
+            cachedDelayMs = latest.interpolationDelayMs;
+            renderTime = m_clock - static_cast<float>(latest.interpolationDelayMs) / 1000.0f;
+            auto it = std::upper_bound(m_timeline.begin(), m_timeline.end(), renderTime,
+                [](float t, const Snapshot* s) { return t < s->time; });
+            from = it != m_timeline.begin() ? *(it - 1) : nullptr;
+            to = it != m_timeline.end() ? *it : nullptr;
+        }
+
+        const NetEntityState* a = from ? from->find(latest.netId) : nullptr;
+        const NetEntityState* b = to ? to->find(latest.netId) : nullptr;
+        if (!a && !b) a = &latest;
+        float t = 0.0f;
+        if (a && b && to->time > from->time) {
+            t = std::clamp((renderTime - from->time) / (to->time - from->time), 0.0f, 1.0f);
+        } else if (!a) {
+            a = b;
+        }
+        if (!b) b = a;
+
+        auto [it, inserted] = m_replicas.try_emplace(latest.netId, NullEntity);
+        Entity& entity = it->second;
+        if (!registry.valid(entity)) {
+            entity = registry.create();
+            registry.add<NetworkReplica>(entity, NetworkReplica{latest.netId});
+        }
+
+        auto* syncPtr = registry.tryGet<NetworkSync>(entity);
+        auto& sync = syncPtr ? *syncPtr : registry.add<NetworkSync>(entity);
+        sync.syncPosition = (latest.syncFlags & NetSyncFlags::Position) != 0;
+        sync.syncRotation = (latest.syncFlags & NetSyncFlags::Rotation) != 0;
+        sync.syncVelocity = (latest.syncFlags & NetSyncFlags::Velocity) != 0;
+        sync.interpolationDelay = static_cast<float>(latest.interpolationDelayMs) / 1000.0f;
+        sync.ownerClientId = latest.ownerClientId;
+
+        auto* transform = registry.tryGet<Transform>(entity);
+        if (!transform) transform = &registry.add<Transform>(entity);
+        if (sync.syncPosition) {
+            transform->position.x = lerp(NetQuantize::toPosition(a->x), NetQuantize::toPosition(b->x), t);
+            transform->position.y = lerp(NetQuantize::toPosition(a->y), NetQuantize::toPosition(b->y), t);
+        }
+        if (sync.syncRotation) transform->rotation = lerpRotation(a->rotation, b->rotation, t);
+        if (sync.syncVelocity) {
+            if (auto* velocity = registry.tryGet<Velocity>(entity)) {
+                velocity->linear.x = lerp(NetQuantize::toVelocity(a->vx), NetQuantize::toVelocity(b->vx), t);
+                velocity->linear.y = lerp(NetQuantize::toVelocity(a->vy), NetQuantize::toVelocity(b->vy), t);
+            }
+        }
+    }
+}
+
+} // namespace gloaming
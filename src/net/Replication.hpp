@@ -0,0 +1,202 @@
+#pragma once
+
+#include "ecs/Registry.hpp"
+#include "engine/KeyedHash.hpp"
+#include "net/Snapshot.hpp"
+#include "net/UdpSocket.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gloaming {
+
+/// Settings shared by ReplicationServer and ReplicationClient.
+struct ReplicationConfig {
+    std::string host = "127.0.0.1";     ///< Server address (client only)
+    uint16_t port = 27015;              ///< Server port (0 = any, server only)
+    float snapshotRate = 20.0f;         ///< Snapshots per second per client
+    size_t maxPacketBytes = 1200;       ///< Hard cap per snapshot packet (stays under MTU)
+    float timeout = 5.0f;               ///< Seconds of silence before dropping a peer
+    size_t maxClients = 16;             ///< Connections accepted at once (server only)
+};
+
+/// Wire format shared by server and client.
+namespace NetPacket {
+    constexpr uint16_t kMagic = 0x4C47;         ///< "GL"
+    constexpr uint8_t kProtocolVersion = 2;
+    constexpr size_t kMaxDatagram = 1500;
+
+    /// Hellos are zero-padded to this size. The server ignores shorter ones
+    /// and never answers one with more bytes, so a spoofed Hello can't be
+    /// used to amplify traffic toward its forged source.
+    constexpr size_t kHelloBytes = 64;
+
+    enum Type : uint8_t {
+        Hello = 1,          ///< client -> server: version, cookie (0 = none yet), padding
+        Snapshot = 2,       ///< server -> client: clientId, tick, baselineTick, time, payload
+        Ack = 3,            ///< client -> server: newest decoded tick
+        Disconnect = 4,     ///< either direction
+        Challenge = 5       ///< server -> client: cookie to echo in the next Hello
+    };
+}
+
+/// Per-client send statistics.
+struct ReplicationClientStats {
+    uint32_t clientId = 0;
+    uint64_t bytesSent = 0;
+    uint64_t packetsSent = 0;
+    size_t lastPacketBytes = 0;
+    uint32_t lastDeferred = 0;          ///< Changes that did not fit the last packet
+    uint32_t ackedTick = 0;
+};
+
+/// Server side of snapshot replication.
+///
+/// Every 1/snapshotRate seconds of update() time, captures all NetworkSync
+/// entities into a Snapshot and sends each client one datagram, delta-encoded
+/// against the newest snapshot that client has acknowledged (or against
+/// nothing, until the first ack). Each packet is capped at maxPacketBytes,
+/// so per-client bandwidth is bounded by maxPacketBytes * snapshotRate no
+/// matter how many entities exist; changes that don't fit wait for a later
+/// packet, stalest first.
+///
+/// Clients join with a stateless cookie round-trip: a Hello without a valid
+/// cookie gets only a small Challenge carrying one, derived by keyed hash
+/// from the sender's address and the current time window. Nothing is
+/// allocated and no snapshot is sent until a Hello echoes that cookie, which
+/// proves the sender can receive at the address it claims. At most
+/// maxClients connections are accepted; further Hellos are ignored. Clients
+/// are dropped after `timeout` seconds without a packet. Client IDs start at
+/// 1 (0 is the server, matching NetworkSync::ownerClientId).
+class ReplicationServer {
+public:
+    /// Snapshots remembered per client for delta baselines.
+    static constexpr size_t kHistory = 32;
+
+    ~ReplicationServer() { stop(); }
+
+    /// Bind the socket. Returns false if the port is unavailable.
+    bool start(const ReplicationConfig& config);
+    void stop();
+    bool isRunning() const { return m_socket.isOpen(); }
+    uint16_t port() const { return m_socket.localPort(); }
+
+    /// Receive client packets, then send snapshots when one is due.
+    void update(Registry& registry, float dt);
+
+    size_t clientCount() const { return m_clients.size(); }
+    uint32_t currentTick() const { return m_tick; }
+
+    /// Stats for every connected client, in join order.
+    std::vector<ReplicationClientStats> clientStats() const;
+
+private:
+    struct ClientConnection {
+        UdpAddress address;
+        ReplicationClientStats stats;
+        float silence = 0.0f;
+        SnapshotEncoder encoder;
+        std::array<Snapshot, kHistory> sent;    ///< Indexed by tick % kHistory
+    };
+
+    void receive();
+    void handlePacket(const UdpAddress& from, const uint8_t* data, size_t size);
+    void sendSnapshot(ClientConnection& client);
+    ClientConnection* findClient(const UdpAddress& address);
+
+    /// Handshake cookie for `address` in cookie time window `window`
+    uint64_t cookieFor(const UdpAddress& address, uint32_t window) const;
+    bool cookieValid(const UdpAddress& address, uint64_t cookie) const;
+
+    ReplicationConfig m_config;
+    UdpSocket m_socket;
+    HashKey m_cookieKey{};              ///< Fresh per start(); never leaves the server
+    std::vector<std::unique_ptr<ClientConnection>> m_clients;
+    uint32_t m_nextClientId = 1;
+
+    Snapshot m_current;
+    uint32_t m_tick = 0;
+    float m_time = 0.0f;
+    float m_sendAccumulator = 0.0f;
+
+    std::vector<uint8_t> m_packet;
+    std::array<uint8_t, NetPacket::kMaxDatagram> m_receiveBuffer{};
+};
+
+/// Client side of snapshot replication.
+///
+/// Decodes snapshots into a short history, acknowledges each one, and
+/// mirrors the server's NetworkSync entities as local entities tagged
+/// NetworkReplica. Every frame each replica is placed by interpolating the
+/// two snapshots around (estimated server time - interpolationDelay), using
+/// the delay the server set on that entity; the newest state is held when
+/// the buffer runs dry. Velocity is written only if the game gave the
+/// replica a Velocity component. Replicas are destroyed once the server
+/// stops sending them. Owned entities are interpolated like any other (no
+/// client-side prediction).
+class ReplicationClient {
+public:
+    /// Decoded snapshots kept for interpolation and as delta baselines.
+    /// Larger than the server's history so any baseline it picks is here.
+    static constexpr size_t kHistory = 64;
+
+    ~ReplicationClient() { disconnect(); }
+
+    /// Open a local socket and start the Hello/Challenge handshake with
+    /// config.host:port.
+    bool connect(const ReplicationConfig& config);
+    void disconnect();
+
+    bool isOpen() const { return m_socket.isOpen(); }
+
+    /// Whether a snapshot arrived within the timeout.
+    bool isConnected() const { return m_clientId != 0 && m_silence < m_config.timeout; }
+
+    /// ID the server assigned (0 until the first snapshot).
+    uint32_t clientId() const { return m_clientId; }
+
+    /// Receive snapshots, then move replicas to their interpolated state.
+    void update(Registry& registry, float dt);
+
+    /// Local entity replicating a server entity (NullEntity if none).
+    Entity findEntity(uint32_t netId) const;
+
+    /// Estimated current server time (seconds).
+    float serverTime() const { return m_clock; }
+    uint32_t newestTick() const { return m_newestTick; }
+    uint64_t bytesReceived() const { return m_bytesReceived; }
+
+private:
+    void receive();
+    void sendHello();
+    void handleSnapshot(ByteReader& in);
+    void applyReplicas(Registry& registry);
+    const Snapshot* findSnapshot(uint32_t tick) const;
+
+    ReplicationConfig m_config;
+    UdpSocket m_socket;
+    UdpAddress m_server;
+    uint32_t m_clientId = 0;
+    float m_silence = 0.0f;
+    float m_helloTimer = 0.0f;
+    uint64_t m_cookie = 0;              ///< From the server's last Challenge
+
+    SnapshotDecoder m_decoder;
+    std::array<Snapshot, kHistory> m_snapshots;     ///< Indexed by tick % kHistory
+    Snapshot m_decoded;                             ///< Decode target before it is stored
+    uint32_t m_newestTick = 0;
+    float m_clock = 0.0f;
+    uint64_t m_bytesReceived = 0;
+
+    std::unordered_map<uint32_t, Entity> m_replicas;
+    std::vector<const Snapshot*> m_timeline;        ///< Scratch: history sorted by time
+    std::vector<uint32_t> m_stale;                  ///< Scratch: replicas to destroy
+    std::vector<uint8_t> m_packet;
+    std::array<uint8_t, NetPacket::kMaxDatagram> m_receiveBuffer{};
+};
+
+} // namespace gloaming
@@ -0,0 +1,325 @@
+#include "net/Snapshot.hpp"
+#include "ecs/Components.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gloaming {
+
+namespace {
+
+// Field groups in an update record's mask
+constexpr uint8_t kFieldPosition = 1 << 0;
+constexpr uint8_t kFieldVelocity = 1 << 1;
+constexpr uint8_t kFieldRotation = 1 << 2;
+constexpr uint8_t kFieldMeta     = 1 << 3;
+constexpr uint8_t kFieldAll      = kFieldPosition | kFieldVelocity | kFieldRotation | kFieldMeta;
+
+/// Smallest possible update record: netId delta + mask.
+constexpr size_t kMinRecordBytes = 2;
+
+int32_t quantize(float v, float scale) {
+    float q = std::round(v * scale);
+    if (!(q > -2147483520.0f)) return INT32_MIN + 128;    // also catches NaN
+    if (q > 2147483520.0f) return INT32_MAX - 128;
+    return static_cast<int32_t>(q);
+}
+
+uint8_t changedFields(const NetEntityState& a, const NetEntityState& b) {
+    uint8_t mask = 0;
+    if (a.x != b.x || a.y != b.y) mask |= kFieldPosition;
+    if (a.vx != b.vx || a.vy != b.vy) mask |= kFieldVelocity;
+    if (a.rotation != b.rotation) mask |= kFieldRotation;
+    if (a.syncFlags != b.syncFlags || a.ownerClientId != b.ownerClientId ||
+        a.interpolationDelayMs != b.interpolationDelayMs) {
+        mask |= kFieldMeta;
+    }
+    return mask;
+}
+
+size_t varIntSize(int32_t v) { return ByteWriter::varUintSize(ByteWriter::zigzag(v)); }
+
+/// Deltas wrap modulo 2^32 on both ends, so extreme values round-trip.
+int32_t delta(int32_t to, int32_t from) {
+    return static_cast<int32_t>(static_cast<uint32_t>(to) - static_cast<uint32_t>(from));
+}
+
+int32_t applyDelta(int32_t base, int32_t d) {
+    return static_cast<int32_t>(static_cast<uint32_t>(base) + static_cast<uint32_t>(d));
+}
+
+/// Encoded size of an update record, with the netId delta bounded by the
+/// netId itself (the real delta from the previous record is never larger).
+size_t recordSize(const NetEntityState& s, const NetEntityState& base, uint8_t mask) {
+    size_t size = ByteWriter::varUintSize(s.netId) + 1;
+    if (mask & kFieldPosition) size += varIntSize(delta(s.x, base.x)) + varIntSize(delta(s.y, base.y));
+    if (mask & kFieldVelocity) size += varIntSize(delta(s.vx, base.vx)) + varIntSize(delta(s.vy, base.vy));
+    if (mask & kFieldRotation) size += varIntSize(delta(s.rotation, base.rotation));
+    if (mask & kFieldMeta) {
+        size += 1 + ByteWriter::varUintSize(s.ownerClientId) +
+                ByteWriter::varUintSize(s.interpolationDelayMs);
+    }
+    return size;
+}
+
+/// out = baseline - removed + updates. Both lists are sorted by netId and
+/// every update replaces (or adds) the entity with the same netId.
+void mergeSnapshot(const Snapshot* baseline, const std::vector<uint32_t>& removed,
+                   const std::vector<NetEntityState>& updates, Snapshot& out) {
+    out.entities.clear();
+    static const std::vector<NetEntityState> kEmpty;
+    const auto& base = baseline ? baseline->entities : kEmpty;
+    out.entities.reserve(base.size() + updates.size());
+
+    size_t b = 0, u = 0, r = 0;
+    while (b < base.size() || u < updates.size()) {
+        bool takeUpdate = b >= base.size() ||
+                          (u < updates.size() && updates[u].netId <= base[b].netId);
+        if (takeUpdate) {
+            if (b < base.size() && base[b].netId == updates[u].netId) ++b;
+            out.entities.push_back(updates[u++]);
+            continue;
+        }
+        while (r < removed.size() && removed[r] < base[b].netId) ++r;
+        if (r < removed.size() && removed[r] == base[b].netId) {
+            ++b;
+            continue;
+        }
+        out.entities.push_back(base[b++]);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Quantization
+// ============================================================================
+
+int32_t NetQuantize::position(float v) { return quantize(v, kPositionScale); }
+int32_t NetQuantize::velocity(float v) { return quantize(v, kVelocityScale); }
+
+int32_t NetQuantize::rotation(float degrees) {
+    float wrapped = std::fmod(degrees, 360.0f);
+    if (wrapped < 0.0f) wrapped += 360.0f;
+    if (!(wrapped >= 0.0f)) wrapped = 0.0f;     // NaN
+    return static_cast<int32_t>(std::lround(wrapped * kRotationScale)) & 0xFFFF;
+}
+
+// ============================================================================
+// Snapshot
+// ============================================================================
+
+const NetEntityState* Snapshot::find(uint32_t netId) const {
+    auto it = std::lower_bound(entities.begin(), entities.end(), netId,
+        [](const NetEntityState& s, uint32_t id) { return s.netId < id; });
+    return (it != entities.end() && it->netId == netId) ? &*it : nullptr;
+}
+
+void captureSnapshot(Registry& registry, uint32_t tick, float time, Snapshot& out) {
+    out.tick = tick;
+    out.time = time;
+    out.entities.clear();
+
+    registry.each<NetworkSync, Transform>([&](Entity entity, NetworkSync& sync, Transform& transform) {
+        NetEntityState s;
+        s.netId = static_cast<uint32_t>(entity);
+        s.ownerClientId = sync.ownerClientId;
+        float delayMs = std::clamp(sync.interpolationDelay * 1000.0f, 0.0f, 65535.0f);
+        s.interpolationDelayMs = static_cast<uint16_t>(delayMs);
+        s.updatedTick = tick;
+
+        if (sync.syncPosition) {
+            s.syncFlags |= NetSyncFlags::Position;
+            s.x = NetQuantize::position(transform.position.x);
+            s.y = NetQuantize::position(transform.position.y);
+        }
+        if (sync.syncRotation) {
+            s.syncFlags |= NetSyncFlags::Rotation;
+            s.rotation = NetQuantize::rotation(transform.rotation);
+        }
+        if (sync.syncVelocity) {
+            s.syncFlags |= NetSyncFlags::Velocity;
+            if (const auto* vel = registry.tryGet<Velocity>(entity)) {
+                s.vx = NetQuantize::velocity(vel->linear.x);
+                s.vy = NetQuantize::velocity(vel->linear.y);
+            }
+        }
+        out.entities.push_back(s);
+    });
+
+    std::sort(out.entities.begin(), out.entities.end(),
+              [](const NetEntityState& a, const NetEntityState& b) { return a.netId < b.netId; });
+}
+
+// ============================================================================
+// SnapshotEncoder
+// ============================================================================
+
+SnapshotEncodeStats SnapshotEncoder::encode(const Snapshot& current, const Snapshot* baseline,
+                                            size_t budgetBytes, ByteWriter& out, Snapshot& sent) {
+    SnapshotEncodeStats stats;
+    m_candidates.clear();
+    m_selected.clear();
+    m_removals.clear();
+    m_removalsSent.clear();
+    m_updates.clear();
+
+    static const NetEntityState kZeroState;
+    static const std::vector<NetEntityState> kEmpty;
+    const auto& base = baseline ? baseline->entities : kEmpty;
+
+    // Diff current against the baseline (both sorted by netId)
+    size_t b = 0;
+    for (uint32_t c = 0; c < current.entities.size(); ++c) {
+        const NetEntityState& s = current.entities[c];
+        while (b < base.size() && base[b].netId < s.netId) m_removals.push_back(base[b++].netId);
+
+        if (b < base.size() && base[b].netId == s.netId) {
+            uint8_t mask = changedFields(s, base[b]);
+            if (mask != 0) {
+                uint32_t staleness = current.tick > base[b].updatedTick
+                                   ? current.tick - base[b].updatedTick : 1;
+                m_candidates.push_back({c, static_cast<int32_t>(b), staleness,
+                                        recordSize(s, base[b], mask)});
+            }
+            ++b;
+        } else {
+            m_candidates.push_back({c, -1, UINT32_MAX,
+                                    recordSize(s, kZeroState, kFieldAll)});
+        }
+    }
+    while (b < base.size()) m_removals.push_back(base[b++].netId);
+
+    // Budget: the two counts, then removals (cheap), then spawns and the
+    // stalest changes that still fit
+    size_t remaining = budgetBytes;
+    size_t countBytes = ByteWriter::varUintSize(static_cast<uint32_t>(m_removals.size())) +
+                        ByteWriter::varUintSize(static_cast<uint32_t>(m_candidates.size()));
+    remaining = remaining > countBytes ? remaining - countBytes : 0;
+
+    for (uint32_t id : m_removals) {
+        size_t size = ByteWriter::varUintSize(id);
+        if (size > remaining) break;
+        remaining -= size;
+        m_removalsSent.push_back(id);
+    }
+
+    std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate& a, const Candidate& b) {
+        if (a.priority != b.priority) return a.priority > b.priority;
+        return a.current < b.current;
+    });
+    for (const auto& candidate : m_candidates) {
+        if (remaining < kMinRecordBytes) break;
+        if (candidate.maxBytes > remaining) continue;
+        remaining -= candidate.maxBytes;
+        m_selected.push_back(candidate);
+    }
+    std::sort(m_selected.begin(), m_selected.end(),
+              [](const Candidate& a, const Candidate& b) { return a.current < b.current; });
+
+    // Write
+    size_t start = out.size();
+    out.writeVarUint(static_cast<uint32_t>(m_removalsSent.size()));
+    uint32_t prevId = 0;
+    for (uint32_t id : m_removalsSent) {
+        out.writeVarUint(id - prevId);
+        prevId = id;
+    }
+
+    out.writeVarUint(static_cast<uint32_t>(m_selected.size()));
+    prevId = 0;
+    for (const auto& candidate : m_selected) {
+        const NetEntityState& s = current.entities[candidate.current];
+        const NetEntityState& from = candidate.baseline >= 0 ? base[candidate.baseline] : kZeroState;
+        uint8_t mask = candidate.baseline >= 0 ? changedFields(s, from) : kFieldAll;
+
+        out.writeVarUint(s.netId - prevId);
+        prevId = s.netId;
+        out.writeU8(mask);
+        if (mask & kFieldPosition) {
+            out.writeVarInt(delta(s.x, from.x));
+            out.writeVarInt(delta(s.y, from.y));
+        }
+        if (mask & kFieldVelocity) {
+            out.writeVarInt(delta(s.vx, from.vx));
+            out.writeVarInt(delta(s.vy, from.vy));
+        }
+        if (mask & kFieldRotation) out.writeVarInt(delta(s.rotation, from.rotation));
+        if (mask & kFieldMeta) {
+            out.writeU8(s.syncFlags);
+            out.writeVarUint(s.ownerClientId);
+            out.writeVarUint(s.interpolationDelayMs);
+        }
+
+        NetEntityState written = s;
+        written.updatedTick = current.tick;
+        m_updates.push_back(written);
+    }
+
+    mergeSnapshot(baseline, m_removalsSent, m_updates, sent);
+    sent.tick = current.tick;
+    sent.time = current.time;
+
+    stats.bytes = out.size() - start;
+    stats.updated = static_cast<uint32_t>(m_selected.size());
+    stats.removed = static_cast<uint32_t>(m_removalsSent.size());
+    stats.deferred = static_cast<uint32_t>(m_candidates.size() - m_selected.size() +
+                                           m_removals.size() - m_removalsSent.size());
+    return stats;
+}
+
+// ============================================================================
+// SnapshotDecoder
+// ============================================================================
+
+bool SnapshotDecoder::decode(ByteReader& in, const Snapshot* baseline, Snapshot& out) {
+    static const NetEntityState kZeroState;
+    m_removed.clear();
+    m_updates.clear();
+
+    uint32_t removedCount = in.readVarUint();
+    if (!in.ok() || removedCount > in.remaining()) return false;
+    uint32_t id = 0;
+    for (uint32_t i = 0; i < removedCount; ++i) {
+        uint32_t gap = in.readVarUint();
+        if (i > 0 && gap == 0) return false;        // ids must be strictly increasing
+        id += gap;
+        m_removed.push_back(id);
+    }
+
+    uint32_t updateCount = in.readVarUint();
+    if (!in.ok() || updateCount > in.remaining() / kMinRecordBytes) return false;
+    id = 0;
+    for (uint32_t i = 0; i < updateCount; ++i) {
+        uint32_t gap = in.readVarUint();
+        if (i > 0 && gap == 0) return false;
+        id += gap;
+
+        const NetEntityState* found = baseline ? baseline->find(id) : nullptr;
+        NetEntityState s = found ? *found : kZeroState;
+        s.netId = id;
+
+        uint8_t mask = in.readU8();
+        if (mask & kFieldPosition) {
+            s.x = applyDelta(s.x, in.readVarInt());
+            s.y = applyDelta(s.y, in.readVarInt());
+        }
+        if (mask & kFieldVelocity) {
+            s.vx = applyDelta(s.vx, in.readVarInt());
+            s.vy = applyDelta(s.vy, in.readVarInt());
+        }
+        if (mask & kFieldRotation) s.rotation = applyDelta(s.rotation, in.readVarInt());
+        if (mask & kFieldMeta) {
+            s.syncFlags = in.readU8();
+            s.ownerClientId = in.readVarUint();
+            s.interpolationDelayMs = static_cast<uint16_t>(in.readVarUint());
+        }
+        if (!in.ok()) return false;
+        m_updates.push_back(s);
+    }
+
+    mergeSnapshot(baseline, m_removed, m_updates, out);
+    return in.ok();
+}
+
+} // namespace gloaming
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "ecs/Registry.hpp"
+#include "net/ByteStream.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gloaming {
+
+/// Quantized replication state of one NetworkSync entity.
+///
+/// Positions and velocities are fixed-point (1/16 px, 1/16 px/s), rotation
+/// is a 16-bit angle. Comparing quantized values is what decides whether an
+/// entity changed, so sub-quantum jitter never costs bandwidth.
+struct NetEntityState {
+    uint32_t netId = 0;             ///< Server entity ID (index + version)
+    int32_t x = 0, y = 0;
+    int32_t vx = 0, vy = 0;
+    int32_t rotation = 0;           ///< 0..65535 = 0..360 degrees
+    uint32_t ownerClientId = 0;
+    uint16_t interpolationDelayMs = 0;
+    uint8_t syncFlags = 0;          ///< NetSyncFlags of the source NetworkSync
+
+    /// Tick this state was last written into a sent snapshot. Server-side
+    /// bookkeeping for send priority; never serialized.
+    uint32_t updatedTick = 0;
+};
+
+namespace NetSyncFlags {
+    constexpr uint8_t Position = 1 << 0;
+    constexpr uint8_t Rotation = 1 << 1;
+    constexpr uint8_t Velocity = 1 << 2;
+}
+
+/// Quantization helpers shared by the encoder and the client.
+namespace NetQuantize {
+    constexpr float kPositionScale = 16.0f;    ///< Steps per pixel
+    constexpr float kVelocityScale = 16.0f;    ///< Steps per pixel/second
+    constexpr float kRotationScale = 65536.0f / 360.0f;
+
+    int32_t position(float v);
+    int32_t velocity(float v);
+    int32_t rotation(float degrees);
+
+    inline float toPosition(int32_t q) { return static_cast<float>(q) / kPositionScale; }
+    inline float toVelocity(int32_t q) { return static_cast<float>(q) / kVelocityScale; }
+    inline float toRotation(int32_t q) { return static_cast<float>(q) / kRotationScale; }
+}
+
+/// All replicated entities at one server tick, sorted by netId.
+struct Snapshot {
+    uint32_t tick = 0;              ///< 0 = empty / never captured
+    float time = 0.0f;              ///< Server time in seconds
+    std::vector<NetEntityState> entities;
+
+    /// Binary search by netId (nullptr if absent).
+    const NetEntityState* find(uint32_t netId) const;
+
+    void clear() {
+        tick = 0;
+        time = 0.0f;
+        entities.clear();
+    }
+};
+
+/// Fill `out` with every entity that has NetworkSync and Transform.
+/// Velocity is read when present and syncVelocity is set. Reuses out's capacity.
+void captureSnapshot(Registry& registry, uint32_t tick, float time, Snapshot& out);
+
+/// Outcome of one SnapshotEncoder::encode call.
+struct SnapshotEncodeStats {
+    size_t bytes = 0;           ///< Payload bytes written
+    uint32_t updated = 0;       ///< Entities sent (new or changed)
+    uint32_t removed = 0;       ///< Removals sent
+    uint32_t deferred = 0;      ///< Changes left for a later packet (over budget)
+};
+
+/// Delta-encodes snapshots against a client's last acknowledged snapshot.
+///
+/// Only entities whose quantized state differs from the baseline are
+/// written, and only the changed field groups of each. Every record is
+/// budgeted: when the changes don't fit in `budgetBytes`, entities the
+/// client has never seen go first, then the stalest changes, and the rest
+/// are deferred, so a packet never exceeds the budget however many
+/// entities exist. Deferred changes stay pending because the baseline
+/// still holds the old state.
+///
+/// encode() also produces `sent`: the snapshot the client will hold after
+/// decoding this packet (baseline plus the records actually written). The
+/// server keeps it as the baseline to use once the client acknowledges it.
+///
+/// Payload layout (all varints):
+///   removedCount, removed netIds (delta from the previous)
+///   updateCount, per update: netId delta, field mask (u8), fields
+///     Position: dx, dy    Velocity: dvx, dvy    Rotation: drot
+///     Meta: syncFlags, ownerClientId, interpolationDelayMs
+/// Field values are deltas against the baseline state (zero for new entities).
+class SnapshotEncoder {
+public:
+    SnapshotEncodeStats encode(const Snapshot& current, const Snapshot* baseline,
+                               size_t budgetBytes, ByteWriter& out, Snapshot& sent);
+
+private:
+    struct Candidate {
+        uint32_t current;       ///< Index into current.entities
+        int32_t baseline;       ///< Index into baseline entities (-1 = new)
+        uint32_t priority;      ///< Ticks since last sent (UINT32_MAX = new)
+        size_t maxBytes;        ///< Upper bound on the encoded record size
+    };
+
+    std::vector<Candidate> m_candidates;
+    std::vector<Candidate> m_selected;
+    std::vector<uint32_t> m_removals;        ///< netIds in the baseline but not in current
+    std::vector<uint32_t> m_removalsSent;
+    std::vector<NetEntityState> m_updates;
+};
+
+/// Rebuilds snapshots from payloads written by SnapshotEncoder.
+class SnapshotDecoder {
+public:
+    /// `baseline` must be the snapshot the encoder used (nullptr if none).
+    /// Returns false on a malformed payload; `out` is unspecified then.
+    /// out.tick and out.time are left to the caller (they travel in the
+    /// packet header).
+    bool decode(ByteReader& in, const Snapshot* baseline, Snapshot& out);
+
+private:
+    std::vector<uint32_t> m_removed;
+    std::vector<NetEntityState> m_updates;
+};
+
+} // namespace gloaming
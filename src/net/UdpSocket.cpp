@@ -0,0 +1,172 @@
+#include "net/UdpSocket.hpp"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+
+namespace gloaming {
+
+namespace {
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+
+/// Winsock needs one WSAStartup per process before any socket call.
+bool ensureWinsock() {
+    static const bool started = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return started;
+}
+
+bool wouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+void closeHandle(SocketHandle s) { closesocket(s); }
+#else
+using SocketHandle = int;
+
+bool ensureWinsock() { return true; }
+bool wouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+void closeHandle(SocketHandle s) { ::close(s); }
+#endif
+
+SocketHandle toSocket(intptr_t handle) { return static_cast<SocketHandle>(handle); }
+
+sockaddr_in toSockaddr(const UdpAddress& address) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(address.ip);
+    addr.sin_port = htons(address.port);
+    return addr;
+}
+
+} // namespace
+
+// ============================================================================
+// UdpAddress
+// ============================================================================
+
+bool UdpAddress::parse(const std::string& host, uint16_t port, UdpAddress& out) {
+    const std::string& text = (host == "localhost") ? std::string("127.0.0.1") : host;
+    unsigned a, b, c, d;
+    char trailing;
+    if (std::sscanf(text.c_str(), "%u.%u.%u.%u%c", &a, &b, &c, &d, &trailing) != 4) return false;
+    if (a > 255 || b > 255 || c > 255 || d > 255) return false;
+    out.ip = (a << 24) | (b << 16) | (c << 8) | d;
+    out.port = port;
+    return true;
+}
+
+std::string UdpAddress::toString() const {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u:%u",
+                  (ip >> 24) & 0xFF, (ip >> 16) & 0xFF, (ip >> 8) & 0xFF, ip & 0xFF, port);
+    return buffer;
+}
+
+// ============================================================================
+// UdpSocket
+// ============================================================================
+
+UdpSocket::~UdpSocket() {
+    close();
+}
+
+bool UdpSocket::open(uint16_t port) {
+    close();
+    if (!ensureWinsock()) return false;
+
+    SocketHandle s = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifdef _WIN32
+    if (s == INVALID_SOCKET) return false;
+#else
+    if (s < 0) return false;
+#endif
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (::bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        closeHandle(s);
+        return false;
+    }
+
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    bool ok = ioctlsocket(s, FIONBIO, &nonBlocking) == 0;
+#else
+    int flags = fcntl(s, F_GETFL, 0);
+    bool ok = flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+    if (!ok) {
+        closeHandle(s);
+        return false;
+    }
+
+    sockaddr_in bound{};
+    socklen_t length = sizeof(bound);
+    if (::getsockname(s, reinterpret_cast<sockaddr*>(&bound), &length) == 0) {
+        m_localPort = ntohs(bound.sin_port);
+    } else {
+        m_localPort = port;
+    }
+
+    m_handle = static_cast<intptr_t>(s);
+    return true;
+}
+
+void UdpSocket::close() {
+    if (!isOpen()) return;
+    closeHandle(toSocket(m_handle));
+    m_handle = kInvalidHandle;
+    m_localPort = 0;
+}
+
+bool UdpSocket::sendTo(const UdpAddress& to, const uint8_t* data, size_t size) {
+    if (!isOpen()) return false;
+    sockaddr_in addr = toSockaddr(to);
+    auto sent = ::sendto(toSocket(m_handle), reinterpret_cast<const char*>(data),
+                         static_cast<int>(size), 0,
+                         reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    return sent == static_cast<decltype(sent)>(size);
+}
+
+int UdpSocket::receiveFrom(UdpAddress& from, uint8_t* buffer, size_t capacity) {
+    if (!isOpen()) return -1;
+    sockaddr_in addr{};
+    socklen_t length = sizeof(addr);
+    auto received = ::recvfrom(toSocket(m_handle), reinterpret_cast<char*>(buffer),
+                               static_cast<int>(capacity), 0,
+                               reinterpret_cast<sockaddr*>(&addr), &length);
+    if (received < 0) {
+#ifdef _WIN32
+        // Oversized datagrams and ICMP port-unreachable surface as errors on
+        // Winsock; treat both as a dropped packet
+        int error = WSAGetLastError();
+        if (error == WSAEMSGSIZE || error == WSAECONNRESET) return 0;
+#endif
+        return wouldBlock() ? 0 : -1;
+    }
+    from.ip = ntohl(addr.sin_addr.s_addr);
+    from.port = ntohs(addr.sin_port);
+    return static_cast<int>(received);
+}
+
+} // namespace gloaming
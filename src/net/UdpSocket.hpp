@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gloaming {
+
+/// IPv4 endpoint (host byte order).
+struct UdpAddress {
+    uint32_t ip = 0;
+    uint16_t port = 0;
+
+    bool operator==(const UdpAddress& other) const { return ip == other.ip && port == other.port; }
+    bool operator!=(const UdpAddress& other) const { return !(*this == other); }
+
+    /// Parse a dotted IPv4 address or "localhost".
+    static bool parse(const std::string& host, uint16_t port, UdpAddress& out);
+
+    std::string toString() const;
+};
+
+/// Minimal non-blocking IPv4 UDP socket (BSD sockets / Winsock).
+class UdpSocket {
+public:
+    UdpSocket() = default;
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    /// Bind to `port` on all interfaces (0 = any free port).
+    bool open(uint16_t port = 0);
+    void close();
+    bool isOpen() const { return m_handle != kInvalidHandle; }
+
+    /// Port actually bound (useful after open(0)).
+    uint16_t localPort() const { return m_localPort; }
+
+    /// Send one datagram. Returns false if the OS rejected it.
+    bool sendTo(const UdpAddress& to, const uint8_t* data, size_t size);
+
+    /// Receive one datagram if available. Returns its size, 0 when nothing is
+    /// queued, or -1 on error. Datagrams larger than `capacity` come back
+    /// truncated (or dropped on Winsock).
+    int receiveFrom(UdpAddress& from, uint8_t* buffer, size_t capacity);
+
+private:
+    static constexpr intptr_t kInvalidHandle = -1;
+
+    intptr_t m_handle = kInvalidHandle;
+    uint16_t m_localPort = 0;
+};
+
+} // namespace gloaming
@@ -9,3 +9,4 @@
 #include "physics/Trigger.hpp"
 #include "physics/Raycast.hpp"
 #include "physics/PhysicsSystem.hpp"
+#include "physics/SpatialIndex.hpp"
@@ -1,12 +1,21 @@
 #include "physics/PhysicsSystem.hpp"
+#include "engine/Engine.hpp"
 
-// PhysicsSystem implementation is in the header file (inline)
-// This source file exists to verify header compilation and for future
-// non-inline implementations if needed.
+// Most of PhysicsSystem is inline in the header. init() lives here because it
+// needs the full Engine definition, which the header can't include (Engine
+// pulls in GameMode, which pulls in PhysicsSystem).
 
 namespace gloaming {
 
-// Currently all implementations are inline in the header.
-// Add any non-inline implementations here if needed in the future.
+void PhysicsSystem::init(Registry& registry, Engine& engine) {
+    System::init(registry, engine);
+    m_triggerSystem.init(registry);
+    m_jobSystem = &engine.getJobSystem();
+
+    // Get tile size from config if available
+    // Default is 16 pixels
+    m_tileSize = 16;
+    m_tileCollision.setTileSize(m_tileSize);
+}
 
 } // namespace gloaming
@@ -8,6 +8,7 @@
 #include "ecs/Systems.hpp"
 #include "ecs/Components.hpp"
 #include "ecs/Registry.hpp"
+#include "engine/JobSystem.hpp"
 #include "world/TileMap.hpp"
 #include <functional>
 #include <vector>
@@ -27,6 +28,7 @@ struct PhysicsConfig {
     float groundCheckDistance = 2.0f;   // Distance to check for ground
     bool enableSweepCollision = true;   // Use swept collision for fast objects
     float sweepThreshold = 100.0f;      // Speed above which to use swept collision
+    size_t parallelGrain = 128;         // Bodies per integration job (0 = always serial)
 };
 
 /// Collision event data
@@ -46,6 +48,14 @@ using CollisionCallback = std::function<void(const CollisionEvent&)>;
 
 /// Main physics system
 /// Handles gravity, velocity, and collision detection/response
+///
+/// Body integration (velocity, tile collision, grounding) touches only the
+/// body's own components and reads the tile map, so with a running JobSystem
+/// it is split into batches of parallelGrain bodies that run on workers.
+/// Tile collision events are buffered per batch and fired afterwards in
+/// entity order, so callbacks see the same sequence whether the pass ran
+/// serially or in parallel. Entity-entity collisions and triggers still run
+/// serially after integration.
 class PhysicsSystem : public System {
 public:
     explicit PhysicsSystem(const PhysicsConfig& config = PhysicsConfig())
@@ -62,6 +72,9 @@ public:
     /// Set the tile map for tile collision
     void setTileMap(TileMap* tileMap);
 
+    /// Job system for the integration phase (init() uses the engine's; nullptr = serial)
+    void setJobSystem(JobSystem* jobs) { m_jobSystem = jobs; }
+
     /// Get tile collision handler
     TileCollision& getTileCollision() { return m_tileCollision; }
     const TileCollision& getTileCollision() const { return m_tileCollision; }
@@ -112,15 +125,29 @@ public:
     const Stats& getStats() const { return m_stats; }
 
 private:
+    /// A moving body's components, gathered once per update
+    struct Body {
+        Entity entity;
+        Transform* transform;
+        Velocity* velocity;
+        Collider* collider;
+        Gravity* gravity;
+    };
+
+    /// Output of one integration batch, merged in batch order
+    struct IntegrationBatch {
+        std::vector<CollisionEvent> events;
+        size_t tileCollisions = 0;
+    };
+
     /// Apply gravity to all gravity-affected entities
     void applyGravity(float dt);
 
     /// Update entity positions based on velocity
     void updatePositions(float dt);
 
-    /// Process a single entity's physics
-    void processEntity(Entity entity, Transform& transform, Velocity& velocity,
-                       Collider* collider, Gravity* gravity, float dt);
+    /// Process a single entity's physics (safe to run concurrently for distinct bodies)
+    void processEntity(const Body& body, float dt, IntegrationBatch& out);
 
     /// Handle entity-to-entity collisions
     void handleEntityCollisions();
@@ -133,7 +160,10 @@ private:
     int m_tileSize = 16;
     TileCollision m_tileCollision;
     TriggerSystem m_triggerSystem;
+    JobSystem* m_jobSystem = nullptr;
     std::vector<CollisionCallback> m_collisionCallbacks;
+    std::vector<Body> m_bodies;                 ///< Scratch: this update's moving bodies
+    std::vector<IntegrationBatch> m_batches;    ///< Scratch: reused across updates
     Stats m_stats;
 };
 
@@ -141,16 +171,6 @@ private:
 // Implementation
 // ============================================================================
 
-inline void PhysicsSystem::init(Registry& registry, Engine& engine) {
-    System::init(registry, engine);
-    m_triggerSystem.init(registry);
-
-    // Get tile size from config if available
-    // Default is 16 pixels
-    m_tileSize = 16;
-    m_tileCollision.setTileSize(m_tileSize);
-}
-
 inline void PhysicsSystem::setTileMap(TileMap* tileMap) {
     m_tileMap = tileMap;
     m_tileCollision.setTileMap(tileMap);
@@ -200,27 +220,55 @@ inline void PhysicsSystem::applyGravity(float dt) {
 inline void PhysicsSystem::updatePositions(float dt) {
     auto& registry = getRegistry();
 
-    // Process entities with velocity
+    // Gather bodies serially; the batches below then only touch these pointers
+    m_bodies.clear();
     auto view = registry.view<Transform, Velocity>();
     for (auto entity : view) {
-        auto& transform = view.get<Transform>(entity);
-        auto& velocity = view.get<Velocity>(entity);
-
-        Collider* collider = registry.has<Collider>(entity)
-            ? &registry.get<Collider>(entity)
-            : nullptr;
+        m_bodies.push_back({entity, &view.get<Transform>(entity), &view.get<Velocity>(entity),
+                            registry.tryGet<Collider>(entity), registry.tryGet<Gravity>(entity)});
+    }
+    m_stats.entitiesProcessed = m_bodies.size();
+    if (m_bodies.empty()) return;
+
+    // Batch boundaries depend only on the body count, so events merge in
+    // the same order however the batches were scheduled
+    const size_t grain = m_config.parallelGrain > 0 ? m_config.parallelGrain : m_bodies.size();
+    const size_t batchCount = (m_bodies.size() + grain - 1) / grain;
+    if (m_batches.size() < batchCount) m_batches.resize(batchCount);
+
+    auto runBatches = [this, dt, grain](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            IntegrationBatch& batch = m_batches[b];
+            batch.events.clear();
+            batch.tileCollisions = 0;
+            const size_t last = std::min(m_bodies.size(), (b + 1) * grain);
+            for (size_t i = b * grain; i < last; ++i) {
+                processEntity(m_bodies[i], dt, batch);
+            }
+        }
+    };
 
-        Gravity* gravity = registry.has<Gravity>(entity)
-            ? &registry.get<Gravity>(entity)
-            : nullptr;
+    if (m_jobSystem && batchCount > 1) {
+        m_jobSystem->parallelFor(batchCount, 1, runBatches);
+    } else {
+        runBatches(0, batchCount);
+    }
 
-        processEntity(entity, transform, velocity, collider, gravity, dt);
-        ++m_stats.entitiesProcessed;
+    for (size_t b = 0; b < batchCount; ++b) {
+        m_stats.tileCollisions += m_batches[b].tileCollisions;
+        for (const CollisionEvent& event : m_batches[b].events) {
+            fireCollisionEvent(event);
+        }
     }
 }
 
-inline void PhysicsSystem::processEntity(Entity entity, Transform& transform, Velocity& velocity,
-                                          Collider* collider, Gravity* gravity, float dt) {
+inline void PhysicsSystem::processEntity(const Body& body, float dt, IntegrationBatch& out) {
+    Entity entity = body.entity;
+    Transform& transform = *body.transform;
+    Velocity& velocity = *body.velocity;
+    Collider* collider = body.collider;
+    Gravity* gravity = body.gravity;
+
     // Clamp horizontal speed
     if (std::abs(velocity.linear.x) > m_config.maxHorizontalSpeed) {
         velocity.linear.x = velocity.linear.x > 0 ? m_config.maxHorizontalSpeed : -m_config.maxHorizontalSpeed;
@@ -263,8 +311,8 @@ inline void PhysicsSystem::processEntity(Entity entity, Transform& transform, Ve
                 event.tileX = moveResult.collisions[0].tileX;
                 event.tileY = moveResult.collisions[0].tileY;
             }
-            fireCollisionEvent(event);
-            ++m_stats.tileCollisions;
+            if (!m_collisionCallbacks.empty()) out.events.push_back(event);
+            ++out.tileCollisions;
         }
 
         if (moveResult.hitVertical) {
@@ -278,8 +326,8 @@ inline void PhysicsSystem::processEntity(Entity entity, Transform& transform, Ve
                 event.tileX = moveResult.collisions[0].tileX;
                 event.tileY = moveResult.collisions[0].tileY;
             }
-            fireCollisionEvent(event);
-            ++m_stats.tileCollisions;
+            if (!m_collisionCallbacks.empty()) out.events.push_back(event);
+            ++out.tileCollisions;
         }
 
         // Update grounded state
@@ -319,7 +367,7 @@ inline void PhysicsSystem::processEntity(Entity entity, Transform& transform, Ve
                 gravity->grounded = true;
             }
 
-            ++m_stats.tileCollisions;
+            ++out.tileCollisions;
         } else {
             // No collision, move freely
             transform.position = transform.position + frameVelocity;
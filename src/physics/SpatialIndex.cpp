@@ -0,0 +1,519 @@
+#include "physics/SpatialIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+
+namespace gloaming {
+
+namespace {
+
+/// Cell coordinates are clamped well inside int32 so range arithmetic can't overflow
+constexpr float kMaxCellCoord = 1.0e8f;
+
+size_t nextPowerOfTwo(size_t v) {
+    size_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+float distanceSq(Vec2 a, Vec2 b) {
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+} // namespace
+
+SpatialIndex::SpatialIndex(float cellSize)
+    : m_typeNames(1) {
+    setCellSize(cellSize);
+}
+
+void SpatialIndex::setCellSize(float cellSize) {
+    m_cellSize = cellSize > 1.0f ? cellSize : 1.0f;
+    m_invCellSize = 1.0f / m_cellSize;
+}
+
+int32_t SpatialIndex::cellOf(float v) const {
+    float c = std::floor(v * m_invCellSize);
+    return static_cast<int32_t>(std::clamp(c, -kMaxCellCoord, kMaxCellCoord));
+}
+
+size_t SpatialIndex::bucketOf(int32_t cellX, int32_t cellY) const {
+    uint32_t h = static_cast<uint32_t>(cellX) * 73856093u ^ static_cast<uint32_t>(cellY) * 19349663u;
+    return h & m_bucketMask;
+}
+
+SpatialIndex::EntitySlot& SpatialIndex::slotOf(Entity entity) {
+    size_t index = entt::to_entity(entity);
+    if (index >= m_slots.size()) m_slots.resize(index + 1);
+    return m_slots[index];
+}
+
+uint32_t SpatialIndex::resolveType(Registry& registry, Entity entity) {
+    const Name* name = registry.tryGet<Name>(entity);
+    if (!name || name->type.empty()) return 0;
+
+    // Most entities keep their type for life: check the cached ID before hashing
+    EntitySlot& slot = slotOf(entity);
+    if (slot.entity == entity && m_typeNames[slot.typeId] == name->type) return slot.typeId;
+
+    auto [it, inserted] = m_typeIds.try_emplace(name->type, static_cast<uint32_t>(m_typeNames.size()));
+    if (inserted) m_typeNames.push_back(name->type);
+    slot.entity = entity;
+    slot.typeId = it->second;
+    return slot.typeId;
+}
+
+SpatialIndex::Entry SpatialIndex::makeEntry(Entity entity, const Transform& transform,
+                                            const Collider* collider, uint32_t typeId) const {
+    Entry entry;
+    entry.entity = entity;
+    entry.position = transform.position;
+    if (collider) {
+        entry.bounds = Collision::getEntityAABB(transform, *collider);
+        entry.layer = collider->layer;
+    } else {
+        entry.bounds = AABB(transform.position, Vec2(0.0f, 0.0f));
+        entry.layer = 0;
+    }
+    entry.typeId = typeId;
+
+    entry.homeX = cellOf(entry.position.x);
+    entry.homeY = cellOf(entry.position.y);
+    Vec2 min = entry.bounds.getMin();
+    Vec2 max = entry.bounds.getMax();
+    entry.minX = std::min(cellOf(min.x), entry.homeX);
+    entry.minY = std::min(cellOf(min.y), entry.homeY);
+    entry.maxX = std::max(cellOf(max.x), entry.homeX);
+    entry.maxY = std::max(cellOf(max.y), entry.homeY);
+    return entry;
+}
+
+void SpatialIndex::sync(Registry& registry) {
+    m_syncedVersion = registry.version();
+    m_changeCursor = registry.changeCursor();
+    forgetEntries();
+    m_entries.clear();
+    registry.each<Transform>([&](Entity entity, const Transform& transform) {
+        uint32_t typeId = resolveType(registry, entity);
+        slotOf(entity).entry = static_cast<uint32_t>(m_entries.size());
+        m_entries.push_back(makeEntry(entity, transform, registry.tryGet<Collider>(entity), typeId));
+    });
+    buildGrid();
+}
+
+void SpatialIndex::syncColliders(Registry& registry, uint32_t layerMask) {
+    m_syncedVersion = registry.version();
+    m_changeCursor = registry.changeCursor();
+    forgetEntries();
+    m_entries.clear();
+    registry.each<Transform, Collider>([&](Entity entity, const Transform& transform, const Collider& collider) {
+        if (collider.enabled && (collider.layer & layerMask) != 0) {
+            m_entries.push_back(makeEntry(entity, transform, &collider, 0));
+        }
+    });
+    buildGrid();
+}
+
+void SpatialIndex::forgetEntries() {
+    for (const Entry& e : m_entries) {
+        size_t index = entt::to_entity(e.entity);
+        if (index < m_slots.size()) m_slots[index].entry = kNoEntry;
+    }
+    for (const Entry& e : m_pending) {
+        size_t index = entt::to_entity(e.entity);
+        if (index < m_slots.size()) m_slots[index].pending = kNoEntry;
+    }
+}
+
+void SpatialIndex::buildGrid() {
+    ++m_rebuilds;
+    m_staleCount = 0;
+    m_pending.clear();
+    m_oversized.clear();
+    m_items.clear();
+
+    // Count grid items; very large entities go to the always-scanned list
+    size_t itemCount = 0;
+    m_occupiedMinX = m_occupiedMinY = std::numeric_limits<int32_t>::max();
+    m_occupiedMaxX = m_occupiedMaxY = std::numeric_limits<int32_t>::min();
+    for (uint32_t i = 0; i < m_entries.size(); ++i) {
+        const Entry& e = m_entries[i];
+        int64_t cells = int64_t(e.maxX - e.minX + 1) * int64_t(e.maxY - e.minY + 1);
+        if (cells > kMaxCellsPerEntity) {
+            m_oversized.push_back(i);
+            continue;
+        }
+        itemCount += static_cast<size_t>(cells);
+        m_occupiedMinX = std::min(m_occupiedMinX, e.minX);
+        m_occupiedMinY = std::min(m_occupiedMinY, e.minY);
+        m_occupiedMaxX = std::max(m_occupiedMaxX, e.maxX);
+        m_occupiedMaxY = std::max(m_occupiedMaxY, e.maxY);
+    }
+    if (itemCount == 0) {
+        m_occupiedMinX = m_occupiedMinY = 0;
+        m_occupiedMaxX = m_occupiedMaxY = -1;
+    }
+
+    // Counting sort of (entry, cell) items into hashed buckets
+    size_t bucketCount = nextPowerOfTwo(std::max<size_t>(64, itemCount));
+    m_bucketMask = bucketCount - 1;
+    m_bucketStart.assign(bucketCount + 1, 0);
+    size_t oversizedNext = 0;
+    for (uint32_t i = 0; i < m_entries.size(); ++i) {
+        if (oversizedNext < m_oversized.size() && m_oversized[oversizedNext] == i) {
+            ++oversizedNext;
+            continue;
+        }
+        const Entry& e = m_entries[i];
+        for (int32_t y = e.minY; y <= e.maxY; ++y) {
+            for (int32_t x = e.minX; x <= e.maxX; ++x) {
+                ++m_bucketStart[bucketOf(x, y) + 1];
+            }
+        }
+    }
+    for (size_t b = 0; b < bucketCount; ++b) {
+        m_bucketStart[b + 1] += m_bucketStart[b];
+    }
+
+    m_items.resize(itemCount);
+    m_bucketCursor.assign(m_bucketStart.begin(), m_bucketStart.end() - 1);
+    oversizedNext = 0;
+    for (uint32_t i = 0; i < m_entries.size(); ++i) {
+        if (oversizedNext < m_oversized.size() && m_oversized[oversizedNext] == i) {
+            ++oversizedNext;
+            continue;
+        }
+        const Entry& e = m_entries[i];
+        for (int32_t y = e.minY; y <= e.maxY; ++y) {
+            for (int32_t x = e.minX; x <= e.maxX; ++x) {
+                m_items[m_bucketCursor[bucketOf(x, y)]++] = Item{i, x, y};
+            }
+        }
+    }
+
+    m_built = true;
+}
+
+void SpatialIndex::update(Registry& registry) {
+    if (!m_built || m_syncedVersion != registry.version()) {
+        sync(registry);
+        return;
+    }
+    std::span<const Entity> changed = registry.changedSince(m_changeCursor);
+    if (m_staleCount + m_pending.size() + changed.size() > kMaxIncremental + m_entries.size() / 8) {
+        sync(registry);
+        return;
+    }
+    for (Entity entity : changed) refresh(registry, entity);
+    m_changeCursor = registry.changeCursor();
+}
+
+void SpatialIndex::refresh(Registry& registry, Entity entity) {
+    EntitySlot& slot = slotOf(entity);
+
+    // Retire what this entity index holds: the entity's own old state, or a
+    // destroyed entity's that used the index before it
+    if (slot.entry != kNoEntry) {
+        Entry& old = m_entries[slot.entry];
+        if (old.entity == entity || !registry.valid(old.entity)) {
+            old.stale = true;
+            ++m_staleCount;
+            slot.entry = kNoEntry;
+        }
+    }
+    if (slot.pending != kNoEntry) {
+        const Entry& old = m_pending[slot.pending];
+        if (old.entity == entity || !registry.valid(old.entity)) {
+            uint32_t at = slot.pending;
+            slot.pending = kNoEntry;
+            if (at + 1 != m_pending.size()) {
+                m_pending[at] = m_pending.back();
+                m_slots[entt::to_entity(m_pending[at].entity)].pending = at;
+            }
+            m_pending.pop_back();
+        }
+    }
+
+    if (!registry.valid(entity)) return;
+    if (const Transform* transform = registry.tryGet<Transform>(entity)) {
+        slot.pending = static_cast<uint32_t>(m_pending.size());
+        m_pending.push_back(makeEntry(entity, *transform, registry.tryGet<Collider>(entity),
+                                      resolveType(registry, entity)));
+    }
+}
+
+void SpatialIndex::clear() {
+    m_entries.clear();
+    m_pending.clear();
+    m_oversized.clear();
+    m_items.clear();
+    m_bucketStart.clear();
+    m_bucketMask = 0;
+    m_occupiedMinX = m_occupiedMinY = 0;
+    m_occupiedMaxX = m_occupiedMaxY = -1;
+    m_typeIds.clear();
+    m_typeNames.assign(1, std::string());
+    m_slots.clear();
+    m_staleCount = 0;
+    m_built = false;
+}
+
+uint32_t SpatialIndex::typeId(const std::string& type) const {
+    auto it = m_typeIds.find(type);
+    return it != m_typeIds.end() ? it->second : 0;
+}
+
+bool SpatialIndex::passes(const Entry& entry, const SpatialFilter& filter) const {
+    if (entry.stale) return false;
+    if (entry.entity == filter.ignore) return false;
+    if (filter.layerMask != 0 && (entry.layer & filter.layerMask) == 0) return false;
+    if (filter.typeId != 0 && entry.typeId != filter.typeId) return false;
+    return true;
+}
+
+template<typename Fn>
+void SpatialIndex::forEachInCell(int32_t cellX, int32_t cellY, Fn&& fn) const {
+    if (m_items.empty()) return;
+    size_t bucket = bucketOf(cellX, cellY);
+    for (uint32_t i = m_bucketStart[bucket]; i < m_bucketStart[bucket + 1]; ++i) {
+        const Item& item = m_items[i];
+        if (item.cellX == cellX && item.cellY == cellY) {
+            fn(m_entries[item.entry]);
+        }
+    }
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+void SpatialIndex::queryRadius(Vec2 center, float radius, const SpatialFilter& filter,
+                               std::vector<Entity>& out) const {
+    out.clear();
+    if (!(radius >= 0.0f)) return;          // also rejects NaN
+    const float radiusSq = radius * radius;
+
+    auto consider = [&](const Entry& e) {
+        if (passes(e, filter) && distanceSq(e.position, center) <= radiusSq) {
+            out.push_back(e.entity);
+        }
+    };
+
+    for (const Entry& e : m_pending) consider(e);
+    for (uint32_t i : m_oversized) consider(m_entries[i]);
+
+    int32_t minX = std::max(cellOf(center.x - radius), m_occupiedMinX);
+    int32_t minY = std::max(cellOf(center.y - radius), m_occupiedMinY);
+    int32_t maxX = std::min(cellOf(center.x + radius), m_occupiedMaxX);
+    int32_t maxY = std::min(cellOf(center.y + radius), m_occupiedMaxY);
+    if (minX > maxX || minY > maxY) return;
+
+    // A query covering more cells than there are items is cheaper as a scan
+    if (int64_t(maxX - minX + 1) * int64_t(maxY - minY + 1) > static_cast<int64_t>(m_items.size())) {
+        for (const Entry& e : m_entries) {
+            if (int64_t(e.maxX - e.minX + 1) * int64_t(e.maxY - e.minY + 1) <= kMaxCellsPerEntity) {
+                consider(e);
+            }
+        }
+        return;
+    }
+
+    // Each entity is counted once, in the cell holding its position
+    for (int32_t y = minY; y <= maxY; ++y) {
+        for (int32_t x = minX; x <= maxX; ++x) {
+            forEachInCell(x, y, [&](const Entry& e) {
+                if (e.homeX == x && e.homeY == y) consider(e);
+            });
+        }
+    }
+}
+
+void SpatialIndex::queryAABB(const AABB& area, const SpatialFilter& filter, std::vector<Entity>& out) const {
+    out.clear();
+
+    auto consider = [&](const Entry& e) {
+        if (passes(e, filter) && e.bounds.intersects(area)) {
+            out.push_back(e.entity);
+        }
+    };
+
+    for (const Entry& e : m_pending) consider(e);
+    for (uint32_t i : m_oversized) consider(m_entries[i]);
+
+    Vec2 areaMin = area.getMin();
+    Vec2 areaMax = area.getMax();
+    int32_t minX = std::max(cellOf(areaMin.x), m_occupiedMinX);
+    int32_t minY = std::max(cellOf(areaMin.y), m_occupiedMinY);
+    int32_t maxX = std::min(cellOf(areaMax.x), m_occupiedMaxX);
+    int32_t maxY = std::min(cellOf(areaMax.y), m_occupiedMaxY);
+    if (minX > maxX || minY > maxY) return;
+
+    if (int64_t(maxX - minX + 1) * int64_t(maxY - minY + 1) > static_cast<int64_t>(m_items.size())) {
+        for (const Entry& e : m_entries) {
+            if (int64_t(e.maxX - e.minX + 1) * int64_t(e.maxY - e.minY + 1) <= kMaxCellsPerEntity) {
+                consider(e);
+            }
+        }
+        return;
+    }
+
+    // An entity spanning several queried cells is counted in the first of them
+    for (int32_t y = minY; y <= maxY; ++y) {
+        for (int32_t x = minX; x <= maxX; ++x) {
+            forEachInCell(x, y, [&](const Entry& e) {
+                if (std::max(e.minX, minX) == x && std::max(e.minY, minY) == y) consider(e);
+            });
+        }
+    }
+}
+
+void SpatialIndex::queryNearest(Vec2 center, size_t k, float maxRadius, const SpatialFilter& filter,
+                                std::vector<Entity>& out) const {
+    out.clear();
+    if (k == 0 || !(maxRadius >= 0.0f)) return;
+    const float maxRadiusSq = maxRadius * maxRadius;
+
+    // Max-heap of the best k so far (largest distance on top)
+    std::vector<std::pair<float, Entity>> best;
+    best.reserve(std::min<size_t>(k, 64));
+    auto consider = [&](const Entry& e) {
+        if (!passes(e, filter)) return;
+        float d = distanceSq(e.position, center);
+        if (d > maxRadiusSq) return;
+        if (best.size() < k) {
+            best.emplace_back(d, e.entity);
+            std::push_heap(best.begin(), best.end());
+        } else if (d < best.front().first) {
+            std::pop_heap(best.begin(), best.end());
+            best.back() = {d, e.entity};
+            std::push_heap(best.begin(), best.end());
+        }
+    };
+
+    for (const Entry& e : m_pending) consider(e);
+    for (uint32_t i : m_oversized) consider(m_entries[i]);
+
+    if (m_occupiedMinX <= m_occupiedMaxX) {
+        const int32_t cx = cellOf(center.x);
+        const int32_t cy = cellOf(center.y);
+        // Rings beyond these add nothing: past maxRadius, or past every occupied cell
+        int64_t ringLimit = std::max({int64_t(cx) - m_occupiedMinX, int64_t(m_occupiedMaxX) - cx,
+                                      int64_t(cy) - m_occupiedMinY, int64_t(m_occupiedMaxY) - cy});
+        // Clamped before the cast: an unbounded radius (FLT_MAX, inf) would overflow it
+        float radiusCells = std::min(maxRadius * m_invCellSize, 2.0f * kMaxCellCoord);
+        ringLimit = std::min<int64_t>(ringLimit, static_cast<int64_t>(radiusCells) + 1);
+
+        auto visit = [&](int32_t x, int32_t y) {
+            if (x < m_occupiedMinX || x > m_occupiedMaxX || y < m_occupiedMinY || y > m_occupiedMaxY) return;
+            forEachInCell(x, y, [&](const Entry& e) {
+                if (e.homeX == x && e.homeY == y) consider(e);
+            });
+        };
+
+        for (int64_t ring = 0; ring <= ringLimit; ++ring) {
+            const int32_t n = static_cast<int32_t>(ring);
+            if (n == 0) {
+                visit(cx, cy);
+            } else {
+                int32_t x0 = std::max(cx - n, m_occupiedMinX);
+                int32_t x1 = std::min(cx + n, m_occupiedMaxX);
+                for (int32_t x = x0; x <= x1; ++x) {
+                    visit(x, cy - n);
+                    visit(x, cy + n);
+                }
+                int32_t y0 = std::max(cy - n + 1, m_occupiedMinY);
+                int32_t y1 = std::min(cy + n - 1, m_occupiedMaxY);
+                for (int32_t y = y0; y <= y1; ++y) {
+                    visit(cx - n, y);
+                    visit(cx + n, y);
+                }
+            }
+
+            // Every unvisited cell is at least ring * cellSize away
+            float reach = static_cast<float>(ring) * m_cellSize;
+            if (best.size() == k && best.front().first <= reach * reach) break;
+        }
+    }
+
+    std::sort_heap(best.begin(), best.end());
+    out.reserve(best.size());
+    for (const auto& [d, entity] : best) out.push_back(entity);
+}
+
+Entity SpatialIndex::raycast(const Ray& ray, float maxDistance, const SpatialFilter& filter,
+                             float* outDistance) const {
+    Entity hit = NullEntity;
+    float bestT = maxDistance;
+
+    auto consider = [&](const Entry& e) {
+        if (!passes(e, filter)) return;
+        float t = Raycast::raycastAABB(ray, e.bounds);
+        if (t >= 0.0f && t <= bestT) {
+            if (hit == NullEntity || t < bestT) {
+                bestT = t;
+                hit = e.entity;
+            }
+        }
+    };
+
+    for (const Entry& e : m_pending) consider(e);
+    for (uint32_t i : m_oversized) consider(m_entries[i]);
+
+    if (m_occupiedMinX <= m_occupiedMaxX && maxDistance > 0.0f) {
+        // Grid DDA: visit cells in the order the ray crosses them
+        int32_t x = cellOf(ray.origin.x);
+        int32_t y = cellOf(ray.origin.y);
+        const int32_t stepX = ray.direction.x > 0.0f ? 1 : (ray.direction.x < 0.0f ? -1 : 0);
+        const int32_t stepY = ray.direction.y > 0.0f ? 1 : (ray.direction.y < 0.0f ? -1 : 0);
+        const float inf = std::numeric_limits<float>::max();
+
+        const float tDeltaX = stepX != 0 ? std::abs(m_cellSize / ray.direction.x) : inf;
+        const float tDeltaY = stepY != 0 ? std::abs(m_cellSize / ray.direction.y) : inf;
+        float tMaxX = inf, tMaxY = inf;
+        if (stepX != 0) {
+            float edge = static_cast<float>(stepX > 0 ? x + 1 : x) * m_cellSize;
+            tMaxX = (edge - ray.origin.x) / ray.direction.x;
+        }
+        if (stepY != 0) {
+            float edge = static_cast<float>(stepY > 0 ? y + 1 : y) * m_cellSize;
+            tMaxY = (edge - ray.origin.y) / ray.direction.y;
+        }
+
+        while (true) {
+            if (x >= m_occupiedMinX && x <= m_occupiedMaxX &&
+                y >= m_occupiedMinY && y <= m_occupiedMaxY) {
+                forEachInCell(x, y, consider);
+            }
+
+            // A hit inside the cells crossed so far can't be beaten further on
+            float cellExit = std::min(tMaxX, tMaxY);
+            if (hit != NullEntity && bestT <= cellExit) break;
+            if (cellExit > maxDistance) break;
+
+            // Stop once the ray has left the occupied area for good
+            if ((stepX > 0 && x > m_occupiedMaxX) || (stepX < 0 && x < m_occupiedMinX) ||
+                (stepX == 0 && (x < m_occupiedMinX || x > m_occupiedMaxX)) ||
+                (stepY > 0 && y > m_occupiedMaxY) || (stepY < 0 && y < m_occupiedMinY) ||
+                (stepY == 0 && (y < m_occupiedMinY || y > m_occupiedMaxY))) {
+                break;
+            }
+
+            if (tMaxX < tMaxY) {
+                x += stepX;
+                tMaxX += tDeltaX;
+            } else {
+                y += stepY;
+                tMaxY += tDeltaY;
+            }
+        }
+    }
+
+    if (outDistance) *outDistance = hit != NullEntity ? bestT : 0.0f;
+    return hit;
+}
+
+} // namespace gloaming
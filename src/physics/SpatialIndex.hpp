@@ -0,0 +1,174 @@
+#pragma once
+
+#include "physics/AABB.hpp"
+#include "physics/Raycast.hpp"
+#include "ecs/Components.hpp"
+#include "ecs/Registry.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gloaming {
+
+/// Filter applied by every SpatialIndex query.
+struct SpatialFilter {
+    uint32_t layerMask = 0;         ///< Collider::layer must intersect this (0 = any, no collider needed)
+    uint32_t typeId = 0;            ///< SpatialIndex::typeId() of Name::type (0 = any)
+    Entity ignore = NullEntity;     ///< Never returned (e.g. the querying entity)
+};
+
+/// Uniform grid of entity positions and bounds for neighbourhood queries.
+///
+/// sync() rebuilds the grid from every Transform entity: each entity goes
+/// into every cell covered by its Collider bounds (or just its position
+/// without a Collider), and the cells are laid out contiguously by hashed
+/// bucket so queries read flat arrays. Rebuilding is O(entities) with no
+/// allocation once the buffers have grown, which is cheaper than tracking
+/// moves incrementally when most bodies move every tick.
+///
+/// Queries answer from the state captured by the last sync(). update()
+/// brings a synced index up to date: it rebuilds after a Registry::touch(),
+/// and otherwise re-reads only the entities the registry logged as changed
+/// (Registry::touch(entity)), retiring their grid entries and keeping their
+/// new state in a short list every query scans until the next rebuild.
+/// Entities destroyed since the last update may still be returned, so
+/// callers holding a registry should check valid().
+///
+/// Name::type strings are interned to small IDs so type filters compare
+/// integers; IDs stay stable until clear().
+class SpatialIndex {
+public:
+    static constexpr float kDefaultCellSize = 128.0f;
+
+    /// Entities covering more cells than this are kept in a list every query scans
+    static constexpr int kMaxCellsPerEntity = 64;
+
+    explicit SpatialIndex(float cellSize = kDefaultCellSize);
+
+    /// Change the cell size (takes effect at the next sync).
+    void setCellSize(float cellSize);
+    float getCellSize() const { return m_cellSize; }
+
+    /// Rebuild from the registry's Transform entities.
+    void sync(Registry& registry);
+
+    /// Rebuild from enabled Colliders on any of `layerMask`'s layers only,
+    /// without type IDs (a per-frame target grid for hit tests).
+    void syncColliders(Registry& registry, uint32_t layerMask);
+
+    /// Catch up with the registry: refresh the entities changed one at a
+    /// time since the last sync/update, or sync() when the registry was
+    /// touched as a whole or too much has changed. For sync()-built indexes.
+    void update(Registry& registry);
+
+    /// Drop everything, including interned types.
+    void clear();
+
+    /// Whether sync() has run since construction or clear().
+    bool isBuilt() const { return m_built; }
+
+    /// Whether the registry is unchanged (Registry::version() and its change
+    /// log) since the last sync or update.
+    bool isCurrent(const Registry& registry) const {
+        return m_built && m_syncedVersion == registry.version() &&
+               m_changeCursor == registry.changeCursor();
+    }
+
+    /// Entities indexed (synced plus refreshed since).
+    size_t size() const { return m_entries.size() - m_staleCount + m_pending.size(); }
+
+    /// Full rebuilds so far (sync(), syncColliders(), or update() falling back).
+    uint64_t rebuildCount() const { return m_rebuilds; }
+
+    /// Interned ID for a Name::type, or 0 if no indexed entity has that type.
+    uint32_t typeId(const std::string& type) const;
+
+    /// Entities whose position lies within `radius` of `center`.
+    void queryRadius(Vec2 center, float radius, const SpatialFilter& filter,
+                     std::vector<Entity>& out) const;
+
+    /// Entities whose bounds overlap `area`.
+    void queryAABB(const AABB& area, const SpatialFilter& filter, std::vector<Entity>& out) const;
+
+    /// Up to `k` entities nearest to `center` by position, within
+    /// `maxRadius`, nearest first.
+    void queryNearest(Vec2 center, size_t k, float maxRadius, const SpatialFilter& filter,
+                      std::vector<Entity>& out) const;
+
+    /// First entity whose bounds the ray hits within maxDistance
+    /// (NullEntity if none). Rays starting inside a box hit it at distance 0.
+    Entity raycast(const Ray& ray, float maxDistance, const SpatialFilter& filter,
+                   float* outDistance = nullptr) const;
+
+private:
+    struct Entry {
+        Entity entity;
+        Vec2 position;
+        AABB bounds;
+        uint32_t layer;
+        uint32_t typeId;
+        int32_t homeX, homeY;           ///< Cell holding position
+        int32_t minX, minY, maxX, maxY; ///< Cells covered by bounds and position
+        bool stale = false;             ///< Superseded by update(); skipped by queries
+    };
+
+    /// One (entry, cell) pair, grouped by bucket
+    struct Item {
+        uint32_t entry;
+        int32_t cellX, cellY;
+    };
+
+    static constexpr uint32_t kNoEntry = UINT32_MAX;
+
+    /// Per entity index
+    struct EntitySlot {
+        Entity entity = NullEntity;     ///< Entity typeId was resolved for
+        uint32_t typeId = 0;
+        uint32_t entry = kNoEntry;      ///< In m_entries
+        uint32_t pending = kNoEntry;    ///< In m_pending
+    };
+
+    /// update() rebuilds once more entries than this (plus 1/8 of the grid) would be stale or pending
+    static constexpr size_t kMaxIncremental = 64;
+
+    Entry makeEntry(Entity entity, const Transform& transform, const Collider* collider,
+                    uint32_t typeId) const;
+    void buildGrid();               ///< Bucket m_entries into the grid
+    void forgetEntries();           ///< Unlink m_entries and m_pending from m_slots
+    void refresh(Registry& registry, Entity entity);
+    EntitySlot& slotOf(Entity entity);
+    uint32_t resolveType(Registry& registry, Entity entity);
+    int32_t cellOf(float v) const;
+    size_t bucketOf(int32_t cellX, int32_t cellY) const;
+    bool passes(const Entry& entry, const SpatialFilter& filter) const;
+
+    /// Visit the items in one cell; fn(const Entry&) per entry stored there.
+    template<typename Fn>
+    void forEachInCell(int32_t cellX, int32_t cellY, Fn&& fn) const;
+
+    float m_cellSize = kDefaultCellSize;
+    float m_invCellSize = 1.0f / kDefaultCellSize;
+    bool m_built = false;
+    uint64_t m_syncedVersion = 0;
+    uint64_t m_changeCursor = 0;            ///< Registry::changeCursor() caught up to
+    uint64_t m_rebuilds = 0;
+    size_t m_staleCount = 0;                ///< Stale entries in m_entries
+
+    std::vector<Entry> m_entries;           ///< Synced entities
+    std::vector<Entry> m_pending;           ///< Refreshed since the last sync
+    std::vector<uint32_t> m_oversized;      ///< Entries in m_entries too large for the grid
+    std::vector<Item> m_items;              ///< Sorted by bucket
+    std::vector<uint32_t> m_bucketStart;    ///< m_items range per bucket (size buckets + 1)
+    std::vector<uint32_t> m_bucketCursor;   ///< Scratch for filling m_items
+    size_t m_bucketMask = 0;
+    int32_t m_occupiedMinX = 0, m_occupiedMinY = 0;
+    int32_t m_occupiedMaxX = -1, m_occupiedMaxY = -1;
+
+    std::unordered_map<std::string, uint32_t> m_typeIds;
+    std::vector<std::string> m_typeNames;   ///< By type ID (0 = untyped)
+    std::vector<EntitySlot> m_slots;        ///< By entity index
+};
+
+} // namespace gloaming
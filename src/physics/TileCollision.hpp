@@ -3,7 +3,10 @@
 #include "physics/AABB.hpp"
 #include "world/TileMap.hpp"
 #include "rendering/TileRenderer.hpp"
+#include <array>
 #include <cmath>
+#include <limits>
+#include <type_traits>
 #include <vector>
 #include <algorithm>
 #include <functional>
@@ -33,6 +36,30 @@ struct TileCollisionResult {
     operator bool() const { return collided; }
 };
 
+/// Collisions recorded by one moveAABB call.
+/// Fixed capacity so moving a body never touches the heap. moveAABB records
+/// at most one collision per axis per iteration and runs at most
+/// kMaxIterations iterations, so the list never fills up.
+class TileCollisionList {
+public:
+    static constexpr int kMaxIterations = 8;
+    static constexpr size_t kCapacity = 2 * kMaxIterations;
+
+    void push_back(const TileCollisionResult& collision) {
+        if (m_count < kCapacity) m_items[m_count++] = collision;
+    }
+
+    bool empty() const { return m_count == 0; }
+    size_t size() const { return m_count; }
+    const TileCollisionResult& operator[](size_t i) const { return m_items[i]; }
+    const TileCollisionResult* begin() const { return m_items.data(); }
+    const TileCollisionResult* end() const { return m_items.data() + m_count; }
+
+private:
+    std::array<TileCollisionResult, kCapacity> m_items{};
+    size_t m_count = 0;
+};
+
 /// Result of moving through tiles with collision response
 struct TileMoveResult {
     Vec2 newPosition{0.0f, 0.0f};       // Final position after collision
@@ -42,7 +69,7 @@ struct TileMoveResult {
     bool onGround = false;               // Standing on solid ground
     bool onSlope = false;                // Standing on a slope
     bool onPlatform = false;             // Standing on a platform
-    std::vector<TileCollisionResult> collisions; // All collisions that occurred
+    TileCollisionList collisions;        // All collisions that occurred
 };
 
 /// Tile collision detection and response
@@ -51,7 +78,7 @@ public:
     /// Configuration for tile collision
     struct Config {
         float skinWidth = 0.01f;       // Small buffer to prevent sticking
-        int maxIterations = 4;          // Max collision resolution iterations
+        int maxIterations = 4;          // Max resolution iterations, capped at TileCollisionList::kMaxIterations
         float slopeLimit = 46.0f;       // Max slope angle in degrees (45 + 1 for tolerance)
         float groundCheckDistance = 2.0f; // Distance below feet to check for ground
     };
@@ -90,35 +117,22 @@ public:
     bool doesAABBOverlapSolid(const AABB& aabb) const {
         if (!hasTileSource()) return false;
 
-        Vec2 min = aabb.getMin();
-        Vec2 max = aabb.getMax();
-
-        int minTileX, minTileY, maxTileX, maxTileY;
-        worldToTileCoords(min.x, min.y, minTileX, minTileY);
-        worldToTileCoords(max.x - 0.01f, max.y - 0.01f, maxTileX, maxTileY);
-
-        for (int ty = minTileY; ty <= maxTileY; ++ty) {
-            for (int tx = minTileX; tx <= maxTileX; ++tx) {
-                Tile tile = getTileAt(tx, ty);
-                if (tile.isSolid()) {
-                    return true;
-                }
-            }
-        }
-        return false;
+        bool solid = false;
+        forEachTileInAABB(aabb, [&](int, int, Tile tile) {
+            solid = tile.isSolid();
+            return !solid;
+        });
+        return solid;
     }
 
     /// Get tiles that an AABB overlaps
+    /// @note Allocates; the collision queries iterate the range in place instead.
     std::vector<std::pair<int, int>> getTilesInAABB(const AABB& aabb) const {
         std::vector<std::pair<int, int>> tiles;
         if (!hasTileSource()) return tiles;
 
-        Vec2 min = aabb.getMin();
-        Vec2 max = aabb.getMax();
-
         int minTileX, minTileY, maxTileX, maxTileY;
-        worldToTileCoords(min.x, min.y, minTileX, minTileY);
-        worldToTileCoords(max.x - 0.01f, max.y - 0.01f, maxTileX, maxTileY);
+        getTileRange(aabb, minTileX, minTileY, maxTileX, maxTileY);
 
         for (int ty = minTileY; ty <= maxTileY; ++ty) {
             for (int tx = minTileX; tx <= maxTileX; ++tx) {
@@ -136,14 +150,13 @@ public:
 
         float smallestPenetration = std::numeric_limits<float>::max();
 
-        auto tiles = getTilesInAABB(aabb.expanded(1.0f));
-        for (const auto& [tx, ty] : tiles) {
-            auto collision = testSingleTileCollision(aabb, tx, ty);
+        forEachTileInAABB(aabb.expanded(1.0f), [&](int tx, int ty, Tile tile) {
+            auto collision = testTileCollision(aabb, tx, ty, tile);
             if (collision && collision.penetration < smallestPenetration) {
                 result = collision;
                 smallestPenetration = collision.penetration;
             }
-        }
+        });
 
         return result;
     }
@@ -153,7 +166,12 @@ public:
         TileCollisionResult result;
         if (!hasTileSource()) return result;
 
-        Tile tile = getTileAt(tileX, tileY);
+        return testTileCollision(aabb, tileX, tileY, getTileAt(tileX, tileY));
+    }
+
+    /// Test collision with a tile whose contents are already known
+    TileCollisionResult testTileCollision(const AABB& aabb, int tileX, int tileY, Tile tile) const {
+        TileCollisionResult result;
         if (tile.isEmpty()) return result;
 
         result.tileX = tileX;
@@ -268,7 +286,9 @@ public:
 
         Vec2 remainingVelocity = velocity;
 
-        for (int iteration = 0; iteration < m_config.maxIterations; ++iteration) {
+        // Capped so every collision fits in result.collisions
+        const int maxIterations = std::min(m_config.maxIterations, TileCollisionList::kMaxIterations);
+        for (int iteration = 0; iteration < maxIterations; ++iteration) {
             if (std::abs(remainingVelocity.x) < 0.001f && std::abs(remainingVelocity.y) < 0.001f) {
                 break;
             }
@@ -383,14 +403,11 @@ public:
 
         // Calculate swept AABB bounds
         AABB sweptBounds = AABB::merge(aabb, aabb.translated(velocity));
-        auto tiles = getTilesInAABB(sweptBounds.expanded(static_cast<float>(m_tileSize)));
-
-        for (const auto& [tx, ty] : tiles) {
-            Tile tile = getTileAt(tx, ty);
-            if (!tile.isSolid()) continue;
+        forEachTileInAABB(sweptBounds.expanded(static_cast<float>(m_tileSize)), [&](int tx, int ty, Tile tile) {
+            if (!tile.isSolid()) return;
 
             // Skip slopes for swept test (handle separately)
-            if (tile.flags & TilePhysicsFlags::SLOPE_MASK) continue;
+            if (tile.flags & TilePhysicsFlags::SLOPE_MASK) return;
 
             float tileWorldX = static_cast<float>(tx * m_tileSize);
             float tileWorldY = static_cast<float>(ty * m_tileSize);
@@ -403,7 +420,7 @@ public:
             if (sweep.hit && sweep.time < result.time) {
                 result = sweep;
             }
-        }
+        });
 
         return result;
     }
@@ -417,18 +434,16 @@ private:
         // Compute original position and swept area covering full movement path
         AABB originalAABB = testAABB.translated(Vec2(-velocityX, 0.0f));
         AABB sweptArea = AABB::merge(originalAABB, testAABB);
-        auto tiles = getTilesInAABB(sweptArea);
         float closestPenetration = 0.0f;
 
-        for (const auto& [tx, ty] : tiles) {
-            Tile tile = getTileAt(tx, ty);
-            if (!tile.isSolid()) continue;
+        forEachTileInAABB(sweptArea, [&](int tx, int ty, Tile tile) {
+            if (!tile.isSolid()) return;
 
             // Skip platforms for horizontal collision
-            if ((tile.flags & Tile::FLAG_PLATFORM) && !(tile.flags & Tile::FLAG_SOLID)) continue;
+            if ((tile.flags & Tile::FLAG_PLATFORM) && !(tile.flags & Tile::FLAG_SOLID)) return;
 
             // Skip slopes for horizontal (they use Y collision)
-            if (tile.flags & TilePhysicsFlags::SLOPE_MASK) continue;
+            if (tile.flags & TilePhysicsFlags::SLOPE_MASK) return;
 
             float tileWorldX = static_cast<float>(tx * m_tileSize);
             float tileWorldY = static_cast<float>(ty * m_tileSize);
@@ -440,7 +455,7 @@ private:
             // Verify vertical overlap with the original AABB
             bool verticalOverlap = originalAABB.getMin().y < tileAABB.getMax().y &&
                                    originalAABB.getMax().y > tileAABB.getMin().y;
-            if (!verticalOverlap) continue;
+            if (!verticalOverlap) return;
 
             float penetration = 0.0f;
             bool hit = false;
@@ -471,7 +486,7 @@ private:
                 result.normal = Vec2(velocityX > 0.0f ? -1.0f : 1.0f, 0.0f);
                 closestPenetration = penetration;
             }
-        }
+        });
 
         return result;
     }
@@ -485,12 +500,10 @@ private:
         // Compute original position and swept area covering full movement path
         AABB originalAABB = testAABB.translated(Vec2(0.0f, -velocityY));
         AABB sweptArea = AABB::merge(originalAABB, testAABB);
-        auto tiles = getTilesInAABB(sweptArea);
         float closestPenetration = 0.0f;
 
-        for (const auto& [tx, ty] : tiles) {
-            Tile tile = getTileAt(tx, ty);
-            if (tile.isEmpty()) continue;
+        forEachTileInAABB(sweptArea, [&](int tx, int ty, Tile tile) {
+            if (tile.isEmpty()) return;
 
             bool isSolid = tile.isSolid();
             bool isPlatform = (tile.flags & Tile::FLAG_PLATFORM) != 0;
@@ -498,17 +511,17 @@ private:
 
             // Handle one-way platforms
             if (isPlatform && !isSolid) {
-                if (!checkPlatforms) continue;
+                if (!checkPlatforms) return;
 
                 // Only collide when falling (moving down)
-                if (velocityY <= 0.0f) continue;
+                if (velocityY <= 0.0f) return;
 
                 // Check if entity was above platform before movement
                 float platformTop = static_cast<float>(ty * m_tileSize);
                 float entityBottom = originalAABB.getMax().y;
 
                 // Only collide if we were above the platform
-                if (entityBottom > platformTop + m_config.skinWidth) continue;
+                if (entityBottom > platformTop + m_config.skinWidth) return;
             }
 
             float tileWorldX = static_cast<float>(tx * m_tileSize);
@@ -525,15 +538,15 @@ private:
                     result = slopeResult;
                     closestPenetration = slopeResult.penetration;
                 }
-                continue;
+                return;
             }
 
-            if (!isSolid && !isPlatform) continue;
+            if (!isSolid && !isPlatform) return;
 
             // Verify horizontal overlap with the original AABB
             bool horizontalOverlap = originalAABB.getMin().x < tileAABB.getMax().x &&
                                      originalAABB.getMax().x > tileAABB.getMin().x;
-            if (!horizontalOverlap) continue;
+            if (!horizontalOverlap) return;
 
             float penetration = 0.0f;
             bool hit = false;
@@ -565,11 +578,103 @@ private:
                 result.isPlatform = isPlatform;
                 closestPenetration = penetration;
             }
-        }
+        });
 
         return result;
     }
 
+    /// Widest run of chunks forEachTile resolves up front (448+ tiles)
+    static constexpr int kMaxChunkSpan = 8;
+
+    /// Tile range covered by an AABB (inclusive; the max edge is exclusive in world space)
+    void getTileRange(const AABB& aabb, int& minTileX, int& minTileY,
+                      int& maxTileX, int& maxTileY) const {
+        Vec2 min = aabb.getMin();
+        Vec2 max = aabb.getMax();
+        worldToTileCoords(min.x, min.y, minTileX, minTileY);
+        worldToTileCoords(max.x - 0.01f, max.y - 0.01f, maxTileX, maxTileY);
+    }
+
+    template<typename Fn>
+    void forEachTileInAABB(const AABB& aabb, Fn&& visit) const {
+        if (!hasTileSource()) return;
+        int minTileX, minTileY, maxTileX, maxTileY;
+        getTileRange(aabb, minTileX, minTileY, maxTileX, maxTileY);
+        forEachTile(minTileX, minTileY, maxTileX, maxTileY, std::forward<Fn>(visit));
+    }
+
+    /// Visit every tile in [minTileX, maxTileX] x [minTileY, maxTileY] row by
+    /// row (the resolvers break penetration ties by visiting order). With a
+    /// TileMap, chunk pointers are looked up once per chunk the range crosses
+    /// and tiles are read straight from the chunk's tile rows; unloaded chunks
+    /// are skipped since they read as empty. The visitor takes (x, y, Tile)
+    /// and may return false to stop early.
+    template<typename Fn>
+    void forEachTile(int minTileX, int minTileY, int maxTileX, int maxTileY, Fn&& visit) const {
+        auto call = [&visit](int tx, int ty, Tile tile) {
+            if constexpr (std::is_same_v<std::invoke_result_t<Fn&, int, int, Tile>, bool>) {
+                return visit(tx, ty, tile);
+            } else {
+                visit(tx, ty, tile);
+                return true;
+            }
+        };
+
+        if (maxTileX < minTileX || maxTileY < minTileY) return;
+
+        if (!m_tileMap) {
+            if (!m_tileCallback) return;
+            for (int ty = minTileY; ty <= maxTileY; ++ty) {
+                for (int tx = minTileX; tx <= maxTileX; ++tx) {
+                    if (!call(tx, ty, m_tileCallback(tx, ty))) return;
+                }
+            }
+            return;
+        }
+
+        if (!m_tileMap->isWorldLoaded()) return;
+        const ChunkManager& chunks = m_tileMap->getChunkManager();
+
+        const ChunkCoord firstChunkX = worldToChunkCoord(minTileX);
+        const int chunkSpan = worldToChunkCoord(maxTileX) - firstChunkX + 1;
+        if (chunkSpan > kMaxChunkSpan) {
+            for (int ty = minTileY; ty <= maxTileY; ++ty) {
+                for (int tx = minTileX; tx <= maxTileX; ++tx) {
+                    if (!call(tx, ty, m_tileMap->getTile(tx, ty))) return;
+                }
+            }
+            return;
+        }
+
+        std::array<const Chunk*, kMaxChunkSpan> rowChunks{};
+        const ChunkCoord lastChunkY = worldToChunkCoord(maxTileY);
+        for (ChunkCoord chunkY = worldToChunkCoord(minTileY); chunkY <= lastChunkY; ++chunkY) {
+            bool anyLoaded = false;
+            for (int i = 0; i < chunkSpan; ++i) {
+                rowChunks[i] = chunks.getChunk(ChunkPosition(firstChunkX + i, chunkY));
+                anyLoaded = anyLoaded || rowChunks[i];
+            }
+            if (!anyLoaded) continue;
+
+            const int chunkMinY = chunkToWorldCoord(chunkY);
+            const int rowBegin = std::max(minTileY, chunkMinY);
+            const int rowEnd = std::min(maxTileY, chunkMinY + CHUNK_SIZE - 1);
+            for (int ty = rowBegin; ty <= rowEnd; ++ty) {
+                const int rowOffset = (ty - chunkMinY) * CHUNK_SIZE;
+                for (int i = 0; i < chunkSpan; ++i) {
+                    if (!rowChunks[i]) continue;
+                    const int chunkMinX = chunkToWorldCoord(firstChunkX + i);
+                    const int colBegin = std::max(minTileX, chunkMinX);
+                    const int colEnd = std::min(maxTileX, chunkMinX + CHUNK_SIZE - 1);
+                    const Tile* row = rowChunks[i]->getTileData() + rowOffset;
+                    for (int tx = colBegin; tx <= colEnd; ++tx) {
+                        if (!call(tx, ty, row[tx - chunkMinX])) return;
+                    }
+                }
+            }
+        }
+    }
+
     /// Get a tile using either TileMap or the callback
     Tile getTileAt(int tileX, int tileY) const {
         if (m_tileMap) {
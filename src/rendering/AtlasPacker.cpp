@@ -0,0 +1,339 @@
+#include "rendering/AtlasPacker.hpp"
+#include "engine/Log.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+namespace fs = std::filesystem;
+
+namespace gloaming {
+
+// ============================================================================
+// MaxRectsPacker
+// ============================================================================
+
+MaxRectsPacker::MaxRectsPacker(int width, int height)
+    : m_width(width), m_height(height) {
+    m_free.push_back({0, 0, width, height});
+}
+
+bool MaxRectsPacker::insert(int width, int height, int& outX, int& outY) {
+    if (width <= 0 || height <= 0) return false;
+
+    int bestShort = INT_MAX;
+    int bestLong = INT_MAX;
+    const Box* best = nullptr;
+    for (const Box& free : m_free) {
+        if (free.w < width || free.h < height) continue;
+        int leftoverX = free.w - width;
+        int leftoverY = free.h - height;
+        int shortSide = std::min(leftoverX, leftoverY);
+        int longSide = std::max(leftoverX, leftoverY);
+        if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong)) {
+            bestShort = shortSide;
+            bestLong = longSide;
+            best = &free;
+        }
+    }
+    if (!best) return false;
+
+    Box used{best->x, best->y, width, height};
+    splitFreeBoxes(used);
+    pruneFreeBoxes();
+
+    m_usedArea += static_cast<int64_t>(width) * height;
+    outX = used.x;
+    outY = used.y;
+    return true;
+}
+
+float MaxRectsPacker::occupancy() const {
+    int64_t area = static_cast<int64_t>(m_width) * m_height;
+    return area > 0 ? static_cast<float>(m_usedArea) / static_cast<float>(area) : 0.0f;
+}
+
+void MaxRectsPacker::splitFreeBoxes(const Box& used) {
+    m_split.clear();
+    for (const Box& free : m_free) {
+        bool overlaps = used.x < free.x + free.w && used.x + used.w > free.x &&
+                        used.y < free.y + free.h && used.y + used.h > free.y;
+        if (!overlaps) {
+            m_split.push_back(free);
+            continue;
+        }
+
+        // Up to four maximal boxes around the placement
+        if (used.x > free.x) {
+            m_split.push_back({free.x, free.y, used.x - free.x, free.h});
+        }
+        if (used.x + used.w < free.x + free.w) {
+            m_split.push_back({used.x + used.w, free.y,
+                               free.x + free.w - (used.x + used.w), free.h});
+        }
+        if (used.y > free.y) {
+            m_split.push_back({free.x, free.y, free.w, used.y - free.y});
+        }
+        if (used.y + used.h < free.y + free.h) {
+            m_split.push_back({free.x, used.y + used.h,
+                               free.w, free.y + free.h - (used.y + used.h)});
+        }
+    }
+    m_free.swap(m_split);
+}
+
+void MaxRectsPacker::pruneFreeBoxes() {
+    for (size_t i = 0; i < m_free.size(); ++i) {
+        for (size_t j = i + 1; j < m_free.size(); ++j) {
+            if (m_free[j].contains(m_free[i])) {
+                m_free.erase(m_free.begin() + static_cast<std::ptrdiff_t>(i));
+                --i;
+                break;
+            }
+            if (m_free[i].contains(m_free[j])) {
+                m_free.erase(m_free.begin() + static_cast<std::ptrdiff_t>(j));
+                --j;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// packAtlas
+// ============================================================================
+
+/// Copy `src` to (dx, dy) on `dst`, repeating its edge pixels `pad` pixels
+/// outward so filtering at region borders never samples a neighbour.
+static void blitPadded(const Image& src, Image& dst, int dx, int dy, int pad) {
+    const size_t rowBytes = static_cast<size_t>(src.width) * 4;
+    for (int y = -pad; y < src.height + pad; ++y) {
+        int sy = std::clamp(y, 0, src.height - 1);
+        const uint8_t* srcRow = &src.pixels[static_cast<size_t>(sy) * rowBytes];
+        uint8_t* dstRow = &dst.pixels[(static_cast<size_t>(dy + y) * dst.width + dx) * 4];
+
+        std::memcpy(dstRow, srcRow, rowBytes);
+        for (int x = 1; x <= pad; ++x) {
+            std::memcpy(dstRow - x * 4, srcRow, 4);
+            std::memcpy(dstRow + rowBytes + (x - 1) * 4, srcRow + rowBytes - 4, 4);
+        }
+    }
+}
+
+PackedAtlas packAtlas(const std::vector<AtlasSource>& sources, const AtlasPackSettings& settings) {
+    PackedAtlas result;
+    const int pad = std::max(0, settings.padding);
+    const int pageSize = std::max(1, settings.pageSize);
+
+    // Tallest first (then widest) packs shelves of similar sprites tightly;
+    // ties keep input order so the layout is deterministic
+    std::vector<size_t> order(sources.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const Image* ia = sources[a].image;
+        const Image* ib = sources[b].image;
+        int ha = ia ? ia->height : 0;
+        int hb = ib ? ib->height : 0;
+        if (ha != hb) return ha > hb;
+        return (ia ? ia->width : 0) > (ib ? ib->width : 0);
+    });
+
+    std::vector<MaxRectsPacker> packers;
+    std::vector<int> pageBottoms;
+    std::vector<int> placedPage(sources.size(), -1);
+    std::vector<PackedRegion> placed(sources.size());
+
+    for (size_t index : order) {
+        const Image* image = sources[index].image;
+        if (!image || !image->isValid()) continue;
+
+        int width = image->width + pad * 2;
+        int height = image->height + pad * 2;
+        if (width > pageSize || height > pageSize) {
+            LOG_WARN("packAtlas: '{}' ({}x{}) does not fit a {}px page",
+                     sources[index].name, image->width, image->height, pageSize);
+            continue;
+        }
+
+        int x = 0;
+        int y = 0;
+        size_t page = 0;
+        while (page < packers.size() && !packers[page].insert(width, height, x, y)) {
+            ++page;
+        }
+        if (page == packers.size()) {
+            packers.emplace_back(pageSize, pageSize);
+            result.pages.emplace_back(pageSize, pageSize);
+            pageBottoms.push_back(0);
+            packers.back().insert(width, height, x, y);
+        }
+
+        blitPadded(*image, result.pages[page], x + pad, y + pad, pad);
+        pageBottoms[page] = std::max(pageBottoms[page], y + height);
+
+        placedPage[index] = static_cast<int>(page);
+        placed[index].name = sources[index].name;
+        placed[index].page = static_cast<uint32_t>(page);
+        placed[index].bounds = Rect(static_cast<float>(x + pad), static_cast<float>(y + pad),
+                                    static_cast<float>(image->width),
+                                    static_cast<float>(image->height));
+    }
+
+    // Trim unused rows (rows are contiguous, so this is a plain resize),
+    // keeping power-of-two heights
+    for (size_t page = 0; page < result.pages.size(); ++page) {
+        int height = 1;
+        while (height < pageBottoms[page]) height *= 2;
+        if (height < pageSize) {
+            Image& image = result.pages[page];
+            image.height = height;
+            image.pixels.resize(static_cast<size_t>(image.width) * height * 4);
+        }
+    }
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (placedPage[i] >= 0) {
+            result.regions.push_back(std::move(placed[i]));
+        }
+    }
+    return result;
+}
+
+// ============================================================================
+// AtlasCache
+// ============================================================================
+
+namespace {
+
+constexpr uint32_t kAtlasCacheMagic = 0x4C544147;   // "GATL"
+constexpr uint32_t kAtlasCacheVersion = 1;
+constexpr uint32_t kMaxCachedPageEdge = 16384;
+constexpr uint32_t kMaxCachedNameLength = 4096;
+
+template<typename T>
+void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool readValue(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // namespace
+
+uint64_t AtlasCache::hash(const void* data, size_t size, uint64_t seed) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t h = seed;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= bytes[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+std::string AtlasCache::pathFor(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.atlas", static_cast<unsigned long long>(key));
+    return (fs::path(m_directory) / name).string();
+}
+
+bool AtlasCache::load(uint64_t key, PackedAtlas& out) const {
+    std::ifstream file(pathFor(key), std::ios::binary);
+    if (!file.is_open()) return false;
+
+    uint32_t magic = 0, version = 0;
+    uint64_t storedKey = 0;
+    if (!readValue(file, magic) || magic != kAtlasCacheMagic) return false;
+    if (!readValue(file, version) || version != kAtlasCacheVersion) return false;
+    if (!readValue(file, storedKey) || storedKey != key) return false;
+
+    PackedAtlas atlas;
+    uint32_t pageCount = 0;
+    if (!readValue(file, pageCount)) return false;
+    for (uint32_t i = 0; i < pageCount; ++i) {
+        uint32_t width = 0, height = 0;
+        if (!readValue(file, width) || !readValue(file, height)) return false;
+        if (width == 0 || height == 0 ||
+            width > kMaxCachedPageEdge || height > kMaxCachedPageEdge) return false;
+
+        Image page(static_cast<int>(width), static_cast<int>(height));
+        if (!file.read(reinterpret_cast<char*>(page.pixels.data()),
+                       static_cast<std::streamsize>(page.pixels.size()))) return false;
+        atlas.pages.push_back(std::move(page));
+    }
+
+    uint32_t regionCount = 0;
+    if (!readValue(file, regionCount)) return false;
+    for (uint32_t i = 0; i < regionCount; ++i) {
+        PackedRegion region;
+        uint32_t nameLength = 0;
+        if (!readValue(file, nameLength) || nameLength > kMaxCachedNameLength) return false;
+        region.name.resize(nameLength);
+        if (nameLength > 0 && !file.read(region.name.data(), nameLength)) return false;
+        if (!readValue(file, region.page) || region.page >= pageCount) return false;
+        if (!readValue(file, region.bounds)) return false;
+        atlas.regions.push_back(std::move(region));
+    }
+
+    out = std::move(atlas);
+    return true;
+}
+
+bool AtlasCache::save(uint64_t key, const PackedAtlas& atlas) const {
+    std::error_code ec;
+    fs::create_directories(m_directory, ec);
+    if (ec) {
+        LOG_WARN("AtlasCache: cannot create '{}': {}", m_directory, ec.message());
+        return false;
+    }
+
+    // Write beside the target and rename, so readers never see a partial file
+    std::string path = pathFor(key);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_WARN("AtlasCache: cannot write '{}'", tempPath);
+            return false;
+        }
+
+        writeValue(file, kAtlasCacheMagic);
+        writeValue(file, kAtlasCacheVersion);
+        writeValue(file, key);
+
+        writeValue(file, static_cast<uint32_t>(atlas.pages.size()));
+        for (const Image& page : atlas.pages) {
+            writeValue(file, static_cast<uint32_t>(page.width));
+            writeValue(file, static_cast<uint32_t>(page.height));
+            file.write(reinterpret_cast<const char*>(page.pixels.data()),
+                       static_cast<std::streamsize>(page.pixels.size()));
+        }
+
+        writeValue(file, static_cast<uint32_t>(atlas.regions.size()));
+        for (const PackedRegion& region : atlas.regions) {
+            writeValue(file, static_cast<uint32_t>(region.name.size()));
+            file.write(region.name.data(), static_cast<std::streamsize>(region.name.size()));
+            writeValue(file, region.page);
+            writeValue(file, region.bounds);
+        }
+
+        if (!file.good()) {
+            file.close();
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace gloaming
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "rendering/IRenderer.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gloaming {
+
+/// Rectangle bin packer for one atlas page (MaxRects, best short side fit).
+///
+/// Keeps the maximal free rectangles of the page; each insert picks the
+/// free rectangle whose shorter leftover side is smallest, then splits every
+/// free rectangle the placement overlaps and drops those contained in others.
+class MaxRectsPacker {
+public:
+    MaxRectsPacker(int width, int height);
+
+    /// Place a width x height rectangle. Returns false if it no longer fits.
+    bool insert(int width, int height, int& outX, int& outY);
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+    /// Fraction of the page area in use (0-1)
+    float occupancy() const;
+
+private:
+    struct Box {
+        int x, y, w, h;
+        bool contains(const Box& o) const {
+            return o.x >= x && o.y >= y && o.x + o.w <= x + w && o.y + o.h <= y + h;
+        }
+    };
+
+    void splitFreeBoxes(const Box& used);
+    void pruneFreeBoxes();
+
+    int m_width;
+    int m_height;
+    int64_t m_usedArea = 0;
+    std::vector<Box> m_free;
+    std::vector<Box> m_split;    ///< Scratch for splitFreeBoxes
+};
+
+/// Settings for packAtlas(). Part of the cache key.
+struct AtlasPackSettings {
+    int pageSize = 2048;    ///< Square page edge in pixels
+    int padding = 2;        ///< Border around each image, filled by repeating its edge pixels
+};
+
+/// Where one named image ended up
+struct PackedRegion {
+    std::string name;
+    uint32_t page = 0;
+    Rect bounds;            ///< Pixel bounds on the page, excluding padding
+};
+
+/// Output of packAtlas(): page images plus one region per packed input
+struct PackedAtlas {
+    std::vector<Image> pages;
+    std::vector<PackedRegion> regions;  ///< In input order
+};
+
+/// A named CPU-side image to pack
+struct AtlasSource {
+    std::string name;
+    const Image* image = nullptr;
+};
+
+/// Pack images into as few pages as possible, tallest first. Images that
+/// would not fit on an empty page (or are invalid) are left out of the
+/// result, so callers should keep them as standalone textures.
+PackedAtlas packAtlas(const std::vector<AtlasSource>& sources, const AtlasPackSettings& settings);
+
+/// Packed atlases on disk, one file per content hash, so unchanged inputs
+/// skip decoding and packing on the next run.
+///
+/// Files hold raw RGBA pages and the region table; a file that is missing,
+/// truncated, or from another format version is treated as a miss.
+class AtlasCache {
+public:
+    static constexpr uint64_t kHashSeed = 14695981039346656037ull;
+
+    explicit AtlasCache(std::string directory) : m_directory(std::move(directory)) {}
+
+    /// FNV-1a over `size` bytes, continuing from `seed` (chain calls to hash several buffers)
+    static uint64_t hash(const void* data, size_t size, uint64_t seed = kHashSeed);
+
+    /// Cache file for `key`
+    std::string pathFor(uint64_t key) const;
+
+    bool load(uint64_t key, PackedAtlas& out) const;
+    bool save(uint64_t key, const PackedAtlas& atlas) const;
+
+private:
+    std::string m_directory;
+};
+
+} // namespace gloaming
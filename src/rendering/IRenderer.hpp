@@ -3,8 +3,10 @@
 #include "engine/Vec2.hpp"
 
 #include <string>
+#include <cstddef>
 #include <cstdint>
 #include <cmath>
+#include <vector>
 
 namespace gloaming {
 
@@ -61,6 +63,35 @@ struct Rect {
     }
 };
 
+/// How batched geometry is blended with what is already drawn
+enum class BlendMode : uint8_t {
+    Alpha,          // Standard alpha blending
+    Additive        // Adds color (glows, sparks, fire)
+};
+
+/// Vertex of a quad submitted through IRenderer::drawQuadBatch
+struct QuadVertex {
+    Vec2 position;                  // Screen space
+    Vec2 uv;                        // Normalized texture coordinates
+    Color color;
+};
+
+/// CPU-side RGBA8 image, rows top to bottom, 4 bytes per pixel
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+
+    Image() = default;
+    Image(int w, int h)
+        : width(w), height(h), pixels(static_cast<size_t>(w) * static_cast<size_t>(h) * 4, 0) {}
+
+    bool isValid() const {
+        return width > 0 && height > 0 &&
+               pixels.size() == static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    }
+};
+
 /// Abstract renderer interface for backend-agnostic rendering
 /// This allows swapping Raylib for Vulkan/SDL/etc. in the future
 class IRenderer {
@@ -95,6 +126,12 @@ public:
     /// Unload a texture
     virtual void unloadTexture(Texture* texture) = 0;
 
+    /// Decode an image file to RGBA8 pixels without creating a texture
+    virtual bool loadImage(const std::string& path, Image& out) = 0;
+
+    /// Create a texture from RGBA8 pixels (owned by the renderer, like loadTexture)
+    virtual Texture* createTexture(const Image& image) = 0;
+
     /// Draw a texture at position
     virtual void drawTexture(const Texture* texture, Vec2 position,
                             Color tint = Color::White()) = 0;
@@ -128,6 +165,12 @@ public:
     /// Draw a circle outline
     virtual void drawCircleOutline(Vec2 center, float radius, const Color& color, float thickness = 1.0f) = 0;
 
+    /// Draw many quads with one texture and blend mode in a single submission.
+    /// `vertices` holds 4 per quad: top-left, bottom-left, bottom-right,
+    /// top-right. A null texture draws solid colored quads.
+    virtual void drawQuadBatch(const Texture* texture, BlendMode blend,
+                               const QuadVertex* vertices, size_t quadCount) = 0;
+
     /// Draw text (basic, for debugging)
     virtual void drawText(const std::string& text, Vec2 position, int fontSize,
                          const Color& color) = 0;
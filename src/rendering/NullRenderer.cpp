@@ -0,0 +1,105 @@
+#include "rendering/NullRenderer.hpp"
+#include "engine/Log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+namespace gloaming {
+
+/// Read width/height from a PNG's IHDR chunk. Returns false for anything
+/// that is not a readable PNG.
+static bool readPngSize(const std::string& path, int& width, int& height) {
+    static constexpr std::array<unsigned char, 8> kSignature = {
+        0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    // 8-byte signature, 4-byte chunk length, "IHDR", then big-endian width/height
+    std::array<unsigned char, 24> header{};
+    if (!file.read(reinterpret_cast<char*>(header.data()), header.size())) return false;
+    for (size_t i = 0; i < kSignature.size(); ++i) {
+        if (header[i] != kSignature[i]) return false;
+    }
+    if (header[12] != 'I' || header[13] != 'H' || header[14] != 'D' || header[15] != 'R') return false;
+
+    auto be32 = [&header](size_t at) {
+        return (static_cast<uint32_t>(header[at]) << 24) | (static_cast<uint32_t>(header[at + 1]) << 16) |
+               (static_cast<uint32_t>(header[at + 2]) << 8) | static_cast<uint32_t>(header[at + 3]);
+    };
+    width = static_cast<int>(be32(16));
+    height = static_cast<int>(be32(20));
+    return width > 0 && height > 0;
+}
+
+bool NullRenderer::init(int screenWidth, int screenHeight) {
+    m_screenWidth = screenWidth;
+    m_screenHeight = screenHeight;
+    LOG_INFO("NullRenderer: Initialized ({}x{}, headless)", screenWidth, screenHeight);
+    return true;
+}
+
+void NullRenderer::shutdown() {
+    m_textures.clear();
+}
+
+void NullRenderer::setScreenSize(int width, int height) {
+    m_screenWidth = width;
+    m_screenHeight = height;
+}
+
+Texture* NullRenderer::loadTexture(const std::string& path) {
+    std::ifstream probe(path, std::ios::binary);
+    if (!probe) {
+        LOG_ERROR("NullRenderer: Failed to load texture '{}'", path);
+        return nullptr;
+    }
+
+    int width = 1;
+    int height = 1;
+    readPngSize(path, width, height);
+
+    unsigned int id = m_nextTextureId++;
+    auto texture = std::make_unique<Texture>(width, height, id);
+    Texture* result = texture.get();
+    m_textures[id] = std::move(texture);
+    return result;
+}
+
+bool NullRenderer::loadImage(const std::string& path, Image& out) {
+    std::ifstream probe(path, std::ios::binary);
+    if (!probe) {
+        LOG_ERROR("NullRenderer: Failed to load image '{}'", path);
+        return false;
+    }
+
+    int width = 1;
+    int height = 1;
+    readPngSize(path, width, height);
+
+    out = Image(width, height);
+    std::fill(out.pixels.begin(), out.pixels.end(), uint8_t{255});
+    return true;
+}
+
+Texture* NullRenderer::createTexture(const Image& image) {
+    if (!image.isValid()) return nullptr;
+
+    unsigned int id = m_nextTextureId++;
+    auto texture = std::make_unique<Texture>(image.width, image.height, id);
+    Texture* result = texture.get();
+    m_textures[id] = std::move(texture);
+    return result;
+}
+
+void NullRenderer::unloadTexture(Texture* texture) {
+    if (!texture) return;
+    m_textures.erase(texture->getId());
+}
+
+int NullRenderer::measureTextWidth(const std::string& text, int fontSize) {
+    return static_cast<int>(text.size()) * fontSize / 2;
+}
+
+} // namespace gloaming
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "rendering/IRenderer.hpp"
+#include "rendering/Texture.hpp"
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+namespace gloaming {
+
+/// Renderer that draws nothing, for headless runs (servers, CI soak tests,
+/// benchmarks) and unit tests. Needs no window or GPU.
+///
+/// Textures are bookkeeping only: loadTexture() reads the image size from
+/// PNG headers (other formats report 1x1) so sprite and atlas setup code
+/// behaves as it would with a real renderer. Draw calls are counted, with
+/// quad batches also tallied separately so tests can check batching.
+class NullRenderer : public IRenderer {
+public:
+    NullRenderer() = default;
+    ~NullRenderer() override = default;
+
+    bool init(int screenWidth, int screenHeight) override;
+    void shutdown() override;
+
+    void beginFrame() override { m_drawCalls = 0; m_quadBatches = 0; m_batchedQuads = 0; }
+    void endFrame() override {}
+
+    void clear(const Color& /*color*/) override {}
+
+    int getScreenWidth() const override { return m_screenWidth; }
+    int getScreenHeight() const override { return m_screenHeight; }
+    void setScreenSize(int width, int height) override;
+
+    Texture* loadTexture(const std::string& path) override;
+    void unloadTexture(Texture* texture) override;
+
+    /// Opaque white pixels at the file's PNG size (1x1 for other formats).
+    bool loadImage(const std::string& path, Image& out) override;
+    Texture* createTexture(const Image& image) override;
+
+    void drawTexture(const Texture*, Vec2, Color = Color::White()) override { ++m_drawCalls; }
+    void drawTextureRegion(const Texture*, const Rect&, const Rect&,
+                           Color = Color::White()) override { ++m_drawCalls; }
+    void drawTextureRegionEx(const Texture*, const Rect&, const Rect&, Vec2, float,
+                             Color = Color::White()) override { ++m_drawCalls; }
+    void drawTextureEx(const Texture*, Vec2, float, float,
+                       Color = Color::White()) override { ++m_drawCalls; }
+    void drawRectangle(const Rect&, const Color&) override { ++m_drawCalls; }
+    void drawRectangleOutline(const Rect&, const Color&, float = 1.0f) override { ++m_drawCalls; }
+    void drawLine(Vec2, Vec2, const Color&, float = 1.0f) override { ++m_drawCalls; }
+    void drawCircle(Vec2, float, const Color&) override { ++m_drawCalls; }
+    void drawCircleOutline(Vec2, float, const Color&, float = 1.0f) override { ++m_drawCalls; }
+    void drawQuadBatch(const Texture*, BlendMode, const QuadVertex*, size_t quadCount) override {
+        ++m_drawCalls;
+        ++m_quadBatches;
+        m_batchedQuads += quadCount;
+    }
+    void drawText(const std::string&, Vec2, int, const Color&) override { ++m_drawCalls; }
+
+    /// Approximates raylib's default font (about half the font size per glyph).
+    int measureTextWidth(const std::string& text, int fontSize) override;
+
+    /// Draw calls since the last beginFrame().
+    uint64_t drawCallCount() const { return m_drawCalls; }
+
+    /// drawQuadBatch() calls, and the quads they carried, since the last beginFrame().
+    uint64_t quadBatchCount() const { return m_quadBatches; }
+    uint64_t batchedQuadCount() const { return m_batchedQuads; }
+
+    /// Number of textures currently loaded.
+    size_t textureCount() const { return m_textures.size(); }
+
+private:
+    int m_screenWidth = 0;
+    int m_screenHeight = 0;
+    unsigned int m_nextTextureId = 1;
+    uint64_t m_drawCalls = 0;
+    uint64_t m_quadBatches = 0;
+    uint64_t m_batchedQuads = 0;
+    std::unordered_map<unsigned int, std::unique_ptr<Texture>> m_textures;
+};
+
+} // namespace gloaming
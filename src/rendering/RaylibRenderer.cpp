@@ -1,6 +1,10 @@
 #include "rendering/RaylibRenderer.hpp"
 #include "engine/Log.hpp"
 
+#include <rlgl.h>
+
+#include <algorithm>
+
 namespace gloaming {
 
 // Helper to convert our Color to Raylib Color
@@ -73,6 +77,48 @@ Texture* RaylibRenderer::loadTexture(const std::string& path) {
         return nullptr;
     }
 
+    Texture* result = adoptTexture(rlTexture);
+    LOG_DEBUG("RaylibRenderer: Loaded texture '{}' ({}x{}, id={})",
+              path, rlTexture.width, rlTexture.height, result->getId());
+
+    return result;
+}
+
+bool RaylibRenderer::loadImage(const std::string& path, Image& out) {
+    ::Image rlImage = LoadImage(path.c_str());
+    if (!rlImage.data) {
+        LOG_ERROR("RaylibRenderer: Failed to load image '{}'", path);
+        return false;
+    }
+
+    ImageFormat(&rlImage, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    out = Image(rlImage.width, rlImage.height);
+    const auto* pixels = static_cast<const uint8_t*>(rlImage.data);
+    std::copy(pixels, pixels + out.pixels.size(), out.pixels.begin());
+    UnloadImage(rlImage);
+    return true;
+}
+
+Texture* RaylibRenderer::createTexture(const Image& image) {
+    if (!image.isValid()) return nullptr;
+
+    // LoadTextureFromImage only reads the pixels, so the const_cast is safe
+    ::Image rlImage{};
+    rlImage.data = const_cast<uint8_t*>(image.pixels.data());
+    rlImage.width = image.width;
+    rlImage.height = image.height;
+    rlImage.mipmaps = 1;
+    rlImage.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+    ::Texture2D rlTexture = LoadTextureFromImage(rlImage);
+    if (rlTexture.id == 0) {
+        LOG_ERROR("RaylibRenderer: Failed to create {}x{} texture", image.width, image.height);
+        return nullptr;
+    }
+    return adoptTexture(rlTexture);
+}
+
+Texture* RaylibRenderer::adoptTexture(const ::Texture2D& rlTexture) {
     // Create our texture wrapper
     unsigned int id = m_nextTextureId++;
     auto engineTexture = std::make_unique<Texture>(rlTexture.width, rlTexture.height, id);
@@ -84,10 +130,6 @@ Texture* RaylibRenderer::loadTexture(const std::string& path) {
 
     Texture* result = data.engineTexture.get();
     m_textures[id] = std::move(data);
-
-    LOG_DEBUG("RaylibRenderer: Loaded texture '{}' ({}x{}, id={})",
-              path, rlTexture.width, rlTexture.height, id);
-
     return result;
 }
 
@@ -194,6 +236,43 @@ void RaylibRenderer::drawCircleOutline(Vec2 center, float radius, const Color& c
     }
 }
 
+void RaylibRenderer::drawQuadBatch(const Texture* texture, BlendMode blend,
+                                   const QuadVertex* vertices, size_t quadCount) {
+    if (!vertices || quadCount == 0) return;
+
+    // Untextured quads sample rlgl's 1x1 white default texture
+    unsigned int textureId = rlGetTextureIdDefault();
+    if (texture) {
+        const ::Texture2D* rlTex = getRaylibTexture(texture);
+        if (!rlTex) return;
+        textureId = rlTex->id;
+    }
+
+    if (blend == BlendMode::Additive) BeginBlendMode(BLEND_ADDITIVE);
+
+    // rlgl's vertex buffer holds a few thousand quads; feed it in chunks so
+    // it flushes between them rather than mid-quad
+    constexpr size_t kChunkQuads = 1024;
+    for (size_t first = 0; first < quadCount; first += kChunkQuads) {
+        size_t count = std::min(kChunkQuads, quadCount - first);
+        rlCheckRenderBatchLimit(static_cast<int>(count * 4));
+
+        rlSetTexture(textureId);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        const QuadVertex* end = vertices + (first + count) * 4;
+        for (const QuadVertex* v = vertices + first * 4; v != end; ++v) {
+            rlColor4ub(v->color.r, v->color.g, v->color.b, v->color.a);
+            rlTexCoord2f(v->uv.x, v->uv.y);
+            rlVertex2f(v->position.x, v->position.y);
+        }
+        rlEnd();
+        rlSetTexture(0);
+    }
+
+    if (blend == BlendMode::Additive) EndBlendMode();
+}
+
 void RaylibRenderer::drawText(const std::string& text, Vec2 position,
                               int fontSize, const Color& color) {
     DrawText(text.c_str(), static_cast<int>(position.x), static_cast<int>(position.y),
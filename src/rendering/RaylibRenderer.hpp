@@ -29,6 +29,8 @@ public:
 
     Texture* loadTexture(const std::string& path) override;
     void unloadTexture(Texture* texture) override;
+    bool loadImage(const std::string& path, Image& out) override;
+    Texture* createTexture(const Image& image) override;
 
     void drawTexture(const Texture* texture, Vec2 position,
                     Color tint = Color::White()) override;
@@ -54,6 +56,9 @@ public:
     void drawCircleOutline(Vec2 center, float radius, const Color& color,
                            float thickness = 1.0f) override;
 
+    void drawQuadBatch(const Texture* texture, BlendMode blend,
+                       const QuadVertex* vertices, size_t quadCount) override;
+
     void drawText(const std::string& text, Vec2 position, int fontSize,
                  const Color& color) override;
 
@@ -68,6 +73,9 @@ private:
         std::unique_ptr<Texture> engineTexture;
     };
 
+    /// Wrap a loaded raylib texture and take ownership of it
+    Texture* adoptTexture(const ::Texture2D& rlTexture);
+
     int m_screenWidth = 0;
     int m_screenHeight = 0;
     bool m_initialized = false;
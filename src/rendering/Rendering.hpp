@@ -5,6 +5,7 @@
 #include "rendering/IRenderer.hpp"
 #include "rendering/RaylibRenderer.hpp"
 #include "rendering/Texture.hpp"
+#include "rendering/AtlasPacker.hpp"
 #include "rendering/Camera.hpp"
 #include "rendering/SpriteBatch.hpp"
 #include "rendering/TileRenderer.hpp"
@@ -1,6 +1,7 @@
 #include "rendering/SpriteBatch.hpp"
 #include "engine/Log.hpp"
 #include <algorithm>
+#include <cmath>
 
 namespace gloaming {
 
@@ -65,6 +66,18 @@ void SpriteBatch::draw(const Texture* texture, const Rect& sourceRect,
     draw(sprite);
 }
 
+void SpriteBatch::draw(const TextureRegion& region, Vec2 position, Color tint, int layer) {
+    if (!region.texture) return;
+
+    SpriteData sprite;
+    sprite.texture = region.texture;
+    sprite.sourceRect = region.bounds;
+    sprite.position = position;
+    sprite.tint = tint;
+    sprite.layer = layer;
+    draw(sprite);
+}
+
 void SpriteBatch::draw(const TextureAtlas* atlas, const std::string& regionName,
                        Vec2 position, Color tint) {
     if (!atlas || !atlas->getTexture()) return;
@@ -122,23 +135,20 @@ void SpriteBatch::flush() {
         return;
     }
 
+    m_lastDrawCalls = 0;
     if (m_sprites.empty()) {
-        m_lastDrawCalls = 0;
         return;
     }
 
-    // Sort by layer if enabled
-    if (m_sortEnabled) {
-        std::stable_sort(m_sprites.begin(), m_sprites.end(),
-            [](const SpriteData& a, const SpriteData& b) {
-                return a.layer < b.layer;
-            });
-    }
+    // Cull and build sort keys; texture slots are numbered by first use
+    m_order.clear();
+    m_keys.clear();
+    m_textureSlots.clear();
+    const Texture* lastTexture = nullptr;
+    uint32_t lastSlot = 0;
+    for (size_t i = 0; i < m_sprites.size(); ++i) {
+        const SpriteData& sprite = m_sprites[i];
 
-    // Render each sprite
-    m_lastDrawCalls = 0;
-    for (const SpriteData& sprite : m_sprites) {
-        // Culling check
         if (m_cullingEnabled && m_camera) {
             float width = sprite.sourceRect.width * sprite.scale.x;
             float height = sprite.sourceRect.height * sprite.scale.y;
@@ -152,43 +162,162 @@ void SpriteBatch::flush() {
             }
         }
 
-        renderSprite(sprite);
+        if (sprite.texture != lastTexture) {
+            auto [it, inserted] = m_textureSlots.try_emplace(
+                sprite.texture, static_cast<uint32_t>(m_textureSlots.size()));
+            lastTexture = sprite.texture;
+            lastSlot = it->second;
+        }
+
+        m_order.push_back(static_cast<uint32_t>(i));
+        m_keys.push_back(makeSortKey(sprite.layer, sprite.blend, lastSlot));
+    }
+
+    if (m_order.empty()) {
+        m_sprites.clear();
+        return;
+    }
+
+    if (m_sortEnabled) {
+        radixSort();
+    }
+
+    // Quads in draw order, then one bulk pass to screen space
+    m_vertices.resize(m_order.size() * 4);
+    for (size_t i = 0; i < m_order.size(); ++i) {
+        buildQuad(m_sprites[m_order[i]], &m_vertices[i * 4]);
+    }
+    if (m_camera) {
+        transformToScreen();
+    }
+
+    // Submit each run of sprites sharing a texture and blend mode
+    size_t runStart = 0;
+    for (size_t i = 1; i <= m_order.size(); ++i) {
+        const SpriteData& first = m_sprites[m_order[runStart]];
+        if (i < m_order.size()) {
+            const SpriteData& next = m_sprites[m_order[i]];
+            if (next.texture == first.texture && next.blend == first.blend) continue;
+        }
+        m_renderer->drawQuadBatch(first.texture, first.blend,
+                                  &m_vertices[runStart * 4], i - runStart);
         ++m_lastDrawCalls;
+        runStart = i;
     }
 
     m_sprites.clear();
 }
 
-void SpriteBatch::renderSprite(const SpriteData& sprite) {
-    // Calculate destination rectangle size
-    float width = sprite.sourceRect.width * sprite.scale.x;
-    float height = sprite.sourceRect.height * sprite.scale.y;
+uint64_t SpriteBatch::makeSortKey(int layer, BlendMode blend, uint32_t textureSlot) {
+    // Flip the sign bit so negative layers order before positive ones
+    uint64_t layerBits = static_cast<uint32_t>(layer) ^ 0x80000000u;
+    uint64_t blendBit = static_cast<uint64_t>(blend) & 1u;
+    return (layerBits << 32) | (blendBit << 31) | (textureSlot & 0x7FFFFFFFu);
+}
+
+void SpriteBatch::radixSort() {
+    const size_t count = m_order.size();
+    m_keyScratch.resize(count);
+    m_orderScratch.resize(count);
 
-    // Transform to screen space if we have a camera
-    Vec2 screenPos = sprite.position;
-    if (m_camera) {
-        screenPos = m_camera->worldToScreen(sprite.position);
-        float zoom = m_camera->getZoom();
-        width *= zoom;
-        height *= zoom;
+    uint64_t* keys = m_keys.data();
+    uint32_t* order = m_order.data();
+    uint64_t* keysOut = m_keyScratch.data();
+    uint32_t* orderOut = m_orderScratch.data();
+
+    // Bits that differ between keys; passes over bytes that are all the same
+    // (usually the high layer bytes) are skipped
+    uint64_t varying = 0;
+    for (size_t i = 1; i < count; ++i) {
+        varying |= keys[i] ^ keys[0];
+    }
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xFFu) == 0) continue;
+
+        size_t offsets[256] = {};
+        for (size_t i = 0; i < count; ++i) {
+            ++offsets[(keys[i] >> shift) & 0xFFu];
+        }
+        size_t sum = 0;
+        for (size_t& offset : offsets) {
+            size_t bucketCount = offset;
+            offset = sum;
+            sum += bucketCount;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            size_t dst = offsets[(keys[i] >> shift) & 0xFFu]++;
+            keysOut[dst] = keys[i];
+            orderOut[dst] = order[i];
+        }
+        std::swap(keys, keysOut);
+        std::swap(order, orderOut);
     }
 
-    // Use the renderer to draw
+    // An odd number of passes leaves the result in the scratch buffers
+    if (keys != m_keys.data()) {
+        m_keys.swap(m_keyScratch);
+        m_order.swap(m_orderScratch);
+    }
+}
+
+void SpriteBatch::buildQuad(const SpriteData& sprite, QuadVertex* out) {
+    const Rect& src = sprite.sourceRect;
+    float width = std::abs(src.width * sprite.scale.x);
+    float height = std::abs(src.height * sprite.scale.y);
+
+    // Corners relative to the pivot, rotated about it in world space
+    float left = -width * sprite.origin.x;
+    float top = -height * sprite.origin.y;
+    Vec2 corners[4] = {
+        {left, top},
+        {left, top + height},
+        {left + width, top + height},
+        {left + width, top},
+    };
     if (sprite.rotation != 0.0f) {
-        // For rotated sprites, position the dest rect at the sprite position
-        // and use origin (in pixels) to define the rotation pivot
-        Vec2 originPixels(width * sprite.origin.x, height * sprite.origin.y);
-        Rect destRect(screenPos.x, screenPos.y, width, height);
-        m_renderer->drawTextureRegionEx(sprite.texture, sprite.sourceRect,
-                                        destRect, originPixels, sprite.rotation,
-                                        sprite.tint);
-    } else {
-        // For non-rotated sprites, apply origin offset to position
-        float destX = screenPos.x - width * sprite.origin.x;
-        float destY = screenPos.y - height * sprite.origin.y;
-        Rect destRect(destX, destY, width, height);
-        m_renderer->drawTextureRegion(sprite.texture, sprite.sourceRect,
-                                      destRect, sprite.tint);
+        float radians = sprite.rotation * DEG_TO_RAD;
+        float cosR = std::cos(radians);
+        float sinR = std::sin(radians);
+        for (Vec2& c : corners) {
+            c = Vec2(c.x * cosR - c.y * sinR, c.x * sinR + c.y * cosR);
+        }
+    }
+
+    // Negative source size or scale mirrors the texture, not the quad
+    float invW = 1.0f / static_cast<float>(sprite.texture->getWidth());
+    float invH = 1.0f / static_cast<float>(sprite.texture->getHeight());
+    float u0 = src.x * invW;
+    float v0 = src.y * invH;
+    float u1 = (src.x + std::abs(src.width)) * invW;
+    float v1 = (src.y + std::abs(src.height)) * invH;
+    if ((src.width < 0.0f) != (sprite.scale.x < 0.0f)) std::swap(u0, u1);
+    if ((src.height < 0.0f) != (sprite.scale.y < 0.0f)) std::swap(v0, v1);
+
+    out[0] = {sprite.position + corners[0], {u0, v0}, sprite.tint};
+    out[1] = {sprite.position + corners[1], {u0, v1}, sprite.tint};
+    out[2] = {sprite.position + corners[2], {u1, v1}, sprite.tint};
+    out[3] = {sprite.position + corners[3], {u1, v0}, sprite.tint};
+}
+
+void SpriteBatch::transformToScreen() {
+    // Same mapping as Camera::worldToScreen, folded into one affine transform
+    Vec2 cameraPos = m_camera->getPosition();
+    Vec2 center = m_camera->getScreenSize() * 0.5f;
+    float zoom = m_camera->getZoom();
+    float cosR = zoom;
+    float sinR = 0.0f;
+    if (m_camera->getRotation() != 0.0f) {
+        float radians = m_camera->getRotation() * DEG_TO_RAD;
+        cosR = std::cos(radians) * zoom;
+        sinR = std::sin(radians) * zoom;
+    }
+
+    for (QuadVertex& v : m_vertices) {
+        float dx = v.position.x - cameraPos.x;
+        float dy = v.position.y - cameraPos.y;
+        v.position.x = center.x + dx * cosR - dy * sinR;
+        v.position.y = center.y + dx * sinR + dy * cosR;
     }
 }
 
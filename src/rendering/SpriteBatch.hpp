@@ -3,6 +3,8 @@
 #include "rendering/IRenderer.hpp"
 #include "rendering/Texture.hpp"
 #include "rendering/Camera.hpp"
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace gloaming {
@@ -17,6 +19,7 @@ struct SpriteData {
     float rotation = 0.0f; // Rotation in degrees
     Color tint = Color::White();
     int layer = 0;         // Draw order (lower = drawn first)
+    BlendMode blend = BlendMode::Alpha;
 
     SpriteData() = default;
     SpriteData(const Texture* tex, Vec2 pos)
@@ -29,7 +32,12 @@ struct SpriteData {
 };
 
 /// Batches sprite rendering for efficiency
-/// Groups sprites by texture and sorts by layer for correct draw order
+///
+/// flush() radix-sorts sprites by a packed (layer, blend, texture) key,
+/// transforms every quad to screen space in one pass, and submits each
+/// contiguous run sharing a texture and blend mode as a single
+/// IRenderer::drawQuadBatch call. Sprites in the same layer may be reordered
+/// to group textures; sprites with equal keys keep submission order.
 class SpriteBatch {
 public:
     SpriteBatch() = default;
@@ -58,6 +66,10 @@ public:
     void draw(const Texture* texture, const Rect& sourceRect, Vec2 position,
               Vec2 origin, Vec2 scale, float rotation, Color tint, int layer = 0);
 
+    /// Convenience: draw a texture region (e.g. from TextureManager::getRegion)
+    void draw(const TextureRegion& region, Vec2 position, Color tint = Color::White(),
+              int layer = 0);
+
     /// Convenience: draw from an atlas region
     void draw(const TextureAtlas* atlas, const std::string& regionName,
               Vec2 position, Color tint = Color::White());
@@ -76,10 +88,12 @@ public:
     /// Get the number of sprites in the current batch
     size_t getSpriteCount() const { return m_sprites.size(); }
 
-    /// Get the number of draw calls in the last flush
+    /// Get the number of draw calls in the last flush (one per texture/blend run)
     size_t getDrawCallCount() const { return m_lastDrawCalls; }
 
-    /// Enable/disable sorting by layer (enabled by default)
+    /// Enable/disable sorting by layer and texture (enabled by default).
+    /// When disabled, sprites draw in submission order and only adjacent
+    /// sprites sharing a texture are batched.
     void setSortEnabled(bool enabled) { m_sortEnabled = enabled; }
 
     /// Enable/disable camera culling (enabled by default)
@@ -95,7 +109,25 @@ private:
     bool m_cullingEnabled = true;
     size_t m_lastDrawCalls = 0;
 
-    void renderSprite(const SpriteData& sprite);
+    // Per-flush scratch, kept to avoid reallocating every frame
+    std::vector<uint64_t> m_keys;
+    std::vector<uint64_t> m_keyScratch;
+    std::vector<uint32_t> m_order;          ///< Indices into m_sprites, draw order
+    std::vector<uint32_t> m_orderScratch;
+    std::vector<QuadVertex> m_vertices;     ///< 4 per drawn sprite, in m_order order
+    std::unordered_map<const Texture*, uint32_t> m_textureSlots;
+
+    /// Pack layer (most significant), blend and texture slot into one key
+    static uint64_t makeSortKey(int layer, BlendMode blend, uint32_t textureSlot);
+
+    /// Stable LSD radix sort of m_order by m_keys (8 bits per pass)
+    void radixSort();
+
+    /// Write a sprite's world-space corners and UVs (TL, BL, BR, TR)
+    static void buildQuad(const SpriteData& sprite, QuadVertex* out);
+
+    /// Transform every vertex from world to screen space with m_camera
+    void transformToScreen();
 };
 
 } // namespace gloaming
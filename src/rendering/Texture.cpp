@@ -1,6 +1,10 @@
 #include "rendering/Texture.hpp"
 #include "engine/Log.hpp"
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
 namespace gloaming {
 
 void TextureAtlas::addRegion(const std::string& name, const Rect& bounds, Vec2 pivot) {
@@ -97,6 +101,7 @@ void TextureManager::unloadAll() {
             m_renderer->unloadTexture(texture);
         }
     }
+    releaseAtlasPages();
     m_textures.clear();
     m_atlases.clear();
     LOG_DEBUG("TextureManager: Unloaded all textures");
@@ -127,4 +132,109 @@ bool TextureManager::hasTexture(const std::string& path) const {
     return m_textures.find(path) != m_textures.end();
 }
 
+size_t TextureManager::packTextures(const std::vector<std::string>& paths,
+                                    const AtlasPackSettings& settings,
+                                    const std::string& cacheDir) {
+    releaseAtlasPages();
+    m_lastPackFromCache = false;
+
+    if (!m_renderer) {
+        LOG_ERROR("TextureManager: No renderer set, cannot pack textures");
+        return 0;
+    }
+
+    // Sorted and deduplicated so the cache key ignores registration order
+    std::vector<std::string> sorted = paths;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    // Key: settings, then each readable file's path and bytes
+    std::vector<std::string> inputs;
+    uint64_t key = AtlasCache::hash(&settings.pageSize, sizeof(settings.pageSize));
+    key = AtlasCache::hash(&settings.padding, sizeof(settings.padding), key);
+    std::string bytes;
+    for (const std::string& path : sorted) {
+        if (path.empty()) continue;
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            LOG_WARN("TextureManager: Cannot read '{}' for packing", path);
+            continue;
+        }
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        key = AtlasCache::hash(path.data(), path.size() + 1, key);
+        key = AtlasCache::hash(bytes.data(), bytes.size(), key);
+        inputs.push_back(path);
+    }
+    if (inputs.empty()) return 0;
+
+    PackedAtlas atlas;
+    AtlasCache cache(cacheDir);
+    if (!cacheDir.empty() && cache.load(key, atlas)) {
+        m_lastPackFromCache = true;
+    } else {
+        std::vector<Image> images(inputs.size());
+        std::vector<AtlasSource> sources;
+        sources.reserve(inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (m_renderer->loadImage(inputs[i], images[i])) {
+                sources.push_back({inputs[i], &images[i]});
+            }
+        }
+        atlas = packAtlas(sources, settings);
+        if (!cacheDir.empty() && !cache.save(key, atlas)) {
+            LOG_WARN("TextureManager: Failed to write atlas cache to '{}'", cacheDir);
+        }
+    }
+
+    for (const Image& page : atlas.pages) {
+        m_atlasPages.push_back(m_renderer->createTexture(page));
+    }
+    for (const PackedRegion& packed : atlas.regions) {
+        Texture* page = packed.page < m_atlasPages.size() ? m_atlasPages[packed.page] : nullptr;
+        if (!page) continue;
+        m_regionHandles[packed.name] = static_cast<TextureRegionHandle>(m_regions.size());
+        m_regions.push_back({page, packed.bounds});
+    }
+
+    LOG_INFO("TextureManager: Packed {}/{} textures into {} atlas page(s){}",
+             m_regionHandles.size(), inputs.size(), m_atlasPages.size(),
+             m_lastPackFromCache ? " (cached)" : "");
+    return m_regionHandles.size();
+}
+
+TextureRegionHandle TextureManager::getRegionHandle(const std::string& path) const {
+    auto it = m_regionHandles.find(path);
+    return it != m_regionHandles.end() ? it->second : 0;
+}
+
+const TextureRegion* TextureManager::getRegion(TextureRegionHandle handle) const {
+    if (handle == 0 || handle >= m_regions.size()) return nullptr;
+    return &m_regions[handle];
+}
+
+bool TextureManager::resolveRegion(const std::string& path, TextureRegion& out) {
+    if (const TextureRegion* packed = getRegion(getRegionHandle(path))) {
+        out = *packed;
+        return true;
+    }
+
+    Texture* texture = loadTexture(path);
+    if (!texture) return false;
+    out.texture = texture;
+    out.bounds = Rect(0, 0, static_cast<float>(texture->getWidth()),
+                      static_cast<float>(texture->getHeight()));
+    return true;
+}
+
+void TextureManager::releaseAtlasPages() {
+    if (m_renderer) {
+        for (Texture* page : m_atlasPages) {
+            if (page) m_renderer->unloadTexture(page);
+        }
+    }
+    m_atlasPages.clear();
+    m_regions.resize(1);
+    m_regionHandles.clear();
+}
+
 } // namespace gloaming
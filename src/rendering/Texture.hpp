@@ -1,6 +1,8 @@
 #pragma once
 
 #include "rendering/IRenderer.hpp"
+#include "rendering/AtlasPacker.hpp"
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <memory>
@@ -74,6 +76,15 @@ private:
     std::unordered_map<std::string, AtlasRegion> m_regions;
 };
 
+/// Handle to a packed texture region (0 = none). Stable until the next packTextures().
+using TextureRegionHandle = uint32_t;
+
+/// A texture and the area of it to draw
+struct TextureRegion {
+    const Texture* texture = nullptr;
+    Rect bounds;
+};
+
 /// Manages loaded textures and atlases with caching
 /// Note: Textures are owned by the renderer, TextureManager just caches pointers
 class TextureManager {
@@ -109,11 +120,44 @@ public:
     /// Check if a texture is loaded
     [[nodiscard]] bool hasTexture(const std::string& path) const;
 
+    /// Pack image files into shared atlas pages so sprites using them can be
+    /// batched together. The result is cached under `cacheDir` (empty = no
+    /// cache), keyed by a hash of the files' contents and the settings, so
+    /// unchanged inputs reuse the cached pages without decoding anything.
+    /// Replaces any previous packing; returns the number of packed files.
+    size_t packTextures(const std::vector<std::string>& paths,
+                        const AtlasPackSettings& settings = {},
+                        const std::string& cacheDir = "");
+
+    /// Whether the last packTextures() was served from the disk cache
+    bool lastPackFromCache() const { return m_lastPackFromCache; }
+
+    /// Number of atlas pages from the last packTextures()
+    size_t atlasPageCount() const { return m_atlasPages.size(); }
+
+    /// Handle of a packed file, or 0 if it was not packed
+    TextureRegionHandle getRegionHandle(const std::string& path) const;
+
+    /// Region for a handle (nullptr for 0 or unknown handles)
+    const TextureRegion* getRegion(TextureRegionHandle handle) const;
+
+    /// Where to draw `path` from: its atlas region when packed, otherwise
+    /// the whole standalone texture (loaded on demand). False if neither exists.
+    bool resolveRegion(const std::string& path, TextureRegion& out);
+
 private:
+    void releaseAtlasPages();
+
     IRenderer* m_renderer = nullptr;
     // Non-owning cache: renderer owns the textures, we just map paths to pointers
     std::unordered_map<std::string, Texture*> m_textures;
     std::unordered_map<std::string, std::unique_ptr<TextureAtlas>> m_atlases;
+
+    // Packed atlas pages (renderer-owned) and regions; index 0 is the null handle
+    std::vector<Texture*> m_atlasPages;
+    std::vector<TextureRegion> m_regions{TextureRegion{}};
+    std::unordered_map<std::string, TextureRegionHandle> m_regionHandles;
+    bool m_lastPackFromCache = false;
 };
 
 } // namespace gloaming
@@ -99,6 +99,8 @@ void TileRenderer::renderTile(const Tile& tile, float worldX, float worldY) {
 
     // Calculate source rectangle (handle variants)
     Rect source = def->textureRegion;
+    source.x += m_tilesetOrigin.x;
+    source.y += m_tilesetOrigin.y;
     if (def->variantCount > 1 && tile.variant < def->variantCount) {
         // Variants are assumed to be laid out horizontally
         source.x += tile.variant * source.width;
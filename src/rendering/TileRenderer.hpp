@@ -57,7 +57,14 @@ public:
     void setCamera(const Camera* camera) { m_camera = camera; }
 
     /// Set the tileset texture
-    void setTileset(const Texture* tileset) { m_tileset = tileset; }
+    void setTileset(const Texture* tileset) { m_tileset = tileset; m_tilesetOrigin = {}; }
+
+    /// Set the tileset from a region (e.g. a tileset packed into an atlas
+    /// page); tile texture regions are then relative to the region's corner
+    void setTileset(const TextureRegion& tileset) {
+        m_tileset = tileset.texture;
+        m_tilesetOrigin = Vec2(tileset.bounds.x, tileset.bounds.y);
+    }
 
     /// Set the tile size
     void setTileSize(int size) { m_config.tileSize = size; }
@@ -102,6 +109,7 @@ private:
     IRenderer* m_renderer = nullptr;
     const Camera* m_camera = nullptr;
     const Texture* m_tileset = nullptr;
+    Vec2 m_tilesetOrigin;
     TileRenderConfig m_config;
 
     std::vector<TileDefinition> m_tileDefinitions;
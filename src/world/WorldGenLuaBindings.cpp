@@ -47,12 +47,15 @@ void bindWorldGenAPI(sol::state& lua, Engine& engine, WorldGenerator& worldGen)
     // worldgen.registerTerrainGenerator(name, callback)
     // callback(chunk_x, seed) -> table of 64 heights
     // =========================================================================
-    wg["registerTerrainGenerator"] = [&worldGen, &lua](
-            const std::string& name, sol::function callback) {
+    wg["registerTerrainGenerator"] = [&worldGen, &engine](
+            const std::string& name, sol::protected_function callback) {
 
-        sol::function fn = callback;
+        sol::protected_function fn = callback;
+        LuaCpuBudget* cpu = &engine.getModLoader().getLuaBindings().getCpuBudget();
+        LuaCpuBudget::ModHandle owner = cpu->currentMod();
         worldGen.registerTerrainGenerator(name,
-            [fn, &lua](int chunkX, uint64_t seed) -> std::vector<int> {
+            [fn, cpu, owner](int chunkX, uint64_t seed) -> std::vector<int> {
+                LuaCpuBudget::Scope scope(cpu, owner);
                 std::vector<int> heights;
                 heights.reserve(CHUNK_SIZE);
                 try {
@@ -279,19 +282,15 @@ void bindWorldGenAPI(sol::state& lua, Engine& engine, WorldGenerator& worldGen)
     //   chunk_handle:get_tile(local_x, local_y) -> {id, variant, flags}
     //   chunk_handle:set_tile(local_x, local_y, tile_id, variant, flags)
     // =========================================================================
-    wg["registerPass"] = [&worldGen, &lua](const std::string& name, int priority,
-                                      sol::function callback) {
-        sol::function fn = callback;
+    wg["registerPass"] = [&worldGen, &lua, &engine](const std::string& name, int priority,
+                                               sol::protected_function callback) {
+        auto fn = engine.getModLoader().getLuaBindings().modCallback<sol::table, uint32_t, uint32_t>(
+            std::move(callback), "worldgen pass");
         worldGen.registerPass(name, priority,
             [fn, &lua](Chunk& chunk, uint64_t seed, const WorldGenConfig&) {
-                try {
-                    sol::table chunkHandle = makeChunkHandle(lua, chunk);
-                    uint32_t seedHi = static_cast<uint32_t>(seed >> 32);
-                    uint32_t seedLo = static_cast<uint32_t>(seed & 0xFFFFFFFF);
-                    fn(chunkHandle, seedLo, seedHi);
-                } catch (const std::exception& e) {
-                    MOD_LOG_ERROR("worldgen pass error: {}", e.what());
-                }
+                uint32_t seedHi = static_cast<uint32_t>(seed >> 32);
+                uint32_t seedLo = static_cast<uint32_t>(seed & 0xFFFFFFFF);
+                fn(makeChunkHandle(lua, chunk), seedLo, seedHi);
             });
         MOD_LOG_INFO("Registered worldgen pass '{}' (priority {})", name, priority);
     };
@@ -300,18 +299,15 @@ void bindWorldGenAPI(sol::state& lua, Engine& engine, WorldGenerator& worldGen)
     // worldgen.registerDecorator(name, callback)
     // callback(chunk_handle, seed_lo, seed_hi) -- same chunk_handle as passes
     // =========================================================================
-    wg["registerDecorator"] = [&worldGen, &lua](const std::string& name, sol::function callback) {
-        sol::function fn = callback;
+    wg["registerDecorator"] = [&worldGen, &lua, &engine](const std::string& name,
+                                                    sol::protected_function callback) {
+        auto fn = engine.getModLoader().getLuaBindings().modCallback<sol::table, uint32_t, uint32_t>(
+            std::move(callback), "worldgen decorator");
         worldGen.registerDecorator(name,
             [fn, &lua](Chunk& chunk, uint64_t seed) {
-                try {
-                    sol::table chunkHandle = makeChunkHandle(lua, chunk);
-                    uint32_t seedHi = static_cast<uint32_t>(seed >> 32);
-                    uint32_t seedLo = static_cast<uint32_t>(seed & 0xFFFFFFFF);
-                    fn(chunkHandle, seedLo, seedHi);
-                } catch (const std::exception& e) {
-                    MOD_LOG_ERROR("worldgen decorator error: {}", e.what());
-                }
+                uint32_t seedHi = static_cast<uint32_t>(seed >> 32);
+                uint32_t seedLo = static_cast<uint32_t>(seed & 0xFFFFFFFF);
+                fn(makeChunkHandle(lua, chunk), seedLo, seedHi);
             });
         MOD_LOG_INFO("Registered worldgen decorator '{}'", name);
     };
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include "engine/Config.hpp"
+#include "engine/Headless.hpp"
 
 #include <filesystem>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -290,3 +292,80 @@ TEST(ConfigTest, ArrayValuesReturnDefault) {
     ASSERT_TRUE(cfg.loadFromString(R"({"list": [1, 2, 3]})"));
     EXPECT_EQ(cfg.getInt("list", -1), -1);
 }
+
+// =============================================================================
+// Launch Options and Headless Mode
+// =============================================================================
+
+TEST(LaunchOptionsTest, DefaultsLeaveConfigAlone) {
+    const char* argv[] = {"gloaming"};
+    LaunchOptions options = LaunchOptions::parse(1, argv);
+    EXPECT_EQ(options.configPath, "config.json");
+    EXPECT_TRUE(options.errors.empty());
+
+    HeadlessConfig config;
+    config.tickRate = 30.0;
+    options.applyTo(config);
+    EXPECT_FALSE(config.enabled);
+    EXPECT_DOUBLE_EQ(config.tickRate, 30.0);
+}
+
+TEST(LaunchOptionsTest, ParsesHeadlessBenchmarkRun) {
+    const char* argv[] = {"gloaming", "--config", "ci.json", "--ticks", "10000",
+                          "--fast", "--report", "out/perf.json"};
+    LaunchOptions options = LaunchOptions::parse(8, argv);
+    EXPECT_TRUE(options.errors.empty());
+    EXPECT_EQ(options.configPath, "ci.json");
+
+    HeadlessConfig config;
+    options.applyTo(config);
+    EXPECT_TRUE(config.enabled);            // --ticks implies --headless
+    EXPECT_EQ(config.maxTicks, 10000u);
+    EXPECT_FALSE(config.realtime);
+    EXPECT_EQ(config.reportPath, "out/perf.json");
+}
+
+TEST(LaunchOptionsTest, BadArgumentsAreReported) {
+    const char* argv[] = {"gloaming", "--bogus", "--ticks", "lots", "--config"};
+    LaunchOptions options = LaunchOptions::parse(5, argv);
+    EXPECT_EQ(options.errors.size(), 3u);
+    EXPECT_FALSE(options.ticks.has_value());
+    EXPECT_EQ(options.configPath, "config.json");
+}
+
+TEST(HeadlessReportTest, SummarizesTickTimes) {
+    HeadlessReport report;
+    for (int i = 1; i <= 100; ++i) report.recordTick(static_cast<double>(i));
+    report.finish(2.0, 100.0 / 60.0);
+
+    EXPECT_EQ(report.ticks(), 100u);
+    EXPECT_DOUBLE_EQ(report.avgTickMs(), 50.5);
+    EXPECT_DOUBLE_EQ(report.maxTickMs(), 100.0);
+    EXPECT_DOUBLE_EQ(report.percentileTickMs(50.0), 50.0);
+    EXPECT_DOUBLE_EQ(report.percentileTickMs(95.0), 95.0);
+    EXPECT_DOUBLE_EQ(report.percentileTickMs(100.0), 100.0);
+}
+
+TEST(HeadlessReportTest, WritesJson) {
+    HeadlessReport report;
+    report.recordTick(1.0);
+    report.recordTick(3.0);
+    report.finish(0.5, 2.0 / 60.0);
+
+    ProfileZoneStats zone;
+    zone.name = "Update";
+    zone.avgTimeMs = 2.0;
+    zone.sampleCount = 2;
+
+    auto path = (std::filesystem::temp_directory_path() / "gloaming_headless_report.json").string();
+    ASSERT_TRUE(report.writeJson(path, {zone}));
+
+    std::ifstream in(path);
+    nlohmann::json json = nlohmann::json::parse(in);
+    EXPECT_EQ(json["ticks"], 2);
+    EXPECT_DOUBLE_EQ(json["tick_ms"]["avg"].get<double>(), 2.0);
+    EXPECT_DOUBLE_EQ(json["ticks_per_second"].get<double>(), 4.0);
+    EXPECT_DOUBLE_EQ(json["zones"]["Update"]["avg_ms"].get<double>(), 2.0);
+    in.close();
+    std::filesystem::remove(path);
+}
@@ -4,6 +4,15 @@
 #include "ecs/Components.hpp"
 #include "ecs/Systems.hpp"
 #include "ecs/EntityFactory.hpp"
+#include "ecs/SystemGraph.hpp"
+#include "ecs/TransformInterpolation.hpp"
+#include "engine/JobSystem.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 using namespace gloaming;
 
@@ -622,3 +631,295 @@ TEST(SystemSchedulerTest, DisableSystem) {
     system.update(0.016f);
     EXPECT_EQ(system.updateCount, 2);
 }
+
+// =============================================================================
+// System Timing Tests
+// =============================================================================
+
+TEST(SystemTimingStatsTest, PercentilesFromWindow) {
+    SystemTimingStats stats;
+    for (int i = 1; i <= 100; ++i) {
+        stats.addSample(static_cast<double>(i));
+    }
+    stats.refreshPercentiles();
+
+    EXPECT_EQ(stats.sampleCount, 100u);
+    EXPECT_DOUBLE_EQ(stats.lastMs, 100.0);
+    EXPECT_DOUBLE_EQ(stats.maxMs, 100.0);
+    EXPECT_DOUBLE_EQ(stats.p50Ms, 50.0);
+    EXPECT_DOUBLE_EQ(stats.p95Ms, 95.0);
+    EXPECT_DOUBLE_EQ(stats.p99Ms, 99.0);
+}
+
+TEST(SystemTimingStatsTest, WindowForgetsOldSamples) {
+    SystemTimingStats stats;
+    for (size_t i = 0; i < SystemTimingStats::kWindowSize; ++i) stats.addSample(1.0);
+    for (size_t i = 0; i < SystemTimingStats::kWindowSize; ++i) stats.addSample(5.0);
+    stats.refreshPercentiles();
+
+    EXPECT_DOUBLE_EQ(stats.p50Ms, 5.0);
+    EXPECT_DOUBLE_EQ(stats.p99Ms, 5.0);
+}
+
+TEST(SystemTimingStatsTest, SpikesCountedAgainstMedian) {
+    SystemTimingStats stats;
+    for (int i = 0; i < 60; ++i) stats.addSample(1.0);
+    EXPECT_EQ(stats.spikeCount, 0u);
+
+    stats.addSample(2.0);   // slower, but not 3x the median
+    EXPECT_EQ(stats.spikeCount, 0u);
+
+    stats.addSample(10.0);
+    EXPECT_EQ(stats.spikeCount, 1u);
+}
+
+TEST(SystemTimingStatsTest, TinySystemsDoNotSpike) {
+    SystemTimingStats stats;
+    for (int i = 0; i < 60; ++i) stats.addSample(0.01);
+    stats.addSample(0.2);   // 20x the median but under the spike floor
+    EXPECT_EQ(stats.spikeCount, 0u);
+}
+
+TEST(SystemTimingStatsTest, FrameAccumulatorAndReset) {
+    SystemTimingStats stats;
+    stats.addSample(1.5);
+    stats.addSample(2.5);
+    EXPECT_DOUBLE_EQ(stats.frameMs, 4.0);
+
+    stats.reset();
+    EXPECT_EQ(stats.sampleCount, 0u);
+    EXPECT_DOUBLE_EQ(stats.frameMs, 0.0);
+    EXPECT_DOUBLE_EQ(stats.p95Ms, 0.0);
+}
+
+TEST(SystemTimingStatsTest, SystemStartsWithEmptyTiming) {
+    CounterSystem system;
+    EXPECT_EQ(system.getTimingStats().sampleCount, 0u);
+    EXPECT_EQ(Profiler::zoneName(Profiler::zoneId("CounterSystem")), "CounterSystem");
+}
+
+// =============================================================================
+// Parallel Scheduling Tests
+// =============================================================================
+
+TEST(SystemAccessTest, ReadersDoNotConflict) {
+    SystemAccess a, b;
+    a.reads<Transform, Sprite>();
+    b.reads<Transform>().writes<Velocity>();
+    EXPECT_FALSE(a.conflictsWith(b));
+    EXPECT_FALSE(b.conflictsWith(a));
+}
+
+TEST(SystemAccessTest, WriteConflictsWithReadAndWrite) {
+    SystemAccess writer, reader, otherWriter;
+    writer.writes<Transform>();
+    reader.reads<Transform>();
+    otherWriter.writes<Transform>();
+    EXPECT_TRUE(writer.conflictsWith(reader));
+    EXPECT_TRUE(reader.conflictsWith(writer));
+    EXPECT_TRUE(writer.conflictsWith(otherWriter));
+}
+
+TEST(SystemAccessTest, EntityWritersConflictWithEverything) {
+    SystemAccess spawner, unrelated;
+    spawner.writes<Lifetime, resource::Entities>();
+    unrelated.reads<resource::Camera>();
+    EXPECT_TRUE(spawner.conflictsWith(unrelated));
+    EXPECT_TRUE(unrelated.conflictsWith(spawner));
+}
+
+TEST(SystemAccessTest, PreparePoolsCreatesStorage) {
+    Registry registry;
+    SystemAccess access;
+    access.reads<LightSource, resource::TileMap>();
+    const auto& raw = std::as_const(registry.raw());
+    EXPECT_EQ(raw.storage<LightSource>(), nullptr);
+    access.preparePools(registry);
+    EXPECT_NE(raw.storage<LightSource>(), nullptr);
+}
+
+TEST(SystemGraphTest, UndeclaredSystemIsBarrier) {
+    SystemAccess a, b;
+    a.reads<Transform>();
+    b.reads<Sprite>();
+
+    SystemGraph graph;
+    graph.build({&a, nullptr, &b});
+    EXPECT_TRUE(graph.dependsOn(1, 0));
+    EXPECT_TRUE(graph.dependsOn(2, 1));
+    EXPECT_FALSE(graph.dependsOn(2, 0));   // ordered through the barrier
+}
+
+TEST(SystemGraphTest, DisjointSystemsHaveNoEdge) {
+    SystemAccess a, b, c;
+    a.writes<Transform>();
+    b.writes<Sprite>();
+    c.reads<Transform>();
+
+    SystemGraph graph;
+    graph.build({&a, &b, &c});
+    EXPECT_FALSE(graph.dependsOn(1, 0));
+    EXPECT_TRUE(graph.dependsOn(2, 0));
+    EXPECT_FALSE(graph.dependsOn(2, 1));
+    EXPECT_TRUE(graph.hasParallelism());
+}
+
+TEST(SystemGraphTest, FullyConflictingGraphIsSerial) {
+    SystemGraph graph;
+    graph.build({nullptr, nullptr, nullptr});
+    EXPECT_FALSE(graph.hasParallelism());
+}
+
+TEST(SystemGraphTest, ExecuteRespectsDependencies) {
+    SystemAccess writer, reader, independent, mainOnly;
+    writer.writes<Transform>();
+    reader.reads<Transform>();
+    independent.writes<Sprite>();
+    mainOnly.reads<resource::Camera>().mainThread();
+
+    SystemGraph graph;
+    graph.build({&writer, &independent, &reader, &mainOnly, nullptr});
+
+    JobSystem jobs;
+    jobs.start(3);
+
+    const std::thread::id caller = std::this_thread::get_id();
+    for (int run = 0; run < 50; ++run) {
+        std::mutex mutex;
+        std::vector<size_t> order;
+        std::vector<std::thread::id> threads(5);
+
+        graph.execute(jobs, [&](size_t node) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(node);
+            threads[node] = std::this_thread::get_id();
+        });
+
+        ASSERT_EQ(order.size(), 5u);
+        auto pos = [&](size_t node) {
+            return std::find(order.begin(), order.end(), node) - order.begin();
+        };
+        EXPECT_LT(pos(0), pos(2));         // reader after writer
+        EXPECT_EQ(order.back(), 4u);       // undeclared barrier runs last
+        EXPECT_EQ(threads[3], caller);     // main-thread node stays on the caller
+        EXPECT_EQ(threads[4], caller);
+    }
+    jobs.stop();
+}
+
+TEST(SystemGraphTest, ExecuteWithoutWorkersRunsInline) {
+    SystemAccess a, b;
+    a.writes<Transform>();
+    b.writes<Sprite>();
+
+    SystemGraph graph;
+    graph.build({&a, &b});
+
+    JobSystem jobs;   // not started
+    std::vector<size_t> order;
+    graph.execute(jobs, [&](size_t node) { order.push_back(node); });
+    EXPECT_EQ(order, (std::vector<size_t>{0, 1}));
+}
+
+TEST(JobSystemTest, SubmitWithoutWorkersRunsImmediately) {
+    JobSystem jobs;
+    int value = 0;
+    jobs.submit([&]() { value = 7; });
+    EXPECT_EQ(value, 7);
+    EXPECT_FALSE(jobs.tryRunOne());
+}
+
+TEST(JobSystemTest, ParallelForCoversRangeOnce) {
+    JobSystem jobs;
+    jobs.start(4);
+    EXPECT_EQ(jobs.workerCount(), 4u);
+
+    std::vector<std::atomic<int>> hits(10007);
+    jobs.parallelFor(hits.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) hits[i].fetch_add(1);
+    });
+    for (const auto& h : hits) {
+        ASSERT_EQ(h.load(), 1);
+    }
+    jobs.stop();
+    EXPECT_FALSE(jobs.isRunning());
+}
+
+TEST(JobSystemTest, StopDrainsQueuedJobs) {
+    JobSystem jobs;
+    jobs.start(2);
+    std::atomic<int> done{0};
+    for (int i = 0; i < 200; ++i) {
+        jobs.submit([&]() { done.fetch_add(1); });
+    }
+    jobs.stop();
+    EXPECT_EQ(done.load(), 200);
+}
+
+// =============================================================================
+// Transform Interpolation Tests
+// =============================================================================
+
+class TransformInterpolationTest : public ::testing::Test {
+protected:
+    Registry registry;
+    TransformInterpolator interpolator;
+
+    Entity makeSprite(Vec2 position) {
+        Entity e = registry.create();
+        registry.add<Transform>(e, position);
+        registry.add<Sprite>(e);
+        return e;
+    }
+};
+
+TEST_F(TransformInterpolationTest, ApplyLerpsBetweenTicksAndRestoreUndoes) {
+    Entity e = makeSprite({0.0f, 0.0f});
+
+    interpolator.beginTick(registry);
+    registry.get<Transform>(e).position = {10.0f, 20.0f};
+
+    interpolator.apply(registry, 0.25f);
+    EXPECT_FLOAT_EQ(registry.get<Transform>(e).position.x, 2.5f);
+    EXPECT_FLOAT_EQ(registry.get<Transform>(e).position.y, 5.0f);
+
+    interpolator.restore(registry);
+    EXPECT_FLOAT_EQ(registry.get<Transform>(e).position.x, 10.0f);
+    EXPECT_FLOAT_EQ(registry.get<Transform>(e).position.y, 20.0f);
+}
+
+TEST_F(TransformInterpolationTest, NewEntitiesAndNonSpritesAreNotMoved) {
+    Entity fresh = makeSprite({5.0f, 5.0f});
+    Entity plain = registry.create();
+    registry.add<Transform>(plain, Vec2{1.0f, 1.0f});
+
+    interpolator.beginTick(registry);
+    Entity spawned = makeSprite({50.0f, 50.0f});   // Created during the tick
+    registry.get<Transform>(plain).position = {3.0f, 3.0f};
+
+    interpolator.apply(registry, 0.5f);
+    EXPECT_FLOAT_EQ(registry.get<Transform>(fresh).position.x, 5.0f);
+    EXPECT_FLOAT_EQ(registry.get<Transform>(spawned).position.x, 50.0f);
+    EXPECT_FLOAT_EQ(registry.get<Transform>(plain).position.x, 3.0f);
+    EXPECT_FALSE(registry.has<TransformHistory>(plain));
+    interpolator.restore(registry);
+}
+
+TEST_F(TransformInterpolationTest, TeleportsSnap) {
+    interpolator.setSnapDistance(100.0f);
+    Entity e = makeSprite({0.0f, 0.0f});
+
+    interpolator.beginTick(registry);
+    registry.get<Transform>(e).position = {500.0f, 0.0f};
+
+    interpolator.apply(registry, 0.5f);
+    EXPECT_FLOAT_EQ(registry.get<Transform>(e).position.x, 500.0f);
+    interpolator.restore(registry);
+    EXPECT_FLOAT_EQ(registry.get<Transform>(e).position.x, 500.0f);
+}
+
+TEST_F(TransformInterpolationTest, RotationTakesShortestArc) {
+    EXPECT_FLOAT_EQ(TransformInterpolator::lerpAngle(350.0f, 10.0f, 0.5f), 360.0f);
+    EXPECT_FLOAT_EQ(TransformInterpolator::lerpAngle(10.0f, 350.0f, 0.5f), 0.0f);
+    EXPECT_FLOAT_EQ(TransformInterpolator::lerpAngle(0.0f, 90.0f, 0.5f), 45.0f);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "gameplay/EnemyAI.hpp"
+#include "gameplay/AILod.hpp"
 #include "gameplay/EnemyAISystem.hpp"
 #include "gameplay/EnemySpawnSystem.hpp"
 #include "gameplay/LootDropSystem.hpp"
@@ -9,6 +10,8 @@
 #include "ecs/Components.hpp"
 #include "mod/ContentRegistry.hpp"
 
+#include <sstream>
+
 using namespace gloaming;
 
 // =============================================================================
@@ -115,7 +118,7 @@ TEST(EnemyAIIntegrationTest, AddComponentToEntity) {
     Entity entity = registry.create(
         Transform{Vec2(100.0f, 200.0f)},
         Name{"slime", "base:slime"},
-        EnemyTag{"base:slime"}
+        EnemyTag{}
     );
 
     EnemyAI ai("patrol_walk");
@@ -210,6 +213,137 @@ TEST(EnemyAISystemTest, BuiltInBehaviorsNotRegistered) {
     EXPECT_FALSE(system.hasBehavior("chase"));
 }
 
+TEST(EnemyAISystemTest, CustomBehaviorCanReplaceBuiltIn) {
+    EnemyAISystem system;
+    system.registerBehavior("chase", [](Entity, EnemyAI&, float) {});
+    EXPECT_TRUE(system.hasBehavior("chase"));
+    EXPECT_FALSE(system.hasBehavior("flee"));
+    EXPECT_EQ(system.lastBatchSize(AIBehavior::Chase), 0u);
+}
+
+// =============================================================================
+// AIBehaviorId Tests
+// =============================================================================
+
+TEST(AIBehaviorIdTest, DefaultIdIsNamedIdle) {
+    // Default and BuiltinAIBehavior construction must seed the names too,
+    // not only interning a string
+    EnemyAI ai;
+    EXPECT_TRUE(ai.behavior == "idle");
+    EXPECT_EQ(ai.behavior.name(), "idle");
+    EXPECT_EQ(AIBehaviorId(BuiltinAIBehavior::Flee).name(), "flee");
+}
+
+TEST(AIBehaviorIdTest, BuiltInNamesHaveFixedIds) {
+    EXPECT_EQ(AIBehaviorId(AIBehavior::Idle).id(), static_cast<uint32_t>(BuiltinAIBehavior::Idle));
+    EXPECT_EQ(AIBehaviorId("chase").id(), static_cast<uint32_t>(BuiltinAIBehavior::Chase));
+    EXPECT_EQ(AIBehaviorId(std::string("strafe_run")).builtin(), BuiltinAIBehavior::StrafeRun);
+    EXPECT_EQ(AIBehaviorId("custom").builtin(), BuiltinAIBehavior::Custom);
+    EXPECT_TRUE(AIBehaviorId(AIBehavior::Orbit).isBuiltin());
+}
+
+TEST(AIBehaviorIdTest, ModNamesGetStableIdsAfterBuiltIns) {
+    AIBehaviorId a("test_swoop");
+    AIBehaviorId b(std::string("test_swoop"));
+    EXPECT_FALSE(a.isBuiltin());
+    EXPECT_GE(a.id(), static_cast<uint32_t>(BuiltinAIBehavior::Count));
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.name(), "test_swoop");
+    EXPECT_NE(a, AIBehaviorId("test_dive"));
+}
+
+TEST(AIBehaviorIdTest, AssignAndCompareByName) {
+    EnemyAI ai;
+    EXPECT_EQ(ai.behavior, BuiltinAIBehavior::Idle);
+
+    ai.behavior = AIBehavior::Guard;
+    EXPECT_EQ(ai.behavior, "guard");
+    EXPECT_EQ(ai.behavior, std::string("guard"));
+    EXPECT_EQ(ai.behavior, BuiltinAIBehavior::Guard);
+    EXPECT_FALSE(ai.behavior == "chase");
+
+    std::ostringstream out;
+    out << ai.behavior;
+    EXPECT_EQ(out.str(), "guard");
+}
+
+// =============================================================================
+// AI Level-of-Detail Tests
+// =============================================================================
+
+TEST(AILodSchedulerTest, TiersByDistanceToNearestReference) {
+    AILodScheduler lod;
+    lod.beginFrame();
+    EXPECT_EQ(lod.tierFor(Vec2(99999.0f, 0.0f)), AILodTier::Near);  // no references yet
+
+    lod.addReferencePoint(Vec2(0.0f, 0.0f));
+    lod.addReferencePoint(Vec2(5000.0f, 0.0f));
+    EXPECT_EQ(lod.tierFor(Vec2(100.0f, 0.0f)), AILodTier::Near);
+    EXPECT_EQ(lod.tierFor(Vec2(1000.0f, 0.0f)), AILodTier::Mid);
+    EXPECT_EQ(lod.tierFor(Vec2(2500.0f, 0.0f)), AILodTier::Far);
+    EXPECT_EQ(lod.tierFor(Vec2(4900.0f, 0.0f)), AILodTier::Near);  // near the second point
+}
+
+TEST(AILodSchedulerTest, FarAgentRunsOncePerIntervalWithAccumulatedDt) {
+    AILodScheduler lod;
+    AILodState state;
+    Entity agent = static_cast<Entity>(7);
+
+    int runs = 0;
+    float total = 0.0f;
+    for (int frame = 0; frame < 32; ++frame) {
+        lod.beginFrame();
+        lod.addReferencePoint(Vec2(0.0f, 0.0f));
+        float step = 0.0f;
+        if (lod.shouldUpdate(agent, Vec2(5000.0f, 0.0f), state, 0.01f, step)) {
+            // The first run comes early (stagger phase); after that, one full interval
+            if (runs > 0) EXPECT_NEAR(step, 0.16f, 1e-4f);
+            ++runs;
+            total += step;
+        }
+    }
+    EXPECT_EQ(runs, 2);
+    EXPECT_NEAR(total + state.pendingDt, 0.32f, 1e-4f);
+    EXPECT_EQ(state.tier, AILodTier::Far);
+}
+
+TEST(AILodSchedulerTest, TierWorkIsSpreadAcrossFrames) {
+    AILodScheduler lod;
+    std::vector<AILodState> states(160);
+
+    for (int frame = 0; frame < 16; ++frame) {
+        lod.beginFrame();
+        lod.addReferencePoint(Vec2(0.0f, 0.0f));
+        for (uint32_t i = 0; i < states.size(); ++i) {
+            float step = 0.0f;
+            lod.shouldUpdate(static_cast<Entity>(i), Vec2(0.0f, 5000.0f), states[i], 0.016f, step);
+        }
+        // 160 far agents at interval 16: the same share runs every frame
+        EXPECT_EQ(lod.updatedCount(AILodTier::Far), 10u);
+        EXPECT_EQ(lod.skippedCount(), 150u);
+    }
+}
+
+TEST(AILodSchedulerTest, NearAndDisabledAlwaysRun) {
+    AILodScheduler lod;
+    AILodState nearState;
+    float step = 0.0f;
+    lod.beginFrame();
+    lod.addReferencePoint(Vec2(0.0f, 0.0f));
+    EXPECT_TRUE(lod.shouldUpdate(static_cast<Entity>(3), Vec2(10.0f, 0.0f), nearState, 0.016f, step));
+    EXPECT_FLOAT_EQ(step, 0.016f);
+
+    AILodConfig config;
+    config.enabled = false;
+    lod.setConfig(config);
+    AILodState farState;
+    for (int frame = 0; frame < 4; ++frame) {
+        lod.beginFrame();
+        lod.addReferencePoint(Vec2(0.0f, 0.0f));
+        EXPECT_TRUE(lod.shouldUpdate(static_cast<Entity>(3), Vec2(9000.0f, 0.0f), farState, 0.016f, step));
+    }
+}
+
 // =============================================================================
 // EnemyDefinition AI Fields Tests
 // =============================================================================
@@ -326,7 +460,7 @@ TEST(EnemyEntityTest, MultipleEnemiesWithDifferentBehaviors) {
     // Create a side-view enemy
     Entity patrol = registry.create(
         Transform{Vec2(100.0f, 300.0f)},
-        EnemyTag{"base:slime"}
+        EnemyTag{}
     );
     registry.add<Health>(patrol, 50.0f, 50.0f);
     registry.add<Velocity>(patrol);
@@ -335,7 +469,7 @@ TEST(EnemyEntityTest, MultipleEnemiesWithDifferentBehaviors) {
     // Create a flying enemy
     Entity flyer = registry.create(
         Transform{Vec2(200.0f, 100.0f)},
-        EnemyTag{"base:bat"}
+        EnemyTag{}
     );
     registry.add<Health>(flyer, 30.0f, 30.0f);
     registry.add<Velocity>(flyer);
@@ -344,7 +478,7 @@ TEST(EnemyEntityTest, MultipleEnemiesWithDifferentBehaviors) {
     // Create a top-down enemy
     Entity guard = registry.create(
         Transform{Vec2(400.0f, 400.0f)},
-        EnemyTag{"base:guard"}
+        EnemyTag{}
     );
     registry.add<Health>(guard, 100.0f, 100.0f);
     registry.add<Velocity>(guard);
@@ -370,7 +504,7 @@ TEST(EnemyDeathTest, DeathDetectedByHealthCheck) {
 
     Entity enemy = registry.create(
         Transform{Vec2(100.0f, 200.0f)},
-        EnemyTag{"base:slime"},
+        EnemyTag{},
         Name{"slime", "base:slime"}
     );
     registry.add<Health>(enemy, 50.0f, 50.0f);
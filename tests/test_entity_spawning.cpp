@@ -6,6 +6,10 @@
 #include "ecs/Registry.hpp"
 #include "ecs/Components.hpp"
 #include "ecs/EntityFactory.hpp"
+#include "engine/Engine.hpp"
+#include "gameplay/LuaComponentViews.hpp"
+
+#include <limits>
 
 using namespace gloaming;
 
@@ -386,6 +390,114 @@ TEST(SpatialQueryTest, FindNearestNoResult) {
     EXPECT_EQ(result.entity, NullEntity);
 }
 
+TEST(SpatialQueryTest, IndexedQueriesMatchScan) {
+    Registry registry;
+    EntitySpawning scan;
+    scan.setRegistry(&registry);
+
+    SpatialIndex index(64.0f);
+    EntitySpawning indexed;
+    indexed.setRegistry(&registry);
+    indexed.setSpatialIndex(&index);
+
+    const char* types[] = {"enemy", "npc", "entity"};
+    for (int i = 0; i < 400; ++i) {
+        float x = static_cast<float>((i * 37) % 1000);
+        float y = static_cast<float>((i * 53) % 700);
+        Entity e = scan.create(x, y);
+        registry.get<Name>(e).type = types[i % 3];
+        if (i % 2 == 0) {
+            Collider collider;
+            collider.layer = (i % 4 == 0) ? CollisionLayer::Enemy : CollisionLayer::NPC;
+            registry.add<Collider>(e, collider);
+        }
+        if (i % 5 == 0) {
+            Health health(10.0f);
+            if (i % 10 == 0) health.current = 0.0f;
+            registry.add<Health>(e, health);
+        }
+    }
+    index.sync(registry);
+
+    // Created after the sync, and retyped: still found
+    Entity late = indexed.create(500.0f, 350.0f);
+    registry.get<Name>(late).type = "enemy";
+    index.sync(registry);
+    Entity later = indexed.create(505.0f, 350.0f);
+
+    std::vector<EntityQueryFilter> filters(4);
+    filters[1].type = "enemy";
+    filters[2].requiredLayer = CollisionLayer::Enemy;
+    filters[3].excludeDead = false;
+    filters[3].type = "npc";
+
+    for (const auto& filter : filters) {
+        for (float radius : {0.0f, 40.0f, 150.0f, 2000.0f}) {
+            auto expected = scan.findInRadius(500.0f, 350.0f, radius, filter);
+            auto got = indexed.findInRadius(500.0f, 350.0f, radius, filter);
+            ASSERT_EQ(got.size(), expected.size()) << filter.type << " r=" << radius;
+            for (size_t i = 0; i < got.size(); ++i) {
+                EXPECT_FLOAT_EQ(got[i].distance, expected[i].distance);
+            }
+
+            auto nearestExpected = scan.findNearest(310.0f, 120.0f, radius, filter);
+            auto nearestGot = indexed.findNearest(310.0f, 120.0f, radius, filter);
+            EXPECT_EQ(nearestGot.entity == NullEntity, nearestExpected.entity == NullEntity);
+            EXPECT_FLOAT_EQ(nearestGot.distance, nearestExpected.distance);
+        }
+    }
+
+    auto nearby = indexed.findInRadius(500.0f, 350.0f, 10.0f);
+    ASSERT_GE(nearby.size(), 2u);
+    EXPECT_EQ(nearby[0].entity, late);
+    EXPECT_EQ(nearby[1].entity, later);
+
+    EntityQueryFilter unknown;
+    unknown.type = "dragon";
+    EXPECT_TRUE(indexed.findInRadius(500.0f, 350.0f, 2000.0f, unknown).empty());
+}
+
+TEST(SpatialQueryTest, IndexFollowsChangesSinceSync) {
+    Registry registry;
+    SpatialIndex index(64.0f);
+    EntitySpawning spawning;
+    spawning.setRegistry(&registry);
+    spawning.setSpatialIndex(&index);
+
+    Entity mover = spawning.create(1000.0f, 1000.0f);
+    Entity stayer = spawning.create(20.0f, 0.0f);
+    index.sync(registry);
+
+    // Moved in place after the sync (as a system would), then touched
+    registry.get<Transform>(mover).position = Vec2(5.0f, 0.0f);
+    registry.touch();
+    auto nearest = spawning.findNearest(0.0f, 0.0f, 50.0f);
+    EXPECT_EQ(nearest.entity, mover);
+
+    // Spawned directly through the registry
+    Entity spawned = registry.create(Transform{Vec2(1.0f, 0.0f)}, Name{"entity"});
+    EXPECT_EQ(spawning.findNearest(0.0f, 0.0f, 50.0f).entity, spawned);
+
+    // Retyped with a fresh Name, to a type the index has interned...
+    registry.addOrReplace<Name>(stayer, "stayer", "enemy");
+    EntityQueryFilter enemies;
+    enemies.type = "enemy";
+    auto found = spawning.findInRadius(0.0f, 0.0f, 50.0f, enemies);
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0].entity, stayer);
+
+    // ...or, edited in place without a touch, to one it has not: scanned
+    registry.get<Name>(mover).type = "boss";
+    EntityQueryFilter bosses;
+    bosses.type = "boss";
+    EXPECT_EQ(spawning.findNearest(0.0f, 0.0f, 50.0f, bosses).entity, mover);
+
+    // Unbounded radii don't overflow the ring count
+    EXPECT_EQ(spawning.findNearest(0.0f, 0.0f, std::numeric_limits<float>::max()).entity, spawned);
+    EXPECT_EQ(spawning.findNearest(0.0f, 0.0f, std::numeric_limits<float>::infinity()).entity, spawned);
+    EXPECT_EQ(spawning.findNearest(0.0f, 0.0f, std::numeric_limits<float>::quiet_NaN()).entity, NullEntity);
+}
+
 TEST(SpatialQueryTest, CountByType) {
     Registry registry;
     EntitySpawning spawning;
@@ -772,6 +884,97 @@ TEST(ProjectileIntegrationTest, CollisionLayerFiltering) {
     EXPECT_FALSE((playerCol.layer & hitMask) != 0);
 }
 
+// =============================================================================
+// ProjectileSystem Update Tests
+// =============================================================================
+
+namespace {
+
+Entity makeTestProjectile(Registry& registry, Vec2 position, Vec2 velocity, int pierce) {
+    Collider collider;
+    collider.size = Vec2(4, 4);
+    collider.layer = CollisionLayer::Projectile;
+    collider.mask = CollisionLayer::None;
+
+    Projectile proj;
+    proj.hitMask = CollisionLayer::Enemy;
+    proj.pierce = pierce;
+    proj.damage = 10.0f;
+    return registry.create(Transform{position}, Velocity{velocity}, collider, proj);
+}
+
+Entity makeTestTarget(Registry& registry, Vec2 position, Vec2 size,
+                      uint32_t layer = CollisionLayer::Enemy) {
+    Collider collider;
+    collider.size = size;
+    collider.layer = layer;
+    return registry.create(Transform{position}, collider, Health{100.0f});
+}
+
+} // namespace
+
+TEST(ProjectileSystemUpdateTest, FastProjectileHitsThinTarget) {
+    Registry registry;
+    Engine engine;
+    ProjectileSystem system;
+    system.init(registry, engine);
+
+    // Moves 100px per 60Hz frame; the target sits between last frame's
+    // position and this one, so an end-position overlap test would miss it
+    Entity proj = makeTestProjectile(registry, Vec2(200, 50), Vec2(6000, 0), 0);
+    Entity wall = makeTestTarget(registry, Vec2(150, 50), Vec2(2, 32));
+
+    system.update(1.0f / 60.0f);
+
+    EXPECT_FLOAT_EQ(registry.get<Health>(wall).current, 90.0f);
+    EXPECT_FALSE(registry.valid(proj));
+}
+
+TEST(ProjectileSystemUpdateTest, HitsResolvedInTravelOrder) {
+    Registry registry;
+    Engine engine;
+    ProjectileSystem system;
+    system.init(registry, engine);
+
+    Entity proj = makeTestProjectile(registry, Vec2(200, 50), Vec2(6000, 0), 0);
+    Entity far = makeTestTarget(registry, Vec2(200, 50), Vec2(16, 16));
+    Entity near = makeTestTarget(registry, Vec2(130, 50), Vec2(16, 16));
+
+    std::vector<Entity> hits;
+    system.getCallbacks().registerOnHit(proj, [&](const ProjectileHitInfo& info) {
+        hits.push_back(info.target);
+    });
+
+    system.update(1.0f / 60.0f);
+
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0], near);
+    EXPECT_FLOAT_EQ(registry.get<Health>(near).current, 90.0f);
+    EXPECT_FLOAT_EQ(registry.get<Health>(far).current, 100.0f);
+}
+
+TEST(ProjectileSystemUpdateTest, SkipsOwnerAndOtherLayers) {
+    Registry registry;
+    Engine engine;
+    ProjectileSystem system;
+    system.init(registry, engine);
+
+    Entity owner = makeTestTarget(registry, Vec2(100, 50), Vec2(16, 16));
+    Entity player = makeTestTarget(registry, Vec2(100, 50), Vec2(16, 16), CollisionLayer::Player);
+    Entity proj = makeTestProjectile(registry, Vec2(100, 50), Vec2(0, 0), -1);
+    registry.get<Projectile>(proj).ownerEntity = static_cast<uint32_t>(owner);
+    Entity enemy = makeTestTarget(registry, Vec2(104, 50), Vec2(16, 16));
+
+    system.update(1.0f / 60.0f);
+    system.update(1.0f / 60.0f);
+
+    EXPECT_FLOAT_EQ(registry.get<Health>(owner).current, 100.0f);
+    EXPECT_FLOAT_EQ(registry.get<Health>(player).current, 100.0f);
+    // Piercing projectiles damage each target once
+    EXPECT_FLOAT_EQ(registry.get<Health>(enemy).current, 90.0f);
+    EXPECT_TRUE(registry.valid(proj));
+}
+
 // =============================================================================
 // ProjectileHitInfo Tests
 // =============================================================================
@@ -925,3 +1128,111 @@ TEST(ProjectileSpawnTest, AngleToVelocity) {
     EXPECT_NEAR(vx, expected, 0.01f);
     EXPECT_NEAR(vy, expected, 0.01f);
 }
+
+// =============================================================================
+// Lua Component View Tests
+// =============================================================================
+
+class LuaComponentViewTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        lua.open_libraries(sol::lib::base, sol::lib::math);
+        sol::table entityApi = lua.create_named_table("entity");
+        bindComponentViews(lua, entityApi, registry);
+        lua["destroy"] = [this](uint32_t id) { registry.destroy(static_cast<Entity>(id)); };
+    }
+
+    bool run(const std::string& code) {
+        auto result = lua.safe_script(code, sol::script_pass_on_error);
+        if (!result.valid()) {
+            sol::error err = result;
+            lastError = err.what();
+        }
+        return result.valid();
+    }
+
+    Registry registry;
+    sol::state lua;
+    std::string lastError;
+};
+
+TEST_F(LuaComponentViewTest, RefWritesThroughToStorage) {
+    Entity e = registry.create(Transform{Vec2(1.0f, 2.0f)}, Velocity{3.0f, 4.0f});
+    lua["id"] = static_cast<uint32_t>(e);
+
+    ASSERT_TRUE(run(R"(
+        local t = entity.ref(id, "transform")
+        assert(t.x == 1 and t.y == 2 and t.entity == id and t.valid)
+        t.x = t.x + 10
+        entity.ref(id, "velocity").angular = 90
+        assert(entity.ref(id, "health") == nil)
+    )")) << lastError;
+
+    EXPECT_FLOAT_EQ(registry.get<Transform>(e).position.x, 11.0f);
+    EXPECT_FLOAT_EQ(registry.get<Velocity>(e).angular, 90.0f);
+}
+
+TEST_F(LuaComponentViewTest, StaleRefRaisesAfterDestroy) {
+    Entity e = registry.create(Transform{});
+    lua["id"] = static_cast<uint32_t>(e);
+    ASSERT_TRUE(run("held = entity.ref(id, 'transform')"));
+
+    registry.destroy(e);
+    Entity recycled = registry.create(Transform{});   // May reuse the slot
+    (void)recycled;
+
+    EXPECT_TRUE(run("assert(held.valid == false)"));
+    EXPECT_FALSE(run("local x = held.x"));
+    EXPECT_NE(lastError.find("stale"), std::string::npos);
+    EXPECT_FALSE(run("held.x = 5"));
+}
+
+TEST_F(LuaComponentViewTest, EachVisitsEntitiesWithAllComponents) {
+    for (int i = 0; i < 10; ++i) {
+        Entity e = registry.create(Transform{Vec2(static_cast<float>(i), 0.0f)});
+        if (i % 2 == 0) registry.add<Velocity>(e, 1.0f, 2.0f);
+    }
+
+    ASSERT_TRUE(run(R"(
+        visited = entity.each({"transform", "velocity"}, function(id, t, v)
+            t.x = t.x + v.x
+            t.y = t.y + v.y
+        end)
+    )")) << lastError;
+    EXPECT_EQ(lua.get<int>("visited"), 5);
+
+    registry.view<Transform>().each([&](Entity e, const Transform& t) {
+        bool moving = registry.has<Velocity>(e);
+        EXPECT_FLOAT_EQ(t.position.y, moving ? 2.0f : 0.0f);
+    });
+}
+
+TEST_F(LuaComponentViewTest, EachStopsEarlyAndSurvivesDestroy) {
+    for (int i = 0; i < 8; ++i) {
+        registry.create(Transform{}, Health{10.0f});
+    }
+
+    ASSERT_TRUE(run(R"(
+        visited = entity.each({"health"}, function(id, h) return false end)
+    )")) << lastError;
+    EXPECT_EQ(lua.get<int>("visited"), 1);
+
+    // Entities destroyed mid-iteration are skipped instead of touching freed slots
+    ASSERT_TRUE(run(R"(
+        local ids = {}
+        entity.each({"health"}, function(id) ids[#ids + 1] = id end)
+        local seen = 0
+        entity.each({"health", "transform"}, function(id, h, t)
+            seen = seen + 1
+            for _, other in ipairs(ids) do destroy(other) end
+        end)
+        assert(#ids == 8 and seen == 1)
+    )")) << lastError;
+    EXPECT_EQ(registry.count<Health>(), 0u);
+}
+
+TEST_F(LuaComponentViewTest, EachRejectsUnknownComponent) {
+    EXPECT_FALSE(run("entity.each({'transform', 'nonsense'}, function() end)"));
+    EXPECT_NE(lastError.find("nonsense"), std::string::npos);
+}
+
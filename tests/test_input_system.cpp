@@ -1,12 +1,17 @@
 #include <gtest/gtest.h>
 
+#include "engine/FixedTimestep.hpp"
 #include "engine/Gamepad.hpp"
+#include "engine/Input.hpp"
+#include "engine/InputEdgeLatch.hpp"
 #include "engine/InputDeviceTracker.hpp"
 #include "engine/InputGlyphs.hpp"
 #include "engine/Haptics.hpp"
 #include "gameplay/InputActions.hpp"
 #include "ui/OnScreenKeyboard.hpp"
 
+#include <utility>
+
 using namespace gloaming;
 
 // ============================================================================
@@ -588,6 +593,77 @@ TEST(AxisEdgeDetectionTest, GetActionValueWithDeadzone) {
     EXPECT_FLOAT_EQ(val, 0.0f);
 }
 
+// ============================================================================
+// Per-tick Edge Latch Tests (InputEdgeLatch)
+// ============================================================================
+
+TEST(InputEdgeLatchTest, EachEdgeReachesExactlyOneTick) {
+    // Mirrors Engine::update: poll once per frame, then run that frame's
+    // ticks, clearing the latch after each. Power-of-two rates keep the
+    // accumulator exact.
+    FixedTimestepConfig config;
+    config.enabled = true;
+    config.tickRate = 64.0;
+    FixedTimestep fixed;
+    fixed.setConfig(config);
+
+    InputEdgeLatch<Input::kMaxKeys> latch;
+    const int space = static_cast<int>(Key::Space);
+    auto frame = [&](double dt, bool pressed, bool released, int expectedTicks) {
+        latch.record(space, pressed, released);
+        int steps = fixed.advance(dt);
+        EXPECT_EQ(steps, expectedTicks);
+        int pressedTicks = 0;
+        int releasedTicks = 0;
+        for (int i = 0; i < steps; ++i) {
+            if (latch.pressed(space)) ++pressedTicks;
+            if (latch.released(space)) ++releasedTicks;
+            latch.clear();
+        }
+        return std::make_pair(pressedTicks, releasedTicks);
+    };
+
+    // Pressed on a frame that runs no tick: the next frame's tick sees it
+    EXPECT_EQ(frame(1.0 / 128.0, true, false, 0), std::make_pair(0, 0));
+    EXPECT_EQ(frame(1.0 / 128.0, false, false, 1), std::make_pair(1, 0));
+
+    // Released on a frame that runs two ticks: only the first sees it
+    EXPECT_EQ(frame(2.0 / 64.0, false, true, 2), std::make_pair(0, 1));
+
+    // Tapped within one tickless frame: both edges still arrive
+    EXPECT_EQ(frame(1.0 / 128.0, true, true, 0), std::make_pair(0, 0));
+    EXPECT_EQ(frame(1.0 / 128.0, false, false, 1), std::make_pair(1, 1));
+
+    // Nothing left over
+    EXPECT_EQ(frame(1.0 / 64.0, false, false, 1), std::make_pair(0, 0));
+}
+
+TEST(InputEdgeLatchTest, OutOfRangeCodesIgnored) {
+    InputEdgeLatch<8> latch;
+    latch.record(-1, true, true);
+    latch.record(8, true, true);
+    EXPECT_FALSE(latch.pressed(-1));
+    EXPECT_FALSE(latch.pressed(8));
+    EXPECT_FALSE(latch.released(8));
+}
+
+TEST(InputEdgeLatchTest, InputReadsLatchOnlyInsideTick) {
+    Input input;
+    input.beginTick();
+    EXPECT_FALSE(input.isKeyPressed(Key::Space));
+    EXPECT_FALSE(input.isMouseButtonReleased(MouseButton::Left));
+    EXPECT_FLOAT_EQ(input.getMouseWheelDelta(), 0.0f);
+    input.endTick();
+
+    Gamepad gamepad;
+    EXPECT_FALSE(gamepad.inTick());
+    gamepad.beginTick();
+    EXPECT_TRUE(gamepad.inTick());
+    EXPECT_FALSE(gamepad.isButtonPressed(GamepadButton::FaceDown));
+    gamepad.endTick();
+    EXPECT_FALSE(gamepad.inTick());
+}
+
 // ============================================================================
 // GamepadButton and GamepadAxis Enum Tests
 // ============================================================================
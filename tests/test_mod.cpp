@@ -4,6 +4,8 @@
 #include "mod/EventBus.hpp"
 #include "mod/ContentRegistry.hpp"
 #include "mod/HotReload.hpp"
+#include "mod/BytecodeCache.hpp"
+#include "mod/LuaCpuBudget.hpp"
 #include "mod/LuaBindings.hpp"
 #include "mod/ModLoader.hpp"
 #include "engine/Engine.hpp"
@@ -11,6 +13,7 @@
 #include <nlohmann/json.hpp>
 #include <filesystem>
 #include <fstream>
+#include <thread>
 
 using namespace gloaming;
 namespace fs = std::filesystem;
@@ -725,6 +728,77 @@ TEST(ContentRegistry, GetIdLists) {
     EXPECT_EQ(itemIds.size(), 1u);
 }
 
+TEST(ContentRegistry, EveryTypeGetsDenseRuntimeIds) {
+    ContentRegistry registry;
+
+    ItemDefinition sword, pick;
+    sword.id = "sword"; sword.qualifiedId = "base:sword";
+    pick.id = "pick";   pick.qualifiedId = "base:pick";
+    EXPECT_EQ(registry.registerItem(sword), 1u);
+    EXPECT_EQ(registry.registerItem(pick), 2u);
+
+    EnemyDefinition slime;
+    slime.id = "slime"; slime.qualifiedId = "base:slime";
+    EXPECT_EQ(registry.registerEnemy(slime), 1u);  // Separate ID space per type
+
+    ShopDefinition shop;
+    shop.id = "store"; shop.qualifiedId = "base:store";
+    EXPECT_EQ(registry.registerShop(shop), 1u);
+
+    EXPECT_EQ(registry.getItemRuntimeId("base:pick"), 2u);
+    EXPECT_EQ(registry.getItemRuntimeId("base:missing"), 0u);
+
+    const auto* byRuntime = registry.getItemByRuntime(2);
+    ASSERT_NE(byRuntime, nullptr);
+    EXPECT_EQ(byRuntime->qualifiedId, "base:pick");
+    EXPECT_EQ(byRuntime->runtimeId, 2u);
+    EXPECT_EQ(registry.getEnemyByRuntime(1)->qualifiedId, "base:slime");
+    EXPECT_EQ(registry.getItemByRuntime(0), nullptr);
+    EXPECT_EQ(registry.getItemByRuntime(3), nullptr);
+}
+
+TEST(ContentRegistry, ReRegisteringKeepsRuntimeId) {
+    ContentRegistry registry;
+
+    TileContentDef dirt, stone;
+    dirt.id = "dirt";   dirt.qualifiedId = "base:dirt";
+    stone.id = "stone"; stone.qualifiedId = "base:stone";
+    uint16_t dirtId = registry.registerTile(dirt);
+    registry.registerTile(stone);
+
+    dirt.hardness = 5.0f;
+    EXPECT_EQ(registry.registerTile(dirt), dirtId);
+    EXPECT_EQ(registry.tileCount(), 2u);
+
+    const auto* tile = registry.getTileByRuntime(dirtId);
+    ASSERT_NE(tile, nullptr);
+    EXPECT_FLOAT_EQ(tile->hardness, 5.0f);
+    EXPECT_EQ(registry.getTile("base:dirt"), tile);
+}
+
+TEST(ContentRegistry, IdsAndTablesFollowRegistrationOrder) {
+    ContentRegistry registry;
+
+    for (const char* name : {"c", "a", "b"}) {
+        RecipeDefinition recipe;
+        recipe.id = name;
+        recipe.qualifiedId = std::string("base:") + name;
+        registry.registerRecipe(recipe);
+    }
+
+    EXPECT_EQ(registry.getRecipeIds(), (std::vector<std::string>{"base:c", "base:a", "base:b"}));
+    const auto& recipes = registry.getRecipes();
+    ASSERT_EQ(recipes.size(), 3u);
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        EXPECT_EQ(recipes[i].runtimeId, i + 1);
+    }
+
+    registry.clear();
+    RecipeDefinition again;
+    again.id = "a"; again.qualifiedId = "base:a";
+    EXPECT_EQ(registry.registerRecipe(again), 1u);
+}
+
 // ============================================================================
 // EventBus Tests
 // ============================================================================
@@ -888,6 +962,252 @@ TEST(EventBus, Clear) {
     EXPECT_EQ(bus.handlerCount("b"), 0u);
 }
 
+TEST(EventBus, InternedIdsAreStable) {
+    EventId a = EventNames::intern("interned_event");
+    EventId b = EventNames::intern(std::string("interned_event"));
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(EventNames::name(a), "interned_event");
+    EXPECT_EQ(EventNames::find("never_interned_name_xyz"), EventNames::kInvalid);
+}
+
+TEST(EventBus, EmitById) {
+    EventBus bus;
+    const EventId hit = EventBus::intern("hit_by_id");
+    const EventKey damage = EventNames::intern("damage");
+    float captured = 0.0f;
+
+    bus.on(hit, [&](const EventData& data) -> bool {
+        captured = data.getFloat(damage);
+        return false;
+    });
+
+    EventData data;
+    data.setFloat(damage, 12.5f);
+    bus.emit(hit, data);
+    EXPECT_FLOAT_EQ(captured, 12.5f);
+
+    // Name- and ID-based APIs address the same handler list
+    EXPECT_EQ(bus.handlerCount("hit_by_id"), 1u);
+    EXPECT_TRUE(bus.hasHandlers(hit));
+}
+
+TEST(EventBus, EventDataOverflow) {
+    EventData data;
+    for (int i = 0; i < 20; ++i) {
+        data.setInt("overflow_key_" + std::to_string(i), i);
+    }
+    std::string longText(300, 'x');
+    data.setString("long", longText);
+    data.setString("short", "abc");
+
+    EXPECT_EQ(data.size(), 22u);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(data.getInt("overflow_key_" + std::to_string(i)), i);
+    }
+    EXPECT_EQ(data.getString("long"), longText);
+    EXPECT_EQ(data.getStringView("short"), "abc");
+
+    // Same key may hold one value per type, as with the old map-per-type layout
+    data.setInt("short", 7);
+    EXPECT_EQ(data.getString("short"), "abc");
+    EXPECT_EQ(data.getInt("short"), 7);
+
+    // Copies own their text
+    EventData copy = data;
+    data.clear();
+    EXPECT_TRUE(data.empty());
+    EXPECT_EQ(copy.getString("long"), longText);
+}
+
+TEST(EventBus, UnsubscribeSelfDuringEmit) {
+    EventBus bus;
+    int first = 0;
+    int second = 0;
+    EventHandlerId selfId = 0;
+
+    selfId = bus.on("test", [&](const EventData&) -> bool {
+        ++first;
+        bus.off(selfId);
+        return false;
+    });
+    bus.on("test", [&](const EventData&) -> bool { ++second; return false; }, 10);
+
+    bus.emit("test");
+    bus.emit("test");
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, 2);
+    EXPECT_EQ(bus.handlerCount("test"), 1u);
+}
+
+TEST(EventBus, SubscribeDuringEmitTakesEffectNextEmit) {
+    EventBus bus;
+    int added = 0;
+    bool subscribed = false;
+
+    bus.on("test", [&](const EventData&) -> bool {
+        if (!subscribed) {
+            subscribed = true;
+            bus.on("test", [&](const EventData&) -> bool { ++added; return false; });
+        }
+        return false;
+    });
+
+    bus.emit("test");
+    EXPECT_EQ(added, 0);
+    EXPECT_EQ(bus.handlerCount("test"), 2u);
+
+    bus.emit("test");
+    EXPECT_EQ(added, 1);
+}
+
+TEST(EventBus, ClearDuringNestedEmit) {
+    EventBus bus;
+    int outer = 0;
+    int inner = 0;
+
+    bus.on("outer", [&](const EventData&) -> bool {
+        ++outer;
+        bus.emit("inner");
+        return false;
+    });
+    bus.on("outer", [&](const EventData&) -> bool { ++outer; return false; }, 5);
+    bus.on("inner", [&](const EventData&) -> bool {
+        ++inner;
+        bus.clear();
+        return false;
+    });
+
+    bus.emit("outer");
+    EXPECT_EQ(outer, 1);  // Second outer handler was removed mid-dispatch
+    EXPECT_EQ(inner, 1);
+    EXPECT_EQ(bus.handlerCount("outer"), 0u);
+    EXPECT_EQ(bus.handlerCount("inner"), 0u);
+}
+
+TEST(EventBus, QueuedEventsDeliveredOnFlush) {
+    EventBus bus;
+    std::vector<int> received;
+
+    bus.on("queued", [&](const EventData& data) -> bool {
+        received.push_back(data.getInt("n"));
+        return false;
+    });
+
+    for (int i = 0; i < 3; ++i) {
+        EventData data;
+        data.setInt("n", i);
+        bus.queue("queued", data);
+    }
+    EXPECT_TRUE(received.empty());
+    EXPECT_EQ(bus.queuedCount(), 3u);
+
+    EXPECT_EQ(bus.flushQueued(), 3u);
+    ASSERT_EQ(received.size(), 3u);
+    EXPECT_EQ(received[0], 0);
+    EXPECT_EQ(received[2], 2);
+    EXPECT_EQ(bus.queuedCount(), 0u);
+    EXPECT_EQ(bus.flushQueued(), 0u);
+}
+
+TEST(EventBus, DeferredEmitIsQueued) {
+    EventBus bus;
+    int count = 0;
+    bus.on("deferred", [&](const EventData&) -> bool { ++count; return true; });
+    bus.setDeferred("deferred", true);
+
+    EXPECT_FALSE(bus.emit("deferred"));  // Queued events cannot be cancelled by the emitter
+    EXPECT_EQ(count, 0);
+    bus.flushQueued();
+    EXPECT_EQ(count, 1);
+
+    bus.setDeferred("deferred", false);
+    EXPECT_TRUE(bus.emit("deferred"));
+    EXPECT_EQ(count, 2);
+}
+
+TEST(EventBus, BatchHandlerReceivesAllEventsOfType) {
+    EventBus bus;
+    std::vector<size_t> batchSizes;
+    float total = 0.0f;
+
+    bus.onBatch("damage", [&](std::span<const EventData> events) {
+        batchSizes.push_back(events.size());
+        for (const auto& e : events) total += e.getFloat("amount");
+    });
+
+    for (int i = 1; i <= 4; ++i) {
+        EventData data;
+        data.setFloat("amount", static_cast<float>(i));
+        bus.queue("damage", data);
+    }
+    bus.queue("other");
+    bus.flushQueued();
+
+    ASSERT_EQ(batchSizes.size(), 1u);
+    EXPECT_EQ(batchSizes[0], 4u);
+    EXPECT_FLOAT_EQ(total, 10.0f);
+
+    // Immediate emits reach batch handlers as a single-element batch
+    EventData single;
+    single.setFloat("amount", 5.0f);
+    bus.emit("damage", single);
+    ASSERT_EQ(batchSizes.size(), 2u);
+    EXPECT_EQ(batchSizes[1], 1u);
+    EXPECT_FLOAT_EQ(total, 15.0f);
+}
+
+TEST(EventBus, CoalescingHandlerSkipsDuplicates) {
+    EventBus bus;
+    int coalesced = 0;
+    int plain = 0;
+
+    bus.on("tile_update", [&](const EventData&) -> bool { ++coalesced; return false; }, 0, true);
+    bus.on("tile_update", [&](const EventData&) -> bool { ++plain; return false; });
+
+    for (int i = 0; i < 5; ++i) {
+        EventData data;
+        data.setInt("x", i % 2);  // Two distinct payloads
+        data.setString("reason", "break");
+        bus.queue("tile_update", data);
+    }
+    bus.flushQueued();
+
+    EXPECT_EQ(coalesced, 2);
+    EXPECT_EQ(plain, 5);
+}
+
+TEST(EventBus, EventsQueuedDuringFlushWaitForNextFlush) {
+    EventBus bus;
+    int chained = 0;
+
+    bus.on("first", [&](const EventData&) -> bool {
+        bus.queue("second");
+        return false;
+    });
+    bus.on("second", [&](const EventData&) -> bool { ++chained; return false; });
+
+    bus.queue("first");
+    bus.flushQueued();
+    EXPECT_EQ(chained, 0);
+    EXPECT_EQ(bus.queuedCount(), 1u);
+
+    bus.flushQueued();
+    EXPECT_EQ(chained, 1);
+}
+
+TEST(EventBus, QueueCapacityDropsOverflow) {
+    EventBus bus;
+    bus.setMaxQueuedEvents(2);
+    EXPECT_TRUE(bus.queue("capped"));
+    EXPECT_TRUE(bus.queue("capped"));
+    EXPECT_FALSE(bus.queue("capped"));
+    EXPECT_EQ(bus.droppedCount(), 1u);
+
+    bus.clearQueued();
+    EXPECT_EQ(bus.queuedCount(), 0u);
+    EXPECT_EQ(bus.flushQueued(), 0u);
+}
+
 // ============================================================================
 // HotReload Tests
 // ============================================================================
@@ -979,6 +1299,119 @@ TEST(HotReload, UnwatchSpecificMod) {
     fs::remove_all(tmpDir2);
 }
 
+TEST(HotReload, CoalescesBurstIntoOneReload) {
+    HotReload hotReload;
+    if (hotReload.backend() != HotReload::Backend::Inotify) {
+        GTEST_SKIP() << "inotify not available";
+    }
+
+    std::string tmpDir = "/tmp/gloaming_hr_burst_" + std::to_string(getpid());
+    fs::create_directories(tmpDir);
+    hotReload.setDebounce(0.05f);
+
+    int calls = 0;
+    std::vector<std::string> changedFiles;
+    hotReload.setCallback([&](const std::string&, const std::vector<std::string>& files) {
+        ++calls;
+        changedFiles = files;
+    });
+    hotReload.watchMod("test-mod", tmpDir);
+
+    // Idle: nothing to report
+    EXPECT_FALSE(hotReload.poll());
+
+    // Editor-style burst: repeated writes, an atomic rename, and a swap file
+    for (int i = 0; i < 3; ++i) {
+        std::ofstream f(tmpDir + "/main.lua");
+        f << "-- save " << i;
+    }
+    {
+        std::ofstream f(tmpDir + "/items.json.tmp");
+        f << "{}";
+    }
+    fs::rename(tmpDir + "/items.json.tmp", tmpDir + "/items.json");
+    {
+        std::ofstream f(tmpDir + "/.main.lua.swp");
+        f << "x";
+    }
+
+    // Still inside the debounce window
+    EXPECT_FALSE(hotReload.poll());
+    EXPECT_EQ(calls, 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    EXPECT_TRUE(hotReload.poll());
+    EXPECT_EQ(calls, 1);
+    ASSERT_EQ(changedFiles.size(), 2u);
+    EXPECT_EQ(changedFiles[0], tmpDir + "/items.json");
+    EXPECT_EQ(changedFiles[1], tmpDir + "/main.lua");
+
+    EXPECT_FALSE(hotReload.poll());
+    EXPECT_EQ(calls, 1);
+
+    fs::remove_all(tmpDir);
+}
+
+TEST(HotReload, WatchesNewSubdirectories) {
+    HotReload hotReload;
+    if (hotReload.backend() != HotReload::Backend::Inotify) {
+        GTEST_SKIP() << "inotify not available";
+    }
+
+    std::string tmpDir = "/tmp/gloaming_hr_subdir_" + std::to_string(getpid());
+    fs::create_directories(tmpDir);
+    hotReload.setDebounce(0.0f);
+
+    std::vector<std::string> changedFiles;
+    hotReload.setCallback([&](const std::string&, const std::vector<std::string>& files) {
+        changedFiles = files;
+    });
+    hotReload.watchMod("test-mod", tmpDir);
+
+    fs::create_directories(tmpDir + "/scripts");
+    EXPECT_FALSE(hotReload.poll());     // Directory alone is not a change
+
+    {
+        std::ofstream f(tmpDir + "/scripts/ai.lua");
+        f << "-- ai";
+    }
+    EXPECT_TRUE(hotReload.poll());
+    ASSERT_EQ(changedFiles.size(), 1u);
+    EXPECT_EQ(changedFiles[0], tmpDir + "/scripts/ai.lua");
+
+    fs::remove_all(tmpDir);
+}
+
+TEST(HotReload, PollingFallbackDetectsChange) {
+    std::string tmpDir = "/tmp/gloaming_hr_polling_" + std::to_string(getpid());
+    fs::create_directories(tmpDir);
+    std::string file = tmpDir + "/test.lua";
+    {
+        std::ofstream f(file);
+        f << "-- original";
+    }
+
+    HotReload hotReload(false);
+    EXPECT_EQ(hotReload.backend(), HotReload::Backend::Polling);
+    hotReload.setPollInterval(0.0f);
+    hotReload.setDebounce(0.0f);
+
+    std::vector<std::string> changedFiles;
+    hotReload.setCallback([&](const std::string&, const std::vector<std::string>& files) {
+        changedFiles = files;
+    });
+    hotReload.watchMod("test-mod", tmpDir);
+    EXPECT_FALSE(hotReload.poll());
+
+    // Move the timestamp explicitly so coarse filesystem clocks can't hide the edit
+    fs::last_write_time(file, fs::last_write_time(file) + std::chrono::seconds(2));
+    EXPECT_TRUE(hotReload.poll());
+    ASSERT_EQ(changedFiles.size(), 1u);
+    EXPECT_EQ(changedFiles[0], file);
+
+    fs::remove_all(tmpDir);
+}
+
 // ============================================================================
 // Integration: ModManifest + ContentRegistry
 // ============================================================================
@@ -1062,6 +1495,20 @@ protected:
     LuaBindings m_bindings;
 };
 
+TEST(LuaBindingsLifetime, DestroyWithoutShutdown) {
+    Engine engine;
+    ContentRegistry registry;
+    EventBus eventBus;
+    {
+        LuaBindings bindings;
+        ASSERT_TRUE(bindings.init(engine, registry, eventBus));
+        auto env = bindings.createModEnvironment("test");
+        ASSERT_TRUE(bindings.executeString("x = 1", env, "=test"));
+        // No shutdown(): the destructor must unhook before the state closes
+    }
+    SUCCEED();
+}
+
 TEST_F(LuaBindingsTest, SandboxRemovesOS) {
     auto env = m_bindings.createModEnvironment("test");
     bool ok = m_bindings.executeString("assert(os == nil)", env, "=test");
@@ -1203,6 +1650,403 @@ TEST_F(LuaBindingsTest, EventRoundTrip) {
     EXPECT_TRUE(ok);
 }
 
+TEST_F(LuaBindingsTest, EventBatchRoundTrip) {
+    auto env = m_bindings.createModEnvironment("test");
+    bool ok = m_bindings.executeString(R"(
+        batches = 0
+        total = 0
+        events.on_batch("batch_event", function(list)
+            batches = batches + 1
+            for _, e in ipairs(list) do total = total + e.amount end
+        end)
+        events.queue("batch_event", {amount = 2})
+        events.queue("batch_event", {amount = 3})
+        assert(batches == 0)
+    )", env, "=test");
+    ASSERT_TRUE(ok);
+
+    m_eventBus.flushQueued();
+
+    ok = m_bindings.executeString(R"(
+        assert(batches == 1)
+        assert(total == 5)
+    )", env, "=test");
+    EXPECT_TRUE(ok);
+}
+
+// ============================================================================
+// Bytecode cache Tests
+// ============================================================================
+
+TEST(BytecodeCacheTest, RoundTripsChunk) {
+    std::string tmpDir = "/tmp/gloaming_luac_roundtrip_" + std::to_string(getpid());
+    fs::remove_all(tmpDir);
+    BytecodeCache cache(tmpDir);
+    ASSERT_TRUE(cache.isEnabled());
+    EXPECT_TRUE(fs::exists(tmpDir + ".key"));
+    EXPECT_EQ(fs::status(tmpDir + ".key").permissions() & fs::perms::all,
+              fs::perms::owner_read | fs::perms::owner_write);
+    EXPECT_FALSE(fs::exists(tmpDir + ".key.tmp"));
+
+    uint64_t key = cache.keyFor("=test", "return 1");
+    std::string chunk("\x1bLua\0payload", 12);
+    ASSERT_TRUE(cache.save(key, chunk));
+
+    std::string loaded;
+    ASSERT_TRUE(cache.load(key, loaded));
+    EXPECT_EQ(loaded, chunk);
+
+    // Reopening with the same key file still hits
+    BytecodeCache reopened(tmpDir);
+    EXPECT_EQ(reopened.keyFor("=test", "return 1"), key);
+    EXPECT_TRUE(reopened.load(key, loaded));
+
+    // Another install names the script differently, and its secret
+    // doesn't authenticate the entry
+    BytecodeCache otherInstall(tmpDir, tmpDir + "_other.key");
+    EXPECT_NE(otherInstall.keyFor("=test", "return 1"), key);
+    EXPECT_FALSE(otherInstall.load(key, loaded));
+
+    // Another key, or a corrupted file, is a miss
+    EXPECT_FALSE(cache.load(key + 1, loaded));
+    {
+        std::fstream file(cache.pathFor(key), std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('X');
+    }
+    EXPECT_FALSE(cache.load(key, loaded));
+
+    fs::remove_all(tmpDir);
+    fs::remove(tmpDir + ".key");
+    fs::remove(tmpDir + "_other.key");
+}
+
+TEST(BytecodeCacheTest, KeyDependsOnNameAndSource) {
+    BytecodeCache cache;
+    EXPECT_EQ(cache.keyFor("@a.lua", "return 1"), cache.keyFor("@a.lua", "return 1"));
+    EXPECT_NE(cache.keyFor("@a.lua", "return 1"), cache.keyFor("@a.lua", "return 2"));
+    EXPECT_NE(cache.keyFor("@a.lua", "return 1"), cache.keyFor("@b.lua", "return 1"));
+    EXPECT_NE(cache.keyFor("@a", "b"), cache.keyFor("@ab", ""));
+}
+
+TEST(BytecodeCacheTest, DisabledWithoutDirectory) {
+    BytecodeCache cache;
+    EXPECT_FALSE(cache.isEnabled());
+    EXPECT_FALSE(cache.save(1, "chunk"));
+    std::string loaded;
+    EXPECT_FALSE(cache.load(1, loaded));
+}
+
+class LuaBytecodeCacheTest : public LuaBindingsTest {
+protected:
+    void SetUp() override {
+        LuaBindingsTest::SetUp();
+        m_tmpDir = "/tmp/gloaming_luac_test_" + std::to_string(getpid());
+        fs::remove_all(m_tmpDir);
+        fs::create_directories(m_tmpDir + "/scripts");
+        m_bindings.setBytecodeCacheDirectory(m_tmpDir + "/cache");
+    }
+
+    void TearDown() override {
+        LuaBindingsTest::TearDown();
+        fs::remove_all(m_tmpDir);
+    }
+
+    std::string writeScript(const std::string& name, const std::string& source) {
+        std::string path = m_tmpDir + "/scripts/" + name;
+        std::ofstream(path, std::ios::binary) << source;
+        return path;
+    }
+
+    size_t cachedFileCount() const {
+        size_t count = 0;
+        for (const auto& entry : fs::directory_iterator(m_tmpDir + "/cache")) {
+            if (entry.path().extension() == ".luac") ++count;
+        }
+        return count;
+    }
+
+    std::string m_tmpDir;
+};
+
+TEST_F(LuaBytecodeCacheTest, SecondLoadHitsCache) {
+    std::string path = writeScript("count.lua", "counter = (counter or 0) + 1\n");
+    auto env = m_bindings.createModEnvironment("test");
+
+    ASSERT_TRUE(m_bindings.executeFile(path, env));
+    EXPECT_EQ(m_bindings.bytecodeCacheMisses(), 1u);
+    EXPECT_EQ(m_bindings.bytecodeCacheHits(), 0u);
+    EXPECT_EQ(cachedFileCount(), 1u);
+
+    ASSERT_TRUE(m_bindings.executeFile(path, env));
+    EXPECT_EQ(m_bindings.bytecodeCacheHits(), 1u);
+    EXPECT_TRUE(m_bindings.executeString("assert(counter == 2)", env, "=test"));
+}
+
+TEST_F(LuaBytecodeCacheTest, CacheSurvivesRestart) {
+    std::string path = writeScript("value.lua", "value = 7\n");
+    auto env = m_bindings.createModEnvironment("test");
+    ASSERT_TRUE(m_bindings.executeFile(path, env));
+
+    // A fresh Lua state (next startup) loads the chunk from disk
+    m_eventBus.clear();
+    LuaBindings restarted;
+    restarted.init(m_engine, m_registry, m_eventBus);
+    restarted.setBytecodeCacheDirectory(m_tmpDir + "/cache");
+    auto env2 = restarted.createModEnvironment("test");
+    ASSERT_TRUE(restarted.executeFile(path, env2));
+    EXPECT_EQ(restarted.bytecodeCacheHits(), 1u);
+    EXPECT_EQ(restarted.bytecodeCacheMisses(), 0u);
+    EXPECT_TRUE(restarted.executeString("assert(value == 7)", env2, "=test"));
+    m_eventBus.clear();
+    restarted.shutdown();
+}
+
+TEST_F(LuaBytecodeCacheTest, EditedScriptInvalidatesChunk) {
+    std::string path = writeScript("value.lua", "value = 1\n");
+    auto env = m_bindings.createModEnvironment("test");
+    ASSERT_TRUE(m_bindings.executeFile(path, env));
+
+    // Hot reload: the new source compiles and replaces the old chunk
+    writeScript("value.lua", "value = 2\n");
+    ASSERT_TRUE(m_bindings.executeFile(path, env));
+    EXPECT_EQ(m_bindings.bytecodeCacheMisses(), 2u);
+    EXPECT_EQ(m_bindings.bytecodeCacheHits(), 0u);
+    EXPECT_EQ(cachedFileCount(), 1u);
+    EXPECT_TRUE(m_bindings.executeString("assert(value == 2)", env, "=test"));
+}
+
+TEST_F(LuaBytecodeCacheTest, CachedChunkKeepsLineNumbers) {
+    std::string path = writeScript("fail.lua", "local x = 1\nerror('boom')\n");
+    std::string error;
+    m_bindings.loadScript(path, error);
+
+    sol::protected_function chunk = m_bindings.loadScript(path, error);
+    ASSERT_TRUE(chunk.valid());
+    EXPECT_EQ(m_bindings.bytecodeCacheHits(), 1u);
+    auto result = chunk();
+    ASSERT_FALSE(result.valid());
+    sol::error err = result;
+    EXPECT_NE(std::string(err.what()).find("fail.lua:2"), std::string::npos);
+}
+
+TEST_F(LuaBytecodeCacheTest, ModScriptsCannotBeBinaryChunks) {
+    // A precompiled chunk shipped as a mod script is rejected
+    std::string error;
+    std::string okPath = writeScript("ok.lua", "return 42\n");
+    sol::protected_function chunk = m_bindings.loadScript(okPath, error);
+    ASSERT_TRUE(chunk.valid());
+    std::string bytecode;
+    const BytecodeCache& cache = m_bindings.getBytecodeCache();
+    ASSERT_TRUE(cache.load(cache.keyFor("@" + okPath, "return 42\n"), bytecode));
+
+    std::string path = writeScript("binary.lua", bytecode);
+    auto env = m_bindings.createModEnvironment("test");
+    EXPECT_FALSE(m_bindings.executeFile(path, env));
+    EXPECT_FALSE(m_bindings.executeString(bytecode, env, "=binary"));
+}
+
+// ============================================================================
+// Lua CPU budget Tests
+// ============================================================================
+
+TEST(LuaCpuBudgetTest, NestedScopesChargeExclusiveTime) {
+    LuaCpuBudget budget;
+    auto modA = budget.registerMod("mod-a");
+    auto modB = budget.registerMod("mod-b");
+    EXPECT_EQ(budget.registerMod("mod-a"), modA);
+    EXPECT_EQ(budget.currentMod(), LuaCpuBudget::kNoMod);
+
+    {
+        LuaCpuBudget::Scope outer(&budget, modA);
+        EXPECT_EQ(budget.currentMod(), modA);
+        {
+            LuaCpuBudget::Scope inner(&budget, modB);
+            EXPECT_EQ(budget.currentMod(), modB);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        EXPECT_EQ(budget.currentMod(), modA);
+    }
+    budget.endFrame();
+
+    const auto* a = budget.getStats("mod-a");
+    const auto* b = budget.getStats("mod-b");
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(a->calls, 1u);
+    EXPECT_EQ(b->calls, 1u);
+    EXPECT_GE(b->lastFrameMs, 15.0);
+    EXPECT_LT(a->lastFrameMs, 15.0);
+    EXPECT_EQ(budget.getStats("unknown"), nullptr);
+}
+
+TEST(LuaCpuBudgetTest, SoftBudgetCountsOverrunFrames) {
+    LuaCpuBudget budget;
+    LuaCpuBudget::Settings settings;
+    settings.softFrameMs = 1.0;
+    budget.setSettings(settings);
+    auto mod = budget.registerMod("slow");
+
+    {
+        LuaCpuBudget::Scope scope(&budget, mod);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    budget.endFrame();
+    budget.endFrame();      // Idle frame: no new overrun
+
+    EXPECT_EQ(budget.getStats("slow")->softOverruns, 1u);
+    EXPECT_EQ(budget.getStats("slow")->lastFrameMs, 0.0);
+}
+
+TEST_F(LuaBindingsTest, RunawayCallbackIsAborted) {
+    auto settings = m_bindings.getCpuBudget().getSettings();
+    settings.hardCallInstructions = 200000;
+    m_bindings.getCpuBudget().setSettings(settings);
+
+    auto env = m_bindings.createModEnvironment("runaway");
+    ASSERT_TRUE(m_bindings.executeString(
+        "events.on('tick', function() while true do end end)", env, "=runaway"));
+    m_eventBus.emit("tick", EventData{});
+
+    const auto* stats = m_bindings.getCpuBudget().getStats("runaway");
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->hardAborts, 1u);
+    EXPECT_GE(stats->instructions, 200000u);
+
+    // The state is still usable afterwards
+    EXPECT_TRUE(m_bindings.executeString("x = 1", env, "=runaway"));
+}
+
+TEST_F(LuaBindingsTest, HardTimeBudgetAbortsCallback) {
+    auto settings = m_bindings.getCpuBudget().getSettings();
+    settings.hardCallMs = 10.0;
+    settings.hardCallInstructions = 0;
+    m_bindings.getCpuBudget().setSettings(settings);
+
+    auto env = m_bindings.createModEnvironment("slow");
+    ASSERT_TRUE(m_bindings.executeString(
+        "events.on('tick', function() while true do end end)", env, "=slow"));
+    m_eventBus.emit("tick", EventData{});
+    EXPECT_EQ(m_bindings.getCpuBudget().getStats("slow")->hardAborts, 1u);
+}
+
+TEST_F(LuaBindingsTest, ScriptsRunUnderLoadLimits) {
+    auto settings = m_bindings.getCpuBudget().getSettings();
+    settings.hardCallInstructions = 200000;
+    settings.loadCallInstructions = 0;
+    m_bindings.getCpuBudget().setSettings(settings);
+
+    // Well past the per-callback limit, but it's setup, not a callback
+    auto env = m_bindings.createModEnvironment("big");
+    EXPECT_TRUE(m_bindings.executeString(
+        "local sum = 0 for i = 1, 1000000 do sum = sum + i end", env, "=big"));
+    EXPECT_EQ(m_bindings.getCpuBudget().getStats("big")->hardAborts, 0u);
+
+    // Runaway setup still hits the load limit
+    settings.loadCallInstructions = 5'000'000;
+    m_bindings.getCpuBudget().setSettings(settings);
+    EXPECT_FALSE(m_bindings.executeString("while true do end", env, "=big"));
+    EXPECT_EQ(m_bindings.getCpuBudget().getStats("big")->hardAborts, 1u);
+}
+
+TEST_F(LuaBindingsTest, HandlerTimeChargedToRegisteringMod) {
+    auto listener = m_bindings.createModEnvironment("listener");
+    auto emitter = m_bindings.createModEnvironment("emitter");
+
+    ASSERT_TRUE(m_bindings.executeString(R"(
+        events.on("tick", function(data)
+            local sum = 0
+            for i = 1, 50000 do sum = sum + i end
+        end)
+    )", listener, "=listener"));
+    ASSERT_TRUE(m_bindings.executeString(R"(
+        for i = 1, 3 do events.emit("tick", {}) end
+    )", emitter, "=emitter"));
+
+    const auto* listenerStats = m_bindings.getCpuBudget().getStats("listener");
+    const auto* emitterStats = m_bindings.getCpuBudget().getStats("emitter");
+    ASSERT_NE(listenerStats, nullptr);
+    ASSERT_NE(emitterStats, nullptr);
+    EXPECT_EQ(listenerStats->calls, 4u);   // Registration chunk + 3 handler calls
+    EXPECT_GT(listenerStats->instructions, emitterStats->instructions);
+}
+
+TEST_F(LuaBindingsTest, AbortedHandlerLeavesOtherModsRunning) {
+    auto settings = m_bindings.getCpuBudget().getSettings();
+    settings.hardCallInstructions = 200000;
+    m_bindings.getCpuBudget().setSettings(settings);
+
+    auto bad = m_bindings.createModEnvironment("bad");
+    auto good = m_bindings.createModEnvironment("good");
+    ASSERT_TRUE(m_bindings.executeString(
+        "events.on('tick', function() while true do end end, 10)", bad, "=bad"));
+    ASSERT_TRUE(m_bindings.executeString(
+        "ticks = 0; events.on('tick', function() ticks = ticks + 1 end)", good, "=good"));
+
+    m_eventBus.emit("tick", EventData{});
+
+    EXPECT_EQ(m_bindings.getCpuBudget().getStats("bad")->hardAborts, 1u);
+    EXPECT_TRUE(m_bindings.executeString("assert(ticks == 1)", good, "=good"));
+}
+
+TEST_F(LuaBindingsTest, ScopedHandlersDontResetUnscopedCeiling) {
+    auto settings = m_bindings.getCpuBudget().getSettings();
+    settings.hardCallInstructions = 200000;
+    m_bindings.getCpuBudget().setSettings(settings);
+
+    auto listener = m_bindings.createModEnvironment("listener");
+    ASSERT_TRUE(m_bindings.executeString(
+        "events.on('tick', function() end)", listener, "=listener"));
+
+    // Each emit runs a scoped handler; the loop around it is unscoped
+    auto result = m_bindings.getState().safe_script(
+        "while true do events.emit('tick', {}) end", sol::script_pass_on_error);
+    EXPECT_FALSE(result.valid());
+    EXPECT_EQ(m_bindings.getCpuBudget().getStats("listener")->hardAborts, 0u);
+}
+
+TEST_F(LuaBindingsTest, GcSteppingFinishesCycleAndFreesGarbage) {
+    auto env = m_bindings.createModEnvironment("gc");
+    ASSERT_TRUE(m_bindings.executeString(
+        "junk = {} for i = 1, 50000 do junk[i] = { i } end", env, "=gc"));
+    ASSERT_TRUE(m_bindings.executeString("junk = nil", env, "=gc"));
+
+    auto& gc = m_bindings.getGcScheduler();
+    double before = gc.memoryKb();
+    for (int frame = 0; frame < 1000 && gc.getStats().cycles == 0; ++frame) {
+        gc.step(5.0);
+    }
+
+    EXPECT_GE(gc.getStats().cycles, 1u);
+    EXPECT_GT(gc.getStats().steps, 0u);
+    EXPECT_LT(gc.memoryKb(), before);
+}
+
+TEST_F(LuaBindingsTest, GcFullCollectWaitsForNextStep) {
+    auto& gc = m_bindings.getGcScheduler();
+    gc.requestFullCollect("test");
+    EXPECT_TRUE(gc.fullCollectPending());
+    EXPECT_EQ(gc.getStats().fullCollections, 0u);
+
+    gc.step(0.0);
+
+    EXPECT_FALSE(gc.fullCollectPending());
+    EXPECT_EQ(gc.getStats().fullCollections, 1u);
+}
+
+TEST_F(LuaBindingsTest, GcUnpacedLeavesCollectorToLua) {
+    auto settings = m_bindings.getGcScheduler().getSettings();
+    settings.enginePaced = false;
+    m_bindings.getGcScheduler().setSettings(settings);
+
+    auto env = m_bindings.createModEnvironment("gc");
+    ASSERT_TRUE(m_bindings.executeString(
+        "junk = {} for i = 1, 20000 do junk[i] = { i } end junk = nil", env, "=gc"));
+    m_bindings.getGcScheduler().step(5.0);
+
+    EXPECT_EQ(m_bindings.getGcScheduler().getStats().steps, 0u);
+}
+
 // ============================================================================
 // ModLoader Tests
 // ============================================================================
@@ -1289,6 +2133,35 @@ TEST_F(ModLoaderTest, LoadSimpleMod) {
     loader.shutdown();
 }
 
+TEST_F(ModLoaderTest, LongInitStillLoads) {
+    // init() and postInit() run far past the per-callback limit
+    createMod("big-pack", "1.0.0", {}, R"(
+        local function work()
+            local sum = 0
+            for i = 1, 1000000 do sum = sum + i end
+            return sum
+        end
+        work()
+        return { init = work, postInit = work }
+    )");
+
+    ModLoader loader;
+    ModLoaderConfig config;
+    config.modsDirectory = m_tmpDir;
+    config.configFile = "";
+    config.cpuBudget.hardCallInstructions = 100000;
+    ASSERT_TRUE(loader.init(m_engine, config));
+
+    loader.discoverMods();
+    ASSERT_TRUE(loader.resolveDependencies());
+    EXPECT_EQ(loader.loadMods(), 1);
+    loader.postInitMods();
+    EXPECT_TRUE(loader.isModLoaded("big-pack"));
+    EXPECT_EQ(loader.getMod("big-pack")->state, ModState::PostInit);
+
+    loader.shutdown();
+}
+
 TEST_F(ModLoaderTest, DependencyOrder) {
     createMod("base", "1.0.0", {}, "return {}");
     createMod("addon", "1.0.0", {
@@ -0,0 +1,478 @@
+#include <gtest/gtest.h>
+
+#include "ecs/Components.hpp"
+#include "net/ByteStream.hpp"
+#include "net/Replication.hpp"
+#include "net/Snapshot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+
+using namespace gloaming;
+
+namespace {
+
+/// Quantized fields only (updatedTick is server bookkeeping).
+void expectSameState(const NetEntityState& a, const NetEntityState& b) {
+    EXPECT_EQ(a.netId, b.netId);
+    EXPECT_EQ(a.x, b.x);
+    EXPECT_EQ(a.y, b.y);
+    EXPECT_EQ(a.vx, b.vx);
+    EXPECT_EQ(a.vy, b.vy);
+    EXPECT_EQ(a.rotation, b.rotation);
+    EXPECT_EQ(a.ownerClientId, b.ownerClientId);
+    EXPECT_EQ(a.interpolationDelayMs, b.interpolationDelayMs);
+    EXPECT_EQ(a.syncFlags, b.syncFlags);
+}
+
+void expectSameSnapshot(const Snapshot& a, const Snapshot& b) {
+    ASSERT_EQ(a.entities.size(), b.entities.size());
+    for (size_t i = 0; i < a.entities.size(); ++i) expectSameState(a.entities[i], b.entities[i]);
+}
+
+NetEntityState makeState(uint32_t netId, int32_t x, int32_t y) {
+    NetEntityState s;
+    s.netId = netId;
+    s.x = x;
+    s.y = y;
+    s.syncFlags = NetSyncFlags::Position;
+    s.interpolationDelayMs = 100;
+    return s;
+}
+
+/// Encode `current` against `baseline`, decode it back, and check that the
+/// client ends up with exactly what the server recorded as sent.
+SnapshotEncodeStats roundTrip(SnapshotEncoder& encoder, const Snapshot& current,
+                              const Snapshot* baseline, size_t budget,
+                              Snapshot& sent, Snapshot& decoded) {
+    std::vector<uint8_t> buffer;
+    ByteWriter out(buffer);
+    SnapshotEncodeStats stats = encoder.encode(current, baseline, budget, out, sent);
+    EXPECT_EQ(stats.bytes, buffer.size());
+
+    SnapshotDecoder decoder;
+    ByteReader in(buffer.data(), buffer.size());
+    EXPECT_TRUE(decoder.decode(in, baseline, decoded));
+    EXPECT_TRUE(in.atEnd());
+    expectSameSnapshot(sent, decoded);
+    return stats;
+}
+
+} // namespace
+
+// ============================================================================
+// ByteStream
+// ============================================================================
+
+TEST(ByteStreamTest, VarIntsRoundTrip) {
+    std::vector<uint8_t> buffer;
+    ByteWriter out(buffer);
+    const int32_t values[] = {0, 1, -1, 63, -64, 64, 300, -300, INT32_MAX, INT32_MIN};
+    for (int32_t v : values) out.writeVarInt(v);
+    out.writeVarUint(UINT32_MAX);
+    out.writeU16(0xBEEF);
+    out.writeU32(0xDEADBEEF);
+
+    ByteReader in(buffer.data(), buffer.size());
+    for (int32_t v : values) EXPECT_EQ(in.readVarInt(), v);
+    EXPECT_EQ(in.readVarUint(), UINT32_MAX);
+    EXPECT_EQ(in.readU16(), 0xBEEF);
+    EXPECT_EQ(in.readU32(), 0xDEADBEEFu);
+    EXPECT_TRUE(in.ok());
+    EXPECT_TRUE(in.atEnd());
+}
+
+TEST(ByteStreamTest, SmallSignedValuesTakeOneByte) {
+    std::vector<uint8_t> buffer;
+    ByteWriter out(buffer);
+    out.writeVarInt(-3);
+    out.writeVarInt(3);
+    EXPECT_EQ(buffer.size(), 2u);
+    EXPECT_EQ(ByteWriter::varUintSize(127), 1u);
+    EXPECT_EQ(ByteWriter::varUintSize(128), 2u);
+}
+
+TEST(ByteStreamTest, ReadingPastEndFails) {
+    const uint8_t data[] = {0x80, 0x80};   // unterminated varint
+    ByteReader in(data, sizeof(data));
+    EXPECT_EQ(in.readVarUint(), 0u);
+    EXPECT_FALSE(in.ok());
+    EXPECT_EQ(in.readU32(), 0u);
+    EXPECT_EQ(in.remaining(), 0u);
+}
+
+// ============================================================================
+// Snapshot capture
+// ============================================================================
+
+TEST(SnapshotTest, QuantizationWrapsRotation) {
+    EXPECT_EQ(NetQuantize::rotation(0.0f), 0);
+    EXPECT_EQ(NetQuantize::rotation(360.0f), 0);
+    EXPECT_EQ(NetQuantize::rotation(-90.0f), NetQuantize::rotation(270.0f));
+    EXPECT_NEAR(NetQuantize::toRotation(NetQuantize::rotation(45.0f)), 45.0f, 0.01f);
+    EXPECT_NEAR(NetQuantize::toPosition(NetQuantize::position(12.34f)), 12.34f, 1.0f / 32.0f);
+}
+
+TEST(SnapshotTest, CaptureReadsNetworkSyncEntitiesOnly) {
+    Registry registry;
+    Entity a = registry.create(Transform{Vec2{10.0f, 20.0f}, 90.0f}, Velocity{5.0f, -5.0f});
+    registry.add<NetworkSync>(a);
+    Entity b = registry.create(Transform{Vec2{-4.0f, 0.5f}});
+    auto& syncB = registry.add<NetworkSync>(b);
+    syncB.syncVelocity = false;
+    syncB.ownerClientId = 3;
+    syncB.interpolationDelay = 0.25f;
+    registry.create(Transform{Vec2{1.0f, 1.0f}});   // not replicated
+
+    Snapshot snapshot;
+    captureSnapshot(registry, 7, 1.5f, snapshot);
+
+    EXPECT_EQ(snapshot.tick, 7u);
+    ASSERT_EQ(snapshot.entities.size(), 2u);
+    EXPECT_LT(snapshot.entities[0].netId, snapshot.entities[1].netId);
+
+    const NetEntityState* sa = snapshot.find(static_cast<uint32_t>(a));
+    ASSERT_NE(sa, nullptr);
+    EXPECT_EQ(sa->x, 160);
+    EXPECT_EQ(sa->y, 320);
+    EXPECT_EQ(sa->vx, 80);
+    EXPECT_EQ(sa->rotation, 16384);
+
+    const NetEntityState* sb = snapshot.find(static_cast<uint32_t>(b));
+    ASSERT_NE(sb, nullptr);
+    EXPECT_EQ(sb->ownerClientId, 3u);
+    EXPECT_EQ(sb->interpolationDelayMs, 250);
+    EXPECT_EQ(sb->syncFlags & NetSyncFlags::Velocity, 0);
+}
+
+// ============================================================================
+// Delta codec
+// ============================================================================
+
+TEST(SnapshotCodecTest, FullSnapshotRoundTrips) {
+    Snapshot current;
+    current.tick = 1;
+    for (uint32_t i = 0; i < 50; ++i) current.entities.push_back(makeState(i * 3 + 1, i * 100, -int32_t(i)));
+    current.entities[4].vx = INT32_MIN;
+    current.entities[5].rotation = 65535;
+
+    SnapshotEncoder encoder;
+    Snapshot sent, decoded;
+    auto stats = roundTrip(encoder, current, nullptr, 64 * 1024, sent, decoded);
+    EXPECT_EQ(stats.updated, 50u);
+    EXPECT_EQ(stats.deferred, 0u);
+    expectSameSnapshot(current, decoded);
+}
+
+TEST(SnapshotCodecTest, UnchangedEntitiesCostNothing) {
+    Snapshot baseline;
+    baseline.tick = 1;
+    for (uint32_t i = 0; i < 100; ++i) baseline.entities.push_back(makeState(i + 1, i * 16, 0));
+
+    Snapshot current = baseline;
+    current.tick = 2;
+
+    SnapshotEncoder encoder;
+    Snapshot sent, decoded;
+    auto stats = roundTrip(encoder, current, &baseline, 1200, sent, decoded);
+    EXPECT_EQ(stats.updated, 0u);
+    EXPECT_EQ(stats.bytes, 2u);     // two zero counts
+
+    // One entity moves one pixel: a small record with only the position group
+    current.entities[42].x += 16;
+    stats = roundTrip(encoder, current, &baseline, 1200, sent, decoded);
+    EXPECT_EQ(stats.updated, 1u);
+    EXPECT_LE(stats.bytes, 8u);
+    expectSameSnapshot(current, decoded);
+}
+
+TEST(SnapshotCodecTest, RemovalsAndSpawnsApply) {
+    Snapshot baseline;
+    baseline.tick = 1;
+    for (uint32_t i = 0; i < 10; ++i) baseline.entities.push_back(makeState(i + 1, 0, 0));
+
+    Snapshot current;
+    current.tick = 2;
+    for (uint32_t i = 0; i < 10; ++i) {
+        if (i == 3 || i == 7) continue;
+        current.entities.push_back(makeState(i + 1, 0, 0));
+    }
+    current.entities.push_back(makeState(500, 32, 32));
+
+    SnapshotEncoder encoder;
+    Snapshot sent, decoded;
+    auto stats = roundTrip(encoder, current, &baseline, 1200, sent, decoded);
+    EXPECT_EQ(stats.removed, 2u);
+    EXPECT_EQ(stats.updated, 1u);
+    expectSameSnapshot(current, decoded);
+    EXPECT_EQ(decoded.find(4), nullptr);
+    ASSERT_NE(decoded.find(500), nullptr);
+}
+
+TEST(SnapshotCodecTest, PacketsStayWithinBudgetAndConverge) {
+    constexpr size_t kBudget = 1000;
+    constexpr uint32_t kTicks = 150;
+    Snapshot current;
+    for (uint32_t i = 0; i < 5000; ++i) current.entities.push_back(makeState(i + 1, i * 7, i * 13));
+
+    SnapshotEncoder encoder;
+    SnapshotDecoder decoder;
+    Snapshot acked;             // what the client holds (and has acknowledged)
+    bool haveBaseline = false;
+    uint32_t deferred = 0;
+
+    for (uint32_t tick = 1; tick <= kTicks; ++tick) {
+        current.tick = tick;
+        // Everything keeps moving, so every entity always has a pending change
+        for (auto& s : current.entities) s.x += 16;
+
+        std::vector<uint8_t> buffer;
+        ByteWriter out(buffer);
+        Snapshot sent;
+        deferred = encoder.encode(current, haveBaseline ? &acked : nullptr, kBudget, out, sent).deferred;
+        ASSERT_LE(buffer.size(), kBudget);
+
+        Snapshot decoded;
+        ByteReader in(buffer.data(), buffer.size());
+        ASSERT_TRUE(decoder.decode(in, haveBaseline ? &acked : nullptr, decoded));
+        expectSameSnapshot(sent, decoded);
+        acked = sent;
+        haveBaseline = true;
+    }
+
+    // Every entity reached the client despite the cap, and the rest of the
+    // changes are still queued rather than dropped
+    EXPECT_EQ(acked.entities.size(), current.entities.size());
+    EXPECT_GT(deferred, 0u);
+
+    // Staleness priority refreshes entities round-robin: none falls more
+    // than a couple of sweeps behind
+    uint32_t oldest = UINT32_MAX;
+    for (const auto& s : acked.entities) oldest = std::min(oldest, s.updatedTick);
+    EXPECT_GT(oldest, kTicks - 80);
+}
+
+TEST(SnapshotCodecTest, MalformedPayloadIsRejected) {
+    Snapshot current;
+    current.tick = 1;
+    for (uint32_t i = 0; i < 20; ++i) current.entities.push_back(makeState(i + 1, i, i));
+
+    std::vector<uint8_t> buffer;
+    ByteWriter out(buffer);
+    SnapshotEncoder encoder;
+    Snapshot sent;
+    encoder.encode(current, nullptr, 1200, out, sent);
+
+    SnapshotDecoder decoder;
+    Snapshot decoded;
+    ByteReader truncated(buffer.data(), buffer.size() / 2);
+    EXPECT_FALSE(decoder.decode(truncated, nullptr, decoded));
+
+    const uint8_t hugeCount[] = {0x00, 0xFF, 0xFF, 0xFF, 0x0F};
+    ByteReader bogus(hugeCount, sizeof(hugeCount));
+    EXPECT_FALSE(decoder.decode(bogus, nullptr, decoded));
+}
+
+// ============================================================================
+// Loopback replication
+// ============================================================================
+
+TEST(ReplicationTest, AddressParsing) {
+    UdpAddress address;
+    ASSERT_TRUE(UdpAddress::parse("127.0.0.1", 27015, address));
+    EXPECT_EQ(address.ip, 0x7F000001u);
+    EXPECT_EQ(address.toString(), "127.0.0.1:27015");
+    EXPECT_TRUE(UdpAddress::parse("localhost", 1, address));
+    EXPECT_FALSE(UdpAddress::parse("300.1.1.1", 1, address));
+    EXPECT_FALSE(UdpAddress::parse("example.com", 1, address));
+}
+
+TEST(ReplicationTest, LoopbackReplicatesAndInterpolates) {
+    ReplicationConfig config;
+    config.port = 0;
+    config.snapshotRate = 20.0f;
+
+    ReplicationServer server;
+    if (!server.start(config)) GTEST_SKIP() << "UDP sockets unavailable";
+
+    config.host = "127.0.0.1";
+    config.port = server.port();
+    ReplicationClient client;
+    ASSERT_TRUE(client.connect(config));
+
+    Registry serverWorld;
+    Entity mover = serverWorld.create(Transform{Vec2{0.0f, 50.0f}});
+    auto& sync = serverWorld.add<NetworkSync>(mover);
+    sync.interpolationDelay = 0.1f;
+    sync.ownerClientId = 2;
+    Entity doomed = serverWorld.create(Transform{Vec2{5.0f, 5.0f}});
+    serverWorld.add<NetworkSync>(doomed);
+
+    Registry clientWorld;
+    const float dt = 1.0f / 60.0f;
+    float time = 0.0f;
+    for (int frame = 0; frame < 120; ++frame) {
+        time += dt;
+        serverWorld.get<Transform>(mover).position.x = 100.0f * time;    // 100 px/s
+        server.update(serverWorld, dt);
+        client.update(clientWorld, dt);
+    }
+
+    ASSERT_TRUE(client.isConnected());
+    EXPECT_EQ(server.clientCount(), 1u);
+    EXPECT_GT(server.clientStats()[0].ackedTick, 0u);
+
+    Entity replica = client.findEntity(static_cast<uint32_t>(mover));
+    ASSERT_TRUE(clientWorld.valid(replica));
+    ASSERT_TRUE(clientWorld.has<NetworkReplica>(replica));
+    EXPECT_EQ(clientWorld.get<NetworkSync>(replica).ownerClientId, 2u);
+
+    // Drawn interpolationDelay behind the server clock, on the line between
+    // two snapshots (within a quantum plus a frame of slack)
+    float expected = 100.0f * (client.serverTime() - 0.1f);
+    EXPECT_NEAR(clientWorld.get<Transform>(replica).position.x, expected, 2.0f);
+    EXPECT_NEAR(clientWorld.get<Transform>(replica).position.y, 50.0f, 0.1f);
+
+    // Destroyed on the server -> destroyed on the client
+    Entity doomedReplica = client.findEntity(static_cast<uint32_t>(doomed));
+    ASSERT_TRUE(clientWorld.valid(doomedReplica));
+    serverWorld.destroy(doomed);
+    for (int frame = 0; frame < 30; ++frame) {
+        server.update(serverWorld, dt);
+        client.update(clientWorld, dt);
+    }
+    EXPECT_FALSE(clientWorld.valid(doomedReplica));
+    EXPECT_EQ(client.findEntity(static_cast<uint32_t>(doomed)), NullEntity);
+
+    client.disconnect();
+    server.update(serverWorld, dt);
+    EXPECT_EQ(server.clientCount(), 0u);
+}
+
+TEST(ReplicationTest, BandwidthStaysBoundedAsEntitiesGrow) {
+    ReplicationConfig config;
+    config.port = 0;
+    config.maxPacketBytes = 600;
+
+    ReplicationServer server;
+    if (!server.start(config)) GTEST_SKIP() << "UDP sockets unavailable";
+    config.port = server.port();
+    ReplicationClient client;
+    ASSERT_TRUE(client.connect(config));
+
+    Registry serverWorld, clientWorld;
+    for (int i = 0; i < 3000; ++i) {
+        Entity e = serverWorld.create(Transform{Vec2{static_cast<float>(i), 0.0f}});
+        serverWorld.add<NetworkSync>(e);
+    }
+
+    const float dt = 1.0f / 20.0f;
+    for (int frame = 0; frame < 40; ++frame) {
+        serverWorld.each<Transform>([](Entity, Transform& t) { t.position.y += 1.0f; });
+        server.update(serverWorld, dt);
+        client.update(clientWorld, dt);
+        for (const auto& stats : server.clientStats()) {
+            EXPECT_LE(stats.lastPacketBytes, config.maxPacketBytes);
+        }
+    }
+
+    auto stats = server.clientStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_GT(stats[0].lastDeferred, 0u);
+    EXPECT_LE(stats[0].bytesSent, stats[0].packetsSent * config.maxPacketBytes);
+    EXPECT_GT(clientWorld.count<NetworkReplica>(), 0u);
+}
+
+TEST(ReplicationTest, HelloWithoutCookieOnlyGetsChallenge) {
+    ReplicationConfig config;
+    config.port = 0;
+    ReplicationServer server;
+    if (!server.start(config)) GTEST_SKIP() << "UDP sockets unavailable";
+
+    UdpSocket raw;
+    ASSERT_TRUE(raw.open(0));
+    UdpAddress serverAddress;
+    ASSERT_TRUE(UdpAddress::parse("127.0.0.1", server.port(), serverAddress));
+
+    auto sendHello = [&](uint64_t cookie, size_t padTo) {
+        std::vector<uint8_t> packet;
+        ByteWriter out(packet);
+        out.writeU16(NetPacket::kMagic);
+        out.writeU8(NetPacket::Hello);
+        out.writeU8(NetPacket::kProtocolVersion);
+        out.writeU64(cookie);
+        packet.resize(std::max(packet.size(), padTo), 0);
+        raw.sendTo(serverAddress, packet.data(), packet.size());
+    };
+    std::array<uint8_t, NetPacket::kMaxDatagram> buffer{};
+    auto receive = [&]() {
+        UdpAddress from;
+        int size = 0;
+        for (int attempt = 0; attempt < 50 && size <= 0; ++attempt) {
+            size = raw.receiveFrom(from, buffer.data(), buffer.size());
+        }
+        return size;
+    };
+
+    Registry world;
+    world.add<NetworkSync>(world.create(Transform{Vec2{1.0f, 2.0f}}));
+
+    // Unpadded Hello: no reply at all
+    sendHello(0, 0);
+    server.update(world, 0.1f);
+    EXPECT_LE(receive(), 0);
+    EXPECT_EQ(server.clientCount(), 0u);
+
+    // Padded Hello without a cookie: a Challenge no larger than the Hello,
+    // and no connection
+    sendHello(0, NetPacket::kHelloBytes);
+    server.update(world, 0.1f);
+    int size = receive();
+    ASSERT_GT(size, 0);
+    EXPECT_LE(static_cast<size_t>(size), NetPacket::kHelloBytes);
+    ByteReader in(buffer.data(), static_cast<size_t>(size));
+    EXPECT_EQ(in.readU16(), NetPacket::kMagic);
+    EXPECT_EQ(in.readU8(), NetPacket::Challenge);
+    uint64_t cookie = in.readU64();
+    ASSERT_TRUE(in.ok());
+    EXPECT_EQ(server.clientCount(), 0u);
+
+    // A guessed cookie is challenged again, not accepted
+    sendHello(cookie ^ 1, NetPacket::kHelloBytes);
+    server.update(world, 0.1f);
+    EXPECT_GT(receive(), 0);
+    EXPECT_EQ(server.clientCount(), 0u);
+
+    // Echoing the real cookie connects
+    sendHello(cookie, NetPacket::kHelloBytes);
+    server.update(world, 0.1f);
+    EXPECT_EQ(server.clientCount(), 1u);
+}
+
+TEST(ReplicationTest, MaxClientsIsEnforced) {
+    ReplicationConfig config;
+    config.port = 0;
+    config.maxClients = 1;
+    ReplicationServer server;
+    if (!server.start(config)) GTEST_SKIP() << "UDP sockets unavailable";
+
+    config.port = server.port();
+    ReplicationClient first, second;
+    ASSERT_TRUE(first.connect(config));
+    ASSERT_TRUE(second.connect(config));
+
+    Registry serverWorld, firstWorld, secondWorld;
+    serverWorld.add<NetworkSync>(serverWorld.create(Transform{Vec2{0.0f, 0.0f}}));
+
+    const float dt = 1.0f / 20.0f;
+    for (int frame = 0; frame < 40; ++frame) {
+        server.update(serverWorld, dt);
+        first.update(firstWorld, dt);
+        second.update(secondWorld, dt);
+    }
+
+    EXPECT_EQ(server.clientCount(), 1u);
+    EXPECT_NE(first.isConnected(), second.isConnected());
+}
@@ -620,6 +620,43 @@ TEST(ShopManagerTest, GetBuySellPrices) {
     EXPECT_EQ(manager.getSellPrice("base:store", "base:potion"), 20);
 }
 
+TEST(ShopManagerTest, StockTrackedPerItemByRuntimeId) {
+    ContentRegistry contentRegistry;
+
+    ShopDefinition shop;
+    shop.id = "store";
+    shop.qualifiedId = "base:store";
+    shop.buyMultiplier = 1.0f;
+    shop.currencyItem = "base:coins";
+
+    ShopItemEntry torch;
+    torch.itemId = "base:torch";
+    torch.buyPrice = 1;
+    torch.stock = 5;
+    shop.items.push_back(torch);
+
+    ShopItemEntry rope;
+    rope.itemId = "base:rope";
+    rope.buyPrice = 1;
+    rope.stock = 3;
+    shop.items.push_back(rope);
+
+    uint16_t shopId = contentRegistry.registerShop(shop);
+
+    ShopManager manager;
+    manager.setContentRegistry(&contentRegistry);
+    EXPECT_EQ(manager.resolveShop("base:store"), shopId);
+    EXPECT_EQ(manager.resolveShop("base:missing"), 0);
+
+    Inventory inv;
+    inv.addItem("base:coins", 100);
+
+    EXPECT_TRUE(manager.buyItem(shopId, "base:torch", 2, inv).success);
+    EXPECT_EQ(manager.getRemainingStock(shopId, "base:torch"), 3);
+    EXPECT_EQ(manager.getRemainingStock("base:store", "base:rope"), 3);
+    EXPECT_FALSE(manager.buyItem(uint16_t{0}, "base:torch", 1, inv).success);
+}
+
 // =============================================================================
 // HousingRequirements Tests
 // =============================================================================
@@ -5,6 +5,10 @@
 #include "gameplay/DebugDrawSystem.hpp"
 #include "ecs/Registry.hpp"
 #include "ecs/Components.hpp"
+#include "engine/Engine.hpp"
+#include "engine/JobSystem.hpp"
+#include "rendering/NullRenderer.hpp"
+#include "rendering/Texture.hpp"
 
 using namespace gloaming;
 
@@ -82,6 +86,130 @@ TEST(ParticleConfigTest, EmitterConfigDefaults) {
     EXPECT_TRUE(config.fade);
 }
 
+TEST(ParticlePoolTest, ParticlesExpireAndCompact) {
+    Engine engine;
+    Registry registry;
+    ParticleSystem particles;
+    particles.init(registry, engine);
+
+    ParticleEmitterConfig shortLived;
+    shortLived.count = 300;
+    shortLived.lifetime = RangeF(0.25f);
+    ParticleEmitterConfig longLived = shortLived;
+    longLived.count = 200;
+    longLived.lifetime = RangeF(1.0f);
+
+    particles.burst(shortLived, Vec2(0, 0));
+    EmitterId kept = particles.burst(longLived, Vec2(100, 0));
+    EXPECT_EQ(particles.getStats().activeParticles, 500u);
+
+    particles.update(0.1f);
+    EXPECT_EQ(particles.getStats().activeParticles, 500u);
+    particles.update(0.2f);
+    EXPECT_EQ(particles.getStats().activeParticles, 200u);
+
+    particles.destroyEmitter(kept);
+    EXPECT_EQ(particles.getStats().activeParticles, 0u);
+}
+
+TEST(ParticlePoolTest, DestroyEmitterKeepsOtherParticles) {
+    Engine engine;
+    Registry registry;
+    ParticleSystem particles;
+    particles.init(registry, engine);
+
+    ParticleEmitterConfig config;
+    config.count = 100;
+    EmitterId a = particles.burst(config, Vec2(0, 0));
+    particles.burst(config, Vec2(50, 0));
+    EmitterId c = particles.burst(config, Vec2(100, 0));
+
+    particles.destroyEmitter(a);
+    EXPECT_EQ(particles.getStats().activeParticles, 200u);
+    particles.destroyEmitter(c);
+    EXPECT_EQ(particles.getStats().activeParticles, 100u);
+}
+
+TEST(ParticlePoolTest, RespectsMaxParticles) {
+    Engine engine;
+    Registry registry;
+    ParticleSystem particles;
+    particles.init(registry, engine);
+    particles.setMaxParticles(300);
+
+    ParticleEmitterConfig config;
+    config.count = 500;
+    particles.burst(config, Vec2(0, 0));
+    EXPECT_EQ(particles.getStats().activeParticles, 300u);
+}
+
+TEST(ParticlePoolTest, ParallelUpdateExpiresOnSchedule) {
+    Engine engine;
+    Registry registry;
+    JobSystem jobs;
+    jobs.start(3);
+    ParticleSystem particles;
+    particles.init(registry, engine);
+    particles.setJobSystem(&jobs);
+
+    // Several update jobs' worth of particles, half of them living twice as long
+    ParticleEmitterConfig config;
+    config.count = static_cast<int>(ParticleSystem::kParallelGrain * 2);
+    config.lifetime = RangeF(0.5f);
+    config.gravity = 98.0f;
+    particles.burst(config, Vec2(0, 0));
+    config.lifetime = RangeF(1.0f);
+    particles.burst(config, Vec2(0, 0));
+    const size_t total = ParticleSystem::kParallelGrain * 4;
+    ASSERT_EQ(particles.getStats().activeParticles, total);
+
+    for (int i = 0; i < 4; ++i) particles.update(0.1f);
+    EXPECT_EQ(particles.getStats().activeParticles, total);
+    for (int i = 0; i < 2; ++i) particles.update(0.1f);
+    EXPECT_EQ(particles.getStats().activeParticles, total / 2);
+    for (int i = 0; i < 5; ++i) particles.update(0.1f);
+    EXPECT_EQ(particles.getStats().activeParticles, 0u);
+}
+
+TEST(ParticleRenderTest, OneBatchPerTextureAndBlend) {
+    Engine engine;
+    Registry registry;
+    ParticleSystem particles;
+    particles.init(registry, engine);
+
+    NullRenderer renderer;
+    renderer.init(640, 360);
+    Camera camera(640.0f, 360.0f);
+    camera.setPosition(0.0f, 0.0f);
+
+    Texture spark(8, 8, 42);
+    ParticleEmitterConfig plain;
+    plain.count = 400;
+    plain.speed = RangeF(0.0f);
+    ParticleEmitterConfig additive = plain;
+    additive.blend = BlendMode::Additive;
+    ParticleEmitterConfig textured = additive;
+    textured.texture = &spark;
+
+    particles.burst(plain, Vec2(0, 0));
+    particles.burst(additive, Vec2(10, 0));
+    particles.burst(textured, Vec2(-10, 0));
+    particles.burst(plain, Vec2(20, 0));            // Shares the first batch
+    particles.burst(plain, Vec2(100000, 100000));   // Culled
+
+    renderer.beginFrame();
+    particles.render(&renderer, camera);
+    EXPECT_EQ(renderer.drawCallCount(), 3u);
+    EXPECT_EQ(renderer.quadBatchCount(), 3u);
+    EXPECT_EQ(renderer.batchedQuadCount(), 1600u);
+
+    // Nothing visible: nothing submitted
+    camera.setPosition(-50000.0f, -50000.0f);
+    renderer.beginFrame();
+    particles.render(&renderer, camera);
+    EXPECT_EQ(renderer.drawCallCount(), 0u);
+}
+
 // =============================================================================
 // TweenSystem Tests
 // =============================================================================
@@ -0,0 +1,711 @@
+#include <gtest/gtest.h>
+
+#include "engine/Engine.hpp"
+#include "mod/ContentRegistry.hpp"
+#include "mod/EventBus.hpp"
+#include "mod/LuaBindings.hpp"
+#include "net/Snapshot.hpp"
+#include "physics/PhysicsSystem.hpp"
+#include "physics/SpatialIndex.hpp"
+#include "gameplay/EntitySpawning.hpp"
+#include "gameplay/ProjectileSystem.hpp"
+#include "gameplay/ParticleSystem.hpp"
+#include "rendering/NullRenderer.hpp"
+#include "rendering/SpriteBatch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace gloaming;
+
+// ============================================================================
+// Allocation counting
+//
+// Replaces the global allocator with a pass-through that counts calls while a
+// AllocationCounter is alive. Counting is off otherwise, so the rest of the
+// test binary is unaffected.
+// ============================================================================
+
+namespace {
+
+std::atomic<bool> g_countAllocations{false};
+std::atomic<size_t> g_allocationCount{0};
+
+class AllocationCounter {
+public:
+    AllocationCounter() {
+        g_allocationCount.store(0, std::memory_order_relaxed);
+        g_countAllocations.store(true, std::memory_order_relaxed);
+    }
+    ~AllocationCounter() { g_countAllocations.store(false, std::memory_order_relaxed); }
+
+    size_t count() const { return g_allocationCount.load(std::memory_order_relaxed); }
+};
+
+using BenchClock = std::chrono::steady_clock;
+
+double elapsedMs(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+}
+
+} // namespace
+
+// GCC flags malloc/free inside replacement operators as mismatched once inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    if (g_countAllocations.load(std::memory_order_relaxed)) {
+        g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// ============================================================================
+// EventBus
+// ============================================================================
+
+TEST(Performance, EventBusEmitIsAllocationFree) {
+    EventBus bus;
+    const EventId damageEvent = EventBus::intern("bench_entity_damaged");
+    const EventKey keyEntity = EventNames::intern("entity");
+    const EventKey keyDamage = EventNames::intern("damage");
+    const EventKey keyType   = EventNames::intern("enemy_id");
+
+    float total = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        bus.on(damageEvent, [&total, keyDamage](const EventData& data) -> bool {
+            total += data.getFloat(keyDamage);
+            return false;
+        }, i);
+    }
+
+    constexpr int kEmits = 100000;
+
+    // Warm up (first emit may touch lazily created state)
+    {
+        EventData data;
+        data.setFloat(keyDamage, 1.0f);
+        bus.emit(damageEvent, data);
+    }
+
+    AllocationCounter counter;
+    auto start = BenchClock::now();
+    for (int i = 0; i < kEmits; ++i) {
+        EventData data;
+        data.setInt(keyEntity, i);
+        data.setFloat(keyDamage, 1.0f);
+        data.setString(keyType, "base:green_slime_variant");
+        bus.emit(damageEvent, data);
+    }
+    double ms = elapsedMs(start);
+    size_t allocations = counter.count();
+
+    std::printf("[   BENCH  ] EventBus emit (4 handlers, 3 keys): %.1f ns/emit, %zu allocations\n",
+                ms * 1e6 / kEmits, allocations);
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_FLOAT_EQ(total, 1.0f * 4 + static_cast<float>(kEmits) * 4);
+}
+
+// ============================================================================
+// Snapshot replication
+// ============================================================================
+
+TEST(Performance, SnapshotDeltaEncodeDecode) {
+    constexpr uint32_t kEntities = 10000;
+    constexpr int kTicks = 100;
+
+    Snapshot baseline;
+    baseline.tick = 1;
+    for (uint32_t i = 0; i < kEntities; ++i) {
+        NetEntityState s;
+        s.netId = i + 1;
+        s.x = static_cast<int32_t>(i * 37);
+        s.y = static_cast<int32_t>(i * 11);
+        s.syncFlags = NetSyncFlags::Position | NetSyncFlags::Velocity;
+        s.interpolationDelayMs = 100;
+        baseline.entities.push_back(s);
+    }
+
+    // A quarter of the entities move each tick
+    Snapshot current = baseline;
+    current.tick = 2;
+    for (uint32_t i = 0; i < kEntities; i += 4) {
+        current.entities[i].x += 24;
+        current.entities[i].vx = 96;
+    }
+
+    SnapshotEncoder encoder;
+    SnapshotDecoder decoder;
+    Snapshot sent, decoded;
+    std::vector<uint8_t> buffer;
+    buffer.reserve(256 * 1024);
+
+    // Unbounded budget: cost of diffing and encoding every change
+    double encodeMs = 0.0, decodeMs = 0.0;
+    size_t fullBytes = 0;
+    for (int i = 0; i < kTicks; ++i) {
+        buffer.clear();
+        ByteWriter out(buffer);
+        auto start = BenchClock::now();
+        encoder.encode(current, &baseline, SIZE_MAX, out, sent);
+        encodeMs += elapsedMs(start);
+        fullBytes = buffer.size();
+
+        ByteReader in(buffer.data(), buffer.size());
+        start = BenchClock::now();
+        ASSERT_TRUE(decoder.decode(in, &baseline, decoded));
+        decodeMs += elapsedMs(start);
+    }
+    ASSERT_EQ(decoded.entities.size(), kEntities);
+
+    // MTU-sized budget: what a client actually receives per snapshot
+    double cappedMs = 0.0;
+    size_t cappedBytes = 0;
+    for (int i = 0; i < kTicks; ++i) {
+        buffer.clear();
+        ByteWriter out(buffer);
+        auto start = BenchClock::now();
+        encoder.encode(current, &baseline, 1200, out, sent);
+        cappedMs += elapsedMs(start);
+        cappedBytes = buffer.size();
+    }
+
+    std::printf("[   BENCH  ] Snapshot delta (%u entities, %u changed): encode %.1f ns/entity, "
+                "decode %.1f ns/entity, %zu bytes uncapped\n",
+                kEntities, kEntities / 4, encodeMs * 1e6 / (kTicks * kEntities),
+                decodeMs * 1e6 / (kTicks * kEntities), fullBytes);
+    std::printf("[   BENCH  ] Snapshot delta capped at 1200 bytes: encode %.3f ms, %zu bytes\n",
+                cappedMs / kTicks, cappedBytes);
+
+    EXPECT_LE(cappedBytes, 1200u);
+    // Position and velocity deltas fit in a few bytes per changed entity
+    EXPECT_LT(fullBytes, static_cast<size_t>(kEntities / 4) * 10);
+}
+
+// ============================================================================
+// Physics
+// ============================================================================
+
+namespace {
+
+/// Runs PhysicsSystem::update over `bodies` falling, walking boxes on a tile
+/// floor with a wall every 16 tiles, and reports the per-body cost of the
+/// whole update and of the tile collision pass on its own.
+void benchPhysicsUpdate(int bodies, int frames) {
+    constexpr int kWidthTiles = 256;        // 4 chunks wide
+    constexpr int kFloorY = 40;
+    constexpr float kDt = 1.0f / 60.0f;
+
+    std::string worldDir = (std::filesystem::temp_directory_path() /
+                            ("gloaming_bench_physics_" + std::to_string(bodies))).string();
+    std::filesystem::remove_all(worldDir);
+
+    TileMap tileMap;
+    ASSERT_TRUE(tileMap.createWorld(worldDir, "Bench", 1));
+    for (int x = 0; x < kWidthTiles; ++x) {
+        for (int y = 0; y < kFloorY; ++y) {
+            bool wall = (x % 16 == 0) && y >= kFloorY - 6;
+            tileMap.setTileId(x, y, wall ? 1 : 0, 0, wall ? Tile::FLAG_SOLID : 0);
+        }
+        tileMap.setTileId(x, kFloorY, 1, 0, Tile::FLAG_SOLID);
+    }
+
+    Engine engine;
+    Registry registry;
+    PhysicsSystem physics;
+    physics.init(registry, engine);
+    physics.setTileMap(&tileMap);
+
+    struct Walker { Entity entity; float speed; };
+    std::vector<Walker> walkers;
+    walkers.reserve(bodies);
+    const float worldWidth = static_cast<float>(kWidthTiles * 16);
+    for (int i = 0; i < bodies; ++i) {
+        float x = 24.0f + std::fmod(static_cast<float>(i) * 37.3f, worldWidth - 48.0f);
+        float y = 16.0f + std::fmod(static_cast<float>(i) * 11.7f, static_cast<float>(kFloorY * 16 - 64));
+        float speed = (i % 2 ? 1.0f : -1.0f) * (20.0f + static_cast<float>(i % 60));
+        Entity e = registry.create(Transform{Vec2(x, y)}, Velocity{Vec2(speed, 0.0f)},
+                                   Collider{Vec2(10.0f, 14.0f)}, Gravity{});
+        walkers.push_back({e, speed});
+    }
+
+    // Keep every body walking, turning around at walls, the way AI would
+    auto steer = [&] {
+        for (Walker& w : walkers) {
+            auto& velocity = registry.get<Velocity>(w.entity);
+            if (velocity.linear.x == 0.0f) w.speed = -w.speed;
+            velocity.linear.x = w.speed;
+        }
+    };
+
+    // Let bodies fall onto the floor so the timed frames mix airborne and grounded movement
+    for (int i = 0; i < frames; ++i) {
+        steer();
+        physics.update(kDt);
+    }
+
+    double updateMs = 0.0;
+    for (int i = 0; i < frames; ++i) {
+        steer();
+        auto start = BenchClock::now();
+        physics.update(kDt);
+        updateMs += elapsedMs(start);
+    }
+
+    // Tile collision alone: the same moveAABB call updatePositions makes per body
+    struct Move { AABB aabb; Vec2 delta; bool grounded; };
+    std::vector<Move> moves;
+    moves.reserve(bodies);
+    for (const Walker& w : walkers) {
+        const auto& velocity = registry.get<Velocity>(w.entity);
+        moves.push_back({Collision::getEntityAABB(registry.get<Transform>(w.entity),
+                                                  registry.get<Collider>(w.entity)),
+                         Vec2(w.speed, velocity.linear.y + 980.0f * kDt) * kDt,
+                         registry.get<Gravity>(w.entity).grounded});
+    }
+
+    const TileCollision& tiles = physics.getTileCollision();
+    size_t grounded = 0;
+    AllocationCounter counter;
+    auto start = BenchClock::now();
+    for (int i = 0; i < frames; ++i) {
+        for (const Move& move : moves) {
+            grounded += tiles.moveAABB(move.aabb, move.delta, true, move.grounded).onGround ? 1 : 0;
+        }
+    }
+    double tileMs = elapsedMs(start);
+    size_t allocations = counter.count();
+
+    const double perBody = 1e6 / (static_cast<double>(frames) * bodies);
+    std::printf("[   BENCH  ] Physics update (%d bodies): %.1f ns/body total, "
+                "tile collision %.1f ns/body, %zu allocations\n",
+                bodies, updateMs * perBody, tileMs * perBody, allocations);
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_GT(grounded, 0u);
+
+    tileMap.closeWorld();
+    std::filesystem::remove_all(worldDir);
+}
+
+} // namespace
+
+TEST(Performance, PhysicsUpdate1kBodies) {
+    benchPhysicsUpdate(1000, 60);
+}
+
+TEST(Performance, PhysicsUpdate10kBodies) {
+    benchPhysicsUpdate(10000, 6);
+}
+
+// ============================================================================
+// Spatial queries
+// ============================================================================
+
+TEST(Performance, FindInRadiusIndexedVsScan) {
+    constexpr int kEntities = 10000;
+    constexpr int kQueries = 300;           // e.g. one find_in_radius per scripted enemy
+    constexpr float kRadius = 200.0f;
+
+    Registry registry;
+    EntitySpawning scan;
+    scan.setRegistry(&registry);
+
+    SpatialIndex index;
+    EntitySpawning indexed;
+    indexed.setRegistry(&registry);
+    indexed.setSpatialIndex(&index);
+
+    const char* types[] = {"slime", "zombie", "arrow", "item"};
+    for (int i = 0; i < kEntities; ++i) {
+        float x = std::fmod(static_cast<float>(i) * 97.1f, 8000.0f);
+        float y = std::fmod(static_cast<float>(i) * 53.9f, 4000.0f);
+        Entity e = registry.create(Transform{Vec2(x, y)}, Name{"e", types[i % 4]});
+        if (i % 2 == 0) registry.add<Collider>(e, Collider{Vec2(16.0f, 24.0f)});
+    }
+
+    EntityQueryFilter filter;
+    filter.type = "slime";
+    auto queryPoint = [](int q) {
+        return Vec2(std::fmod(static_cast<float>(q) * 613.7f, 8000.0f),
+                    std::fmod(static_cast<float>(q) * 291.3f, 4000.0f));
+    };
+
+    size_t scanHits = 0;
+    auto start = BenchClock::now();
+    for (int q = 0; q < kQueries; ++q) {
+        Vec2 p = queryPoint(q);
+        scanHits += scan.findInRadius(p.x, p.y, kRadius, filter).size();
+    }
+    double scanMs = elapsedMs(start);
+
+    start = BenchClock::now();
+    index.sync(registry);
+    double syncMs = elapsedMs(start);
+
+    size_t indexedHits = 0;
+    start = BenchClock::now();
+    for (int q = 0; q < kQueries; ++q) {
+        Vec2 p = queryPoint(q);
+        indexedHits += indexed.findInRadius(p.x, p.y, kRadius, filter).size();
+    }
+    double indexedMs = elapsedMs(start);
+
+    std::printf("[   BENCH  ] find_in_radius x%d over %d entities: scan %.2f ms, "
+                "indexed %.2f ms (+%.2f ms sync)\n",
+                kQueries, kEntities, scanMs, indexedMs, syncMs);
+
+    EXPECT_EQ(indexedHits, scanHits);
+    EXPECT_GT(scanHits, 0u);
+}
+
+TEST(Performance, FindInRadiusInterleavedWithMoves) {
+    constexpr int kEntities = 10000;
+    constexpr int kQueries = 1000;          // a script loop: query, then move or spawn
+    constexpr float kRadius = 200.0f;
+
+    Registry registry;
+    EntitySpawning scan;
+    scan.setRegistry(&registry);
+
+    SpatialIndex index;
+    EntitySpawning indexed;
+    indexed.setRegistry(&registry);
+    indexed.setSpatialIndex(&index);
+
+    std::vector<Entity> entities;
+    entities.reserve(kEntities);
+    for (int i = 0; i < kEntities; ++i) {
+        float x = std::fmod(static_cast<float>(i) * 97.1f, 8000.0f);
+        float y = std::fmod(static_cast<float>(i) * 53.9f, 4000.0f);
+        entities.push_back(registry.create(Transform{Vec2(x, y)}, Name{"e", i % 4 ? "item" : "slime"}));
+    }
+    index.sync(registry);
+    const uint64_t rebuilds = index.rebuildCount();
+
+    EntityQueryFilter filter;
+    filter.type = "slime";
+    auto point = [](int q, float a, float b) {
+        return Vec2(std::fmod(static_cast<float>(q) * a, 8000.0f),
+                    std::fmod(static_cast<float>(q) * b, 4000.0f));
+    };
+
+    size_t scanHits = 0;
+    size_t indexedHits = 0;
+    double scanMs = 0.0;
+    double indexedMs = 0.0;
+    for (int q = 0; q < kQueries; ++q) {
+        Vec2 p = point(q, 613.7f, 291.3f);
+        auto start = BenchClock::now();
+        scanHits += scan.findInRadius(p.x, p.y, kRadius, filter).size();
+        scanMs += elapsedMs(start);
+
+        start = BenchClock::now();
+        indexedHits += indexed.findInRadius(p.x, p.y, kRadius, filter).size();
+        if (q % 10 == 0) {
+            Vec2 at = point(q, 71.3f, 37.9f);
+            indexed.create(at.x, at.y);
+        } else {
+            Vec2 to = point(q, 211.9f, 127.1f);
+            indexed.setPosition(entities[static_cast<size_t>(q) * 7 % kEntities], to.x, to.y);
+        }
+        indexedMs += elapsedMs(start);
+    }
+
+    std::printf("[   BENCH  ] find_in_radius x%d interleaved with moves/spawns over %d entities: "
+                "scan %.2f ms, indexed %.2f ms (%llu rebuilds)\n",
+                kQueries, kEntities, scanMs, indexedMs,
+                static_cast<unsigned long long>(index.rebuildCount() - rebuilds));
+
+    EXPECT_EQ(indexedHits, scanHits);
+    EXPECT_GT(scanHits, 0u);
+    // Moves and spawns are applied per entity, not by rebuilding the grid
+    EXPECT_LE(index.rebuildCount() - rebuilds, 1u);
+}
+
+// ============================================================================
+// Projectiles
+// ============================================================================
+
+TEST(Performance, ProjectileUpdate2kProjectiles) {
+    constexpr int kProjectiles = 2000;
+    constexpr int kTargets = 1000;
+    constexpr int kFrames = 30;
+    constexpr float kDt = 1.0f / 60.0f;
+
+    Engine engine;
+    Registry registry;
+    ProjectileSystem projectiles;
+    projectiles.init(registry, engine);
+
+    for (int i = 0; i < kTargets; ++i) {
+        Collider collider{Vec2(16.0f, 24.0f)};
+        collider.layer = (i % 2) ? CollisionLayer::Enemy : CollisionLayer::NPC;
+        registry.create(Transform{Vec2(std::fmod(static_cast<float>(i) * 83.1f, 4000.0f),
+                                       std::fmod(static_cast<float>(i) * 41.7f, 2000.0f))},
+                        collider, Health{1e9f});
+    }
+
+    // Piercing bullets, so most stay alive through the run
+    for (int i = 0; i < kProjectiles; ++i) {
+        Collider collider{Vec2(4.0f, 4.0f)};
+        collider.layer = CollisionLayer::Projectile;
+        collider.mask = CollisionLayer::None;
+        Projectile proj;
+        proj.hitMask = CollisionLayer::Enemy;
+        proj.pierce = -1;
+        proj.lifetime = 1000.0f;
+        float angle = static_cast<float>(i) * 0.61f;
+        registry.create(Transform{Vec2(std::fmod(static_cast<float>(i) * 57.3f, 4000.0f),
+                                       std::fmod(static_cast<float>(i) * 29.9f, 2000.0f))},
+                        Velocity{Vec2(std::cos(angle), std::sin(angle)) * 900.0f},
+                        collider, proj);
+    }
+
+    auto start = BenchClock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        // Stand-in for PhysicsSystem moving the bullets
+        registry.each<Transform, Velocity, Projectile>(
+            [&](Entity, Transform& t, Velocity& v, Projectile&) { t.position += v.linear * kDt; });
+        projectiles.update(kDt);
+    }
+    double ms = elapsedMs(start);
+
+    size_t alive = registry.count<Projectile>();
+    std::printf("[   BENCH  ] Projectile update (%d projectiles, %d targets): %.3f ms/frame, "
+                "%zu still alive\n", kProjectiles, kTargets, ms / kFrames, alive);
+
+    EXPECT_GT(alive, static_cast<size_t>(kProjectiles / 2));
+}
+
+// ============================================================================
+// Particles
+// ============================================================================
+
+namespace {
+
+/// Updates a pool of `count` long-lived rain-like particles and reports
+/// simulated particles per millisecond, serially and across workers.
+void benchParticleUpdate(size_t count, int frames) {
+    constexpr float kDt = 1.0f / 60.0f;
+
+    Engine engine;
+    Registry registry;
+    ParticleSystem particles;
+    particles.init(registry, engine);
+    particles.setMaxParticles(count);
+
+    ParticleEmitterConfig rain;
+    rain.count = static_cast<int>(count);
+    rain.lifetime = RangeF(1000.0f);
+    rain.speed = RangeF(200.0f, 400.0f);
+    rain.angle = RangeF(80.0f, 100.0f);
+    rain.gravity = 300.0f;
+    rain.width = 4000.0f;
+    particles.burst(rain, Vec2(0.0f, 0.0f));
+    ASSERT_EQ(particles.getStats().activeParticles, count);
+
+    auto run = [&](JobSystem* jobs) {
+        particles.setJobSystem(jobs);
+        auto start = BenchClock::now();
+        for (int i = 0; i < frames; ++i) particles.update(kDt);
+        return elapsedMs(start);
+    };
+
+    double serialMs = run(nullptr);
+    JobSystem jobs;
+    jobs.start(JobSystem::defaultWorkerCount());
+    double parallelMs = run(&jobs);
+
+    const double simulated = static_cast<double>(count) * frames;
+    std::printf("[   BENCH  ] Particle update (%zu particles): %.0f particles/ms serial, "
+                "%.0f particles/ms on %u workers\n",
+                count, simulated / serialMs, simulated / parallelMs, jobs.workerCount());
+
+    EXPECT_EQ(particles.getStats().activeParticles, count);
+}
+
+} // namespace
+
+TEST(Performance, ParticleUpdate10k) {
+    benchParticleUpdate(10000, 120);
+}
+
+TEST(Performance, ParticleUpdate200k) {
+    benchParticleUpdate(200000, 30);
+}
+
+// ============================================================================
+// Sprite batching
+// ============================================================================
+
+TEST(Performance, SpriteBatchFlush20kSprites) {
+    constexpr int kSprites = 20000;
+    constexpr int kFrames = 60;
+
+    NullRenderer renderer;
+    renderer.init(1280, 720);
+    Camera camera(1280.0f, 720.0f);
+    camera.setPosition(640.0f, 360.0f);
+
+    std::vector<std::unique_ptr<Texture>> textures;
+    for (unsigned int i = 0; i < 16; ++i) {
+        textures.push_back(std::make_unique<Texture>(32, 32, i + 1));
+    }
+
+    SpriteBatch batch(&renderer);
+    batch.setCamera(&camera);
+
+    auto start = BenchClock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        renderer.beginFrame();
+        batch.begin();
+        for (int i = 0; i < kSprites; ++i) {
+            SpriteData sprite(textures[static_cast<size_t>(i * 31) % textures.size()].get(),
+                              Vec2(static_cast<float>((i * 37) % 1280),
+                                   static_cast<float>((i * 53) % 720)));
+            sprite.rotation = static_cast<float>(i % 360);
+            sprite.layer = i % 6;
+            batch.draw(sprite);
+        }
+        batch.end();
+    }
+    double ms = elapsedMs(start) / kFrames;
+
+    std::printf("[   BENCH  ] SpriteBatch (%d sprites, %zu textures): %.3f ms/frame, "
+                "%zu draw calls\n",
+                kSprites, textures.size(), ms, batch.getDrawCallCount());
+
+    EXPECT_LE(batch.getDrawCallCount(), 6u * textures.size());
+    EXPECT_EQ(renderer.batchedQuadCount(), static_cast<size_t>(kSprites));
+}
+
+// ============================================================================
+// Lua bytecode cache
+// ============================================================================
+
+/// Loads the same set of generated scripts with an empty cache (compile and
+/// dump every one, as on first launch) and again from a fresh Lua state
+/// (every chunk served from disk, as on the next launch).
+TEST(Performance, LuaScriptLoadColdVsWarm) {
+    constexpr int kScripts = 48;
+    constexpr int kFunctionsPerScript = 150;
+
+    std::string benchDir = (std::filesystem::temp_directory_path() /
+                            "gloaming_bench_luac").string();
+    std::filesystem::remove_all(benchDir);
+    std::filesystem::create_directories(benchDir + "/scripts");
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < kScripts; ++i) {
+        std::string source = "local M = {}\n";
+        for (int f = 0; f < kFunctionsPerScript; ++f) {
+            std::string name = "fn" + std::to_string(f);
+            source += "function M." + name + "(a, b)\n"
+                      "    local t = {x = a, y = b, name = '" + name + "'}\n"
+                      "    for k = 1, 4 do t.x = t.x + k * " + std::to_string(i + 1) + " end\n"
+                      "    if t.x > t.y then return t.x - t.y else return t.y - t.x end\n"
+                      "end\n";
+        }
+        source += "return M\n";
+
+        paths.push_back(benchDir + "/scripts/s" + std::to_string(i) + ".lua");
+        std::ofstream(paths.back(), std::ios::binary) << source;
+    }
+
+    Engine engine;
+    ContentRegistry registry;
+    EventBus eventBus;
+
+    auto loadAll = [&](LuaBindings& bindings) {
+        std::string error;
+        for (const auto& path : paths) {
+            sol::protected_function chunk = bindings.loadScript(path, error);
+            ASSERT_TRUE(chunk.valid()) << error;
+        }
+    };
+
+    LuaBindings cold;
+    cold.init(engine, registry, eventBus);
+    cold.setBytecodeCacheDirectory(benchDir + "/cache");
+    auto start = BenchClock::now();
+    loadAll(cold);
+    double coldMs = elapsedMs(start);
+    cold.shutdown();
+
+    LuaBindings warm;
+    warm.init(engine, registry, eventBus);
+    warm.setBytecodeCacheDirectory(benchDir + "/cache");
+    start = BenchClock::now();
+    loadAll(warm);
+    double warmMs = elapsedMs(start);
+    warm.shutdown();
+
+    std::printf("[   BENCH  ] Lua script load (%d scripts): cold %.2f ms, warm %.2f ms "
+                "(%.1fx)\n",
+                kScripts, coldMs, warmMs, warmMs > 0.0 ? coldMs / warmMs : 0.0);
+
+    EXPECT_EQ(cold.bytecodeCacheMisses(), static_cast<size_t>(kScripts));
+    EXPECT_EQ(warm.bytecodeCacheHits(), static_cast<size_t>(kScripts));
+    EXPECT_EQ(warm.bytecodeCacheMisses(), 0u);
+
+    std::filesystem::remove_all(benchDir);
+}
+
+// ============================================================================
+// Content lookups
+// ============================================================================
+
+/// Resolves the same item references by qualified string (hash per lookup)
+/// and by runtime ID (array index), as gameplay code does per frame.
+TEST(Performance, ContentLookupStringVsRuntimeId) {
+    constexpr int kItems = 2000;
+    constexpr int kLookups = 1'000'000;
+
+    ContentRegistry registry;
+    std::vector<std::string> qualifiedIds;
+    std::vector<uint16_t> runtimeIds;
+    for (int i = 0; i < kItems; ++i) {
+        ItemDefinition item;
+        item.id = "item_" + std::to_string(i);
+        item.qualifiedId = "bench-mod:" + item.id;
+        item.maxStack = i;
+        qualifiedIds.push_back(item.qualifiedId);
+        runtimeIds.push_back(registry.registerItem(item));
+    }
+
+    long long stringSum = 0;
+    auto start = BenchClock::now();
+    for (int i = 0; i < kLookups; ++i) {
+        stringSum += registry.getItem(qualifiedIds[static_cast<size_t>(i % kItems)])->maxStack;
+    }
+    double stringMs = elapsedMs(start);
+
+    long long runtimeSum = 0;
+    start = BenchClock::now();
+    for (int i = 0; i < kLookups; ++i) {
+        runtimeSum += registry.getItemByRuntime(runtimeIds[static_cast<size_t>(i % kItems)])->maxStack;
+    }
+    double runtimeMs = elapsedMs(start);
+
+    std::printf("[   BENCH  ] Content lookup (%d lookups): string %.2f ms, runtime ID %.2f ms "
+                "(%.1fx)\n",
+                kLookups, stringMs, runtimeMs, runtimeMs > 0.0 ? stringMs / runtimeMs : 0.0);
+
+    EXPECT_EQ(stringSum, runtimeSum);
+}
@@ -5,11 +5,16 @@
 #include "physics/Trigger.hpp"
 #include "physics/Raycast.hpp"
 #include "physics/PhysicsSystem.hpp"
+#include "physics/SpatialIndex.hpp"
 #include "ecs/Registry.hpp"
 #include "ecs/Components.hpp"
 #include "rendering/TileRenderer.hpp"
+#include "engine/Engine.hpp"
+#include "engine/JobSystem.hpp"
 #include <map>
 #include <algorithm>
+#include <filesystem>
+#include <random>
 
 using namespace gloaming;
 
@@ -693,6 +698,26 @@ TEST(TileCollisionWithMapTest, MoveAABBHitFloor) {
     EXPECT_LT(result.newPosition.y, 160.0f);  // Should be above the floor
 }
 
+TEST(TileCollisionWithMapTest, MoveAABBIterationsCappedToCollisionList) {
+    MockTileProvider provider;
+    // Wall at tile x=10 and floor at tile y=10, meeting in a corner
+    for (int y = 5; y <= 10; ++y) provider.setSolid(10, y);
+    for (int x = 5; x <= 10; ++x) provider.setSolid(x, 10);
+
+    TileCollision collision;
+    collision.setTileSize(16);
+    collision.setTileCallback(provider.getCallback());
+    collision.getConfig().maxIterations = 100;
+
+    AABB aabb(Vec2(140.0f, 140.0f), Vec2(8.0f, 8.0f));
+    auto result = collision.moveAABB(aabb, Vec2(50.0f, 50.0f), true, false);
+
+    EXPECT_TRUE(result.hitHorizontal);
+    EXPECT_TRUE(result.hitVertical);
+    EXPECT_EQ(result.collisions.size(), 2u);
+    EXPECT_LE(result.collisions.size(), TileCollisionList::kCapacity);
+}
+
 TEST(TileCollisionWithMapTest, MoveAABBOnPlatformFallingThrough) {
     MockTileProvider provider;
     // Create a one-way platform
@@ -770,6 +795,90 @@ TEST(TileCollisionWithMapTest, CheckGroundBelowNotGrounded) {
     EXPECT_FALSE(grounded);
 }
 
+TEST(TileCollisionWithMapTest, TileMapPathMatchesPerTileLookup) {
+    // The TileMap path reads chunk rows directly; a callback over
+    // TileMap::getTile goes tile by tile. Both must resolve identically,
+    // including across chunk boundaries and at negative coordinates.
+    std::string worldDir = "test_tile_collision_world";
+    std::filesystem::remove_all(worldDir);
+
+    TileMap tileMap;
+    ASSERT_TRUE(tileMap.createWorld(worldDir, "Collision", 7));
+
+    for (int edge : {0, CHUNK_SIZE}) {
+        for (int x = edge - 8; x <= edge + 8; ++x) {
+            for (int y = edge - 8; y <= edge + 3; ++y) {
+                tileMap.setTileId(x, y, 0);
+            }
+            tileMap.setTileId(x, edge + 4, 1, 0, Tile::FLAG_SOLID);
+        }
+        for (int y = edge - 6; y <= edge + 3; ++y) {
+            tileMap.setTileId(edge, y, 1, 0, Tile::FLAG_SOLID);
+        }
+        for (int x = edge - 6; x <= edge - 2; ++x) {
+            tileMap.setTileId(x, edge - 2, 2, 0, Tile::FLAG_PLATFORM);
+        }
+        tileMap.setTileId(edge + 3, edge + 3, 3, 0, Tile::FLAG_SOLID | TilePhysicsFlags::SLOPE_LEFT);
+    }
+
+    TileCollision direct;
+    direct.setTileSize(16);
+    direct.setTileMap(&tileMap);
+
+    TileCollision perTile;
+    perTile.setTileSize(16);
+    perTile.setTileCallback([&tileMap](int x, int y) { return tileMap.getTile(x, y); });
+
+    const Vec2 velocities[] = {
+        Vec2(40.0f, 30.0f), Vec2(-35.0f, 45.0f), Vec2(20.0f, -50.0f),
+        Vec2(0.0f, 60.0f), Vec2(-60.0f, 0.0f)
+    };
+
+    int hits = 0;
+    for (int edge : {0, CHUNK_SIZE}) {
+        float base = static_cast<float>(edge * 16);
+        for (float x = base - 112.0f; x <= base + 112.0f; x += 5.0f) {
+            for (float y = base - 112.0f; y <= base + 48.0f; y += 7.0f) {
+                AABB aabb(Vec2(x, y), Vec2(6.0f, 10.0f));
+                for (Vec2 velocity : velocities) {
+                    auto a = direct.moveAABB(aabb, velocity, true, false);
+                    auto b = perTile.moveAABB(aabb, velocity, true, false);
+                    ASSERT_EQ(a.newPosition.x, b.newPosition.x) << "at " << x << "," << y;
+                    ASSERT_EQ(a.newPosition.y, b.newPosition.y) << "at " << x << "," << y;
+                    ASSERT_EQ(a.hitHorizontal, b.hitHorizontal);
+                    ASSERT_EQ(a.hitVertical, b.hitVertical);
+                    ASSERT_EQ(a.onGround, b.onGround);
+                    ASSERT_EQ(a.onSlope, b.onSlope);
+                    ASSERT_EQ(a.onPlatform, b.onPlatform);
+                    ASSERT_EQ(a.collisions.size(), b.collisions.size());
+                    for (size_t i = 0; i < a.collisions.size(); ++i) {
+                        EXPECT_EQ(a.collisions[i].tileX, b.collisions[i].tileX);
+                        EXPECT_EQ(a.collisions[i].tileY, b.collisions[i].tileY);
+                    }
+
+                    auto sweepA = direct.sweepAABBTiles(aabb, velocity);
+                    auto sweepB = perTile.sweepAABBTiles(aabb, velocity);
+                    ASSERT_EQ(sweepA.hit, sweepB.hit);
+                    ASSERT_EQ(sweepA.time, sweepB.time);
+
+                    hits += (a.hitHorizontal || a.hitVertical) ? 1 : 0;
+                }
+
+                auto overlapA = direct.testAABBTileCollision(aabb);
+                auto overlapB = perTile.testAABBTileCollision(aabb);
+                ASSERT_EQ(overlapA.collided, overlapB.collided);
+                ASSERT_EQ(overlapA.tileX, overlapB.tileX);
+                ASSERT_EQ(overlapA.tileY, overlapB.tileY);
+                ASSERT_EQ(direct.doesAABBOverlapSolid(aabb), perTile.doesAABBOverlapSolid(aabb));
+            }
+        }
+    }
+    EXPECT_GT(hits, 0);
+
+    tileMap.closeWorld();
+    std::filesystem::remove_all(worldDir);
+}
+
 // ============================================================================
 // PhysicsSystem Integration Tests
 // ============================================================================
@@ -868,6 +977,106 @@ TEST(PhysicsSystemTest, CollisionCallback) {
     EXPECT_FLOAT_EQ(events[0].normal.y, -1.0f);
 }
 
+// ============================================================================
+// Parallel Integration Tests
+// ============================================================================
+// These do run PhysicsSystem::update(): init() only needs the registry and the
+// engine's job system, so a default-constructed Engine is enough.
+
+namespace {
+
+struct PhysicsRun {
+    struct Recorded {
+        Entity entity;
+        int tileX, tileY;
+        float normalX, normalY;
+    };
+
+    Registry registry;
+    PhysicsSystem physics;
+    std::vector<Recorded> events;
+
+    PhysicsRun(Engine& engine, TileMap& tileMap, JobSystem* jobs, size_t grain) {
+        physics.getConfig().parallelGrain = grain;
+        physics.init(registry, engine);
+        physics.setJobSystem(jobs);
+        physics.setTileMap(&tileMap);
+        physics.onCollision([this](const CollisionEvent& e) {
+            events.push_back({e.entity, e.tileX, e.tileY, e.normal.x, e.normal.y});
+        });
+
+        for (int i = 0; i < 1500; ++i) {
+            float x = 40.0f + static_cast<float>((i * 53) % 3900);
+            float y = 40.0f + static_cast<float>((i * 29) % 500);
+            float vx = (i % 2 ? 1.0f : -1.0f) * static_cast<float>(30 + i % 150);
+            // Every tenth body is fast enough to take the swept path
+            if (i % 10 == 0) vx *= 4.0f;
+            Entity e = registry.create(Transform{Vec2(x, y)}, Velocity{Vec2(vx, 0.0f)},
+                                       Collider{Vec2(10.0f, 14.0f)}, Gravity{});
+            // Keep bodies out of each other's way so only tile collision matters
+            registry.get<Collider>(e).mask = CollisionLayer::Tile;
+        }
+    }
+};
+
+} // namespace
+
+TEST(PhysicsParallelTest, ParallelIntegrationMatchesSerial) {
+    std::string worldDir = "test_physics_parallel_world";
+    std::filesystem::remove_all(worldDir);
+
+    TileMap tileMap;
+    ASSERT_TRUE(tileMap.createWorld(worldDir, "Parallel", 3));
+    for (int x = 0; x < 256; ++x) {
+        for (int y = 0; y < 40; ++y) {
+            bool wall = (x % 20 == 0) && y >= 30;
+            tileMap.setTileId(x, y, wall ? 1 : 0, 0, wall ? Tile::FLAG_SOLID : 0);
+        }
+        tileMap.setTileId(x, 40, 1, 0, Tile::FLAG_SOLID);
+        if (x % 7 < 3) tileMap.setTileId(x, 34, 2, 0, Tile::FLAG_PLATFORM);
+    }
+
+    JobSystem jobs;
+    jobs.start(3);
+    Engine engine;
+
+    PhysicsRun serial(engine, tileMap, nullptr, 0);
+    PhysicsRun parallel(engine, tileMap, &jobs, 64);
+
+    for (int frame = 0; frame < 90; ++frame) {
+        serial.physics.update(1.0f / 60.0f);
+        parallel.physics.update(1.0f / 60.0f);
+        ASSERT_EQ(serial.physics.getStats().tileCollisions,
+                  parallel.physics.getStats().tileCollisions) << "frame " << frame;
+    }
+    jobs.stop();
+
+    ASSERT_GT(serial.events.size(), 0u);
+    ASSERT_EQ(serial.events.size(), parallel.events.size());
+    for (size_t i = 0; i < serial.events.size(); ++i) {
+        const auto& a = serial.events[i];
+        const auto& b = parallel.events[i];
+        ASSERT_EQ(a.entity, b.entity) << "event " << i;
+        EXPECT_EQ(a.tileX, b.tileX);
+        EXPECT_EQ(a.tileY, b.tileY);
+        EXPECT_EQ(a.normalX, b.normalX);
+        EXPECT_EQ(a.normalY, b.normalY);
+    }
+
+    serial.registry.each<Transform, Velocity, Gravity>(
+        [&](Entity e, Transform& transform, Velocity& velocity, Gravity& gravity) {
+            ASSERT_TRUE(parallel.registry.valid(e));
+            EXPECT_EQ(transform.position.x, parallel.registry.get<Transform>(e).position.x);
+            EXPECT_EQ(transform.position.y, parallel.registry.get<Transform>(e).position.y);
+            EXPECT_EQ(velocity.linear.x, parallel.registry.get<Velocity>(e).linear.x);
+            EXPECT_EQ(velocity.linear.y, parallel.registry.get<Velocity>(e).linear.y);
+            EXPECT_EQ(gravity.grounded, parallel.registry.get<Gravity>(e).grounded);
+        });
+
+    tileMap.closeWorld();
+    std::filesystem::remove_all(worldDir);
+}
+
 // ============================================================================
 // Trigger Enter/Stay/Exit Tests
 // ============================================================================
@@ -1074,3 +1283,234 @@ TEST(TriggerCallbackTest, RemoveEntity) {
     tracker.removeEntity(movingEntity);
     EXPECT_EQ(tracker.getOverlapCount(), 0);
 }
+
+// ============================================================================
+// Spatial Index Tests
+// ============================================================================
+
+namespace {
+
+/// Random mix of point entities, small and oversized colliders, typed and untyped
+void populateSpatialWorld(Registry& registry, size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> size(2.0f, 60.0f);
+    const char* types[] = {"slime", "zombie", "arrow", ""};
+
+    for (size_t i = 0; i < count; ++i) {
+        Entity e = registry.create(Transform{Vec2(pos(rng), pos(rng))});
+        if (const char* type = types[i % 4]; type[0] != '\0') {
+            registry.add<Name>(e, "e", type);
+        }
+        if (i % 3 != 0) {
+            Collider c;
+            c.size = (i % 97 == 0) ? Vec2(3000.0f, 40.0f) : Vec2(size(rng), size(rng));
+            c.layer = 1u << (i % 4);
+            registry.add<Collider>(e, c);
+        }
+    }
+}
+
+/// Brute-force filter matching SpatialFilter semantics
+bool spatialMatches(Registry& registry, Entity e, const SpatialFilter& filter, const std::string& type) {
+    if (e == filter.ignore) return false;
+    if (filter.layerMask != 0) {
+        auto* c = registry.tryGet<Collider>(e);
+        if (!c || (c->layer & filter.layerMask) == 0) return false;
+    }
+    if (!type.empty()) {
+        auto* n = registry.tryGet<Name>(e);
+        if (!n || n->type != type) return false;
+    }
+    return true;
+}
+
+AABB spatialBounds(Registry& registry, Entity e) {
+    const auto& t = registry.get<Transform>(e);
+    if (auto* c = registry.tryGet<Collider>(e)) return Collision::getEntityAABB(t, *c);
+    return AABB(t.position, Vec2(0.0f, 0.0f));
+}
+
+std::vector<Entity> sortedEntities(std::vector<Entity> v) {
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+} // namespace
+
+TEST(SpatialIndexTest, QueriesMatchBruteForce) {
+    Registry registry;
+    populateSpatialWorld(registry, 3000, 7);
+
+    SpatialIndex index(96.0f);
+    index.sync(registry);
+    ASSERT_TRUE(index.isBuilt());
+    EXPECT_EQ(index.size(), 3000u);
+    EXPECT_NE(index.typeId("slime"), 0u);
+    EXPECT_EQ(index.typeId("dragon"), 0u);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> pos(-2200.0f, 2200.0f);
+    std::uniform_real_distribution<float> radius(0.0f, 600.0f);
+    const char* types[] = {"", "slime", "arrow"};
+    std::vector<Entity> got;
+
+    for (int q = 0; q < 200; ++q) {
+        Vec2 center(pos(rng), pos(rng));
+        float r = radius(rng);
+        std::string type = types[q % 3];
+        SpatialFilter filter;
+        filter.layerMask = (q % 5 == 0) ? 0x3u : 0u;
+        filter.typeId = index.typeId(type);
+
+        // Radius
+        std::vector<Entity> expected;
+        registry.each<Transform>([&](Entity e, Transform& t) {
+            if (spatialMatches(registry, e, filter, type) && (t.position - center).lengthSquared() <= r * r) {
+                expected.push_back(e);
+            }
+        });
+        index.queryRadius(center, r, filter, got);
+        ASSERT_EQ(sortedEntities(got), sortedEntities(expected)) << "radius query " << q;
+
+        // AABB
+        AABB area(center, Vec2(r, r * 0.5f));
+        expected.clear();
+        registry.each<Transform>([&](Entity e, Transform&) {
+            if (spatialMatches(registry, e, filter, type) && spatialBounds(registry, e).intersects(area)) {
+                expected.push_back(e);
+            }
+        });
+        index.queryAABB(area, filter, got);
+        ASSERT_EQ(sortedEntities(got), sortedEntities(expected)) << "aabb query " << q;
+
+        // k-nearest: compare distances, since ties may pick either entity
+        std::vector<float> expectedDist;
+        registry.each<Transform>([&](Entity e, Transform& t) {
+            float d = (t.position - center).lengthSquared();
+            if (spatialMatches(registry, e, filter, type) && d <= r * r) expectedDist.push_back(d);
+        });
+        std::sort(expectedDist.begin(), expectedDist.end());
+        size_t k = 1 + static_cast<size_t>(q % 12);
+        expectedDist.resize(std::min(k, expectedDist.size()));
+        index.queryNearest(center, k, r, filter, got);
+        ASSERT_EQ(got.size(), expectedDist.size()) << "nearest query " << q;
+        for (size_t i = 0; i < got.size(); ++i) {
+            EXPECT_FLOAT_EQ((registry.get<Transform>(got[i]).position - center).lengthSquared(), expectedDist[i]);
+        }
+
+        // Ray
+        float angle = static_cast<float>(q) * 0.37f;
+        Ray ray(center, Vec2(std::cos(angle), std::sin(angle)));
+        float maxDistance = r * 4.0f;
+        float expectedT = -1.0f;
+        registry.each<Transform>([&](Entity e, Transform&) {
+            if (!spatialMatches(registry, e, filter, type)) return;
+            float t = Raycast::raycastAABB(ray, spatialBounds(registry, e));
+            if (t >= 0.0f && t <= maxDistance && (expectedT < 0.0f || t < expectedT)) expectedT = t;
+        });
+        float hitT = 0.0f;
+        Entity hit = index.raycast(ray, maxDistance, filter, &hitT);
+        if (expectedT < 0.0f) {
+            EXPECT_EQ(hit, NullEntity) << "ray query " << q;
+        } else {
+            ASSERT_NE(hit, NullEntity) << "ray query " << q;
+            EXPECT_FLOAT_EQ(hitT, expectedT) << "ray query " << q;
+        }
+    }
+}
+
+TEST(SpatialIndexTest, UpdateRefreshesChangedEntitiesWithoutRebuild) {
+    Registry registry;
+    Entity first = registry.create(Transform{Vec2(1000.0f, 1000.0f)});
+    for (int i = 1; i < 100; ++i) {
+        registry.create(Transform{Vec2(1000.0f + i * 10.0f, 1000.0f)});
+    }
+    SpatialIndex index;
+    index.sync(registry);
+    const uint64_t rebuilds = index.rebuildCount();
+
+    std::vector<Entity> got;
+    index.queryRadius(Vec2(0.0f, 0.0f), 50.0f, SpatialFilter{}, got);
+    EXPECT_TRUE(got.empty());
+
+    Entity e = registry.create(Transform{Vec2(10.0f, 10.0f)}, Name{"e", "slime"});
+    EXPECT_FALSE(index.isCurrent(registry));
+    index.update(registry);
+    EXPECT_TRUE(index.isCurrent(registry));
+    EXPECT_EQ(index.size(), 101u);
+
+    SpatialFilter filter;
+    filter.typeId = index.typeId("slime");
+    EXPECT_NE(filter.typeId, 0u);
+    index.queryRadius(Vec2(0.0f, 0.0f), 50.0f, filter, got);
+    ASSERT_EQ(got.size(), 1u);
+    EXPECT_EQ(got[0], e);
+
+    // Moved in place: found at the new position only
+    registry.get<Transform>(e).position = Vec2(500.0f, 500.0f);
+    registry.touch(e);
+    index.update(registry);
+    index.queryRadius(Vec2(0.0f, 0.0f), 50.0f, SpatialFilter{}, got);
+    EXPECT_TRUE(got.empty());
+    index.queryRadius(Vec2(500.0f, 500.0f), 50.0f, filter, got);
+    ASSERT_EQ(got.size(), 1u);
+    EXPECT_EQ(got[0], e);
+
+    // A synced entity moved away leaves its old cell
+    Vec2 was = registry.get<Transform>(first).position;
+    registry.get<Transform>(first).position = Vec2(-800.0f, 0.0f);
+    registry.touch(first);
+    index.update(registry);
+    index.queryRadius(was, 1.0f, SpatialFilter{}, got);
+    EXPECT_TRUE(got.empty());
+    index.queryRadius(Vec2(-800.0f, 0.0f), 1.0f, SpatialFilter{}, got);
+    ASSERT_EQ(got.size(), 1u);
+    EXPECT_EQ(got[0], first);
+
+    registry.destroy(e);
+    index.update(registry);
+    index.queryRadius(Vec2(500.0f, 500.0f), 50.0f, SpatialFilter{}, got);
+    EXPECT_TRUE(got.empty());
+    EXPECT_EQ(index.size(), 100u);
+    EXPECT_EQ(index.rebuildCount(), rebuilds);
+
+    // A bulk touch rebuilds; interned IDs survive it
+    uint32_t slime = filter.typeId;
+    registry.create(Transform{Vec2(0.0f, 0.0f)}, Name{"f", "slime"});
+    registry.touch();
+    index.update(registry);
+    EXPECT_EQ(index.rebuildCount(), rebuilds + 1);
+    EXPECT_EQ(index.typeId("slime"), slime);
+    index.queryRadius(Vec2(0.0f, 0.0f), 50.0f, filter, got);
+    EXPECT_EQ(got.size(), 1u);
+}
+
+TEST(SpatialIndexTest, IgnoreAndLayerFilters) {
+    Registry registry;
+    Entity self = registry.create(Transform{Vec2(0.0f, 0.0f)}, Collider{});
+    Collider enemyCollider;
+    enemyCollider.layer = CollisionLayer::Enemy;
+    Entity enemy = registry.create(Transform{Vec2(20.0f, 0.0f)}, enemyCollider);
+    registry.create(Transform{Vec2(30.0f, 0.0f)});  // no collider
+
+    SpatialIndex index;
+    index.sync(registry);
+
+    SpatialFilter filter;
+    filter.ignore = self;
+    std::vector<Entity> got;
+    index.queryNearest(Vec2(0.0f, 0.0f), 1, 100.0f, filter, got);
+    ASSERT_EQ(got.size(), 1u);
+    EXPECT_EQ(got[0], enemy);
+
+    filter.layerMask = CollisionLayer::Enemy;
+    index.queryRadius(Vec2(0.0f, 0.0f), 100.0f, filter, got);
+    ASSERT_EQ(got.size(), 1u);
+    EXPECT_EQ(got[0], enemy);
+
+    float distance = 0.0f;
+    Entity hit = index.raycast(Ray(Vec2(-50.0f, 0.0f), Vec2(1.0f, 0.0f)), 200.0f, filter, &distance);
+    EXPECT_EQ(hit, enemy);
+    EXPECT_NEAR(distance, 20.0f - enemyCollider.size.x * 0.5f + 50.0f, 0.001f);
+}
@@ -1,9 +1,14 @@
 #include <gtest/gtest.h>
 
 #include "engine/Profiler.hpp"
+#include "engine/JobSystem.hpp"
 #include "engine/ResourceManager.hpp"
 #include "engine/DiagnosticOverlay.hpp"
 
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
 using namespace gloaming;
 
 // =============================================================================
@@ -212,6 +217,153 @@ TEST_F(ProfilerTest, MinMaxFrameTime) {
     EXPECT_LE(profiler.minFrameTimeMs(), profiler.maxFrameTimeMs());
 }
 
+TEST_F(ProfilerTest, NestedZonesRecordHierarchy) {
+    profiler.beginFrame();
+    {
+        auto outer = profiler.scopedZone("Outer");
+        {
+            auto inner = profiler.scopedZone("Inner");
+            EXPECT_EQ(profiler.openZoneDepth(), 2u);
+        }
+    }
+    profiler.endFrame();
+
+    auto outer = profiler.getZoneStats("Outer");
+    auto inner = profiler.getZoneStats("Inner");
+    EXPECT_EQ(outer.depth, 0u);
+    EXPECT_EQ(outer.parentId, ProfileZoneStats::kNoParent);
+    EXPECT_EQ(inner.depth, 1u);
+    EXPECT_EQ(inner.parentId, Profiler::zoneId("Outer"));
+    EXPECT_LE(inner.lastTimeMs, outer.lastTimeMs);
+
+    // Parents are listed before their children
+    const auto& all = profiler.getAllZoneStats();
+    ASSERT_EQ(all.size(), 2u);
+    EXPECT_EQ(all[0].name, "Outer");
+    EXPECT_EQ(all[1].name, "Inner");
+}
+
+TEST_F(ProfilerTest, ZoneIdsMatchNames) {
+    ProfileZoneId id = Profiler::zoneId("IdZone");
+    EXPECT_EQ(Profiler::zoneId("IdZone"), id);
+    EXPECT_EQ(Profiler::zoneName(id), "IdZone");
+
+    profiler.beginFrame();
+    profiler.beginZone(id);
+    profiler.endZone("IdZone");
+    { auto z = profiler.scopedZone(id); }
+    profiler.endFrame();
+
+    EXPECT_EQ(profiler.getZoneStats("IdZone").sampleCount, 2u);
+}
+
+TEST_F(ProfilerTest, CaptureWritesChromeTrace) {
+    auto path = (std::filesystem::temp_directory_path() / "gloaming_test_trace.json").string();
+    std::filesystem::remove(path);
+
+    EXPECT_TRUE(profiler.capture(2, path));
+    EXPECT_TRUE(profiler.isCapturing());
+    EXPECT_FALSE(profiler.capture(5, path)); // already pending
+
+    for (int i = 0; i < 3; ++i) {
+        profiler.beginFrame();
+        {
+            auto outer = profiler.scopedZone("TraceOuter");
+            auto inner = profiler.scopedZone("TraceInner");
+        }
+        profiler.endFrame();
+    }
+
+    EXPECT_FALSE(profiler.isCapturing());
+    EXPECT_EQ(profiler.lastCapturePath(), path);
+    // 2 frames x (Frame + 2 zones); the third frame was not captured
+    EXPECT_EQ(profiler.capturedEventCount(), 6u);
+    EXPECT_EQ(profiler.droppedTraceEvents(), 0u);
+
+    std::ifstream file(path);
+    ASSERT_TRUE(file.good());
+    std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"TraceOuter\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"TraceInner\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Frame\""), std::string::npos);
+    EXPECT_NE(json.find("\"thread_name\""), std::string::npos);
+
+    file.close();
+    std::filesystem::remove(path);
+}
+
+TEST_F(ProfilerTest, CaptureRecordsWorkerThreads) {
+    auto path = (std::filesystem::temp_directory_path() / "gloaming_test_trace_mt.json").string();
+    ASSERT_TRUE(profiler.capture(1, path));
+
+    profiler.beginFrame();
+    {
+        auto z = profiler.scopedZone("MainWork");
+        std::thread worker([this]() {
+            profiler.setThreadName("Worker 1");
+            auto wz = profiler.scopedZone("WorkerJob");
+        });
+        worker.join();
+    }
+    profiler.endFrame();
+
+    std::ifstream file(path);
+    ASSERT_TRUE(file.good());
+    std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    EXPECT_NE(json.find("\"WorkerJob\""), std::string::npos);
+    EXPECT_NE(json.find("\"Worker 1\""), std::string::npos);
+
+    // Worker zones are traced but do not feed the main-thread stats
+    EXPECT_EQ(profiler.getZoneStats("WorkerJob").sampleCount, 0u);
+    EXPECT_EQ(profiler.getZoneStats("MainWork").sampleCount, 1u);
+    std::filesystem::remove(path);
+}
+
+TEST_F(ProfilerTest, CaptureIsWrittenInBackground) {
+    JobSystem jobs;
+    jobs.start(2);
+    profiler.setBackgroundTraceWrites(true);
+
+    auto path = (std::filesystem::temp_directory_path() / "gloaming_test_trace_job.json").string();
+    std::filesystem::remove(path);
+    ASSERT_TRUE(profiler.capture(1, path));
+    profiler.beginFrame();
+    { auto z = profiler.scopedZone("JobTraced"); }
+    profiler.endFrame();
+
+    EXPECT_FALSE(profiler.isCapturing());
+    EXPECT_EQ(profiler.lastCapturePath(), path);
+    EXPECT_EQ(profiler.capturedEventCount(), 2u);
+
+    // The write is not a job, so a main thread helping the pool can't run it
+    EXPECT_FALSE(jobs.tryRunOne());
+
+    profiler.waitForTraceWrites();
+    EXPECT_FALSE(profiler.isWritingTrace());
+    std::ifstream file(path);
+    ASSERT_TRUE(file.good());
+    std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    EXPECT_NE(json.find("\"JobTraced\""), std::string::npos);
+
+    jobs.stop();
+    std::filesystem::remove(path);
+}
+
+TEST_F(ProfilerTest, CaptureEnablesProfiler) {
+    profiler.setEnabled(false);
+    EXPECT_FALSE(profiler.capture(0));
+    auto path = (std::filesystem::temp_directory_path() / "gloaming_test_trace_en.json").string();
+    EXPECT_TRUE(profiler.capture(1, path));
+    EXPECT_TRUE(profiler.isEnabled());
+    profiler.beginFrame();
+    profiler.endFrame();
+    EXPECT_FALSE(profiler.isCapturing());
+    std::filesystem::remove(path);
+}
+
 // =============================================================================
 // ResourceManager Tests
 // =============================================================================
@@ -427,6 +579,19 @@ TEST_F(DiagnosticOverlayTest, RenderWhenOffIsNoOp) {
     // any of its arguments — including the renderer and engine pointers.
 }
 
+TEST_F(DiagnosticOverlayTest, TriggerCaptureStartsProfilerCapture) {
+    Profiler profiler;
+    overlay.setCaptureFrames(3);
+    EXPECT_EQ(overlay.getCaptureFrames(), 3);
+
+    EXPECT_TRUE(overlay.triggerCapture(profiler));
+    EXPECT_TRUE(profiler.isCapturing());
+    EXPECT_EQ(profiler.captureFramesRemaining(), 3);
+
+    // A second trigger while capturing is refused
+    EXPECT_FALSE(overlay.triggerCapture(profiler));
+}
+
 // =============================================================================
 // Integration: Profiler + ResourceManager together
 // =============================================================================
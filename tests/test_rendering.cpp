@@ -3,6 +3,16 @@
 #include "rendering/Camera.hpp"
 #include "rendering/Texture.hpp"
 #include "rendering/TileRenderer.hpp"
+#include "rendering/NullRenderer.hpp"
+#include "rendering/SpriteBatch.hpp"
+#include "rendering/AtlasPacker.hpp"
+#include "gameplay/SpriteAnimation.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 using namespace gloaming;
 
@@ -469,3 +479,469 @@ TEST(TileTest, MultipleFlags) {
     EXPECT_TRUE(tile.isSolid());
     EXPECT_TRUE((tile.flags & Tile::FLAG_PLATFORM) != 0);
 }
+
+// =============================================================================
+// NullRenderer Tests
+// =============================================================================
+
+TEST(NullRendererTest, ReportsScreenSizeAndCountsDraws) {
+    NullRenderer renderer;
+    ASSERT_TRUE(renderer.init(640, 360));
+    EXPECT_EQ(renderer.getScreenWidth(), 640);
+    EXPECT_EQ(renderer.getScreenHeight(), 360);
+
+    renderer.beginFrame();
+    renderer.drawRectangle(Rect(0, 0, 10, 10), Color::White());
+    renderer.drawText("hi", {0, 0}, 20, Color::White());
+    EXPECT_EQ(renderer.drawCallCount(), 2u);
+    renderer.endFrame();
+
+    renderer.beginFrame();
+    EXPECT_EQ(renderer.drawCallCount(), 0u);
+    EXPECT_EQ(renderer.measureTextWidth("abcd", 20), 40);
+}
+
+TEST(NullRendererTest, CountsQuadBatches) {
+    NullRenderer renderer;
+    renderer.init(640, 360);
+
+    QuadVertex quads[8] = {};
+    renderer.beginFrame();
+    renderer.drawQuadBatch(nullptr, BlendMode::Alpha, quads, 2);
+    renderer.drawQuadBatch(nullptr, BlendMode::Additive, quads, 1);
+    renderer.drawRectangle(Rect(0, 0, 10, 10), Color::White());
+    EXPECT_EQ(renderer.drawCallCount(), 3u);
+    EXPECT_EQ(renderer.quadBatchCount(), 2u);
+    EXPECT_EQ(renderer.batchedQuadCount(), 3u);
+
+    renderer.beginFrame();
+    EXPECT_EQ(renderer.quadBatchCount(), 0u);
+    EXPECT_EQ(renderer.batchedQuadCount(), 0u);
+}
+
+TEST(NullRendererTest, TexturesReadPngSize) {
+    // Minimal PNG signature + IHDR header for a 48x16 image
+    const unsigned char png[] = {
+        0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n',
+        0, 0, 0, 13, 'I', 'H', 'D', 'R',
+        0, 0, 0, 48, 0, 0, 0, 16, 8, 6, 0, 0, 0};
+    auto path = (std::filesystem::temp_directory_path() / "gloaming_null_renderer.png").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(png), sizeof(png));
+    }
+
+    NullRenderer renderer;
+    renderer.init(640, 360);
+    Texture* texture = renderer.loadTexture(path);
+    ASSERT_NE(texture, nullptr);
+    EXPECT_TRUE(texture->isValid());
+    EXPECT_EQ(texture->getWidth(), 48);
+    EXPECT_EQ(texture->getHeight(), 16);
+    EXPECT_EQ(renderer.textureCount(), 1u);
+
+    EXPECT_EQ(renderer.loadTexture(path + ".missing"), nullptr);
+
+    renderer.unloadTexture(texture);
+    EXPECT_EQ(renderer.textureCount(), 0u);
+    std::filesystem::remove(path);
+}
+
+// =============================================================================
+// SpriteBatch Tests
+// =============================================================================
+
+namespace {
+
+/// NullRenderer that keeps each quad batch for inspection
+class BatchRecordingRenderer : public NullRenderer {
+public:
+    struct Batch {
+        const Texture* texture;
+        BlendMode blend;
+        std::vector<QuadVertex> vertices;
+    };
+
+    void drawQuadBatch(const Texture* texture, BlendMode blend,
+                       const QuadVertex* vertices, size_t quadCount) override {
+        NullRenderer::drawQuadBatch(texture, blend, vertices, quadCount);
+        batches.push_back({texture, blend,
+                           std::vector<QuadVertex>(vertices, vertices + quadCount * 4)});
+    }
+
+    std::vector<Batch> batches;
+};
+
+} // namespace
+
+TEST(SpriteBatchTest, GroupsTexturesWithinLayer) {
+    BatchRecordingRenderer renderer;
+    renderer.init(640, 360);
+    Texture a(16, 16, 1), b(16, 16, 2);
+
+    SpriteBatch batch(&renderer);
+    batch.begin();
+    for (int i = 0; i < 100; ++i) {
+        batch.draw(i % 2 ? &a : &b, Vec2(static_cast<float>(i), 0.0f));
+    }
+    batch.end();
+
+    EXPECT_EQ(batch.getDrawCallCount(), 2u);
+    ASSERT_EQ(renderer.batches.size(), 2u);
+    EXPECT_EQ(renderer.batches[0].vertices.size(), 200u);
+    EXPECT_EQ(renderer.batches[1].vertices.size(), 200u);
+}
+
+TEST(SpriteBatchTest, LayersDrawInOrder) {
+    BatchRecordingRenderer renderer;
+    renderer.init(640, 360);
+    Texture a(16, 16, 1), b(16, 16, 2);
+
+    SpriteBatch batch(&renderer);
+    batch.begin();
+    batch.draw(&a, Rect(0, 0, 16, 16), Vec2(0, 0), Vec2(0, 0), Vec2(1, 1), 0.0f,
+               Color::White(), 5);
+    batch.draw(&b, Rect(0, 0, 16, 16), Vec2(0, 0), Vec2(0, 0), Vec2(1, 1), 0.0f,
+               Color::White(), -3);
+    batch.draw(&a, Rect(0, 0, 16, 16), Vec2(0, 0), Vec2(0, 0), Vec2(1, 1), 0.0f,
+               Color::White(), 0);
+    SpriteData additive(&a, Vec2(0, 0));
+    additive.layer = 0;
+    additive.blend = BlendMode::Additive;
+    batch.draw(additive);
+    batch.end();
+
+    // -3: b, 0: a (alpha), 0: a (additive), 5: a
+    ASSERT_EQ(renderer.batches.size(), 4u);
+    EXPECT_EQ(renderer.batches[0].texture, &b);
+    EXPECT_EQ(renderer.batches[1].texture, &a);
+    EXPECT_EQ(renderer.batches[1].blend, BlendMode::Alpha);
+    EXPECT_EQ(renderer.batches[2].blend, BlendMode::Additive);
+    EXPECT_EQ(renderer.batches[3].texture, &a);
+    EXPECT_EQ(renderer.batches[3].blend, BlendMode::Alpha);
+}
+
+TEST(SpriteBatchTest, UnsortedBatchesOnlyAdjacentSprites) {
+    NullRenderer renderer;
+    renderer.init(640, 360);
+    Texture a(16, 16, 1), b(16, 16, 2);
+
+    SpriteBatch batch(&renderer);
+    batch.setSortEnabled(false);
+    batch.begin();
+    batch.draw(&a, Vec2(0, 0));
+    batch.draw(&a, Vec2(1, 0));
+    batch.draw(&b, Vec2(2, 0));
+    batch.draw(&a, Vec2(3, 0));
+    batch.end();
+
+    EXPECT_EQ(batch.getDrawCallCount(), 3u);
+}
+
+TEST(SpriteBatchTest, QuadsMatchCameraTransform) {
+    BatchRecordingRenderer renderer;
+    renderer.init(640, 360);
+    Texture tex(64, 32, 1);
+    Camera camera(640.0f, 360.0f);
+    camera.setPosition(100.0f, 50.0f);
+    camera.setZoom(2.0f);
+
+    SpriteBatch batch(&renderer);
+    batch.setCamera(&camera);
+    batch.begin();
+    // Right half of the texture, pivot at its centre, flipped horizontally
+    batch.draw(&tex, Rect(32, 0, 32, 32), Vec2(110.0f, 60.0f), Vec2(0.5f, 0.5f),
+               Vec2(-1.0f, 1.0f), 0.0f, Color::Red(), 0);
+    batch.end();
+
+    ASSERT_EQ(renderer.batches.size(), 1u);
+    const auto& v = renderer.batches[0].vertices;
+    ASSERT_EQ(v.size(), 4u);
+
+    Vec2 topLeft = camera.worldToScreen(Vec2(94.0f, 44.0f));
+    Vec2 bottomRight = camera.worldToScreen(Vec2(126.0f, 76.0f));
+    EXPECT_NEAR(v[0].position.x, topLeft.x, 1e-3f);
+    EXPECT_NEAR(v[0].position.y, topLeft.y, 1e-3f);
+    EXPECT_NEAR(v[2].position.x, bottomRight.x, 1e-3f);
+    EXPECT_NEAR(v[2].position.y, bottomRight.y, 1e-3f);
+
+    // Flipped: left edge samples u = 1, right edge u = 0.5
+    EXPECT_FLOAT_EQ(v[0].uv.x, 1.0f);
+    EXPECT_FLOAT_EQ(v[2].uv.x, 0.5f);
+    EXPECT_FLOAT_EQ(v[0].uv.y, 0.0f);
+    EXPECT_FLOAT_EQ(v[1].uv.y, 1.0f);
+    EXPECT_EQ(v[0].color.r, Color::Red().r);
+}
+
+TEST(SpriteBatchTest, ManySpritesFewDrawCalls) {
+    NullRenderer renderer;
+    renderer.init(1280, 720);
+    std::vector<std::unique_ptr<Texture>> textures;
+    for (unsigned int i = 0; i < 8; ++i) {
+        textures.push_back(std::make_unique<Texture>(32, 32, i + 1));
+    }
+
+    SpriteBatch batch(&renderer);
+    batch.begin();
+    for (int i = 0; i < 20000; ++i) {
+        batch.draw(textures[static_cast<size_t>(i / 4) % textures.size()].get(),
+                   Rect(0, 0, 32, 32), Vec2(static_cast<float>(i % 1000), 0.0f),
+                   Vec2(0, 0), Vec2(1, 1), 0.0f, Color::White(), i % 4);
+    }
+    batch.end();
+
+    // 4 layers x 8 textures
+    EXPECT_EQ(batch.getDrawCallCount(), 32u);
+    EXPECT_EQ(renderer.batchedQuadCount(), 20000u);
+}
+
+// =============================================================================
+// Atlas Packing Tests
+// =============================================================================
+
+namespace {
+
+Image solidImage(int width, int height, uint8_t shade) {
+    Image image(width, height);
+    for (size_t i = 0; i < image.pixels.size(); i += 4) {
+        image.pixels[i] = shade;
+        image.pixels[i + 1] = static_cast<uint8_t>(i / 4);
+        image.pixels[i + 2] = 0;
+        image.pixels[i + 3] = 255;
+    }
+    return image;
+}
+
+const uint8_t* pixelAt(const Image& image, int x, int y) {
+    return &image.pixels[(static_cast<size_t>(y) * image.width + x) * 4];
+}
+
+/// Minimal PNG signature + IHDR, enough for NullRenderer to read the size
+void writePngHeader(const std::string& path, int width, int height, uint8_t salt = 0) {
+    const unsigned char png[] = {
+        0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n',
+        0, 0, 0, 13, 'I', 'H', 'D', 'R',
+        0, 0, static_cast<unsigned char>(width >> 8), static_cast<unsigned char>(width),
+        0, 0, static_cast<unsigned char>(height >> 8), static_cast<unsigned char>(height),
+        8, 6, 0, 0, 0, salt};
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(png), sizeof(png));
+}
+
+} // namespace
+
+TEST(AtlasPackerTest, MaxRectsFillsPageWithoutOverlap) {
+    MaxRectsPacker packer(32, 32);
+    std::vector<Rect> placed;
+    for (int i = 0; i < 4; ++i) {
+        int x = -1, y = -1;
+        ASSERT_TRUE(packer.insert(16, 16, x, y));
+        Rect r(static_cast<float>(x), static_cast<float>(y), 16, 16);
+        EXPECT_GE(r.x, 0.0f);
+        EXPECT_GE(r.y, 0.0f);
+        EXPECT_LE(r.x + r.width, 32.0f);
+        EXPECT_LE(r.y + r.height, 32.0f);
+        for (const Rect& other : placed) {
+            EXPECT_FALSE(r.intersects(other));
+        }
+        placed.push_back(r);
+    }
+    EXPECT_FLOAT_EQ(packer.occupancy(), 1.0f);
+
+    int x, y;
+    EXPECT_FALSE(packer.insert(1, 1, x, y));
+}
+
+TEST(AtlasPackerTest, PacksPixelsWithExtrudedPadding) {
+    Image a = solidImage(10, 6, 10);
+    Image b = solidImage(4, 12, 20);
+    Image tooBig = solidImage(80, 8, 30);
+
+    AtlasPackSettings settings;
+    settings.pageSize = 64;
+    settings.padding = 2;
+    PackedAtlas atlas = packAtlas({{"a", &a}, {"b", &b}, {"big", &tooBig}}, settings);
+
+    ASSERT_EQ(atlas.pages.size(), 1u);
+    ASSERT_EQ(atlas.regions.size(), 2u);
+    EXPECT_EQ(atlas.regions[0].name, "a");
+    EXPECT_EQ(atlas.regions[1].name, "b");
+
+    const Image& page = atlas.pages[0];
+    EXPECT_EQ(page.width, 64);
+    EXPECT_LE(page.height, 64);
+    EXPECT_TRUE(page.isValid());
+
+    for (size_t i = 0; i < 2; ++i) {
+        const PackedRegion& region = atlas.regions[i];
+        const Image& source = i == 0 ? a : b;
+        int rx = static_cast<int>(region.bounds.x);
+        int ry = static_cast<int>(region.bounds.y);
+        EXPECT_EQ(static_cast<int>(region.bounds.width), source.width);
+        EXPECT_EQ(static_cast<int>(region.bounds.height), source.height);
+
+        // Interior pixels match the source exactly
+        for (int y = 0; y < source.height; ++y) {
+            for (int x = 0; x < source.width; ++x) {
+                ASSERT_EQ(std::memcmp(pixelAt(page, rx + x, ry + y), pixelAt(source, x, y), 4), 0);
+            }
+        }
+        // Padding repeats the nearest edge pixel
+        EXPECT_EQ(std::memcmp(pixelAt(page, rx - 2, ry - 2), pixelAt(source, 0, 0), 4), 0);
+        EXPECT_EQ(std::memcmp(pixelAt(page, rx + source.width + 1, ry + source.height + 1),
+                              pixelAt(source, source.width - 1, source.height - 1), 4), 0);
+    }
+}
+
+TEST(AtlasPackerTest, OverflowOpensNewPages) {
+    std::vector<Image> images;
+    for (int i = 0; i < 5; ++i) images.push_back(solidImage(30, 30, static_cast<uint8_t>(i)));
+    std::vector<AtlasSource> sources;
+    for (int i = 0; i < 5; ++i) sources.push_back({"img" + std::to_string(i), &images[i]});
+
+    AtlasPackSettings settings;
+    settings.pageSize = 64;
+    settings.padding = 1;
+    PackedAtlas atlas = packAtlas(sources, settings);
+
+    // 32px padded cells: four per page
+    ASSERT_EQ(atlas.pages.size(), 2u);
+    ASSERT_EQ(atlas.regions.size(), 5u);
+    EXPECT_EQ(atlas.regions[4].page, 1u);
+    EXPECT_EQ(atlas.pages[1].height, 32);  // Trimmed to the rows in use
+}
+
+TEST(AtlasPackerTest, CacheRoundTrip) {
+    auto dir = (std::filesystem::temp_directory_path() / "gloaming_atlas_cache_test").string();
+    std::filesystem::remove_all(dir);
+
+    Image a = solidImage(8, 8, 1);
+    PackedAtlas atlas = packAtlas({{"a", &a}}, AtlasPackSettings{64, 1});
+
+    AtlasCache cache(dir);
+    const uint64_t key = AtlasCache::hash("a", 1);
+    PackedAtlas loaded;
+    EXPECT_FALSE(cache.load(key, loaded));
+    ASSERT_TRUE(cache.save(key, atlas));
+    ASSERT_TRUE(cache.load(key, loaded));
+
+    ASSERT_EQ(loaded.pages.size(), 1u);
+    EXPECT_EQ(loaded.pages[0].pixels, atlas.pages[0].pixels);
+    ASSERT_EQ(loaded.regions.size(), 1u);
+    EXPECT_EQ(loaded.regions[0].name, "a");
+    EXPECT_FLOAT_EQ(loaded.regions[0].bounds.x, atlas.regions[0].bounds.x);
+
+    // Truncated files are misses
+    std::filesystem::resize_file(cache.pathFor(key), 20);
+    EXPECT_FALSE(cache.load(key, loaded));
+    std::filesystem::remove_all(dir);
+}
+
+TEST(AtlasPackerTest, TextureManagerPacksAndReusesCache) {
+    auto dir = std::filesystem::temp_directory_path() / "gloaming_atlas_pack_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::string hero = (dir / "hero.png").string();
+    std::string slime = (dir / "slime.png").string();
+    std::string loose = (dir / "loose.png").string();
+    writePngHeader(hero, 24, 32);
+    writePngHeader(slime, 16, 16);
+    writePngHeader(loose, 8, 8);
+    std::string cacheDir = (dir / "cache").string();
+
+    NullRenderer renderer;
+    renderer.init(640, 360);
+    TextureManager textures;
+    textures.setRenderer(&renderer);
+
+    EXPECT_EQ(textures.packTextures({hero, slime, hero, ""}, {}, cacheDir), 2u);
+    EXPECT_FALSE(textures.lastPackFromCache());
+    EXPECT_EQ(textures.atlasPageCount(), 1u);
+
+    TextureRegionHandle heroHandle = textures.getRegionHandle(hero);
+    TextureRegionHandle slimeHandle = textures.getRegionHandle(slime);
+    ASSERT_NE(heroHandle, 0u);
+    ASSERT_NE(slimeHandle, 0u);
+    const TextureRegion* heroRegion = textures.getRegion(heroHandle);
+    const TextureRegion* slimeRegion = textures.getRegion(slimeHandle);
+    ASSERT_NE(heroRegion, nullptr);
+    ASSERT_NE(slimeRegion, nullptr);
+    EXPECT_EQ(heroRegion->texture, slimeRegion->texture);
+    EXPECT_FLOAT_EQ(heroRegion->bounds.width, 24.0f);
+    EXPECT_FLOAT_EQ(heroRegion->bounds.height, 32.0f);
+    EXPECT_EQ(textures.getRegion(0), nullptr);
+
+    // Unpacked files resolve to their own whole texture
+    TextureRegion region;
+    ASSERT_TRUE(textures.resolveRegion(loose, region));
+    EXPECT_NE(region.texture, heroRegion->texture);
+    EXPECT_FLOAT_EQ(region.bounds.width, 8.0f);
+
+    // Both packed sprites share a page, so they batch into one draw
+    SpriteBatch batch(&renderer);
+    batch.begin();
+    batch.draw(*heroRegion, Vec2(0, 0));
+    batch.draw(*slimeRegion, Vec2(40, 0));
+    batch.end();
+    EXPECT_EQ(batch.getDrawCallCount(), 1u);
+
+    // Same inputs: served from the cache
+    EXPECT_EQ(textures.packTextures({slime, hero}, {}, cacheDir), 2u);
+    EXPECT_TRUE(textures.lastPackFromCache());
+    EXPECT_EQ(textures.atlasPageCount(), 1u);
+
+    // Changed content: repacked
+    writePngHeader(slime, 16, 16, 1);
+    EXPECT_EQ(textures.packTextures({slime, hero}, {}, cacheDir), 2u);
+    EXPECT_FALSE(textures.lastPackFromCache());
+
+    textures.unloadAll();
+    EXPECT_EQ(textures.getRegionHandle(hero), 0u);
+    EXPECT_EQ(renderer.textureCount(), 0u);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(AtlasPackerTest, AnimationClipsFromPackedSheetStayInRegion) {
+    auto dir = std::filesystem::temp_directory_path() / "gloaming_atlas_anim_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::string big = (dir / "big.png").string();
+    std::string walk = (dir / "walk.png").string();
+    writePngHeader(big, 96, 96);
+    writePngHeader(walk, 64, 32);   // 4 frames of 16x16, 2 rows
+
+    NullRenderer renderer;
+    renderer.init(640, 360);
+    TextureManager textures;
+    textures.setRenderer(&renderer);
+    ASSERT_EQ(textures.packTextures({big, walk}, {}, (dir / "cache").string()), 2u);
+
+    TextureRegion region;
+    ASSERT_TRUE(textures.resolveRegion(walk, region));
+    ASSERT_GT(region.texture->getWidth(), 64);   // Packed onto a larger page
+    ASSERT_TRUE(region.bounds.x > 0.0f || region.bounds.y > 0.0f);
+
+    Sprite sprite(region.texture, region.bounds);
+    sprite.sheetRect = region.bounds;
+
+    AnimationController ctrl;
+    ASSERT_TRUE(ctrl.addClipFromSprite("walk", sprite, /*row=*/1, /*frameCount=*/4,
+                                       0, 0, 10.0f));
+    const auto& frames = ctrl.clips["walk"].frames;
+    ASSERT_EQ(frames.size(), 4u);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        EXPECT_FLOAT_EQ(frames[i].width, 16.0f);
+        EXPECT_FLOAT_EQ(frames[i].height, 16.0f);
+        EXPECT_FLOAT_EQ(frames[i].x, region.bounds.x + 16.0f * static_cast<float>(i));
+        EXPECT_FLOAT_EQ(frames[i].y, region.bounds.y + 16.0f);
+    }
+
+    // Unpacked sprites keep sheet-relative frames at the texture origin
+    Sprite loose(region.texture);
+    ASSERT_TRUE(ctrl.addClipFromSprite("loose", loose, 0, 2, 8, 8, 10.0f));
+    EXPECT_FLOAT_EQ(ctrl.clips["loose"].frames[1].x, 8.0f);
+    EXPECT_FLOAT_EQ(ctrl.clips["loose"].frames[1].y, 0.0f);
+
+    textures.unloadAll();
+    std::filesystem::remove_all(dir);
+}
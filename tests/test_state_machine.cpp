@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include "gameplay/StateMachine.hpp"
+#include "ecs/Registry.hpp"
+
+#include <string>
+#include <vector>
 
 using namespace gloaming;
 
@@ -183,3 +187,234 @@ TEST_F(StateMachineTest, TransitionFromEmptyState) {
     EXPECT_EQ(fsm.getCurrentState(), "idle");
     EXPECT_TRUE(fsm.previousState.empty());
 }
+
+// =============================================================================
+// Shared FSM Definitions
+// =============================================================================
+
+class SharedFSMTest : public ::testing::Test {
+protected:
+    Registry registry;
+    StateMachineSystem system;
+
+    FSMDefinitionId defineGuard() {
+        FSMDefinition& def = system.define("guard");
+        def.addState("idle");
+        def.addState("alert");
+        def.addState("attack");
+        return system.findDefinition("guard");
+    }
+
+    Entity spawn(FSMDefinitionId def) {
+        Entity e = registry.create();
+        system.start(registry.add<FSMInstance>(e), e, def);
+        return e;
+    }
+};
+
+TEST_F(SharedFSMTest, DefinitionAssignsDenseIds) {
+    FSMDefinitionId guard = defineGuard();
+    FSMDefinitionId slime = system.findDefinition("slime");
+    EXPECT_EQ(slime, kInvalidFSMDefinition);
+
+    const FSMDefinition* def = system.getDefinition(guard);
+    ASSERT_NE(def, nullptr);
+    EXPECT_EQ(def->findState("idle"), 0);
+    EXPECT_EQ(def->findState("alert"), 1);
+    EXPECT_EQ(def->findState("attack"), 2);
+    EXPECT_EQ(def->findState("missing"), kNoFSMState);
+
+    // Redefining keeps the definition and its state IDs
+    system.define("guard").addState("attack", {});
+    EXPECT_EQ(system.definitionCount(), 1u);
+    EXPECT_EQ(system.getDefinition(guard)->findState("attack"), 2);
+}
+
+TEST_F(SharedFSMTest, StartEntersInitialState) {
+    int entered = 0;
+    FSMDefinition& def = system.define("door");
+    def.addState("closed", {.onEnter = [&](Entity) { ++entered; }});
+    def.addState("open");
+    def.setInitialState(def.findState("open"));
+
+    Entity e = spawn(system.findDefinition("door"));
+    auto& fsm = registry.get<FSMInstance>(e);
+    EXPECT_EQ(system.getStateName(fsm), "open");
+    EXPECT_EQ(fsm.previousState, kNoFSMState);
+    EXPECT_EQ(entered, 0);
+}
+
+TEST_F(SharedFSMTest, SetStateCallsExitThenEnter) {
+    std::vector<std::string> log;
+    FSMDefinition& def = system.define("door");
+    def.addState("closed", {.onExit = [&](Entity) { log.push_back("exit_closed"); }});
+    def.addState("open", {.onEnter = [&](Entity) { log.push_back("enter_open"); }});
+
+    Entity e = spawn(system.findDefinition("door"));
+    auto& fsm = registry.get<FSMInstance>(e);
+    fsm.timeInState = 3.0f;
+
+    EXPECT_TRUE(system.setState(fsm, e, "open"));
+    EXPECT_FALSE(system.setState(fsm, e, "open"));     // Already there
+    EXPECT_FALSE(system.setState(fsm, e, "missing"));
+    ASSERT_EQ(log.size(), 2u);
+    EXPECT_EQ(log[0], "exit_closed");
+    EXPECT_EQ(log[1], "enter_open");
+    EXPECT_EQ(system.getStateName(fsm), "open");
+    EXPECT_EQ(fsm.previousState, def.findState("closed"));
+    EXPECT_FLOAT_EQ(fsm.timeInState, 0.0f);
+}
+
+TEST_F(SharedFSMTest, TransitionTableGuardsSetState) {
+    FSMDefinitionId guard = defineGuard();
+    FSMDefinition& def = *system.getDefinition(guard);
+    ASSERT_TRUE(def.addTransition("idle", "alert"));
+    ASSERT_TRUE(def.addTransition("alert", "attack"));
+    EXPECT_FALSE(def.addTransition("idle", "missing"));
+
+    Entity e = spawn(guard);
+    auto& fsm = registry.get<FSMInstance>(e);
+    EXPECT_FALSE(system.setState(fsm, e, "attack"));   // idle -> attack not listed
+    EXPECT_TRUE(system.setState(fsm, e, "alert"));
+    EXPECT_TRUE(system.setState(fsm, e, "attack"));
+    EXPECT_TRUE(system.setState(fsm, e, "idle"));      // attack has no table: anything goes
+}
+
+TEST_F(SharedFSMTest, UpdateGroupsEntitiesByState) {
+    FSMDefinitionId guard = defineGuard();
+    FSMDefinition& def = *system.getDefinition(guard);
+
+    int idleBatches = 0;
+    size_t idleEntities = 0;
+    int alertCalls = 0;
+    def.addState("idle", {}, [&](std::span<const Entity> entities, float) {
+        ++idleBatches;
+        idleEntities += entities.size();
+    });
+    def.addState("alert", {.onUpdate = [&](Entity, float) { ++alertCalls; }});
+
+    std::vector<Entity> entities;
+    for (int i = 0; i < 10; ++i) entities.push_back(spawn(guard));
+    for (int i = 0; i < 3; ++i) {
+        system.setState(registry.get<FSMInstance>(entities[i]), entities[i], "alert");
+    }
+
+    system.updateShared(registry, 0.5f);
+    EXPECT_EQ(idleBatches, 1);
+    EXPECT_EQ(idleEntities, 7u);
+    EXPECT_EQ(alertCalls, 3);
+    EXPECT_EQ(system.lastGroupSize(guard, def.findState("idle")), 7u);
+    EXPECT_EQ(system.lastGroupSize(guard, def.findState("alert")), 3u);
+    EXPECT_EQ(system.lastGroupSize(guard, def.findState("attack")), 0u);
+    EXPECT_FLOAT_EQ(registry.get<FSMInstance>(entities[5]).timeInState, 0.5f);
+}
+
+TEST_F(SharedFSMTest, ConditionalTransitionsFireAfterUpdate) {
+    FSMDefinitionId guard = defineGuard();
+    FSMDefinition& def = *system.getDefinition(guard);
+    def.addTransition("idle", "alert", [](Entity, float time) { return time >= 1.0f; });
+
+    Entity e = spawn(guard);
+    auto& fsm = registry.get<FSMInstance>(e);
+
+    system.updateShared(registry, 0.6f);
+    EXPECT_EQ(system.getStateName(fsm), "idle");
+    system.updateShared(registry, 0.6f);
+    EXPECT_EQ(system.getStateName(fsm), "alert");
+    EXPECT_FLOAT_EQ(fsm.timeInState, 0.0f);
+}
+
+TEST_F(SharedFSMTest, ConditionsRefetchInstanceAfterPoolChanges) {
+    FSMDefinitionId guard = defineGuard();
+    FSMDefinition& def = *system.getDefinition(guard);
+    Entity other = spawn(guard);
+    Entity e = spawn(guard);
+
+    // Removing another instance moves e's into its slot, and the new
+    // instance reuses e's old slot; the second condition must still read
+    // e's own time in state
+    def.addTransition("idle", "attack", [&](Entity entity, float) {
+        if (entity == e && registry.has<FSMInstance>(other)) {
+            registry.remove<FSMInstance>(other);
+            registry.add<FSMInstance>(registry.create());
+        }
+        return false;
+    });
+    float seenTime = -1.0f;
+    def.addTransition("idle", "alert", [&](Entity entity, float time) {
+        if (entity == e) seenTime = time;
+        return true;
+    });
+
+    system.updateShared(registry, 0.25f);
+    EXPECT_FLOAT_EQ(seenTime, 0.25f);
+    EXPECT_EQ(system.getStateName(registry.get<FSMInstance>(e)), "alert");
+}
+
+TEST_F(SharedFSMTest, DestroyedEntitiesAreSkippedMidDispatch) {
+    FSMDefinitionId guard = defineGuard();
+    FSMDefinition& def = *system.getDefinition(guard);
+
+    std::vector<Entity> entities;
+    for (int i = 0; i < 4; ++i) entities.push_back(spawn(guard));
+
+    int calls = 0;
+    def.addState("idle", {.onUpdate = [&](Entity self, float) {
+        ++calls;
+        // Whichever entity updates first destroys the rest of its group
+        for (Entity other : entities) {
+            if (other != self && registry.valid(other)) registry.destroy(other);
+        }
+    }});
+
+    system.updateShared(registry, 0.1f);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(SharedFSMTest, RedefineFromCallbackAppliesAfterDispatch) {
+    FSMDefinitionId guard = defineGuard();
+    FSMDefinition& def = *system.getDefinition(guard);
+
+    std::vector<Entity> entities;
+    for (int i = 0; i < 3; ++i) entities.push_back(spawn(guard));
+
+    int oldCalls = 0;
+    int newCalls = 0;
+    def.addState("idle", {.onUpdate = [&](Entity, float) {
+        ++oldCalls;
+        // Replaces the callable that is running right now
+        system.redefine("guard", [&](FSMDefinition& d) {
+            d.addState("idle", {.onUpdate = [&](Entity, float) { ++newCalls; }});
+        });
+        EXPECT_TRUE(system.isDispatching());
+    }});
+
+    system.updateShared(registry, 0.1f);
+    EXPECT_EQ(oldCalls, 3);
+    EXPECT_EQ(newCalls, 0);
+    EXPECT_FALSE(system.isDispatching());
+
+    system.updateShared(registry, 0.1f);
+    EXPECT_EQ(oldCalls, 3);
+    EXPECT_EQ(newCalls, 3);
+}
+
+TEST_F(SharedFSMTest, DirectEditsMidDispatchAreSeen) {
+    FSMDefinitionId guard = defineGuard();
+    FSMDefinition& def = *system.getDefinition(guard);
+    Entity e = spawn(guard);
+
+    // Adding states takes effect this frame, as does a transition added
+    // from onUpdate (no condition is running yet)
+    def.addState("idle", {.onUpdate = [&](Entity, float) {
+        if (def.findState("flee") != kNoFSMState) return;
+        for (int i = 0; i < 32; ++i) def.addState("extra" + std::to_string(i));
+        def.addState("flee");
+        def.addTransition("idle", "flee", [](Entity, float) { return true; });
+    }});
+    uint32_t before = def.revision();
+
+    system.updateShared(registry, 0.1f);
+    EXPECT_GT(def.revision(), before);
+    EXPECT_EQ(system.getStateName(registry.get<FSMInstance>(e)), "flee");
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "engine/Time.hpp"
+#include "engine/FixedTimestep.hpp"
 
 using namespace gloaming;
 
@@ -187,3 +188,64 @@ TEST(TimeTest, FpsUpdatesAfterNextBatch) {
     }
     EXPECT_NEAR(time.fps(), 30.0, 2.0);
 }
+
+// =============================================================================
+// FixedTimestep Tests
+// =============================================================================
+
+static FixedTimestep makeFixed(double tickRate, int maxSteps = 5) {
+    FixedTimestep fixed;
+    FixedTimestepConfig config;
+    config.enabled = true;
+    config.tickRate = tickRate;
+    config.maxStepsPerFrame = maxSteps;
+    fixed.setConfig(config);
+    return fixed;
+}
+
+TEST(FixedTimestepTest, DisabledByDefault) {
+    FixedTimestep fixed;
+    EXPECT_FALSE(fixed.isEnabled());
+    EXPECT_NEAR(fixed.tickDt(), 1.0 / 60.0, 1e-12);
+}
+
+TEST(FixedTimestepTest, FasterRenderingRunsTicksOnSomeFrames) {
+    // 120 Hz rendering over a 60 Hz simulation: one tick every other frame
+    FixedTimestep fixed = makeFixed(60.0);
+    int total = 0;
+    for (int frame = 0; frame < 120; ++frame) {
+        int steps = fixed.advance(1.0 / 120.0);
+        EXPECT_LE(steps, 1);
+        total += steps;
+        EXPECT_GE(fixed.alpha(), 0.0f);
+        EXPECT_LT(fixed.alpha(), 1.0f);
+    }
+    EXPECT_NEAR(total, 60, 1);
+    EXPECT_EQ(fixed.tickCount(), static_cast<uint64_t>(total));
+}
+
+TEST(FixedTimestepTest, SlowerRenderingRunsSeveralTicks) {
+    // 40 Hz rendering: 1.5 ticks per frame on average
+    FixedTimestep fixed = makeFixed(60.0);
+    EXPECT_EQ(fixed.advance(1.0 / 40.0), 1);
+    EXPECT_NEAR(fixed.alpha(), 0.5f, 1e-4f);
+    EXPECT_EQ(fixed.advance(1.0 / 40.0), 2);
+    EXPECT_NEAR(fixed.alpha(), 0.0f, 1e-4f);
+}
+
+TEST(FixedTimestepTest, HitchIsCappedAndExcessDropped) {
+    FixedTimestep fixed = makeFixed(60.0, 4);
+    int steps = fixed.advance(0.25);   // 15 ticks' worth
+    EXPECT_EQ(steps, 4);
+    EXPECT_NEAR(fixed.droppedTime(), 11.0 / 60.0, 1e-6);
+    EXPECT_LT(fixed.alpha(), 1.0f);
+
+    // Next normal frame is not still catching up
+    EXPECT_LE(fixed.advance(1.0 / 60.0), 1);
+}
+
+TEST(FixedTimestepTest, InvalidConfigIsSanitized) {
+    FixedTimestep fixed = makeFixed(0.0, 0);
+    EXPECT_NEAR(fixed.tickDt(), 1.0 / 60.0, 1e-12);
+    EXPECT_EQ(fixed.getConfig().maxStepsPerFrame, 1);
+}